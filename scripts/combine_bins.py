@@ -65,27 +65,12 @@ def combine_bin_files(keep,fileName,remakeBins):
   
   files.sort()
   failedFiles=[]
+  toCombine=[]
   for i in range(len(files)):
     
     #if combined binary file doesn't already exist with this file name
     if not (os.path.exists(files[i][:len(files[i])-2])) or remakeBins:
-      
-      #make combined binary files
-      if not keep:
-        print __name__+":"+combine_bin_files.__name__+": combining \""+files[i][:len(files[i])-2]\
-          +"\" and removing distributed binaries ..."
-      else:
-        print __name__+":"+combine_bin_files.__name__+": combining \""+files[i][:len(files[i])-2]+"\" ..."
-      
-      success=os.system(paths.SPHERLSanalPath+' -c dbcb '+files[i][:len(files[i])-2])
-      if success==0:
-        if not keep:
-          #remove distributed binary files
-          os.system('rm -f '+files[i][:len(files[i])-2]+'-*')
-      else :
-        #say there was an error and quit
-        failedFiles.append(__name__+":"+combine_bin_files.__name__+": error combining binary file "
-          +files[i][:len(files[i])-2])
+      toCombine.append(files[i][:len(files[i])-2])
     else:
       if not keep:
         print __name__+":"+combine_bin_files.__name__+": combined binary \""\
@@ -96,6 +81,35 @@ def combine_bin_files(keep,fileName,remakeBins):
         print __name__+":"+combine_bin_files.__name__+": combined binary \""\
           +files[i][:len(files[i])-2]+"\" already exists"
   
+  #make combined binary files, all dumps are combined by a single SPHERLSanal process which
+  #combines them in parallel, a group at a time to keep the command line a reasonable length
+  groupSize=256
+  for start in range(0,len(toCombine),groupSize):
+    group=toCombine[start:start+groupSize]
+    for base in group:
+      if not keep:
+        print __name__+":"+combine_bin_files.__name__+": combining \""+base\
+          +"\" and removing distributed binaries ..."
+      else:
+        print __name__+":"+combine_bin_files.__name__+": combining \""+base+"\" ..."
+    
+    success=os.system(paths.SPHERLSanalPath+' -c dbcb '+" ".join(group))
+    if success!=0:
+      
+      #find out which dumps failed by combining them one at a time
+      succeeded=[]
+      for base in group:
+        if os.system(paths.SPHERLSanalPath+' -c dbcb '+base)==0:
+          succeeded.append(base)
+        else:
+          failedFiles.append(__name__+":"+combine_bin_files.__name__
+            +": error combining binary file "+base)
+      group=succeeded
+    if not keep:
+      for base in group:
+        #remove distributed binary files
+        os.system('rm -f '+base+'-*')
+  
   if __name__=="__main__":#keeps from redundently reporting errors
     #report problem files
     for failedFile in failedFiles:
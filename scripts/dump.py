@@ -255,7 +255,7 @@ class Dump:
         if self.globalDims[l]==1:
           #make sure if global dimensions are 1 in direction l, that varible 
           #isn't defined in that direction
-          self.varInfo[i][l]==-1
+          self.varInfo[i][l]=-1
         if self.varInfo[i][l]==-1:#not defined in direction l
           tmp2[l]=1
         elif self.varInfo[i][l]==1 and self.boundaryConditions[l]==0:
@@ -360,7 +360,7 @@ class Dump:
         if self.globalDims[l]==1:
           #make sure if global dimensions are 1 in direction l, that varible isn't defined in that
           #direction
-          self.varInfo[i][l]==-1
+          self.varInfo[i][l]=-1
         if self.varInfo[i][l]==-1:#not defined in direction l
           tmp2[l]=1
         elif self.varInfo[i][l]==1 and self.boundaryConditions[l]==0:
@@ -401,34 +401,24 @@ class Dump:
     if self.varInfo[var][2]==-1:
       ghostCellsInX2=0
     
-    #read 1D part
+    #set sizes of 1D part and multi-D part
     sizeX01=ghostCellsInX0*(self.num1DZones+self.numGhostCells)
     if self.varInfo[var][0]==1 and self.boundaryConditions[0]==0:
       sizeX01=ghostCellsInX0*(self.num1DZones+self.numGhostCells+1)
-    sizeX1=1
-    sizeX2=1
-    varTmp=[]
-    for i in range(sizeX01):
-      tmpj=[]
-      for j in range(sizeX1):
-        tmpk=[]
-        for k in range(sizeX2):
-          tmpk.append(struct.unpack('d',self.f.read(8))[0])
-        tmpj.append(tmpk)
-      varTmp.append(tmpj)
-    
-    #read multi-D part
     sizeX02=self.varSize[var][0]+ghostCellsInX0*2*self.numGhostCells
     sizeX1=self.varSize[var][1]+ghostCellsInX1*2*self.numGhostCells
     sizeX2=self.varSize[var][2]+ghostCellsInX2*2*self.numGhostCells
-    for i in range(sizeX01,sizeX02):
-      tmpj=[]
-      for j in range(sizeX1):
-        tmpk=[]
-        for k in range(sizeX2):
-          tmpk.append(struct.unpack('d',self.f.read(8))[0])
-        tmpj.append(tmpk)
-      varTmp.append(tmpj)
+    
+    #map the values of the variable from the file instead of unpacking them one
+    #at a time, copy on write so changes never reach the file
+    count=sizeX01+(sizeX02-sizeX01)*sizeX1*sizeX2
+    values=np.memmap(self.fileName,dtype=np.dtype('d'),mode='c',offset=self.f.tell()
+      ,shape=(count,))
+    self.f.seek(count*8,1)
+    
+    #1D part has one value per radial zone, multi-D part has full rows
+    varTmp=list(values[:sizeX01].reshape((sizeX01,1,1)))
+    varTmp+=list(values[sizeX01:].reshape((sizeX02-sizeX01,sizeX1,sizeX2)))
     self.vars.append(varTmp)
   def _writeBinaryVar(self,var):
     """Write a variable to a binary dump file.
@@ -829,17 +819,14 @@ class Dump:
     #allocate numpy array
     rectVar=np.empty(shapeRec)
     
-    #convert 1D part to 2D/3D
-    for i in range(sizeX01):
-      for j in range(sizeX12):
-        for k in range(sizeX22):
-          rectVar[i][j][k]=self.vars[var][i][0][0]
+    #convert 1D part to 2D/3D by broadcasting each radial value over j and k
+    if sizeX01>0:
+      rectVar[:sizeX01,:,:]=np.array(
+        [self.vars[var][i][0][0] for i in range(sizeX01)]).reshape((sizeX01,1,1))
     
-    #print out MD part
-    for i in range(sizeX01,sizeX02):
-      for j in range(sizeX12):
-        for k in range(sizeX22):
-          rectVar[i][j][k]=self.vars[var][i][j][k]
+    #copy MD part
+    if sizeX02>sizeX01:
+      rectVar[sizeX01:,:,:]=np.array(self.vars[var][sizeX01:sizeX02])
     return rectVar
   def getVarSlice(self,var,rIndexMin=0,rIndexMax=None,tIndexMin=0
                   ,tIndexMax=None,pIndexMin=0,pIndexMax=None):
@@ -1633,86 +1620,28 @@ class Dump:
     temp=self.rectVars[self.getVarID("T")]
     rho=self.rectVars[self.getVarID("rho")]
     
-    #variables to set
-    if "dlnPdlnT" in varsToSet:
-      dlnPdlnT=np.empty(self.cellCenteredShape)
-    if "dlnPdlnD" in varsToSet:
-      dlnPdlnD=np.empty(self.cellCenteredShape)
-    if "dEdT" in varsToSet:
-      dEdT=np.empty(self.cellCenteredShape)
-    if "p" in varsToSet:
-      p=np.empty(self.cellCenteredShape)
-    if "e" in varsToSet:
-      e=np.empty(self.cellCenteredShape)
-    if "kappa" in varsToSet:
-      kappa=np.empty(self.cellCenteredShape)
-    if "gamma" in varsToSet:
-      gamma=np.empty(self.cellCenteredShape)
-    if "cp" in varsToSet:
-      cp=np.empty(self.cellCenteredShape)
+    #only the cell centered part of the grid has equation of state variables
+    shape=self.cellCenteredShape
+    temp=temp[:shape[0],:shape[1],:shape[2]]
+    rho=rho[:shape[0],:shape[1],:shape[2]]
+    
+    #get extra quantities from equation of state for the whole grid at once
+    if ("dlnPdlnT" in varsToSet
+      or "dlnPdlnD" in varsToSet
+      or "dEdT" in varsToSet):
+      [dlnPdlnT,dlnPdlnD,dEdT]=eosTable.getDlnPDlnTDlnPDlnPDEDTArray(temp,rho)
+    if ("p" in varsToSet
+      or "e" in varsToSet
+      or "kappa" in varsToSet
+      or "gamma" in varsToSet
+      or "cp" in varsToSet):
+      [p,e,kappa,gamma,cp]=eosTable.getPEKappaGammaCpArray(temp,rho)
+    if ("gamma1" in varsToSet
+      or "DelAd" in varsToSet
+      or "cv" in varsToSet):
+      [gamma1,DelAd,cv]=eosTable.getGamma1DelAdC_vArray(temp,rho)
     if "c" in varsToSet:
-      c=np.empty(self.cellCenteredShape)
-    if "gamma1" in varsToSet:
-      gamma1=np.empty(self.cellCenteredShape)
-    if "DelAd" in varsToSet:
-      DelAd=np.empty(self.cellCenteredShape)
-    if "cv" in varsToSet:
-      cv=np.empty(self.cellCenteredShape)
-    
-    for i in range(self.cellCenteredShape[0]):
-      for j in range(self.cellCenteredShape[1]):
-        for k in range(self.cellCenteredShape[2]):
-          
-          #get extra quantities from equation of state
-          if ("dlnPdlnT" in varsToSet
-            or "dlnPdlnD" in varsToSet
-            or "dEdT" in varsToSet):
-            [dlnPdlnTtmp,dlnPdlnDtmp,dEdTtmp]=eosTable.getDlnPDlnTDlnPDlnPDEDT(
-              temp[i][j][k],rho[i][j][k])
-          if ("p" in varsToSet
-            or "e" in varsToSet
-            or "kappa" in varsToSet
-            or "gamma" in varsToSet
-            or "cp" in varsToSet):
-            [ptmp,etmp,kappatmp,gammatmp,cptmp]=eosTable.getPEKappaGammaCp(
-              temp[i][j][k],rho[i][j][k])
-          if ("gamma1" in varsToSet
-            or "DelAd" in varsToSet
-            or "cv" in varsToSet):
-            [gamma1tmp,DelAdtmp,cvtmp]=eosTable.getGamma1DelAdC_v(
-              temp[i][j][k],rho[i][j][k])
-          if "c" in varsToSet:
-            ctmp=eosTable.getSoundSpeed(
-              temp[i][j][k],rho[i][j][k])
-          if "dRhodP" in varsToSet:
-            dRhodPtmp=eosTable.getDRhoDP(
-              temp[i][j][k],rho[i][j][k])
-          
-          #set values
-          if "dlnPdlnT" in varsToSet:
-            dlnPdlnT[i][j][k]=dlnPdlnTtmp
-          if "dlnPdlnD" in varsToSet:
-            dlnPdlnD[i][j][k]=dlnPdlnDtmp
-          if "dEdT" in varsToSet:
-            dEdT[i][j][k]=dEdTtmp
-          if "p" in varsToSet:
-            p[i][j][k]=ptmp
-          if "e" in varsToSet:
-            e[i][j][k]=etmp
-          if "kappa" in varsToSet:
-            kappa[i][j][k]=kappatmp
-          if "gamma" in varsToSet:
-            gamma[i][j][k]=gammatmp
-          if "cp" in varsToSet:
-            cp[i][j][k]=cptmp
-          if "c" in varsToSet:
-            c[i][j][k]=ctmp
-          if "gamma1" in varsToSet:
-            gamma1[i][j][k]=gamma1tmp
-          if "DelAd" in varsToSet:
-            DelAd[i][j][k]=DelAdtmp
-          if "cv" in varsToSet:
-            cv[i][j][k]=cvtmp
+      c=eosTable.getSoundSpeedArray(temp,rho)
     
     #Add newly set variables
     if "dlnPdlnT" in varsToSet:
@@ -115,25 +115,35 @@ def make_2DSlices(keep,fileName,nPlane,nPlaneIndex,remake):
     extension=extension+"i="+str(nPlaneIndex)+".txt"
   if nPlane==2:
     extension=extension+"j="+str(nPlaneIndex)+".txt"
-  count=1
+  
+  #find the files which need 2D slices made
+  toMake=[]
   for file in files:
     #if this particular 2D slice doesn't already exsist for this binary file create it
     if not (os.path.exists(file+extension)) or remake:
-      
-      #make 2D slice
-      print __name__+":"+make_2DSlices.__name__+": creating 2D slice from \""+file+"\" "\
-        +str(count)+"/"+str(len(files))+" ..."
-      success=os.system(paths.SPHERLSanalPath+' -s cb '+str(nPlane)+' '+str(nPlaneIndex)+' '+file)
-      if success==0:
-        pass
-      else :
-        
-        #say there was an error and return
-        print __name__+":"+make_2DSlices.__name__+": error making 2D slice "+file+extension
-        return False
+      toMake.append(file)
     else:
       print __name__+":"+make_2DSlices.__name__+": 2D slice \""+file+extension+"\" already exists"
-    count+=1
+  
+  #make 2D slices, each group of files is sliced in parallel by a single SPHERLSanal process
+  cmd=paths.SPHERLSanalPath+' -s cb '+str(nPlane)+' '+str(nPlaneIndex)+' '
+  groupSize=256
+  count=1
+  for start in range(0,len(toMake),groupSize):
+    group=toMake[start:start+groupSize]
+    for file in group:
+      print __name__+":"+make_2DSlices.__name__+": creating 2D slice from \""+file+"\" "\
+        +str(count)+"/"+str(len(toMake))+" ..."
+      count+=1
+    success=os.system(cmd+" ".join(group))
+    if success==0:
+      pass
+    else :
+      
+      #say there was an error and return
+      print __name__+":"+make_2DSlices.__name__+": error making 2D slices "+group[0]+extension\
+        +" to "+group[-1]+extension
+      return False
   return True
 if __name__ == "__main__":
   main()
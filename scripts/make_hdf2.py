@@ -180,7 +180,7 @@ class fileSet:
     #write out time
     hdf.open(self.timeFile)
     hdf.openData("time",hdf.DFNT_FLOAT64,[len(times)])
-    hdf.writeData(times)
+    hdf.writeData(numpy.array(times,dtype='d'))
     hdf.closeData()
     hdf.close()
   def convertDumpToHDF(self,dump):
@@ -204,7 +204,9 @@ class fileSet:
     for data in self.data:
       #print "  writting \""+self.dataNames[n]+"\" to file ..."
       hdf.openData(self.dataNames[n],hdf.DFNT_FLOAT64,self.dataShape[n])
-      hdf.writeData(data)
+      
+      #hand the variable over as one contiguous array so it is written in a single call
+      hdf.writeData(numpy.ascontiguousarray(data,dtype='d'))
       hdf.closeData()
       n+=1
     hdf.close()
@@ -86,6 +86,50 @@ def make_profile(fileName,options,nCount,nNumFiles):
       +"_pro.txt\" already exists, not remaking"
   
   return None#conversion successful
+def make_profiles(files,options):
+  """Makes radial profiles from a list of combined binary files using a single
+  SPHERLSanal process for each group of files, which processes the files of a
+  group in parallel.
+  
+  uses the same options as make_profile
+  
+  returns a list of files that failed being made
+  """
+  
+  #find the files which need profiles made
+  toMake=[]
+  for file in files:
+    if not (os.path.exists(file+"_pro.txt")) or options.remakeProfiles:
+      toMake.append(file)
+    else:
+      print __name__+":"+make_profiles.__name__+": profile \""+file\
+        +"_pro.txt\" already exists, not remaking"
+  
+  cmd=paths.SPHERLSanalPath
+  if options.extraProfileInfo:
+    cmd+=" -v "
+  if options.eosFile!=None:
+    cmd+=" -e "+options.eosFile
+  cmd+=' -a cb '
+  
+  #make profiles a group at a time to keep the command line a reasonable length
+  failedFiles=[]
+  groupSize=256
+  nCount=1
+  for start in range(0,len(toMake),groupSize):
+    group=toMake[start:start+groupSize]
+    for file in group:
+      print (__name__+":"+make_profiles.__name__+": creating profile from \""
+        +file+"\" "+str(nCount)+"/"+str(len(toMake))+" ...")
+      nCount+=1
+    success=os.system(cmd+" ".join(group))
+    if success!=0:
+      
+      #find out which profiles failed by making them one at a time
+      for file in group:
+        if os.system(cmd+file)!=0:
+          failedFiles.append("error making profile "+file+"_pro.txt")
+  return failedFiles
 def make_fileSet(fileName,options,makeFileFunction=make_profile,frequency=1):
   """Makes a set of files from SPHERLS output using fileMakingFunction
   
@@ -125,6 +169,11 @@ def make_fileSet(fileName,options,makeFileFunction=make_profile,frequency=1):
       +"-"+str(end)+"]")
     
   
+  #profiles are made in batches by one SPHERLSanal process
+  if makeFileFunction==make_profile:
+    failedFiles+=make_profiles(files[::frequency],options)
+    return failedFiles
+  
   nNumFiles=len(files)
   nCount=1
   for i in range(0,len(files),frequency):
@@ -219,6 +219,12 @@ def readWatchzone(fileName):
     return
   f=open(fileName,'r')
   
+  #binary watch zone files start with a 'w'
+  if f.read(1)=='w':
+    f.close()
+    return readWatchzoneBin(fileName)
+  f.seek(0)
+  
   #skip first two lines
   line=f.readline()
   line=f.readline()
@@ -254,6 +260,29 @@ def readWatchzone(fileName):
     i=i+1
   return watchZone
   
+def readWatchzoneBin(fileName):
+  """Reads a binary watch zone file, returning the same list of columns as readWatchzone"""
+  
+  f=open(fileName,'rb')
+  
+  #read header, 'w', version, zone i,j,k, gamma-law flag, gamma, number of columns
+  header=np.fromfile(f,dtype=np.dtype([('type','S1'),('version','i4'),('zone','i4',(3,))
+    ,('gammaLaw','i4'),('gamma','f8'),('numColumns','i4')]),count=1)[0]
+  if header['version']!=1:
+    print "file \""+fileName+"\" is version",header['version'],", expected version 1"
+    quit()
+  
+  #read all records at once, time step index followed by the columns
+  records=np.fromfile(f,dtype=np.dtype([('j','i4'),('values','f8',(header['numColumns'],))]))
+  f.close()
+  
+  #undefined values are written as NaN, they are "-" in the text files
+  values=np.nan_to_num(records['values'])
+  watchZone=[list(records['j'].astype(float))]
+  for col in range(header['numColumns']):
+    watchZone.append(list(values[:,col]))
+  return watchZone
+  
 def calcPhase(watchZone):
   phase=[]
   i=0
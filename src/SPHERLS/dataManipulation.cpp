@@ -11,6 +11,7 @@
 #include <fstream>
 #include <iomanip>
 #include <vector>
+#include <algorithm>
 #include <fenv.h>//linux
 #include "dataManipulation.h"
 #include "global.h"
@@ -20,6 +21,10 @@
 #include "physEquations.h"
 #include <string>
 #include "fileExists.h"
+#include "dumpFile.h"
+#ifdef HDF5_ENABLE
+#include <hdf5.h>
+#endif
 
 void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &parameters
   ,MessPass &messPass,Performance &performance,Implicit &implicit
@@ -140,6 +145,40 @@ void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &para
   if(!xDump.isEmpty()){
     output.bDump=true;
     
+    //get dump format
+    std::string sFormat;
+    if(getXMLAttributeNoThrow(xDump,"format",sFormat)){
+      if(sFormat.compare("binary")==0){
+        output.nDumpFormat=0;
+      }
+      else if(sFormat.compare("hdf5")==0){
+        #ifdef HDF5_ENABLE
+        output.nDumpFormat=1;
+        #else
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+          <<": dump format \"hdf5\" requested, but SPHERLS was not configured with "
+          <<"--enable-hdf5\n";
+        throw exception2(ssTemp.str(),INPUT);
+        #endif
+      }
+      else{
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+          <<": unknown dump format \""<<sFormat<<"\", expecting \"binary\" or \"hdf5\"\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+    }
+    
+    //get compression of HDF5 dumps
+    getXMLAttributeNoThrow(xDump,"compression",output.nDumpCompression);
+    if(output.nDumpCompression<0||output.nDumpCompression>9){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": dump compression must be between 0 and 9, got "<<output.nDumpCompression<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
     //get dump frequencies
     XMLNode xFrequency1=getXMLNodeNoThrow(xDump,"frequency",0);
     if(!xFrequency1.isEmpty()){//no frequency node found
@@ -355,6 +394,27 @@ void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &para
     
     parameters.eosTable.readBin(sTemp);
     
+    //get interpolation method, bicubic Hermite interpolation gives derivatives that are continuous
+    //across table cells
+    std::string sInterpolation="linear";
+    getXMLValueNoThrow(xEOS,"interpolation",0,sInterpolation);
+    if(sInterpolation.compare("bicubic")==0){
+      parameters.eosTable.setHermite(true);
+    }
+    else if(sInterpolation.compare("linear")!=0){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": Unknown equation of state interpolation, \""<<sInterpolation
+        <<"\", try either \"linear\" or \"bicubic\"."<<std::endl;
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //make inverse table of temperature as a function of energy and density, used to get the new
+    //temperature without iterating on the energy, off unless turned on
+    bool bInverse=false;
+    getXMLValueNoThrow(xEOS,"inverse",0,bInverse);
+    parameters.eosTable.setInverse(bInverse);
+    
     //get tolerance for iterated quantities
     getXMLValue(xEOS,"tolerance",0,parameters.dTolerance);
     
@@ -409,6 +469,12 @@ void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &para
   //initialize internal variables
   initInternalVars(grid,procTop,parameters);
   
+  //tabulate the angular part of the zone volumes
+  initAngularGeometry(procTop,grid);
+  
+  //scratch space for the face based 3D kernels
+  initRadialFacePlanes(procTop,grid);
+  
   //initialize implicit calculation
   if(implicit.nNumImplicitZones>0){
     initImplicitCalculation(implicit, grid, procTop,nNumArgs,cArgs);
@@ -417,6 +483,9 @@ void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &para
   //parse, and initialize watch zones
   initWatchZones(xData, procTop,grid,output,parameters,time);
   
+  //parse, and initialize in-situ radial profiles
+  initRadialProfiles(xData, procTop,grid,output,parameters,time);
+  
   //switch to dedm node if there is one
   XMLNode xDEDM=getXMLNodeNoThrow(xData,"dedm",0);
   if(!xDEDM.isEmpty()){
@@ -450,9 +519,7 @@ void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &para
     parameters.bDEDMClamp=false;
   }
 }
-void setupLocalGrid(ProcTop &procTop, Grid &grid){
-  
-  //set coordinates for all processors
+void setProcCoords(ProcTop &procTop){
   int nRankCur=1;
   procTop.nCoords=new int*[procTop.nNumProcs];
   for(int i=1;i<procTop.nProcDims[0];i++){
@@ -470,6 +537,11 @@ void setupLocalGrid(ProcTop &procTop, Grid &grid){
   procTop.nCoords[0][0]=0;
   procTop.nCoords[0][1]=-1;//matches all y
   procTop.nCoords[0][2]=-1;//matches all z
+}
+void setupLocalGrid(ProcTop &procTop, Grid &grid){
+  
+  //set coordinates for all processors
+  setProcCoords(procTop);
   
   //calculate grid sizes for all processors
   grid.nLocalGridDims=new int**[procTop.nNumProcs];
@@ -556,6 +628,21 @@ void setupLocalGrid(ProcTop &procTop, Grid &grid){
         +2*nGhostCellsX*grid.nNumGhostCells];
       grid.dLocalGridNew[n]=new double**[grid.nLocalGridDims[procTop.nRank][n][0]
         +2*nGhostCellsX*grid.nNumGhostCells];
+      if(n==grid.nR){//radial geometry
+        int nSizeX=grid.nLocalGridDims[procTop.nRank][n][0]+2*nGhostCellsX*grid.nNumGhostCells;
+        grid.dRCuOld=new double[nSizeX];
+        grid.dRCuNew=new double[nSizeX];
+        grid.dRSqOld=new double[nSizeX];
+        grid.dDelRCuOld=new double[nSizeX];
+        grid.dDelRCuNew=new double[nSizeX];
+        grid.dDelRSqOld=new double[nSizeX];
+      }
+      if(n==grid.nT){//equation of state table cell hints and T^4, same size as temperature
+        grid.nEOSCell=new int**[grid.nLocalGridDims[procTop.nRank][n][0]
+          +2*nGhostCellsX*grid.nNumGhostCells];
+        grid.dT4Old=new double**[grid.nLocalGridDims[procTop.nRank][n][0]
+          +2*nGhostCellsX*grid.nNumGhostCells];
+      }
       
       //do inner part of old and new grid
       for(int i=0;i<grid.nLocalGridDims[procTop.nRank][n][0]+nGhostCellsX*grid.nNumGhostCells;i++){
@@ -565,6 +652,17 @@ void setupLocalGrid(ProcTop &procTop, Grid &grid){
           grid.dLocalGridOld[n][i][j]=new double[grid.nLocalGridDims[procTop.nRank][n][2]];
           grid.dLocalGridNew[n][i][j]=new double[grid.nLocalGridDims[procTop.nRank][n][2]];
         }
+        if(n==grid.nT){
+          grid.nEOSCell[i]=new int*[grid.nLocalGridDims[procTop.nRank][n][1]];
+          grid.dT4Old[i]=new double*[grid.nLocalGridDims[procTop.nRank][n][1]];
+          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1];j++){
+            grid.nEOSCell[i][j]=new int[grid.nLocalGridDims[procTop.nRank][n][2]];
+            grid.dT4Old[i][j]=new double[grid.nLocalGridDims[procTop.nRank][n][2]];
+            for(int k=0;k<grid.nLocalGridDims[procTop.nRank][n][2];k++){
+              grid.nEOSCell[i][j][k]=-1;
+            }
+          }
+        }
       }
       
       //expand out last grid.nNumGhostCells to hold data from adjacent 3D grid, to later be averaged
@@ -597,6 +695,17 @@ void setupLocalGrid(ProcTop &procTop, Grid &grid){
           grid.dLocalGridOld[n][i][j]=new double[nSizeZ];
           grid.dLocalGridNew[n][i][j]=new double[nSizeZ];
         }
+        if(n==grid.nT){
+          grid.nEOSCell[i]=new int*[nSizeY];
+          grid.dT4Old[i]=new double*[nSizeY];
+          for(int j=0;j<nSizeY;j++){
+            grid.nEOSCell[i][j]=new int[nSizeZ];
+            grid.dT4Old[i][j]=new double[nSizeZ];
+            for(int k=0;k<nSizeZ;k++){
+              grid.nEOSCell[i][j][k]=-1;
+            }
+          }
+        }
       }
     }
   }
@@ -636,6 +745,29 @@ void setupLocalGrid(ProcTop &procTop, Grid &grid){
           grid.dLocalGridNew[n][i][j]=new double[nSizeZ];
         }
       }
+      if(n==grid.nR){//radial geometry
+        grid.dRCuOld=new double[nSizeX];
+        grid.dRCuNew=new double[nSizeX];
+        grid.dRSqOld=new double[nSizeX];
+        grid.dDelRCuOld=new double[nSizeX];
+        grid.dDelRCuNew=new double[nSizeX];
+        grid.dDelRSqOld=new double[nSizeX];
+      }
+      if(n==grid.nT){//equation of state table cell hints and T^4, same size as temperature
+        grid.nEOSCell=new int**[nSizeX];
+        grid.dT4Old=new double**[nSizeX];
+        for(int i=0;i<nSizeX;i++){
+          grid.nEOSCell[i]=new int*[nSizeY];
+          grid.dT4Old[i]=new double*[nSizeY];
+          for(int j=0;j<nSizeY;j++){
+            grid.nEOSCell[i][j]=new int[nSizeZ];
+            grid.dT4Old[i][j]=new double[nSizeZ];
+            for(int k=0;k<nSizeZ;k++){
+              grid.nEOSCell[i][j][k]=-1;
+            }
+          }
+        }
+      }
     }
   }
   
@@ -763,7 +895,16 @@ void fin(bool bWriteCurrentStateToFile, Time &time, Output &output,ProcTop
                 <<" "<<time.dDelV_t_V_max<<std::endl;
             }
           }
+    #ifdef HDF5_ENABLE
+    if(output.nDumpFormat==1){
+      modelWrite_HDF5(ssFileNameOut.str(),output,procTop,grid,time,parameters);
+    }
+    else{
+      functions.fpModelWrite(ssFileNameOut.str(),procTop,grid,time,parameters);
+    }
+    #else
     functions.fpModelWrite(ssFileNameOut.str(),procTop,grid,time,parameters);
+    #endif
     
     #if DEBUG_EQUATIONS==1
     std::stringstream ssFileNameProOut;
@@ -775,7 +916,7 @@ void fin(bool bWriteCurrentStateToFile, Time &time, Output &output,ProcTop
   }
   
   //finish other tasks
-  finWatchZones(output);
+  finWatchZones(output,procTop);
   
   //report on performance
   if(procTop.nRank==0){
@@ -828,6 +969,9 @@ void modelWrite_GL(std::string sFileName,ProcTop &procTop, Grid &grid, Time &tim
   //write out last time step
   ofOut.write((char*)(&time.dDeltat_nm1half),sizeof(double));
   
+  //write out last time step
+  ofOut.write((char*)(&time.dDeltat_np1half),sizeof(double));
+  
   //write out alpha
   ofOut.write((char*)(&parameters.dAlpha),sizeof(double));
   
@@ -1151,67 +1295,321 @@ void modelWrite_TEOS(std::string sFileName,ProcTop &procTop, Grid &grid, Time &t
     ofOut.close();
   }
 }
-void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
-  , Parameters &parameters){
-  
-  //open file
-  std::ifstream ifIn;
-  ifIn.open(sFileName.c_str(),std::ios::binary);
-  if(!ifIn.is_open()){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
-      <<": error opening the file \""<<sFileName.c_str()<<"\"\n";
-    throw exception2(ssTemp.str(),INPUT);
+std::string getVariableName(Grid &grid,int nVar){
+  if(nVar==grid.nM){
+    return "M";
+  }
+  if(nVar==grid.nTheta){
+    return "Theta";
+  }
+  if(nVar==grid.nPhi){
+    return "Phi";
+  }
+  if(nVar==grid.nDM){
+    return "DM";
+  }
+  if(nVar==grid.nR){
+    return "R";
+  }
+  if(nVar==grid.nD){
+    return "D";
+  }
+  if(nVar==grid.nU){
+    return "U";
+  }
+  if(nVar==grid.nU0){
+    return "U0";
+  }
+  if(nVar==grid.nV){
+    return "V";
+  }
+  if(nVar==grid.nW){
+    return "W";
+  }
+  if(nVar==grid.nT){
+    return "T";
+  }
+  if(nVar==grid.nE){
+    return "E";
+  }
+  std::stringstream ssName;
+  ssName<<"var"<<nVar;
+  return ssName.str();
+}
+void getCollectedGridSize(ProcTop &procTop,Grid &grid,int nVar,int nSize[3]){
+  for(int l=0;l<3;l++){
+    nSize[l]=1;//1 if variable not defined in that direction
+    if(grid.nVariables[nVar][l]!=-1){
+      nSize[l]=grid.nGlobalGridDims[l]+2*grid.nNumGhostCells;
+      if(procTop.nPeriodic[l]==0){
+        nSize[l]+=grid.nVariables[nVar][l];
+      }
+    }
   }
   
-  //set up array to hold size of dimensions
-  grid.nGlobalGridDims=new int[3];
-  
-  //check file type
-  char cTemp;
-  ifIn.read((char*)(&cTemp),sizeof(char));
-  if(cTemp!='b'){
+  //radial direction starts after the 1D region
+  if(grid.nVariables[nVar][0]!=-1){
+    nSize[0]=grid.nGlobalGridDims[0]-grid.nNum1DZones+grid.nNumGhostCells;
+  }
+}
+void getCollectedGridPosition(int nProc,ProcTop &procTop,int ***nLocalGridDims,Grid &grid
+  ,int nVar,int nPosGrid[3]){
+  nPosGrid[0]=0;
+  nPosGrid[1]=0;
+  nPosGrid[2]=0;
+  if(nProc==0){
+    return;
+  }
+  for(int p=1;p<procTop.nNumProcs;p++){
+    for(int l=0;l<3;l++){
+      if(grid.nVariables[nVar][l]==-1){
+        continue;
+      }
+      bool bBefore=procTop.nCoords[p][l]<procTop.nCoords[nProc][l];
+      for(int m=0;m<3;m++){
+        if(m!=l&&procTop.nCoords[p][m]!=procTop.nCoords[nProc][m]){
+          bBefore=false;
+        }
+      }
+      if(bBefore){
+        nPosGrid[l]+=nLocalGridDims[p][nVar][l];
+      }
+    }
+  }
+  if(grid.nVariables[nVar][0]!=-1){
+    nPosGrid[0]-=grid.nNumGhostCells;//local grid starts with the inner ghost cells
+  }
+}
+bool bGetOwnedZones(int nProc,ProcTop &procTop,int ***nLocalGridDims,Grid &grid,int nVar
+  ,int nStart[3],int nEnd[3]){
+  if(nProc==0){
+    return false;
+  }
+  for(int l=0;l<3;l++){
+    if(grid.nVariables[nVar][l]==-1){//only the first processor in direction l owns it
+      nStart[l]=0;
+      nEnd[l]=1;
+      int nFirst=0;
+      if(l==0){
+        nFirst=1;
+      }
+      if(procTop.nCoords[nProc][l]!=nFirst){
+        return false;
+      }
+    }
+    else{
+      nStart[l]=grid.nNumGhostCells;
+      nEnd[l]=nLocalGridDims[nProc][nVar][l]+grid.nNumGhostCells;
+      if(procTop.nCoords[nProc][l]==0){
+        nStart[l]=0;
+      }
+      if(procTop.nCoords[nProc][l]==procTop.nProcDims[l]-1){
+        nEnd[l]+=grid.nNumGhostCells;
+      }
+    }
+  }
+  return true;
+}
+#ifdef HDF5_ENABLE
+void writeHDF5Attribute(hid_t nLocation,std::string sName,hid_t nType,int nRank,hsize_t nDims[]
+  ,void *vData){
+  hid_t nSpace=H5Screate_simple(nRank,nDims,NULL);
+  hid_t nAttribute=H5Acreate(nLocation,sName.c_str(),nType,nSpace,H5P_DEFAULT,H5P_DEFAULT);
+  H5Awrite(nAttribute,nType,vData);
+  H5Aclose(nAttribute);
+  H5Sclose(nSpace);
+}
+void readHDF5Attribute(hid_t nLocation,std::string sName,hid_t nType,void *vData
+  ,std::string sFileName,ProcTop &procTop){
+  if(H5Aexists(nLocation,sName.c_str())<=0){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
-      <<": file \""<<sFileName<<"\" is not a binary file.\n";
+      <<": attribute \""<<sName<<"\" not found in file \""<<sFileName<<"\"\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  
-  //check file version
-  int nTemp;
-  ifIn.read((char*)(&nTemp),sizeof(int));
-  if(nTemp!=DUMP_VERSION){
+  hid_t nAttribute=H5Aopen(nLocation,sName.c_str(),H5P_DEFAULT);
+  H5Aread(nAttribute,nType,vData);
+  H5Aclose(nAttribute);
+}
+void modelWrite_HDF5(std::string sFileName,Output &output,ProcTop &procTop, Grid &grid
+  ,Time &time, Parameters &parameters){
+  
+  //all processors open the same file for parallel I/O
+  std::string sFileNameH5=sFileName+".h5";
+  hid_t nAccess=H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_mpio(nAccess,MPI_COMM_WORLD,MPI_INFO_NULL);
+  hid_t nFile=H5Fcreate(sFileNameH5.c_str(),H5F_ACC_TRUNC,H5P_DEFAULT,nAccess);
+  H5Pclose(nAccess);
+  if(nFile<0){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
-      <<": file \""<<sFileName<<"\" has version \""<<nTemp
-      <<"\" which is not the same as the supported version \"DUMP_VERSION\"\n";
-    throw exception2(ssTemp.str(),INPUT);
+      <<": error opening the file "<<sFileNameH5<<std::endl;
+    throw exception2(ssTemp.str(),OUTPUT);
   }
+  hid_t nTransfer=H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(nTransfer,H5FD_MPIO_COLLECTIVE);
   
-  //read in time
-  ifIn.read((char*)(&time.dt),sizeof(double));
-  
-  //read in time step index
-  ifIn.read((char*)(&time.nTimeStepIndex),sizeof(int));
-  
-  //read in last time step
-  ifIn.read((char*)(&time.dDeltat_nm1half),sizeof(double));
-  
-  //read in last time step
-  ifIn.read((char*)(&time.dDeltat_np1half),sizeof(double));
-  
-  //set other time values to reasonable initial values
-  time.dDeltat_n=(time.dDeltat_nm1half+time.dDeltat_np1half)*0.5;
-  
-  //read in dAlpha
-  ifIn.read((char*)(&parameters.dAlpha),sizeof(double));
+  //write out header, attribute writes are collective so all processors write the same values
+  hsize_t nScalar[1]={1};
+  hsize_t nVector[1]={3};
+  int nTemp=DUMP_VERSION;
+  writeHDF5Attribute(nFile,"version",H5T_NATIVE_INT,1,nScalar,&nTemp);
+  writeHDF5Attribute(nFile,"time",H5T_NATIVE_DOUBLE,1,nScalar,&time.dt);
+  writeHDF5Attribute(nFile,"timeStepIndex",H5T_NATIVE_INT,1,nScalar,&time.nTimeStepIndex);
+  writeHDF5Attribute(nFile,"deltat_nm1half",H5T_NATIVE_DOUBLE,1,nScalar,&time.dDeltat_nm1half);
+  writeHDF5Attribute(nFile,"deltat_np1half",H5T_NATIVE_DOUBLE,1,nScalar,&time.dDeltat_np1half);
+  writeHDF5Attribute(nFile,"alpha",H5T_NATIVE_DOUBLE,1,nScalar,&parameters.dAlpha);
+  nTemp=0;
+  if(parameters.bEOSGammaLaw){
+    nTemp=1;
+  }
+  writeHDF5Attribute(nFile,"gammaLaw",H5T_NATIVE_INT,1,nScalar,&nTemp);
+  if(parameters.bEOSGammaLaw){
+    writeHDF5Attribute(nFile,"gamma",H5T_NATIVE_DOUBLE,1,nScalar,&parameters.dGamma);
+  }
+  else{
+    hid_t nString=H5Tcopy(H5T_C_S1);
+    H5Tset_size(nString,parameters.sEOSFileName.length()+1);
+    writeHDF5Attribute(nFile,"eosFile",nString,1,nScalar
+      ,(void*)(parameters.sEOSFileName.c_str()));
+    H5Tclose(nString);
+  }
+  writeHDF5Attribute(nFile,"A",H5T_NATIVE_DOUBLE,1,nScalar,&parameters.dA);
+  writeHDF5Attribute(nFile,"AVThreshold",H5T_NATIVE_DOUBLE,1,nScalar,&parameters.dAVThreshold);
+  writeHDF5Attribute(nFile,"procDims",H5T_NATIVE_INT,1,nVector,procTop.nProcDims);
+  writeHDF5Attribute(nFile,"periodic",H5T_NATIVE_INT,1,nVector,procTop.nPeriodic);
+  writeHDF5Attribute(nFile,"globalGridDims",H5T_NATIVE_INT,1,nVector,grid.nGlobalGridDims);
+  writeHDF5Attribute(nFile,"num1DZones",H5T_NATIVE_INT,1,nScalar,&grid.nNum1DZones);
+  writeHDF5Attribute(nFile,"numGhostCells",H5T_NATIVE_INT,1,nScalar,&grid.nNumGhostCells);
+  writeHDF5Attribute(nFile,"numVars",H5T_NATIVE_INT,1,nScalar,&grid.nNumVars);
+  int *nVariableInfo=new int[4*grid.nNumVars];
+  for(int n=0;n<grid.nNumVars;n++){
+    for(int l=0;l<4;l++){
+      nVariableInfo[4*n+l]=grid.nVariables[n][l];
+    }
+  }
+  hsize_t nInfoDims[2]={hsize_t(grid.nNumVars),4};
+  writeHDF5Attribute(nFile,"variableInfo",H5T_NATIVE_INT,2,nInfoDims,nVariableInfo);
+  delete [] nVariableInfo;
   
-  //read in gammalaw gas
-  int nGammaLaw;
-  ifIn.read((char*)(&nGammaLaw),sizeof(int));
+  //write out grid
+  for(int n=0;n<grid.nNumVars;n++){
+    hid_t nGroup=H5Gcreate(nFile,getVariableName(grid,n).c_str(),H5P_DEFAULT,H5P_DEFAULT
+      ,H5P_DEFAULT);
+    
+    //1D region, written by processor 0, includes inner ghost cells, and outer ghost cells if there
+    //is only one processor in the radial direction
+    if(grid.nVariables[n][0]!=-1){
+      int nGhostCellsOuter=0;
+      if(procTop.nProcDims[0]==1){
+        nGhostCellsOuter=grid.nNumGhostCells;
+      }
+      hsize_t nDims[3]={hsize_t(grid.nLocalGridDims[0][n][0]+grid.nNumGhostCells
+        +nGhostCellsOuter),hsize_t(grid.nLocalGridDims[0][n][1])
+        ,hsize_t(grid.nLocalGridDims[0][n][2])};
+      hsize_t nChunk[3]={std::min(nDims[0],std::max(hsize_t(1)
+        ,hsize_t(HDF5_CHUNK_SIZE)/(nDims[1]*nDims[2])))
+        ,nDims[1],nDims[2]};
+      hid_t nCreate=H5Pcreate(H5P_DATASET_CREATE);
+      H5Pset_chunk(nCreate,3,nChunk);
+      if(output.nDumpCompression>0){
+        H5Pset_deflate(nCreate,output.nDumpCompression);
+      }
+      hid_t nFileSpace=H5Screate_simple(3,nDims,NULL);
+      hid_t nDataSet=H5Dcreate(nGroup,"1D",H5T_NATIVE_DOUBLE,nFileSpace,H5P_DEFAULT,nCreate
+        ,H5P_DEFAULT);
+      hid_t nMemSpace=H5Screate_simple(3,nDims,NULL);
+      double *dBuffer=NULL;
+      if(procTop.nRank==0){
+        dBuffer=new double[nDims[0]*nDims[1]*nDims[2]];
+        int nIndex=0;
+        for(hsize_t i=0;i<nDims[0];i++){
+          for(hsize_t j=0;j<nDims[1];j++){
+            for(hsize_t k=0;k<nDims[2];k++){
+              dBuffer[nIndex]=grid.dLocalGridOld[n][i][j][k];
+              nIndex++;
+            }
+          }
+        }
+      }
+      else{
+        H5Sselect_none(nFileSpace);
+        H5Sselect_none(nMemSpace);
+      }
+      H5Dwrite(nDataSet,H5T_NATIVE_DOUBLE,nMemSpace,nFileSpace,nTransfer,dBuffer);
+      delete [] dBuffer;
+      H5Sclose(nMemSpace);
+      H5Dclose(nDataSet);
+      H5Sclose(nFileSpace);
+      H5Pclose(nCreate);
+    }
+    
+    //multi-dimensional region, each processor other than 0 writes its own block
+    if(procTop.nProcDims[0]>1){
+      int nPosGrid[3];
+      int nSize[3];
+      getCollectedGridSize(procTop,grid,n,nSize);
+      getCollectedGridPosition(procTop.nRank,procTop,grid.nLocalGridDims,grid,n,nPosGrid);
+      hsize_t nDims[3]={hsize_t(nSize[0]),hsize_t(nSize[1]),hsize_t(nSize[2])};
+      hsize_t nChunk[3]={std::min(nDims[0],std::max(hsize_t(1)
+        ,hsize_t(HDF5_CHUNK_SIZE)/(nDims[1]*nDims[2])))
+        ,nDims[1],nDims[2]};
+      hid_t nCreate=H5Pcreate(H5P_DATASET_CREATE);
+      H5Pset_chunk(nCreate,3,nChunk);
+      if(output.nDumpCompression>0){
+        H5Pset_deflate(nCreate,output.nDumpCompression);
+      }
+      hid_t nFileSpace=H5Screate_simple(3,nDims,NULL);
+      hid_t nDataSet=H5Dcreate(nGroup,"grid",H5T_NATIVE_DOUBLE,nFileSpace,H5P_DEFAULT,nCreate
+        ,H5P_DEFAULT);
+      
+      //each processor writes the zones it owns, see bGetOwnedZones
+      int nStart[3];
+      int nEnd[3];
+      bool bWrite=bGetOwnedZones(procTop.nRank,procTop,grid.nLocalGridDims,grid,n,nStart,nEnd);
+      hsize_t nCount[3]={1,1,1};
+      double *dBuffer=NULL;
+      if(bWrite){
+        hsize_t nOffset[3];
+        for(int l=0;l<3;l++){
+          nOffset[l]=nPosGrid[l]+nStart[l];
+          nCount[l]=nEnd[l]-nStart[l];
+        }
+        H5Sselect_hyperslab(nFileSpace,H5S_SELECT_SET,nOffset,NULL,nCount,NULL);
+        dBuffer=new double[nCount[0]*nCount[1]*nCount[2]];
+        int nIndex=0;
+        for(int i=nStart[0];i<nEnd[0];i++){
+          for(int j=nStart[1];j<nEnd[1];j++){
+            for(int k=nStart[2];k<nEnd[2];k++){
+              dBuffer[nIndex]=grid.dLocalGridOld[n][i][j][k];
+              nIndex++;
+            }
+          }
+        }
+      }
+      hid_t nMemSpace=H5Screate_simple(3,nCount,NULL);
+      if(!bWrite){
+        H5Sselect_none(nFileSpace);
+        H5Sselect_none(nMemSpace);
+      }
+      H5Dwrite(nDataSet,H5T_NATIVE_DOUBLE,nMemSpace,nFileSpace,nTransfer,dBuffer);
+      delete [] dBuffer;
+      H5Sclose(nMemSpace);
+      H5Dclose(nDataSet);
+      H5Sclose(nFileSpace);
+      H5Pclose(nCreate);
+    }
+    H5Gclose(nGroup);
+  }
+  H5Pclose(nTransfer);
+  H5Fclose(nFile);
+}
+#endif
+void setModelEOS(ProcTop &procTop,Parameters &parameters,bool bGammaLaw,double dGamma
+  ,std::string sModelEOSFileName){
   
-  if(nGammaLaw==0){//if zero use a gamma law gas
-    ifIn.read((char*)(&parameters.dGamma),sizeof(double));
+  if(bGammaLaw){//use a gamma law gas
+    parameters.dGamma=dGamma;
     parameters.bEOSGammaLaw=true;
     if(parameters.sEOSFileName.size()!=0){//if we have an EOS file name from
                                           //configuration file
@@ -1221,12 +1619,7 @@ void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
     }
   }
   else{
-    char *cBuffer=new char[nGammaLaw+1];//if nGammaLaw not zero then it is the 
-                                        //size of the string following it
-    ifIn.read(cBuffer,(nGammaLaw)*sizeof(char));
-    cBuffer[nGammaLaw]='\0';
-    std::string sTemp=cBuffer;
-    delete [] cBuffer;
+    std::string sTemp=sModelEOSFileName;
     if(parameters.sEOSFileName.size()==0){//sEOSFileName not specified in
                                           //configuration file use model EOS
                                           //file name
@@ -1241,22 +1634,10 @@ void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
     }
     parameters.bEOSGammaLaw=false;
   }
+}
+void setModelGrid(std::string sFileName,ProcTop &procTop,Grid &grid,Parameters &parameters
+  ,int *nVariableInfo){
   
-  //write out artificial viscosity
-  ifIn.read((char*)(&parameters.dA),sizeof(double));
-  
-  //write out artificial viscosity threshold
-  ifIn.read((char*)(&parameters.dAVThreshold),sizeof(double));
-  
-  //read in grid dimensions
-  ifIn.read((char*)(grid.nGlobalGridDims),3*sizeof(int));
-  
-  //allocate memory to hold periodicity, and read it in
-  procTop.nPeriodic=new int[3];
-  ifIn.read((char*)(procTop.nPeriodic),3*sizeof(int));
-  
-  //read in number of 1D zones
-  ifIn.read((char*)(&grid.nNum1DZones),sizeof(int));
   if(grid.nGlobalGridDims[0]>grid.nNum1DZones&&procTop.nNumProcs<=1){//need at least 2 processors
     /**\todo At some point should get it working with only 1 processor*/
     std::stringstream ssTemp;
@@ -1268,8 +1649,6 @@ void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
       <<") is not greater than 1. At least 2 processors are requiredfor for 3D grids.\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  ifIn.read((char*)(&grid.nNumGhostCells),sizeof(int));
-  ifIn.read((char*)(&grid.nNumVars),sizeof(int));
   
   //set number of dimensions
   if(grid.nGlobalGridDims[0]>grid.nNumGhostCells&&grid.nGlobalGridDims[1]==1
@@ -1550,8 +1929,10 @@ void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
   //set variable infos, for non-internal variables
   grid.nVariables=new int*[grid.nNumVars+grid.nNumIntVars];
   for(int n=0;n<grid.nNumVars;n++){
-    grid.nVariables[n]=new int[3];//+1 because of keeping track of time info
-    ifIn.read((char*)(grid.nVariables[n]),(4)*sizeof(int));
+    grid.nVariables[n]=new int[4];//+1 because of keeping track of time info
+    for(int l=0;l<4;l++){
+      grid.nVariables[n][l]=nVariableInfo[4*n+l];
+    }
     if(grid.nNum1DZones==grid.nGlobalGridDims[0]){//there is no need to define variable in any direction other than radial
       grid.nVariables[n][1]=-1;//not defined in theta
       grid.nVariables[n][2]=-1;//not defined in phi
@@ -1594,296 +1975,967 @@ void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
   
   //set up data storage and processor topography
   setupLocalGrid(procTop,grid);
+}
+void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
+  , Parameters &parameters){
+  
+  //if there is no collected file, but there is a set of distributed files, read them directly
+  if(!bFileExists(sFileName)&&bFileExists(sFileName+"-0")){
+    modelRead_Distributed(sFileName,procTop,grid,time,parameters);
+    return;
+  }
+  
+  //open file
+  std::ifstream ifIn;
+  ifIn.open(sFileName.c_str(),std::ios::binary);
+  if(!ifIn.is_open()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": error opening the file \""<<sFileName.c_str()<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //check file type
+  char cTemp;
+  ifIn.read((char*)(&cTemp),sizeof(char));
+  if(cTemp=='\211'){//first byte of the HDF5 file signature
+    ifIn.close();
+    #ifdef HDF5_ENABLE
+    modelRead_HDF5(sFileName,procTop,grid,time,parameters);
+    return;
+    #else
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": file \""<<sFileName<<"\" is an HDF5 file, but SPHERLS was not configured with "
+      <<"--enable-hdf5.\n";
+    throw exception2(ssTemp.str(),INPUT);
+    #endif
+  }
+  
+  ifIn.close();
+  
+  //map the file, and check its type and version
+  dumpFile dump;
+  dump.open(sFileName,DUMP_VERSION);
+  
+  //set time
+  time.dt=dump.dTime;
+  time.nTimeStepIndex=dump.nTimeStepIndex;
+  time.dDeltat_nm1half=dump.dDeltat_nm1half;
+  time.dDeltat_np1half=dump.dDeltat_np1half;
+  
+  //set other time values to reasonable initial values
+  time.dDeltat_n=(time.dDeltat_nm1half+time.dDeltat_np1half)*0.5;
+  parameters.dAlpha=dump.dAlpha;
+  
+  //set equation of state
+  setModelEOS(procTop,parameters,dump.bGammaLaw,dump.dGamma,dump.sEOSFileName);
+  
+  //set artificial viscosity
+  parameters.dA=dump.dA;
+  parameters.dAVThreshold=dump.dAVThreshold;
+  
+  //set grid dimensions, periodicity, and number of 1D zones
+  grid.nGlobalGridDims=new int[3];
+  procTop.nPeriodic=new int[3];
+  for(int l=0;l<3;l++){
+    grid.nGlobalGridDims[l]=dump.nGlobalGridDims[l];
+    procTop.nPeriodic[l]=dump.nPeriodic[l];
+  }
+  grid.nNum1DZones=dump.nNum1DZones;
+  grid.nNumGhostCells=dump.nNumGhostCells;
+  grid.nNumVars=dump.nNumVars;
+  
+  //set grid variables, and set up data storage and processor topography
+  setModelGrid(sFileName,procTop,grid,parameters,dump.nVariableInfo);
   
   if(procTop.nRank==0){//read in grid
     for(int n=0;n<grid.nNumVars;n++){
       
       int nGhostCellsX=1;
+      size_t nPos=0;//position in the values of var n
       
-      //set global size of grid for var n, minus the 1D region, and ghostcells
+      //set global size of grid for var n, minus ghostcells
       int nGlobalSize[3]={1,1,1};
-      if(grid.nVariables[n][0]!=-1){
-        nGlobalSize[0]=grid.nGlobalGridDims[0]-grid.nNum1DZones;/*don't need to add extra for
-          interface variables since 1d region allready read extra interface*/
-        if(procTop.nProcDims[0]==1){
-          nGlobalSize[0]=0;//only 1 processor in this direction, so no x-zones left
+      if(grid.nVariables[n][1]!=-1){
+        nGlobalSize[1]=grid.nGlobalGridDims[1];
+        if(procTop.nPeriodic[1]==0){//if not periodic add
+          nGlobalSize[1]+=grid.nVariables[n][1];
+        }
+      }
+      if(grid.nVariables[n][2]!=-1){
+        nGlobalSize[2]=grid.nGlobalGridDims[2];
+        if(procTop.nPeriodic[2]==0){
+          nGlobalSize[2]+=grid.nVariables[n][2];
+        }
+      }
+      if(grid.nVariables[n][0]!=-1){//only read it if variable is defined in x-direction
+      
+        //read in inner 1D region
+        for(int i=0;i<grid.nLocalGridDims[procTop.nRank][n][0]+grid.nNumGhostCells;i++){
+          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1];j++){
+            dump.copyValues(n,nPos,grid.nLocalGridDims[procTop.nRank][n][2]
+              ,grid.dLocalGridOld[n][i][j]);
+            nPos+=grid.nLocalGridDims[procTop.nRank][n][2];
+          }
         }
+        
+        int nSkipSize[3]={0,0,0};
+        if(grid.nVariables[n][1]!=-1){//y-skip size
+          if(grid.nNumDims>1){
+            nSkipSize[1]=grid.nNumGhostCells;
+            if(grid.nNumDims>2){
+              if(grid.nVariables[n][2]!=-1){
+                nSkipSize[1]=nSkipSize[1]*(2*grid.nNumGhostCells+nGlobalSize[2]);
+              }
+            }
+          }
+        }
+        if(grid.nVariables[n][2]!=-1){//z-skip size
+          if(grid.nNumDims>2){
+            nSkipSize[2]=grid.nNumGhostCells;
+          }
+        }
+        
+        //read in outter 1D region
+        for(int i=grid.nLocalGridDims[procTop.nRank][n][0]+nGhostCellsX*grid.nNumGhostCells;
+          i<grid.nLocalGridDims[procTop.nRank][n][0]+2*nGhostCellsX*grid.nNumGhostCells;i++){
+          
+          //skip inner y-ghostcells
+          nPos+=nSkipSize[1];
+          
+          for(int j=0;j<nGlobalSize[1];j++){
+            
+            //skip inner z-ghost cells
+            nPos+=nSkipSize[2];
+            
+            dump.copyValues(n,nPos,nGlobalSize[2],grid.dLocalGridOld[n][i][j]);
+            nPos+=nGlobalSize[2];
+            //may need to copy these around if the variable is not defined in y and or z directions
+            //grid will be the size of the y and z processor dimensions
+            
+            //skip outer z-ghost cells
+            nPos+=nSkipSize[2];
+          }
+          //skip outer y-ghost cells
+          nPos+=nSkipSize[1];
+        }
+        
+      }
+    }
+  }
+  else{//read in grid
+    for(int n=0;n<grid.nNumVars;n++){
+      
+      int nPosGrid[3]={0,0,0};//holds start position of processor procTop.nRank in global grid
+      size_t nPos=0;//position in the values of var n
+      
+      //add any offset due to position in dimension 2
+      for(int p=1;p<procTop.nRank;p++){
+        if(procTop.nCoords[p][2]<procTop.nCoords[procTop.nRank][2]
+          &&procTop.nCoords[p][1]==procTop.nCoords[procTop.nRank][1]
+          &&procTop.nCoords[p][0]==procTop.nCoords[procTop.nRank][0]){
+          if(grid.nVariables[n][2]!=-1){
+            nPosGrid[2]+=grid.nLocalGridDims[p][n][2];
+          }
+        }
+      }
+      
+      //Add any offset due to position in dimension 1
+      for(int p=1;p<procTop.nRank;p++){
+        if(procTop.nCoords[p][2]==procTop.nCoords[procTop.nRank][2]
+          &&procTop.nCoords[p][1]<procTop.nCoords[procTop.nRank][1]
+          &&procTop.nCoords[p][0]==procTop.nCoords[procTop.nRank][0]){
+          if(grid.nVariables[n][1]!=-1){
+            nPosGrid[1]+=grid.nLocalGridDims[p][n][1];
+          }
+        }
+      }
+      
+      //Add any offset due to position in dimension 0
+      for(int p=1;p<procTop.nRank;p++){
+        if(procTop.nCoords[p][2]==procTop.nCoords[procTop.nRank][2]
+          &&procTop.nCoords[p][1]==procTop.nCoords[procTop.nRank][1]
+          &&procTop.nCoords[p][0]<procTop.nCoords[procTop.nRank][0]){
+          if(grid.nVariables[n][0]!=-1){
+            nPosGrid[0]+=grid.nLocalGridDims[p][n][0];
+          }
+        }
+      }
+      
+      //calculate total global sizes
+      int nSize[3]={1,1,1};//1 if variable not defined in that direction
+      for(int l=0;l<3;l++){
+        if(grid.nVariables[n][l]!=-1){
+          if(procTop.nPeriodic[l]==0){
+            nSize[l]=grid.nGlobalGridDims[l]+grid.nVariables[n][l]+2*grid.nNumGhostCells;
+          }
+          else{
+            nSize[l]=grid.nGlobalGridDims[l]+2*grid.nNumGhostCells;
+          }
+        }
+      }
+      
+      //set starting position
+      int nStart=0;
+      if(procTop.nCoords[procTop.nRank][0]==1){
+        if(grid.nVariables[n][0]==1&&procTop.nPeriodic[0]==0){
+          //adds an additional number for the inner interface
+          nStart=grid.nNum1DZones+1+nPosGrid[2]+nPosGrid[1]*nSize[2]+nPosGrid[0]*nSize[2]*nSize[1];
+        }
+        else{
+          nStart=grid.nNum1DZones+nPosGrid[2]+nPosGrid[1]*nSize[2]+nPosGrid[0]*nSize[2]*nSize[1];
+        }
+      }
+      else{
+        if(grid.nVariables[n][0]==1){//adds an additional number for the inner interface
+          nStart=grid.nNum1DZones+1+grid.nNumGhostCells+nPosGrid[2]+nPosGrid[1]*nSize[2]
+          +(nPosGrid[0]-grid.nNumGhostCells)*nSize[2]*nSize[1];
+          //accounts for the fact that the first 2 ghost cells are in 1D region
+        }
+        else{
+          nStart=grid.nNum1DZones+grid.nNumGhostCells+nPosGrid[2]+nPosGrid[1]*nSize[2]
+          +(nPosGrid[0]-grid.nNumGhostCells)*nSize[2]*nSize[1];
+          //accounts for the fact that the first 2 ghost cells are in 1D region
+        }
+      }
+        
+      //find out if we need ghost cells
+      int nGhostCellsX=0;
+      if(grid.nVariables[n][0]!=-1){
+        nGhostCellsX=1;
+      }
+      int nGhostCellsY=0;
+      if(grid.nVariables[n][1]!=-1&&grid.nNumDims>1){
+        nGhostCellsY=1;
+      }
+      int nGhostCellsZ=0;
+      if(grid.nVariables[n][2]!=-1&&grid.nNumDims>2){
+        nGhostCellsZ=1;
+      }
+      
+      //calculate spacings
+      int nZSpacing=0;
+      if(grid.nVariables[n][2]!=-1){
+        nZSpacing=nSize[2]-grid.nLocalGridDims[procTop.nRank][n][2]-2*grid.nNumGhostCells;
+      }
+      int nYSpacing=0;
+      if(grid.nVariables[n][1]!=-1){
+        nYSpacing=(nSize[1]-grid.nLocalGridDims[procTop.nRank][n][1]-2*grid.nNumGhostCells)
+          *(nSize[2]);
+      }
+      int nROffset=0;
+      if(grid.nVariables[n][0]==1&&procTop.nPeriodic[0]==0){//if interface variable and not periodic
+        nROffset=1;
+      }
+      if(procTop.nCoords[procTop.nRank][0]==1){//boardering 1D region
+        
+        //read in inner ghost cells
+        nPos+=nGhostCellsX*(grid.nNum1DZones+nROffset);
+        for(int i=0;i<nGhostCellsX*grid.nNumGhostCells;i++){
+          double dTemp;
+          dump.copyValues(n,nPos,1,&dTemp);
+          nPos++;
+          
+          //copy to all y and z at that x in old grid
+          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1]
+            +nGhostCellsY*2*grid.nNumGhostCells;j++){
+            for(int k=0;k<grid.nLocalGridDims[procTop.nRank][n][2]
+              +nGhostCellsZ*2*grid.nNumGhostCells;k++){
+              grid.dLocalGridOld[n][i][j][k]=dTemp;
+            }
+          }
+        }
+        
+        //move to the start for current processor, after inner ghost cells read in
+        nPos+=nGhostCellsX*(nStart-(grid.nNum1DZones+nROffset));
+        
+        //read in rest of grid
+        for(int i=nGhostCellsX*grid.nNumGhostCells;i<grid.nLocalGridDims[procTop.nRank][n][0]
+          +nGhostCellsX*2*grid.nNumGhostCells;i++){
+          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1]
+            +nGhostCellsY*2*grid.nNumGhostCells;j++){
+            int nRowSize=grid.nLocalGridDims[procTop.nRank][n][2]
+              +nGhostCellsZ*2*grid.nNumGhostCells;
+            dump.copyValues(n,nPos,nRowSize,grid.dLocalGridOld[n][i][j]);
+            nPos+=nRowSize;
+            
+            //skip some z for other processors
+            nPos+=nZSpacing;
+          }
+          //skip some y for other processors
+          nPos+=nYSpacing;
+        }
+      }
+      else{//not boardering 1D region
+        
+        //move to the start for current processor
+        nPos+=nGhostCellsX*nStart;
+        
+        //read in rest of grid
+        for(int i=0;i<grid.nLocalGridDims[procTop.nRank][n][0]
+          +nGhostCellsX*2*grid.nNumGhostCells;i++){
+          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1]
+            +nGhostCellsY*2*grid.nNumGhostCells;j++){
+            int nRowSize=grid.nLocalGridDims[procTop.nRank][n][2]
+              +nGhostCellsZ*2*grid.nNumGhostCells;
+            dump.copyValues(n,nPos,nRowSize,grid.dLocalGridOld[n][i][j]);
+            nPos+=nRowSize;
+              
+            //skip some z for other processors
+            nPos+=nZSpacing;
+          }
+          //skip some y for other processors
+          nPos+=nYSpacing;
+        }
+      }
+    }
+  }
+}
+#ifdef HDF5_ENABLE
+hid_t openHDF5DataSet(hid_t nLocation,std::string sName,std::string sFileName,ProcTop &procTop){
+  hid_t nDataSet=H5Dopen(nLocation,sName.c_str(),H5P_DEFAULT);
+  if(nDataSet<0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": dataset \""<<sName<<"\" not found in file \""<<sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  return nDataSet;
+}
+void readHDF5Block(hid_t nDataSet,hsize_t nOffset[3],hsize_t nCount[3],double *dBuffer){
+  hid_t nFileSpace=H5Dget_space(nDataSet);
+  H5Sselect_hyperslab(nFileSpace,H5S_SELECT_SET,nOffset,NULL,nCount,NULL);
+  hid_t nMemSpace=H5Screate_simple(3,nCount,NULL);
+  H5Dread(nDataSet,H5T_NATIVE_DOUBLE,nMemSpace,nFileSpace,H5P_DEFAULT,dBuffer);
+  H5Sclose(nMemSpace);
+  H5Sclose(nFileSpace);
+}
+void modelRead_HDF5(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
+  , Parameters &parameters){
+  
+  //all processors open the file, each reads only the part of the grid it needs
+  hid_t nAccess=H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_mpio(nAccess,MPI_COMM_WORLD,MPI_INFO_NULL);
+  hid_t nFile=H5Fopen(sFileName.c_str(),H5F_ACC_RDONLY,nAccess);
+  H5Pclose(nAccess);
+  if(nFile<0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": error opening the file \""<<sFileName.c_str()<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //check file version
+  int nTemp;
+  readHDF5Attribute(nFile,"version",H5T_NATIVE_INT,&nTemp,sFileName,procTop);
+  if(nTemp!=DUMP_VERSION){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": file \""<<sFileName<<"\" has version \""<<nTemp
+      <<"\" which is not the same as the supported version \"DUMP_VERSION\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //read in time
+  readHDF5Attribute(nFile,"time",H5T_NATIVE_DOUBLE,&time.dt,sFileName,procTop);
+  readHDF5Attribute(nFile,"timeStepIndex",H5T_NATIVE_INT,&time.nTimeStepIndex,sFileName,procTop);
+  readHDF5Attribute(nFile,"deltat_nm1half",H5T_NATIVE_DOUBLE,&time.dDeltat_nm1half,sFileName
+    ,procTop);
+  readHDF5Attribute(nFile,"deltat_np1half",H5T_NATIVE_DOUBLE,&time.dDeltat_np1half,sFileName
+    ,procTop);
+  
+  //set other time values to reasonable initial values
+  time.dDeltat_n=(time.dDeltat_nm1half+time.dDeltat_np1half)*0.5;
+  
+  //read in dAlpha
+  readHDF5Attribute(nFile,"alpha",H5T_NATIVE_DOUBLE,&parameters.dAlpha,sFileName,procTop);
+  
+  //read in equation of state
+  int nGammaLaw;
+  double dGamma=0.0;
+  std::string sModelEOSFileName="";
+  readHDF5Attribute(nFile,"gammaLaw",H5T_NATIVE_INT,&nGammaLaw,sFileName,procTop);
+  if(nGammaLaw==1){
+    readHDF5Attribute(nFile,"gamma",H5T_NATIVE_DOUBLE,&dGamma,sFileName,procTop);
+  }
+  else{
+    hid_t nAttribute=H5Aopen(nFile,"eosFile",H5P_DEFAULT);
+    hid_t nString=H5Aget_type(nAttribute);
+    size_t nLength=H5Tget_size(nString);
+    char *cBuffer=new char[nLength+1];
+    H5Aread(nAttribute,nString,cBuffer);
+    cBuffer[nLength]='\0';
+    sModelEOSFileName=cBuffer;
+    delete [] cBuffer;
+    H5Tclose(nString);
+    H5Aclose(nAttribute);
+  }
+  setModelEOS(procTop,parameters,nGammaLaw==1,dGamma,sModelEOSFileName);
+  
+  //read in artificial viscosity
+  readHDF5Attribute(nFile,"A",H5T_NATIVE_DOUBLE,&parameters.dA,sFileName,procTop);
+  readHDF5Attribute(nFile,"AVThreshold",H5T_NATIVE_DOUBLE,&parameters.dAVThreshold,sFileName
+    ,procTop);
+  
+  //read in grid dimensions, and periodicity
+  grid.nGlobalGridDims=new int[3];
+  readHDF5Attribute(nFile,"globalGridDims",H5T_NATIVE_INT,grid.nGlobalGridDims,sFileName,procTop);
+  procTop.nPeriodic=new int[3];
+  readHDF5Attribute(nFile,"periodic",H5T_NATIVE_INT,procTop.nPeriodic,sFileName,procTop);
+  readHDF5Attribute(nFile,"num1DZones",H5T_NATIVE_INT,&grid.nNum1DZones,sFileName,procTop);
+  readHDF5Attribute(nFile,"numGhostCells",H5T_NATIVE_INT,&grid.nNumGhostCells,sFileName,procTop);
+  readHDF5Attribute(nFile,"numVars",H5T_NATIVE_INT,&grid.nNumVars,sFileName,procTop);
+  
+  //read in variable infos
+  int *nVariableInfo=new int[4*grid.nNumVars];
+  readHDF5Attribute(nFile,"variableInfo",H5T_NATIVE_INT,nVariableInfo,sFileName,procTop);
+  
+  //set grid variables, and set up data storage and processor topography
+  setModelGrid(sFileName,procTop,grid,parameters,nVariableInfo);
+  delete [] nVariableInfo;
+  
+  //read in grid
+  for(int n=0;n<grid.nNumVars;n++){
+    std::string sName=getVariableName(grid,n);
+    hid_t nGroup=H5Gopen(nFile,sName.c_str(),H5P_DEFAULT);
+    if(nGroup<0){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": variable \""<<sName<<"\" not found in file \""<<sFileName<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    int nPosGrid[3];
+    int nSize[3];
+    getCollectedGridSize(procTop,grid,n,nSize);
+    getCollectedGridPosition(procTop.nRank,procTop,grid.nLocalGridDims,grid,n,nPosGrid);
+    int nGhostCells[3]={0,0,0};
+    for(int l=0;l<3;l++){
+      if(grid.nVariables[n][l]!=-1){
+        nGhostCells[l]=grid.nNumGhostCells;
+      }
+    }
+    
+    if(procTop.nRank==0){
+      if(grid.nVariables[n][0]==-1){//processor 0 doesn't care about it
+        H5Gclose(nGroup);
+        continue;
+      }
+      
+      //read in 1D region
+      int nGhostCellsOuter=0;
+      if(procTop.nProcDims[0]==1){
+        nGhostCellsOuter=grid.nNumGhostCells;
+      }
+      hsize_t nOffset[3]={0,0,0};
+      hsize_t nCount[3]={hsize_t(grid.nLocalGridDims[0][n][0]+grid.nNumGhostCells
+        +nGhostCellsOuter),hsize_t(grid.nLocalGridDims[0][n][1])
+        ,hsize_t(grid.nLocalGridDims[0][n][2])};
+      double *dBuffer=new double[nCount[0]*nCount[1]*nCount[2]];
+      hid_t nDataSet=openHDF5DataSet(nGroup,"1D",sFileName,procTop);
+      readHDF5Block(nDataSet,nOffset,nCount,dBuffer);
+      H5Dclose(nDataSet);
+      int nIndex=0;
+      for(hsize_t i=0;i<nCount[0];i++){
+        for(hsize_t j=0;j<nCount[1];j++){
+          for(hsize_t k=0;k<nCount[2];k++){
+            grid.dLocalGridOld[n][i][j][k]=dBuffer[nIndex];
+            nIndex++;
+          }
+        }
+      }
+      delete [] dBuffer;
+      
+      //read in outer ghost cells from the inner edge of the multi-dimensional region
+      if(procTop.nProcDims[0]>1){
+        hsize_t nOffsetOuter[3]={0,hsize_t(nGhostCells[1]),hsize_t(nGhostCells[2])};
+        hsize_t nCountOuter[3]={hsize_t(grid.nNumGhostCells),hsize_t(nSize[1]-2*nGhostCells[1])
+          ,hsize_t(nSize[2]-2*nGhostCells[2])};
+        dBuffer=new double[nCountOuter[0]*nCountOuter[1]*nCountOuter[2]];
+        nDataSet=openHDF5DataSet(nGroup,"grid",sFileName,procTop);
+        readHDF5Block(nDataSet,nOffsetOuter,nCountOuter,dBuffer);
+        H5Dclose(nDataSet);
+        nIndex=0;
+        for(hsize_t i=0;i<nCountOuter[0];i++){
+          for(hsize_t j=0;j<nCountOuter[1];j++){
+            for(hsize_t k=0;k<nCountOuter[2];k++){
+              grid.dLocalGridOld[n][nCount[0]+i][j][k]=dBuffer[nIndex];
+              nIndex++;
+            }
+          }
+        }
+        delete [] dBuffer;
+      }
+    }
+    else{
+      
+      //processors boardering the 1D region get their inner ghost cells from the 1D region
+      int nStartX=0;
+      if(procTop.nCoords[procTop.nRank][0]==1&&nGhostCells[0]>0){
+        nStartX=grid.nNumGhostCells;
+      }
+      
+      //read in local grid
+      hsize_t nOffset[3]={hsize_t(nPosGrid[0]+nStartX),hsize_t(nPosGrid[1])
+        ,hsize_t(nPosGrid[2])};
+      hsize_t nCount[3];
+      for(int l=0;l<3;l++){
+        nCount[l]=grid.nLocalGridDims[procTop.nRank][n][l]+2*nGhostCells[l];
+      }
+      nCount[0]-=nStartX;
+      double *dBuffer=new double[nCount[0]*nCount[1]*nCount[2]];
+      hid_t nDataSet=openHDF5DataSet(nGroup,"grid",sFileName,procTop);
+      readHDF5Block(nDataSet,nOffset,nCount,dBuffer);
+      H5Dclose(nDataSet);
+      int nIndex=0;
+      for(hsize_t i=0;i<nCount[0];i++){
+        for(hsize_t j=0;j<nCount[1];j++){
+          for(hsize_t k=0;k<nCount[2];k++){
+            grid.dLocalGridOld[n][nStartX+i][j][k]=dBuffer[nIndex];
+            nIndex++;
+          }
+        }
+      }
+      delete [] dBuffer;
+      
+      if(nStartX>0){
+        
+        //read in inner ghost cells, and copy to all y and z at that x
+        hsize_t nOffsetInner[3]={hsize_t(grid.nLocalGridDims[0][n][0]),0,0};
+        hsize_t nCountInner[3]={hsize_t(grid.nNumGhostCells),1,1};
+        dBuffer=new double[grid.nNumGhostCells];
+        nDataSet=openHDF5DataSet(nGroup,"1D",sFileName,procTop);
+        readHDF5Block(nDataSet,nOffsetInner,nCountInner,dBuffer);
+        H5Dclose(nDataSet);
+        for(int i=0;i<grid.nNumGhostCells;i++){
+          for(hsize_t j=0;j<nCount[1];j++){
+            for(hsize_t k=0;k<nCount[2];k++){
+              grid.dLocalGridOld[n][i][j][k]=dBuffer[i];
+            }
+          }
+        }
+        delete [] dBuffer;
+      }
+    }
+    H5Gclose(nGroup);
+  }
+  H5Fclose(nFile);
+}
+#endif
+void readDistributedGridBlock(std::string sFileName,ProcTop &procTopDump,int ***nLocalGridDimsDump
+  ,std::streamoff nDataStart,std::ifstream *ifDump,Grid &grid,int nVar,int nStart[3]
+  ,int nCount[3],double *dBuffer){
+  
+  int nNumRead=0;
+  for(int q=1;q<procTopDump.nNumProcs;q++){
+    
+    //find the part of the requested block owned by dump processor q
+    int nOwnedStart[3];
+    int nOwnedEnd[3];
+    if(!bGetOwnedZones(q,procTopDump,nLocalGridDimsDump,grid,nVar,nOwnedStart,nOwnedEnd)){
+      continue;
+    }
+    int nPosGrid[3];
+    getCollectedGridPosition(q,procTopDump,nLocalGridDimsDump,grid,nVar,nPosGrid);
+    int nLow[3];
+    int nHigh[3];
+    bool bOverlap=true;
+    for(int l=0;l<3;l++){
+      nLow[l]=std::max(nStart[l],nPosGrid[l]+nOwnedStart[l]);
+      nHigh[l]=std::min(nStart[l]+nCount[l],nPosGrid[l]+nOwnedEnd[l]);
+      if(nLow[l]>=nHigh[l]){
+        bOverlap=false;
+      }
+    }
+    if(!bOverlap){
+      continue;
+    }
+    
+    //open the file of processor q the first time it is needed
+    if(!ifDump[q].is_open()){
+      std::ostringstream ossFileName;
+      ossFileName<<sFileName<<"-"<<q;
+      ifDump[q].open(ossFileName.str().c_str(),std::ios::binary);
+      if(!ifDump[q].is_open()){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTopDump.nRank
+          <<": error opening the file \""<<ossFileName.str()<<"\"\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+    }
+    
+    //find the start of the variable in the file, each processor writes its whole local grid
+    int nSizeFile[3];
+    std::streamoff nOffset=nDataStart;
+    for(int n=0;n<=nVar;n++){
+      for(int l=0;l<3;l++){
+        nSizeFile[l]=nLocalGridDimsDump[q][n][l];
+        if(grid.nVariables[n][l]!=-1){
+          nSizeFile[l]+=2*grid.nNumGhostCells;
+        }
+      }
+      if(n<nVar){
+        nOffset+=std::streamoff(nSizeFile[0])*nSizeFile[1]*nSizeFile[2]*sizeof(double);
+      }
+    }
+    
+    //read in the overlap one row in direction 2 at a time
+    for(int i=nLow[0];i<nHigh[0];i++){
+      for(int j=nLow[1];j<nHigh[1];j++){
+        std::streamoff nIndexFile=(std::streamoff(i-nPosGrid[0])*nSizeFile[1]+(j-nPosGrid[1]))
+          *nSizeFile[2]+(nLow[2]-nPosGrid[2]);
+        int nIndex=((i-nStart[0])*nCount[1]+(j-nStart[1]))*nCount[2]+(nLow[2]-nStart[2]);
+        ifDump[q].seekg(nOffset+nIndexFile*std::streamoff(sizeof(double)),std::ios_base::beg);
+        ifDump[q].read((char*)(dBuffer+nIndex),(nHigh[2]-nLow[2])*sizeof(double));
+        nNumRead+=nHigh[2]-nLow[2];
+      }
+    }
+    if(!ifDump[q].good()){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTopDump.nRank
+        <<": error reading the file \""<<sFileName<<"-"<<q<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+  }
+  if(nNumRead!=nCount[0]*nCount[1]*nCount[2]){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTopDump.nRank
+      <<": only "<<nNumRead<<" of "<<nCount[0]*nCount[1]*nCount[2]<<" values of variable "<<nVar
+      <<" found in the distributed files \""<<sFileName<<"-*\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+}
+void modelRead_Distributed(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
+  , Parameters &parameters){
+  
+  //all processors read the header from the file of processor 0 of the dump
+  std::ostringstream ossFileName;
+  ossFileName<<sFileName<<"-0";
+  std::ifstream ifIn;
+  ifIn.open(ossFileName.str().c_str(),std::ios::binary);
+  if(!ifIn.is_open()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": error opening the file \""<<ossFileName.str()<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //check file type
+  char cTemp;
+  ifIn.read((char*)(&cTemp),sizeof(char));
+  if(cTemp!='b'){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": file \""<<ossFileName.str()<<"\" is not a binary file.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //check file version
+  int nTemp;
+  ifIn.read((char*)(&nTemp),sizeof(int));
+  if(nTemp!=DUMP_VERSION){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": file \""<<ossFileName.str()<<"\" has version \""<<nTemp
+      <<"\" which is not the same as the supported version \"DUMP_VERSION\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //read in time
+  ifIn.read((char*)(&time.dt),sizeof(double));
+  ifIn.read((char*)(&time.nTimeStepIndex),sizeof(int));
+  ifIn.read((char*)(&time.dDeltat_nm1half),sizeof(double));
+  ifIn.read((char*)(&time.dDeltat_np1half),sizeof(double));
+  
+  //set other time values to reasonable initial values
+  time.dDeltat_n=(time.dDeltat_nm1half+time.dDeltat_np1half)*0.5;
+  
+  //read in dAlpha
+  ifIn.read((char*)(&parameters.dAlpha),sizeof(double));
+  
+  //read in equation of state
+  int nGammaLaw;
+  ifIn.read((char*)(&nGammaLaw),sizeof(int));
+  double dGamma=0.0;
+  std::string sModelEOSFileName="";
+  if(nGammaLaw==0){//if zero use a gamma law gas
+    ifIn.read((char*)(&dGamma),sizeof(double));
+  }
+  else{
+    char *cBuffer=new char[nGammaLaw+1];//if nGammaLaw not zero then it is the 
+                                        //size of the string following it
+    ifIn.read(cBuffer,(nGammaLaw)*sizeof(char));
+    cBuffer[nGammaLaw]='\0';
+    sModelEOSFileName=cBuffer;
+    delete [] cBuffer;
+  }
+  setModelEOS(procTop,parameters,nGammaLaw==0,dGamma,sModelEOSFileName);
+  
+  //read in artificial viscosity
+  ifIn.read((char*)(&parameters.dA),sizeof(double));
+  ifIn.read((char*)(&parameters.dAVThreshold),sizeof(double));
+  
+  //the rest of the header is the same size in all files
+  std::streamoff nHeaderSize=ifIn.tellg();
+  
+  //read in processor topology of the dump
+  ProcTop procTopDump;
+  procTopDump.nRank=procTop.nRank;
+  procTopDump.nProcDims=new int[3];
+  ifIn.read((char*)(procTopDump.nProcDims),3*sizeof(int));
+  procTopDump.nNumProcs=(procTopDump.nProcDims[0]-1)*procTopDump.nProcDims[1]
+    *procTopDump.nProcDims[2]+1;
+  int nCoordsTemp[3];
+  ifIn.read((char*)(nCoordsTemp),3*sizeof(int));
+  procTop.nPeriodic=new int[3];
+  ifIn.read((char*)(procTop.nPeriodic),3*sizeof(int));
+  procTopDump.nPeriodic=procTop.nPeriodic;
+  
+  //read in variable infos
+  ifIn.read((char*)(&grid.nNumVars),sizeof(int));
+  int *nVariableInfo=new int[4*grid.nNumVars];
+  ifIn.read((char*)(nVariableInfo),4*grid.nNumVars*sizeof(int));
+  
+  //read in grid dimensions
+  ifIn.read((char*)(&grid.nNum1DZones),sizeof(int));
+  grid.nGlobalGridDims=new int[3];
+  ifIn.read((char*)(grid.nGlobalGridDims),3*sizeof(int));
+  
+  //read in local grid size of processor 0 of the dump
+  int ***nLocalGridDimsDump=new int**[procTopDump.nNumProcs];
+  for(int q=0;q<procTopDump.nNumProcs;q++){
+    nLocalGridDimsDump[q]=new int*[grid.nNumVars];
+    for(int n=0;n<grid.nNumVars;n++){
+      nLocalGridDimsDump[q][n]=new int[3];
+    }
+  }
+  for(int n=0;n<grid.nNumVars;n++){
+    ifIn.read((char*)(nLocalGridDimsDump[0][n]),3*sizeof(int));
+  }
+  ifIn.read((char*)(&grid.nNumGhostCells),sizeof(int));
+  std::streamoff nDataStart0=ifIn.tellg();
+  if(!ifIn.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": error reading the header of file \""<<ossFileName.str()<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  ifIn.close();
+  
+  //set grid variables, and set up data storage and processor topography
+  setModelGrid(sFileName,procTop,grid,parameters,nVariableInfo);
+  delete [] nVariableInfo;
+  
+  //processor 0 reads the local grid sizes from the headers of the other dump files, and sends
+  //them to all processors
+  setProcCoords(procTopDump);
+  int *nSizesDump=new int[3*grid.nNumVars*procTopDump.nNumProcs];
+  if(procTop.nRank==0){
+    for(int q=1;q<procTopDump.nNumProcs;q++){
+      ossFileName.str("");
+      ossFileName<<sFileName<<"-"<<q;
+      ifIn.open(ossFileName.str().c_str(),std::ios::binary);
+      if(!ifIn.is_open()){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+          <<": error opening the file \""<<ossFileName.str()<<"\", the dump has "
+          <<procTopDump.nNumProcs<<" files\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      ifIn.seekg(nHeaderSize,std::ios_base::beg);
+      ifIn.read((char*)(nCoordsTemp),3*sizeof(int));
+      ifIn.read((char*)(&nTemp),sizeof(int));
+      if(nCoordsTemp[0]!=procTopDump.nCoords[q][0]||nCoordsTemp[1]!=procTopDump.nCoords[q][1]
+        ||nCoordsTemp[2]!=procTopDump.nCoords[q][2]||nTemp!=grid.nNumVars){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+          <<": file \""<<ossFileName.str()<<"\" does not match the processor topology or "
+          <<"number of variables in \""<<sFileName<<"-0\"\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      ifIn.seekg(4*grid.nNumVars*sizeof(int),std::ios_base::cur);
+      ifIn.read((char*)(nSizesDump+3*grid.nNumVars*q),3*grid.nNumVars*sizeof(int));
+      ifIn.close();
+    }
+  }
+  MPI::COMM_WORLD.Bcast(nSizesDump+3*grid.nNumVars,3*grid.nNumVars*(procTopDump.nNumProcs-1)
+    ,MPI::INT,0);
+  for(int q=1;q<procTopDump.nNumProcs;q++){
+    for(int n=0;n<grid.nNumVars;n++){
+      for(int l=0;l<3;l++){
+        nLocalGridDimsDump[q][n][l]=nSizesDump[3*grid.nNumVars*q+3*n+l];
+      }
+    }
+  }
+  delete [] nSizesDump;
+  for(int n=0;n<grid.nNumVars;n++){
+    for(int l=0;l<3;l++){
+      if(nLocalGridDimsDump[0][n][l]!=grid.nLocalGridDims[0][n][l]){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+          <<": size of the 1D region of variable "<<n<<" in file \""<<sFileName
+          <<"-0\" does not match the size of the 1D region of the model\n";
+        throw exception2(ssTemp.str(),INPUT);
       }
-      if(grid.nVariables[n][1]!=-1){
-        nGlobalSize[1]=grid.nGlobalGridDims[1];
-        if(procTop.nPeriodic[1]==0){//if not periodic add
-          nGlobalSize[1]+=grid.nVariables[n][1];
-        }
+    }
+  }
+  
+  //data starts after coordinates, number of variables, variable infos, local grid sizes, and
+  //number of ghost cells
+  std::streamoff nDataStart=nHeaderSize+(3+1+4*grid.nNumVars+3*grid.nNumVars+1)*sizeof(int);
+  
+  //read in grid, only opening the files which overlap the local grid
+  std::ifstream *ifDump=new std::ifstream[procTopDump.nNumProcs];
+  ossFileName.str("");
+  ossFileName<<sFileName<<"-0";
+  std::streamoff nOffset0=nDataStart0;//start of current variable in file of processor 0
+  for(int n=0;n<grid.nNumVars;n++){
+    int nGhostCells[3]={0,0,0};
+    for(int l=0;l<3;l++){
+      if(grid.nVariables[n][l]!=-1){
+        nGhostCells[l]=grid.nNumGhostCells;
       }
-      if(grid.nVariables[n][2]!=-1){
-        nGlobalSize[2]=grid.nGlobalGridDims[2];
-        if(procTop.nPeriodic[2]==0){
-          nGlobalSize[2]+=grid.nVariables[n][2];
+    }
+    
+    //size of the grid of processor 0 of the dump for this variable
+    int nSizeInner=(nLocalGridDimsDump[0][n][0]+nGhostCells[0])*nLocalGridDimsDump[0][n][1]
+      *nLocalGridDimsDump[0][n][2];
+    int nSizeOuterY=grid.nGlobalGridDims[1];
+    int nSizeOuterZ=grid.nGlobalGridDims[2];
+    if(grid.nVariables[n][1]==-1){
+      nSizeOuterY=procTopDump.nProcDims[1];
+    }
+    if(grid.nVariables[n][2]==-1){
+      nSizeOuterZ=procTopDump.nProcDims[2];
+    }
+    
+    if(procTop.nRank==0&&grid.nVariables[n][0]!=-1){
+      if(!ifDump[0].is_open()){
+        ifDump[0].open(ossFileName.str().c_str(),std::ios::binary);
+      }
+      
+      //read in 1D region, it doesn't depend on the processor topology
+      ifDump[0].seekg(nOffset0,std::ios_base::beg);
+      for(int i=0;i<grid.nLocalGridDims[0][n][0]+nGhostCells[0];i++){
+        for(int j=0;j<grid.nLocalGridDims[0][n][1];j++){
+          ifDump[0].read((char*)(grid.dLocalGridOld[n][i][j])
+            ,grid.nLocalGridDims[0][n][2]*sizeof(double));
         }
       }
-      if(grid.nVariables[n][0]!=-1){//only read it if variable is defined in x-direction
       
-        //read in inner 1D region
-        for(int i=0;i<grid.nLocalGridDims[procTop.nRank][n][0]+grid.nNumGhostCells;i++){
-          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1];j++){
-            ifIn.read((char*)(grid.dLocalGridOld[n][i][j])
-              ,(grid.nLocalGridDims[procTop.nRank][n][2])*sizeof(double));
+      //read in outer ghost cells
+      int nStartX=grid.nLocalGridDims[0][n][0]+nGhostCells[0];
+      if(procTop.nProcDims[0]>1){//from the inner edge of the multi-dimensional region
+        int nSize[3];
+        getCollectedGridSize(procTop,grid,n,nSize);
+        int nStart[3]={0,nGhostCells[1],nGhostCells[2]};
+        int nCount[3]={grid.nNumGhostCells,nSize[1]-2*nGhostCells[1],nSize[2]-2*nGhostCells[2]};
+        double *dBuffer=new double[nCount[0]*nCount[1]*nCount[2]];
+        readDistributedGridBlock(sFileName,procTopDump,nLocalGridDimsDump,nDataStart,ifDump,grid,n
+          ,nStart,nCount,dBuffer);
+        int nIndex=0;
+        for(int i=0;i<nCount[0];i++){
+          for(int j=0;j<nCount[1];j++){
+            for(int k=0;k<nCount[2];k++){
+              grid.dLocalGridOld[n][nStartX+i][j][k]=dBuffer[nIndex];
+              nIndex++;
+            }
           }
         }
-        
-        int nSkipSize[3]={0,0,0};
-        if(grid.nVariables[n][1]!=-1){//y-skip size
-          if(grid.nNumDims>1){
-            nSkipSize[1]=grid.nNumGhostCells;
-            if(grid.nNumDims>2){
-              if(grid.nVariables[n][2]!=-1){
-                nSkipSize[1]=nSkipSize[1]*(2*grid.nNumGhostCells+nGlobalSize[2]);
+        delete [] dBuffer;
+      }
+      else{//from the outer ghost cells of processor 0 of the dump
+        double *dRow=new double[nSizeOuterZ];
+        for(int i=0;i<grid.nNumGhostCells;i++){
+          for(int j=0;j<nSizeOuterY;j++){
+            ifDump[0].read((char*)(dRow),nSizeOuterZ*sizeof(double));
+            if(j<grid.nLocalGridDims[0][n][1]){
+              for(int k=0;k<nSizeOuterZ&&k<grid.nLocalGridDims[0][n][2];k++){
+                grid.dLocalGridOld[n][nStartX+i][j][k]=dRow[k];
               }
             }
           }
         }
-        if(grid.nVariables[n][2]!=-1){//z-skip size
-          if(grid.nNumDims>2){
-            nSkipSize[2]=grid.nNumGhostCells;
-          }
-        }
-        
-        //read in outter 1D region
-        for(int i=grid.nLocalGridDims[procTop.nRank][n][0]+nGhostCellsX*grid.nNumGhostCells;
-          i<grid.nLocalGridDims[procTop.nRank][n][0]+2*nGhostCellsX*grid.nNumGhostCells;i++){
-          
-          //skip inner y-ghostcells
-          ifIn.seekg(nSkipSize[1]*sizeof(double),std::ios_base::cur);
-          
-          for(int j=0;j<nGlobalSize[1];j++){
-            
-            //skip inner z-ghost cells
-            ifIn.seekg(nSkipSize[2]*sizeof(double),std::ios_base::cur);
-            
-            ifIn.read((char*)(grid.dLocalGridOld[n][i][j]),(nGlobalSize[2])*sizeof(double));
-            //may need to copy these around if the variable is not defined in y and or z directions
-            //grid will be the size of the y and z processor dimensions
-            
-            //skip outer z-ghost cells
-            ifIn.seekg(nSkipSize[2]*sizeof(double),std::ios_base::cur);
-          }
-          //skip outer y-ghost cells
-          ifIn.seekg(nSkipSize[1]*sizeof(double),std::ios_base::cur);
-        }
-        
-        //skip rest of grid for var n
-        int nNumSkip=1;
-        if(grid.nVariables[n][0]!=-1){
-          nNumSkip=nGlobalSize[0];
-        }
-        if(grid.nVariables[n][1]!=-1){
-          if(grid.nNumDims>1){
-            nNumSkip=nNumSkip*(2*grid.nNumGhostCells+nGlobalSize[1]);
-          }
-        }
-        if(grid.nVariables[n][2]!=-1){
-          if(grid.nNumDims>2){
-            nNumSkip=nNumSkip*(2*grid.nNumGhostCells+nGlobalSize[2]);
-          }
-        }
-        ifIn.seekg(nNumSkip*sizeof(double),std::ios_base::cur);
-      }
-      else{
-        //skip variable, since it isn't defined in x-direction
-        int nNumSkip=1;
-        if(grid.nVariables[n][1]!=-1){
-          if(grid.nNumDims>1){
-            nNumSkip=nNumSkip*(2*grid.nNumGhostCells+nGlobalSize[1]);
-          }
-        }
-        if(grid.nVariables[n][2]!=-1){
-          if(grid.nNumDims>2){
-            nNumSkip=nNumSkip*(2*grid.nNumGhostCells+nGlobalSize[2]);
-          }
-        }
-        ifIn.seekg(nNumSkip*sizeof(double),std::ios_base::cur);
+        delete [] dRow;
       }
     }
-  }
-  else{//read in grid
-    for(int n=0;n<grid.nNumVars;n++){
-      
-      int nPosGrid[3]={0,0,0};//holds start position of processor procTop.nRank in global grid
-      
-      //add any offset due to position in dimension 2
-      for(int p=1;p<procTop.nRank;p++){
-        if(procTop.nCoords[p][2]<procTop.nCoords[procTop.nRank][2]
-          &&procTop.nCoords[p][1]==procTop.nCoords[procTop.nRank][1]
-          &&procTop.nCoords[p][0]==procTop.nCoords[procTop.nRank][0]){
-          if(grid.nVariables[n][2]!=-1){
-            nPosGrid[2]+=grid.nLocalGridDims[p][n][2];
-          }
-        }
-      }
-      
-      //Add any offset due to position in dimension 1
-      for(int p=1;p<procTop.nRank;p++){
-        if(procTop.nCoords[p][2]==procTop.nCoords[procTop.nRank][2]
-          &&procTop.nCoords[p][1]<procTop.nCoords[procTop.nRank][1]
-          &&procTop.nCoords[p][0]==procTop.nCoords[procTop.nRank][0]){
-          if(grid.nVariables[n][1]!=-1){
-            nPosGrid[1]+=grid.nLocalGridDims[p][n][1];
-          }
-        }
-      }
+    else if(procTop.nRank!=0){
       
-      //Add any offset due to position in dimension 0
-      for(int p=1;p<procTop.nRank;p++){
-        if(procTop.nCoords[p][2]==procTop.nCoords[procTop.nRank][2]
-          &&procTop.nCoords[p][1]==procTop.nCoords[procTop.nRank][1]
-          &&procTop.nCoords[p][0]<procTop.nCoords[procTop.nRank][0]){
-          if(grid.nVariables[n][0]!=-1){
-            nPosGrid[0]+=grid.nLocalGridDims[p][n][0];
-          }
-        }
+      //processors boardering the 1D region get their inner ghost cells from the 1D region
+      int nStartX=0;
+      if(procTop.nCoords[procTop.nRank][0]==1&&nGhostCells[0]>0){
+        nStartX=grid.nNumGhostCells;
       }
       
-      //calculate total global sizes
-      int nSize[3]={1,1,1};//1 if variable not defined in that direction
+      //read in local grid
+      int nPosGrid[3];
+      getCollectedGridPosition(procTop.nRank,procTop,grid.nLocalGridDims,grid,n,nPosGrid);
+      int nStart[3]={nPosGrid[0]+nStartX,nPosGrid[1],nPosGrid[2]};
+      int nCount[3];
       for(int l=0;l<3;l++){
-        if(grid.nVariables[n][l]!=-1){
-          if(procTop.nPeriodic[l]==0){
-            nSize[l]=grid.nGlobalGridDims[l]+grid.nVariables[n][l]+2*grid.nNumGhostCells;
-          }
-          else{
-            nSize[l]=grid.nGlobalGridDims[l]+2*grid.nNumGhostCells;
+        nCount[l]=grid.nLocalGridDims[procTop.nRank][n][l]+2*nGhostCells[l];
+      }
+      nCount[0]-=nStartX;
+      double *dBuffer=new double[nCount[0]*nCount[1]*nCount[2]];
+      readDistributedGridBlock(sFileName,procTopDump,nLocalGridDimsDump,nDataStart,ifDump,grid,n
+        ,nStart,nCount,dBuffer);
+      int nIndex=0;
+      for(int i=0;i<nCount[0];i++){
+        for(int j=0;j<nCount[1];j++){
+          for(int k=0;k<nCount[2];k++){
+            grid.dLocalGridOld[n][nStartX+i][j][k]=dBuffer[nIndex];
+            nIndex++;
           }
         }
       }
+      delete [] dBuffer;
       
-      //set starting position
-      int nStart=0;
-      if(procTop.nCoords[procTop.nRank][0]==1){
-        if(grid.nVariables[n][0]==1&&procTop.nPeriodic[0]==0){
-          //adds an additional number for the inner interface
-          nStart=grid.nNum1DZones+1+nPosGrid[2]+nPosGrid[1]*nSize[2]+nPosGrid[0]*nSize[2]*nSize[1];
+      if(nStartX>0){
+        if(!ifDump[0].is_open()){
+          ifDump[0].open(ossFileName.str().c_str(),std::ios::binary);
         }
-        else{
-          nStart=grid.nNum1DZones+nPosGrid[2]+nPosGrid[1]*nSize[2]+nPosGrid[0]*nSize[2]*nSize[1];
-        }
-      }
-      else{
-        if(grid.nVariables[n][0]==1){//adds an additional number for the inner interface
-          nStart=grid.nNum1DZones+1+grid.nNumGhostCells+nPosGrid[2]+nPosGrid[1]*nSize[2]
-          +(nPosGrid[0]-grid.nNumGhostCells)*nSize[2]*nSize[1];
-          //accounts for the fact that the first 2 ghost cells are in 1D region
-        }
-        else{
-          nStart=grid.nNum1DZones+grid.nNumGhostCells+nPosGrid[2]+nPosGrid[1]*nSize[2]
-          +(nPosGrid[0]-grid.nNumGhostCells)*nSize[2]*nSize[1];
-          //accounts for the fact that the first 2 ghost cells are in 1D region
-        }
-      }
-        
-      //find out if we need ghost cells
-      int nGhostCellsX=0;
-      if(grid.nVariables[n][0]!=-1){
-        nGhostCellsX=1;
-      }
-      int nGhostCellsY=0;
-      if(grid.nVariables[n][1]!=-1&&grid.nNumDims>1){
-        nGhostCellsY=1;
-      }
-      int nGhostCellsZ=0;
-      if(grid.nVariables[n][2]!=-1&&grid.nNumDims>2){
-        nGhostCellsZ=1;
-      }
-      
-      //calculate spacings
-      int nZSpacing=0;
-      if(grid.nVariables[n][2]!=-1){
-        nZSpacing=(nSize[2]-grid.nLocalGridDims[procTop.nRank][n][2]
-          -2*grid.nNumGhostCells)*sizeof(double);
-      }
-      int nYSpacing=0;
-      if(grid.nVariables[n][1]!=-1){
-        nYSpacing=(nSize[1]-grid.nLocalGridDims[procTop.nRank][n][1]-2*grid.nNumGhostCells)
-          *(nSize[2])*sizeof(double);
-      }
-      int nROffset=0;
-      if(grid.nVariables[n][0]==1&&procTop.nPeriodic[0]==0){//if interface variable and not periodic
-        nROffset=1;
-      }
-      if(procTop.nCoords[procTop.nRank][0]==1){//boardering 1D region
         
-        //read in inner ghost cells
-        ifIn.seekg(nGhostCellsX*(grid.nNum1DZones+nROffset)*sizeof(double),std::ios_base::cur);
-        for(int i=0;i<nGhostCellsX*grid.nNumGhostCells;i++){
+        //read in inner ghost cells, and copy to all y and z at that x
+        for(int i=0;i<grid.nNumGhostCells;i++){
           double dTemp;
-          ifIn.read((char*)(&dTemp),sizeof(double));
-          
-          //copy to all y and z at that x in old grid
-          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1]
-            +nGhostCellsY*2*grid.nNumGhostCells;j++){
-            for(int k=0;k<grid.nLocalGridDims[procTop.nRank][n][2]
-              +nGhostCellsZ*2*grid.nNumGhostCells;k++){
+          ifDump[0].seekg(nOffset0+std::streamoff(grid.nLocalGridDims[0][n][0]+i)
+            *nLocalGridDimsDump[0][n][1]*nLocalGridDimsDump[0][n][2]*sizeof(double)
+            ,std::ios_base::beg);
+          ifDump[0].read((char*)(&dTemp),sizeof(double));
+          for(int j=0;j<nCount[1];j++){
+            for(int k=0;k<nCount[2];k++){
               grid.dLocalGridOld[n][i][j][k]=dTemp;
             }
           }
         }
-        
-        //move to the start for current processor, after inner ghost cells read in
-        ifIn.seekg(nGhostCellsX*(nStart-(grid.nNum1DZones+nROffset))*sizeof(double)
-          ,std::ios_base::cur);
-        
-        //read in rest of grid
-        for(int i=nGhostCellsX*grid.nNumGhostCells;i<grid.nLocalGridDims[procTop.nRank][n][0]
-          +nGhostCellsX*2*grid.nNumGhostCells;i++){
-          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1]
-            +nGhostCellsY*2*grid.nNumGhostCells;j++){
-            ifIn.read((char*)(grid.dLocalGridOld[n][i][j])
-              ,(grid.nLocalGridDims[procTop.nRank][n][2]+nGhostCellsZ*2*grid.nNumGhostCells)
-              *sizeof(double));
-            
-            //skip some z for other processors
-            ifIn.seekg(nZSpacing,std::ios_base::cur);
-          }
-          //skip some y for other processors
-          ifIn.seekg(nYSpacing,std::ios_base::cur);
-        }
-      }
-      else{//not boardering 1D region
-        
-        //move to the start for current processor
-        ifIn.seekg(nGhostCellsX*nStart*sizeof(double),std::ios_base::cur);
-        
-        //read in rest of grid
-        for(int i=0;i<grid.nLocalGridDims[procTop.nRank][n][0]
-          +nGhostCellsX*2*grid.nNumGhostCells;i++){
-          for(int j=0;j<grid.nLocalGridDims[procTop.nRank][n][1]
-            +nGhostCellsY*2*grid.nNumGhostCells;j++){
-            ifIn.read((char*)(grid.dLocalGridOld[n][i][j])
-              ,(grid.nLocalGridDims[procTop.nRank][n][2]+nGhostCellsZ*2*grid.nNumGhostCells)
-              *sizeof(double));
-              
-            //skip some z for other processors
-            ifIn.seekg(nZSpacing,std::ios_base::cur);
-          }
-          //skip some y for other processors
-          ifIn.seekg(nYSpacing,std::ios_base::cur);
-        }
       }
-      
-      //skip rest of grid for var n
-      int nTotal=nSize[2]*nSize[1]*(nSize[0]-nGhostCellsX*(grid.nNumGhostCells
-        +grid.nNum1DZones+nROffset))+nGhostCellsX*(grid.nNumGhostCells+grid.nNum1DZones+nROffset);
-      int nReadIn=nSize[2]*nSize[1]*(grid.nLocalGridDims[procTop.nRank][n][0]
-        +2*nGhostCellsX*grid.nNumGhostCells);
-      if(procTop.nCoords[procTop.nRank][0]==1){
-        nReadIn=nGhostCellsX*grid.nNumGhostCells
-          +nSize[2]*nSize[1]*(grid.nLocalGridDims[procTop.nRank][n][0]
-          +nGhostCellsX*grid.nNumGhostCells);
-      }
-      int nSkip=nTotal-nGhostCellsX*nStart-nReadIn;
-      ifIn.seekg(nSkip*sizeof(double),std::ios_base::cur);
     }
+    if(ifDump[0].is_open()&&!ifDump[0].good()){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": error reading the file \""<<ossFileName.str()<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //move to next variable in file of processor 0
+    nOffset0+=std::streamoff(nSizeInner+nGhostCells[0]*nSizeOuterY*nSizeOuterZ)*sizeof(double);
+  }
+  
+  //clean up
+  for(int q=0;q<procTopDump.nNumProcs;q++){
+    if(ifDump[q].is_open()){
+      ifDump[q].close();
+    }
+    for(int n=0;n<grid.nNumVars;n++){
+      delete [] nLocalGridDimsDump[q][n];
+    }
+    delete [] nLocalGridDimsDump[q];
+    delete [] procTopDump.nCoords[q];
   }
-  ifIn.close();
+  delete [] nLocalGridDimsDump;
+  delete [] procTopDump.nCoords;
+  delete [] procTopDump.nProcDims;
+  delete [] ifDump;
 }
 void initUpdateLocalBoundaries(ProcTop &procTop, Grid &grid, MessPass &messPass,Implicit &implicit){
   
@@ -3798,11 +4850,17 @@ void updateLocalBoundaries(ProcTop &procTop, MessPass &messPass, Grid &grid){
   //wait till all recieves complet on current processor
   MPI::Request::Waitall(procTop.nNumNeighbors,messPass.requestRecv,messPass.statusRecv);
   
+  //cube radii of the old grid, used for averaging and through out the next time step
+  updateGeometryOld(procTop,grid);
+  
   if(procTop.nRank==0){
     //average recieved values
     average3DTo1DBoundariesOld(grid);
   }
   
+  //T^4 of the old grid, after the averaging
+  updateT4Old(procTop,grid);
+  
   //wait till all sends completed on current processor, since the send buffer can't be modified 
   //until after all sends complete.
   MPI::Request::Waitall(procTop.nNumNeighbors,messPass.requestSend,messPass.statusSend);
@@ -3898,6 +4956,107 @@ void updateOldGrid(ProcTop &procTop, Grid &grid){
     }
   }
 }
+void updateGeometryOld(ProcTop &procTop, Grid &grid){
+  
+  //same extent as copied by updateNewGridWithOld
+  int nEndX=grid.nLocalGridDims[procTop.nRank][grid.nR][0]+2*grid.nNumGhostCells;
+  for(int i=0;i<nEndX;i++){
+    grid.dRSqOld[i]=grid.dLocalGridOld[grid.nR][i][0][0]*grid.dLocalGridOld[grid.nR][i][0][0];
+    grid.dRCuOld[i]=pow(grid.dLocalGridOld[grid.nR][i][0][0],3.0);
+  }
+  
+  //shells with both interfaces inside the radial extent
+  for(int i=1-grid.nCenIntOffset[0];i<nEndX-grid.nCenIntOffset[0];i++){
+    int nIInt=i+grid.nCenIntOffset[0];
+    grid.dDelRCuOld[i]=grid.dRCuOld[nIInt]-grid.dRCuOld[nIInt-1];
+    grid.dDelRSqOld[i]=grid.dRSqOld[nIInt]-grid.dRSqOld[nIInt-1];
+  }
+}
+void updateGeometryNew(ProcTop &procTop, Grid &grid){
+  int nEndX=grid.nLocalGridDims[procTop.nRank][grid.nR][0]+2*grid.nNumGhostCells;
+  for(int i=0;i<nEndX;i++){
+    grid.dRCuNew[i]=pow(grid.dLocalGridNew[grid.nR][i][0][0],3.0);
+  }
+  for(int i=1-grid.nCenIntOffset[0];i<nEndX-grid.nCenIntOffset[0];i++){
+    int nIInt=i+grid.nCenIntOffset[0];
+    grid.dDelRCuNew[i]=grid.dRCuNew[nIInt]-grid.dRCuNew[nIInt-1];
+  }
+}
+void initAngularGeometry(ProcTop &procTop, Grid &grid){
+  if(procTop.nRank==0||grid.nNumDims<2){//no angular zoning
+    return;
+  }
+  int nSizeY=grid.nLocalGridDims[procTop.nRank][grid.nDCosThetaIJK][1]+2*grid.nNumGhostCells;
+  int nSizeZ=1;
+  if(grid.nNumDims>2){
+    nSizeZ=grid.nLocalGridDims[procTop.nRank][grid.nDPhi][2]+2*grid.nNumGhostCells;
+  }
+  grid.dDCosThetaDPhi=new double*[nSizeY];
+  for(int j=0;j<nSizeY;j++){
+    grid.dDCosThetaDPhi[j]=new double[nSizeZ];
+    for(int k=0;k<nSizeZ;k++){
+      
+      /*the first ghost zone has no inner interface and isn't set by initInternalVars, nor used 
+      by the kernels*/
+      if(j==0||(grid.nNumDims>2&&k==0)){
+        grid.dDCosThetaDPhi[j][k]=0.0;
+      }
+      else if(grid.nNumDims>2){
+        grid.dDCosThetaDPhi[j][k]=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
+          *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+      }
+      else{
+        grid.dDCosThetaDPhi[j][k]=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+      }
+    }
+  }
+}
+void initRadialFacePlanes(ProcTop &procTop, Grid &grid){
+  if(procTop.nRank==0||grid.nNumDims<3){//only the 3D kernels use them
+    return;
+  }
+  
+  //large enough for both zone and interface centered quantities
+  int nSizeY=std::max(grid.nLocalGridDims[procTop.nRank][grid.nD][1]
+    ,grid.nLocalGridDims[procTop.nRank][grid.nV][1])+2*grid.nNumGhostCells;
+  int nSizeZ=std::max(grid.nLocalGridDims[procTop.nRank][grid.nD][2]
+    ,grid.nLocalGridDims[procTop.nRank][grid.nW][2])+2*grid.nNumGhostCells;
+  grid.dRadialFacePlanes=new double**[NUM_RADIAL_FACE_PLANES];
+  for(int l=0;l<NUM_RADIAL_FACE_PLANES;l++){
+    grid.dRadialFacePlanes[l]=new double*[nSizeY];
+    for(int j=0;j<nSizeY;j++){
+      grid.dRadialFacePlanes[l][j]=new double[nSizeZ];
+    }
+  }
+}
+void updateT4Old(ProcTop &procTop, Grid &grid){
+  if(grid.dT4Old==NULL){//not allocated with a gamma-law gas
+    return;
+  }
+  
+  //same extent as copied by updateNewGridWithOld
+  int nEndX=grid.nLocalGridDims[procTop.nRank][grid.nT][0]+2*grid.nNumGhostCells;
+  int nEndY=1;
+  if(grid.nNumDims>1){
+    nEndY=grid.nLocalGridDims[procTop.nRank][grid.nT][1]+2*grid.nNumGhostCells;
+  }
+  int nEndZ=1;
+  if(grid.nNumDims>2){
+    nEndZ=grid.nLocalGridDims[procTop.nRank][grid.nT][2]+2*grid.nNumGhostCells;
+  }
+  if(procTop.nRank==0){//only has 1D
+    nEndY=1;
+    nEndZ=1;
+  }
+  for(int i=0;i<nEndX;i++){
+    for(int j=0;j<nEndY;j++){
+      for(int k=0;k<nEndZ;k++){
+        double dTSq=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
+        grid.dT4Old[i][j][k]=dTSq*dTSq;
+      }
+    }
+  }
+}
 void updateNewGridWithOld(Grid &grid, ProcTop &procTop){
   //update the old grid
   for(int n=0;n<grid.nNumVars+grid.nNumIntVars;n++){
@@ -3959,8 +5118,7 @@ void average3DTo1DBoundariesOld(Grid &grid){
       
       double dSum=0.0;
       double dVolume=0.0;//total volume of shell
-      double dRFactor=0.33333333333333333*(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-        -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
+      double dRFactor=0.33333333333333333*grid.dDelRCuOld[nICen];
       
       for(int j=grid.nStartGhostUpdateExplicit[n][0][1];j<grid.nEndGhostUpdateExplicit[n][0][1];j++){
         
@@ -4016,8 +5174,7 @@ void average3DTo1DBoundariesNew(Grid &grid, int nVar){
     
     double dSum=0.0;
     double dVolume=0.0;//total volume of shell
-    double dRFactor=0.33333333333333333*(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-      -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
+    double dRFactor=0.33333333333333333*grid.dDelRCuOld[nICen];
     
     for(int j=grid.nStartGhostUpdateExplicit[nVar][0][1];j<grid.nEndGhostUpdateExplicit[nVar][0][1];
       j++){
@@ -7,7 +7,11 @@
 */
 
 #include <mpi.h>
+#include <fstream>
 #include "global.h"
+#ifdef HDF5_ENABLE
+#include <hdf5.h>
+#endif
 
 
 void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &parameters
@@ -39,6 +43,14 @@ void init(ProcTop &procTop,Grid &grid,Output &output,Time &time,Parameters &para
   @param[in] argc
   @param[in] argv
   */
+void setProcCoords(ProcTop &procTop);/**<
+  Allocates and sets the coordinates of all processors (\ref ProcTop::nCoords) from the processor
+  dimensions (\ref ProcTop::nProcDims). Processor 0 has coordinates (0,-1,-1) as it holds the 1D
+  region for all theta and phi, the other processors fill the rest of the processor grid starting
+  at 1 in direction 0.
+  
+  @param[in,out] procTop \ref ProcTop::nProcDims and \ref ProcTop::nNumProcs must be set
+  */
 void setupLocalGrid(ProcTop &procTop, Grid &grid);/**<
   Determins size of local grids (\ref Grid::nLocalGridDims) based on processor topology, and 
   allocates memory for the local grids (\ref Grid::dLocalGridNew, \ref Grid::dLocalGridOld).
@@ -93,11 +105,133 @@ void modelWrite_TEOS(std::string sFileName,ProcTop &procTop, Grid &grid, Time &t
   @param[in] time
   @param[in] parameters
   */
+std::string getVariableName(Grid &grid,int nVar);/**<
+  Returns the name of the external variable \c nVar, e.g. "M", "R", "D", "U", or "T". Variables
+  which have no name are called "var" followed by their index. These names are used for the groups
+  in HDF5 model dumps.
+  
+  @param[in] grid
+  @param[in] nVar index of the variable
+  */
+void getCollectedGridSize(ProcTop &procTop,Grid &grid,int nVar,int nSize[3]);/**<
+  Sets the size of the part of a collected binary model outside the 1D region for variable \c nVar.
+  It starts with the first radial zone outside the 1D region and includes the outer radial ghost
+  cells as well as the ghost cells in theta and phi. Directions in which the variable is not defined
+  have size 1. This layout is also used for the "grid" datasets of HDF5 model dumps.
+  
+  @param[in] procTop
+  @param[in] grid
+  @param[in] nVar index of the variable
+  @param[out] nSize size of the grid in each direction
+  */
+void getCollectedGridPosition(int nProc,ProcTop &procTop,int ***nLocalGridDims,Grid &grid
+  ,int nVar,int nPosGrid[3]);/**<
+  Sets the position of the first element, including ghost cells, of the local grid of processor
+  \c nProc in the grid described by \ref getCollectedGridSize. The processor topology and local grid
+  sizes are passed separately so that the topology of a dump can differ from the current one.
+  
+  @param[in] nProc rank of the processor
+  @param[in] procTop processor topology containing \c nProc
+  @param[in] nLocalGridDims local grid sizes of all processors in \c procTop
+  @param[in] grid
+  @param[in] nVar index of the variable
+  @param[out] nPosGrid position of the local grid
+  */
+bool bGetOwnedZones(int nProc,ProcTop &procTop,int ***nLocalGridDims,Grid &grid,int nVar
+  ,int nStart[3],int nEnd[3]);/**<
+  Sets the range of the local grid of processor \c nProc, in local indices, which it owns in the
+  grid described by \ref getCollectedGridSize. A processor owns its real zones and the ghost cells
+  at the edges of the global grid. If the variable is not defined in a direction only the first
+  processor in that direction owns it. Each zone is owned by exactly one processor, in the same way
+  as combining distributed binary files with SPHERLSanal.
+  
+  @param[in] nProc rank of the processor
+  @param[in] procTop processor topology containing \c nProc
+  @param[in] nLocalGridDims local grid sizes of all processors in \c procTop
+  @param[in] grid
+  @param[in] nVar index of the variable
+  @param[out] nStart first owned local index in each direction
+  @param[out] nEnd one past the last owned local index in each direction
+  @return false if the processor owns no zones of the variable, e.g. processor 0
+  */
+#ifdef HDF5_ENABLE
+void writeHDF5Attribute(hid_t nLocation,std::string sName,hid_t nType,int nRank,hsize_t nDims[]
+  ,void *vData);/**<
+  Creates and writes an attribute to an HDF5 file, group, or dataset. When the file is open for
+  parallel I/O all processors must call this with the same values.
+  
+  @param[in] nLocation HDF5 id of the object to attach the attribute to
+  @param[in] sName name of the attribute
+  @param[in] nType HDF5 type of the attribute
+  @param[in] nRank number of dimensions of the attribute
+  @param[in] nDims size of the attribute in each dimension
+  @param[in] vData data to write
+  */
+void readHDF5Attribute(hid_t nLocation,std::string sName,hid_t nType,void *vData
+  ,std::string sFileName,ProcTop &procTop);/**<
+  Reads an attribute from an HDF5 file, group, or dataset. Throws an exception if the attribute
+  does not exist.
+  
+  @param[in] nLocation HDF5 id of the object the attribute is attached to
+  @param[in] sName name of the attribute
+  @param[in] nType HDF5 type to read the attribute as
+  @param[out] vData buffer to hold the attribute
+  @param[in] sFileName name of the file, used for error messages
+  @param[in] procTop
+  */
+void modelWrite_HDF5(std::string sFileName,Output &output,ProcTop &procTop, Grid &grid
+  ,Time &time, Parameters &parameters);/**<
+  Writes out a model to a single HDF5 file, "sFileName.h5", with all processors writing their part
+  of the grid using collective parallel I/O. The header is stored as attributes of the root group.
+  Each variable has a group named by \ref getVariableName containing a "1D" dataset, with the grid
+  of processor 0 including its inner ghost cells, and if there is more than one processor in the
+  radial direction a "grid" dataset described in \ref getCollectedGridSize. Each processor writes
+  the zones given by \ref bGetOwnedZones. Datasets are chunked to about \ref HDF5_CHUNK_SIZE
+  values, and compressed if \ref Output::nDumpCompression is greater than 0. Works for both
+  gamma-law gas, and tabulated equation of state models. Requires an HDF5 library built with
+  parallel support.
+  
+  @param[in] sFileName base name of the output file
+  @param[in] output
+  @param[in] procTop
+  @param[in] grid
+  @param[in] time
+  @param[in] parameters
+  */
+#endif
+void setModelEOS(ProcTop &procTop,Parameters &parameters,bool bGammaLaw,double dGamma
+  ,std::string sModelEOSFileName);/**<
+  Sets the equation of state from the values read in from a model. If the model uses a tabulated
+  equation of state, the file given in the configuration file takes precedence over the one from
+  the model, and a warning is printed if they differ.
+  
+  @param[in] procTop
+  @param[in,out] parameters
+  @param[in] bGammaLaw true if the model uses a gamma-law gas
+  @param[in] dGamma value of gamma for a gamma-law gas
+  @param[in] sModelEOSFileName name of the equation of state file given in the model
+  */
+void setModelGrid(std::string sFileName,ProcTop &procTop,Grid &grid,Parameters &parameters
+  ,int *nVariableInfo);/**<
+  Sets the number of dimensions, checks the grid dimensions, and sets the indices of the external and
+  internal variables from the header of a model. It then sets the variable infos, sets the internal
+  variable infos by calling \ref setInternalVarInf, and calls \ref setupLocalGrid to allocate
+  memory. \ref Grid::nGlobalGridDims, \ref Grid::nNum1DZones, \ref Grid::nNumGhostCells,
+  \ref Grid::nNumVars, and \ref ProcTop::nPeriodic must already be set.
+  
+  @param[in] sFileName name of the model file, used for error messages
+  @param[in,out] procTop
+  @param[in,out] grid
+  @param[in] parameters
+  @param[in] nVariableInfo variable infos of the external variables, 4 for each variable
+  */
 void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
   , Parameters &parameters);/**<
   Reads in a collected binary file into the local grid and calls \ref setupLocalGrid to allocate
   memory and set various parameters of the model. Works for both gamma-law gas, and tabulated
-  equation of state models.
+  equation of state models. If the file is an HDF5 file \ref modelRead_HDF5 is used instead, and if
+  the file doesn't exist but a set of distributed files "sFileName-<rank>" does,
+  \ref modelRead_Distributed is used.
   
   @param[in] sFileName name of the file containing the model to be read in
   @param[out] procTop 
@@ -105,6 +239,71 @@ void modelRead(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
   @param[out] time
   @param[out] parameters
   */
+#ifdef HDF5_ENABLE
+hid_t openHDF5DataSet(hid_t nLocation,std::string sName,std::string sFileName
+  ,ProcTop &procTop);/**<
+  Opens a dataset in an HDF5 file or group. Throws an exception if the dataset does not exist.
+  
+  @param[in] nLocation HDF5 id of the file or group containing the dataset
+  @param[in] sName name of the dataset
+  @param[in] sFileName name of the file, used for error messages
+  @param[in] procTop
+  */
+void readHDF5Block(hid_t nDataSet,hsize_t nOffset[3],hsize_t nCount[3],double *dBuffer);/**<
+  Reads a 3D block from an HDF5 dataset of doubles into a contiguous buffer.
+  
+  @param[in] nDataSet HDF5 id of the dataset
+  @param[in] nOffset start of the block in the dataset
+  @param[in] nCount size of the block
+  @param[out] dBuffer buffer of size nCount[0]*nCount[1]*nCount[2]
+  */
+void modelRead_HDF5(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
+  , Parameters &parameters);/**<
+  Reads in a model written by \ref modelWrite_HDF5. Each processor reads only the part of the
+  datasets which overlaps its local grid, including ghost cells, so the number of processors may
+  differ from the run which wrote the file.
+  
+  @param[in] sFileName name of the file containing the model to be read in
+  @param[out] procTop 
+  @param[out] grid
+  @param[out] time
+  @param[out] parameters
+  */
+#endif
+void readDistributedGridBlock(std::string sFileName,ProcTop &procTopDump,int ***nLocalGridDimsDump
+  ,std::streamoff nDataStart,std::ifstream *ifDump,Grid &grid,int nVar,int nStart[3]
+  ,int nCount[3],double *dBuffer);/**<
+  Reads a block of the grid described by \ref getCollectedGridSize from a set of distributed binary
+  files written by \ref modelWrite_GL or \ref modelWrite_TEOS. Only the files of processors which
+  own part of the block, as given by \ref bGetOwnedZones, are opened and read, one row in direction
+  2 at a time. Throws an exception if part of the block is not found in any file.
+  
+  @param[in] sFileName base name of the distributed files
+  @param[in] procTopDump processor topology of the run which wrote the files
+  @param[in] nLocalGridDimsDump local grid sizes of the processors in \c procTopDump
+  @param[in] nDataStart offset of the grid in the files of processors other than 0
+  @param[in,out] ifDump array of file streams, one for each processor in \c procTopDump, files are
+    opened the first time they are needed
+  @param[in] grid
+  @param[in] nVar index of the variable
+  @param[in] nStart start of the block
+  @param[in] nCount size of the block
+  @param[out] dBuffer buffer of size nCount[0]*nCount[1]*nCount[2]
+  */
+void modelRead_Distributed(std::string sFileName,ProcTop &procTop, Grid &grid, Time &time
+  , Parameters &parameters);/**<
+  Reads in a model directly from the set of distributed binary files "sFileName-<rank>" written by
+  \ref modelWrite_GL or \ref modelWrite_TEOS, without first combining them with SPHERLSanal. The
+  processor topology of the dump is read from the file of processor 0, and each processor reads
+  only the parts of the files which overlap its local grid, so the processor topology may differ
+  from the run which wrote the files.
+  
+  @param[in] sFileName base name of the distributed files
+  @param[out] procTop 
+  @param[out] grid
+  @param[out] time
+  @param[out] parameters
+  */
 void initUpdateLocalBoundaries(ProcTop &procTop, Grid &grid, MessPass &messPass
   ,Implicit &implicit);/**<
   Sets up MPI derived data types used for updating the local grid boundaries
@@ -149,6 +348,44 @@ void updateLocalBoundariesNewGrid(int nVar, ProcTop &procTop, MessPass &messPass
 void updateOldGrid(ProcTop &procTop, Grid &grid);/**<
   Updates the old grid with the new grid, not including boundaries.
   
+  @param[in] procTop
+  @param[in,out] grid
+  */
+void updateGeometryOld(ProcTop &procTop, Grid &grid);/**<
+  Sets the radial geometry of the old grid, \ref Grid::dRCuOld, \ref Grid::dRSqOld,
+  \ref Grid::dDelRCuOld and \ref Grid::dDelRSqOld. It is called by \ref updateLocalBoundaries
+  once the old grid is complete, so that the kernels and averages of the next time step can use
+  them instead of computing them again for every zone.
+  
+  @param[in] procTop
+  @param[in,out] grid
+  */
+void updateGeometryNew(ProcTop &procTop, Grid &grid);/**<
+  Sets the radial geometry of the new grid, \ref Grid::dRCuNew and \ref Grid::dDelRCuNew. It
+  should be called once the new radii and their boundaries have been calculated.
+  
+  @param[in] procTop
+  @param[in,out] grid
+  */
+void initAngularGeometry(ProcTop &procTop, Grid &grid);/**<
+  Allocates and sets \ref Grid::dDCosThetaDPhi from the angular zoning set by 
+  \ref initInternalVars. It does nothing in 1D and for the 1D region.
+  
+  @param[in] procTop
+  @param[in,out] grid
+  */
+void initRadialFacePlanes(ProcTop &procTop, Grid &grid);/**<
+  Allocates \ref Grid::dRadialFacePlanes for 3D calculations. It does nothing in 1D, 2D and for
+  the 1D region.
+  
+  @param[in] procTop
+  @param[in,out] grid
+  */
+void updateT4Old(ProcTop &procTop, Grid &grid);/**<
+  Sets \ref Grid::dT4Old, the fourth power of the temperatures of the old grid, if a tabulated
+  equation of state is used. It is called by \ref updateLocalBoundaries after the 3D boundary has
+  been averaged.
+  
   @param[in] procTop
   @param[in,out] grid
   */
@@ -13,6 +13,7 @@
 #include <cmath>
 #include <iomanip>
 #include <string>
+#include <limits>
 #include "watchzone.h"
 #include "exception2.h"
 #include "xmlFunctions.h"
@@ -26,8 +27,54 @@ void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
   , Parameters &parameters, Time &time){
   
   XMLNode xWatchZones=getXMLNodeNoThrow(xParent,"watchZones",0);
+  std::vector<WatchZone> vecWatchZonesGlobal;
+  std::vector<WatchZone> vecWatchZonesLocal;
+  std::vector<int> vecnOwners;
   
   if(!xWatchZones.isEmpty()){//if there are watch zones set
+    
+    //get format of watch zone files
+    std::string sFormat;
+    if(getXMLAttributeNoThrow(xWatchZones,"format",sFormat)){
+      if(sFormat.compare("text")==0){
+        output.nWatchZoneFormat=0;
+      }
+      else if(sFormat.compare("binary")==0){
+        output.nWatchZoneFormat=1;
+      }
+      else{
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+          <<": unknown watch zone format \""<<sFormat<<"\", expecting \"text\" or \"binary\"\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+    }
+    
+    //get buffering of watch zone files
+    getXMLAttributeNoThrow(xWatchZones,"bufferSize",output.nWatchZoneBufferSize);
+    if(output.nWatchZoneBufferSize<0){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": watch zone bufferSize must be non-negative, got "<<output.nWatchZoneBufferSize<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    getXMLAttributeNoThrow(xWatchZones,"flushFrequency",output.nWatchZoneFlushFrequency);
+    if(output.nWatchZoneFlushFrequency<0){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": watch zone flushFrequency must be non-negative, got "<<output.nWatchZoneFlushFrequency
+        <<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    getXMLAttributeNoThrow(xWatchZones,"gatherFrequency",output.nWatchZoneGatherFrequency);
+    if(output.nWatchZoneGatherFrequency<1){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": watch zone gatherFrequency must be at least 1, got "
+        <<output.nWatchZoneGatherFrequency<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
     int w=0;
     XMLNode xTemp=getXMLNodeNoThrow(xWatchZones,"watchZone",w);
     while(!xTemp.isEmpty()){
@@ -124,7 +171,7 @@ void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
       int nEndX2=0;
       for(int p=0;p<procTop.nNumProcs;p++){
         if( (procTop.nCoords[p][0]==procTop.nCoords[procTop.nRank][0]||procTop.nCoords[p][0]==-1)
-          &&(procTop.nCoords[p][1]==procTop.nCoords[procTop.nRank][1]||procTop.nCoords[p][0]==-1)
+          &&(procTop.nCoords[p][1]==procTop.nCoords[procTop.nRank][1]||procTop.nCoords[p][1]==-1)
           &&(procTop.nCoords[p][2]<procTop.nCoords[procTop.nRank][2])){
           nStartX2+=grid.nLocalGridDims[p][grid.nD][2];
         }
@@ -143,12 +190,18 @@ void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
         bOnLocalGrid=false;
       }
       
-      /*Note: the above if's don't work if the model is 1D*/
-      if(bOnGlobalGrid && bOnLocalGrid){//if on local and global grid add to list
+      if(bOnGlobalGrid){//add to list of zones to watch
         
         //set output file name
         std::stringstream ssTemp;
-        ssTemp<<output.sBaseOutputFileName<<"_watchZone_r"<<nITemp<<"_t"<<nJTemp<<"_p"<<nKTemp<<".txt";
+        ssTemp<<output.sBaseOutputFileName<<"_watchZone_r"<<nITemp<<"_t"<<nJTemp<<"_p"<<nKTemp;
+        if(output.nWatchZoneFormat==1){
+          ssTemp<<".bin";
+        }
+        else{
+          ssTemp<<".txt";
+        }
+        vecWatchZonesGlobal.push_back(WatchZone(nITemp,nJTemp,nKTemp,ssTemp.str()));
         
         //adjust position to fall on local grid
         if(nStartX0!=0){
@@ -160,14 +213,18 @@ void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
         if(nStartX2!=0){
           nStartX2-=grid.nNumGhostCells;
         }
-        nITemp-=nStartX0;
-        nJTemp-=nStartX1;
-        nKTemp-=nStartX2;
+        vecWatchZonesLocal.push_back(WatchZone(nITemp-nStartX0,nJTemp-nStartX1,nKTemp-nStartX2
+          ,ssTemp.str()));
         
-        //save watch zone
-        output.watchzoneList.push_back(WatchZone (nITemp,nJTemp,nKTemp,ssTemp.str()));
+        //candidate owner, procTop.nNumProcs if not on the local grid
+        if(bOnLocalGrid){
+          vecnOwners.push_back(procTop.nRank);
+        }
+        else{
+          vecnOwners.push_back(procTop.nNumProcs);
+        }
       }
-      if(!bOnGlobalGrid){
+      else{
         std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
         <<": WARNING the watch zone ("<<nITemp<<","<<nJTemp<<","<<nKTemp<<") is not being included "
         "since it isn't on the global grid.\n";
@@ -179,36 +236,111 @@ void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
     }
   }
   
+  //pick a single owning processor for each zone, the lowest rank that has it on its local grid
+  std::vector<int> vecnOwnersGlobal(vecnOwners.size());
+  if(vecnOwners.size()>0){
+    MPI::COMM_WORLD.Allreduce(&vecnOwners[0],&vecnOwnersGlobal[0],vecnOwners.size(),MPI::INT
+      ,MPI_MIN);
+  }
+  for(unsigned int n=0;n<vecnOwnersGlobal.size();n++){
+    if(vecnOwnersGlobal[n]==procTop.nNumProcs){
+      if(procTop.nRank==0){
+        std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+          <<": WARNING the watch zone ("<<vecWatchZonesGlobal[n].i<<","<<vecWatchZonesGlobal[n].j
+          <<","<<vecWatchZonesGlobal[n].k<<") is not being included since no processor has it on "
+          <<"its local grid.\n";
+      }
+      continue;
+    }
+    output.watchzoneGlobalList.push_back(vecWatchZonesGlobal[n]);
+    output.nWatchZoneOwners.push_back(vecnOwnersGlobal[n]);
+    if(vecnOwnersGlobal[n]==procTop.nRank){
+      output.watchzoneList.push_back(vecWatchZonesLocal[n]);
+    }
+  }
+  output.dWatchZoneSamples.reserve(output.nWatchZoneGatherFrequency*output.watchzoneList.size()
+    *(nNumWatchZoneColumns+1));
+  output.nNumWatchZoneSamples=0;
+  
+  //only processor 0 writes the watch zone files
+  if(procTop.nRank!=0){
+    return;
+  }
+  
   //open files for watch zones
-  output.ofWatchZoneFiles=new std::ofstream[output.watchzoneList.size()];
-  for(unsigned int i=0;i<output.watchzoneList.size();i++){
-    bool bAppend=bFileExists(output.watchzoneList[i].sOutFileName);
+  output.ofWatchZoneFiles=new std::ofstream[output.watchzoneGlobalList.size()];
+  output.cWatchZoneBuffers=new char*[output.watchzoneGlobalList.size()];
+  for(unsigned int i=0;i<output.watchzoneGlobalList.size();i++){
+    
+    //give the stream a large buffer so that it is only written when full or flushed, this must be
+    //done before the file is opened
+    output.cWatchZoneBuffers[i]=NULL;
+    if(output.nWatchZoneBufferSize>0){
+      output.cWatchZoneBuffers[i]=new char[output.nWatchZoneBufferSize];
+      output.ofWatchZoneFiles[i].rdbuf()->pubsetbuf(output.cWatchZoneBuffers[i]
+        ,output.nWatchZoneBufferSize);
+    }
+    
+    std::ios::openmode nMode=ios::out;
+    if(output.nWatchZoneFormat==1){
+      nMode|=ios::binary;
+    }
+    bool bAppend=bFileExists(output.watchzoneGlobalList[i].sOutFileName);
     if(time.nTimeStepIndex!=0&&bAppend){//append to end of file
+      
       //open file and go to the start of the line for the current time step
-      output.ofWatchZoneFiles[i].open(output.watchzoneList[i].sOutFileName.c_str(),ios::in|ios::out);
-      output.ofWatchZoneFiles[i].seekp((time.nTimeStepIndex+2)*(9+23*23)*sizeof(char));
+      output.ofWatchZoneFiles[i].open(output.watchzoneGlobalList[i].sOutFileName.c_str()
+        ,nMode|ios::in);
+      if(output.nWatchZoneFormat==1){
+        output.ofWatchZoneFiles[i].seekp(nWatchZoneBinHeaderSize
+          +std::streamoff(time.nTimeStepIndex)*nWatchZoneBinRecordSize);
+      }
+      else{
+        output.ofWatchZoneFiles[i].seekp((time.nTimeStepIndex+2)*(9+23*23)*sizeof(char));
+      }
     }
     else{//open a new file
-      output.ofWatchZoneFiles[i].open(output.watchzoneList[i].sOutFileName.c_str());
+      output.ofWatchZoneFiles[i].open(output.watchzoneGlobalList[i].sOutFileName.c_str(),nMode);
     }
     if(!output.ofWatchZoneFiles[i].good()){//didn't open properly
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
-        <<": error opening the file \""<<output.watchzoneList[i].sOutFileName<<"\"\n";
+        <<": error opening the file \""<<output.watchzoneGlobalList[i].sOutFileName<<"\"\n";
       throw exception2(ssTemp.str(),OUTPUT);
     }
     
+    if(output.nWatchZoneFormat==1){
+      if(time.nTimeStepIndex==0||!bAppend){//write out file header
+        char cTemp='w';
+        int nTemp=1;//version
+        output.ofWatchZoneFiles[i].write((char*)(&cTemp),sizeof(char));
+        output.ofWatchZoneFiles[i].write((char*)(&nTemp),sizeof(int));
+        output.ofWatchZoneFiles[i].write((char*)(&output.watchzoneGlobalList[i].i),sizeof(int));
+        output.ofWatchZoneFiles[i].write((char*)(&output.watchzoneGlobalList[i].j),sizeof(int));
+        output.ofWatchZoneFiles[i].write((char*)(&output.watchzoneGlobalList[i].k),sizeof(int));
+        nTemp=0;
+        if(parameters.bEOSGammaLaw){
+          nTemp=1;
+        }
+        output.ofWatchZoneFiles[i].write((char*)(&nTemp),sizeof(int));
+        output.ofWatchZoneFiles[i].write((char*)(&parameters.dGamma),sizeof(double));
+        nTemp=nNumWatchZoneColumns;
+        output.ofWatchZoneFiles[i].write((char*)(&nTemp),sizeof(int));
+      }
+      continue;
+    }
+    
     output.ofWatchZoneFiles[i].precision(14);
     output.ofWatchZoneFiles[i].setf(std::ios::scientific);
     int nWidthOutputField=23;
     if(time.nTimeStepIndex==0||!bAppend){//write out file header
       stringstream ssHeader;
-      ssHeader<<"zone= ("<<output.watchzoneList[i].i<<","<<output.watchzoneList[i].j<<","
-      <<output.watchzoneList[i].k<<")";
+      ssHeader<<"zone= ("<<output.watchzoneGlobalList[i].i<<","<<output.watchzoneGlobalList[i].j
+        <<","<<output.watchzoneGlobalList[i].k<<")";
       if(parameters.bEOSGammaLaw){
         ssHeader<<" gamma= "<<parameters.dGamma;
       }
-      output.ofWatchZoneFiles[i]<<std::setw(8+23*23)<<std::left<<ssHeader.str()<<std::endl;
+      output.ofWatchZoneFiles[i]<<std::setw(8+23*23)<<std::left<<ssHeader.str()<<"\n";
       output.ofWatchZoneFiles[i]<<std::right;
       output.ofWatchZoneFiles[i]
         <<std::setw(8)<<"j(1)"
@@ -239,387 +371,744 @@ void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
     }
   }
 }
+void bufferWatchZoneSample(Output &output, Time &time, double dValues[]){
+  output.dWatchZoneSamples.push_back(double(time.nTimeStepIndex));
+  output.dWatchZoneSamples.insert(output.dWatchZoneSamples.end(),dValues
+    ,dValues+nNumWatchZoneColumns);
+}
+void writeWatchZoneRecord(Output &output, unsigned int nZone, double dRecord[]){
+  int nTimeStepIndex=int(dRecord[0]);
+  double *dValues=dRecord+1;
+  if(output.nWatchZoneFormat==1){
+    output.ofWatchZoneFiles[nZone].write((char*)(&nTimeStepIndex),sizeof(int));
+    output.ofWatchZoneFiles[nZone].write((char*)(dValues),nNumWatchZoneColumns*sizeof(double));
+  }
+  else{
+    int nWidthOutputField=23;
+    output.ofWatchZoneFiles[nZone]<<std::setw(8)<<nTimeStepIndex;
+    for(int n=0;n<nNumWatchZoneColumns;n++){
+      output.ofWatchZoneFiles[nZone]<<std::setw(nWidthOutputField);
+      if(dValues[n]!=dValues[n]){//not defined for this zone
+        output.ofWatchZoneFiles[nZone]<<"-";
+      }
+      else{
+        output.ofWatchZoneFiles[nZone]<<dValues[n];
+      }
+    }
+    output.ofWatchZoneFiles[nZone]<<"\n";
+  }
+}
+void flushWatchZones(Output &output, ProcTop &procTop, bool bForce){
+  
+  //all processors know the number of zones and samples, so all return here together
+  if(output.watchzoneGlobalList.size()==0||output.nNumWatchZoneSamples==0){
+    return;
+  }
+  if(!bForce&&output.nNumWatchZoneSamples<output.nWatchZoneGatherFrequency){
+    return;
+  }
+  
+  //processor 0 knows how many zones each processor owns, so it can work out the message sizes
+  int nRecordSize=nNumWatchZoneColumns+1;
+  int *nRecvCounts=NULL;
+  int *nDispls=NULL;
+  std::vector<double> dRecvBuffer;
+  std::vector<std::vector<unsigned int> > vecnZonesOnProc;
+  if(procTop.nRank==0){
+    vecnZonesOnProc.resize(procTop.nNumProcs);
+    for(unsigned int n=0;n<output.nWatchZoneOwners.size();n++){
+      vecnZonesOnProc[output.nWatchZoneOwners[n]].push_back(n);
+    }
+    nRecvCounts=new int[procTop.nNumProcs];
+    nDispls=new int[procTop.nNumProcs];
+    int nTotal=0;
+    for(int p=0;p<procTop.nNumProcs;p++){
+      nRecvCounts[p]=vecnZonesOnProc[p].size()*output.nNumWatchZoneSamples*nRecordSize;
+      nDispls[p]=nTotal;
+      nTotal+=nRecvCounts[p];
+    }
+    dRecvBuffer.resize(nTotal);
+  }
+  
+  //gather all samples to processor 0 in one message from each processor
+  double dDummy=0.0;
+  double *dSend=&dDummy;
+  if(output.dWatchZoneSamples.size()>0){
+    dSend=&output.dWatchZoneSamples[0];
+  }
+  double *dRecv=&dDummy;
+  if(dRecvBuffer.size()>0){
+    dRecv=&dRecvBuffer[0];
+  }
+  MPI::COMM_WORLD.Gatherv(dSend,output.dWatchZoneSamples.size(),MPI::DOUBLE,dRecv,nRecvCounts
+    ,nDispls,MPI::DOUBLE,0);
+  output.dWatchZoneSamples.clear();
+  
+  //write out samples, each processor's samples are ordered by time step then by zone
+  if(procTop.nRank==0){
+    for(int p=0;p<procTop.nNumProcs;p++){
+      int nNumZones=vecnZonesOnProc[p].size();
+      for(int s=0;s<output.nNumWatchZoneSamples;s++){
+        for(int z=0;z<nNumZones;z++){
+          writeWatchZoneRecord(output,vecnZonesOnProc[p][z]
+            ,&dRecvBuffer[nDispls[p]+(s*nNumZones+z)*nRecordSize]);
+        }
+      }
+    }
+    delete [] nRecvCounts;
+    delete [] nDispls;
+    
+    output.nNumTimeStepsSinceLastWatchZoneFlush+=output.nNumWatchZoneSamples;
+    if(bForce||(output.nWatchZoneFlushFrequency>0
+      &&output.nNumTimeStepsSinceLastWatchZoneFlush>=output.nWatchZoneFlushFrequency)){
+      for(unsigned int i=0;i<output.watchzoneGlobalList.size();i++){
+        output.ofWatchZoneFiles[i].flush();
+      }
+      output.nNumTimeStepsSinceLastWatchZoneFlush=0;
+    }
+  }
+  output.nNumWatchZoneSamples=0;
+}
 void writeWatchZones_R_GL(Output &output, Grid &grid, Parameters &parameters, Time &time
   , ProcTop &procTop){
+  double dValues[nNumWatchZoneColumns];
+  double dUndefined=std::numeric_limits<double>::quiet_NaN();
   for(unsigned int i=0;i<output.watchzoneList.size();i++){
     
     //calculate zone mass
     double dM=grid.dLocalGridOld[grid.nDM][output.watchzoneList[i].i][0][0];
     double dMCalc=4.0/3.0*parameters.dPi*grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][0][0]
-      *(pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i+grid.nCenIntOffset[0]][0][0],3.0)
-      -pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i-1+grid.nCenIntOffset[0]][0][0],3.0));
+      *grid.dDelRCuOld[output.watchzoneList[i].i];
     
-    int nWidthOutputField=23;
-    int nIInt=output.watchzoneList[i].i+grid.nCenIntOffset[0];
-    output.ofWatchZoneFiles[i]
-      <<std::setw(8)<<time.nTimeStepIndex
-      <<std::setw(nWidthOutputField)<<time.dt
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt-1][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nQ0][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"//V_ijp1halfk
-      <<std::setw(nWidthOutputField)<<"-"//V_ijm1halfk
-      <<std::setw(nWidthOutputField)<<"-"//Q1
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkp1half
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkm1half
-      <<std::setw(nWidthOutputField)<<"-"//Q2
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nE][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nP][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"//T
-      <<std::setw(nWidthOutputField)<<dM
-      <<std::setw(nWidthOutputField)<<dMCalc
-      <<std::setw(nWidthOutputField)<<(dM-dMCalc)/dM
-      <<std::endl;
+    int nI=output.watchzoneList[i].i;
+    int nJ=output.watchzoneList[i].j;
+    int nK=output.watchzoneList[i].k;
+    int nIInt=nI+grid.nCenIntOffset[0];
+    dValues[0]=time.dt;
+    dValues[1]=grid.dLocalGridOld[grid.nU][nIInt][nJ][nK];
+    dValues[2]=grid.dLocalGridOld[grid.nU][nIInt-1][nJ][nK];
+    dValues[3]=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+    dValues[4]=grid.dLocalGridOld[grid.nU0][nIInt-1][0][0];
+    dValues[5]=grid.dLocalGridOld[grid.nQ0][nI][nJ][nK];
+    dValues[6]=dUndefined;//V_ijp1halfk
+    dValues[7]=dUndefined;//V_ijm1halfk
+    dValues[8]=dUndefined;//Q1
+    dValues[9]=dUndefined;//W_ijkp1half
+    dValues[10]=dUndefined;//W_ijkm1half
+    dValues[11]=dUndefined;//Q2
+    dValues[12]=grid.dLocalGridOld[grid.nR][nIInt][0][0];
+    dValues[13]=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
+    dValues[14]=grid.dLocalGridOld[grid.nD][nI][nJ][nK];
+    dValues[15]=grid.dLocalGridOld[grid.nD][nI][0][0];
+    dValues[16]=dUndefined;//eddy viscosity
+    dValues[17]=grid.dLocalGridOld[grid.nE][nI][nJ][nK];
+    dValues[18]=grid.dLocalGridOld[grid.nP][nI][nJ][nK];
+    dValues[19]=dUndefined;//T
+    dValues[20]=dM;
+    dValues[21]=dMCalc;
+    dValues[22]=(dM-dMCalc)/dM;
+    bufferWatchZoneSample(output,time,dValues);
   }
+  output.nNumWatchZoneSamples++;
+  flushWatchZones(output,procTop,false);
 }
 void writeWatchZones_R_TEOS(Output &output, Grid &grid, Parameters &parameters, Time &time
   , ProcTop &procTop){
+  double dValues[nNumWatchZoneColumns];
+  double dUndefined=std::numeric_limits<double>::quiet_NaN();
   for(unsigned int i=0;i<output.watchzoneList.size();i++){
     
     //calculate zone mass
     double dM=grid.dLocalGridOld[grid.nDM][output.watchzoneList[i].i][0][0];
     double dMCalc=4.0/3.0*parameters.dPi*grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][0][0]
-      *(pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i+grid.nCenIntOffset[0]][0][0],3.0)
-      -pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i-1+grid.nCenIntOffset[0]][0][0],3.0));
+      *grid.dDelRCuOld[output.watchzoneList[i].i];
     
-    int nWidthOutputField=23;
-    int nIInt=output.watchzoneList[i].i+grid.nCenIntOffset[0];
-    output.ofWatchZoneFiles[i]
-      <<std::setw(8)<<time.nTimeStepIndex
-      <<std::setw(nWidthOutputField)<<time.dt
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt-1][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nQ0][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"//V_ijp1halfk
-      <<std::setw(nWidthOutputField)<<"-"//V_ijm1halfk
-      <<std::setw(nWidthOutputField)<<"-"//Q1
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkp1half
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkm1half
-      <<std::setw(nWidthOutputField)<<"-"//Q2
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][0][0]
-      <<std::setw(nWidthOutputField)<<"-"
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nE][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nP][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-        <<grid.dLocalGridOld[grid.nT][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<dM
-      <<std::setw(nWidthOutputField)<<dMCalc
-      <<std::setw(nWidthOutputField)<<(dM-dMCalc)/dM
-      <<std::endl;
+    int nI=output.watchzoneList[i].i;
+    int nJ=output.watchzoneList[i].j;
+    int nK=output.watchzoneList[i].k;
+    int nIInt=nI+grid.nCenIntOffset[0];
+    dValues[0]=time.dt;
+    dValues[1]=grid.dLocalGridOld[grid.nU][nIInt][nJ][nK];
+    dValues[2]=grid.dLocalGridOld[grid.nU][nIInt-1][nJ][nK];
+    dValues[3]=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+    dValues[4]=grid.dLocalGridOld[grid.nU0][nIInt-1][0][0];
+    dValues[5]=grid.dLocalGridOld[grid.nQ0][nI][nJ][nK];
+    dValues[6]=dUndefined;//V_ijp1halfk
+    dValues[7]=dUndefined;//V_ijm1halfk
+    dValues[8]=dUndefined;//Q1
+    dValues[9]=dUndefined;//W_ijkp1half
+    dValues[10]=dUndefined;//W_ijkm1half
+    dValues[11]=dUndefined;//Q2
+    dValues[12]=grid.dLocalGridOld[grid.nR][nIInt][0][0];
+    dValues[13]=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
+    dValues[14]=grid.dLocalGridOld[grid.nD][nI][nJ][nK];
+    dValues[15]=grid.dLocalGridOld[grid.nD][nI][0][0];
+    dValues[16]=dUndefined;//eddy viscosity
+    dValues[17]=grid.dLocalGridOld[grid.nE][nI][nJ][nK];
+    dValues[18]=grid.dLocalGridOld[grid.nP][nI][nJ][nK];
+    dValues[19]=grid.dLocalGridOld[grid.nT][nI][nJ][nK];
+    dValues[20]=dM;
+    dValues[21]=dMCalc;
+    dValues[22]=(dM-dMCalc)/dM;
+    bufferWatchZoneSample(output,time,dValues);
   }
+  output.nNumWatchZoneSamples++;
+  flushWatchZones(output,procTop,false);
 }
 void writeWatchZones_RT_GL(Output &output, Grid &grid, Parameters &parameters, Time &time
   , ProcTop &procTop){
+  double dValues[nNumWatchZoneColumns];
+  double dUndefined=std::numeric_limits<double>::quiet_NaN();
   for(unsigned int i=0;i<output.watchzoneList.size();i++){
     
     //calculate zone mass
     double dM=grid.dLocalGridOld[grid.nDM][output.watchzoneList[i].i][0][0];
     double dMCalc=4.0/3.0*parameters.dPi*grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
-      *(pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i+grid.nCenIntOffset[0]][0][0],3.0)
-      -pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i-1+grid.nCenIntOffset[0]][0][0],3.0));
+      *grid.dDelRCuOld[output.watchzoneList[i].i];
     
-    int nWidthOutputField=23;
-    int nIInt=output.watchzoneList[i].i+grid.nCenIntOffset[0];
-    int nJInt=output.watchzoneList[i].j+grid.nCenIntOffset[1];
-    output.ofWatchZoneFiles[i]
-      <<std::setw(8)<<time.nTimeStepIndex
-      <<std::setw(nWidthOutputField)<<time.dt
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt-1][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nQ0][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt][output.watchzoneList[i].k];
+    int nI=output.watchzoneList[i].i;
+    int nJ=output.watchzoneList[i].j;
+    int nK=output.watchzoneList[i].k;
+    int nIInt=nI+grid.nCenIntOffset[0];
+    int nJInt=nJ+grid.nCenIntOffset[1];
+    dValues[0]=time.dt;
+    dValues[1]=grid.dLocalGridOld[grid.nU][nIInt][nJ][nK];
+    dValues[2]=grid.dLocalGridOld[grid.nU][nIInt-1][nJ][nK];
+    dValues[3]=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+    dValues[4]=grid.dLocalGridOld[grid.nU0][nIInt-1][0][0];
+    dValues[5]=grid.dLocalGridOld[grid.nQ0][nI][nJ][nK];
+    dValues[6]=grid.dLocalGridOld[grid.nV][nI][nJInt][nK];
     if(nJInt-1<0){
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<"-";//doesn't work when at inner edge
+      dValues[7]=dUndefined;//not defined when on edge
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt-1][output.watchzoneList[i].k];
-    }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nQ1][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkp1half
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkm1half
-      <<std::setw(nWidthOutputField)<<"-"//Q2
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k];
+      dValues[7]=grid.dLocalGridOld[grid.nV][nI][nJInt-1][nK];
+    }
+    dValues[8]=grid.dLocalGridOld[grid.nQ1][nI][nJ][nK];
+    dValues[9]=dUndefined;//W_ijkp1half
+    dValues[10]=dUndefined;//W_ijkm1half
+    dValues[11]=dUndefined;//Q2
+    dValues[12]=grid.dLocalGridOld[grid.nR][nIInt][0][0];
+    dValues[13]=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
+    dValues[14]=grid.dLocalGridOld[grid.nD][nI][nJ][nK];
+    dValues[15]=grid.dLocalGridOld[grid.nDenAve][nI][0][0];
     if(parameters.nTypeTurbulanceMod>0){
-      output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nEddyVisc][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k];
+      dValues[16]=grid.dLocalGridOld[grid.nEddyVisc][nI][nJ][nK];
     }
     else{
-      output.ofWatchZoneFiles[i]<<std::setw(nWidthOutputField)<<"-";
-    }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nE][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nP][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"//T
-      <<std::setw(nWidthOutputField)<<dM
-      <<std::setw(nWidthOutputField)<<dMCalc
-      <<std::setw(nWidthOutputField)<<(dM-dMCalc)/dM
-      <<std::endl;
+      dValues[16]=dUndefined;
+    }
+    dValues[17]=grid.dLocalGridOld[grid.nE][nI][nJ][nK];
+    dValues[18]=grid.dLocalGridOld[grid.nP][nI][nJ][nK];
+    dValues[19]=dUndefined;//T
+    dValues[20]=dM;
+    dValues[21]=dMCalc;
+    dValues[22]=(dM-dMCalc)/dM;
+    bufferWatchZoneSample(output,time,dValues);
   }
+  output.nNumWatchZoneSamples++;
+  flushWatchZones(output,procTop,false);
 }
 void writeWatchZones_RT_TEOS(Output &output, Grid &grid, Parameters &parameters, Time &time
   , ProcTop &procTop){
+  double dValues[nNumWatchZoneColumns];
+  double dUndefined=std::numeric_limits<double>::quiet_NaN();
   for(unsigned int i=0;i<output.watchzoneList.size();i++){
     
     //calculate zone mass
     double dM=grid.dLocalGridOld[grid.nDM][output.watchzoneList[i].i][0][0];
     double dMCalc=4.0/3.0*parameters.dPi*grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
-      *(pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i+grid.nCenIntOffset[0]][0][0],3.0)
-      -pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i-1+grid.nCenIntOffset[0]][0][0],3.0));
+      *grid.dDelRCuOld[output.watchzoneList[i].i];
     
-    int nWidthOutputField=23;
-    int nIInt=output.watchzoneList[i].i+grid.nCenIntOffset[0];
-    int nJInt=output.watchzoneList[i].j+grid.nCenIntOffset[1];
-    output.ofWatchZoneFiles[i]
-      <<std::setw(8)<<time.nTimeStepIndex
-      <<std::setw(nWidthOutputField)<<time.dt
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nU][nIInt][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nU][nIInt-1][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nQ0][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField);
+    int nI=output.watchzoneList[i].i;
+    int nJ=output.watchzoneList[i].j;
+    int nK=output.watchzoneList[i].k;
+    int nIInt=nI+grid.nCenIntOffset[0];
+    int nJInt=nJ+grid.nCenIntOffset[1];
+    dValues[0]=time.dt;
+    dValues[1]=grid.dLocalGridOld[grid.nU][nIInt][nJ][nK];
+    dValues[2]=grid.dLocalGridOld[grid.nU][nIInt-1][nJ][nK];
+    dValues[3]=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+    dValues[4]=grid.dLocalGridOld[grid.nU0][nIInt-1][0][0];
+    dValues[5]=grid.dLocalGridOld[grid.nQ0][nI][nJ][nK];
+    dValues[6]=grid.dLocalGridOld[grid.nV][nI][nJInt][nK];
     if(nJInt-1<0){
-      output.ofWatchZoneFiles[i]
-        <<"-";//doesn't work when at inner edge
+      dValues[7]=dUndefined;//not defined when on edge
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt-1][output.watchzoneList[i].k];
-    }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nQ1][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkp1half
-      <<std::setw(nWidthOutputField)<<"-"//W_ijkm1half
-      <<std::setw(nWidthOutputField)<<"-"//Q2
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][output.watchzoneList[i].j]
-      [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0];
+      dValues[7]=grid.dLocalGridOld[grid.nV][nI][nJInt-1][nK];
+    }
+    dValues[8]=grid.dLocalGridOld[grid.nQ1][nI][nJ][nK];
+    dValues[9]=dUndefined;//W_ijkp1half
+    dValues[10]=dUndefined;//W_ijkm1half
+    dValues[11]=dUndefined;//Q2
+    dValues[12]=grid.dLocalGridOld[grid.nR][nIInt][0][0];
+    dValues[13]=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
+    dValues[14]=grid.dLocalGridOld[grid.nD][nI][nJ][nK];
+    dValues[15]=grid.dLocalGridOld[grid.nDenAve][nI][0][0];
     if(parameters.nTypeTurbulanceMod>0){
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nEddyVisc]
-        [output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k];
+      dValues[16]=grid.dLocalGridOld[grid.nEddyVisc][nI][nJ][nK];
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<"-";
-    }
-    output.ofWatchZoneFiles[i]<<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nE][output.watchzoneList[i].i][output.watchzoneList[i].j]
-      [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nP][output.watchzoneList[i].i][output.watchzoneList[i].j]
-      [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nT][output.watchzoneList[i].i][output.watchzoneList[i].j]
-      [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<dM
-      <<std::setw(nWidthOutputField)<<dMCalc
-      <<std::setw(nWidthOutputField)<<(dM-dMCalc)/dM
-      <<std::endl;
+      dValues[16]=dUndefined;
+    }
+    dValues[17]=grid.dLocalGridOld[grid.nE][nI][nJ][nK];
+    dValues[18]=grid.dLocalGridOld[grid.nP][nI][nJ][nK];
+    dValues[19]=grid.dLocalGridOld[grid.nT][nI][nJ][nK];
+    dValues[20]=dM;
+    dValues[21]=dMCalc;
+    dValues[22]=(dM-dMCalc)/dM;
+    bufferWatchZoneSample(output,time,dValues);
   }
+  output.nNumWatchZoneSamples++;
+  flushWatchZones(output,procTop,false);
 }
 void writeWatchZones_RTP_GL(Output &output, Grid &grid, Parameters &parameters, Time &time
   , ProcTop &procTop){
+  double dValues[nNumWatchZoneColumns];
+  double dUndefined=std::numeric_limits<double>::quiet_NaN();
   for(unsigned int i=0;i<output.watchzoneList.size();i++){
     
     //calculate zone mass
     double dM=grid.dLocalGridOld[grid.nDM][output.watchzoneList[i].i][0][0];
     double dMCalc=4.0/3.0*parameters.dPi*grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
-      *(pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i+grid.nCenIntOffset[0]][0][0],3.0)
-      -pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i-1+grid.nCenIntOffset[0]][0][0],3.0));
+      *grid.dDelRCuOld[output.watchzoneList[i].i];
     
-    int nWidthOutputField=23;
-    int nIInt=output.watchzoneList[i].i+grid.nCenIntOffset[0];
-    int nJInt=output.watchzoneList[i].j+grid.nCenIntOffset[1];
-    int nKInt=output.watchzoneList[i].k+grid.nCenIntOffset[2];
-    output.ofWatchZoneFiles[i]
-      <<std::setw(8)<<time.nTimeStepIndex
-      <<std::setw(nWidthOutputField)<<time.dt
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU][nIInt-1][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nQ0][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt][output.watchzoneList[i].k];
-    if(nJInt-1==-1){
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<"-";//not defined when on edge
+    int nI=output.watchzoneList[i].i;
+    int nJ=output.watchzoneList[i].j;
+    int nK=output.watchzoneList[i].k;
+    int nIInt=nI+grid.nCenIntOffset[0];
+    int nJInt=nJ+grid.nCenIntOffset[1];
+    int nKInt=nK+grid.nCenIntOffset[2];
+    dValues[0]=time.dt;
+    dValues[1]=grid.dLocalGridOld[grid.nU][nIInt][nJ][nK];
+    dValues[2]=grid.dLocalGridOld[grid.nU][nIInt-1][nJ][nK];
+    dValues[3]=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+    dValues[4]=grid.dLocalGridOld[grid.nU0][nIInt-1][0][0];
+    dValues[5]=grid.dLocalGridOld[grid.nQ0][nI][nJ][nK];
+    dValues[6]=grid.dLocalGridOld[grid.nV][nI][nJInt][nK];
+    if(nJInt-1<0){
+      dValues[7]=dUndefined;//not defined when on edge
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt-1][output.watchzoneList[i].k];
+      dValues[7]=grid.dLocalGridOld[grid.nV][nI][nJInt-1][nK];
     }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nQ1][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nW][output.watchzoneList[i].i][output.watchzoneList[i].j][nKInt];
-    if(nKInt-1==-1){
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<"-";//not defined when on edge
+    dValues[8]=grid.dLocalGridOld[grid.nQ1][nI][nJ][nK];
+    dValues[9]=grid.dLocalGridOld[grid.nW][nI][nJ][nKInt];
+    if(nKInt-1<0){
+      dValues[10]=dUndefined;//not defined when on edge
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nW][output.watchzoneList[i].i][output.watchzoneList[i].j][nKInt-1];
-    }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nQ2][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k];
+      dValues[10]=grid.dLocalGridOld[grid.nW][nI][nJ][nKInt-1];
+    }
+    dValues[11]=grid.dLocalGridOld[grid.nQ2][nI][nJ][nK];
+    dValues[12]=grid.dLocalGridOld[grid.nR][nIInt][0][0];
+    dValues[13]=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
+    dValues[14]=grid.dLocalGridOld[grid.nD][nI][nJ][nK];
+    dValues[15]=grid.dLocalGridOld[grid.nDenAve][nI][0][0];
     if(parameters.nTypeTurbulanceMod>0){
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nEddyVisc]
-        [output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k];
+      dValues[16]=grid.dLocalGridOld[grid.nEddyVisc][nI][nJ][nK];
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<"-";
-    }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nE][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nP][output.watchzoneList[i].i][output.watchzoneList[i].j]
-        [output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<"-"//T
-      <<std::setw(nWidthOutputField)<<dM
-      <<std::setw(nWidthOutputField)<<dMCalc
-      <<std::setw(nWidthOutputField)<<(dM-dMCalc)/dM
-      <<std::endl;
+      dValues[16]=dUndefined;
+    }
+    dValues[17]=grid.dLocalGridOld[grid.nE][nI][nJ][nK];
+    dValues[18]=grid.dLocalGridOld[grid.nP][nI][nJ][nK];
+    dValues[19]=dUndefined;//T
+    dValues[20]=dM;
+    dValues[21]=dMCalc;
+    dValues[22]=(dM-dMCalc)/dM;
+    bufferWatchZoneSample(output,time,dValues);
   }
+  output.nNumWatchZoneSamples++;
+  flushWatchZones(output,procTop,false);
 }
 void writeWatchZones_RTP_TEOS(Output &output, Grid &grid, Parameters &parameters, Time &time
   , ProcTop &procTop){
+  double dValues[nNumWatchZoneColumns];
+  double dUndefined=std::numeric_limits<double>::quiet_NaN();
   for(unsigned int i=0;i<output.watchzoneList.size();i++){
     
     //calculate zone mass
     double dM=grid.dLocalGridOld[grid.nDM][output.watchzoneList[i].i][0][0];
-    double dMCalc=4.0/3.0*parameters.dPi
-      *grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
-      *(pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i+grid.nCenIntOffset[0]][0][0],3.0)
-      -pow(grid.dLocalGridOld[grid.nR][output.watchzoneList[i].i-1
-      +grid.nCenIntOffset[0]][0][0],3.0));
+    double dMCalc=4.0/3.0*parameters.dPi*grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
+      *grid.dDelRCuOld[output.watchzoneList[i].i];
     
-    int nWidthOutputField=23;
-    int nIInt=output.watchzoneList[i].i+grid.nCenIntOffset[0];
-    int nJInt=output.watchzoneList[i].j+grid.nCenIntOffset[1];
-    int nKInt=output.watchzoneList[i].k+grid.nCenIntOffset[2];
-    output.ofWatchZoneFiles[i]
-      <<std::setw(8)<<time.nTimeStepIndex
-      <<std::setw(nWidthOutputField)<<time.dt
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nU][nIInt][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nU][nIInt-1][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nU0][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nQ0][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField);
-    if(nJInt-1==-1){
-      output.ofWatchZoneFiles[i]<<"-";//not defined when on edge
+    int nI=output.watchzoneList[i].i;
+    int nJ=output.watchzoneList[i].j;
+    int nK=output.watchzoneList[i].k;
+    int nIInt=nI+grid.nCenIntOffset[0];
+    int nJInt=nJ+grid.nCenIntOffset[1];
+    int nKInt=nK+grid.nCenIntOffset[2];
+    dValues[0]=time.dt;
+    dValues[1]=grid.dLocalGridOld[grid.nU][nIInt][nJ][nK];
+    dValues[2]=grid.dLocalGridOld[grid.nU][nIInt-1][nJ][nK];
+    dValues[3]=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+    dValues[4]=grid.dLocalGridOld[grid.nU0][nIInt-1][0][0];
+    dValues[5]=grid.dLocalGridOld[grid.nQ0][nI][nJ][nK];
+    dValues[6]=grid.dLocalGridOld[grid.nV][nI][nJInt][nK];
+    if(nJInt-1<0){
+      dValues[7]=dUndefined;//not defined when on edge
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<grid.dLocalGridOld[grid.nV][output.watchzoneList[i].i][nJInt-1][output.watchzoneList[i].k];
+      dValues[7]=grid.dLocalGridOld[grid.nV][nI][nJInt-1][nK];
     }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nQ1][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nW][output.watchzoneList[i].i][output.watchzoneList[i].j][nKInt]
-      <<std::setw(nWidthOutputField);
-    if(nKInt-1==-1){
-      output.ofWatchZoneFiles[i]<<"-";//not defined when on edge
+    dValues[8]=grid.dLocalGridOld[grid.nQ1][nI][nJ][nK];
+    dValues[9]=grid.dLocalGridOld[grid.nW][nI][nJ][nKInt];
+    if(nKInt-1<0){
+      dValues[10]=dUndefined;//not defined when on edge
     }
     else{
-      output.ofWatchZoneFiles[i]
-        <<grid.dLocalGridOld[grid.nW][output.watchzoneList[i].i][output.watchzoneList[i].j][nKInt-1];
-    }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nQ2][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt][0][0]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nR][nIInt-1][0][0]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nD][output.watchzoneList[i].i][output.watchzoneList[i].j]
-      [output.watchzoneList[i].k];
+      dValues[10]=grid.dLocalGridOld[grid.nW][nI][nJ][nKInt-1];
+    }
+    dValues[11]=grid.dLocalGridOld[grid.nQ2][nI][nJ][nK];
+    dValues[12]=grid.dLocalGridOld[grid.nR][nIInt][0][0];
+    dValues[13]=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
+    dValues[14]=grid.dLocalGridOld[grid.nD][nI][nJ][nK];
+    dValues[15]=grid.dLocalGridOld[grid.nDenAve][nI][0][0];
     if(parameters.nTypeTurbulanceMod>0){
-      output.ofWatchZoneFiles[i]
-        <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nEddyVisc]
-        [output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k];
+      dValues[16]=grid.dLocalGridOld[grid.nEddyVisc][nI][nJ][nK];
     }
     else{
-      output.ofWatchZoneFiles[i]<<std::setw(nWidthOutputField)<<"-";
-    }
-    output.ofWatchZoneFiles[i]
-      <<std::setw(nWidthOutputField)<<grid.dLocalGridOld[grid.nDenAve][output.watchzoneList[i].i][0][0]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nE][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nP][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)
-      <<grid.dLocalGridOld[grid.nT][output.watchzoneList[i].i][output.watchzoneList[i].j][output.watchzoneList[i].k]
-      <<std::setw(nWidthOutputField)<<dM
-      <<std::setw(nWidthOutputField)<<dMCalc
-      <<std::setw(nWidthOutputField)<<(dM-dMCalc)/dM
-      <<std::endl;
+      dValues[16]=dUndefined;
+    }
+    dValues[17]=grid.dLocalGridOld[grid.nE][nI][nJ][nK];
+    dValues[18]=grid.dLocalGridOld[grid.nP][nI][nJ][nK];
+    dValues[19]=grid.dLocalGridOld[grid.nT][nI][nJ][nK];
+    dValues[20]=dM;
+    dValues[21]=dMCalc;
+    dValues[22]=(dM-dMCalc)/dM;
+    bufferWatchZoneSample(output,time,dValues);
   }
+  output.nNumWatchZoneSamples++;
+  flushWatchZones(output,procTop,false);
 }
-void finWatchZones(Output &output){
-  for(unsigned int i=0;i<output.watchzoneList.size();i++){
+void finWatchZones(Output &output, ProcTop &procTop){
+  
+  //write out samples not yet gathered
+  flushWatchZones(output,procTop,true);
+  
+  if(procTop.nRank!=0){
+    return;
+  }
+  for(unsigned int i=0;i<output.watchzoneGlobalList.size();i++){
     output.ofWatchZoneFiles[i].flush();//write out buffer
     output.ofWatchZoneFiles[i].close();
   }
+  
+  //buffers can only be freed after the streams have been closed
+  if(output.cWatchZoneBuffers!=NULL){
+    for(unsigned int i=0;i<output.watchzoneGlobalList.size();i++){
+      if(output.cWatchZoneBuffers[i]!=NULL){
+        delete [] output.cWatchZoneBuffers[i];
+      }
+    }
+    delete [] output.cWatchZoneBuffers;
+    output.cWatchZoneBuffers=NULL;
+  }
+}
+void initRadialProfiles(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
+  , Parameters &parameters, Time &time){
+  
+  //switch to radial profile node
+  XMLNode xProfiles=getXMLNodeNoThrow(xParent,"profiles",0);
+  
+  //set time of last profile equal to the current simulation time
+  output.dTimeLastProfile=time.dt;
+  
+  //get profile frequencies
+  output.nProfileFrequencyStep=0;//not writing profiles according to number of time steps
+  output.dProfileFrequencyTime=0.0;//not writing profiles according to simulation time
+  
+  if(xProfiles.isEmpty()){
+    output.bProfiles=false;
+    return;
+  }
+  output.bProfiles=true;
+  
+  //get up to two profile frequencies, one in time steps and one in seconds
+  for(int n=0;n<2;n++){
+    XMLNode xFrequency=getXMLNodeNoThrow(xProfiles,"frequency",n);
+    if(xFrequency.isEmpty()){
+      break;
+    }
+    std::string sType;
+    getXMLAttribute(xFrequency,"type",sType);
+    if(sType.compare("timeSteps")==0){
+      getXMLValue(xProfiles,"frequency",n,output.nProfileFrequencyStep);
+    }
+    else if(sType.compare("seconds")==0){
+      getXMLValue(xProfiles,"frequency",n,output.dProfileFrequencyTime);
+    }
+    else{
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": unknown attribute, \""<<sType<<"\" in frequency node "<<n
+        <<" under \"profiles\" node."<<std::endl;
+      throw exception2(ssTemp.str(),INPUT);
+    }
+  }
+  if(output.nProfileFrequencyStep==0&&output.dProfileFrequencyTime==0.0){
+    if(procTop.nRank==0){
+      std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+        <<": WARNING no \"frequency\" node found under \"profiles\" node, no radial profiles will "
+        <<"be written!"<<std::endl;
+    }
+    output.bProfiles=false;
+    return;
+  }
+  
+  //set zone centered variables to average over shells
+  output.nProfileVars.clear();
+  output.sProfileVarNames.clear();
+  output.nProfileVars.push_back(grid.nD);
+  output.sProfileVarNames.push_back("D[g/cm^3]");
+  output.nProfileVars.push_back(grid.nE);
+  output.sProfileVarNames.push_back("E[erg/g]");
+  output.nProfileVars.push_back(grid.nP);
+  output.sProfileVarNames.push_back("P[dynes/cm^2]");
+  output.nProfileVars.push_back(grid.nQ0);
+  output.sProfileVarNames.push_back("Q0[dynes/cm^2]");
+  if(!parameters.bEOSGammaLaw){
+    output.nProfileVars.push_back(grid.nT);
+    output.sProfileVarNames.push_back("T[K]");
+    output.nProfileVars.push_back(grid.nKappa);
+    output.sProfileVarNames.push_back("Kap[cm^2/g]");
+    output.nProfileVars.push_back(grid.nGamma);
+    output.sProfileVarNames.push_back("Gam[na]");
+  }
+  if(parameters.nTypeTurbulanceMod>0){
+    output.nProfileVars.push_back(grid.nEddyVisc);
+    output.sProfileVarNames.push_back("Eddy_Visc");
+  }
+}
+bool bWriteRadialProfileThisStep(Output &output, Time &time){
+  if(!output.bProfiles){
+    return false;
+  }
+  bool bWrite=false;
+  if(output.nProfileFrequencyStep!=0){
+    if(time.nTimeStepIndex%output.nProfileFrequencyStep==0){
+      bWrite=true;
+    }
+  }
+  if(output.dProfileFrequencyTime!=0.0){
+    if(time.dt>=(output.dProfileFrequencyTime+output.dTimeLastProfile)){
+      bWrite=true;
+      output.dTimeLastProfile=time.dt;
+    }
+  }
+  return bWrite;
+}
+void writeRadialProfile(std::string sFileName, Output &output, Grid &grid, Time &time
+  , ProcTop &procTop){
+  
+  /*Columns summed over a shell, the first is the shell volume the rest are volume weighted 
+  quantities which become horizontal averages once divided by the shell volume*/
+  const int nVol=0;
+  const int nRCol=1;
+  const int nMCol=2;
+  const int nDMCol=3;
+  const int nUCol=4;
+  const int nU0Col=5;
+  const int nVCol=6;
+  const int nWCol=7;
+  const int nNumFixedCols=8;
+  int nNumProVars=output.nProfileVars.size();
+  int nNumSumCols=nNumFixedCols+nNumProVars;
+  int nNumMinMaxCols=1+nNumProVars;//radial velocity plus zone centered variables
+  int nNumShells=grid.nGlobalGridDims[0]+2*grid.nNumGhostCells;
+  
+  double *dSumLocal=new double[nNumShells*nNumSumCols];
+  double *dMinLocal=new double[nNumShells*nNumMinMaxCols];
+  double *dMaxLocal=new double[nNumShells*nNumMinMaxCols];
+  for(int n=0;n<nNumShells*nNumSumCols;n++){
+    dSumLocal[n]=0.0;
+  }
+  for(int n=0;n<nNumShells*nNumMinMaxCols;n++){
+    dMinLocal[n]=std::numeric_limits<double>::max();
+    dMaxLocal[n]=-1.0*std::numeric_limits<double>::max();
+  }
+  
+  //get the radial offset of the local grid in the global grid
+  int nGlobalOffset=grid.nGlobalGridPositionLocalGrid[0];
+  if(nGlobalOffset!=0){
+    nGlobalOffset-=grid.nNumGhostCells;
+  }
+  
+  //processor 0 is always 1D, and so are all processors in a 1D calculation
+  bool b1D=(procTop.nRank==0||grid.nNumDims==1);
+  int nStartJ=0;
+  int nEndJ=1;
+  int nStartK=0;
+  int nEndK=1;
+  if(!b1D){
+    nStartJ=grid.nNumGhostCells;
+    nEndJ=nStartJ+grid.nLocalGridDims[procTop.nRank][grid.nD][1];
+    if(grid.nNumDims>2){
+      nStartK=grid.nNumGhostCells;
+      nEndK=nStartK+grid.nLocalGridDims[procTop.nRank][grid.nD][2];
+    }
+  }
+  
+  //sum up local zones in each shell
+  int nStartI=grid.nNumGhostCells;
+  int nEndI=nStartI+grid.nLocalGridDims[procTop.nRank][grid.nD][0];
+  for(int i=nStartI;i<nEndI;i++){
+    
+    //calculate i for interface centered quantities
+    int nIInt=i+grid.nCenIntOffset[0];
+    int nShell=i+nGlobalOffset;
+    double *dSum=dSumLocal+nShell*nNumSumCols;
+    double *dMin=dMinLocal+nShell*nNumMinMaxCols;
+    double *dMax=dMaxLocal+nShell*nNumMinMaxCols;
+    double dRFactor=0.33333333333333333*grid.dDelRCuOld[i];
+    
+    for(int j=nStartJ;j<nEndJ;j++){
+      
+      //calculate j for interface centered quantities
+      int nJInt=j+grid.nCenIntOffset[1];
+      for(int k=nStartK;k<nEndK;k++){
+        
+        //calculate k for interface centered quantities
+        int nKInt=k+grid.nCenIntOffset[2];
+        
+        double dVolumeTemp=dRFactor;
+        if(!b1D){
+          dVolumeTemp*=grid.dDCosThetaDPhi[j][k];
+        }
+        
+        //1D quantities
+        dSum[nVol]+=dVolumeTemp;
+        dSum[nRCol]+=dVolumeTemp*grid.dLocalGridOld[grid.nR][nIInt][0][0];
+        dSum[nMCol]+=dVolumeTemp*grid.dLocalGridOld[grid.nM][nIInt][0][0];
+        dSum[nDMCol]+=dVolumeTemp*grid.dLocalGridOld[grid.nDM][i][0][0];
+        dSum[nU0Col]+=dVolumeTemp*grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+        
+        //radial velocity
+        double dU=grid.dLocalGridOld[grid.nU][nIInt][j][k];
+        dSum[nUCol]+=dVolumeTemp*dU;
+        if(dU<dMin[0]){
+          dMin[0]=dU;
+        }
+        if(dU>dMax[0]){
+          dMax[0]=dU;
+        }
+        
+        //horizontal velocities, zero in 1D region
+        if(!b1D){
+          dSum[nVCol]+=dVolumeTemp*grid.dLocalGridOld[grid.nV][i][nJInt][k];
+          if(grid.nNumDims>2){
+            dSum[nWCol]+=dVolumeTemp*grid.dLocalGridOld[grid.nW][i][j][nKInt];
+          }
+        }
+        
+        //zone centered quantities
+        for(int n=0;n<nNumProVars;n++){
+          double dValue=grid.dLocalGridOld[output.nProfileVars[n]][i][j][k];
+          dSum[nNumFixedCols+n]+=dVolumeTemp*dValue;
+          if(dValue<dMin[1+n]){
+            dMin[1+n]=dValue;
+          }
+          if(dValue>dMax[1+n]){
+            dMax[1+n]=dValue;
+          }
+        }
+      }
+    }
+  }
+  
+  //reduce to processor 0
+  double *dSumGlobal=NULL;
+  double *dMinGlobal=NULL;
+  double *dMaxGlobal=NULL;
+  if(procTop.nRank==0){
+    dSumGlobal=new double[nNumShells*nNumSumCols];
+    dMinGlobal=new double[nNumShells*nNumMinMaxCols];
+    dMaxGlobal=new double[nNumShells*nNumMinMaxCols];
+  }
+  MPI::COMM_WORLD.Reduce(dSumLocal,dSumGlobal,nNumShells*nNumSumCols,MPI::DOUBLE,MPI_SUM,0);
+  MPI::COMM_WORLD.Reduce(dMinLocal,dMinGlobal,nNumShells*nNumMinMaxCols,MPI::DOUBLE,MPI_MIN,0);
+  MPI::COMM_WORLD.Reduce(dMaxLocal,dMaxGlobal,nNumShells*nNumMinMaxCols,MPI::DOUBLE,MPI_MAX,0);
+  delete [] dSumLocal;
+  delete [] dMinLocal;
+  delete [] dMaxLocal;
+  
+  if(procTop.nRank!=0){
+    return;
+  }
+  
+  //open output file
+  std::ofstream ofFile;
+  ofFile.open(sFileName.c_str());
+  if(!ofFile.good()){
+    delete [] dSumGlobal;
+    delete [] dMinGlobal;
+    delete [] dMaxGlobal;
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<procTop.nRank
+      <<": error opening the file \""<<sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+  ofFile.precision(14);
+  ofFile.setf(std::ios::scientific);
+  
+  //write out header, in the same style as profiles made by SPHERLSanal
+  int nWidthOutputField=25;
+  int nWidthIntOutputField=12;
+  int nColumn=1;
+  ofFile<<"time= "<<time.dt<<" [s] timeStepIndex= "<<time.nTimeStepIndex<<std::endl;
+  ofFile<<std::setw(nWidthIntOutputField)<<"Zone_#(1)";
+  std::stringstream ssColumn;
+  const char* cFixedNames[]={"M_r_ip1half[g]","DM_r[g]","R_ip1half[cm]","U0_ip1half[cm/s]"
+    ,"U_ave_ip1half[cm/s]","U_min_ip1half[cm/s]","U_max_ip1half[cm/s]","V_ave_jp1half[cm/s]"
+    ,"W_ave_kp1half[cm/s]"};
+  for(int n=0;n<9;n++){
+    ssColumn.str("");
+    ssColumn<<cFixedNames[n]<<"("<<++nColumn<<")";
+    ofFile<<std::setw(nWidthOutputField)<<ssColumn.str();
+  }
+  for(int n=0;n<nNumProVars;n++){
+    ssColumn.str("");
+    ssColumn<<"<"<<output.sProfileVarNames[n]<<">("<<++nColumn<<")";
+    ofFile<<std::setw(nWidthOutputField)<<ssColumn.str();
+    ssColumn.str("");
+    ssColumn<<output.sProfileVarNames[n]<<"_min("<<++nColumn<<")";
+    ofFile<<std::setw(nWidthOutputField)<<ssColumn.str();
+    ssColumn.str("");
+    ssColumn<<output.sProfileVarNames[n]<<"_max("<<++nColumn<<")";
+    ofFile<<std::setw(nWidthOutputField)<<ssColumn.str();
+  }
+  ofFile<<std::endl;
+  
+  //write out shells which have zones in them
+  for(int nShell=0;nShell<nNumShells;nShell++){
+    double *dSum=dSumGlobal+nShell*nNumSumCols;
+    double *dMin=dMinGlobal+nShell*nNumMinMaxCols;
+    double *dMax=dMaxGlobal+nShell*nNumMinMaxCols;
+    if(dSum[nVol]<=0.0){
+      continue;
+    }
+    ofFile<<std::setw(nWidthIntOutputField)<<nShell
+      <<std::setw(nWidthOutputField)<<dSum[nMCol]/dSum[nVol]
+      <<std::setw(nWidthOutputField)<<dSum[nDMCol]/dSum[nVol]
+      <<std::setw(nWidthOutputField)<<dSum[nRCol]/dSum[nVol]
+      <<std::setw(nWidthOutputField)<<dSum[nU0Col]/dSum[nVol]
+      <<std::setw(nWidthOutputField)<<dSum[nUCol]/dSum[nVol]
+      <<std::setw(nWidthOutputField)<<dMin[0]
+      <<std::setw(nWidthOutputField)<<dMax[0]
+      <<std::setw(nWidthOutputField)<<dSum[nVCol]/dSum[nVol]
+      <<std::setw(nWidthOutputField)<<dSum[nWCol]/dSum[nVol];
+    for(int n=0;n<nNumProVars;n++){
+      ofFile<<std::setw(nWidthOutputField)<<dSum[nNumFixedCols+n]/dSum[nVol]
+        <<std::setw(nWidthOutputField)<<dMin[1+n]
+        <<std::setw(nWidthOutputField)<<dMax[1+n];
+    }
+    ofFile<<"\n";
+  }
+  ofFile.close();
+  
+  delete [] dSumGlobal;
+  delete [] dMinGlobal;
+  delete [] dMaxGlobal;
 }
-
@@ -13,9 +13,9 @@
 
 void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
   , Parameters &parameters, Time &time);/**<
-  Reads in watchzones set in configuration file "SPHERLS.xml". A list is created on each processor 
-  containing the watchzones on that processor's local grid. It also opens file streams for each 
-  watchzone and writes out a header.
+  Reads in watchzones set in configuration file "SPHERLS.xml". The processor which has each zone on
+  its local grid is found, and a list is created on each processor containing the watchzones it
+  samples. Processor 0 opens file streams for all watchzones and writes out a header.
   
   @param[in] xParent
   @param[in] procTop
@@ -24,6 +24,34 @@ void initWatchZones(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
   @param[in] parameters
   @param[in] time
   */
+void bufferWatchZoneSample(Output &output, Time &time, double dValues[]);/**<
+  Adds one time step of a watch zone to \ref Output::dWatchZoneSamples, to be gathered to processor
+  0 later by \ref flushWatchZones. Values which are not defined for the zone should be set to NaN.
+  
+  @param[in,out] output
+  @param[in] time
+  @param[in] dValues array of \ref nNumWatchZoneColumns values to buffer
+  */
+void writeWatchZoneRecord(Output &output, unsigned int nZone, double dRecord[]);/**<
+  Writes one time step of the watch zone \c nZone to its file, either as a formatted line or as a
+  binary record depending on \ref Output::nWatchZoneFormat. Values which are NaN are written as "-"
+  in the text format. Only called on processor 0.
+  
+  @param[in,out] output
+  @param[in] nZone index of the watch zone in \ref Output::watchzoneGlobalList
+  @param[in] dRecord the time step index followed by \ref nNumWatchZoneColumns values
+  */
+void flushWatchZones(Output &output, ProcTop &procTop, bool bForce);/**<
+  Once \ref Output::nWatchZoneGatherFrequency time steps have been buffered, or if \c bForce is
+  true, gathers the buffered watch zone samples of all processors to processor 0 with a single
+  MPI::COMM_WORLD.Gatherv and writes them out. The files are flushed every
+  \ref Output::nWatchZoneFlushFrequency time steps, or if \c bForce is true. It must be called by
+  all processors.
+  
+  @param[in,out] output
+  @param[in] procTop
+  @param[in] bForce if true gather, write, and flush regardless of the frequencies
+  */
 void writeWatchZones_R_GL(Output &output, Grid &grid, Parameters &parameters, Time &time
   , ProcTop &procTop);/**<
   Writes out the information for each watchzone specified in "SPHERLS.xml" in the case of a 1D
@@ -90,9 +118,44 @@ void writeWatchZones_RTP_TEOS(Output &output, Grid &grid, Parameters &parameters
   @param[in] time
   @param[in] procTop
   */
-void finWatchZones(Output &output);/**<
-  Closes the files opened for writting out the watchzones
+void finWatchZones(Output &output, ProcTop &procTop);/**<
+  Writes out any buffered watchzone samples, closes the files opened for writting out the
+  watchzones, and frees their buffers. It must be called by all processors.
+  
+  @param[in] output
+  @param[in] procTop
+  */
+void initRadialProfiles(XMLNode xParent,ProcTop &procTop, Grid &grid, Output &output
+  , Parameters &parameters, Time &time);/**<
+  Reads in the "profiles" node from the configuration file "SPHERLS.xml" and sets the frequency at
+  which horizontally averaged radial profiles are written during the calculation. It also sets the
+  list of variables which are included in the profiles.
+  
+  @param[in] xParent
+  @param[in] procTop
+  @param[in] grid
+  @param[in,out] output
+  @param[in] parameters
+  @param[in] time
+  */
+bool bWriteRadialProfileThisStep(Output &output, Time &time);/**<
+  Decides if a radial profile should be written this time step based on
+  \ref Output::nProfileFrequencyStep and \ref Output::dProfileFrequencyTime.
   
+  @param[in,out] output
+  @param[in] time
+  */
+void writeRadialProfile(std::string sFileName, Output &output, Grid &grid, Time &time
+  , ProcTop &procTop);/**<
+  Writes out horizontally averaged radial profiles of the current model to the file \c sFileName.
+  Each processor sums the volume weighted values, and finds the horizontal minimum and maximum, of
+  its local zones in each radial shell, in the same way as \ref calNewDenave_RTP. These are then
+  reduced to processor 0 which writes the profile. It must be called by all processors.
+  
+  @param[in] sFileName name of the profile file to write
   @param[in] output
+  @param[in] grid
+  @param[in] time
+  @param[in] procTop
   */
 #endif
@@ -25,6 +25,16 @@ Grid::Grid(){
   nLocalGridDims=NULL;
   dLocalGridNew=NULL;
   dLocalGridOld=NULL;
+  nEOSCell=NULL;
+  dRCuOld=NULL;
+  dRCuNew=NULL;
+  dRSqOld=NULL;
+  dDelRCuOld=NULL;
+  dDelRCuNew=NULL;
+  dDelRSqOld=NULL;
+  dDCosThetaDPhi=NULL;
+  dRadialFacePlanes=NULL;
+  dT4Old=NULL;
   nStartUpdateExplicit=NULL;
   nEndUpdateExplicit=NULL;
   nStartGhostUpdateExplicit=NULL;
@@ -92,8 +102,21 @@ Parameters::Parameters(){
 Output::Output(){
   nDumpFrequencyStep=1;
   bDump=false;
+  nDumpFormat=0;
+  nDumpCompression=0;
   sBaseOutputFileName="out";
   ofWatchZoneFiles=NULL;
+  nWatchZoneFormat=0;
+  nWatchZoneBufferSize=1048576;
+  cWatchZoneBuffers=NULL;
+  nWatchZoneFlushFrequency=0;
+  nNumTimeStepsSinceLastWatchZoneFlush=0;
+  nNumWatchZoneSamples=0;
+  nWatchZoneGatherFrequency=100;
+  bProfiles=false;
+  nProfileFrequencyStep=0;
+  dProfileFrequencyTime=0.0;
+  dTimeLastProfile=0.0;
   nNumTimeStepsSinceLastDump=-1;
   nNumTimeStepsSinceLastPrint=-1;
 }
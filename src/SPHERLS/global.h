@@ -62,6 +62,10 @@
   Sets the version of the dump file. Should be incremented if changes are made to the information that
   is printed out in a dump.
   */
+#define HDF5_CHUNK_SIZE 131072/**<
+  The approximate number of doubles in each chunk of the datasets in HDF5 model dumps. Chunks span
+  the full theta and phi extent of the grid and as many radial zones as fit in this size.
+  */
 #define DEBUG_EQUATIONS 0/**<
   If 1 will write out in the form of a profile file, all the horizontal maximum values of all terms
   in all equations.
@@ -70,6 +74,11 @@
   If 1 a clamp on the DEDM gradient will be used to limit how large DE/DM becomes in the advection
   term in the energy equation.
   */
+#define NUM_RADIAL_FACE_PLANES 6/**<
+  Number of scratch planes in \ref Grid::dRadialFacePlanes. Each face based quantity of a 3D
+  kernel needs two, one for the inner and one for the outer face of the shell, the mass flux of
+  \ref calNewD_RTP three, as the two zones sharing a face pick its upwind side at different times.
+  */
 
 //classes
 class MessPass{
@@ -318,6 +327,56 @@ class Grid{
       state, it contains the last complete grid state. This is a processor dependent variable and
       contains only the local grid for the current processor plus ghost cells.
       */
+    int ***nEOSCell; /**<
+      Equation of state table cell last used for each zone, as returned by the hinted lookups of
+      \ref eos, or -1 if the zone hasn't been looked up yet. It has the same size as the zone
+      centered variables, e.g. \ref Grid::nT, of \ref Grid::dLocalGridNew and is only allocated 
+      when a tabulated equation of state is used. Since a zone usually stays in the same table cell
+      from one time step to the next, the lookups only have to check the cell instead of finding it.
+      */
+    double *dRCuOld; /**<
+      Cube of the radius of each shell interface of \ref Grid::dLocalGridOld, indexed like the
+      radial index of \ref Grid::nR including ghost cells. Updated once per time step by 
+      \ref updateGeometryOld so that the kernels don't each compute the cubes again.
+      */
+    double *dRCuNew; /**<
+      Cube of the radius of each shell interface of \ref Grid::dLocalGridNew, the same as
+      \ref Grid::dRCuOld but updated by \ref updateGeometryNew once the new radii are known.
+      */
+    double *dRSqOld; /**<
+      Square of the radius of each shell interface of \ref Grid::dLocalGridOld, indexed like
+      \ref Grid::dRCuOld. It is the area of the interface per unit solid angle.
+      */
+    double *dDelRCuOld; /**<
+      Difference of \ref Grid::dRCuOld across each shell, indexed like the radial index of zone
+      centered quantities, e.g. \ref Grid::nD, so that shell \p i is between the interfaces
+      <tt>i+nCenIntOffset[0]-1</tt> and <tt>i+nCenIntOffset[0]</tt>. One third of it is the volume
+      of the shell per unit solid angle.
+      */
+    double *dDelRCuNew; /**<
+      Same as \ref Grid::dDelRCuOld but for \ref Grid::dRCuNew.
+      */
+    double *dDelRSqOld; /**<
+      Difference of \ref Grid::dRSqOld across each shell, indexed like \ref Grid::dDelRCuOld.
+      */
+    double **dDCosThetaDPhi; /**<
+      Angular part of the zone volumes, \ref Grid::nDCosThetaIJK times \ref Grid::nDPhi indexed
+      by the zone centered \p j and \p k. In 2D it is just \ref Grid::nDCosThetaIJK with a single
+      \p k. The angles don't change with time so it is set once by \ref initAngularGeometry. It is
+      NULL in 1D and for the 1D region.
+      */
+    double ***dRadialFacePlanes; /**<
+      Scratch planes of quantities on the radial faces of a shell, indexed as 
+      <tt>[plane][j][k]</tt> with \ref NUM_RADIAL_FACE_PLANES planes. The 3D kernels fill a plane
+      for a face once and use it for both shells that share the face, instead of computing it 
+      again for each zone. Allocated by \ref initRadialFacePlanes in 3D, otherwise NULL.
+      */
+    double ***dT4Old; /**<
+      Fourth power of the temperature of each zone of \ref Grid::dLocalGridOld, used by the
+      radiative diffusion terms of the energy equation. It has the same size as \ref Grid::nEOSCell,
+      is only allocated when a tabulated equation of state is used, and is updated once per time
+      step by \ref updateT4Old.
+      */
     int **nStartUpdateExplicit; /**<
       Positions to begin updating grid with explicit calculations. It is an array of size 
       \ref nNumVars+\ref nNumIntVars by 3. The start positions are defined in 
@@ -541,6 +600,17 @@ class Output{
       timesteps, and/or every \ref Output::dDumpFrequencyTime seconds of simulation time. This is
       set to true by putting a "<dump>" node into the "SPHERLS.xml" configuration file.
       */
+    int nDumpFormat;/**<
+      The format of the model dumps. If it is 0 each processor writes its own local grid to a binary
+      file, which are combined with SPHERLSanal. If it is 1 all processors write into a single HDF5
+      file with collective parallel I/O, see \ref modelWrite_HDF5. This is set with the "format"
+      attribute of the "dumps" node in the "SPHERLS.xml" configuration file.
+      */
+    int nDumpCompression;/**<
+      The deflate compression level, from 0 to 9, applied to the chunked datasets of HDF5 model
+      dumps. If it is 0 the datasets are not compressed. This is set with the "compression"
+      attribute of the "dumps" node in the "SPHERLS.xml" configuration file.
+      */
     bool bPrint;/**<
       Should status updates be printed to the screen.
     */
@@ -557,11 +627,76 @@ class Output{
       */
     std::ofstream *ofWatchZoneFiles; /**<
       An array of output streams of size 
-      \ref Output::watchzoneList .size() which are used to write out the information of the watched
-      zones.
+      \ref Output::watchzoneGlobalList .size() which are used to write out the information of the
+      watched zones. Only allocated on processor 0.
       */
     std::vector<WatchZone> watchzoneList; /**<
-      A vector used to keep information used to specify the zones to be watched.
+      A vector used to keep information used to specify the zones to be watched which are on this
+      processor's local grid, with local grid indices.
+      */
+    std::vector<WatchZone> watchzoneGlobalList; /**<
+      All the zones to be watched, with global grid indices. This is the same on all processors.
+      */
+    std::vector<int> nWatchZoneOwners;/**<
+      The rank of the processor which samples each zone in \ref Output::watchzoneGlobalList.
+      */
+    std::vector<double> dWatchZoneSamples;/**<
+      Samples of the zones in \ref Output::watchzoneList which have not yet been gathered to
+      processor 0. Each sample is the time step index followed by \ref nNumWatchZoneColumns values.
+      */
+    int nNumWatchZoneSamples;/**<
+      Number of time steps held in \ref Output::dWatchZoneSamples.
+      */
+    int nWatchZoneGatherFrequency;/**<
+      Number of time steps buffered in \ref Output::dWatchZoneSamples before they are gathered to
+      processor 0 and written. Set by the "gatherFrequency" attribute of the "<watchZones>" node in
+      the "SPHERLS.xml" configuration file, default is 100.
+      */
+    int nWatchZoneFormat;/**<
+      Format of the watch zone files. If 0 watch zones are written as formatted text, if 1 they are
+      written in binary. Set by the "format" attribute of the "<watchZones>" node in the
+      "SPHERLS.xml" configuration file, default is 0.
+      */
+    int nWatchZoneBufferSize;/**<
+      Size in bytes of the write buffer attached to each of the \ref Output::ofWatchZoneFiles. If 0
+      no buffer is attached and the files keep the default buffer of the standard library. Set by
+      the "bufferSize" attribute of the "<watchZones>" node, default is 1048576.
+      */
+    char **cWatchZoneBuffers;/**<
+      Write buffers of size \ref Output::nWatchZoneBufferSize used by the
+      \ref Output::ofWatchZoneFiles.
+      */
+    int nWatchZoneFlushFrequency;/**<
+      Number of time steps between flushes of the watch zone files. If 0 the files are only flushed
+      when a model is dumped, when the buffers are full, and at the end of the calculation. Set by the
+      "flushFrequency" attribute of the "<watchZones>" node, default is 0.
+      */
+    int nNumTimeStepsSinceLastWatchZoneFlush;/**<
+      Number of time steps written to the watch zone files since they were last flushed.
+      */
+    bool bProfiles;/**<
+      Should horizontally averaged radial profiles be written out during the run. This is set to
+      true by putting a "<profiles>" node into the "SPHERLS.xml" configuration file.
+      */
+    int nProfileFrequencyStep;/**<
+      How often radial profiles are written according to the time step index. If it is 0 no
+      profiles will be written according to the time step index.
+      */
+    double dProfileFrequencyTime;/**<
+      How often radial profiles are written according to simulation time in seconds. If it is 0 no
+      profiles will be written according to simulation time.
+      */
+    double dTimeLastProfile;/**<
+      The simulation time at which the last radial profile was written using the
+      \ref Output::dProfileFrequencyTime criterion.
+      */
+    std::vector<int> nProfileVars;/**<
+      Grid indices of the zone centered variables which are averaged, and have their minimum and
+      maximum found, over each radial shell when writing radial profiles.
+      */
+    std::vector<std::string> sProfileVarNames;/**<
+      Column names used in the radial profile files, one for each entry in
+      \ref Output::nProfileVars.
       */
     int nPrintFrequencyStep;/**<
       How often the status is printed to the screen in time steps.*/
@@ -97,8 +97,22 @@ int main(int argc, char* argv[]){
           }
           
           global.output.nNumTimeStepsSinceLastDump=0;
+          #ifdef HDF5_ENABLE
+          if(global.output.nDumpFormat==1){
+            modelWrite_HDF5(ssFileNameOut.str(),global.output,global.procTop,global.grid
+              ,global.time,global.parameters);
+          }
+          else{
+            global.functions.fpModelWrite(ssFileNameOut.str(), global.procTop,global.grid
+              ,global.time,global.parameters);
+          }
+          #else
           global.functions.fpModelWrite(ssFileNameOut.str(), global.procTop,global.grid,global.time
             ,global.parameters);
+          #endif
+          
+          //make sure watch zones are written up to the dump so a restart can continue from it
+          flushWatchZones(global.output,global.procTop,true);
           
           #if DEBUG_EQUATIONS==1
           if(!bFirstIterationDump){//nothing to print on the first iteration
@@ -115,6 +129,15 @@ int main(int argc, char* argv[]){
         }
       }
       
+      //write horizontally averaged radial profile
+      if(bWriteRadialProfileThisStep(global.output,global.time)){
+        std::stringstream ssFileNameProOut;
+        ssFileNameProOut<<global.output.sBaseOutputFileName<<"_t"<<std::setfill('0')<<std::setw(8)
+          <<global.time.nTimeStepIndex<<"_insitu_pro.txt";
+        writeRadialProfile(ssFileNameProOut.str(),global.output,global.grid,global.time
+          ,global.procTop);
+      }
+      
       //Print status
       if(global.output.bPrint){
         
@@ -217,6 +240,7 @@ int main(int argc, char* argv[]){
       //calculate new radius and update boundaries
       global.functions.fpCalculateNewRadii(global.grid,global.time);
       updateLocalBoundariesNewGrid(global.grid.nR,global.procTop,global.messPass,global.grid);
+      updateGeometryNew(global.procTop,global.grid);
       
       //calculate new densities, and update boundaries
       global.functions.fpCalculateNewDensities(global.grid,global.parameters, global.time
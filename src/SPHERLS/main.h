@@ -42,6 +42,8 @@ int main(int argc, char* argv[]);/**<
       - Update radii on new grid boundaries between processors by calling 
         \ref updateLocalBoundariesNewGrid() indicating radius is to be
         updated (\ref R).
+      - Update the radial geometry of the new grid for the kernels by calling
+        \ref updateGeometryNew()
       - Calculate new densities with \ref Functions::fpCalculateNewDensities()
       - Calculate new energies with \ref Functions::fpCalculateNewEnergies()
       - Update the old grid boundaries and centeres by calling 
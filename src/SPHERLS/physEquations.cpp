@@ -2507,6 +2507,51 @@ void calNewU_RTP(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop){
   #endif
 
 }
+void calRadialStress_RTP(Grid &grid, Parameters &parameters, int i, double **dUUpWindGrad
+  , double **dTau_rr){
+  int nIInt=i+grid.nCenIntOffset[0];
+  double dR_i_n=(grid.dLocalGridOld[grid.nR][nIInt][0][0]
+    +grid.dLocalGridOld[grid.nR][nIInt-1][0][0])*0.5;
+  double dRSq_i_n=dR_i_n*dR_i_n;
+  double dRSq_ip1half_n=grid.dRSqOld[nIInt];
+  double dRSq_im1half_n=grid.dRSqOld[nIInt-1];
+  double dU0_ip1half_nm1half=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+  double dU0_im1half_nm1half=grid.dLocalGridOld[grid.nU0][nIInt-1][0][0];
+  double dDM_i=grid.dLocalGridOld[grid.nDM][i][0][0];
+  double dRhoAve_i=grid.dLocalGridOld[grid.nDenAve][i][0][0];
+  double dFourPiRhoAve_i=4.0*parameters.dPi*dRhoAve_i;
+  for(int j=grid.nStartUpdateExplicit[grid.nU][1];j<grid.nEndUpdateExplicit[grid.nU][1];j++){
+    int nJInt=j+grid.nCenIntOffset[1];
+    double dSinTheta_ijk=grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0];
+    double dSinTheta_ijp1halfk=grid.dLocalGridOld[grid.nSinThetaIJp1halfK][0][nJInt][0];
+    double dSinTheta_ijm1halfk=grid.dLocalGridOld[grid.nSinThetaIJp1halfK][0][nJInt-1][0];
+    double dDTheta_j=grid.dLocalGridOld[grid.nDTheta][0][j][0];
+    
+    //rows of the shell, so the k loop has no indirection
+    double *dU_ip1half_nm1half=grid.dLocalGridOld[grid.nU][nIInt][j];
+    double *dU_im1half_nm1half=grid.dLocalGridOld[grid.nU][nIInt-1][j];
+    double *dV_ijp1halfk_nm1half=grid.dLocalGridOld[grid.nV][i][nJInt];
+    double *dV_ijm1halfk_nm1half=grid.dLocalGridOld[grid.nV][i][nJInt-1];
+    double *dW_ij_nm1half=grid.dLocalGridOld[grid.nW][i][j];
+    double *dEddyVisc_ij_n=grid.dLocalGridOld[grid.nEddyVisc][i][j];
+    double *dDPhi=grid.dLocalGridOld[grid.nDPhi][0][0];
+    double *dUUpWindGrad_j=dUUpWindGrad[j];
+    double *dTau_rr_j=dTau_rr[j];
+    for(int k=grid.nStartUpdateExplicit[grid.nU][2];k<grid.nEndUpdateExplicit[grid.nU][2];k++){
+      int nKInt=k+grid.nCenIntOffset[2];
+      dUUpWindGrad_j[k]=(dU_ip1half_nm1half[k]-dU_im1half_nm1half[k])/dDM_i;
+      double dDivU_ijk_n=dFourPiRhoAve_i
+        *(dRSq_ip1half_n*(dU_ip1half_nm1half[k]-dU0_ip1half_nm1half)
+        -dRSq_im1half_n*(dU_im1half_nm1half[k]-dU0_im1half_nm1half))/dDM_i
+        +(dV_ijp1halfk_nm1half[k]*dSinTheta_ijp1halfk-dV_ijm1halfk_nm1half[k]*dSinTheta_ijm1halfk)
+        /(dDTheta_j*dR_i_n*dSinTheta_ijk)
+        +(dW_ij_nm1half[nKInt]-dW_ij_nm1half[nKInt-1])/(dDPhi[k]*dR_i_n*dSinTheta_ijk);
+      dTau_rr_j[k]=2.0*dEddyVisc_ij_n[k]*(4.0*parameters.dPi*dRSq_i_n*dRhoAve_i
+        *((dU_ip1half_nm1half[k]-dU0_ip1half_nm1half)-(dU_im1half_nm1half[k]-dU0_im1half_nm1half))
+        /dDM_i-0.3333333333333333*dDivU_ijk_n);
+    }
+  }
+}
 void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop){
   int i;
   int j;
@@ -2514,6 +2559,8 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
   int nICen;
   int nJInt;
   int nKInt;
+  int nJUp;
+  int nKUp;
   double dRho_ip1halfjk_n;
   double dP_ip1jk_n;
   double dP_ijk_n;
@@ -2576,11 +2623,8 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
   double dW_R_ijkm1half_n;
   double dRSq_ip1half_n;
   double dRSq_im1half_n;
-  double dRSq_ip1_n;
   double dRSq_i_n;
-  double dRSq_ip3half_n;
   double dRCu_ip1half_n;
-  double dRSqUmU0_ip3halfjk_n;
   double dRSqUmU0_ip1halfjk_n;
   double dRSqUmU0_im1halfjk_n;
   double dRSqUmU0_ijk_n;//needed at surface boundary
@@ -2599,20 +2643,28 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
   double dEddyViscosityTerms;
   double dDonorFrac_ip1half;
   
+  double **dUUpWindGrad_ijk=grid.dRadialFacePlanes[0];
+  double **dUUpWindGrad_ip1jk=grid.dRadialFacePlanes[1];
+  double **dTau_rr_ijk=grid.dRadialFacePlanes[2];
+  double **dTau_rr_ip1jk=grid.dRadialFacePlanes[3];
+  double **dSwap;
+  
   //calculate new u
   for(i=grid.nStartUpdateExplicit[grid.nU][0];i<grid.nEndUpdateExplicit[grid.nU][0];i++){
     
     //calculate i of centered quantities
     nICen=i-grid.nCenIntOffset[0];
     
+    //zone centered terms, the outer zone of this interface is the inner zone of the next one
+    if(i==grid.nStartUpdateExplicit[grid.nU][0]){
+      calRadialStress_RTP(grid,parameters,nICen,dUUpWindGrad_ijk,dTau_rr_ijk);
+    }
+    calRadialStress_RTP(grid,parameters,nICen+1,dUUpWindGrad_ip1jk,dTau_rr_ip1jk);
+    
     //calculate quantities that vary only with radius
     dR_ip1_n=(grid.dLocalGridOld[grid.nR][i+1][0][0]+grid.dLocalGridOld[grid.nR][i][0][0])*0.5;
     dR_i_n=(grid.dLocalGridOld[grid.nR][i][0][0]+grid.dLocalGridOld[grid.nR][i-1][0][0])*0.5;
-    dRSq_ip1_n=dR_ip1_n*dR_ip1_n;
-    dRSq_i_n=dR_i_n*dR_i_n;
     dRSq_ip1half_n=grid.dLocalGridOld[grid.nR][i][0][0]*grid.dLocalGridOld[grid.nR][i][0][0];
-    dRSq_im1half_n=grid.dLocalGridOld[grid.nR][i-1][0][0]*grid.dLocalGridOld[grid.nR][i-1][0][0];
-    dRSq_ip3half_n=grid.dLocalGridOld[grid.nR][i+1][0][0]*grid.dLocalGridOld[grid.nR][i+1][0][0];
     dRCu_ip1half_n=dRSq_ip1half_n*grid.dLocalGridOld[grid.nR][i][0][0];
     dDM_ip1half=(grid.dLocalGridOld[grid.nDM][nICen+1][0][0]
       +grid.dLocalGridOld[grid.nDM][nICen][0][0])*0.5;
@@ -2708,12 +2760,6 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
           +grid.dLocalGridOld[grid.nEddyVisc][nICen+1][j][k-1])*0.25;
         
         //calculate derived quantities
-        dRSqUmU0_ip3halfjk_n=dRSq_ip3half_n*(grid.dLocalGridOld[grid.nU][i+1][j][k]
-          -grid.dLocalGridOld[grid.nU0][i+1][0][0]);
-        dRSqUmU0_ip1halfjk_n=dRSq_ip1half_n*(grid.dLocalGridOld[grid.nU][i][j][k]
-          -grid.dLocalGridOld[grid.nU0][i][0][0]);
-        dRSqUmU0_im1halfjk_n=dRSq_im1half_n*(grid.dLocalGridOld[grid.nU][i-1][j][k]
-          -grid.dLocalGridOld[grid.nU0][i-1][0][0]);
         dV_R_ip1jk_n=dV_ip1jk_nm1half/dR_ip1_n;
         dV_R_ip1jp1halfk_n=grid.dLocalGridOld[grid.nV][nICen+1][nJInt][k]/dR_ip1_n;
         dV_R_ip1jm1halfk_n=grid.dLocalGridOld[grid.nV][nICen+1][nJInt-1][k]/dR_ip1_n;
@@ -2730,17 +2776,8 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
         dA1CenGrad=(dU_ip1jk_nm1half-dU_ijk_nm1half)
           /(grid.dLocalGridOld[grid.nDM][nICen+1][0][0]
           +grid.dLocalGridOld[grid.nDM][nICen][0][0])*2.0;
-        dA1UpWindGrad=0.0;
-        if(dUmU0_ip1halfjk_nm1half<0.0){//moving from outside in
-          dA1UpWindGrad=(grid.dLocalGridOld[grid.nU][i+1][j][k]
-            -grid.dLocalGridOld[grid.nU][i][j][k])
-            /grid.dLocalGridOld[grid.nDM][nICen+1][0][0];
-        }
-        else{//moving from inside out
-          dA1UpWindGrad=(grid.dLocalGridOld[grid.nU][i][j][k]
-            -grid.dLocalGridOld[grid.nU][i-1][j][k])
-            /grid.dLocalGridOld[grid.nDM][nICen][0][0];
-        }
+        dA1UpWindGrad=(dUmU0_ip1halfjk_nm1half<0.0)?dUUpWindGrad_ip1jk[j][k]
+          :dUUpWindGrad_ijk[j][k];//moving from outside in, or inside out
         dA1=dUmU0_ip1halfjk_nm1half*((1.0-dDonorFrac_ip1half)*dA1CenGrad+dDonorFrac_ip1half
           *dA1UpWindGrad);
         
@@ -2753,19 +2790,11 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
         //Calculate dA2
         dA2CenGrad=(dU_ip1halfjp1halfk_nm1half-dU_ip1halfjm1halfk_nm1half)
           /grid.dLocalGridOld[grid.nDTheta][0][j][0];
-        dA2UpWindGrad=0.0;
-        if(dV_ip1halfjk_nm1half>0.0){//moving in positive direction
-          dA2UpWindGrad=(grid.dLocalGridOld[grid.nU][i][j][k]
-            -grid.dLocalGridOld[grid.nU][i][j-1][k])
-            /(grid.dLocalGridOld[grid.nDTheta][0][j][0]
-            +grid.dLocalGridOld[grid.nDTheta][0][j-1][0])*2.0;
-        }
-        else{//moving in negative direction
-          dA2UpWindGrad=(grid.dLocalGridOld[grid.nU][i][j+1][k]
-            -grid.dLocalGridOld[grid.nU][i][j][k])
-            /(grid.dLocalGridOld[grid.nDTheta][0][j+1][0]
-            +grid.dLocalGridOld[grid.nDTheta][0][j][0])*2.0;
-        }
+        nJUp=(dV_ip1halfjk_nm1half>0.0)?j:j+1;//gradient across the upwind face
+        dA2UpWindGrad=(grid.dLocalGridOld[grid.nU][i][nJUp][k]
+          -grid.dLocalGridOld[grid.nU][i][nJUp-1][k])
+          /(grid.dLocalGridOld[grid.nDTheta][0][nJUp][0]
+          +grid.dLocalGridOld[grid.nDTheta][0][nJUp-1][0])*2.0;
         dA2=dV_ip1halfjk_nm1half*((1.0-dDonorFrac_ip1half)*dA2CenGrad
           +dDonorFrac_ip1half*dA2UpWindGrad)/grid.dLocalGridOld[grid.nR][i][0][0];
         
@@ -2776,19 +2805,11 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
         //Calculate dA3
         dA3CenGrad=(dU_ip1halfjkp1half_nm1half-dU_ip1halfjkm1half_nm1half)
           /grid.dLocalGridOld[grid.nDPhi][0][0][k];
-        dA3UpWindGrad=0.0;
-        if(dW_ip1halfjk_nm1half>0.0){//moving in positive direction
-          dA3UpWindGrad=(grid.dLocalGridOld[grid.nU][i][j][k]
-            -grid.dLocalGridOld[grid.nU][i][j][k-1])
-            /(grid.dLocalGridOld[grid.nDPhi][0][0][k]
-            +grid.dLocalGridOld[grid.nDPhi][0][0][k-1])*2.0;
-        }
-        else{//moving in negative direction
-          dA3UpWindGrad=(grid.dLocalGridOld[grid.nU][i][j][k+1]
-            -grid.dLocalGridOld[grid.nU][i][j][k])
-            /(grid.dLocalGridOld[grid.nDPhi][0][0][k+1]
-            +grid.dLocalGridOld[grid.nDPhi][0][0][k])*2.0;
-        }
+        nKUp=(dW_ip1halfjk_nm1half>0.0)?k:k+1;//gradient across the upwind face
+        dA3UpWindGrad=(grid.dLocalGridOld[grid.nU][i][j][nKUp]
+          -grid.dLocalGridOld[grid.nU][i][j][nKUp-1])
+          /(grid.dLocalGridOld[grid.nDPhi][0][0][nKUp]
+          +grid.dLocalGridOld[grid.nDPhi][0][0][nKUp-1])*2.0;
         dA3=dW_ip1halfjk_nm1half*((1.0-dDonorFrac_ip1half)*dA3CenGrad+dDonorFrac_ip1half
           *dA3UpWindGrad)/(grid.dLocalGridOld[grid.nR][i][0][0]
           *grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0]);
@@ -2796,48 +2817,6 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
         //Calculate dS3
         dS3=dW_ip1halfjk_nm1half*dW_ip1halfjk_nm1half/grid.dLocalGridOld[grid.nR][i][0][0];
         
-        //cal DivU_ip1jk_n
-        dDivU_ip1jk_n=4.0*parameters.dPi*grid.dLocalGridOld[grid.nDenAve][nICen+1][0][0]
-          *(dRSqUmU0_ip3halfjk_n-dRSqUmU0_ip1halfjk_n)/grid.dLocalGridOld[grid.nDM][nICen+1][0][0]
-          +(grid.dLocalGridOld[grid.nV][nICen+1][nJInt][k]
-          *grid.dLocalGridOld[grid.nSinThetaIJp1halfK][0][nJInt][0]
-          -grid.dLocalGridOld[grid.nV][nICen+1][nJInt-1][k]
-          *grid.dLocalGridOld[grid.nSinThetaIJp1halfK][0][nJInt-1][0])
-          /(grid.dLocalGridOld[grid.nDTheta][0][j][0]*dR_ip1_n
-          *grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0])
-          +(grid.dLocalGridOld[grid.nW][nICen+1][j][nKInt]
-          -grid.dLocalGridOld[grid.nW][nICen+1][j][nKInt-1])
-          /(grid.dLocalGridOld[grid.nDPhi][0][0][k]*dR_ip1_n
-          *grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0]);
-        
-        //cal DivU_ijk_n
-        dDivU_ijk_n=4.0*parameters.dPi*grid.dLocalGridOld[grid.nDenAve][nICen][0][0]
-          *(dRSqUmU0_ip1halfjk_n-dRSqUmU0_im1halfjk_n)/grid.dLocalGridOld[grid.nDM][nICen][0][0]
-          +(grid.dLocalGridOld[grid.nV][nICen][nJInt][k]
-          *grid.dLocalGridOld[grid.nSinThetaIJp1halfK][0][nJInt][0]
-          -grid.dLocalGridOld[grid.nV][nICen][nJInt-1][k]
-          *grid.dLocalGridOld[grid.nSinThetaIJp1halfK][0][nJInt-1][0])
-          /(grid.dLocalGridOld[grid.nDTheta][0][j][0]*dR_i_n
-          *grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0])
-          +(grid.dLocalGridOld[grid.nW][nICen][j][nKInt]
-          -grid.dLocalGridOld[grid.nW][nICen][j][nKInt-1])
-          /(grid.dLocalGridOld[grid.nDPhi][0][0][k]*dR_i_n
-          *grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0]);
-        
-        //cal Tau_rr_ip1jk_n
-        dTau_rr_ip1jk_n=2.0*grid.dLocalGridOld[grid.nEddyVisc][nICen+1][j][k]*(4.0*parameters.dPi
-          *dRSq_ip1_n*grid.dLocalGridOld[grid.nDenAve][nICen+1][0][0]
-          *((grid.dLocalGridOld[grid.nU][i+1][j][k]-grid.dLocalGridOld[grid.nU0][i+1][0][0])
-          -(grid.dLocalGridOld[grid.nU][i][j][k]-grid.dLocalGridOld[grid.nU0][i][0][0]))
-          /grid.dLocalGridOld[grid.nDM][nICen+1][0][0]-0.3333333333333333*dDivU_ip1jk_n);
-        
-        //cal Tau_rr_ijk_n
-        dTau_rr_ijk_n=2.0*grid.dLocalGridOld[grid.nEddyVisc][nICen][j][k]*(4.0*parameters.dPi
-          *dRSq_i_n*grid.dLocalGridOld[grid.nDenAve][nICen][0][0]
-          *((grid.dLocalGridOld[grid.nU][i][j][k]-grid.dLocalGridOld[grid.nU0][i][0][0])
-          -(grid.dLocalGridOld[grid.nU][i-1][j][k]-grid.dLocalGridOld[grid.nU0][i-1][0][0]))
-          /grid.dLocalGridOld[grid.nDM][nICen][0][0]-0.3333333333333333*dDivU_ijk_n);
-        
         //calculate dTau_rt_ip1halfjp1halfk_n
         dTau_rt_ip1halfjp1halfk_n=dEddyVisc_ip1halfjp1halfk_n*(4.0*parameters.dPi*dRCu_ip1half_n
           *dRhoAve_ip1half_n*(dV_R_ip1jp1halfk_n-dV_R_ijp1halfk_n)/dDM_ip1half
@@ -2871,7 +2850,7 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
           *dDPhi_km1half));
         
         //cal dTA1
-        dTA1=(dTau_rr_ip1jk_n-dTau_rr_ijk_n)/(dDM_ip1half*dRho_ip1halfjk_n);
+        dTA1=(dTau_rr_ip1jk[j][k]-dTau_rr_ijk[j][k])/(dDM_ip1half*dRho_ip1halfjk_n);
         
         //cal dTS1
         dTS1=dEddyVisc_ip1halfjk_n/dRhoR_ip1halfjk_n*(4.0
@@ -2998,6 +2977,14 @@ void calNewU_RTP_LES(Grid &grid,Parameters &parameters,Time &time,ProcTop &procT
         #endif
       }
     }
+    
+    //the outer zone terms become the inner zone terms of the next interface
+    dSwap=dUUpWindGrad_ijk;
+    dUUpWindGrad_ijk=dUUpWindGrad_ip1jk;
+    dUUpWindGrad_ip1jk=dSwap;
+    dSwap=dTau_rr_ijk;
+    dTau_rr_ijk=dTau_rr_ip1jk;
+    dTau_rr_ip1jk=dSwap;
   }
   
   //ghost region 0, outter most ghost region in x1 direction
@@ -6924,8 +6911,6 @@ void calNewU0_RT(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,M
   int j;
   int nJInt;
   int k;
-  double dR_im1half_np1half;
-  double dR_ip1half_np1half;
   double dRSq_im1half_np1half;
   double dRSq_ip1half_np1half;
   double dA_im1halfjk_np1half;
@@ -6958,10 +6943,8 @@ void calNewU0_RT(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,M
     
     //calculate i of centered quantities
     nICen=i-grid.nCenIntOffset[0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][i-1][0][0];
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][i][0][0];
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
+    dRSq_im1half_np1half=grid.dRSqOld[i-1];
+    dRSq_ip1half_np1half=grid.dRSqOld[i];
     d1half_RSq_ip1half_m_RSq_im1half=0.5*(dRSq_ip1half_np1half-dRSq_im1half_np1half);
     dDonorFrac_ip1half=(grid.dLocalGridOld[grid.nDonorCellFrac][nICen+1][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][nICen][0][0])*0.5;
@@ -6976,7 +6959,7 @@ void calNewU0_RT(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,M
       for(k=grid.nStartUpdateExplicit[grid.nU][2];k<grid.nEndUpdateExplicit[grid.nU][2];k++){
         
         
-        dTemp=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+        dTemp=grid.dDCosThetaDPhi[j][0];
         dA_im1halfjk_np1half=dRSq_im1half_np1half*dTemp;
         dA_ip1halfjk_np1half=dRSq_ip1half_np1half*dTemp;
         
@@ -7063,10 +7046,8 @@ void calNewU0_RT(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,M
     
     //calculate i of centered quantities
     nICen=i-grid.nCenIntOffset[0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][i-1][0][0];
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][i][0][0];
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
+    dRSq_im1half_np1half=grid.dRSqOld[i-1];
+    dRSq_ip1half_np1half=grid.dRSqOld[i];
     dDonorFrac_ip1half=grid.dLocalGridOld[grid.nDonorCellFrac][nICen][0][0];
     dDonorFrac_im1half=(grid.dLocalGridOld[grid.nDonorCellFrac][nICen][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][nICen-1][0][0])*0.5;
@@ -7079,7 +7060,7 @@ void calNewU0_RT(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,M
       for(k=grid.nStartUpdateExplicit[grid.nU][2];k<grid.nEndUpdateExplicit[grid.nU][2];k++){
         
         
-        dTemp=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+        dTemp=grid.dDCosThetaDPhi[j][0];
         
         dA_im1halfjk_np1half=dRSq_im1half_np1half*dTemp;
         dA_ip1halfjk_np1half=dRSq_ip1half_np1half*dTemp;
@@ -7170,8 +7151,6 @@ void calNewU0_RTP(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,
   int nJInt;
   int k;
   int nKInt;
-  double dR_im1half_np1half;
-  double dR_ip1half_np1half;
   double dRSq_im1half_np1half;
   double dRSq_ip1half_np1half;
   double dA_im1halfjk_np1half;
@@ -7212,10 +7191,8 @@ void calNewU0_RTP(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,
     
     //calculate i of centered quantities
     nICen=i-grid.nCenIntOffset[0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][i-1][0][0];
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][i][0][0];
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
+    dRSq_im1half_np1half=grid.dRSqOld[i-1];
+    dRSq_ip1half_np1half=grid.dRSqOld[i];
     d1half_RSq_ip1half_m_RSq_im1half=0.5*(dRSq_ip1half_np1half-dRSq_im1half_np1half);
     dDonorFrac_ip1half=(grid.dLocalGridOld[grid.nDonorCellFrac][nICen+1][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][nICen][0][0])*0.5;
@@ -7231,8 +7208,7 @@ void calNewU0_RTP(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,
         
         nKInt=k+grid.nCenIntOffset[2];
         
-        dTemp=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
-          *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+        dTemp=grid.dDCosThetaDPhi[j][k];
         dA_im1halfjk_np1half=dRSq_im1half_np1half*dTemp;
         dA_ip1halfjk_np1half=dRSq_ip1half_np1half*dTemp;
         
@@ -7319,10 +7295,8 @@ void calNewU0_RTP(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,
     
     //calculate i of centered quantities
     nICen=i-grid.nCenIntOffset[0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][i-1][0][0];
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][i][0][0];
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
+    dRSq_im1half_np1half=grid.dRSqOld[i-1];
+    dRSq_ip1half_np1half=grid.dRSqOld[i];
     dDonorFrac_ip1half=grid.dLocalGridOld[grid.nDonorCellFrac][nICen][0][0];
     dDonorFrac_im1half=(grid.dLocalGridOld[grid.nDonorCellFrac][nICen][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][nICen-1][0][0])*0.5;
@@ -7336,8 +7310,7 @@ void calNewU0_RTP(Grid &grid,Parameters &parameters,Time &time,ProcTop &procTop,
         
         nKInt=k+grid.nCenIntOffset[2];
         
-        dTemp=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
-          *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+        dTemp=grid.dDCosThetaDPhi[j][k];
         
         dA_im1halfjk_np1half=dRSq_im1half_np1half*dTemp;
         dA_ip1halfjk_np1half=dRSq_ip1half_np1half*dTemp;
@@ -7418,8 +7391,6 @@ void calNewD_R(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop){
   double dDelRCu_i_n;
   double dDelRCu_i_np1;
   double dVRatio;
-  double dR_ip1half_np1half;
-  double dR_im1half_np1half;
   double dRSq_ip1half_np1half;
   double dRSq_im1half_np1half;
   double dDelRSq_i_np1half;
@@ -7446,15 +7417,11 @@ void calNewD_R(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop){
     
     //calculate i for interface centered quantities
     nIInt=i+grid.nCenIntOffset[0];
-    dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-    dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+    dDelRCu_i_n=grid.dDelRCuOld[i];
+    dDelRCu_i_np1=grid.dDelRCuNew[i];
+    dRSq_ip1half_np1half=grid.dRSqOld[nIInt];
+    dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];
+    dDelRSq_i_np1half=grid.dDelRSqOld[i];
     dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
     dDonorFrac_ip1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i+1][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*0.5;
@@ -7575,15 +7542,11 @@ void calNewD_R(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop){
     
     //calculate i for interface centered quantities
     nIInt=i+grid.nCenIntOffset[0];
-    dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-    dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+    dDelRCu_i_n=grid.dDelRCuOld[i];
+    dDelRCu_i_np1=grid.dDelRCuNew[i];
+    dRSq_ip1half_np1half=grid.dRSqOld[nIInt];
+    dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];
+    dDelRSq_i_np1half=grid.dDelRSqOld[i];
     dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
     dDonorFrac_im1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][i-1][0][0])*0.5;
@@ -7685,15 +7648,11 @@ void calNewD_R(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop){
       
       //calculate i for interface centered quantities
       nIInt=i+grid.nCenIntOffset[0];
-      dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-            -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-      dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-            -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-      dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];//could be time centered
-      dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];//could be time centered
-      dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-      dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-      dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+      dDelRCu_i_n=grid.dDelRCuOld[i];
+      dDelRCu_i_np1=grid.dDelRCuNew[i];
+      dRSq_ip1half_np1half=grid.dRSqOld[nIInt];//could be time centered
+      dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];//could be time centered
+      dDelRSq_i_np1half=grid.dDelRSqOld[i];
       dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
       
       for(j=grid.nStartGhostUpdateExplicit[grid.nD][1][1];
@@ -7747,8 +7706,6 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
   double dDelRCu_i_n;
   double dDelRCu_i_np1;
   double dVRatio;
-  double dR_ip1half_np1half;
-  double dR_im1half_np1half;
   double dRSq_ip1half_np1half;
   double dRSq_im1half_np1half;
   double dDelRSq_i_np1half;
@@ -7784,15 +7741,11 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
     
     //calculate i for interface centered quantities
     nIInt=i+grid.nCenIntOffset[0];
-    dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-    dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+    dDelRCu_i_n=grid.dDelRCuOld[i];
+    dDelRCu_i_np1=grid.dDelRCuNew[i];
+    dRSq_ip1half_np1half=grid.dRSqOld[nIInt];
+    dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];
+    dDelRSq_i_np1half=grid.dDelRSqOld[i];
     dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
     dDonorFrac_ip1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i+1][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*0.5;
@@ -7806,7 +7759,7 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
       
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
         
-        dDelCosThetaDelPhi=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+        dDelCosThetaDelPhi=grid.dDCosThetaDPhi[j][0];
         dV_np1=d1Thrid*dDelRCu_i_np1*dDelCosThetaDelPhi;
         
         
@@ -7960,15 +7913,11 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
     
     //calculate i for interface centered quantities
     nIInt=i+grid.nCenIntOffset[0];
-    dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-    dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+    dDelRCu_i_n=grid.dDelRCuOld[i];
+    dDelRCu_i_np1=grid.dDelRCuNew[i];
+    dRSq_ip1half_np1half=grid.dRSqOld[nIInt];
+    dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];
+    dDelRSq_i_np1half=grid.dDelRSqOld[i];
     dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
     dDonorFrac_im1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][i-1][0][0])*0.5;
@@ -7979,7 +7928,7 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
       nJInt=j+grid.nCenIntOffset[1];
       
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
-        dDelCosThetaDelPhi=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+        dDelCosThetaDelPhi=grid.dDCosThetaDPhi[j][0];
         dV_np1=d1Thrid*dDelRCu_i_np1*dDelCosThetaDelPhi;
           
         //CALCULATE RATE OF CHANGE IN RHO IN RADIAL DIRECTION
@@ -8114,15 +8063,11 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
       
       //calculate i for interface centered quantities
       nIInt=i+grid.nCenIntOffset[0];
-      dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-            -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-      dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-            -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-      dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];//could be time centered
-      dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];//could be time centered
-      dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-      dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-      dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+      dDelRCu_i_n=grid.dDelRCuOld[i];
+      dDelRCu_i_np1=grid.dDelRCuNew[i];
+      dRSq_ip1half_np1half=grid.dRSqOld[nIInt];//could be time centered
+      dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];//could be time centered
+      dDelRSq_i_np1half=grid.dDelRSqOld[i];
       dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
       
       for(j=grid.nStartGhostUpdateExplicit[grid.nD][1][1];
@@ -8134,7 +8079,7 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
         for(k=grid.nStartGhostUpdateExplicit[grid.nD][1][2];
           k<grid.nEndGhostUpdateExplicit[grid.nD][1][2];k++){
           
-          dDelCosThetaDelPhi=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+          dDelCosThetaDelPhi=grid.dDCosThetaDPhi[j][0];
           dV_np1=d1Thrid*dDelRCu_i_np1*dDelCosThetaDelPhi;
             
           //CALCULATE RATE OF CHANGE IN RHO IN RADIAL DIRECTION
@@ -8193,6 +8138,39 @@ void calNewD_RT(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop)
     }
   #endif
 }
+void calRadialMassFlux_RTP(Grid &grid, int i, double **dFlux_i, double **dFlux_ip1){
+  int nIInt=i+grid.nCenIntOffset[0];
+  double dU0_ip1half_np1half=grid.dLocalGridNew[grid.nU0][nIInt][0][0];
+  double dU0_ip1half_nm1half=grid.dLocalGridOld[grid.nU0][nIInt][0][0];
+  double dRSq_ip1half=grid.dRSqOld[nIInt];
+  double dDonorFrac_ip1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i+1][0][0]
+    +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*0.5;
+  for(int j=grid.nStartUpdateExplicit[grid.nD][1];j<grid.nEndUpdateExplicit[grid.nD][1];j++){
+    
+    //rows of the face, so the k loop has no indirection and no branches
+    double *dU_ip1half_np1half=grid.dLocalGridNew[grid.nU][nIInt][j];
+    double *dU_ip1half_nm1half=grid.dLocalGridOld[grid.nU][nIInt][j];
+    double *dRho_i_n=grid.dLocalGridOld[grid.nD][i][j];
+    double *dRho_ip1_n=grid.dLocalGridOld[grid.nD][i+1][j];
+    double *dDelCosThetaDelPhi=grid.dDCosThetaDPhi[j];
+    double *dFlux_i_j=dFlux_i[j];
+    double *dFlux_ip1_j=dFlux_ip1[j];
+    for(int k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
+      double dUmU0=dU_ip1half_np1half[k]-dU0_ip1half_np1half;
+      double dA=dRSq_ip1half*dDelCosThetaDelPhi[k];
+      double dRho_cen=(dRho_i_n[k]+dRho_ip1_n[k])*0.5;
+      
+      //zone i picks the upwind side from u-u0 at n-1/2, zone i+1 from u-u0 at n+1/2
+      double dRho_upwind_i=(dU_ip1half_nm1half[k]-dU0_ip1half_nm1half<0.0)
+        ?dRho_ip1_n[k]:dRho_i_n[k];//outside in, or inside out
+      double dRho_upwind_ip1=(dUmU0<0.0)?dRho_ip1_n[k]:dRho_i_n[k];
+      dFlux_i_j[k]=dUmU0*((1.0-dDonorFrac_ip1half)*dRho_cen+dDonorFrac_ip1half*dRho_upwind_i)
+        *dA;
+      dFlux_ip1_j[k]=dUmU0*((1.0-dDonorFrac_ip1half)*dRho_cen
+        +dDonorFrac_ip1half*dRho_upwind_ip1)*dA;
+    }
+  }
+}
 void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop){
   int i;
   int j;
@@ -8203,21 +8181,14 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
   double dDelRCu_i_n;
   double dDelRCu_i_np1;
   double dVRatio;
-  double dR_ip1half_np1half;
-  double dR_im1half_np1half;
-  double dRSq_ip1half_np1half;
   double dRSq_im1half_np1half;
   double dDelRSq_i_np1half;
   double dDelCosThetaDelPhi;
   double dV_np1;
   double dA_im1half;
-  double dA_ip1half;
   double dRho_im1half;
   double dRho_cen_im1half;
   double dRho_upwind_im1half;
-  double dRho_ip1half;
-  double dRho_cen_ip1half;
-  double dRho_upwind_ip1half;
   double dDeltaRhoR;
   double dA_jm1half;
   double dA_jp1half;
@@ -8239,30 +8210,28 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
   double dDeltaRhoPhi;
   double dVr_np1;
   double d1Thrid=0.333333333333333333333333333333;
-  double dUmU0_ip1halfjk_np1half;
   double dUmU0_im1halfjk_np1half;
-  double dUmU0_ip1halfjk_nm1half;
-  double dDonorFrac_ip1half;
   double dDonorFrac_im1half;
   
+  double **dFluxR_im1half=grid.dRadialFacePlanes[0];
+  double **dFluxR_ip1half=grid.dRadialFacePlanes[1];
+  double **dFluxR_ip1half_ip1=grid.dRadialFacePlanes[2];
+  double **dSwap;
+  
   for(i=grid.nStartUpdateExplicit[grid.nD][0];i<grid.nEndUpdateExplicit[grid.nD][0];i++){
     
     //calculate i for interface centered quantities
     nIInt=i+grid.nCenIntOffset[0];
-    dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-    dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+    dDelRCu_i_n=grid.dDelRCuOld[i];
+    dDelRCu_i_np1=grid.dDelRCuNew[i];
+    dDelRSq_i_np1half=grid.dDelRSqOld[i];
     dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
-    dDonorFrac_ip1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i+1][0][0]
-      +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*0.5;
-    dDonorFrac_im1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]
-      +grid.dLocalGridOld[grid.nDonorCellFrac][i-1][0][0])*0.5;
+    
+    //radial mass fluxes, the outer face of this shell is the inner face of the next one
+    if(i==grid.nStartUpdateExplicit[grid.nD][0]){
+      calRadialMassFlux_RTP(grid,i-1,dFluxR_ip1half,dFluxR_im1half);
+    }
+    calRadialMassFlux_RTP(grid,i,dFluxR_ip1half,dFluxR_ip1half_ip1);
     
     for(j=grid.nStartUpdateExplicit[grid.nD][1];j<grid.nEndUpdateExplicit[grid.nD][1];j++){
       
@@ -8272,54 +8241,12 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
         
         nKInt=k+grid.nCenIntOffset[2];
-        dDelCosThetaDelPhi=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
-          *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+        dDelCosThetaDelPhi=grid.dDCosThetaDPhi[j][k];
         dV_np1=d1Thrid*dDelRCu_i_np1*dDelCosThetaDelPhi;
         
         
         //CALCULATE RATE OF CHANGE IN RHO IN RADIAL DIRECTION
-        
-        //calculate area at i-1/2
-        dA_im1half=dRSq_im1half_np1half*dDelCosThetaDelPhi;
-        
-        //calculate area at i+1/2
-        dA_ip1half=dRSq_ip1half_np1half*dDelCosThetaDelPhi;
-        
-        //calculate difference between U and U0
-        dUmU0_ip1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt][j][k]
-          -grid.dLocalGridNew[grid.nU0][nIInt][0][0];
-        dUmU0_ip1halfjk_nm1half=grid.dLocalGridOld[grid.nU][nIInt][j][k]
-          -grid.dLocalGridOld[grid.nU0][nIInt][0][0];
-        dUmU0_im1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt-1][j][k]
-          -grid.dLocalGridNew[grid.nU0][nIInt-1][0][0];
-        
-        //calculate rho at i-1/2, not time centered
-        dRho_cen_im1half=(grid.dLocalGridOld[grid.nD][i][j][k]
-          +grid.dLocalGridOld[grid.nD][i-1][j][k])*0.5;
-        if(dUmU0_im1halfjk_np1half<0.0){//moving from outside in
-          dRho_upwind_im1half=grid.dLocalGridOld[grid.nD][i][j][k];
-        }
-        else{//moving from inside out
-          dRho_upwind_im1half=grid.dLocalGridOld[grid.nD][i-1][j][k];
-        }
-        dRho_im1half=((1.0-dDonorFrac_im1half)*dRho_cen_im1half+dDonorFrac_im1half
-          *dRho_upwind_im1half);
-        
-        //calculate rho at i+1/2, not time centered
-        dRho_cen_ip1half=(grid.dLocalGridOld[grid.nD][i][j][k]
-          +grid.dLocalGridOld[grid.nD][i+1][j][k])*0.5;
-        if(dUmU0_ip1halfjk_nm1half<0.0){//moving from outside in
-          dRho_upwind_ip1half=grid.dLocalGridOld[grid.nD][i+1][j][k];
-        }
-        else{//moving from inside out
-          dRho_upwind_ip1half=grid.dLocalGridOld[grid.nD][i][j][k];
-        }
-        dRho_ip1half=((1.0-dDonorFrac_ip1half)*dRho_cen_ip1half+dDonorFrac_ip1half
-          *dRho_upwind_ip1half);
-        
-        //calculate radial term
-        dDeltaRhoR=dUmU0_im1halfjk_np1half*dRho_im1half*dA_im1half
-          -dUmU0_ip1halfjk_np1half*dRho_ip1half*dA_ip1half;
+        dDeltaRhoR=dFluxR_im1half[j][k]-dFluxR_ip1half[j][k];
         
         
         //CALCULATE RATE OF CHANGE IN RHO IN THE THETA DIRECTION
@@ -8337,12 +8264,8 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
         //calculte rho at j-1/2
         dRho_cen_jm1half=(grid.dLocalGridOld[grid.nD][i][j-1][k]
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
-        if(grid.dLocalGridNew[grid.nV][i][nJInt-1][k]<0.0){
-          dRho_upwind_jm1half=grid.dLocalGridOld[grid.nD][i][j][k];
-        }
-        else{
-          dRho_upwind_jm1half=grid.dLocalGridOld[grid.nD][i][j-1][k];
-        }
+        dRho_upwind_jm1half=(grid.dLocalGridNew[grid.nV][i][nJInt-1][k]<0.0)
+          ?grid.dLocalGridOld[grid.nD][i][j][k]:grid.dLocalGridOld[grid.nD][i][j-1][k];
         dRho_jm1half=((1.0-grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])
           *dRho_cen_jm1half+grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]
           *dRho_upwind_jm1half);
@@ -8350,12 +8273,8 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
         //calculte rho at j+1/2
         dRho_cen_jp1half=(grid.dLocalGridOld[grid.nD][i][j+1][k]
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
-        if(grid.dLocalGridNew[grid.nV][i][nJInt][k]<0.0){
-          dRho_upwind_jp1half=grid.dLocalGridOld[grid.nD][i][j+1][k];
-        }
-        else{
-          dRho_upwind_jp1half=grid.dLocalGridOld[grid.nD][i][j][k];
-        }
+        dRho_upwind_jp1half=(grid.dLocalGridNew[grid.nV][i][nJInt][k]<0.0)
+          ?grid.dLocalGridOld[grid.nD][i][j+1][k]:grid.dLocalGridOld[grid.nD][i][j][k];
         dRho_jp1half=((1.0-grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*dRho_cen_jp1half
           +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]*dRho_upwind_jp1half);
         
@@ -8375,24 +8294,16 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
         //calculte rho at k-1/2
         dRho_cen_km1half=(grid.dLocalGridOld[grid.nD][i][j][k-1]
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
-        if(grid.dLocalGridNew[grid.nW][i][j][nKInt-1]<0.0){
-          dRho_upwind_km1half=grid.dLocalGridOld[grid.nD][i][j][k];
-        }
-        else{
-          dRho_upwind_km1half=grid.dLocalGridOld[grid.nD][i][j][k-1];
-        }
+        dRho_upwind_km1half=(grid.dLocalGridNew[grid.nW][i][j][nKInt-1]<0.0)
+          ?grid.dLocalGridOld[grid.nD][i][j][k]:grid.dLocalGridOld[grid.nD][i][j][k-1];
         dRho_km1half=((1.0-grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*dRho_cen_km1half
           +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]*dRho_upwind_km1half);
         
         //calculte rho at j+1/2
         dRho_cen_kp1half=(grid.dLocalGridOld[grid.nD][i][j][k+1]
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
-        if(grid.dLocalGridNew[grid.nW][i][j][nKInt]<0.0){
-          dRho_upwind_kp1half=grid.dLocalGridOld[grid.nD][i][j][k+1];
-        }
-        else{
-          dRho_upwind_kp1half=grid.dLocalGridOld[grid.nD][i][j][k];
-        }
+        dRho_upwind_kp1half=(grid.dLocalGridNew[grid.nW][i][j][nKInt]<0.0)
+          ?grid.dLocalGridOld[grid.nD][i][j][k+1]:grid.dLocalGridOld[grid.nD][i][j][k];
         dRho_kp1half=((1.0-grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*dRho_cen_kp1half
           +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]*dRho_upwind_kp1half);
         
@@ -8465,6 +8376,11 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
         }
       }
     }
+    
+    //the outer faces, as seen from the next shell, become its inner faces
+    dSwap=dFluxR_im1half;
+    dFluxR_im1half=dFluxR_ip1half_ip1;
+    dFluxR_ip1half_ip1=dSwap;
   }
   
   //ghost region 0, outter most ghost region in x1 direction
@@ -8473,15 +8389,10 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
     
     //calculate i for interface centered quantities
     nIInt=i+grid.nCenIntOffset[0];
-    dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-    dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-          -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-    dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];
-    dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
-    dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-    dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-    dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+    dDelRCu_i_n=grid.dDelRCuOld[i];
+    dDelRCu_i_np1=grid.dDelRCuNew[i];
+    dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];
+    dDelRSq_i_np1half=grid.dDelRSqOld[i];
     dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
     dDonorFrac_im1half=(grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]
       +grid.dLocalGridOld[grid.nDonorCellFrac][i-1][0][0])*0.5;
@@ -8493,8 +8404,7 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
       
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
         nKInt=k+grid.nCenIntOffset[2];
-        dDelCosThetaDelPhi=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
-          *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+        dDelCosThetaDelPhi=grid.dDCosThetaDPhi[j][k];
         dV_np1=d1Thrid*dDelRCu_i_np1*dDelCosThetaDelPhi;
           
         //CALCULATE RATE OF CHANGE IN RHO IN RADIAL DIRECTION
@@ -8668,6 +8578,9 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
   }
 
   #if SEDOV==1
+    double dRSq_ip1half_np1half;
+    double dA_ip1half;
+    double dRho_ip1half;
     
     //ghost region 1, inner most ghost region in x1 direction
     for(i=grid.nStartGhostUpdateExplicit[grid.nD][1][0];
@@ -8675,15 +8588,11 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
       
       //calculate i for interface centered quantities
       nIInt=i+grid.nCenIntOffset[0];
-      dDelRCu_i_n=(pow(grid.dLocalGridOld[grid.nR][nIInt][0][0],3.0)
-            -pow(grid.dLocalGridOld[grid.nR][nIInt-1][0][0],3.0));
-      dDelRCu_i_np1=(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-            -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
-      dR_ip1half_np1half=grid.dLocalGridOld[grid.nR][nIInt][0][0];//could be time centered
-      dR_im1half_np1half=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];//could be time centered
-      dRSq_ip1half_np1half=dR_ip1half_np1half*dR_ip1half_np1half;
-      dRSq_im1half_np1half=dR_im1half_np1half*dR_im1half_np1half;
-      dDelRSq_i_np1half=dRSq_ip1half_np1half-dRSq_im1half_np1half;
+      dDelRCu_i_n=grid.dDelRCuOld[i];
+      dDelRCu_i_np1=grid.dDelRCuNew[i];
+      dRSq_ip1half_np1half=grid.dRSqOld[nIInt];//could be time centered
+      dRSq_im1half_np1half=grid.dRSqOld[nIInt-1];//could be time centered
+      dDelRSq_i_np1half=grid.dDelRSqOld[i];
       dVRatio=dDelRCu_i_n/dDelRCu_i_np1;//calculate ratio of volume at n to volume at n+1
       
       for(j=grid.nStartGhostUpdateExplicit[grid.nD][1][1];
@@ -8696,8 +8605,7 @@ void calNewD_RTP(Grid &grid, Parameters &parameters, Time &time,ProcTop &procTop
           k<grid.nEndGhostUpdateExplicit[grid.nD][1][2];k++){
           
           nKInt=k+grid.nCenIntOffset[2];
-          dDelCosThetaDelPhi=grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
-            *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+          dDelCosThetaDelPhi=grid.dDCosThetaDPhi[j][k];
           dV_np1=d1Thrid*dDelRCu_i_np1*dDelCosThetaDelPhi;
             
           //CALCULATE RATE OF CHANGE IN RHO IN RADIAL DIRECTION
@@ -8983,9 +8891,6 @@ void calNewE_R_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &procT
   double dRhoAve_im1half_n;
   double dRho_ip1halfjk_n;
   double dRho_im1halfjk_n;
-  double dTSq_ip1jk_n;
-  double dTSq_ijk_n;
-  double dTSq_im1jk_n;
   double dT4_ip1jk_n;
   double dT4_ijk_n;
   double dT4_im1jk_n;
@@ -9040,12 +8945,9 @@ void calNewE_R_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &procT
         //calculate derived quantities
         dUR2_im1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt-1][j][k]*dRSq_im1half_n;
         dUR2_ip1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt][j][k]*dRSq_ip1half_n;
-        dTSq_ip1jk_n=grid.dLocalGridOld[grid.nT][i+1][j][k]*grid.dLocalGridOld[grid.nT][i+1][j][k];
-        dT4_ip1jk_n=dTSq_ip1jk_n*dTSq_ip1jk_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]*grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
+        dT4_ip1jk_n=grid.dT4Old[i+1][j][k];
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
         dKappa_ip1halfjk_n=(dT4_ip1jk_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_ip1jk_n
           /grid.dLocalGridOld[grid.nKappa][i+1][j][k]);
@@ -9202,10 +9104,8 @@ void calNewE_R_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &procT
         //calculate derived quantities
         dUR2_im1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt-1][j][k]*dRSq_im1half_n;
         dUR2_ip1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt][j][k]*dRSq_ip1half_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]*grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
         dKappa_im1halfjk_n=(dT4_im1jk_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_im1jk_n
           /grid.dLocalGridOld[grid.nKappa][i-1][j][k]);
@@ -9335,11 +9235,8 @@ void calNewE_R_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop &p
   double dRho_im1jk_n;
   double dRho_ip1halfjk_n;
   double dRho_im1halfjk_n;
-  double dTSq_ip1jk_n;
   double dT4_ip1jk_n;
-  double dTSq_ijk_n;
   double dT4_ijk_n;
-  double dTSq_im1jk_n;
   double dT4_im1jk_n;
   double dKappa_ip1halfjk_n;
   double dKappa_im1halfjk_n;
@@ -9421,15 +9318,9 @@ void calNewE_R_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop &p
         dRho_im1jk_n=grid.dLocalGridOld[grid.nD][i-1][j][k];
         dRho_ip1halfjk_n=(dRho_ip1jk_n+dRho_ijk_n)*0.5;
         dRho_im1halfjk_n=(dRho_ijk_n+dRho_im1jk_n)*0.5;
-        dTSq_ip1jk_n=grid.dLocalGridOld[grid.nT][i+1][j][k]
-          *grid.dLocalGridOld[grid.nT][i+1][j][k];
-        dT4_ip1jk_n=dTSq_ip1jk_n*dTSq_ip1jk_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]
-          *grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]
-          *grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
+        dT4_ip1jk_n=grid.dT4Old[i+1][j][k];
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
         dKappa_ip1halfjk_n=(dT4_ip1jk_n+dT4_ijk_n)
           /(dT4_ijk_n/grid.dLocalGridOld[grid.nKappa][i][j][k]
           +dT4_ip1jk_n/grid.dLocalGridOld[grid.nKappa][i+1][j][k]);
@@ -9569,12 +9460,8 @@ void calNewE_R_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop &p
           setting it equal to value at i.*/
         dE_im1halfjk_n=(grid.dLocalGridOld[grid.nE][i][j][k]
           +grid.dLocalGridOld[grid.nE][i-1][j][k])*0.5;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]
-          *grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]
-          *grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
         dKappa_im1halfjk_n=(dT4_im1jk_n+dT4_ijk_n)
           /(dT4_ijk_n/grid.dLocalGridOld[grid.nKappa][i][j][k]
           +dT4_im1jk_n/grid.dLocalGridOld[grid.nKappa][i-1][j][k]);
@@ -9955,15 +9842,10 @@ void calNewE_RT_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &proc
   double dRho_ip1halfjk;
   double dRho_ijp1halfk;
   double dRho_ijm1halfk;
-  double dTSq_ip1jk_n;
   double dT4_ip1jk_n;
-  double dTSq_ijk_n;
   double dT4_ijk_n;
-  double dTSq_im1jk_n;
   double dT4_im1jk_n;
-  double dTSq_ijp1k_n;
   double dT4_ijp1k_n;
-  double dTSq_ijm1k_n;
   double dT4_ijm1k_n;
   double dKappa_ip1halfjk_n;
   double dKappa_im1halfjk_n;
@@ -10044,16 +9926,11 @@ void calNewE_RT_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &proc
           *0.5;
         dRho_ijm1halfk=(grid.dLocalGridOld[grid.nD][i][j][k]+grid.dLocalGridOld[grid.nD][i][j-1][k])
           *0.5;
-        dTSq_ip1jk_n=grid.dLocalGridOld[grid.nT][i+1][j][k]*grid.dLocalGridOld[grid.nT][i+1][j][k];
-        dT4_ip1jk_n=dTSq_ip1jk_n*dTSq_ip1jk_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]*grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]*grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]*grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
+        dT4_ip1jk_n=grid.dT4Old[i+1][j][k];
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
         dKappa_ip1halfjk_n=(dT4_ip1jk_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_ip1jk_n
           /grid.dLocalGridOld[grid.nKappa][i+1][j][k]);
@@ -10213,18 +10090,10 @@ void calNewE_RT_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &proc
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
         dRho_ijm1halfk=(grid.dLocalGridOld[grid.nD][i][j][k]
           +grid.dLocalGridOld[grid.nD][i][j-1][k])*0.5;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]
-          *grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]
-          *grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]
-          *grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]
-          *grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
         dKappa_im1halfjk_n=(dT4_im1jk_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_im1jk_n
           /grid.dLocalGridOld[grid.nKappa][i-1][j][k]);
@@ -10371,11 +10240,6 @@ void calNewE_RT_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop &
   double dRho_im1halfjk_n;
   double dRho_ijp1halfk_n;
   double dRho_ijm1halfk_n;
-  double dTSq_ijp1k_n;
-  double dTSq_ijm1k_n;
-  double dTSq_ip1jk_n;
-  double dTSq_ijk_n;
-  double dTSq_im1jk_n;
   double dT4_ip1jk_n;
   double dT4_ijk_n;
   double dT4_im1jk_n;
@@ -10501,16 +10365,11 @@ void calNewE_RT_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop &
           *grid.dLocalGridNew[grid.nV][i][nJInt-1][k];
         dUR2_im1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt-1][j][k]*dRSq_im1half_n;
         dUR2_ip1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt][j][k]*dRSq_ip1half_n;
-        dTSq_ip1jk_n=grid.dLocalGridOld[grid.nT][i+1][j][k]*grid.dLocalGridOld[grid.nT][i+1][j][k];
-        dT4_ip1jk_n=dTSq_ip1jk_n*dTSq_ip1jk_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]*grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]*grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]*grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
+        dT4_ip1jk_n=grid.dT4Old[i+1][j][k];
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
         dKappa_ip1halfjk_n=(dT4_ip1jk_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_ip1jk_n
           /grid.dLocalGridOld[grid.nKappa][i+1][j][k]);
@@ -10868,14 +10727,10 @@ void calNewE_RT_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop &
           *grid.dLocalGridNew[grid.nV][i][nJInt-1][k];
         dUR2_im1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt-1][j][k]*dRSq_im1half_n;
         dUR2_ip1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt][j][k]*dRSq_ip1half_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]*grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]*grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]*grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
         dKappa_im1halfjk_n=(dT4_im1jk_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_im1jk_n
           /grid.dLocalGridOld[grid.nKappa][i-1][j][k]);
@@ -11373,19 +11228,12 @@ void calNewE_RTP_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &pro
   double dRho_ijm1halfk;
   double dRho_ijkp1half;
   double dRho_ijkm1half;
-  double dTSq_ip1jk_n;
   double dT4_ip1jk_n;
-  double dTSq_ijk_n;
   double dT4_ijk_n;
-  double dTSq_im1jk_n;
   double dT4_im1jk_n;
-  double dTSq_ijp1k_n;
   double dT4_ijp1k_n;
-  double dTSq_ijm1k_n;
   double dT4_ijm1k_n;
-  double dTSq_ijkp1_n;
   double dT4_ijkp1_n;
-  double dTSq_ijkm1_n;
   double dT4_ijkm1_n;
   double dKappa_ip1halfjk_n;
   double dKappa_im1halfjk_n;
@@ -11493,27 +11341,13 @@ void calNewE_RTP_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &pro
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
         dRho_ijkm1half=(grid.dLocalGridOld[grid.nD][i][j][k]
           +grid.dLocalGridOld[grid.nD][i][j][k-1])*0.5;
-        dTSq_ip1jk_n=grid.dLocalGridOld[grid.nT][i+1][j][k]
-          *grid.dLocalGridOld[grid.nT][i+1][j][k];
-        dT4_ip1jk_n=dTSq_ip1jk_n*dTSq_ip1jk_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]
-          *grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]
-          *grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]
-          *grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]
-          *grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
-        dTSq_ijkp1_n=grid.dLocalGridOld[grid.nT][i][j][k+1]
-          *grid.dLocalGridOld[grid.nT][i][j][k+1];
-        dT4_ijkp1_n=dTSq_ijkp1_n*dTSq_ijkp1_n;
-        dTSq_ijkm1_n=grid.dLocalGridOld[grid.nT][i][j][k-1]
-          *grid.dLocalGridOld[grid.nT][i][j][k-1];
-        dT4_ijkm1_n=dTSq_ijkm1_n*dTSq_ijkm1_n;
+        dT4_ip1jk_n=grid.dT4Old[i+1][j][k];
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
+        dT4_ijkp1_n=grid.dT4Old[i][j][k+1];
+        dT4_ijkm1_n=grid.dT4Old[i][j][k-1];
         dKappa_ip1halfjk_n=(dT4_ip1jk_n+dT4_ijk_n)
           /(dT4_ijk_n/grid.dLocalGridOld[grid.nKappa][i][j][k]
           +dT4_ip1jk_n/grid.dLocalGridOld[grid.nKappa][i+1][j][k]);
@@ -11725,24 +11559,12 @@ void calNewE_RTP_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &pro
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
         dRho_ijkm1half=(grid.dLocalGridOld[grid.nD][i][j][k]
           +grid.dLocalGridOld[grid.nD][i][j][k-1])*0.5;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]
-          *grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]
-          *grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]
-          *grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]
-          *grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
-        dTSq_ijkp1_n=grid.dLocalGridOld[grid.nT][i][j][k+1]
-          *grid.dLocalGridOld[grid.nT][i][j][k+1];
-        dT4_ijkp1_n=dTSq_ijkp1_n*dTSq_ijkp1_n;
-        dTSq_ijkm1_n=grid.dLocalGridOld[grid.nT][i][j][k-1]
-          *grid.dLocalGridOld[grid.nT][i][j][k-1];
-        dT4_ijkm1_n=dTSq_ijkm1_n*dTSq_ijkm1_n;
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
+        dT4_ijkp1_n=grid.dT4Old[i][j][k+1];
+        dT4_ijkm1_n=grid.dT4Old[i][j][k-1];
         dKappa_im1halfjk_n=(dT4_im1jk_n+dT4_ijk_n)
           /(dT4_ijk_n/grid.dLocalGridOld[grid.nKappa][i][j][k]
           +dT4_im1jk_n/grid.dLocalGridOld[grid.nKappa][i-1][j][k]);
@@ -11879,6 +11701,53 @@ void calNewE_RTP_NA(Grid &grid, Parameters &parameters, Time &time, ProcTop &pro
     }
   }
 }
+void calRadialEnergyFaces_RTP(Grid &grid, int i, double **dEUpWindGrad, double **dRadDiff
+  , double **dEddyDiff){
+  int nIInt=i+grid.nCenIntOffset[0];
+  double dRSq_ip1half_n=grid.dRSqOld[nIInt];
+  double dR4_ip1half_n=dRSq_ip1half_n*dRSq_ip1half_n;
+  double dRhoAve_ip1half_n=(grid.dLocalGridOld[grid.nDenAve][i][0][0]
+    +grid.dLocalGridOld[grid.nDenAve][i+1][0][0])*0.5;
+  double dDM_ip1half=(grid.dLocalGridOld[grid.nDM][i][0][0]
+    +grid.dLocalGridOld[grid.nDM][i+1][0][0])*0.5;
+  double dDMSum_ip1half=grid.dLocalGridOld[grid.nDM][i+1][0][0]
+    +grid.dLocalGridOld[grid.nDM][i][0][0];
+  for(int j=grid.nStartUpdateExplicit[grid.nE][1];j<grid.nEndUpdateExplicit[grid.nE][1];j++){
+    
+    //rows of the face, so the k loop has no indirection
+    double *dE_i_n=grid.dLocalGridOld[grid.nE][i][j];
+    double *dE_ip1_n=grid.dLocalGridOld[grid.nE][i+1][j];
+    double *dRho_i_n=grid.dLocalGridOld[grid.nD][i][j];
+    double *dRho_ip1_n=grid.dLocalGridOld[grid.nD][i+1][j];
+    double *dT4_i_n=grid.dT4Old[i][j];
+    double *dT4_ip1_n=grid.dT4Old[i+1][j];
+    double *dKappa_i_n=grid.dLocalGridOld[grid.nKappa][i][j];
+    double *dKappa_ip1_n=grid.dLocalGridOld[grid.nKappa][i+1][j];
+    double *dEddyVisc_i_np1half=grid.dLocalGridNew[grid.nEddyVisc][i][j];
+    double *dEddyVisc_ip1_np1half=grid.dLocalGridNew[grid.nEddyVisc][i+1][j];
+    double *dEUpWindGrad_j=dEUpWindGrad[j];
+    double *dRadDiff_j=dRadDiff[j];
+    double *dEddyDiff_j=dEddyDiff[j];
+    for(int k=grid.nStartUpdateExplicit[grid.nE][2];k<grid.nEndUpdateExplicit[grid.nE][2];k++){
+      
+      //upwind energy gradient for the zone on either side of the face
+      dEUpWindGrad_j[k]=(dE_ip1_n[k]-dE_i_n[k])/dDMSum_ip1half*2.0;
+      
+      //radiative diffusion
+      double dRho_ip1half_n=(dRho_ip1_n[k]+dRho_i_n[k])*0.5;
+      double dKappa_ip1half_n=(dT4_ip1_n[k]+dT4_i_n[k])/(dT4_i_n[k]/dKappa_i_n[k]
+        +dT4_ip1_n[k]/dKappa_ip1_n[k]);
+      double dTGrad_ip1half=(dT4_ip1_n[k]-dT4_i_n[k])/dDMSum_ip1half*2.0;
+      dRadDiff_j[k]=dRhoAve_ip1half_n*dR4_ip1half_n/(dKappa_ip1half_n*dRho_ip1half_n)
+        *dTGrad_ip1half;
+      
+      //turbulent diffusion of energy
+      double dEddyVisc_ip1half_np1half=(dEddyVisc_ip1_np1half[k]+dEddyVisc_i_np1half[k])*0.5;
+      dEddyDiff_j[k]=dR4_ip1half_n*dEddyVisc_ip1half_np1half*dRhoAve_ip1half_n
+        *(dE_ip1_n[k]-dE_i_n[k])/(dRho_ip1half_n*dDM_ip1half);
+    }
+  }
+}
 void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop &procTop){
   int i;
   int j;
@@ -11886,7 +11755,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
   int nIInt;
   int nJInt;
   int nKInt;
-  double dDM_ip1half;
   double dDM_im1half;
   double dDelTheta_jp1half;
   double dDelTheta_jm1half;
@@ -11921,7 +11789,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
   double dR_ip1half_n;
   double dRSq_i_n;
   double dRSq_ip1half_n;
-  double dR4_ip1half_n;
   double dRSq_im1half_n;
   double dR4_im1half_n;
   double dUmU0_ijk_np1half;
@@ -11929,29 +11796,18 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
   double dVSinTheta_ijm1halfk_np1half;
   double dUR2_im1halfjk_np1half;
   double dUR2_ip1halfjk_np1half;
-  double dRhoAve_ip1half_n;
   double dRhoAve_im1half_n;
-  double dRho_ip1halfjk_n;
   double dRho_im1halfjk_n;
   double dRho_ijp1halfk_n;
   double dRho_ijm1halfk_n;
   double dRho_ijkp1half_n;
   double dRho_ijkm1half_n;
-  double dTSq_ijp1k_n;
-  double dTSq_ijm1k_n;
-  double dTSq_ip1jk_n;
-  double dTSq_ijk_n;
-  double dTSq_im1jk_n;
-  double dTSq_ijkp1_n;
-  double dTSq_ijkm1_n;
-  double dT4_ip1jk_n;
   double dT4_ijk_n;
   double dT4_im1jk_n;
   double dT4_ijp1k_n;
   double dT4_ijm1k_n;
   double dT4_ijkp1_n;
   double dT4_ijkm1_n;
-  double dKappa_ip1halfjk_n;
   double dKappa_im1halfjk_n;
   double dKappa_ijp1halfk_n;
   double dKappa_ijm1halfk_n;
@@ -11970,7 +11826,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
   double dS1;
   double dS2;
   double dS3;
-  double dTGrad_ip1half;
   double dTGrad_im1half;
   double dTGrad_jp1half;
   double dTGrad_jm1half;
@@ -11995,7 +11850,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
   double dEGrad_ijm1halfk_np1half;
   double dEGrad_ijkp1half_np1half;
   double dEGrad_ijkm1half_np1half;
-  double dEddyVisc_ip1halfjk_np1half;
   double dEddyVisc_im1halfjk_np1half;
   double dEddyVisc_ijp1halfk_np1half;
   double dEddyVisc_ijm1halfk_np1half;
@@ -12005,6 +11859,15 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
   double dLengthScale4;
   double dT4;
   double dDelR_i_n;
+  int nJUp;
+  int nKUp;
+  double **dEUpWindGrad_im1half=grid.dRadialFacePlanes[0];
+  double **dEUpWindGrad_ip1half=grid.dRadialFacePlanes[1];
+  double **dRadDiff_im1half=grid.dRadialFacePlanes[2];
+  double **dRadDiff_ip1half=grid.dRadialFacePlanes[3];
+  double **dEddyDiff_im1half=grid.dRadialFacePlanes[4];
+  double **dEddyDiff_ip1half=grid.dRadialFacePlanes[5];
+  double **dSwap;
   for(i=grid.nStartUpdateExplicit[grid.nE][0];i<grid.nEndUpdateExplicit[grid.nE][0];i++){
     
     //calculate i for interface centered quantities
@@ -12013,19 +11876,18 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
     dR_im1half_n=grid.dLocalGridOld[grid.nR][nIInt-1][0][0];
     dR_i_n=(dR_ip1half_n+dR_im1half_n)*0.5;
     dRSq_i_n=dR_i_n*dR_i_n;
-    dRSq_ip1half_n=dR_ip1half_n*dR_ip1half_n;
-    dR4_ip1half_n=dRSq_ip1half_n*dRSq_ip1half_n;
-    dRSq_im1half_n=dR_im1half_n*dR_im1half_n;
-    dR4_im1half_n=dRSq_im1half_n*dRSq_im1half_n;
+    dRSq_ip1half_n=grid.dRSqOld[nIInt];
+    dRSq_im1half_n=grid.dRSqOld[nIInt-1];
     dDelR_i_n=dR_ip1half_n-dR_im1half_n;
-    dRhoAve_ip1half_n=(grid.dLocalGridOld[grid.nDenAve][i][0][0]
-      +grid.dLocalGridOld[grid.nDenAve][i+1][0][0])*0.5;
-    dRhoAve_im1half_n=(grid.dLocalGridOld[grid.nDenAve][i][0][0]
-      +grid.dLocalGridOld[grid.nDenAve][i-1][0][0])*0.5;
     dU0_i_np1half=(grid.dLocalGridNew[grid.nU0][nIInt][0][0]
       +grid.dLocalGridNew[grid.nU0][nIInt-1][0][0])*0.5;
-    dDM_ip1half=(grid.dLocalGridOld[grid.nDM][i][0][0]+grid.dLocalGridOld[grid.nDM][i+1][0][0])*0.5;
-    dDM_im1half=(grid.dLocalGridOld[grid.nDM][i][0][0]+grid.dLocalGridOld[grid.nDM][i-1][0][0])*0.5;
+    
+    //radial faces, the outer face of this shell is the inner face of the next one
+    if(i==grid.nStartUpdateExplicit[grid.nE][0]){
+      calRadialEnergyFaces_RTP(grid,i-1,dEUpWindGrad_im1half,dRadDiff_im1half
+        ,dEddyDiff_im1half);
+    }
+    calRadialEnergyFaces_RTP(grid,i,dEUpWindGrad_ip1half,dRadDiff_ip1half,dEddyDiff_ip1half);
     
     for(j=grid.nStartUpdateExplicit[grid.nE][1];j<grid.nEndUpdateExplicit[grid.nE][1];j++){
       
@@ -12102,10 +11964,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           *0.5;
         dE_ijkm1half_n=(grid.dLocalGridOld[grid.nE][i][j][k-1]+grid.dLocalGridOld[grid.nE][i][j][k])
           *0.5;
-        dRho_ip1halfjk_n=(grid.dLocalGridOld[grid.nD][i+1][j][k]
-          +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
-        dRho_im1halfjk_n=(grid.dLocalGridOld[grid.nD][i][j][k]
-          +grid.dLocalGridOld[grid.nD][i-1][j][k])*0.5;
         dRho_ijp1halfk_n=(grid.dLocalGridOld[grid.nD][i][j+1][k]
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
         dRho_ijm1halfk_n=(grid.dLocalGridOld[grid.nD][i][j][k]
@@ -12114,10 +11972,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
         dRho_ijkm1half_n=(grid.dLocalGridOld[grid.nD][i][j][k]
           +grid.dLocalGridOld[grid.nD][i][j][k-1])*0.5;
-        dEddyVisc_ip1halfjk_np1half=(grid.dLocalGridNew[grid.nEddyVisc][i+1][j][k]
-          +grid.dLocalGridNew[grid.nEddyVisc][i][j][k])*0.5;
-        dEddyVisc_im1halfjk_np1half=(grid.dLocalGridNew[grid.nEddyVisc][i-1][j][k]
-          +grid.dLocalGridNew[grid.nEddyVisc][i][j][k])*0.5;
         dEddyVisc_ijp1halfk_np1half=(grid.dLocalGridNew[grid.nEddyVisc][i][j+1][k]
         +grid.dLocalGridNew[grid.nEddyVisc][i][j][k])*0.5;
         dEddyVisc_ijm1halfk_np1half=(grid.dLocalGridNew[grid.nEddyVisc][i][j-1][k]
@@ -12134,26 +11988,11 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           *grid.dLocalGridNew[grid.nV][i][nJInt-1][k];
         dUR2_im1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt-1][j][k]*dRSq_im1half_n;
         dUR2_ip1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt][j][k]*dRSq_ip1half_n;
-        dTSq_ip1jk_n=grid.dLocalGridOld[grid.nT][i+1][j][k]*grid.dLocalGridOld[grid.nT][i+1][j][k];
-        dT4_ip1jk_n=dTSq_ip1jk_n*dTSq_ip1jk_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]*grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]*grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]*grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
-        dTSq_ijkp1_n=grid.dLocalGridOld[grid.nT][i][j][k+1]*grid.dLocalGridOld[grid.nT][i][j][k+1];
-        dT4_ijkp1_n=dTSq_ijkp1_n*dTSq_ijkp1_n;
-        dTSq_ijkm1_n=grid.dLocalGridOld[grid.nT][i][j][k-1]*grid.dLocalGridOld[grid.nT][i][j][k-1];
-        dT4_ijkm1_n=dTSq_ijkm1_n*dTSq_ijkm1_n;
-        dKappa_ip1halfjk_n=(dT4_ip1jk_n+dT4_ijk_n)/(dT4_ijk_n
-          /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_ip1jk_n
-          /grid.dLocalGridOld[grid.nKappa][i+1][j][k]);
-        dKappa_im1halfjk_n=(dT4_im1jk_n+dT4_ijk_n)/(dT4_ijk_n
-          /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_im1jk_n
-          /grid.dLocalGridOld[grid.nKappa][i-1][j][k]);
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
+        dT4_ijkp1_n=grid.dT4Old[i][j][k+1];
+        dT4_ijkm1_n=grid.dT4Old[i][j][k-1];
         dKappa_ijp1halfk_n=(dT4_ijp1k_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_ijp1k_n
           /grid.dLocalGridOld[grid.nKappa][i][j+1][k]);
@@ -12175,16 +12014,8 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
         //Calcuate dA1
         dA1CenGrad=(dE_ip1halfjk_n-dE_im1halfjk_n)/grid.dLocalGridOld[grid.nDM][i][0][0];
         dUmU0_ijk_np1half=(dU_ijk_np1half-dU0_i_np1half);
-        if(dUmU0_ijk_np1half<0.0){//moving in the negative direction
-          dA1UpWindGrad=(grid.dLocalGridOld[grid.nE][i+1][j][k]
-            -grid.dLocalGridOld[grid.nE][i][j][k])/(grid.dLocalGridOld[grid.nDM][i+1][0][0]
-            +grid.dLocalGridOld[grid.nDM][i][0][0])*2.0;
-        }
-        else{//moving in the postive direction
-          dA1UpWindGrad=(grid.dLocalGridOld[grid.nE][i][j][k]
-            -grid.dLocalGridOld[grid.nE][i-1][j][k])/(grid.dLocalGridOld[grid.nDM][i][0][0]
-            +grid.dLocalGridOld[grid.nDM][i-1][0][0])*2.0;
-        }
+        dA1UpWindGrad=(dUmU0_ijk_np1half<0.0)//moving in the negative, or positive direction
+          ?dEUpWindGrad_ip1half[j][k]:dEUpWindGrad_im1half[j][k];
         dA1=dUmU0_ijk_np1half*dRSq_i_n*((1.0-grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])
           *dA1CenGrad+grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]*dA1UpWindGrad);
         
@@ -12194,16 +12025,10 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
         
         //Calcualte dA2
         dA2CenGrad=(dE_ijp1halfk_n-dE_ijm1halfk_n)/grid.dLocalGridOld[grid.nDTheta][0][j][0];
-        if(dV_ijk_np1half<0.0){//moving in the negative direction
-          dA2UpWindGrad=(grid.dLocalGridOld[grid.nE][i][j+1][k]
-            -grid.dLocalGridOld[grid.nE][i][j][k])/(grid.dLocalGridOld[grid.nDTheta][0][j+1][0]
-            +grid.dLocalGridOld[grid.nDTheta][0][j][0])*2.0;
-        }
-        else{//moving in the positive direction
-          dA2UpWindGrad=(grid.dLocalGridOld[grid.nE][i][j][k]
-            -grid.dLocalGridOld[grid.nE][i][j-1][k])/(grid.dLocalGridOld[grid.nDTheta][0][j][0]
-            +grid.dLocalGridOld[grid.nDTheta][0][j-1][0])*2.0;
-        }
+        nJUp=(dV_ijk_np1half<0.0)?j+1:j;//gradient across the upwind face
+        dA2UpWindGrad=(grid.dLocalGridOld[grid.nE][i][nJUp][k]
+          -grid.dLocalGridOld[grid.nE][i][nJUp-1][k])/(grid.dLocalGridOld[grid.nDTheta][0][nJUp][0]
+          +grid.dLocalGridOld[grid.nDTheta][0][nJUp-1][0])*2.0;
         dA2=dV_ijk_np1half/dR_i_n*((1.0-grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])
           *dA2CenGrad+grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]*dA2UpWindGrad);
           
@@ -12214,16 +12039,11 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
         
         //Calcualte dA3
         dA3CenGrad=(dE_ijkp1half_n-dE_ijkm1half_n)/grid.dLocalGridOld[grid.nDPhi][0][0][k];
-        if(dW_ijk_np1half<0.0){//moving in the negative direction
-          dA3UpWindGrad=(grid.dLocalGridOld[grid.nE][i][j][k+1]
-            -grid.dLocalGridOld[grid.nE][i][j][k])/
-            (grid.dLocalGridOld[grid.nDPhi][0][0][k+1]+grid.dLocalGridOld[grid.nDPhi][0][0][k])*2.0;
-        }
-        else{//moving in the positive direction
-          dA3UpWindGrad=(grid.dLocalGridOld[grid.nE][i][j][k]
-            -grid.dLocalGridOld[grid.nE][i][j][k-1])/
-            (grid.dLocalGridOld[grid.nDPhi][0][0][k]+grid.dLocalGridOld[grid.nDPhi][0][0][k-1])*2.0;
-        }
+        nKUp=(dW_ijk_np1half<0.0)?k+1:k;//gradient across the upwind face
+        dA3UpWindGrad=(grid.dLocalGridOld[grid.nE][i][j][nKUp]
+          -grid.dLocalGridOld[grid.nE][i][j][nKUp-1])/
+          (grid.dLocalGridOld[grid.nDPhi][0][0][nKUp]+grid.dLocalGridOld[grid.nDPhi][0][0][nKUp-1])
+          *2.0;
         dA3=dW_ijk_np1half/(dR_i_n*grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0])*
           ((1.0-grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0])*dA3CenGrad
           +grid.dLocalGridOld[grid.nDonorCellFrac][i][0][0]*dA3UpWindGrad);
@@ -12234,16 +12054,8 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           *(dW_ijkp1half_np1half-dW_ijkm1half_np1half);
         
         //Calculate dS4
-        dTGrad_ip1half=(dT4_ip1jk_n-dT4_ijk_n)/(grid.dLocalGridOld[grid.nDM][i+1][0][0]
-          +grid.dLocalGridOld[grid.nDM][i][0][0])*2.0;
-        dTGrad_im1half=(dT4_ijk_n-dT4_im1jk_n)/(grid.dLocalGridOld[grid.nDM][i][0][0]
-          +grid.dLocalGridOld[grid.nDM][i-1][0][0])*2.0;
-        dGrad_ip1half=dRhoAve_ip1half_n*dR4_ip1half_n/(dKappa_ip1halfjk_n
-          *dRho_ip1halfjk_n)*dTGrad_ip1half;
-        dGrad_im1half=dRhoAve_im1half_n*dR4_im1half_n/(dKappa_im1halfjk_n
-          *dRho_im1halfjk_n)*dTGrad_im1half;
         dS4=16.0*dPiSq*grid.dLocalGridOld[grid.nDenAve][i][0][0]
-          *(dGrad_ip1half-dGrad_im1half)/grid.dLocalGridOld[grid.nDM][i][0][0];
+          *(dRadDiff_ip1half[j][k]-dRadDiff_im1half[j][k])/grid.dLocalGridOld[grid.nDM][i][0][0];
         
         //Calculate dS5
         dTGrad_jp1half=(dT4_ijp1k_n-dT4_ijk_n)/(grid.dLocalGridOld[grid.nDTheta][0][j+1][0]
@@ -12269,14 +12081,8 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           *grid.dLocalGridOld[grid.nSinThetaIJK][0][j][0]*grid.dLocalGridOld[grid.nDPhi][0][0][k]);
         
         //calculate dT1
-        dEGrad_ip1halfjk_np1half=dR4_ip1half_n*dEddyVisc_ip1halfjk_np1half*dRhoAve_ip1half_n
-          *(grid.dLocalGridOld[grid.nE][i+1][j][k]-grid.dLocalGridOld[grid.nE][i][j][k])
-          /(dRho_ip1halfjk_n*dDM_ip1half);
-        dEGrad_im1halfjk_np1half=dR4_im1half_n*dEddyVisc_im1halfjk_np1half*dRhoAve_im1half_n
-          *(grid.dLocalGridOld[grid.nE][i][j][k]-grid.dLocalGridOld[grid.nE][i-1][j][k])
-          /(dRho_im1halfjk_n*dDM_im1half);
-        dT1=16.0*dPiSq*grid.dLocalGridOld[grid.nDenAve][i][0][0]*(dEGrad_ip1halfjk_np1half
-          -dEGrad_im1halfjk_np1half)/grid.dLocalGridOld[grid.nDM][i][0][0];
+        dT1=16.0*dPiSq*grid.dLocalGridOld[grid.nDenAve][i][0][0]*(dEddyDiff_ip1half[j][k]
+          -dEddyDiff_im1half[j][k])/grid.dLocalGridOld[grid.nDM][i][0][0];
         
         //calculate dT2
         dEGrad_ijp1halfk_np1half=dEddyVisc_ijp1halfk_np1half
@@ -12431,6 +12237,17 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
         }
       }
     }
+    
+    //the outer faces become the inner faces of the next shell
+    dSwap=dEUpWindGrad_im1half;
+    dEUpWindGrad_im1half=dEUpWindGrad_ip1half;
+    dEUpWindGrad_ip1half=dSwap;
+    dSwap=dRadDiff_im1half;
+    dRadDiff_im1half=dRadDiff_ip1half;
+    dRadDiff_ip1half=dSwap;
+    dSwap=dEddyDiff_im1half;
+    dEddyDiff_im1half=dEddyDiff_ip1half;
+    dEddyDiff_ip1half=dSwap;
   }
   
   //ghost region 0, outter most ghost region in x1 direction
@@ -12444,19 +12261,13 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
     dR_i_n=(dR_ip1half_n+dR_im1half_n)*0.5;
     dRSq_i_n=dR_i_n*dR_i_n;
     dRSq_ip1half_n=dR_ip1half_n*dR_ip1half_n;
-    dR4_ip1half_n=dRSq_ip1half_n*dRSq_ip1half_n;
     dRSq_im1half_n=dR_im1half_n*dR_im1half_n;
     dR4_im1half_n=dRSq_im1half_n*dRSq_im1half_n;
     dDelR_i_n=dR_ip1half_n-dR_im1half_n;
-    dRhoAve_ip1half_n=grid.dLocalGridOld[grid.nDenAve][i][0][0]*0.5;/*\BC missing average density
-      outside model setting it to zero*/
     dRhoAve_im1half_n=(grid.dLocalGridOld[grid.nDenAve][i][0][0]
       +grid.dLocalGridOld[grid.nDenAve][i-1][0][0])*0.5;
     dU0_i_np1half=(grid.dLocalGridNew[grid.nU0][nIInt][0][0]
       +grid.dLocalGridNew[grid.nU0][nIInt-1][0][0])*0.5;
-    dDM_ip1half=(grid.dLocalGridOld[grid.nDM][i][0][0])*(0.5+parameters.dAlpha
-      +parameters.dAlphaExtra);/**\BC Missing \f$\Delta M_r\f$ outside model using 
-      \ref Parameters.dAlpha times \f$\Delta M_r\f$ in the last zone instead.*/
     dDM_im1half=(grid.dLocalGridOld[grid.nDM][i][0][0]+grid.dLocalGridOld[grid.nDM][i-1][0][0])*0.5;
     
     for(j=grid.nStartGhostUpdateExplicit[grid.nE][0][1];
@@ -12533,8 +12344,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           *0.5;
         dE_ijkm1half_n=(grid.dLocalGridOld[grid.nE][i][j][k-1]+grid.dLocalGridOld[grid.nE][i][j][k])
           *0.5;
-        dRho_ip1halfjk_n=(grid.dLocalGridOld[grid.nD][i][j][k])*0.5;/**\BC missing density outside
-          model, setting it to zero*/
         dRho_im1halfjk_n=(grid.dLocalGridOld[grid.nD][i][j][k]
           +grid.dLocalGridOld[grid.nD][i-1][j][k])*0.5;
         dRho_ijp1halfk_n=(grid.dLocalGridOld[grid.nD][i][j+1][k]
@@ -12545,8 +12354,6 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           +grid.dLocalGridOld[grid.nD][i][j][k])*0.5;
         dRho_ijkm1half_n=(grid.dLocalGridOld[grid.nD][i][j][k]
           +grid.dLocalGridOld[grid.nD][i][j][k-1])*0.5;
-        dEddyVisc_ip1halfjk_np1half=(grid.dLocalGridNew[grid.nEddyVisc][i][j][k])*0.5;/**\BC missing 
-          eddy viscosity outside the model setting it to zero*/
         dEddyVisc_im1halfjk_np1half=(grid.dLocalGridNew[grid.nEddyVisc][i-1][j][k]
           +grid.dLocalGridNew[grid.nEddyVisc][i][j][k])*0.5;
         dEddyVisc_ijp1halfk_np1half=(grid.dLocalGridNew[grid.nEddyVisc][i][j+1][k]
@@ -12565,18 +12372,12 @@ void calNewE_RTP_NA_LES(Grid &grid, Parameters &parameters, Time &time, ProcTop
           *grid.dLocalGridNew[grid.nV][i][nJInt-1][k];
         dUR2_im1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt-1][j][k]*dRSq_im1half_n;
         dUR2_ip1halfjk_np1half=grid.dLocalGridNew[grid.nU][nIInt][j][k]*dRSq_ip1half_n;
-        dTSq_ijk_n=grid.dLocalGridOld[grid.nT][i][j][k]*grid.dLocalGridOld[grid.nT][i][j][k];
-        dT4_ijk_n=dTSq_ijk_n*dTSq_ijk_n;
-        dTSq_im1jk_n=grid.dLocalGridOld[grid.nT][i-1][j][k]*grid.dLocalGridOld[grid.nT][i-1][j][k];
-        dT4_im1jk_n=dTSq_im1jk_n*dTSq_im1jk_n;
-        dTSq_ijp1k_n=grid.dLocalGridOld[grid.nT][i][j+1][k]*grid.dLocalGridOld[grid.nT][i][j+1][k];
-        dT4_ijp1k_n=dTSq_ijp1k_n*dTSq_ijp1k_n;
-        dTSq_ijm1k_n=grid.dLocalGridOld[grid.nT][i][j-1][k]*grid.dLocalGridOld[grid.nT][i][j-1][k];
-        dT4_ijm1k_n=dTSq_ijm1k_n*dTSq_ijm1k_n;
-        dTSq_ijkp1_n=grid.dLocalGridOld[grid.nT][i][j][k+1]*grid.dLocalGridOld[grid.nT][i][j][k+1];
-        dT4_ijkp1_n=dTSq_ijkp1_n*dTSq_ijkp1_n;
-        dTSq_ijkm1_n=grid.dLocalGridOld[grid.nT][i][j][k-1]*grid.dLocalGridOld[grid.nT][i][j][k-1];
-        dT4_ijkm1_n=dTSq_ijkm1_n*dTSq_ijkm1_n;
+        dT4_ijk_n=grid.dT4Old[i][j][k];
+        dT4_im1jk_n=grid.dT4Old[i-1][j][k];
+        dT4_ijp1k_n=grid.dT4Old[i][j+1][k];
+        dT4_ijm1k_n=grid.dT4Old[i][j-1][k];
+        dT4_ijkp1_n=grid.dT4Old[i][j][k+1];
+        dT4_ijkm1_n=grid.dT4Old[i][j][k-1];
         dKappa_im1halfjk_n=(dT4_im1jk_n+dT4_ijk_n)/(dT4_ijk_n
           /grid.dLocalGridOld[grid.nKappa][i][j][k]+dT4_im1jk_n
           /grid.dLocalGridOld[grid.nKappa][i-1][j][k]);
@@ -12775,23 +12576,17 @@ void calNewDenave_RT(Grid &grid){
   int i;
   int j;
   int k;
-  int nIInt;
   double dSum;
   double dVolume;
   double dRFactor;
   double dVolumeTemp;
   for(i=grid.nStartUpdateExplicit[grid.nDenAve][0];i<grid.nEndUpdateExplicit[grid.nDenAve][0];i++){
-    
-    //calculate i for interface centered quantities
-    nIInt=i+grid.nCenIntOffset[0];
-    
     dSum=0.0;
     dVolume=0.0;
-    dRFactor=0.33333333333333333*(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-      -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
+    dRFactor=0.33333333333333333*grid.dDelRCuNew[i];
     for(j=grid.nStartUpdateExplicit[grid.nD][1];j<grid.nEndUpdateExplicit[grid.nD][1];j++){
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
-        dVolumeTemp=dRFactor*grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+        dVolumeTemp=dRFactor*grid.dDCosThetaDPhi[j][0];
         dSum+=dVolumeTemp*grid.dLocalGridNew[grid.nD][i][j][k];
         dVolume+=dVolumeTemp;
       }
@@ -12802,17 +12597,12 @@ void calNewDenave_RT(Grid &grid){
   //ghost region 0, outter most ghost region in x1 direction
   for(i=grid.nStartGhostUpdateExplicit[grid.nDenAve][0][0];
     i<grid.nEndGhostUpdateExplicit[grid.nDenAve][0][0];i++){
-    
-    //calculate i for interface centered quantities
-    nIInt=i+grid.nCenIntOffset[0];
-    
     dSum=0.0;
     dVolume=0.0;
-    dRFactor=0.33333333333333333*(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-      -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
+    dRFactor=0.33333333333333333*grid.dDelRCuNew[i];
     for(j=grid.nStartUpdateExplicit[grid.nD][1];j<grid.nEndUpdateExplicit[grid.nD][1];j++){
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
-        dVolumeTemp=dRFactor*grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0];
+        dVolumeTemp=dRFactor*grid.dDCosThetaDPhi[j][0];
         dSum+=dVolumeTemp*grid.dLocalGridNew[grid.nD][i][j][k];
         dVolume+=dVolumeTemp;
       }
@@ -12824,24 +12614,17 @@ void calNewDenave_RTP(Grid &grid){
   int i;
   int j;
   int k;
-  int nIInt;
   double dSum;
   double dVolume;
   double dRFactor;
   double dVolumeTemp;
   for(i=grid.nStartUpdateExplicit[grid.nDenAve][0];i<grid.nEndUpdateExplicit[grid.nDenAve][0];i++){
-    
-    //calculate i for interface centered quantities
-    nIInt=i+grid.nCenIntOffset[0];
-    
     dSum=0.0;
     dVolume=0.0;
-    dRFactor=0.33333333333333333*(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-      -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
+    dRFactor=0.33333333333333333*grid.dDelRCuNew[i];
     for(j=grid.nStartUpdateExplicit[grid.nD][1];j<grid.nEndUpdateExplicit[grid.nD][1];j++){
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
-        dVolumeTemp=dRFactor*grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
-          *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+        dVolumeTemp=dRFactor*grid.dDCosThetaDPhi[j][k];
         dSum+=dVolumeTemp*grid.dLocalGridNew[grid.nD][i][j][k];
         dVolume+=dVolumeTemp;
       }
@@ -12852,18 +12635,12 @@ void calNewDenave_RTP(Grid &grid){
   //ghost region 0, outter most ghost region in x1 direction
   for(i=grid.nStartGhostUpdateExplicit[grid.nDenAve][0][0];
     i<grid.nEndGhostUpdateExplicit[grid.nDenAve][0][0];i++){
-    
-    //calculate i for interface centered quantities
-    nIInt=i+grid.nCenIntOffset[0];
-    
     dSum=0.0;
     dVolume=0.0;
-    dRFactor=0.33333333333333333*(pow(grid.dLocalGridNew[grid.nR][nIInt][0][0],3.0)
-      -pow(grid.dLocalGridNew[grid.nR][nIInt-1][0][0],3.0));
+    dRFactor=0.33333333333333333*grid.dDelRCuNew[i];
     for(j=grid.nStartUpdateExplicit[grid.nD][1];j<grid.nEndUpdateExplicit[grid.nD][1];j++){
       for(k=grid.nStartUpdateExplicit[grid.nD][2];k<grid.nEndUpdateExplicit[grid.nD][2];k++){
-        dVolumeTemp=dRFactor*grid.dLocalGridOld[grid.nDCosThetaIJK][0][j][0]
-          *grid.dLocalGridOld[grid.nDPhi][0][0][k];
+        dVolumeTemp=dRFactor*grid.dDCosThetaDPhi[j][k];
         dSum+=dVolumeTemp*grid.dLocalGridNew[grid.nD][i][j][k];
         dVolume+=dVolumeTemp;
       }
@@ -12918,39 +12695,61 @@ void calNewTPKappaGamma_TEOS(Grid& grid,Parameters &parameters){
   double dT;
   double dE;
   double dDelE;
+  bool bConverged;
   
   //P, T, Kappa, and Gamma are all cenetered quantities, so bounds of any will be the same
   for(i=grid.nStartUpdateExplicit[grid.nP][0];i<grid.nEndUpdateExplicit[grid.nP][0];i++){
     for(j=grid.nStartUpdateExplicit[grid.nP][1];j<grid.nEndUpdateExplicit[grid.nP][1];j++){
       for(k=grid.nStartUpdateExplicit[grid.nP][2];k<grid.nEndUpdateExplicit[grid.nP][2];k++){
         
-        //calculate new temperature
-        dError=std::numeric_limits<double>::max();
-        dT=grid.dLocalGridOld[grid.nT][i][j][k];
-        nCount=0;
-        while(dError>parameters.dTolerance&&nCount<parameters.nMaxIterations){
-          parameters.eosTable.getEAndDTDE(dT,grid.dLocalGridNew[grid.nD][i][j][k],dE,dDTDE);
-          
-          //correct temperature
-          dDelE=grid.dLocalGridNew[grid.nE][i][j][k]-dE;
-          dT=dDelE*dDTDE+dT;
+        //temperature starting from the table cell of the last step, and P, Kappa, Gamma from the
+        //same table cell
+        bConverged=false;
+        if(parameters.eosTable.bInverse){
           
-          //how far off was the energy
-          dError=fabs(dDelE)/grid.dLocalGridNew[grid.nE][i][j][k];
-          nCount++;
+          //no cell yet after a start or restart, start from the cell of the old temperature so
+          //that the same root is found as by iterating from it
+          if(grid.nEOSCell[i][j][k]<0){
+            grid.nEOSCell[i][j][k]=parameters.eosTable.nGetCell(
+              grid.dLocalGridOld[grid.nT][i][j][k],grid.dLocalGridNew[grid.nD][i][j][k]);
+          }
+          bConverged=parameters.eosTable.bGetTPKappaGamma(grid.dLocalGridNew[grid.nE][i][j][k]
+            ,grid.dLocalGridNew[grid.nD][i][j][k],parameters.dTolerance,parameters.nMaxIterations
+            ,grid.nEOSCell[i][j][k],grid.dLocalGridNew[grid.nT][i][j][k]
+            ,grid.dLocalGridNew[grid.nP][i][j][k]
+            ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
         }
-        if(nCount>=parameters.nMaxIterations){
-          std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": The maximum number of iteration"
-          <<" for converging temperature in explicit region from equation of state ("
-          <<parameters.nMaxIterations<<") has been exceeded with a maximum relative error in "
-          <<"matching the energy of "<<dError<<std::endl;
+        if(!bConverged){
+          
+          //calculate new temperature iterating from the old temperature, also if the table lookup
+          //didn't converge
+          dError=std::numeric_limits<double>::max();
+          dT=grid.dLocalGridOld[grid.nT][i][j][k];
+          nCount=0;
+          while(dError>parameters.dTolerance&&nCount<parameters.nMaxIterations){
+            parameters.eosTable.getEAndDTDE(dT,grid.dLocalGridNew[grid.nD][i][j][k],dE,dDTDE);
+          
+            //correct temperature
+            dDelE=grid.dLocalGridNew[grid.nE][i][j][k]-dE;
+            dT=dDelE*dDTDE+dT;
+          
+            //how far off was the energy
+            dError=fabs(dDelE)/grid.dLocalGridNew[grid.nE][i][j][k];
+            nCount++;
+          }
+          if(nCount>=parameters.nMaxIterations){
+            std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": The maximum number of iteration"
+            <<" for converging temperature in explicit region from equation of state ("
+            <<parameters.nMaxIterations<<") has been exceeded with a maximum relative error in "
+            <<"matching the energy of "<<dError<<std::endl;
+          }
+          grid.dLocalGridNew[grid.nT][i][j][k]=dT;
+          
+          //get P, Kappa, Gamma
+          parameters.eosTable.getPKappaGamma(grid.dLocalGridNew[grid.nT][i][j][k]
+            ,grid.dLocalGridNew[grid.nD][i][j][k],grid.dLocalGridNew[grid.nP][i][j][k]
+            ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
         }
-        grid.dLocalGridNew[grid.nT][i][j][k]=dT;
-        
-        //get P, Kappa, Gamma
-        parameters.eosTable.getPKappaGamma(grid.dLocalGridNew[grid.nT][i][j][k]
-          ,grid.dLocalGridNew[grid.nD][i][j][k],grid.dLocalGridNew[grid.nP][i][j][k]
-          ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
       }
     }
   }
@@ -12961,33 +12760,54 @@ void calNewTPKappaGamma_TEOS(Grid& grid,Parameters &parameters){
       for(k=grid.nStartGhostUpdateExplicit[grid.nP][0][2];
         k<grid.nEndGhostUpdateExplicit[grid.nP][0][2];k++){
         
-        //calculate new temperature
-        dError=std::numeric_limits<double>::max();
-        dT=grid.dLocalGridOld[grid.nT][i][j][k];
-        nCount=0;
-        while(dError>parameters.dTolerance&&nCount<parameters.nMaxIterations){
-          parameters.eosTable.getEAndDTDE(dT,grid.dLocalGridNew[grid.nD][i][j][k],dE,dDTDE);
-          
-          //correct temperature
-          dDelE=grid.dLocalGridNew[grid.nE][i][j][k]-dE;
-          dT=dDelE*dDTDE+dT;
+        //temperature starting from the table cell of the last step, and P, Kappa, Gamma from the
+        //same table cell
+        bConverged=false;
+        if(parameters.eosTable.bInverse){
           
-          //how far off was the energy
-          dError=fabs(dDelE)/grid.dLocalGridNew[grid.nE][i][j][k];
-          nCount++;
+          //no cell yet after a start or restart, start from the cell of the old temperature so
+          //that the same root is found as by iterating from it
+          if(grid.nEOSCell[i][j][k]<0){
+            grid.nEOSCell[i][j][k]=parameters.eosTable.nGetCell(
+              grid.dLocalGridOld[grid.nT][i][j][k],grid.dLocalGridNew[grid.nD][i][j][k]);
+          }
+          bConverged=parameters.eosTable.bGetTPKappaGamma(grid.dLocalGridNew[grid.nE][i][j][k]
+            ,grid.dLocalGridNew[grid.nD][i][j][k],parameters.dTolerance,parameters.nMaxIterations
+            ,grid.nEOSCell[i][j][k],grid.dLocalGridNew[grid.nT][i][j][k]
+            ,grid.dLocalGridNew[grid.nP][i][j][k]
+            ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
         }
-        if(nCount>=parameters.nMaxIterations){
-          std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": The maximum number of iteration"
-          <<" for converging temperature in explicit region from equation of state ("
-          <<parameters.nMaxIterations<<") has been exceeded with a maximum relative error in "
-          <<"matching the energy of "<<dError<<std::endl;
+        if(!bConverged){
+          
+          //calculate new temperature iterating from the old temperature, also if the table lookup
+          //didn't converge
+          dError=std::numeric_limits<double>::max();
+          dT=grid.dLocalGridOld[grid.nT][i][j][k];
+          nCount=0;
+          while(dError>parameters.dTolerance&&nCount<parameters.nMaxIterations){
+            parameters.eosTable.getEAndDTDE(dT,grid.dLocalGridNew[grid.nD][i][j][k],dE,dDTDE);
+          
+            //correct temperature
+            dDelE=grid.dLocalGridNew[grid.nE][i][j][k]-dE;
+            dT=dDelE*dDTDE+dT;
+          
+            //how far off was the energy
+            dError=fabs(dDelE)/grid.dLocalGridNew[grid.nE][i][j][k];
+            nCount++;
+          }
+          if(nCount>=parameters.nMaxIterations){
+            std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": The maximum number of iteration"
+            <<" for converging temperature in explicit region from equation of state ("
+            <<parameters.nMaxIterations<<") has been exceeded with a maximum relative error in "
+            <<"matching the energy of "<<dError<<std::endl;
+          }
+          grid.dLocalGridNew[grid.nT][i][j][k]=dT;
+          
+          //get P, Kappa, Gamma
+          parameters.eosTable.getPKappaGamma(grid.dLocalGridNew[grid.nT][i][j][k]
+            ,grid.dLocalGridNew[grid.nD][i][j][k],grid.dLocalGridNew[grid.nP][i][j][k]
+            ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
         }
-        grid.dLocalGridNew[grid.nT][i][j][k]=dT;
-        
-        //get P, Kappa, Gamma
-        parameters.eosTable.getPKappaGamma(grid.dLocalGridNew[grid.nT][i][j][k]
-          ,grid.dLocalGridNew[grid.nD][i][j][k],grid.dLocalGridNew[grid.nP][i][j][k]
-          ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
       }
     }
   }
@@ -13003,9 +12823,9 @@ void calNewPEKappaGamma_TEOS(Grid& grid,Parameters &parameters){
       for(k=grid.nStartUpdateImplicit[grid.nP][2];k<grid.nEndUpdateImplicit[grid.nP][2];k++){
         
         parameters.eosTable.getPEKappaGamma(grid.dLocalGridNew[grid.nT][i][j][k]
-          ,grid.dLocalGridNew[grid.nD][i][j][k],grid.dLocalGridNew[grid.nP][i][j][k]
-          ,grid.dLocalGridNew[grid.nE][i][j][k],grid.dLocalGridNew[grid.nKappa][i][j][k]
-          ,grid.dLocalGridNew[grid.nGamma][i][j][k]);
+          ,grid.dLocalGridNew[grid.nD][i][j][k],grid.nEOSCell[i][j][k]
+          ,grid.dLocalGridNew[grid.nP][i][j][k],grid.dLocalGridNew[grid.nE][i][j][k]
+          ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
       }
     }
   }
@@ -13017,9 +12837,9 @@ void calNewPEKappaGamma_TEOS(Grid& grid,Parameters &parameters){
         k<grid.nEndGhostUpdateImplicit[grid.nP][0][2];k++){
         
         parameters.eosTable.getPEKappaGamma(grid.dLocalGridNew[grid.nT][i][j][k]
-          ,grid.dLocalGridNew[grid.nD][i][j][k],grid.dLocalGridNew[grid.nP][i][j][k]
-          ,grid.dLocalGridNew[grid.nE][i][j][k],grid.dLocalGridNew[grid.nKappa][i][j][k]
-          ,grid.dLocalGridNew[grid.nGamma][i][j][k]);
+          ,grid.dLocalGridNew[grid.nD][i][j][k],grid.nEOSCell[i][j][k]
+          ,grid.dLocalGridNew[grid.nP][i][j][k],grid.dLocalGridNew[grid.nE][i][j][k]
+          ,grid.dLocalGridNew[grid.nKappa][i][j][k],grid.dLocalGridNew[grid.nGamma][i][j][k]);
       }
     }
   }
@@ -166,6 +166,19 @@ void calNewU_RTP(Grid& grid,Parameters &parameters,Time &time,ProcTop &procTop);
   @param[in] time contains time information, e.g. time step, current time etc.
   @param[in] procTop contains information about the processor topology
 */
+void calRadialStress_RTP(Grid &grid, Parameters &parameters, int i, double **dUUpWindGrad
+  , double **dTau_rr);/**<
+  This function calculates the zone centered quantities of zone \p i used by
+  \ref calNewU_RTP_LES at the interfaces on either side of the zone, for all \p j and \p k it
+  updates. Each is the same for both interfaces, so it is only computed once.
+  
+  @param[in] grid supplies the old grid and the cached geometry
+  @param[in] parameters supplies \ref Parameters::dPi
+  @param[in] i radial index of the zone
+  @param[out] dUUpWindGrad plane of \ref Grid::dRadialFacePlanes to hold the radial velocity
+             gradient across the zone, used as the upwind gradient by the interface downwind of it
+  @param[out] dTau_rr plane to hold the rr component of the turbulent stress tensor
+  */
 void calNewU_RTP_LES(Grid& grid,Parameters &parameters,Time &time,ProcTop &procTop);/**<
   This function calculates the radial velocity, and does it by including all radial, theta and
   phi terms. It also includes the terms for including real viscosity, used in the LES.
@@ -289,6 +302,20 @@ void calNewD_RT(Grid& grid, Parameters &parameters, Time &time,ProcTop &procTop)
   @param[in] procTop contains information about the processor topology, uses \ref ProcTop::nRank 
              when reporting negative densities
   */
+void calRadialMassFlux_RTP(Grid &grid, int i, double **dFlux_i, double **dFlux_ip1);/**<
+  This function calculates the donor cell weighted mass flux through the radial face between zones
+  \p i and \p i+1 for all \p j and \p k updated by \ref calNewD_RTP. As in the per zone
+  calculation the upwind zone is chosen from the sign of \f$u-u_0\f$ at \f$n-1/2\f$ for zone
+  \p i, for which it is the outer face, and at \f$n+1/2\f$ for zone \p i+1, for which it is the
+  inner face, so both fluxes are returned.
+  
+  @param[in] grid supplies the old densities, old and new velocities and the cached geometry
+  @param[in] i radial index of the zone inside the face
+  @param[out] dFlux_i plane of \ref Grid::dRadialFacePlanes to hold the fluxes out of zone \p i,
+             indexed by \p j and \p k
+  @param[out] dFlux_ip1 plane of \ref Grid::dRadialFacePlanes to hold the fluxes into zone
+             \p i+1, indexed by \p j and \p k
+  */
 void calNewD_RTP(Grid& grid, Parameters &parameters, Time &time,ProcTop &procTop);/**<
   This function calculates new densities using terms in the radial, theta, and phi directions
   
@@ -370,6 +397,19 @@ void calNewE_RTP_NA(Grid& grid, Parameters &parameters, Time &time, ProcTop &pro
   @param[in] time contains time information, e.g. time step, current time etc.
   @param[in] procTop
   */
+void calRadialEnergyFaces_RTP(Grid &grid, int i, double **dEUpWindGrad, double **dRadDiff
+  , double **dEddyDiff);/**<
+  This function calculates the quantities on the radial face between zones \p i and \p i+1 used
+  by \ref calNewE_RTP_NA_LES for all \p j and \p k it updates. Each is the same for both zones
+  that share the face, so it is only computed once.
+  
+  @param[in] grid supplies the old grid, the new eddy viscosity and the cached geometry
+  @param[in] i radial index of the zone inside the face
+  @param[out] dEUpWindGrad plane of \ref Grid::dRadialFacePlanes to hold the energy gradient
+             across the face, used as the upwind gradient by the zone downwind of it
+  @param[out] dRadDiff plane to hold the radiative diffusion term across the face
+  @param[out] dEddyDiff plane to hold the turbulent diffusion of energy across the face
+  */
 void calNewE_RTP_NA_LES(Grid& grid, Parameters &parameters, Time &time, ProcTop &procTop);/**<
   This function calculates new non-adiabatic energies using terms in the radial, theta, and phi 
   directions and includes radiation diffusion terms. It also includes the terms for including real 
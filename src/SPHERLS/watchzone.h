@@ -10,6 +10,19 @@
 #include <string>
 #include <fstream>
 
+const int nNumWatchZoneColumns=23;/**<
+  Number of double precision values written per time step to a watch zone file, these are columns
+  2 to 24 of the text format.
+  */
+const int nWatchZoneBinHeaderSize=sizeof(char)+6*sizeof(int)+sizeof(double);/**<
+  Size in bytes of the header of a binary watch zone file. The header is a 'w', the version number,
+  the zone indices i, j, k, 1 if gamma-law gas 0 otherwise, gamma, and the number of columns.
+  */
+const int nWatchZoneBinRecordSize=sizeof(int)+nNumWatchZoneColumns*sizeof(double);/**<
+  Size in bytes of one time step in a binary watch zone file, the time step index followed by
+  \ref nNumWatchZoneColumns doubles. Values which are not defined for the zone are NaN.
+  */
+
 class WatchZone{
   public:
   int i;
@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <unistd.h>
 #include "eos.h"
+#include "dumpFile.h"
 #ifdef HDF_ENABLE
   #include "mfhdf.h"
 #endif
@@ -28,9 +29,11 @@ int main(int argc, char *argv[]){
         <<"leat a filename base\n\n";
       throw exception2(ssTemp.str(),SYNTAX);
     }
-    int nFromFileType;
-    int nToFileType;
+    int nFromFileType=0;
+    int nToFileType=0;
     std::string sFileName;
+    std::string sBatchListFile;
+    std::vector<std::string> vecsFileNames;
     int nOperation=-1;
     int nPlane=-1;
     int nPlaneIndex=-1;
@@ -209,6 +212,7 @@ int main(int argc, char *argv[]){
                   throw exception2(ssTemp.str(),SYNTAX);
                 }
               }
+              i++;//skip next argument, already handled
               break;
             }
             case 'd':{//make an HDF file
@@ -259,6 +263,136 @@ int main(int argc, char *argv[]){
                   throw exception2(ssTemp.str(),SYNTAX);
                 }
               }
+              i++;//skip next argument, already handled
+              break;
+            }
+            case 'k':{//make a VTK file
+              
+              nOperation=8;
+              
+              //check that there are enough arguments
+              if(i+1>=argc){//"exe name"+"-k"+"these arguments"
+                std::stringstream ssTemp;
+                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                  <<": too few arguments\n";
+                throw exception2(ssTemp.str(),SYNTAX);
+              }
+              
+              //modifiers following "-k"
+              for(int c=2;argv[i][c]!='\0';c++){
+                switch(argv[i][c]){
+                  case 'z':{//compress the arrays with zlib
+                    #ifndef ZLIB_ENABLE
+                    std::stringstream ssTemp;
+                    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                      <<": zlib support was disabled during configuration, VTK files can not be "
+                      <<"compressed\n\n";
+                    throw exception2(ssTemp.str(),SYNTAX);
+                    #endif
+                    bVTKCompress=true;
+                    break;
+                  }
+                  case 's':{//keep spherical coordinates
+                    bVTKSpherical=true;
+                    break;
+                  }
+                  default:{
+                    std::stringstream ssTemp;
+                    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                      <<": unknown modifier \""<<argv[i][c]<<"\" in flag \""<<argv[i]<<"\"\n\n";
+                    throw exception2(ssTemp.str(),SYNTAX);
+                  }
+                }
+              }
+              
+              //get from file type
+              nFromFileType=0;
+              switch(argv[i+1][0]){
+                case 'd':{//distributed
+                  nFromFileType+=1;
+                  break;
+                }
+                case 'c':{//collected
+                  nFromFileType+=2;
+                  break;
+                }
+                default:{//unknown
+                  std::stringstream ssTemp;
+                  ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                    <<": unknown file type \""<<argv[i+1][0]
+                    <<"\", should be either \"d\" or \"c\".\n";
+                  throw exception2(ssTemp.str(),SYNTAX);
+                }
+              }
+              switch(argv[i+1][1]){
+                case 'b':{//binary
+                  nFromFileType+=4;
+                  break;
+                }
+                case 'a':{//ascii
+                  nFromFileType+=8;
+                  break;
+                }
+                default:{//unknown
+                  std::stringstream ssTemp;
+                  ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                    <<": unknown file type \""<<argv[i+1][1]
+                    <<"\", should be either \"b\" or \"a\".\n";
+                  throw exception2(ssTemp.str(),SYNTAX);
+                }
+              }
+              i++;//skip next argument, already handled
+              break;
+            }
+            case 'g':{//make a light curve of global scalars
+              
+              nOperation=9;
+              
+              //check that there are enough arguments
+              if(i+1>=argc){//"exe name"+"-g"+"these arguments"
+                std::stringstream ssTemp;
+                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                  <<": too few arguments\n";
+                throw exception2(ssTemp.str(),SYNTAX);
+              }
+              
+              //get from file type
+              nFromFileType=0;
+              switch(argv[i+1][0]){
+                case 'd':{//distributed
+                  nFromFileType+=1;
+                  break;
+                }
+                case 'c':{//collected
+                  nFromFileType+=2;
+                  break;
+                }
+                default:{//unknown
+                  std::stringstream ssTemp;
+                  ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                    <<": unknown file type \""<<argv[i+1][0]
+                    <<"\", should be either \"d\" or \"c\".\n";
+                  throw exception2(ssTemp.str(),SYNTAX);
+                }
+              }
+              switch(argv[i+1][1]){
+                case 'b':{//binary
+                  nFromFileType+=4;
+                  break;
+                }
+                case 'a':{//ascii
+                  nFromFileType+=8;
+                  break;
+                }
+                default:{//unknown
+                  std::stringstream ssTemp;
+                  ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                    <<": unknown file type \""<<argv[i+1][1]
+                    <<"\", should be either \"b\" or \"a\".\n";
+                  throw exception2(ssTemp.str(),SYNTAX);
+                }
+              }
+              i++;//skip next argument, already handled
               break;
             }
             case 's':{//make a 2D slice
@@ -325,6 +459,7 @@ int main(int argc, char *argv[]){
                   <<": plane index must be a postive integer\n";
                 throw exception2(ssTemp.str(),SYNTAX);
               }
+              i+=3;//skip next three arguments, already handled
               break;
             }
             case 't':{//calculate fourier transform
@@ -337,9 +472,45 @@ int main(int argc, char *argv[]){
                   <<": too few arguments\n";
                 throw exception2(ssTemp.str(),SYNTAX);
               }
-              if(argv[i][2]=='l'){//not from a watchZone file but from a two column file
-                nOperation=41;
+              
+              //modifiers following "-t"
+              int nNumValuesUsed=0;
+              for(int c=2;argv[i][c]!='\0';c++){
+                switch(argv[i][c]){
+                  case 'l':{//not from a watchZone file but from a two column file
+                    nOperation=41;
+                    break;
+                  }
+                  case 's':{//Lomb-Scargle periodogram on the uneven time steps
+                    bLombScargle=true;
+                    break;
+                  }
+                  case 'w':{//Welch averaged power spectrum, next value is the segment length
+                    std::string sTemp;
+                    if(i+1+nNumValuesUsed<argc){
+                      sTemp=argv[i+1+nNumValuesUsed];
+                    }
+                    if(sTemp.size()==0||sTemp.find_first_not_of("0123456789")<sTemp.size()
+                      ||atoi(sTemp.c_str())<4){
+                      std::stringstream ssTemp;
+                      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                        <<": segment length given, "<<sTemp
+                        <<", is not an integer of at least 4\n\n";
+                      throw exception2(ssTemp.str(),SYNTAX);
+                    }
+                    nSpectrumSegment=atoi(sTemp.c_str());
+                    nNumValuesUsed++;
+                    break;
+                  }
+                  default:{
+                    std::stringstream ssTemp;
+                    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                      <<": unknown modifier \""<<argv[i][c]<<"\" in flag \""<<argv[i]<<"\"\n\n";
+                    throw exception2(ssTemp.str(),SYNTAX);
+                  }
+                }
               }
+              i+=nNumValuesUsed;//skip values already used
               break;
             }
             case 'h':{//display help
@@ -394,12 +565,60 @@ int main(int argc, char *argv[]){
                   throw exception2(ssTemp.str(),SYNTAX);
                 }
               }
+              i++;//skip next argument, already handled
+              break;
+            }
+            case 'w':{//convert a binary watch zone file to text
+              nOperation=7;
               break;
             }
             case 'v':{//add extra information to radial profile
               bExtraInfoInProfile=true;
               break;
             }
+            case 'b':{//read file names from a batch list file
+              if(i+1>=argc){
+                std::stringstream ssTemp;
+                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                  <<": no batch list file given after "<<argv[i]<<"\n";
+                throw exception2(ssTemp.str(),SYNTAX);
+              }
+              sBatchListFile=argv[i+1];
+              i++;//skip next value since already used
+              break;
+            }
+            case 'm':{//set memory budget
+              std::string sTemp;
+              if(i+1<argc){
+                sTemp=argv[i+1];
+              }
+              if(sTemp.size()==0||sTemp.find_first_not_of("0123456789")<sTemp.size()){
+                std::stringstream ssTemp;
+                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                  <<": memory budget given, "<<sTemp
+                  <<", is not an unsigned integer\n\n";
+                throw exception2(ssTemp.str(),SYNTAX);
+              }
+              nMemoryBudgetMB=atoi(argv[i+1]);
+              i++;//skip next value since already used
+              break;
+            }
+            case 'j':{//set number of threads
+              std::string sTemp;
+              if(i+1<argc){
+                sTemp=argv[i+1];
+              }
+              if(sTemp.size()==0||sTemp.find_first_not_of("0123456789")<sTemp.size()){
+                std::stringstream ssTemp;
+                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                  <<": number of threads given, "<<sTemp
+                  <<", is not an unsigned integer\n\n";
+                throw exception2(ssTemp.str(),SYNTAX);
+              }
+              nNumThreads=atoi(argv[i+1]);
+              i++;//skip next value since already used
+              break;
+            }
             case 'e':{
               
               //get equation of state file
@@ -425,376 +644,492 @@ int main(int argc, char *argv[]){
             throw exception2(ssTemp.str(),SYNTAX);
           }
           sFileName=argv[i];
+          vecsFileNames.push_back(sFileName);
         }
       }
     }
     
+    //expand any wildcards, and add the files in the batch list
+    vecsFileNames=expandFileNames(vecsFileNames,sBatchListFile,nFromFileType==5||nFromFileType==9);
+    
     //check to make sure a base file name was specified
-    if(sFileName.size()==0){//no file name set
+    if(vecsFileNames.size()==0){//no file name set
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
         <<": no file name specified.\n";
       throw exception2(ssTemp.str(),SYNTAX);
     }
+    #ifndef HDF_ENABLE
+    if(nOperation==6){
+      std::cout<<"hdf support was disabled during configuration. To enable reconfigure, build "
+        <<"and install with an hdf library\n";
+      return 0;
+    }
+    #endif
     
-    switch(nOperation){
-      case 1:{//do a conversion
-        switch(nFromFileType){
-          case 5:{//from db
-            switch(nToFileType){
-              case 5:{//to db
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": nothing to do. Convert from and to"
-                  <<" file types the same.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 9:{//to da
-                convertDistBinToAscii(sFileName);
-                break;
-              }
-              case 6:{//to cb
-                combineBinFiles(sFileName);
-                break;
-              }
-              case 10:{//to ca
-                combineBinFiles(sFileName);
-                convertCollBinToAscii(sFileName);
-                break;
-              }
-              default:{
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": unknown file type to convert to. \n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
+    //set the exe directory, equation of state files may be relative to it
+    setExeDir();
+    
+    //combine all the distributed binary dumps together before processing them
+    if(nFromFileType==5&&(nOperation==2||nOperation==3||nOperation==5||nOperation==6
+      ||nOperation==8||nOperation==9||(nOperation==1&&(nToFileType==6||nToFileType==10)))){
+      combineBinFiles(vecsFileNames);
+    }
+    
+    //process the files, nothing left to do if only combining
+    if(!(nOperation==1&&nFromFileType==5&&nToFileType==6)){
+      batchJob job;
+      job.nOperation=nOperation;
+      job.nFromFileType=nFromFileType;
+      job.nToFileType=nToFileType;
+      job.nPlane=nPlane;
+      job.nPlaneIndex=nPlaneIndex;
+      job.nShellThreads=1;
+      processFiles(job,vecsFileNames);
+    }
+    
+    //list the VTK files of a run in a collection so they can be viewed as a time series
+    if(nOperation==8&&vecsFileNames.size()>1){
+      writeVTKCollection(vecsFileNames);
+    }
+    
+    //write the global scalars of all the files as one time series
+    if(nOperation==9){
+      writeGlobalScalars(vecsFileNames);
+    }
+  }
+  catch(exception2& eTemp){
+    std::cout<<eTemp.getMsg();
+    return -1;
+  }
+  catch(...){
+    std::cout<<"main: unknown error\n";
+    return -1;
+  }
+  return 0;
+}
+void processFile(batchJob &job,std::string sFileName){
+  int nOperation=job.nOperation;
+  int nFromFileType=job.nFromFileType;
+  int nToFileType=job.nToFileType;
+  int nPlane=job.nPlane;
+  int nPlaneIndex=job.nPlaneIndex;
+  switch(nOperation){
+    case 1:{//do a conversion
+      switch(nFromFileType){
+        case 5:{//from db
+          switch(nToFileType){
+            case 5:{//to db
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": nothing to do. Convert from and to"
+                <<" file types the same.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
             }
-            break;
-          }
-          case 9:{//from da
-            switch(nToFileType){
-              case 5:{//to db
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": conversion from file type \"da\" to file type \"db\" not"
-                  <<" yet supported.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 9:{//to da
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": nothing to do. Convert from and to file types the same."
-                  <<std::endl;
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 6:{//to cb
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": conversion from file type \"da\" to file type \"cb\" not"
-                  <<" yet supported.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 10:{//to ca
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": conversion from file type \"da\" to file type \"ca\" not"
-                  <<" yet supported.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              default:{
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": unknown file type to convert to. \n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
+            case 9:{//to da
+              convertDistBinToAscii(sFileName);
+              break;
             }
-            break;
-          }
-          case 6:{//from cb
-            switch(nToFileType){
-              case 5:{//to db
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": conversion from file type \"cb\" to file type \"db\" not"
-                  <<" yet supported.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 9:{//to da
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": conversion from file type \"cb\" to file type \"da\" not"
-                  <<" yet supported.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 6:{//to cb
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": nothing to do. Convert from and to file types the same."
-                  <<"\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 10:{//to ca
-                convertCollBinToAscii(sFileName);
-                break;
-              }
-              default:{
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": unknown file type to convert to. \n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
+            case 6:{//to cb, already combined by main
+              break;
             }
-            break;
-          }
-          case 10:{//from ca
-            switch(nToFileType){
-              case 5:{//to db
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": conversion from file type \"ca\" to file type \"db\" not"
-                  <<" yet supported.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 9:{//to da
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": conversion from file type \"ca\" to file type \"da\" not"
-                  <<" yet supported.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              case 6:{//to cb
-                convertCollAsciiToBin(sFileName);
-                break;
-              }
-              case 10:{//to ca
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": nothing"
-                  <<" to do. Convert from and to file types the same.\n";
-                throw exception2(ssTemp.str(),SYNTAX);
-                break;
-              }
-              default:{
-                std::stringstream ssTemp;
-                ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-                  <<": unknown file type to convert to. \n";
-                throw exception2(ssTemp.str(),SYNTAX);
-              }
+            case 10:{//to ca, already combined by main
+              convertCollBinToAscii(sFileName);
+              break;
+            }
+            default:{
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": unknown file type to convert to. \n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
             }
-            break;
-          }
-          default:{
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": unknown file type to convert from. \n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
           }
+          break;
         }
-        break;
-      }
-      case 2:{//make a horizontally averaged profile of quantities
-        switch(nFromFileType){
-          case 5:{//from db
-          
-            //convert to a collected ascii file
-            combineBinFiles(sFileName);
-            makeRadialProFromColBin(sFileName);
-            break;
-          }
-          case 9:{//from da
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": averaged profile from file type \"da\" not yet supported\n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
-          }
-          case 6:{//from cb
-            makeRadialProFromColBin(sFileName);
-            break;
-          }
-          case 10:{//from ca
-            convertCollAsciiToBin(sFileName);
-            makeRadialProFromColBin(sFileName);
-            break;
-          }
-          default:{
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": unknown file type to convert from. \n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
+        case 9:{//from da
+          switch(nToFileType){
+            case 5:{//to db
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": conversion from file type \"da\" to file type \"db\" not"
+                <<" yet supported.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 9:{//to da
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": nothing to do. Convert from and to file types the same."
+                <<std::endl;
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 6:{//to cb
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": conversion from file type \"da\" to file type \"cb\" not"
+                <<" yet supported.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 10:{//to ca
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": conversion from file type \"da\" to file type \"ca\" not"
+                <<" yet supported.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            default:{
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": unknown file type to convert to. \n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
           }
+          break;
         }
-        break;
-      }
-      case 3:{//make a 2D slice
-        switch(nFromFileType){
-          case 5:{//from db
-          
-            //convert to a collected ascii file
-            combineBinFiles(sFileName);
-            make2DSlice(sFileName,nPlane,nPlaneIndex);
-            break;
-          }
-          case 9:{//from da
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": averaged profile from file type \"da\" not yet supported\n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
-          }
-          case 6:{//from cb
-            make2DSlice(sFileName,nPlane,nPlaneIndex);
-            break;
-          }
-          case 10:{//from ca
-            convertCollAsciiToBin(sFileName);
-            make2DSlice(sFileName,nPlane,nPlaneIndex);
-            break;
+        case 6:{//from cb
+          switch(nToFileType){
+            case 5:{//to db
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": conversion from file type \"cb\" to file type \"db\" not"
+                <<" yet supported.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 9:{//to da
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": conversion from file type \"cb\" to file type \"da\" not"
+                <<" yet supported.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 6:{//to cb
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": nothing to do. Convert from and to file types the same."
+                <<"\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 10:{//to ca
+              convertCollBinToAscii(sFileName);
+              break;
+            }
+            default:{
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": unknown file type to convert to. \n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
           }
-          default:{
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": unknown file type to convert from. \n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
+          break;
+        }
+        case 10:{//from ca
+          switch(nToFileType){
+            case 5:{//to db
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": conversion from file type \"ca\" to file type \"db\" not"
+                <<" yet supported.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 9:{//to da
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": conversion from file type \"ca\" to file type \"da\" not"
+                <<" yet supported.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            case 6:{//to cb
+              convertCollAsciiToBin(sFileName);
+              break;
+            }
+            case 10:{//to ca
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": nothing"
+                <<" to do. Convert from and to file types the same.\n";
+              throw exception2(ssTemp.str(),SYNTAX);
+              break;
+            }
+            default:{
+              std::stringstream ssTemp;
+              ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+                <<": unknown file type to convert to. \n";
+              throw exception2(ssTemp.str(),SYNTAX);
+            }
           }
+          break;
         }
-        break;
-      }
-      case 4:{//compute fourier transform
-        #ifdef FFTW_ENABLE
-          std::stringstream ssOutFileName;
-          ssOutFileName<<sFileName.substr(0,sFileName.length()-4)<<"-FT.txt";
-          computeFourierTrans(sFileName,ssOutFileName.str());
-        #else
+        default:{
           std::stringstream ssTemp;
           ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": FFTW was disable during configuration, this option is not available "<<nOperation<<"\n";
+            <<": unknown file type to convert from. \n";
           throw exception2(ssTemp.str(),SYNTAX);
-        #endif
-        break;
+          break;
+        }
       }
-      case 5:{//convert to LNA format
-        switch(nFromFileType){
-          case 5:{//from db
-          
-            //convert to a collected ascii file
-            combineBinFiles(sFileName);
-            convertBinToLNA(sFileName);
-            break;
-          }
-          case 9:{//from da
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": lna file from file type \"da\" not yet supported\n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
-          }
-          case 6:{//from cb
-            convertBinToLNA(sFileName);
-            break;
-          }
-          case 10:{//from ca
-            convertCollAsciiToBin(sFileName);
-            convertBinToLNA(sFileName);
-            break;
-          }
-          default:{
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": unknown file type to convert from. \n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
-          }
+      break;
+    }
+    case 2:{//make a horizontally averaged profile of quantities
+      switch(nFromFileType){
+        case 5:{//from db
+        
+          //already combined into a collected binary file by main
+          makeRadialProFromColBin(sFileName,job.nShellThreads);
+          break;
+        }
+        case 9:{//from da
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": averaged profile from file type \"da\" not yet supported\n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
+        case 6:{//from cb
+          makeRadialProFromColBin(sFileName,job.nShellThreads);
+          break;
+        }
+        case 10:{//from ca
+          convertCollAsciiToBin(sFileName);
+          makeRadialProFromColBin(sFileName,job.nShellThreads);
+          break;
+        }
+        default:{
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": unknown file type to convert from. \n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
         }
-        break;
       }
-      case 41:{//compute a fourier transform
-        #ifdef FFTW_ENABLE
-          std::stringstream ssOutFileName;
-          ssOutFileName<<sFileName.substr(0,sFileName.length()-4)<<"-FT.txt";
-          computeFourierTransFromList(sFileName,ssOutFileName.str());
-        #else
+      break;
+    }
+    case 3:{//make a 2D slice
+      switch(nFromFileType){
+        case 5:{//from db
+        
+          //already combined into a collected binary file by main
+          make2DSlice(sFileName,nPlane,nPlaneIndex);
+          break;
+        }
+        case 9:{//from da
           std::stringstream ssTemp;
           ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": FFTW was disable during configuration, this option is not available "<<nOperation<<"\n";
+            <<": averaged profile from file type \"da\" not yet supported\n";
           throw exception2(ssTemp.str(),SYNTAX);
-        #endif
-        break;
+          break;
+        }
+        case 6:{//from cb
+          make2DSlice(sFileName,nPlane,nPlaneIndex);
+          break;
+        }
+        case 10:{//from ca
+          convertCollAsciiToBin(sFileName);
+          make2DSlice(sFileName,nPlane,nPlaneIndex);
+          break;
+        }
+        default:{
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": unknown file type to convert from. \n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
       }
-      case 6:{//make an HDF file
-        #ifdef HDF_ENABLE
-        switch(nFromFileType){
-          case 5:{//from db
-          
-            //convert to a collected ascii file
-            combineBinFiles(sFileName);
-            convertBinToHDF4(sFileName);
-            break;
-          }
-          case 9:{//from da
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": creating an HDF file from file type \"da\" not yet supported\n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
-          }
-          case 6:{//from cb
-            convertBinToHDF4(sFileName);
-            break;
-          }
-          case 10:{//from ca
-            convertCollAsciiToBin(sFileName);
-            convertBinToHDF4(sFileName);
-            break;
-          }
-          default:{
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": unknown file type to convert from. \n";
-            throw exception2(ssTemp.str(),SYNTAX);
-            break;
-          }
+      break;
+    }
+    case 4:{//compute fourier transform
+      #ifdef FFTW_ENABLE
+        std::stringstream ssOutFileName;
+        ssOutFileName<<sFileName.substr(0,sFileName.length()-4)
+          <<(bLombScargle?"-LS.txt":(nSpectrumSegment>0?"-PSD.txt":"-FT.txt"));
+        computeFourierTrans(sFileName,ssOutFileName.str(),true,job.nShellThreads);
+      #else
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": FFTW was disable during configuration, this option is not available "<<nOperation<<"\n";
+        throw exception2(ssTemp.str(),SYNTAX);
+      #endif
+      break;
+    }
+    case 5:{//convert to LNA format
+      switch(nFromFileType){
+        case 5:{//from db
+        
+          //already combined into a collected binary file by main
+          convertBinToLNA(sFileName);
+          break;
+        }
+        case 9:{//from da
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": lna file from file type \"da\" not yet supported\n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
+        case 6:{//from cb
+          convertBinToLNA(sFileName);
+          break;
+        }
+        case 10:{//from ca
+          convertCollAsciiToBin(sFileName);
+          convertBinToLNA(sFileName);
+          break;
+        }
+        default:{
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": unknown file type to convert from. \n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
         }
-        break;
-        #else
-        std::cout<<"hdf support was disabled during configuration. To enable reconfigure, build "
-          <<"and install with an hdf library\n";
-        return 0;
-        #endif
       }
-      default:{
+      break;
+    }
+    case 41:{//compute a fourier transform
+      #ifdef FFTW_ENABLE
+        std::stringstream ssOutFileName;
+        ssOutFileName<<sFileName.substr(0,sFileName.length()-4)
+          <<(bLombScargle?"-LS.txt":(nSpectrumSegment>0?"-PSD.txt":"-FT.txt"));
+        computeFourierTrans(sFileName,ssOutFileName.str(),false,job.nShellThreads);
+      #else
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": no operation specified, or an unsuported operation has been"
-          <<" requested. The current operation code is "<<nOperation<<"\n";
+          <<": FFTW was disable during configuration, this option is not available "<<nOperation<<"\n";
         throw exception2(ssTemp.str(),SYNTAX);
+      #endif
+      break;
+    }
+    case 7:{//convert a binary watch zone file to text
+      convertWatchZoneBinToAscii(sFileName);
+      break;
+    }
+    case 6:{//make an HDF file
+      #ifdef HDF_ENABLE
+      switch(nFromFileType){
+        case 5:{//from db
+        
+          //already combined into a collected binary file by main
+          convertBinToHDF4(sFileName);
+          break;
+        }
+        case 9:{//from da
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": creating an HDF file from file type \"da\" not yet supported\n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
+        case 6:{//from cb
+          convertBinToHDF4(sFileName);
+          break;
+        }
+        case 10:{//from ca
+          convertCollAsciiToBin(sFileName);
+          convertBinToHDF4(sFileName);
+          break;
+        }
+        default:{
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": unknown file type to convert from. \n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
+      }
+      break;
+      #else
+      std::cout<<"hdf support was disabled during configuration. To enable reconfigure, build "
+        <<"and install with an hdf library\n";
+      break;
+      #endif
+    }
+    case 8:{//make a VTK file
+      switch(nFromFileType){
+        case 5:{//from db
+        
+          //already combined into a collected binary file by main
+          convertBinToVTK(sFileName);
+          break;
+        }
+        case 9:{//from da
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": creating a VTK file from file type \"da\" not yet supported\n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
+        case 6:{//from cb
+          convertBinToVTK(sFileName);
+          break;
+        }
+        case 10:{//from ca
+          convertCollAsciiToBin(sFileName);
+          convertBinToVTK(sFileName);
+          break;
+        }
+        default:{
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": unknown file type to convert from. \n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
       }
+      break;
+    }
+    case 9:{//make a light curve of global scalars
+      switch(nFromFileType){
+        case 5:{//from db
+        
+          //already combined into a collected binary file by main
+          makeGlobalScalars(sFileName,job.nShellThreads);
+          break;
+        }
+        case 9:{//from da
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": global scalars from file type \"da\" not yet supported\n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
+        case 6:{//from cb
+          makeGlobalScalars(sFileName,job.nShellThreads);
+          break;
+        }
+        case 10:{//from ca
+          convertCollAsciiToBin(sFileName);
+          makeGlobalScalars(sFileName,job.nShellThreads);
+          break;
+        }
+        default:{
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": unknown file type to convert from. \n";
+          throw exception2(ssTemp.str(),SYNTAX);
+          break;
+        }
+      }
+      break;
+    }
+    default:{
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": no operation specified, or an unsuported operation has been"
+        <<" requested. The current operation code is "<<nOperation<<"\n";
+      throw exception2(ssTemp.str(),SYNTAX);
     }
   }
-  catch(exception2& eTemp){
-    std::cout<<eTemp.getMsg();
-    return -1;
-  }
-  catch(...){
-    std::cout<<"main: unknown error\n";
-    return -1;
-  }
-  return 0;
 }
 void printHelp(){
   /**\todo need to updated, and revise help text to better describe the program. Some imporovements
@@ -811,7 +1146,8 @@ void printHelp(){
     <<"[parameter]     characters following a flag\n"
     <<"[filename base] base file name to convert, -x will be appended to\n"
     <<"                the [basefile name] for all files which match in pwd\n"
-    <<"                ,where x is an integer\n"
+    <<"                ,where x is an integer\n"    <<"                more than one file, or a quoted wildcard pattern, may be given\n"
+    <<"                and the files are processed in parallel\n"
     <<std::endl
     <<"[flag] [parameter] [discription]\n"
     <<" -c [convert from][convert to] where [convert from] or\n"
@@ -820,6 +1156,16 @@ void printHelp(){
     <<"    da distributed ascii\n"
     <<"    ca collected ascii\n"
     <<"    cb collected binary\n"
+    <<"    when converting from db more than one [filename base] may be given, the\n"
+    <<"    dumps are combined together using multiple threads\n"
+    <<" -j [threads] number of threads used to combine distributed binary files, to\n"
+    <<"       process files, and to compute the radial shells of profiles, default is\n"
+    <<"       the number of processors\n"
+    <<" -m [megabytes] memory the files processed at the same time may use, default\n"
+    <<"       is half of the physical memory\n"
+    <<" -b [list file] processes the files listed in [list file], one per line, in\n"
+    <<"       addition to any given on the command line, lines starting with # are\n"
+    <<"       ignored\n"
     <<" -p    sets persicion of ASCII output, default is 15 decimal places\n"
     <<" -f s  sets output formating to scientific\n"
     <<"    f  sets output formating to fixed\n"
@@ -827,6 +1173,17 @@ void printHelp(){
     <<" -h    displays this message\n"
     <<" -d [input file type]   make an HDF file from [input file type]\n"
     <<" -a [input file type]   make a radial profile from [input file type]\n"
+    <<" -k [input file type]   make a VTK structured grid file, .vts, from [input file\n"
+    <<"       type] with binary appended data. When more than one file is given a\n"
+    <<"       collection, .pvd, listing them in order of time is also made.\n"
+    <<" -kz   compresses the data of the VTK files with zlib\n"
+    <<" -ks   uses r, theta and phi as coordinates and velocity components instead of\n"
+    <<"       x, y and z, the z and s modifiers can be combined, e.g. -kzs\n"
+    <<" -g [input file type]   make a light curve, one line per file in order of\n"
+    <<"       time with the surface luminosity, effective temperature, mass, radius,\n"
+    <<"       velocity, gravity and acceleration, the total pulsation and kinetic\n"
+    <<"       energies, and the largest convective flux, u-u_0 and T-<T>. It is named\n"
+    <<"       after the first file without its time step index with _lc.txt appended\n"
     <<" -v adds extra information to the radial profile about equation of state derivatives.\n"
     <<" -s [input file type] [plane] [planeIndex]   make a 2D slice where\n"
     <<"       [input file type] is a two character combination of c/d or b/a for\n"
@@ -836,11 +1193,24 @@ void printHelp(){
     <<"       direction perpendicular to the plane.\n"
     <<" -t [input file] calculates the fourier transform on [input file] of the \n"
     <<"       radial velocity at i+1/2.\n"
-    <<"       [input file] is expected to be a watchZone file. Output is sent to \n"
+    <<"       [input file] is expected to be a text or binary watchZone file. Output\n"
+    <<"       is sent to \n"
     <<"       to an output file called [input file without exetension]-FT.txt\n"
     <<" -tl [input file] calculates the fourier transform on [input file]. The \n"
     <<"       expected format is two columns, the first being time, the second being\n"
     <<"       the periodic quantity. the output file will then have a -FT appened to the file name.\n"
+    <<" -tw [segment] [input file] instead of one transform of the whole series,\n"
+    <<"       averages the power spectra of Hann windowed segments of [segment]\n"
+    <<"       evenly spaced points, overlapping by half (Welch's method). Only one\n"
+    <<"       segment is kept in memory. Output has frequency and power spectral\n"
+    <<"       density columns and -PSD appended to the file name.\n"
+    <<" -ts [input file] computes a Lomb-Scargle periodogram directly on the uneven\n"
+    <<"       time steps, using the threads set with -j. Output has frequency, power\n"
+    <<"       and amplitude columns and -LS appended to the file name.\n"
+    <<"       the l, w and s modifiers can be combined, e.g. -tlw 4096. FFT plans are\n"
+    <<"       cached in ~/.SPHERLSanal_fftw_wisdom\n"
+    <<" -w [input file] converts a binary watchZone file to the text format. The\n"
+    <<"       output file has the same name with the extension changed to .txt\n"
     <<" -l [input file type] [input file] converts a model into the formate used\n"
     <<"       by LNA.\n"
     <<" -e [eos file] path to equation of state file to use, overrides that \n"
@@ -855,53 +1225,25 @@ void convertCollBinToAscii(std::string sFileName){//tested
       <<":no input file specified\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  std::ifstream ifFile;
-  ifFile.open(sFileName.c_str(),std::ios::binary);
-  if(!ifFile.good()){
+  dumpFile dump;
+  dump.open(sFileName,nDumpFileVersion);
+  
+  //open output file
+  std::string sFileNameOut=sFileName+".txt";
+  std::ofstream ofFile;
+  ofFile.open(sFileNameOut.c_str());
+  if(!ofFile.good()){
     std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" didn't open properly\n";
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
+      <<sFileNameOut<<" didn't open properly\n";
     throw exception2(ssTemp.str(),INPUT);
   }
   
-  //check that it is a binary file
-  char cTemp;
-  ifFile.read((char*)(&cTemp),sizeof(char));
-  if(cTemp!='b'){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" isn't a binary file.\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //check that it is the correct version
-  int nTemp;
-  ifFile.read((char*)(&nTemp),sizeof(int));
-  if(nTemp!=nDumpFileVersion){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": inpput file \""
-      <<sFileName<<"\" version \""<<nTemp
-      <<"\" isn't the supported version \""<<nDumpFileVersion<<"\".\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //open output file
-  std::string sFileNameOut=sFileName+".txt";
-  std::ofstream ofFile;
-  ofFile.open(sFileNameOut.c_str());
-  if(!ofFile.good()){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
-      <<sFileNameOut<<" didn't open properly\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //read in binary input file and write out in ascii
   //write out that the file is an ascii file
   ofFile<<'a'<<" ";
   
   //write out version
-  ofFile<<nTemp<<std::endl;
+  ofFile<<dump.nVersion<<std::endl;
   
   //set double output precision
   ofFile.precision(nPrecisionAscii);
@@ -914,185 +1256,61 @@ void convertCollBinToAscii(std::string sFileName){//tested
     ofFile.setf(std::ios::fixed);
   }
   
-  //read in time
-  double dTime;
-  ifFile.read((char*)(&dTime),sizeof(double));
-  ofFile<<dTime<<" ";
-  
-  //read in time step index
-  int nTimeStepIndex;
-  ifFile.read((char*)(&nTimeStepIndex),sizeof(int));
-  ofFile<<nTimeStepIndex<<std::endl;
-  
-  //read in last timestep1
-  double dTimeStep1;
-  ifFile.read((char*)(&dTimeStep1),sizeof(double));
-  ofFile<<dTimeStep1<<std::endl;
-  
-  //read in last timestep2
-  double dTimeStep2;
-  ifFile.read((char*)(&dTimeStep2),sizeof(double));
-  ofFile<<dTimeStep2<<std::endl;
-  
-  //read in alpha
-  double dAlpha;
-  ifFile.read((char*)(&dAlpha),sizeof(double));
-  ofFile<<dAlpha<<std::endl;
-  
-  //read in equation of state info
-  int nGammaLaw;
-  ifFile.read((char*)(&nGammaLaw),sizeof(int));
-  ofFile<<nGammaLaw<<" ";
-  if(nGammaLaw==0){
-    double dGamma;
-    ifFile.read((char*)(&dGamma),sizeof(double));
-    
-    ofFile<<dGamma<<std::endl;
+  //write out header
+  ofFile<<dump.dTime<<" ";
+  ofFile<<dump.nTimeStepIndex<<std::endl;
+  ofFile<<dump.dDeltat_nm1half<<std::endl;
+  ofFile<<dump.dDeltat_np1half<<std::endl;
+  ofFile<<dump.dAlpha<<std::endl;
+  if(dump.bGammaLaw){
+    ofFile<<0<<" "<<dump.dGamma<<std::endl;
   }
   else{
-    char *cBuffer=new char[nGammaLaw+1];
-    ifFile.read(cBuffer,nGammaLaw*sizeof(char));
-    cBuffer[nGammaLaw]='\0';
-    std::string sEOSTable;
-    sEOSTable=cBuffer;
-    ofFile<<sEOSTable<<std::endl;
-    delete [] cBuffer;
-  }
-  
-  //read in/write out artificial viscosity
-  double dAV;
-  ifFile.read((char*)(&dAV),sizeof(double));
-  ofFile<<dAV<<std::endl;
-  
-  //read in/write out artificial viscosity threshold
-  double dAVThreshold;
-  ifFile.read((char*)(&dAVThreshold),sizeof(double));
-  ofFile<<dAVThreshold<<std::endl;
-  
-  //read in global grid size
-  int nSizeGlobe[3];
-  ifFile.read((char*)(nSizeGlobe),3*sizeof(int));
-  ofFile<<nSizeGlobe[0]<<" ";
-  ofFile<<nSizeGlobe[1]<<" ";
-  ofFile<<nSizeGlobe[2]<<std::endl;
-  
-  //read in periodicity
-  int nPeriodic[3];
-  ifFile.read((char*)(nPeriodic),3*sizeof(int));
-  ofFile<<nPeriodic[0]<<" ";
-  ofFile<<nPeriodic[1]<<" ";
-  ofFile<<nPeriodic[2]<<std::endl;
-  
-  //read in number of 1D Zones
-  int nNum1DZones;
-  ifFile.read((char*)(&nNum1DZones),sizeof(int));
-  ofFile<<nNum1DZones<<std::endl;
-  
-  //read in number of ghostcells
-  int nNumGhostCells;
-  ifFile.read((char*)(&nNumGhostCells),sizeof(int));
-  ofFile<<nNumGhostCells<<std::endl;
-  
-  //read in number of grid variables
-  int nNumVars;
-  ifFile.read((char*)(&nNumVars),sizeof(int));
-  ofFile<<nNumVars<<std::endl;
-  
-  //get variable info, and set grid sizes
-  int **nSize=new int*[nNumVars];
-  int **nVarInfo=new int*[nNumVars];
-  for(int n=0;n<nNumVars;n++){
-    nSize[n]=new int[3];
-    nVarInfo[n]=new int[4];
-    ifFile.read((char*)(nVarInfo[n]),(4)*sizeof(int));
-    for(int l=0;l<3;l++){
-      ofFile<<nVarInfo[n][l]<<" ";
-      if(nVarInfo[n][l]==-1){//variable not defined in direction l
-        nSize[n][l]=1;
-      }
-      else if(nVarInfo[n][l]==1&&nPeriodic[l]==0){//interface variable
-        nSize[n][l]=nSizeGlobe[l]+1;
-      }
-      else{
-        nSize[n][l]=nSizeGlobe[l];
-      }
+    ofFile<<dump.sEOSFileName.size()<<" "<<dump.sEOSFileName<<std::endl;
+  }
+  ofFile<<dump.dA<<std::endl;
+  ofFile<<dump.dAVThreshold<<std::endl;
+  ofFile<<dump.nGlobalGridDims[0]<<" ";
+  ofFile<<dump.nGlobalGridDims[1]<<" ";
+  ofFile<<dump.nGlobalGridDims[2]<<std::endl;
+  ofFile<<dump.nPeriodic[0]<<" ";
+  ofFile<<dump.nPeriodic[1]<<" ";
+  ofFile<<dump.nPeriodic[2]<<std::endl;
+  ofFile<<dump.nNum1DZones<<std::endl;
+  ofFile<<dump.nNumGhostCells<<std::endl;
+  ofFile<<dump.nNumVars<<std::endl;
+  for(int n=0;n<dump.nNumVars;n++){
+    for(int l=0;l<4;l++){
+      ofFile<<dump.nVariableInfo[4*n+l]<<" ";
     }
-    ofFile<<nVarInfo[n][3]<<" ";
     ofFile<<" ";
   }
   ofFile<<std::endl;
   
   //write out the grid
-  for(int n=0;n<nNumVars;n++){
-    int nGhostCellsX=1;
-    if(nVarInfo[n][0]==-1){
-      nGhostCellsX=0;
-    }
-    int nGhostCellsY=1;
-    if(nVarInfo[n][1]==-1){
-      nGhostCellsY=0;
-    }
-    int nGhostCellsZ=1;
-    if(nVarInfo[n][2]==-1){
-      nGhostCellsZ=0;
-    }
+  double ****dGrid=dump.getGrid();
+  for(int n=0;n<dump.nNumVars;n++){
+    
     //write out 1D part of the grid
-    int nSizeX=nGhostCellsX*(nNum1DZones+nNumGhostCells);/*may be need to +1 if only one proc 
-      and variable in interface centered*/
-    if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
-      nSizeX=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
-    }
-    int nSizeY=1;
-    int nSizeZ=1;
-    for(int i=0;i<nSizeX;i++){
-      for(int j=0;j<nSizeY;j++){
-        double *dRow=new double[nSizeZ];
-        ifFile.read((char*)(dRow),nSizeZ*sizeof(double));
-        for(int k=0;k<nSizeZ;k++){
-          ofFile<<dRow[k]<<" ";
-        }
-        ofFile<<std::endl;//new line for each new Y
-        delete [] dRow;
-      }
+    for(int i=0;i<dump.nSizeX1[n];i++){
+      ofFile<<dGrid[n][i][0][0]<<" ";
+      ofFile<<std::endl;//new line for each new Y
       ofFile<<std::endl;//skip a line for each new X
     }
     
     //write out the rest of the grid
-    nSizeX=nSize[n][0]+nGhostCellsX*(nNumGhostCells-nNum1DZones);
-    if(nVarInfo[n][0]==1&&nPeriodic[0]==0){
-      nSizeX=nSize[n][0]+nGhostCellsX*(nNumGhostCells-(nNum1DZones+1));
-    }
-    nSizeY=nSize[n][1]+nGhostCellsY*2*nNumGhostCells;
-    nSizeZ=nSize[n][2]+nGhostCellsZ*2*nNumGhostCells;
-    double *dTempArray=new double[nSizeZ];
-    for(int i=0;i<nSizeX;i++){
-      for(int j=0;j<nSizeY;j++){
-        if(ifFile.eof()){
-          std::stringstream ssTemp;
-          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": reached end of file sooner than expected\n";
-          throw exception2(ssTemp.str(),INPUT);
-        }
-        ifFile.read((char*)(dTempArray),(nSizeZ)*sizeof(double));
-        for(int k=0;k<nSizeZ;k++){
-          ofFile<<dTempArray[k]<<" ";
+    for(int i=dump.nSizeX1[n];i<dump.nSizeX2[n];i++){
+      for(int j=0;j<dump.nSizeY[n];j++){
+        for(int k=0;k<dump.nSizeZ[n];k++){
+          ofFile<<dGrid[n][i][j][k]<<" ";
         }
         ofFile<<std::endl;//new line for each new Y
       }
       ofFile<<std::endl;//skip a line for each new X
     }
     ofFile<<std::endl;//skip two lines for each new variable
-    delete [] dTempArray;
-    
   }
-  ifFile.close();
   ofFile.close();
-  for(int n=0;n<nNumVars;n++){
-    delete [] nSize[n];
-    delete [] nVarInfo[n];
-  }
-  delete [] nSize;
-  delete [] nVarInfo;
 }
 void convertDistBinToAscii(std::string sFileNameBase){//tested
   
@@ -1253,7 +1471,7 @@ void convertDistBinToAscii(std::string sFileNameBase){//tested
   //read in variable info
   int **nVariables=new int*[nNumVars];
   for(int i=0;i<nNumVars;i++){
-    nVariables[i]=new int[3];
+    nVariables[i]=new int[4];
     ifFile.read((char*)(nVariables[i]),4*sizeof(int));
     ofFile<<nVariables[i][0]<<" ";
     ofFile<<nVariables[i][1]<<" ";
@@ -1598,7 +1816,7 @@ void convertDistBinToAscii(std::string sFileNameBase){//tested
     //read in variable info 
     int **nVariables=new int*[nNumVars];
     for(int i=0;i<nNumVars;i++){
-      nVariables[i]=new int[3];
+      nVariables[i]=new int[4];
       ifFile.read((char*)(nVariables[i]),4*sizeof(int));
       ofFile<<nVariables[i][0]<<" ";
       ofFile<<nVariables[i][1]<<" ";
@@ -1682,52 +1900,43 @@ void convertDistBinToAscii(std::string sFileNameBase){//tested
     delete [] nSize;
   }
 }
-void combineBinFiles(std::string sFileNameBase){//tested
+void readDistributedHeaders(std::string sFileNameBase,distributedDump &dump){
   
   //find  out how many files that start with filename are present
   std::ostringstream ossFileName;
-  int nNumFiles=0;
-  ossFileName<<sFileNameBase<<"-"<<nNumFiles;
+  dump.sFileNameBase=sFileNameBase;
+  dump.nNumFiles=0;
+  ossFileName<<sFileNameBase<<"-"<<dump.nNumFiles;
   while(bFileExists(ossFileName.str())){
-    nNumFiles++;
+    dump.nNumFiles++;
     ossFileName.str("");//flush stream
-    ossFileName<<sFileNameBase<<"-"<<nNumFiles;
+    ossFileName<<sFileNameBase<<"-"<<dump.nNumFiles;
   }
-  if(nNumFiles==0){
+  if(dump.nNumFiles==0){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-      <<": no files to combine found\n";
+      <<": no files to combine found for \""<<sFileNameBase<<"\"\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  int ***nFileGridSizes=new int**[nNumFiles];
-  int **nFileProcCoords=new int*[nNumFiles];
-  std::ifstream *ifIn=new std::ifstream[nNumFiles];
-  int nGlobalGridDims[3]={0,0,0};
-  int nGlobalProcDims[3]={0,0,0};
-  int ***nVariableInfo=new int**[nNumFiles];
-  int nNumGhostCells;
-  int nNumVars;
-  int nNum1DZones;
-  int nPeriodic[3];
-  double dTime;
-  int nTimeStepIndex;
-  double dTimeStep1;
-  double dTimeStep2;
-  double dAlpha;
-  int nGammaLaw;
-  double dGamma;
-  std::string sEOSFileName;
-  double dA;
-  double dAVThreshold;
+  dump.nFileGridSizes=new int**[dump.nNumFiles];
+  dump.nFileProcCoords=new int*[dump.nNumFiles];
+  dump.nFileDataStart=new off_t[dump.nNumFiles];
+  for(int l=0;l<3;l++){
+    dump.nGlobalGridDims[l]=0;
+    dump.nGlobalProcDims[l]=0;
+  }
+  dump.dGamma=0.0;
+  int **nVariableInfo=NULL;
   
   //read file headers and check that they are compatiable with each other
-  for(int i=0;i<nNumFiles;i++){
+  for(int i=0;i<dump.nNumFiles;i++){
     
     //open file i
+    std::ifstream ifIn;
     ossFileName.str("");//flush stream
     ossFileName<<sFileNameBase<<"-"<<i;
-    ifIn[i].open(ossFileName.str().c_str(),std::ios::binary);
-    if(!ifIn[i].good()){
+    ifIn.open(ossFileName.str().c_str(),std::ios::binary);
+    if(!ifIn.good()){
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
         <<": error opening the file "<<ossFileName.str()<<std::endl;
@@ -1736,7 +1945,7 @@ void combineBinFiles(std::string sFileNameBase){//tested
     
     //check that file is binary
     char cTemp;
-    ifIn[i].read((char*)(&cTemp),sizeof(char));
+    ifIn.read((char*)(&cTemp),sizeof(char));
     if(cTemp!='b'){
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
@@ -1746,7 +1955,7 @@ void combineBinFiles(std::string sFileNameBase){//tested
     
     //check that file is correct version
     int nTemp;
-    ifIn[i].read((char*)(&nTemp),sizeof(int));
+    ifIn.read((char*)(&nTemp),sizeof(int));
     if(nTemp!=1){
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
@@ -1759,221 +1968,222 @@ void combineBinFiles(std::string sFileNameBase){//tested
     if(i==0){
       
       //read in time
-      ifIn[i].read((char*)(&dTime),sizeof(double));
+      ifIn.read((char*)(&dump.dTime),sizeof(double));
       
       //read in time step index
-      ifIn[i].read((char*)(&nTimeStepIndex),sizeof(int));
+      ifIn.read((char*)(&dump.nTimeStepIndex),sizeof(int));
       
       //read in timestep
-      ifIn[i].read((char*)(&dTimeStep1),sizeof(double));
+      ifIn.read((char*)(&dump.dTimeStep1),sizeof(double));
       
       //read in timestep
-      ifIn[i].read((char*)(&dTimeStep2),sizeof(double));
+      ifIn.read((char*)(&dump.dTimeStep2),sizeof(double));
       
       //read in alpha
-      ifIn[i].read((char*)(&dAlpha),sizeof(double));
+      ifIn.read((char*)(&dump.dAlpha),sizeof(double));
       
       //read in nGammaLaw
-      ifIn[i].read((char*)(&nGammaLaw),sizeof(int));
+      ifIn.read((char*)(&dump.nGammaLaw),sizeof(int));
       
-      if(nGammaLaw==0){
-        ifIn[i].read((char*)(&dGamma),sizeof(double));
+      if(dump.nGammaLaw==0){
+        ifIn.read((char*)(&dump.dGamma),sizeof(double));
       }
       else{
-        char* cBuffer=new char[nGammaLaw+1];
-        ifIn[i].read(cBuffer,nGammaLaw*sizeof(char));
-        cBuffer[nGammaLaw]='\0';
+        char* cBuffer=new char[dump.nGammaLaw+1];
+        ifIn.read(cBuffer,dump.nGammaLaw*sizeof(char));
+        cBuffer[dump.nGammaLaw]='\0';
         std::string sTemp=cBuffer;
-        sEOSFileName=sTemp;
+        dump.sEOSFileName=sTemp;
         delete [] cBuffer;
       }
       
       //read in artificial viscosity
-      ifIn[i].read((char*)(&dA),sizeof(double));
+      ifIn.read((char*)(&dump.dA),sizeof(double));
       
       //read in artificial viscosity threshold
-      ifIn[i].read((char*)(&dAVThreshold),sizeof(double));
+      ifIn.read((char*)(&dump.dAVThreshold),sizeof(double));
       
       //read in processor dims
-      ifIn[i].read((char*)(nGlobalProcDims),3*sizeof(int));
+      ifIn.read((char*)(dump.nGlobalProcDims),3*sizeof(int));
       
       //read in coordinates
-      nFileProcCoords[i]=new int[3];
-      ifIn[i].read((char*)(nFileProcCoords[i]),3*sizeof(int));
+      dump.nFileProcCoords[i]=new int[3];
+      ifIn.read((char*)(dump.nFileProcCoords[i]),3*sizeof(int));
       
       //read in periodic
-      ifIn[i].read((char*)(nPeriodic),3*sizeof(int));
+      ifIn.read((char*)(dump.nPeriodic),3*sizeof(int));
       
       //read in number of variables
-      ifIn[i].read((char*)(&nNumVars),sizeof(int));
+      ifIn.read((char*)(&dump.nNumVars),sizeof(int));
       
       //read in variable info
-      nVariableInfo[i]=new int*[nNumVars];
-      for(int n=0;n<nNumVars;n++){
-        nVariableInfo[i][n]=new int[4];
-        ifIn[i].read((char*)(nVariableInfo[i][n]),4*sizeof(int));
+      dump.nVariableInfo=new int*[dump.nNumVars];
+      for(int n=0;n<dump.nNumVars;n++){
+        dump.nVariableInfo[n]=new int[4];
+        ifIn.read((char*)(dump.nVariableInfo[n]),4*sizeof(int));
       }
+      nVariableInfo=dump.nVariableInfo;
       
       //read in number of 1D zones
-      ifIn[i].read((char*)(&nNum1DZones),sizeof(int));
+      ifIn.read((char*)(&dump.nNum1DZones),sizeof(int));
       
       //read in global grid size
-      ifIn[i].read((char*)(nGlobalGridDims),3*sizeof(int));
+      ifIn.read((char*)(dump.nGlobalGridDims),3*sizeof(int));
       
       //read in local grid size for each variable
-      nFileGridSizes[i]=new int*[nNumVars];
-      for(int n=0;n<nNumVars;n++){
-        nFileGridSizes[i][n]=new int[3];
-        ifIn[i].read((char*)(nFileGridSizes[i][n]),3*sizeof(int));
+      dump.nFileGridSizes[i]=new int*[dump.nNumVars];
+      for(int n=0;n<dump.nNumVars;n++){
+        dump.nFileGridSizes[i][n]=new int[3];
+        ifIn.read((char*)(dump.nFileGridSizes[i][n]),3*sizeof(int));
       }
       
       //read in number of ghostcells
-      ifIn[i].read((char*)(&nNumGhostCells),sizeof(int));
+      ifIn.read((char*)(&dump.nNumGhostCells),sizeof(int));
     }
     else{
       
       //read in time
       double dTemp;
-      ifIn[i].read((char*)(&dTemp),sizeof(double));
-      if(!(dTemp<=dTime*(1.0+5e-15)&&dTemp>=dTime*(1.0-5e-15))){
+      ifIn.read((char*)(&dTemp),sizeof(double));
+      if(!(dTemp<=dump.dTime*(1.0+5e-15)&&dTemp>=dump.dTime*(1.0-5e-15))){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has time="<<dTemp
-          <<"which is different from the time in \""<<sFileNameBase<<"-0\" of "<<dTime<<std::endl;
+          <<"which is different from the time in \""<<sFileNameBase<<"-0\" of "<<dump.dTime
+          <<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in timestep index
       int nTemp;
-      ifIn[i].read((char*)(&nTemp),sizeof(int));
-      if(nTemp!=nTimeStepIndex){
+      ifIn.read((char*)(&nTemp),sizeof(int));
+      if(nTemp!=dump.nTimeStepIndex){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has time step index="<<nTemp
           <<" which is different from the time step index in \""<<sFileNameBase<<"-0\" of "
-          <<nTimeStepIndex<<std::endl;
+          <<dump.nTimeStepIndex<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in timestep
-      ifIn[i].read((char*)(&dTemp),sizeof(double));
-      if(!(dTemp<=dTimeStep1*(1.0+5e-15)&&dTemp>=dTimeStep1*(1.0-5e-15))){
+      ifIn.read((char*)(&dTemp),sizeof(double));
+      if(!(dTemp<=dump.dTimeStep1*(1.0+5e-15)&&dTemp>=dump.dTimeStep1*(1.0-5e-15))){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has time step="<<dTemp
           <<" which is different from the time step in \""<<sFileNameBase<<"-0\" of "
-          <<dTimeStep1<<std::endl;
+          <<dump.dTimeStep1<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in timestep
-      ifIn[i].read((char*)(&dTemp),sizeof(double));
-      if(!(dTemp<=dTimeStep2*(1.0+5e-15)&&dTemp>=dTimeStep2*(1.0-5e-15))){
+      ifIn.read((char*)(&dTemp),sizeof(double));
+      if(!(dTemp<=dump.dTimeStep2*(1.0+5e-15)&&dTemp>=dump.dTimeStep2*(1.0-5e-15))){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has time step="<<dTemp
           <<" which is different from the time step in \""<<sFileNameBase<<"-0\" of "
-          <<dTimeStep2<<std::endl;
+          <<dump.dTimeStep2<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in alpha
-      ifIn[i].read((char*)(&dTemp),sizeof(double));
-      if(dTemp!=dAlpha){
+      ifIn.read((char*)(&dTemp),sizeof(double));
+      if(dTemp!=dump.dAlpha){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has alpha="<<dTemp
           <<" which is different from the alpha in \""<<sFileNameBase<<"-0\" of "
-          <<dAlpha<<std::endl;
+          <<dump.dAlpha<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in gamma law
-      ifIn[i].read((char*)(&nTemp),sizeof(int));
-      if(nTemp!=nGammaLaw){
+      ifIn.read((char*)(&nTemp),sizeof(int));
+      if(nTemp!=dump.nGammaLaw){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has gamma law="<<nTemp
           <<" which is different from the gamma law in \""<<sFileNameBase<<"-0\" of "
-          <<nGammaLaw<<std::endl;
+          <<dump.nGammaLaw<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
-      if(nGammaLaw==0){
-        ifIn[i].read((char*)(&dTemp),sizeof(double));
-        if(dTemp!=dGamma){
+      if(dump.nGammaLaw==0){
+        ifIn.read((char*)(&dTemp),sizeof(double));
+        if(dTemp!=dump.dGamma){
           std::stringstream ssTemp;
           ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
             <<ossFileName.str()<<"\" has a gamma of="<<dTemp
             <<" which is different from the gamma in \""<<sFileNameBase<<"-0\" of "
-            <<dGamma<<std::endl;
+            <<dump.dGamma<<std::endl;
           throw exception2(ssTemp.str(),INPUT);
         }
       }
       else{
-        char* cBuffer=new char[nGammaLaw+1];
-        ifIn[i].read(cBuffer,nGammaLaw*sizeof(char));
-        cBuffer[nGammaLaw]='\0';
+        char* cBuffer=new char[dump.nGammaLaw+1];
+        ifIn.read(cBuffer,dump.nGammaLaw*sizeof(char));
+        cBuffer[dump.nGammaLaw]='\0';
         std::string sTemp=cBuffer;
         delete [] cBuffer;
-        if(sTemp!=sEOSFileName){
+        if(sTemp!=dump.sEOSFileName){
           std::stringstream ssTemp;
           ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
             <<ossFileName.str()<<"\" uses equation of state file \""<<sTemp
             <<"\" which is different from the equation of state file in \""<<sFileNameBase
-            <<"-0\" of \""<<sEOSFileName<<"\""<<std::endl;
+            <<"-0\" of \""<<dump.sEOSFileName<<"\""<<std::endl;
           throw exception2(ssTemp.str(),INPUT);
         }
       }
       
       //read in artificial viscosity
-      ifIn[i].read((char*)(&dTemp),sizeof(double));
-      if(dTemp!=dA){
+      ifIn.read((char*)(&dTemp),sizeof(double));
+      if(dTemp!=dump.dA){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has artificial viscosity="<<dTemp
           <<" which is different from the artificial viscosity in \""<<sFileNameBase<<"-0\" of "
-          <<dA<<std::endl;
+          <<dump.dA<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in artificial viscosity threshold
-      ifIn[i].read((char*)(&dTemp),sizeof(double));
-      if(dTemp!=dAVThreshold){
+      ifIn.read((char*)(&dTemp),sizeof(double));
+      if(dTemp!=dump.dAVThreshold){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": file \""
           <<ossFileName.str()<<"\" has artificial viscosity threshold="<<dTemp
           <<" which is different from the artificial viscosity threshold in \""<<sFileNameBase
-          <<"-0\" of "<<dAVThreshold<<std::endl;
+          <<"-0\" of "<<dump.dAVThreshold<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in processor coordinates
-      nFileProcCoords[i]=new int[3];
-      ifIn[i].read((char*)(nFileProcCoords[i]),3*sizeof(int));
+      dump.nFileProcCoords[i]=new int[3];
+      ifIn.read((char*)(dump.nFileProcCoords[i]),3*sizeof(int));
       
       //read in number of variables and check it against file 0's
-      ifIn[i].read((char*)(&nTemp),sizeof(int));
-      if(nTemp!=nNumVars){
+      ifIn.read((char*)(&nTemp),sizeof(int));
+      if(nTemp!=dump.nNumVars){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
           <<": number of variables in file "<<i<<", "<<nTemp
           <<" does not agree with the number of variables in file 0,"
-          <<nNumVars<<std::endl;
+          <<dump.nNumVars<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
       
       //read in variable info and check it against file 0's
-      nVariableInfo[i]=new int*[nNumVars];
-      for(int n=0;n<nNumVars;n++){
-        nVariableInfo[i][n]=new int[4];
-        ifIn[i].read((char*)(nVariableInfo[i][n]),4*sizeof(int));
+      int nTempInfo[4];
+      for(int n=0;n<dump.nNumVars;n++){
+        ifIn.read((char*)(nTempInfo),4*sizeof(int));
         for(int l=0;l<4;l++){
-          if(nVariableInfo[i][n][l]!=nVariableInfo[0][n][l]){//if variable info doesn't match first file's
+          if(nTempInfo[l]!=nVariableInfo[n][l]){//if variable info doesn't match first file's
             std::stringstream ssTemp;
             ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
               <<": nVariableInfo["<<i<<"]["<<n<<"]["<<l<<"]="
-              <<nVariableInfo[i][n][l]<<" not equal to nVariableInfo[0]["<<n
+              <<nTempInfo[l]<<" not equal to nVariableInfo[0]["<<n
               <<"]["<<l<<"]"<<std::endl;
             throw exception2(ssTemp.str(),INPUT);
           }
@@ -1981,32 +2191,118 @@ void combineBinFiles(std::string sFileNameBase){//tested
       }
       
       //read in local grid size for each variable
-      nFileGridSizes[i]=new int*[nNumVars];
-      for(int n=0;n<nNumVars;n++){
-        nFileGridSizes[i][n]=new int[3];
-        ifIn[i].read((char*)(nFileGridSizes[i][n]),3*sizeof(int));
+      dump.nFileGridSizes[i]=new int*[dump.nNumVars];
+      for(int n=0;n<dump.nNumVars;n++){
+        dump.nFileGridSizes[i][n]=new int[3];
+        ifIn.read((char*)(dump.nFileGridSizes[i][n]),3*sizeof(int));
       }
       
       //read in number of ghost cells and check it against file 0's
-      ifIn[i].read((char*)(&nTemp),sizeof(int));
-      if(nTemp!=nNumGhostCells){
+      ifIn.read((char*)(&nTemp),sizeof(int));
+      if(nTemp!=dump.nNumGhostCells){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
           <<": number of ghost cells in file "<<i<<", "<<nTemp
           <<" does not agree with the number of ghost cells in file 0,"
-          <<nNumGhostCells<<std::endl;
+          <<dump.nNumGhostCells<<std::endl;
         throw exception2(ssTemp.str(),INPUT);
       }
     }
+    if(!ifIn.good()){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": error reading the header of the file "<<ossFileName.str()<<std::endl;
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //the grid follows directly after the header
+    dump.nFileDataStart[i]=off_t(ifIn.tellg());
+    ifIn.close();
+  }
+}
+void setCollectedLayout(distributedDump &dump){
+  
+  dump.nInnerSize=new int[dump.nNumVars];
+  dump.nOuterSize=new int[dump.nNumVars];
+  dump.nCollectedSize=new int*[dump.nNumVars];
+  dump.nVarStart=new off_t[dump.nNumVars+1];
+  dump.nVarStart[0]=dump.nHeaderSize;
+  for(int n=0;n<dump.nNumVars;n++){
+    
+    //size of the inner 1D region, and the outer 1D ghost cells of processor 0 which are not kept
+    dump.nInnerSize[n]=0;
+    dump.nOuterSize[n]=0;
+    if(dump.nVariableInfo[n][0]!=-1){
+      if(dump.nNumFiles==1){//only have a 1D region
+        dump.nInnerSize[n]=dump.nNum1DZones+2*dump.nNumGhostCells+dump.nVariableInfo[n][0];
+      }
+      else{
+        dump.nInnerSize[n]=dump.nNum1DZones+dump.nNumGhostCells+dump.nVariableInfo[n][0];
+        int nSizeY=dump.nGlobalGridDims[1];
+        if(dump.nVariableInfo[n][1]==-1){
+          nSizeY=dump.nGlobalProcDims[1];
+        }
+        int nSizeZ=dump.nGlobalGridDims[2];
+        if(dump.nVariableInfo[n][2]==-1){
+          nSizeZ=dump.nGlobalProcDims[2];
+        }
+        dump.nOuterSize[n]=dump.nNumGhostCells*nSizeY*nSizeZ;
+      }
+    }
+    
+    //size of the multi-dimensional region, the sum of the local grids of one row of processors in
+    //each direction plus the ghost cells at the edges of the global grid
+    dump.nCollectedSize[n]=new int[3];
+    for(int l=0;l<3;l++){
+      dump.nCollectedSize[n][l]=0;
+    }
+    for(int q=1;q<dump.nNumFiles;q++){
+      for(int l=0;l<3;l++){
+        bool bFirstRow=true;
+        for(int m=0;m<3;m++){
+          int nFirst=0;
+          if(m==0){
+            nFirst=1;
+          }
+          if(m!=l&&dump.nFileProcCoords[q][m]!=nFirst){
+            bFirstRow=false;
+          }
+        }
+        if(!bFirstRow){
+          continue;
+        }
+        if(dump.nVariableInfo[n][l]!=-1){
+          dump.nCollectedSize[n][l]+=dump.nFileGridSizes[q][n][l];
+        }
+        else if(dump.nFileProcCoords[q][l]==(l==0?1:0)){
+          dump.nCollectedSize[n][l]=dump.nFileGridSizes[q][n][l];
+        }
+      }
+    }
+    if(dump.nNumFiles>1){
+      if(dump.nVariableInfo[n][0]!=-1){
+        dump.nCollectedSize[n][0]+=dump.nNumGhostCells;
+      }
+      for(int l=1;l<3;l++){
+        if(dump.nVariableInfo[n][l]!=-1){
+          dump.nCollectedSize[n][l]+=2*dump.nNumGhostCells;
+        }
+      }
+    }
+    dump.nVarStart[n+1]=dump.nVarStart[n]+(off_t(dump.nInnerSize[n])
+      +off_t(dump.nCollectedSize[n][0])*dump.nCollectedSize[n][1]*dump.nCollectedSize[n][2])
+      *off_t(sizeof(double));
   }
+}
+void writeCollectedHeader(distributedDump &dump){
   
   //open output file
   std::ofstream ofOut;
-  ofOut.open(sFileNameBase.c_str(),std::ios::binary);
+  ofOut.open(dump.sFileNameBase.c_str(),std::ios::binary);
   if(!ofOut.good()){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-      <<": unable to open the file "<<sFileNameBase.c_str()<<std::endl;
+      <<": unable to open the file "<<dump.sFileNameBase.c_str()<<std::endl;
     throw exception2(ssTemp.str(),INPUT);
   }
   
@@ -2019,225 +2315,593 @@ void combineBinFiles(std::string sFileNameBase){//tested
   ofOut.write((char*)(&nTemp),sizeof(int));
   
   //write out time
-  ofOut.write((char*)(&dTime),sizeof(double));
+  ofOut.write((char*)(&dump.dTime),sizeof(double));
   
   //write out time step index
-  ofOut.write((char*)(&nTimeStepIndex),sizeof(int));
+  ofOut.write((char*)(&dump.nTimeStepIndex),sizeof(int));
   
   //write out time step
-  ofOut.write((char*)(&dTimeStep1),sizeof(double));
+  ofOut.write((char*)(&dump.dTimeStep1),sizeof(double));
   
   //write out time step
-  ofOut.write((char*)(&dTimeStep2),sizeof(double));
+  ofOut.write((char*)(&dump.dTimeStep2),sizeof(double));
   
   //write out alpha
-  ofOut.write((char*)(&dAlpha),sizeof(double));
+  ofOut.write((char*)(&dump.dAlpha),sizeof(double));
   
   //write out nGammaLaw
-  ofOut.write((char*)(&nGammaLaw),sizeof(int));
-  if(nGammaLaw==0){
-    ofOut.write((char*)(&dGamma),sizeof(double));
+  ofOut.write((char*)(&dump.nGammaLaw),sizeof(int));
+  if(dump.nGammaLaw==0){
+    ofOut.write((char*)(&dump.dGamma),sizeof(double));
   }
   else{
-    ofOut.write((char*)(sEOSFileName.c_str()),nGammaLaw*sizeof(char));
+    ofOut.write((char*)(dump.sEOSFileName.c_str()),dump.nGammaLaw*sizeof(char));
   }
   
   //read in artificial viscosity
-  ofOut.write((char*)(&dA),sizeof(double));
+  ofOut.write((char*)(&dump.dA),sizeof(double));
   
   //read in artificial viscosity threshold
-  ofOut.write((char*)(&dAVThreshold),sizeof(double));
+  ofOut.write((char*)(&dump.dAVThreshold),sizeof(double));
   
   //write out global grid dims
-  ofOut.write((char*)(nGlobalGridDims),3*sizeof(int));
+  ofOut.write((char*)(dump.nGlobalGridDims),3*sizeof(int));
   
   //write out periodicity
-  ofOut.write((char*)(nPeriodic),3*sizeof(int));
+  ofOut.write((char*)(dump.nPeriodic),3*sizeof(int));
   
   //write out number of 1D Zones
-  ofOut.write((char*)(&nNum1DZones),sizeof(int));
+  ofOut.write((char*)(&dump.nNum1DZones),sizeof(int));
   
   //write out number of ghostcells
-  ofOut.write((char*)(&nNumGhostCells),sizeof(int));
+  ofOut.write((char*)(&dump.nNumGhostCells),sizeof(int));
   
   //write out number of variables
-  ofOut.write((char*)(&nNumVars),sizeof(int));
+  ofOut.write((char*)(&dump.nNumVars),sizeof(int));
   
   //write out variable info
-  for(int n=0;n<nNumVars;n++){
-    ofOut.write((char*)(nVariableInfo[0][n]),4*sizeof(int));
+  for(int n=0;n<dump.nNumVars;n++){
+    ofOut.write((char*)(dump.nVariableInfo[n]),4*sizeof(int));
+  }
+  dump.nHeaderSize=off_t(ofOut.tellp());
+  if(!ofOut.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error writing the header of the file "<<dump.sFileNameBase.c_str()<<std::endl;
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+  ofOut.close();
+}
+void freeDistributedDump(distributedDump &dump){
+  for(int i=0;i<dump.nNumFiles;i++){
+    for(int n=0;n<dump.nNumVars;n++){
+      delete [] dump.nFileGridSizes[i][n];
+    }
+    delete [] dump.nFileGridSizes[i];
+    delete [] dump.nFileProcCoords[i];
+  }
+  for(int n=0;n<dump.nNumVars;n++){
+    delete [] dump.nVariableInfo[n];
+    delete [] dump.nCollectedSize[n];
+  }
+  delete [] dump.nFileGridSizes;
+  delete [] dump.nFileProcCoords;
+  delete [] dump.nFileDataStart;
+  delete [] dump.nVariableInfo;
+  delete [] dump.nCollectedSize;
+  delete [] dump.nInnerSize;
+  delete [] dump.nOuterSize;
+  delete [] dump.nVarStart;
+}
+void readBlock(int nFile,std::string sFileName,off_t nOffset,size_t nSize,char *cBuffer){
+  size_t nRead=0;
+  while(nRead<nSize){
+    #ifdef HAVE_PREAD
+    ssize_t nTemp=pread(nFile,cBuffer+nRead,nSize-nRead,nOffset+off_t(nRead));
+    #else
+    
+    //each distributed file is read by a single thread, so the seek and read need no lock
+    ssize_t nTemp=-1;
+    if(lseek(nFile,nOffset+off_t(nRead),SEEK_SET)>=0){
+      nTemp=read(nFile,cBuffer+nRead,nSize-nRead);
+    }
+    #endif
+    if(nTemp<=0){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": error reading "<<nSize<<" bytes at "<<nOffset<<" from the file \""<<sFileName
+        <<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    nRead+=size_t(nTemp);
+  }
+}
+void flushCollectedWriter(collectedWriter &writer){
+  size_t nSize=writer.nNumBuffered*sizeof(double);
+  size_t nWritten=0;
+  while(nWritten<nSize){
+    #ifdef HAVE_PWRITE
+    ssize_t nTemp=pwrite(writer.nFile,((char*)writer.dBuffer)+nWritten,nSize-nWritten
+      ,writer.nStart+off_t(nWritten));
+    #else
+    
+    //all threads write to the same collected file
+    ssize_t nTemp=-1;
+    pthread_mutex_lock(&mutexCollectedFiles);
+    if(lseek(writer.nFile,writer.nStart+off_t(nWritten),SEEK_SET)>=0){
+      nTemp=write(writer.nFile,((char*)writer.dBuffer)+nWritten,nSize-nWritten);
+    }
+    pthread_mutex_unlock(&mutexCollectedFiles);
+    #endif
+    if(nTemp<=0){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": error writing "<<nSize<<" bytes at "<<writer.nStart<<" to the file \""
+        <<writer.sFileName<<"\"\n";
+      throw exception2(ssTemp.str(),OUTPUT);
+    }
+    nWritten+=size_t(nTemp);
   }
+  writer.nNumBuffered=0;
+}
+void addToCollectedWriter(collectedWriter &writer,off_t nOffset,double *dValues,size_t nNum){
+  
+  //start a new write if not contiguous with what is already buffered, or if the buffer is full
+  if(writer.nNumBuffered>0&&(nOffset!=writer.nStart+off_t(writer.nNumBuffered*sizeof(double))
+    ||writer.nNumBuffered+nNum>writer.nCapacity)){
+    flushCollectedWriter(writer);
+  }
+  if(nNum>writer.nCapacity){//too large to buffer, write it directly
+    double *dBuffer=writer.dBuffer;
+    writer.dBuffer=dValues;
+    writer.nStart=nOffset;
+    writer.nNumBuffered=nNum;
+    flushCollectedWriter(writer);
+    writer.dBuffer=dBuffer;
+    return;
+  }
+  if(writer.nNumBuffered==0){
+    writer.nStart=nOffset;
+  }
+  memcpy(writer.dBuffer+writer.nNumBuffered,dValues,nNum*sizeof(double));
+  writer.nNumBuffered+=nNum;
+}
+void combineFile(combineTask &task,combineBuffers &buffers){
+  distributedDump &dump=*(task.dump);
+  int q=task.nFile;
+  std::ostringstream ossFileName;
+  ossFileName<<dump.sFileNameBase<<"-"<<q;
   
-  //write out the grid
-  for(int n=0;n<nNumVars;n++){
-    
-    //read in/write out inner 1D grid
-    int nSize[3];
-    if(nNumFiles==1){//only have a 1D region
-      nSize[0]=nNum1DZones+2*nNumGhostCells+nVariableInfo[0][n][0];
-      if(nVariableInfo[0][n][0]==-1){
-        nSize[0]=0;
-      }
-      nSize[1]=1;
-      nSize[2]=1;
+  //size of the grid in file q
+  size_t nDataSize=0;
+  for(int n=0;n<dump.nNumVars;n++){
+    if(q==0){
+      nDataSize+=size_t(dump.nInnerSize[n])+size_t(dump.nOuterSize[n]);
     }
     else{
-      nSize[0]=nNum1DZones+nNumGhostCells+nVariableInfo[0][n][0];
-      if(nVariableInfo[0][n][0]==-1){
-        nSize[0]=0;
+      size_t nSize=1;
+      for(int l=0;l<3;l++){
+        int nSizeFile=dump.nFileGridSizes[q][n][l];
+        if(dump.nVariableInfo[n][l]!=-1){
+          nSizeFile+=2*dump.nNumGhostCells;
+        }
+        nSize*=size_t(nSizeFile);
       }
-      nSize[1]=1;
-      nSize[2]=1;
+      nDataSize+=nSize;
+    }
+  }
+  
+  //read the whole grid of file q in one aligned read
+  if(nDataSize>buffers.nReadCapacity){
+    free(buffers.dRead);
+    buffers.dRead=NULL;
+    #ifdef HAVE_POSIX_MEMALIGN
+    if(posix_memalign((void**)(&buffers.dRead),nCombineAlignment,nDataSize*sizeof(double))!=0){
+    #else
+    buffers.dRead=(double*)malloc(nDataSize*sizeof(double));//alignment only helps speed
+    if(buffers.dRead==NULL){
+    #endif
+      buffers.dRead=NULL;
+      buffers.nReadCapacity=0;
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": unable to allocate a buffer for the file \""<<ossFileName.str()<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
     }
-    double *dRow=new double[nSize[2]];
-    for(int i=0;i<nSize[0];i++){
-      for(int j=0;j<nSize[1];j++){
-        ifIn[0].read((char*)(dRow),nSize[2]*sizeof(double));
-        ofOut.write((char*)(dRow),nSize[2]*sizeof(double));
+    buffers.nReadCapacity=nDataSize;
+  }
+  int nFile=open(ossFileName.str().c_str(),O_RDONLY);
+  if(nFile<0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error opening the file \""<<ossFileName.str()<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  try{
+    readBlock(nFile,ossFileName.str(),dump.nFileDataStart[q],nDataSize*sizeof(double)
+      ,(char*)(buffers.dRead));
+  }
+  catch(exception2 &eTemp){
+    close(nFile);
+    throw;
+  }
+  close(nFile);
+  
+  collectedWriter writer;
+  writer.nFile=dump.nOutFile;
+  writer.sFileName=dump.sFileNameBase;
+  writer.dBuffer=buffers.dWrite;
+  writer.nCapacity=buffers.nWriteCapacity;
+  writer.nNumBuffered=0;
+  writer.nStart=0;
+  double *dVar=buffers.dRead;
+  for(int n=0;n<dump.nNumVars;n++){
+    
+    //processor 0 holds the inner 1D region, its outer ghost cells are not kept
+    if(q==0){
+      if(dump.nInnerSize[n]>0){
+        addToCollectedWriter(writer,dump.nVarStart[n],dVar,size_t(dump.nInnerSize[n]));
       }
+      dVar+=dump.nInnerSize[n]+dump.nOuterSize[n];
+      continue;
     }
-    delete [] dRow;
     
-    //throw away outter 1D grid ghost cells
-    if(nNumFiles!=1){
-      int nSize2[3]={
-        nNum1DZones+2*nNumGhostCells+nVariableInfo[0][n][0]
-        ,nGlobalGridDims[1]
-        ,nGlobalGridDims[2]};
-      if(nVariableInfo[0][n][1]==-1){
-        nSize2[1]=nGlobalProcDims[1];
+    //find the zones file q owns, and where they go in the collected grid
+    int nSizeFile[3];
+    int nStart[3];
+    int nEnd[3];
+    int nPos[3];
+    bool bOwns=true;
+    for(int l=0;l<3;l++){
+      nSizeFile[l]=dump.nFileGridSizes[q][n][l];
+      nPos[l]=0;
+      if(dump.nVariableInfo[n][l]==-1){//only the first processor in direction l owns it
+        nStart[l]=0;
+        nEnd[l]=nSizeFile[l];
+        if(dump.nFileProcCoords[q][l]!=(l==0?1:0)){
+          bOwns=false;
+        }
+        continue;
       }
-      if(nVariableInfo[0][n][2]==-1){
-        nSize2[2]=nGlobalProcDims[2];
+      nSizeFile[l]+=2*dump.nNumGhostCells;
+      nStart[l]=dump.nNumGhostCells;
+      nEnd[l]=dump.nFileGridSizes[q][n][l]+dump.nNumGhostCells;
+      if(dump.nFileProcCoords[q][l]==0){//first processor keeps the inner ghost cells
+        nStart[l]=0;
       }
-      if(nVariableInfo[0][n][0]==-1){
-        nSize2[0]=0;
+      if(dump.nFileProcCoords[q][l]==dump.nGlobalProcDims[l]-1){//last keeps the outer ones
+        nEnd[l]+=dump.nNumGhostCells;
+      }
+      for(int p=1;p<dump.nNumFiles;p++){
+        bool bBefore=dump.nFileProcCoords[p][l]<dump.nFileProcCoords[q][l];
+        for(int m=0;m<3;m++){
+          if(m!=l&&dump.nFileProcCoords[p][m]!=dump.nFileProcCoords[q][m]){
+            bBefore=false;
+          }
+        }
+        if(bBefore){
+          nPos[l]+=dump.nFileGridSizes[p][n][l];
+        }
       }
-      dRow=new double[nSize2[2]];
-      for(int i=nSize[0];i<nSize2[0];i++){
-        for(int j=0;j<nSize2[1];j++){
-          ifIn[0].read((char*)(dRow),nSize2[2]*sizeof(double));
+    }
+    if(dump.nVariableInfo[n][0]!=-1){
+      nPos[0]-=dump.nNumGhostCells;//inner ghost cells are part of the 1D region
+    }
+    if(bOwns){
+      for(int i=nStart[0];i<nEnd[0];i++){
+        for(int j=nStart[1];j<nEnd[1];j++){
+          off_t nIndex=(off_t(nPos[0]+i)*dump.nCollectedSize[n][1]+(nPos[1]+j))
+            *dump.nCollectedSize[n][2]+(nPos[2]+nStart[2]);
+          addToCollectedWriter(writer,dump.nVarStart[n]+(off_t(dump.nInnerSize[n])+nIndex)
+            *off_t(sizeof(double)),dVar+(size_t(i)*nSizeFile[1]+j)*nSizeFile[2]+nStart[2]
+            ,size_t(nEnd[2]-nStart[2]));
         }
       }
-      delete [] dRow;
     }
-    
-    //allocate space to hold a row
-    int nRowSize;
-    nRowSize=nGlobalGridDims[2]+2*nNumGhostCells;
-    if(nVariableInfo[0][n][2]==-1){
-      nRowSize=1;
+    dVar+=size_t(nSizeFile[0])*nSizeFile[1]*nSizeFile[2];
+  }
+  flushCollectedWriter(writer);
+}
+void* combineWorker(void *vQueue){
+  combineQueue *queue=(combineQueue*)(vQueue);
+  combineBuffers buffers;
+  buffers.dRead=NULL;
+  buffers.nReadCapacity=0;
+  buffers.nWriteCapacity=nCombineWriteBufferSize;
+  buffers.dWrite=new double[buffers.nWriteCapacity];
+  while(true){
+    
+    //get the next file to combine
+    pthread_mutex_lock(&queue->mutex);
+    if(queue->nNext>=queue->vecTasks.size()||queue->bError){
+      pthread_mutex_unlock(&queue->mutex);
+      break;
+    }
+    combineTask task=queue->vecTasks[queue->nNext];
+    queue->nNext++;
+    pthread_mutex_unlock(&queue->mutex);
+    
+    try{
+      combineFile(task,buffers);
+    }
+    catch(exception2 &eTemp){
+      pthread_mutex_lock(&queue->mutex);
+      if(!queue->bError){
+        queue->eError=eTemp;
+        queue->bError=true;
+      }
+      pthread_mutex_unlock(&queue->mutex);
+    }
+  }
+  free(buffers.dRead);
+  delete [] buffers.dWrite;
+  return NULL;
+}
+void combineBinFiles(std::string sFileNameBase){//tested
+  std::vector<std::string> vecsFileNameBases(1,sFileNameBase);
+  combineBinFiles(vecsFileNameBases);
+}
+void combineBinFiles(std::vector<std::string> vecsFileNameBases){
+  
+  //number of threads to use
+  int nThreads=nNumThreads;
+  if(nThreads<=0){
+    nThreads=int(sysconf(_SC_NPROCESSORS_ONLN));
+    if(nThreads<=0){
+      nThreads=1;
+    }
+  }
+  
+  //combine the dumps a group at a time to limit the number of open output files
+  for(unsigned int nFirst=0;nFirst<vecsFileNameBases.size();nFirst+=nMaxCombineDumps){
+    unsigned int nLast=std::min((unsigned int)(vecsFileNameBases.size())
+      ,nFirst+(unsigned int)(nMaxCombineDumps));
+    std::vector<distributedDump> vecDumps(nLast-nFirst);
+    combineQueue queue;
+    queue.nNext=0;
+    queue.bError=false;
+    pthread_mutex_init(&queue.mutex,NULL);
+    
+    //read headers, write out the headers of the collected files and size them
+    for(unsigned int d=0;d<vecDumps.size();d++){
+      distributedDump &dump=vecDumps[d];
+      readDistributedHeaders(vecsFileNameBases[nFirst+d],dump);
+      writeCollectedHeader(dump);
+      setCollectedLayout(dump);
+      dump.nOutFile=open(dump.sFileNameBase.c_str(),O_WRONLY);
+      if(dump.nOutFile<0||ftruncate(dump.nOutFile,dump.nVarStart[dump.nNumVars])!=0){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": unable to open the file "<<dump.sFileNameBase.c_str()<<std::endl;
+        throw exception2(ssTemp.str(),OUTPUT);
+      }
+      for(int q=0;q<dump.nNumFiles;q++){
+        combineTask task;
+        task.dump=&dump;
+        task.nFile=q;
+        queue.vecTasks.push_back(task);
+      }
     }
-    dRow=new double[nRowSize];//need a new one for each variable
     
-    int nGhostCellsX=1;
-    if(nVariableInfo[0][n][0]==-1){
-      nGhostCellsX=0;
+    //each thread reads whole files and writes them into place in the collected files
+    int nThreadsGroup=std::min(nThreads,int(queue.vecTasks.size()));
+    std::vector<pthread_t> vecThreads(nThreadsGroup);
+    for(int t=0;t<nThreadsGroup;t++){
+      if(pthread_create(&vecThreads[t],NULL,combineWorker,(void*)(&queue))!=0){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": unable to create thread "<<t<<std::endl;
+        throw exception2(ssTemp.str(),CALCULATION);
+      }
     }
-    int nGhostCellsY=1;
-    if(nVariableInfo[0][n][1]==-1){
-      nGhostCellsY=0;
+    for(int t=0;t<nThreadsGroup;t++){
+      pthread_join(vecThreads[t],NULL);
     }
-    int nGhostCellsZ=1;
-    if(nVariableInfo[0][n][2]==-1){
-      nGhostCellsZ=0;
+    pthread_mutex_destroy(&queue.mutex);
+    
+    for(unsigned int d=0;d<vecDumps.size();d++){
+      close(vecDumps[d].nOutFile);
+      freeDistributedDump(vecDumps[d]);
     }
+    if(queue.bError){
+      throw queue.eError;
+    }
+  }
+}
+eos& getEOSTable(std::string sFileName){
+  pthread_mutex_lock(&mutexEOSTables);
+  std::map<std::string,eos*>::iterator it=mapEOSTables.find(sFileName);
+  if(it==mapEOSTables.end()){
     
-    for(int i=1;i<nGlobalProcDims[0];i++){//loop over processors in x-direction
-      int nSizeX=nFileGridSizes[(i-1)*nGlobalProcDims[2]
-        *nGlobalProcDims[1]+1][n][0]+nGhostCellsX*2*nNumGhostCells;
-      for(int l=0;l<nSizeX;l++){
-        for(int j=0;j<nGlobalProcDims[1];j++){//loop over processors in y-direction
-          int nSizeY=nFileGridSizes[j*nGlobalProcDims[2]+1][n][1]
-            +nGhostCellsY*2*nNumGhostCells;
-          for(int p=0;p<nSizeY;p++){
-            for(int k=0;k<nGlobalProcDims[2];k++){
-            
-              //fill up a row in z direction and write it out
-              //current file index
-              int nIndex=k+j*nGlobalProcDims[2]+(i-1)*nGlobalProcDims[2]
-                *nGlobalProcDims[1]+1;
-              //get size of row in current file
-              int nRowSize=nFileGridSizes[nIndex][n][2];
-              if(k==0&&nVariableInfo[0][n][2]!=-1){//if first processor or last processor in row
-                nRowSize=nRowSize+nNumGhostCells;//add ghost cells
-              }
-              if(k==nGlobalProcDims[2]-1&&nVariableInfo[0][n][2]!=-1){//if last processor in the row
-                nRowSize=nRowSize+nNumGhostCells;//add ghost cells 
-              }
-              
-              //throw away inner ghost cell if not first processor in dimension 2
-              double *dTemp;
-              if(k!=0&&nVariableInfo[0][n][2]!=-1){//provided dimension 2 is defined for var n
-                dTemp=new double[nNumGhostCells];
-                ifIn[nIndex].read((char*)(dTemp),nNumGhostCells*sizeof(double));
-                delete [] dTemp;
-              }
-              dTemp=new double[nRowSize];
-              ifIn[nIndex].read((char*)(dTemp),nRowSize*sizeof(double));
-              
-              //write out plane if it is not the first and last plane (x-direction)
-              if((l>=nGhostCellsX*nNumGhostCells
-                 &&l<nFileGridSizes[(i-1)*nGlobalProcDims[2]
-                 *nGlobalProcDims[1]+1][n][0]+nGhostCellsX*nNumGhostCells)
-                
-                //or it is the first processor in the 0 dimension and it is a ghost cell
-                ||((i==0&&l<nGhostCellsX*nNumGhostCells)
-                
-                //or it is the last processor in the 0 dimension and it is a ghost cell
-                ||((i==nGlobalProcDims[0]-1)
-                &&l>=nFileGridSizes[(i-1)*nGlobalProcDims[2]
-                *nGlobalProcDims[1]+1][n][0]+nGhostCellsX*nNumGhostCells))
-                ){
-                
-                //write out row if it is not a ghost cell row (y-direction)
-                if((p>=nGhostCellsY*nNumGhostCells
-                  &&p<nFileGridSizes[j*nGlobalProcDims[2]+1][n][1]
-                  +nGhostCellsY*nNumGhostCells)
-                  
-                  //or if it is the first processor in the 1 dimension and it is a ghost row
-                  ||((j==0&&p<nGhostCellsY*nNumGhostCells)
-                  
-                  //or if it is the last processor in the 1 dimension and it is a ghost row
-                  ||(j==nGlobalProcDims[1]-1
-                  &&p>=nFileGridSizes[j*nGlobalProcDims[2]+1][n][1]+nGhostCellsY*nNumGhostCells))
-                  ){
-                  if( ((j==0&&nVariableInfo[0][n][1]==-1)||(nVariableInfo[0][n][1]!=-1))
-                    &&((k==0&&nVariableInfo[0][n][2]==-1)||(nVariableInfo[0][n][2]!=-1))
-                    ){
-                    
-                    //if variable defined in x-direction || the first processor in x-direction after 0
-                    if(nVariableInfo[0][n][0]!=-1||i==1){
-                      ofOut.write((char*)(dTemp),nRowSize*sizeof(double));
-                    }
-                  }
-                }
-              }
-              delete [] dTemp;
-              
-              //throw away outter ghost cell if not last in row
-              if(k!=nGlobalProcDims[2]-1&&nVariableInfo[0][n][2]!=-1){
-                dTemp=new double[nNumGhostCells];
-                ifIn[nIndex].read((char*)(dTemp),nNumGhostCells*sizeof(double));
-                delete [] dTemp;
-              }
-            }
-          }
+    //first time this table is needed, read it in
+    eos *eosTable=new eos;
+    try{
+      eosTable->readBin(sFileName);
+    }
+    catch(exception2 &eTemp){
+      delete eosTable;
+      pthread_mutex_unlock(&mutexEOSTables);
+      throw;
+    }
+    it=mapEOSTables.insert(std::pair<std::string,eos*>(sFileName,eosTable)).first;
+  }
+  pthread_mutex_unlock(&mutexEOSTables);
+  return *(it->second);
+}
+std::vector<std::string> expandFileNames(std::vector<std::string> vecsFileNames
+  ,std::string sBatchListFile,bool bDistributed){
+  
+  //add file names listed in the batch list file, one per line
+  if(sBatchListFile.size()>0){
+    std::ifstream ifList;
+    ifList.open(sBatchListFile.c_str());
+    if(!ifList.good()){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": unable to open the batch list file \""<<sBatchListFile<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    std::string sLine;
+    while(std::getline(ifList,sLine)){
+      size_t nFirst=sLine.find_first_not_of(" \t\r");
+      if(nFirst==std::string::npos||sLine[nFirst]=='#'){//skip blank lines and comments
+        continue;
+      }
+      size_t nLast=sLine.find_last_not_of(" \t\r");
+      vecsFileNames.push_back(sLine.substr(nFirst,nLast-nFirst+1));
+    }
+    ifList.close();
+  }
+  
+  //expand wildcards which were not expanded by the shell
+  std::vector<std::string> vecsExpanded;
+  for(unsigned int n=0;n<vecsFileNames.size();n++){
+    if(vecsFileNames[n].find_first_of("*?[")==std::string::npos){
+      vecsExpanded.push_back(vecsFileNames[n]);
+      continue;
+    }
+    glob_t globFiles;
+    if(glob(vecsFileNames[n].c_str(),0,NULL,&globFiles)!=0){
+      globfree(&globFiles);
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": no files match \""<<vecsFileNames[n]<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    std::vector<std::string> vecsMatches;
+    for(size_t m=0;m<globFiles.gl_pathc;m++){
+      std::string sMatch=globFiles.gl_pathv[m];
+      
+      //distributed files are given by their base name, remove the "-<processor>" ending
+      if(bDistributed){
+        size_t nDash=sMatch.find_last_of("-");
+        if(nDash!=std::string::npos&&nDash+1<sMatch.size()
+          &&sMatch.find_first_not_of("0123456789",nDash+1)==std::string::npos){
+          sMatch=sMatch.substr(0,nDash);
         }
       }
+      if(std::find(vecsMatches.begin(),vecsMatches.end(),sMatch)==vecsMatches.end()){
+        vecsMatches.push_back(sMatch);
+      }
+    }
+    globfree(&globFiles);
+    vecsExpanded.insert(vecsExpanded.end(),vecsMatches.begin(),vecsMatches.end());
+  }
+  return vecsExpanded;
+}
+void* batchWorker(void *vQueue){
+  batchQueue *queue=(batchQueue*)(vQueue);
+  while(true){
+    
+    //get the next file, and wait until there is enough memory to process it
+    pthread_mutex_lock(&queue->mutex);
+    if(queue->nNext>=queue->vecsFileNames.size()){
+      pthread_mutex_unlock(&queue->mutex);
+      break;
+    }
+    size_t nFile=queue->nNext;
+    queue->nNext++;
+    size_t nMemory=queue->vecnMemory[nFile];
+    while(queue->nMemoryInUse>0&&queue->nMemoryInUse+nMemory>queue->nMemoryBudget){
+      pthread_cond_wait(&queue->condMemory,&queue->mutex);
+    }
+    queue->nMemoryInUse+=nMemory;
+    pthread_mutex_unlock(&queue->mutex);
+    
+    bool bFailed=false;
+    std::string sError;
+    try{
+      processFile(queue->job,queue->vecsFileNames[nFile]);
+    }
+    catch(exception2 &eTemp){
+      bFailed=true;
+      sError=eTemp.getMsg();
+    }
+    catch(...){
+      bFailed=true;
+      sError="unknown error\n";
+    }
+    
+    //release the memory, and report any error
+    pthread_mutex_lock(&queue->mutex);
+    queue->nMemoryInUse-=nMemory;
+    if(bFailed){
+      queue->nNumFailed++;
+      std::cout<<sError<<"error processing \""<<queue->vecsFileNames[nFile]<<"\"\n";
+    }
+    pthread_cond_broadcast(&queue->condMemory);
+    pthread_mutex_unlock(&queue->mutex);
+  }
+  return NULL;
+}
+void processFiles(batchJob &job,std::vector<std::string> vecsFileNames){
+  
+  batchQueue queue;
+  queue.job=job;
+  queue.vecsFileNames=vecsFileNames;
+  queue.nNext=0;
+  queue.nMemoryInUse=0;
+  queue.nNumFailed=0;
+  
+  //memory budget, default is half of the physical memory
+  queue.nMemoryBudget=size_t(nMemoryBudgetMB)*1048576;
+  if(nMemoryBudgetMB<=0){
+    queue.nMemoryBudget=size_t(sysconf(_SC_PHYS_PAGES))*size_t(sysconf(_SC_PAGE_SIZE))/2;
+  }
+  
+  //estimate the memory needed for each file from its size
+  for(unsigned int n=0;n<vecsFileNames.size();n++){
+    struct stat statFile;
+    size_t nMemory=0;
+    if(stat(vecsFileNames[n].c_str(),&statFile)==0){
+      nMemory=size_t(statFile.st_size)*nBatchMemoryFactor;
+    }
+    queue.vecnMemory.push_back(nMemory);
+  }
+  
+  //number of threads to use, fourier transforms and HDF files are made one at a time as those
+  //libraries are not thread safe
+  int nThreads=nNumThreads;
+  if(nThreads<=0){
+    nThreads=int(sysconf(_SC_NPROCESSORS_ONLN));
+  }
+  int nTotalThreads=std::max(1,nThreads);
+  if(job.nOperation==4||job.nOperation==41||job.nOperation==6){
+    nThreads=1;
+  }
+  nThreads=std::max(1,std::min(nThreads,int(vecsFileNames.size())));
+  
+  //threads not needed for separate files help with the radial shells of each file
+  queue.job.nShellThreads=std::max(1,nTotalThreads/nThreads);
+  
+  pthread_mutex_init(&queue.mutex,NULL);
+  pthread_cond_init(&queue.condMemory,NULL);
+  if(nThreads==1){
+    batchWorker((void*)(&queue));
+  }
+  else{
+    std::vector<pthread_t> vecThreads(nThreads);
+    for(int t=0;t<nThreads;t++){
+      if(pthread_create(&vecThreads[t],NULL,batchWorker,(void*)(&queue))!=0){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": unable to create thread "<<t<<std::endl;
+        throw exception2(ssTemp.str(),CALCULATION);
+      }
+    }
+    for(int t=0;t<nThreads;t++){
+      pthread_join(vecThreads[t],NULL);
     }
-    delete [] dRow;
   }
+  pthread_cond_destroy(&queue.condMemory);
+  pthread_mutex_destroy(&queue.mutex);
   
-  ofOut.close();
-  //delete allocated memory
-  /*for(int i=0;i<nNumFiles;i++){
-    delete [] nFileGridSizes[i];
-    delete [] nFileProcCoords[i];
-  }
-  delete [] nFileGridSizes;
-  delete [] nFileProcCoords;
-  delete [] ifIn;*/
+  if(queue.nNumFailed>0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": "<<queue.nNumFailed<<" of "<<vecsFileNames.size()<<" files failed\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
 }
 bool bFileExists(std::string strFilename){
   std::ifstream ifTest;
@@ -2397,7 +3061,523 @@ void convertCollAsciiToBin(std::string sFileName){//tested
     ofFile.write((char*)(&dTemp),sizeof(double));
   }
 }
-void makeRadialProFromColBin(std::string sFileName){//updated
+gridIndices getGridIndices(){
+  gridIndices indices;
+  indices.nM=nM;
+  indices.nTheta=nTheta;
+  indices.nPhi=nPhi;
+  indices.nDM=nDM;
+  indices.nR=nR;
+  indices.nD=nD;
+  indices.nU=nU;
+  indices.nU0=nU0;
+  indices.nV=nV;
+  indices.nW=nW;
+  indices.nE=nE;
+  indices.nT=nT;
+  indices.nP=nP;
+  indices.nQ=nQ;
+  indices.nKappa=nKappa;
+  indices.nGamma=nGamma;
+  indices.nL_rad=nL_rad;
+  indices.nL_con=nL_con;
+  indices.nKEP=nKEP;
+  indices.nKETot=nKETot;
+  indices.nC=nC;
+  indices.nF_con=nF_con;
+  return indices;
+}
+void setGridIndices(const gridIndices &indices){
+  nM=indices.nM;
+  nTheta=indices.nTheta;
+  nPhi=indices.nPhi;
+  nDM=indices.nDM;
+  nR=indices.nR;
+  nD=indices.nD;
+  nU=indices.nU;
+  nU0=indices.nU0;
+  nV=indices.nV;
+  nW=indices.nW;
+  nE=indices.nE;
+  nT=indices.nT;
+  nP=indices.nP;
+  nQ=indices.nQ;
+  nKappa=indices.nKappa;
+  nGamma=indices.nGamma;
+  nL_rad=indices.nL_rad;
+  nL_con=indices.nL_con;
+  nKEP=indices.nKEP;
+  nKETot=indices.nKETot;
+  nC=indices.nC;
+  nF_con=indices.nF_con;
+}
+void makeShellProfiles_TEOS(profileShells &shells,int nFirst,int nLast){
+  double ****dGrid=shells.dGrid;
+  double **dMax=shells.dMax;
+  double **dMin=shells.dMin;
+  double **dAve=shells.dAve;
+  int **nMaxJIndex=shells.nMaxJIndex;
+  int **nMaxKIndex=shells.nMaxKIndex;
+  int **nMinJIndex=shells.nMinJIndex;
+  int **nMinKIndex=shells.nMinKIndex;
+  int nNumDims=shells.nNumDims;
+  int nSizeX1=shells.nSizeX1;
+  int nSizeX2=shells.nSizeX2;
+  int nSizeY=shells.nSizeY;
+  int nStartY=shells.nStartY;
+  int nEndY=shells.nEndY;
+  int nSizeZ=shells.nSizeZ;
+  int nStartZ=shells.nStartZ;
+  int nEndZ=shells.nEndZ;
+  double dAVThreshold=shells.dAVThreshold;
+  double dASq=shells.dA*shells.dA;
+  
+  //equation of state of the zones of shell i and i+1, and the temperatures and densities of a shell
+  int nNumZones=(nEndY-nStartY)*(nEndZ-nStartZ);
+  std::vector<double> vecdShellT(nNumZones);
+  std::vector<double> vecdShellRho(nNumZones);
+  std::vector<double> vecdEOS(10*nNumZones);
+  double *dP_i=&vecdEOS[0];
+  double *dE_i=&vecdEOS[nNumZones];
+  double *dKappa_i=&vecdEOS[2*nNumZones];
+  double *dGamma_i=&vecdEOS[3*nNumZones];
+  double *dCp_i=&vecdEOS[4*nNumZones];
+  double *dP_ip1=&vecdEOS[5*nNumZones];
+  double *dE_ip1=&vecdEOS[6*nNumZones];
+  double *dKappa_ip1=&vecdEOS[7*nNumZones];
+  double *dGamma_ip1=&vecdEOS[8*nNumZones];
+  double *dCp_ip1=&vecdEOS[9*nNumZones];
+  
+  int i;
+  int j;
+  int k;
+  int n;
+  int nCount;
+  double dF_con;
+  double dCp_ip1half;
+  double dRho_ip1half;
+  double dTAve_ip1half;
+  double dT_ip1halfjk;
+  double dKappa_ip1half;
+  double dQ;
+  double dQ0=0.0;
+  double dQ1=0.0;
+  double dQ2=0.0;
+  double dMaxE;
+  double dMinE;
+  double dSumE;
+  double dMaxP;
+  double dMinP;
+  double dSumP;
+  double dMaxF_con;
+  double dMinF_con;
+  double dSumF_con;
+  double dMaxKappa;
+  double dMinKappa;
+  double dSumKappa;
+  double dMaxGamma;
+  double dMinGamma;
+  double dSumGamma;
+  double dMaxQ;
+  double dMinQ;
+  double dSumQ;
+  double dC;
+  double dMaxC;
+  double dMinC;
+  double dSumC;
+  double dRSq_i;
+  double dA_ip1half;
+  double dA_im1half;
+  double dTheta_j;
+  double dTheta_jp1half;
+  double dTheta_jm1half=0.0;
+  double dA_jp1half=0.0;
+  double dA_jm1half=0.0;
+  double dA_j=0.0;
+  double dDVDtThreshold;
+  double dDVDt_mthreshold;
+  double dDVDt;
+  double dLSum_rad;
+  double dLSum_con;
+  double dAreaSum;
+  double dR_i;
+  double dRSq_ip1half;
+  double dT4_ip1;
+  double dT4_i;
+  double dArea;
+  double dArea1;
+  double dArea2=0.0;
+  double dPhi_kp1half;
+  double dPhi_km1half;
+  double dU_i;
+  double dU_ijk;
+  double dV_ijk;
+  double dW_ijk;
+  double dVSq_ijk;
+  double dKETotSum;
+  double dDMSum;
+  double dDMTemp;
+  
+  //get P,E,Kappa,Gamma,Cp of the first shell
+  for(n=0,j=nStartY;j<nEndY;j++){
+    for(k=nStartZ;k<nEndZ;k++,n++){
+      vecdShellT[n]=dGrid[nT][nFirst][j][k];
+      vecdShellRho[n]=dGrid[nD][nFirst][j][k];
+    }
+  }
+  shells.eosTable->getPEKappaGammaCp(nNumZones,&vecdShellT[0],&vecdShellRho[0],dP_i,dE_i
+    ,dKappa_i,dGamma_i,dCp_i);
+  
+  for(i=nFirst;i<nLast;i++){
+    
+    //get P,E,Kappa,Gamma,Cp of the next shell, kept for the next iteration
+    if(i<nSizeX2-1){
+      for(n=0,j=nStartY;j<nEndY;j++){
+        for(k=nStartZ;k<nEndZ;k++,n++){
+          vecdShellT[n]=dGrid[nT][i+1][j][k];
+          vecdShellRho[n]=dGrid[nD][i+1][j][k];
+        }
+      }
+      shells.eosTable->getPEKappaGammaCp(nNumZones,&vecdShellT[0],&vecdShellRho[0],dP_ip1,dE_ip1
+        ,dKappa_ip1,dGamma_ip1,dCp_ip1);
+    }
+    
+    dMaxE=-1.0*std::numeric_limits<double>::max();
+    dMinE=std::numeric_limits<double>::max();
+    dSumE=0.0;
+    dMaxP=-1.0*std::numeric_limits<double>::max();
+    dMinP=std::numeric_limits<double>::max();
+    dSumP=0.0;
+    dMaxF_con=-1.0*std::numeric_limits<double>::max();
+    dMinF_con=std::numeric_limits<double>::max();
+    dSumF_con=0.0;
+    dMaxKappa=-1.0*std::numeric_limits<double>::max();
+    dMinKappa=std::numeric_limits<double>::max();
+    dSumKappa=0.0;
+    dMaxGamma=-1.0*std::numeric_limits<double>::max();
+    dMinGamma=std::numeric_limits<double>::max();
+    dSumGamma=0.0;
+    dMaxQ=-1.0*std::numeric_limits<double>::max();
+    dMinQ=std::numeric_limits<double>::max();
+    dSumQ=0.0;
+    dMaxC=-1.0*std::numeric_limits<double>::max();
+    dMinC=std::numeric_limits<double>::max();
+    dSumC=0.0;
+    nCount=0;
+    dR_i=(dGrid[nR][i+1][0][0]+dGrid[nR][i][0][0])*0.5;
+    dRSq_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
+    dRSq_i=dR_i*dR_i;
+    dA_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
+    dA_im1half=dGrid[nR][i][0][0]*dGrid[nR][i][0][0];
+    dLSum_rad=0.0;
+    dLSum_con=0.0;
+    dAreaSum=0.0;
+    dArea1=dRSq_ip1half*4.0*dPi;
+    dArea=dArea1;//in 1D the area is the whole sphere
+    dKETotSum=0.0;
+    dDMSum=0.0;
+    dDMTemp=dGrid[nDM][i][0][0];//in 1D these are the same
+    
+    for(n=0,j=nStartY;j<nEndY;j++){
+      
+      if(nNumDims>1){
+        dTheta_jp1half=dGrid[nTheta][0][j][0];
+        if(j==0){
+          dTheta_jm1half=dGrid[nTheta][0][j][0]-(dGrid[nTheta][0][j+1][0]-dGrid[nTheta][0][j][0]);
+        }
+        else{
+          dTheta_jm1half=dGrid[nTheta][0][j-1][0];
+        }
+        dTheta_j=(dTheta_jp1half+dTheta_jm1half)*0.5;
+        dA_jp1half=sin(dTheta_jp1half);
+        dA_jm1half=sin(dTheta_jm1half);
+        dA_j=sin(dTheta_j);
+        dArea2=dArea1/2.0*(cos(dTheta_jm1half)-cos(dTheta_jp1half));
+        dArea=dArea2;
+        dDMTemp=(cos(dTheta_jm1half)-cos(dTheta_jp1half))*dGrid[nD][i][j][0];
+      }
+      
+      for(k=nStartZ;k<nEndZ;k++,n++){
+        if(nNumDims>2){
+          dPhi_kp1half=dGrid[nPhi][0][0][k];
+          if(k==0){
+            dPhi_km1half=dGrid[nPhi][0][0][k]-(dGrid[nPhi][0][0][k+1]-dGrid[nPhi][0][0][k]);
+          }
+          else{
+            dPhi_km1half=dGrid[nPhi][0][0][k-1];
+          }
+          dArea=dArea2/(2.0*dPi)*(dPhi_kp1half-dPhi_km1half);
+          dDMTemp=(cos(dTheta_jm1half)-cos(dTheta_jp1half))
+            *(dPhi_kp1half-dPhi_km1half)*dGrid[nD][i][j][k];
+        }
+        
+        //calculate luminosity from cell and add to sum
+        if(i<nSizeX2-1){
+          dT4_i=pow(dGrid[nT][i][j][k],4);
+          dT4_ip1=pow(dGrid[nT][i+1][j][k],4);
+          dKappa_ip1half=(dT4_i/dKappa_i[n]+dT4_ip1/dKappa_ip1[n])
+            /(dT4_i+dT4_ip1);
+          dLSum_rad=dLSum_rad-16.0*dPi*dSigma*dRSq_ip1half*dKappa_ip1half/3.0
+            *(dT4_ip1-dT4_i)/(dGrid[nDM][i][0][0]+dGrid[nDM][i+1][0][0])*2.0*dArea;
+          dRho_ip1half=(dGrid[nD][i][j][k]+dGrid[nD][i+1][j][k])*0.5;
+          dTAve_ip1half=(dAve[nT][i]+dAve[nT][i+1])*0.5;
+          dT_ip1halfjk=(dGrid[nT][i][j][k]+dGrid[nT][i+1][j][k])*0.5;
+          dCp_ip1half=(dCp_i[n]+dCp_ip1[n])*0.5;
+          dLSum_con=dLSum_con+dCp_ip1half*dRho_ip1half*(dT_ip1halfjk-dTAve_ip1half)
+            *(dGrid[nU][i+1][j][k]-dGrid[nU0][i+1][0][0])*dArea;
+          dF_con=dCp_ip1half*dRho_ip1half*(dT_ip1halfjk-dTAve_ip1half)
+            *(dGrid[nU][i+1][j][k]-dGrid[nU0][i+1][0][0]);
+        }
+        else{
+          //use surface boundary condition
+          dLSum_rad=dLSum_rad+dSigma*dArea*pow(pow(2.0,0.25)*dGrid[nT][i][j][k],4);
+          dLSum_con=0.0;
+          dF_con=0.0;
+        }
+        dAreaSum+=dArea;
+        
+        //calculate total kinetic energy
+        if(i==nSizeX1){
+          dU_ijk=(dGrid[nU][i+1][j][k]+dGrid[nU][i][0][0])*0.5;
+        }
+        else{
+          dU_ijk=(dGrid[nU][i+1][j][k]+dGrid[nU][i][j][k])*0.5;
+        }
+        dVSq_ijk=dU_ijk*dU_ijk;
+        if(nNumDims>1){
+          dV_ijk=(dGrid[nV][i][j+1][k]+dGrid[nV][i][j][k])*0.5;
+          dVSq_ijk+=dV_ijk*dV_ijk;
+        }
+        if(nNumDims>2){
+          dW_ijk=(dGrid[nW][i][j][k+1]+dGrid[nW][i][j][k])*0.5;
+          dVSq_ijk+=dW_ijk*dW_ijk;
+        }
+        dKETotSum+=dDMTemp*dVSq_ijk;
+        dDMSum+=dDMTemp;
+        
+        if(dF_con>dMaxF_con){
+          dMaxF_con=dF_con;
+          nMaxJIndex[nF_con][i]=j;
+          nMaxKIndex[nF_con][i]=k;
+        }
+        if(dF_con<dMinF_con){
+          dMinF_con=dF_con;
+          nMinJIndex[nF_con][i]=j;
+          nMinKIndex[nF_con][i]=k;
+        }
+        dSumF_con+=dF_con;
+        
+        //calculate Q
+        dC=sqrt(dGamma_i[n]*dP_i[n]/dGrid[nD][i][j][k]);
+        dDVDtThreshold=dAVThreshold*dC;
+        if(nNumDims>=1){
+          if(i==nSizeX1){
+            dDVDt=(dA_ip1half*dGrid[nU][i+1][j][k]
+              -dA_im1half*dGrid[nU][i][0][0])/dRSq_i;
+          }
+          else{
+            dDVDt=(dA_ip1half*dGrid[nU][i+1][j][k]
+              -dA_im1half*dGrid[nU][i][j][k])/dRSq_i;
+          }
+          if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+            dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+            dQ0=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
+          }
+          else{
+            dQ0=0.0;
+          }
+        }
+        else if(nNumDims>=2){
+          if(j==0){
+            dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
+              -dA_jm1half*dGrid[nV][i][nSizeY-1][k])/dA_j;
+          }
+          else{
+            dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
+              -dA_jm1half*dGrid[nV][i][j-1][k])/dA_j;
+          }
+          if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+            dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+            dQ1=dASq*dGrid[nD][i][j][k]
+              *dDVDt_mthreshold*dDVDt_mthreshold;
+          }
+          else{
+            dQ1=0.0;
+          }
+        }
+        else if(nNumDims==3){
+          if(k==0){
+            dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][nSizeZ-1]);
+          }
+          else{
+            dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][k-1]);
+          }
+          if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+            dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+            dQ2=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
+          }
+          else{
+            dQ2=0.0;
+          }
+        }
+        dQ=dQ0+dQ1+dQ2;
+        
+        if(dP_i[n]>dMaxP){
+          dMaxP=dP_i[n];
+          nMaxJIndex[nP][i]=j;
+          nMaxKIndex[nP][i]=k;
+        }
+        if(dP_i[n]<dMinP){
+          dMinP=dP_i[n];
+          nMinJIndex[nP][i]=j;
+          nMinKIndex[nP][i]=k;
+        }
+        dSumP+=dP_i[n];
+        if(dE_i[n]>dMaxE){
+          dMaxE=dE_i[n];
+          nMaxJIndex[nE][i]=j;
+          nMaxKIndex[nE][i]=k;
+        }
+        if(dE_i[n]<dMinE){
+          dMinE=dE_i[n];
+          nMinJIndex[nE][i]=j;
+          nMinKIndex[nE][i]=k;
+        }
+        dSumE+=dE_i[n];
+        if(dKappa_i[n]>dMaxKappa){
+          dMaxKappa=dKappa_i[n];
+          nMaxJIndex[nKappa][i]=j;
+          nMaxKIndex[nKappa][i]=k;
+        }
+        if(dKappa_i[n]<dMinKappa){
+          dMinKappa=dKappa_i[n];
+          nMinJIndex[nKappa][i]=j;
+          nMinKIndex[nKappa][i]=k;
+        }
+        dSumKappa+=dKappa_i[n];
+        if(dGamma_i[n]>dMaxGamma){
+          dMaxGamma=dGamma_i[n];
+          nMaxJIndex[nGamma][i]=j;
+          nMaxKIndex[nGamma][i]=k;
+        }
+        if(dGamma_i[n]<dMinGamma){
+          dMinGamma=dGamma_i[n];
+          nMinJIndex[nGamma][i]=j;
+          nMinKIndex[nGamma][i]=k;
+        }
+        dSumGamma+=dGamma_i[n];
+        if(dQ>dMaxQ){
+          dMaxQ=dQ;
+          nMaxJIndex[nQ][i]=j;
+          nMaxKIndex[nQ][i]=k;
+        }
+        if(dQ<dMinQ){
+          dMinQ=dQ;
+          nMinJIndex[nQ][i]=j;
+          nMinKIndex[nQ][i]=k;
+        }
+        dSumQ+=dQ;
+        if(dC>dMaxC){
+          dMaxC=dC;
+          nMaxJIndex[nC][i]=j;
+          nMaxKIndex[nC][i]=k;
+        }
+        if(dC<dMinC){
+          dMinC=dC;
+          nMinJIndex[nC][i]=j;
+          nMinKIndex[nC][i]=k;
+        }
+        dSumC+=dC;
+        nCount++;
+      }
+    }
+    nMaxJIndex[nL_rad][i]=0;
+    nMaxKIndex[nL_rad][i]=0;
+    nMinJIndex[nL_rad][i]=0;
+    nMinKIndex[nL_rad][i]=0;
+    nMaxJIndex[nKEP][i]=0;
+    nMaxKIndex[nKEP][i]=0;
+    nMinJIndex[nKEP][i]=0;
+    nMinKIndex[nKETot][i]=0;
+    nMaxJIndex[nKETot][i]=0;
+    nMaxKIndex[nKETot][i]=0;
+    nMinJIndex[nKETot][i]=0;
+    nMinKIndex[nKETot][i]=0;
+    if(nNumDims==3){
+      dAve[nD][i]=dCalRhoAve3D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
+    }
+    else if(nNumDims==2){
+      dAve[nD][i]=dCalRhoAve2D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
+    }
+    else{
+      dAve[nD][i]=dGrid[nD][i][0][0];
+    }
+    dAve[nL_rad][i]=dLSum_rad/dAreaSum*4.0*dPi*dRSq_ip1half;
+    dAve[nL_con][i]=dLSum_con/dAreaSum*4.0*dPi*dRSq_ip1half;
+    dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
+    dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
+    dAve[nKETot][i]=0.5*dKETotSum/dDMSum*dGrid[nDM][i][0][0];
+    dMax[nP][i]=dMaxP;
+    dMin[nP][i]=dMinP;
+    dAve[nP][i]=dSumP/double(nCount);
+    dMax[nF_con][i]=dMaxF_con;
+    dMin[nF_con][i]=dMinF_con;
+    dAve[nF_con][i]=dSumF_con/double(nCount);
+    dMax[nE][i]=dMaxE;
+    dMin[nE][i]=dMinE;
+    dAve[nE][i]=dSumE/double(nCount);
+    dMax[nKappa][i]=dMaxKappa;
+    dMin[nKappa][i]=dMinKappa;
+    dAve[nKappa][i]=dSumKappa/double(nCount);
+    dMax[nGamma][i]=dMaxGamma;
+    dMin[nGamma][i]=dMinGamma;
+    dAve[nGamma][i]=dSumGamma/double(nCount);
+    dMax[nQ][i]=dMaxQ;
+    dMin[nQ][i]=dMinQ;
+    dAve[nQ][i]=dSumQ/double(nCount);
+    dMax[nC][i]=dMaxC;
+    dMin[nC][i]=dMinC;
+    dAve[nC][i]=dSumC/double(nCount);
+    
+    //the next shell's equation of state becomes this shell's
+    std::swap(dP_i,dP_ip1);
+    std::swap(dE_i,dE_ip1);
+    std::swap(dKappa_i,dKappa_ip1);
+    std::swap(dGamma_i,dGamma_ip1);
+    std::swap(dCp_i,dCp_ip1);
+  }
+}
+void* profileShellWorker(void *vShells){
+  profileShells *shells=(profileShells*)(vShells);
+  setGridIndices(shells->indices);
+  while(true){
+    
+    //get the next chunk of shells
+    pthread_mutex_lock(&shells->mutex);
+    if(shells->nNext>=shells->nSizeX2||shells->bError){
+      pthread_mutex_unlock(&shells->mutex);
+      break;
+    }
+    int nFirst=shells->nNext;
+    int nLast=std::min(nFirst+nProfileShellChunk,shells->nSizeX2);
+    shells->nNext=nLast;
+    pthread_mutex_unlock(&shells->mutex);
+    
+    try{
+      makeShellProfiles_TEOS(*shells,nFirst,nLast);
+    }
+    catch(exception2 &eTemp){
+      pthread_mutex_lock(&shells->mutex);
+      if(!shells->bError){
+        shells->eError=eTemp;
+        shells->bError=true;
+      }
+      pthread_mutex_unlock(&shells->mutex);
+    }
+  }
+  return NULL;
+}
+void makeRadialProFromColBin(std::string sFileName,int nShellThreads){//updated
   
   //open input file
   std::string sExtension=sFileName.substr(sFileName.size()-4,1);
@@ -2410,1770 +3590,1237 @@ void makeRadialProFromColBin(std::string sFileName){//updated
       <<": no input file specified\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  std::ifstream ifFile;
-  ifFile.open(sFileName.c_str(),std::ios::binary);
-  if(!ifFile.good()){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" didn't open properly\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
+  dumpFile dump;
+  dump.open(sFileName,nDumpFileVersion);
+  double dTime=dump.dTime;
+  int nGammaLaw=int(dump.sEOSFileName.size());
+  int nNumDims=dump.nNumDims;
+  int nSizeGlobe[3]={dump.nGlobalGridDims[0],dump.nGlobalGridDims[1],dump.nGlobalGridDims[2]};
+  int nNumGhostCells=dump.nNumGhostCells;
   
-  //check that it is a binary file
-  char cTemp;
-  ifFile.read((char*)(&cTemp),sizeof(char));
-  if(cTemp!='b'){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" isn't a binary file.\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
+  //radialize the grid
+  radialProfile profile;
+  makeRadialProfile(dump,nShellThreads,profile);
+  double ****dGrid=profile.dGrid;
+  double **dMax=profile.dMax;
+  double **dMin=profile.dMin;
+  double **dAve=profile.dAve;
+  int **nMaxJIndex=profile.nMaxJIndex;
+  int **nMaxKIndex=profile.nMaxKIndex;
+  int **nMinJIndex=profile.nMinJIndex;
+  int **nMinKIndex=profile.nMinKIndex;
+  double *dUpFlowFillingFactor=profile.dUpFlowFillingFactor;
+  eos &eosTable=profile.eosTable;
   
-  //check that it is the correct version
-  int nTemp;
-  ifFile.read((char*)(&nTemp),sizeof(int));
-  if(nTemp!=nDumpFileVersion){
+  //open output file
+  std::string sFileNameOut=sFileName+"_pro.txt";
+  std::ofstream ofFile;
+  ofFile.open(sFileNameOut.c_str());
+  if(!ofFile.good()){
     std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": inpput file \""
-      <<sFileName<<"\" version \""<<nTemp
-      <<"\" isn't the supported version \""<<nDumpFileVersion<<"\".\n";
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
+      <<sFileNameOut<<" didn't open properly\n";
     throw exception2(ssTemp.str(),INPUT);
   }
   
-  //read in time
-  double dTime;
-  ifFile.read((char*)(&dTime),sizeof(double));
-  
-  //read in the time step index
-  int nTimeStepIndex;
-  ifFile.read((char*)(&nTimeStepIndex),sizeof(int));
-  
-  //read in the time step
-  double dTimeStep1;
-  ifFile.read((char*)(&dTimeStep1),sizeof(double));
-  
-  //read in the time step
-  double dTimeStep2;
-  ifFile.read((char*)(&dTimeStep2),sizeof(double));
-  
-  //read in alpha
-  double dAlpha;
-  ifFile.read((char*)(&dAlpha),sizeof(double));
-  
-  //read in gamma law
-  int nGammaLaw;
-  ifFile.read((char*)(&nGammaLaw),sizeof(int));
-  
-  double dGamma;
-  std::string sEOSTable;
-  eos eosTable;
-  if(nGammaLaw==0){
-    ifFile.read((char*)(&dGamma),sizeof(double));
+  //set double output precision
+  ofFile.precision(nPrecisionAscii);
+  if(bScientific){
+    ofFile.unsetf(std::ios::fixed);
+    ofFile.setf(std::ios::scientific);
   }
   else{
-    char *cBuffer=new char[nGammaLaw+1];
-    ifFile.read(cBuffer,nGammaLaw*sizeof(char));
-    cBuffer[nGammaLaw]='\0';
-    sEOSTable=cBuffer;
-    delete [] cBuffer;
-    
-    if(sEOSFile!=""){//overwrite sEOSTable if sEOSFile is set
-      sEOSTable=sEOSFile;
-    }
-    
-    //set the exe directory
-    setExeDir();
-    
-    //test to see if it is relative to the execuatable directory
-    std::string sTemp;
-    if (sEOSTable.substr(0,1)!="/" && sEOSTable.substr(0,2)!="./"){
-      
-      //if relative to executable directory 
-      sTemp=sExeDir+"/"+sEOSTable;
-    }
-    else{
-      sTemp=sEOSTable;
-    }
-    
-    eosTable.readBin(sTemp);
+    ofFile.unsetf(std::ios::scientific);
+    ofFile.setf(std::ios::fixed);
   }
   
-  //read in artificial viscosity
-  double dA;
-  ifFile.read((char*)(&dA),sizeof(double));
-  
-  //read in artificial viscosity threshold
-  double dAVThreshold;
-  ifFile.read((char*)(&dAVThreshold),sizeof(double));
-  
-  //read in global grid size
-  int nSizeGlobe[3];
-  ifFile.read((char*)(nSizeGlobe),3*sizeof(int));
-  
-  //read in periodicity
-  int nPeriodic[3];
-  ifFile.read((char*)(nPeriodic),3*sizeof(int));
-  
-  //read in number of 1D Zones
-  int nNum1DZones;
-  ifFile.read((char*)(&nNum1DZones),sizeof(int));
-  
-  //read in number of ghostcells
-  int nNumGhostCells;
-  ifFile.read((char*)(&nNumGhostCells),sizeof(int));
-  
-  //read in number of grid variables
-  int nNumVars;
-  ifFile.read((char*)(&nNumVars),sizeof(int));
-  
-  //get variable info, and set grid sizes
-  int **nSize=new int*[nNumVars];
-  int **nVarInfo=new int*[nNumVars];
-  int l;
-  for(int n=0;n<nNumVars;n++){
-    nSize[n]=new int[3];
-    nVarInfo[n]=new int[3];
-    ifFile.read((char*)(nVarInfo[n]),(4)*sizeof(int));
-    for(l=0;l<3;l++){
-      if(nSizeGlobe[l]==1){
-        nVarInfo[n][l]=-1;
-      }
-      if(nVarInfo[n][l]==-1){//variable not defined in direction l
-        nSize[n][l]=1;
-      }
-      else if(nVarInfo[n][l]==1&&l==0){//interface variable
-        nSize[n][l]=nSizeGlobe[l]+1;
-      }
-      else{
-        nSize[n][l]=nSizeGlobe[l];
-      }
-    }
-  }
-  
-  //figure out number of dimensions
-  int nNumDims=0;
-  if(nSizeGlobe[0]>1){
-    nNumDims++;
-  }
-  if(nSizeGlobe[1]>1){
-    nNumDims++;
-  }
-  if(nSizeGlobe[2]>1){
-    nNumDims++;
+  //write out header to profile file
+  int nWidthOutputField=25;
+  int nWidthIntOutputField=12;
+  ofFile<<"time= "<<dTime<<" [s]"<<std::endl;
+  ofFile<<std::setw(nWidthIntOutputField)<<"Zone_#(1)"
+    <<std::setw(nWidthOutputField)<<"M_r_im1half[g](2)"
+    <<std::setw(nWidthOutputField)<<"DM_r[g](3)"
+    <<std::setw(nWidthOutputField)<<"ErrorDM_r(4)"
+    <<std::setw(nWidthOutputField)<<"R_im1half[cm](5)"
+    <<std::setw(nWidthOutputField)<<"R_ip1half[cm](6)"
+    <<std::setw(nWidthOutputField)<<"<D>[g/cm^3](7)"
+    <<std::setw(nWidthOutputField)<<"D_max[g/cm^3](8)"
+    <<std::setw(nWidthIntOutputField)<<"D_max_j(9)"
+    <<std::setw(nWidthIntOutputField)<<"D_max_k(10)"
+    <<std::setw(nWidthOutputField)<<"D_min[g/cm^3](11)"
+    <<std::setw(nWidthIntOutputField)<<"D_min_j(12)"
+    <<std::setw(nWidthIntOutputField)<<"D_min_k(13)"
+    <<std::setw(nWidthOutputField)<<"U_ave_im1half[cm/s](14)"
+    <<std::setw(nWidthOutputField)<<"U_max_im1half[cm/s](15)"
+    <<std::setw(nWidthIntOutputField)<<"U_max_j(16)"
+    <<std::setw(nWidthIntOutputField)<<"U_max_k(17)"
+    <<std::setw(nWidthOutputField)<<"U_min_im1half[cm/s](18)"
+    <<std::setw(nWidthIntOutputField)<<"U_min_j(19)"
+    <<std::setw(nWidthIntOutputField)<<"U_min_k(20)"
+    <<std::setw(nWidthOutputField)<<"U0[cm/s](21)"
+    <<std::setw(nWidthOutputField)<<"V_ave[cm/s](22)"
+    <<std::setw(nWidthOutputField)<<"V_max[cm/s](23)"
+    <<std::setw(nWidthIntOutputField)<<"V_max_j(24)"
+    <<std::setw(nWidthIntOutputField)<<"V_max_k(25)"
+    <<std::setw(nWidthOutputField)<<"V_min[cm/s](26)"
+    <<std::setw(nWidthIntOutputField)<<"V_min_j(27)"
+    <<std::setw(nWidthIntOutputField)<<"V_min_k(28)"
+    <<std::setw(nWidthOutputField)<<"W_ave[cm/s](29)"
+    <<std::setw(nWidthOutputField)<<"W_max[cm/s](30)"
+    <<std::setw(nWidthIntOutputField)<<"W_max_j(31)"
+    <<std::setw(nWidthIntOutputField)<<"W_max_k(32)"
+    <<std::setw(nWidthOutputField)<<"W_min[cm/s](33)"
+    <<std::setw(nWidthIntOutputField)<<"W_min_j(34)"
+    <<std::setw(nWidthIntOutputField)<<"W_min_k(35)"
+    <<std::setw(nWidthOutputField)<<"Q[dynes/cm^2](36)"
+    <<std::setw(nWidthOutputField)<<"Q_max[dynes/cm^2](37)"
+    <<std::setw(nWidthIntOutputField)<<"Q_max_j(38)"
+    <<std::setw(nWidthIntOutputField)<<"Q_max_k(39)"
+    <<std::setw(nWidthOutputField)<<"Q_min[dynes/cm^2](40)"
+    <<std::setw(nWidthIntOutputField)<<"Q_min_j(41)"
+    <<std::setw(nWidthIntOutputField)<<"Q_min_k(42)"
+    <<std::setw(nWidthOutputField)<<"E_ave[erg/g](43)"
+    <<std::setw(nWidthOutputField)<<"E_max[erg/g](44)"
+    <<std::setw(nWidthIntOutputField)<<"E_max_j(45)"
+    <<std::setw(nWidthIntOutputField)<<"E_max_k(46)"
+    <<std::setw(nWidthOutputField)<<"E_min[erg/g](47)"
+    <<std::setw(nWidthIntOutputField)<<"E_min_j(48)"
+    <<std::setw(nWidthIntOutputField)<<"E_min_k(49)"
+    <<std::setw(nWidthOutputField)<<"T_ave[K](50)"
+    <<std::setw(nWidthOutputField)<<"T_max[K](51)"
+    <<std::setw(nWidthIntOutputField)<<"T_max_j(52)"
+    <<std::setw(nWidthIntOutputField)<<"T_max_k(53)"
+    <<std::setw(nWidthOutputField)<<"T_min[K](54)"
+    <<std::setw(nWidthIntOutputField)<<"T_min_j(55)"
+    <<std::setw(nWidthIntOutputField)<<"T_min_k(56)"
+    <<std::setw(nWidthOutputField)<<"Kap_ave[cm^2/g](57)"
+    <<std::setw(nWidthOutputField)<<"Kap_min[cm^2/g](58)"
+    <<std::setw(nWidthOutputField)<<"Kap_max[cm^2/g](59)"
+    <<std::setw(nWidthOutputField)<<"L_rd_im1half[L_sun](60)"
+    <<std::setw(nWidthOutputField)<<"L_cv_im1half[L_sun](61)"
+    <<std::setw(nWidthOutputField)<<"F_cv_ave[L_sun/cm^2](62)"
+    <<std::setw(nWidthOutputField)<<"F_cv_max[L_sun/cm^2](63)"
+    <<std::setw(nWidthOutputField)<<"F_cv_min[L_sun/cm^2](64)"
+    <<std::setw(nWidthOutputField)<<"KEP[ergs](65)"
+    <<std::setw(nWidthOutputField)<<"KETot[ergs](66)"
+    <<std::setw(nWidthOutputField)<<"P_ave[dynes/cm^2](67)"
+    <<std::setw(nWidthOutputField)<<"P_min[dynes/cm^2](68)"
+    <<std::setw(nWidthOutputField)<<"P_max[dynes/cm^2](69)"
+    <<std::setw(nWidthOutputField)<<"Gam_ave[na](70)"
+    <<std::setw(nWidthOutputField)<<"Gam_min[na](71)"
+    <<std::setw(nWidthOutputField)<<"Gam_max[na](72)"
+    <<std::setw(nWidthOutputField)<<"C_ave[cm/s](73)"
+    <<std::setw(nWidthOutputField)<<"C_max[cm/s](74)"
+    <<std::setw(nWidthIntOutputField)<<"C_max_j(75)"
+    <<std::setw(nWidthIntOutputField)<<"C_max_k(76)"
+    <<std::setw(nWidthOutputField)<<"C_min[cm/s](77)"
+    <<std::setw(nWidthIntOutputField)<<"C_min_j(78)"
+    <<std::setw(nWidthIntOutputField)<<"C_min_k(79)"
+    <<std::setw(nWidthOutputField)<<"UpFillFac(80)";
+  if(bExtraInfoInProfile){
+    ofFile<<std::setw(nWidthOutputField)<<"DlnPDlnT(81)"
+      <<std::setw(nWidthOutputField)<<"DlnPDlnRho(82)"
+      <<std::setw(nWidthOutputField)<<"DEDT(83)";
   }
+  ofFile<<std::endl;
   
-  //set variable indices
-  int nNumIntVars=0;
-  if(nGammaLaw==0){//using gamma law gas
-    if(nNumDims==1){
-      nNumIntVars=5;
-      nM=0;
-      nDM=1;
-      nR=2;
-      nD=3;
-      nU=4;
-      nU0=5;
-      nE=6;
-      nP=nNumVars+0;
-      nQ=nNumVars+1;
-      nKEP=nNumVars+2;
-      nC=nNumVars+3;
-      nKETot=nNumVars+4;
-      nV=-1;
-      nW=-1;
-      nT=-1;
-      nTheta=-1;
-      nPhi=-1;
-      nKappa=-1;
-      nGamma=-1;
-    }
-    else if(nNumDims==2){
-      nNumIntVars=5;
-      nM=0;
-      nTheta=1;
-      nDM=2;
-      nR=3;
-      nD=4;
-      nU=5;
-      nU0=6;
-      nV=7;
-      nE=8;
-      nP=nNumVars+0;
-      nQ=nNumVars+1;
-      nKEP=nNumVars+2;
-      nC=nNumVars+3;
-      nKETot=nNumVars+4;
-      nW=-1;
-      nT=-1;
-      nPhi=-1;
-      nKappa=-1;
-      nGamma=-1;
+  //write out profile
+  double dErrorDM_r;
+  for(int i=0;i<nSizeGlobe[0]+2*nNumGhostCells;i++){
+    
+    //calculate mass error
+    dErrorDM_r=(4.0/3.0*dPi*dAve[nD][i]*(pow(dGrid[nR][i+1][0][0],3.0)
+      -pow(dGrid[nR][i][0][0],3.0))-dGrid[nDM][i][0][0])/dGrid[nDM][i][0][0];
+    double dDlnPDlnT;
+    double dDlnPDlnRho;
+    double dDEDT;
+    eosTable.getDlnPDlnTDlnPDlnPDEDT(dAve[nT][i],dAve[nD][i],dDlnPDlnT,dDlnPDlnRho,dDEDT);
+    
+    nMaxJIndex[nP][i]=0;
+    nMaxKIndex[nP][i]=0;
+    nMinJIndex[nP][i]=0;
+    nMinKIndex[nP][i]=0;
+    
+    ofFile<<std::setw(nWidthIntOutputField)<<i//1
+      <<std::setw(nWidthOutputField)<<dGrid[nM][i][0][0]//2
+      <<std::setw(nWidthOutputField)<<dGrid[nDM][i][0][0]//3
+      <<std::setw(nWidthOutputField)<<dErrorDM_r//4
+      <<std::setw(nWidthOutputField)<<dGrid[nR][i][0][0]//5
+      <<std::setw(nWidthOutputField)<<dGrid[nR][i+1][0][0]//6
+      <<std::setw(nWidthOutputField)<<dAve[nD][i]//7
+      <<std::setw(nWidthOutputField)<<dMax[nD][i]//8
+      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nD][i]//9
+      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nD][i]//10
+      <<std::setw(nWidthOutputField)<<dMin[nD][i]//11
+      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nD][i]//12
+      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nD][i]//13
+      <<std::setw(nWidthOutputField)<<dAve[nU][i]//14
+      <<std::setw(nWidthOutputField)<<dMax[nU][i]//15
+      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nU][i]//16
+      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nU][i]//17
+      <<std::setw(nWidthOutputField)<<dMin[nU][i]//18
+      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nU][i]//19
+      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nU][i]//20
+      <<std::setw(nWidthOutputField)<<dGrid[nU0][i][0][0];//21
+    if(nNumDims>1){
+      ofFile
+        <<std::setw(nWidthOutputField)<<dAve[nV][i]//22
+        <<std::setw(nWidthOutputField)<<dMax[nV][i]//23
+        <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nV][i]//24
+        <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nV][i]//25
+        <<std::setw(nWidthOutputField)<<dMin[nV][i]//26
+        <<std::setw(nWidthIntOutputField)<<nMinJIndex[nV][i]//27
+        <<std::setw(nWidthIntOutputField)<<nMinKIndex[nV][i];//28
     }
-    else if(nNumDims==3){
-      nNumIntVars=5;
-      nM=0;
-      nTheta=1;
-      nPhi=2;
-      nDM=3;
-      nR=4;
-      nD=5;
-      nU=6;
-      nU0=7;
-      nV=8;
-      nW=9;
-      nE=10;
-      nP=nNumVars+0;
-      nQ=nNumVars+1;
-      nKEP=nNumVars+2;
-      nC=nNumVars+3;
-      nKETot=nNumVars+4;
-      nT=-1;
-      nKappa=-1;
-      nGamma=-1;
+    else{
+      ofFile
+        <<std::setw(nWidthOutputField)<<"-"//22
+        <<std::setw(nWidthOutputField)<<"-"//23
+        <<std::setw(nWidthIntOutputField)<<"-"//24
+        <<std::setw(nWidthIntOutputField)<<"-"//25
+        <<std::setw(nWidthOutputField)<<"-"//26
+        <<std::setw(nWidthIntOutputField)<<"-"//27
+        <<std::setw(nWidthIntOutputField)<<"-";//28
     }
-  }
-  else{//using a tabulated equation of state
-    if(nNumDims==1){
-      nNumIntVars=11;
-      nM=0;
-      nDM=1;
-      nR=2;
-      nD=3;
-      nU=4;
-      nU0=5;
-      nT=6;
-      nE=nNumVars+0;
-      nQ=nNumVars+1;
-      nP=nNumVars+2;
-      nKappa=nNumVars+3;
-      nGamma=nNumVars+4;
-      nL_rad=nNumVars+5;
-      nL_con=nNumVars+6;
-      nF_con=nNumVars+7;
-      nKEP=nNumVars+8;
-      nC=nNumVars+9;
-      nKETot=nNumVars+10;
-      nV=-1;
-      nW=-1;
-      nTheta=-1;
-      nPhi=-1;
-    }
-    else if(nNumDims==2){
-      nNumIntVars=11;
-      nM=0;
-      nTheta=1;
-      nDM=2;
-      nR=3;
-      nD=4;
-      nU=5;
-      nU0=6;
-      nV=7;
-      nT=8;
-      nE=nNumVars+0;
-      nQ=nNumVars+1;
-      nP=nNumVars+2;
-      nKappa=nNumVars+3;
-      nGamma=nNumVars+4;
-      nL_rad=nNumVars+5;
-      nL_con=nNumVars+6;
-      nF_con=nNumVars+7;
-      nKEP=nNumVars+8;
-      nC=nNumVars+9;
-      nKETot=nNumVars+10;
-      nPhi=-1;
-      nW=-1;
-    }
-    else if(nNumDims==3){
-      nNumIntVars=11;
-      nM=0;
-      nTheta=1;
-      nPhi=2;
-      nDM=3;
-      nR=4;
-      nD=5;
-      nU=6;
-      nU0=7;
-      nV=8;
-      nW=9;
-      nT=10;
-      nE=nNumVars+0;
-      nQ=nNumVars+1;
-      nP=nNumVars+2;
-      nKappa=nNumVars+3;
-      nGamma=nNumVars+4;
-      nL_rad=nNumVars+5;
-      nL_con=nNumVars+6;
-      nF_con=nNumVars+7;
-      nKEP=nNumVars+8;
-      nC=nNumVars+9;
-      nKETot=nNumVars+10;
-    }
-  }
-  
-  //read in grid
-  double ****dGrid=new double***[nNumVars];
-  int nGhostCellsX;
-  int nGhostCellsY;
-  int nGhostCellsZ;
-  int nSizeX1;
-  int nSizeX2;
-  int nStartY;
-  int nEndY;
-  int nSizeY;
-  int nStartZ;
-  int nEndZ;
-  int nSizeZ;
-  int i;
-  int j;
-  int k;
-  double *dTempArray;
-  double dSum;
-  int nCount;
-  for(int n=0;n<nNumVars;n++){
-    
-    nGhostCellsX=1;
-    if(nVarInfo[n][0]==-1){
-      nGhostCellsX=0;
-    }
-    nGhostCellsY=1;
-    if(nVarInfo[n][1]==-1){
-      nGhostCellsY=0;
+    if(nNumDims>2){
+      ofFile
+        <<std::setw(nWidthOutputField)<<dAve[nW][i]//29
+        <<std::setw(nWidthOutputField)<<dMax[nW][i]//30
+        <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nW][i]//31
+        <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nW][i]//32
+        <<std::setw(nWidthOutputField)<<dMin[nW][i]//33
+        <<std::setw(nWidthIntOutputField)<<nMinJIndex[nW][i]//34
+        <<std::setw(nWidthIntOutputField)<<nMinKIndex[nW][i];//35
     }
-    nGhostCellsZ=1;
-    if(nVarInfo[n][2]==-1){
-      nGhostCellsZ=0;
+    else{
+      ofFile
+        <<std::setw(nWidthOutputField)<<"-"//29
+        <<std::setw(nWidthOutputField)<<"-"//30
+        <<std::setw(nWidthIntOutputField)<<"-"//31
+        <<std::setw(nWidthIntOutputField)<<"-"//32
+        <<std::setw(nWidthOutputField)<<"-"//33
+        <<std::setw(nWidthIntOutputField)<<"-"//34
+        <<std::setw(nWidthIntOutputField)<<"-";//35
     }
-    
-    //make some space to hold the variables
-    dGrid[n]=new double**[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    
-    //read in 1D part of the grid
-    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);//may be need to +1 if only one proc and variable in interface centered
-    if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
-      nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
+    ofFile
+      <<std::setw(nWidthOutputField)<<dAve[nQ][i]//36
+      <<std::setw(nWidthOutputField)<<dMax[nQ][i]//37
+      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nQ][i]//38
+      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nQ][i]//39
+      <<std::setw(nWidthOutputField)<<dMin[nQ][i]//40
+      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nQ][i]//41
+      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nQ][i];//42
+    ofFile
+      <<std::setw(nWidthOutputField)<<dAve[nE][i]//43
+      <<std::setw(nWidthOutputField)<<dMax[nE][i]//44
+      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nE][i]//45
+      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nE][i]//46
+      <<std::setw(nWidthOutputField)<<dMin[nE][i]//47
+      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nE][i]//48
+      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nE][i];//49
+    if(nGammaLaw==0){
+      ofFile
+        <<std::setw(nWidthOutputField)<<"-"//50
+        <<std::setw(nWidthOutputField)<<"-"//51
+        <<std::setw(nWidthIntOutputField)<<"-"//52
+        <<std::setw(nWidthIntOutputField)<<"-"//53
+        <<std::setw(nWidthOutputField)<<"-"//54
+        <<std::setw(nWidthIntOutputField)<<"-"//55
+        <<std::setw(nWidthIntOutputField)<<"-"//56
+        <<std::setw(nWidthOutputField)<<"-"//57
+        <<std::setw(nWidthOutputField)<<"-"//58
+        <<std::setw(nWidthOutputField)<<"-"//59
+        <<std::setw(nWidthOutputField)<<"-"//60
+        <<std::setw(nWidthOutputField)<<"-";//61
     }
-    nSizeY=1;
-    nSizeZ=1;
-    for(i=0;i<nSizeX1;i++){
-      dGrid[n][i]=new double*[nSizeY];
-      for(j=0;j<nSizeY;j++){
-        dGrid[n][i][j]=new double[nSizeZ];
-        ifFile.read((char*)(dGrid[n][i][j]),nSizeZ*sizeof(double));
+    else{
+      ofFile
+        <<std::setw(nWidthOutputField)<<dAve[nT][i]//50
+        <<std::setw(nWidthOutputField)<<dMax[nT][i]//51
+        <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nT][i]//52
+        <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nT][i]//53
+        <<std::setw(nWidthOutputField)<<dMin[nT][i]//54
+        <<std::setw(nWidthIntOutputField)<<nMinJIndex[nT][i]//55
+        <<std::setw(nWidthIntOutputField)<<nMinKIndex[nT][i]//56
+        <<std::setw(nWidthOutputField)<<dAve[nKappa][i]//57
+        <<std::setw(nWidthOutputField)<<dMax[nKappa][i]//58
+        <<std::setw(nWidthOutputField)<<dMin[nKappa][i];//59
+      if(i!=0){
+        ofFile
+          <<std::setw(nWidthOutputField)<<dAve[nL_rad][i-1]/dLSun//60
+          <<std::setw(nWidthOutputField)<<dAve[nL_con][i-1]/dLSun//61
+          <<std::setw(nWidthOutputField)<<dAve[nF_con][i-1]/dLSun//62
+          <<std::setw(nWidthOutputField)<<dMax[nF_con][i-1]/dLSun//63
+          <<std::setw(nWidthOutputField)<<dMin[nF_con][i-1]/dLSun;//64
       }
-    }
-    
-    //read in the rest of the grid
-    nSizeX2=nSize[n][0]+nGhostCellsX*2*nNumGhostCells;
-    nSizeY=nSize[n][1]+nGhostCellsY*2*nNumGhostCells;//assume y and z are always periodic
-    nSizeZ=nSize[n][2]+nGhostCellsZ*2*nNumGhostCells;
-    for(i=nSizeX1;i<nSizeX2;i++){
-      dGrid[n][i]=new double*[nSizeY];
-      for(j=0;j<nSizeY;j++){
-        dGrid[n][i][j]=new double[nSizeZ];
-        ifFile.read((char*)(dGrid[n][i][j]),nSizeZ*sizeof(double));
+      else{//luminosity not defined at inner interface
+        ofFile
+          <<std::setw(nWidthOutputField)<<"-"//60
+          <<std::setw(nWidthOutputField)<<"-"//61
+          <<std::setw(nWidthOutputField)<<"-"//62
+          <<std::setw(nWidthOutputField)<<"-"//63
+          <<std::setw(nWidthOutputField)<<"-";//64
       }
     }
-  }
-  ifFile.close();
-  
-  //radialize the grid
-  double **dMax=new double*[nNumVars+nNumIntVars];
-  double **dMin=new double*[nNumVars+nNumIntVars];
-  double **dAve=new double*[nNumVars+nNumIntVars];
-  int **nMaxJIndex=new int*[nNumVars+nNumIntVars];
-  int **nMaxKIndex=new int*[nNumVars+nNumIntVars];
-  int **nMinJIndex=new int*[nNumVars+nNumIntVars];
-  int **nMinKIndex=new int*[nNumVars+nNumIntVars];
-  double dMaxTemp;
-  double dMinTemp;
-  for(int n=0;n<nNumVars;n++){
-    
-    nGhostCellsX=1;
-    if(nVarInfo[n][0]==-1){
-      nGhostCellsX=0;
-    }
-    nGhostCellsY=1;
-    if(nVarInfo[n][1]==-1){
-      nGhostCellsY=0;
-    }
-    nGhostCellsZ=1;
-    if(nVarInfo[n][2]==-1){
-      nGhostCellsZ=0;
-    }
-    
-    //make some space to hold max,min and average
-    dMax[n]=new double[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    dMin[n]=new double[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    dAve[n]=new double[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    
-    nMaxJIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    nMaxKIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    nMinJIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    nMinKIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    
-    //read in 1D part of the grid
-    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);//may be need to +1 if only one proc and variable in interface centred
-    if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
-      nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
-    }
-    nSizeY=1;
-    nSizeZ=1;
-    for(i=0;i<nSizeX1;i++){
-      //find average max, and min
-      dMax[n][i]=dGrid[n][i][0][0];
-      dMin[n][i]=dGrid[n][i][0][0];
-      dAve[n][i]=dGrid[n][i][0][0];
-      nMaxJIndex[n][i]=0;
-      nMaxKIndex[n][i]=0;
-      nMinJIndex[n][i]=0;
-      nMinKIndex[n][i]=0;
-    }
-    
-    //read in the rest of the grid
-    nSizeX2=nSize[n][0]+nGhostCellsX*2*nNumGhostCells;
-    nSizeY=nSize[n][1]+nGhostCellsY*2*nNumGhostCells;
-    nSizeZ=nSize[n][2]+nGhostCellsZ*2*nNumGhostCells;
-    nStartY=nGhostCellsY*nNumGhostCells;
-    nEndY=nSize[n][1]+nStartY;
-    nStartZ=nGhostCellsZ*nNumGhostCells;
-    nEndZ=nSize[n][2]+nStartZ;
-    for(i=nSizeX1;i<nSizeX2;i++){
-      dMaxTemp=-1.0*std::numeric_limits<double>::max();
-      dMinTemp=std::numeric_limits<double>::max();
-      dSum=0.0;
-      nCount=0;
-      for(j=nStartY;j<nEndY;j++){
-        for(k=nStartZ;k<nEndZ;k++){
-          //find average max, and min
-          if(dGrid[n][i][j][k]>dMaxTemp){
-            dMaxTemp=dGrid[n][i][j][k];
-            nMaxJIndex[n][i]=j;
-            nMaxKIndex[n][i]=k;
-          }
-          if(dGrid[n][i][j][k]<dMinTemp){
-            dMinTemp=dGrid[n][i][j][k];
-            nMinJIndex[n][i]=j;
-            nMinKIndex[n][i]=k;
-          }
-          dSum+=dGrid[n][i][j][k];
-          nCount++;
-        }
-      }
-      dMax[n][i]=dMaxTemp;
-      dMin[n][i]=dMinTemp;
-      dAve[n][i]=dSum/double(nCount);
+    ofFile
+      <<std::setw(nWidthOutputField)<<dAve[nKEP][i]//65
+      <<std::setw(nWidthOutputField)<<dAve[nKETot][i]//66
+      <<std::setw(nWidthOutputField)<<dAve[nP][i]//67
+      <<std::setw(nWidthOutputField)<<dMax[nP][i]//68
+      <<std::setw(nWidthOutputField)<<dMin[nP][i]//69
+      <<std::setw(nWidthOutputField)<<dAve[nGamma][i]//70
+      <<std::setw(nWidthOutputField)<<dMax[nGamma][i]//71
+      <<std::setw(nWidthOutputField)<<dMin[nGamma][i]//72
+      <<std::setw(nWidthOutputField)<<dAve[nC][i]//73
+      <<std::setw(nWidthOutputField)<<dMax[nC][i]//74
+      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nC][i]//75
+      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nC][i]//76
+      <<std::setw(nWidthOutputField)<<dMin[nC][i]//77
+      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nC][i]//78
+      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nC][i]//79
+      <<std::setw(nWidthOutputField)<<dUpFlowFillingFactor[i];//80
+    if(bExtraInfoInProfile){
+      ofFile<<std::setw(nWidthOutputField)<<dDlnPDlnT//81
+        <<std::setw(nWidthOutputField)<<dDlnPDlnRho//82
+        <<std::setw(nWidthOutputField)<<dDEDT;//83
     }
+    ofFile<<std::endl;
   }
-  
-  //allocate space for internal variables
-  for(int n=nNumVars;n<nNumVars+nNumIntVars;n++){
-    dMax[n]=new double[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
-    dMin[n]=new double[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
-    dAve[n]=new double[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
-    nMaxJIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
-    nMaxKIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
-    nMinJIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
-    nMinKIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
+  ofFile
+    <<std::setw(nWidthIntOutputField)<<(nSizeGlobe[0]+2*nNumGhostCells)//1
+    <<std::setw(nWidthOutputField)<<dGrid[nM][nSizeGlobe[0]+2*nNumGhostCells][0][0]//2
+    <<std::setw(nWidthOutputField)<<"-"//3
+    <<std::setw(nWidthOutputField)<<"-"//4
+    <<std::setw(nWidthOutputField)<<dGrid[nR][nSizeGlobe[0]+2*nNumGhostCells][0][0]//5
+    <<std::setw(nWidthOutputField)<<"-"//6
+    <<std::setw(nWidthOutputField)<<"-"//7
+    <<std::setw(nWidthOutputField)<<"-"//8
+    <<std::setw(nWidthIntOutputField)<<"-"//9
+    <<std::setw(nWidthIntOutputField)<<"-"//10
+    <<std::setw(nWidthOutputField)<<"-"//11
+    <<std::setw(nWidthIntOutputField)<<"-"//12
+    <<std::setw(nWidthIntOutputField)<<"-"//13
+    <<std::setw(nWidthOutputField)<<dAve[nU][nSizeGlobe[0]+2*nNumGhostCells]//14
+    <<std::setw(nWidthOutputField)<<dMax[nU][nSizeGlobe[0]+2*nNumGhostCells]//15
+    <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nU][nSizeGlobe[0]+2*nNumGhostCells]//16
+    <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nU][nSizeGlobe[0]+2*nNumGhostCells]//17
+    <<std::setw(nWidthOutputField)<<dMin[nU][nSizeGlobe[0]+2*nNumGhostCells]//18
+    <<std::setw(nWidthIntOutputField)<<nMinJIndex[nU][nSizeGlobe[0]+2*nNumGhostCells]//19
+    <<std::setw(nWidthIntOutputField)<<nMinKIndex[nU][nSizeGlobe[0]+2*nNumGhostCells]//20
+    <<std::setw(nWidthOutputField)<<dAve[nU0][nSizeGlobe[0]+2*nNumGhostCells]//21
+    <<std::setw(nWidthOutputField)<<"-"//22
+    <<std::setw(nWidthOutputField)<<"-"//23
+    <<std::setw(nWidthIntOutputField)<<"-"//24
+    <<std::setw(nWidthIntOutputField)<<"-"//25
+    <<std::setw(nWidthOutputField)<<"-"//26
+    <<std::setw(nWidthIntOutputField)<<"-"//27
+    <<std::setw(nWidthIntOutputField)<<"-"//28
+    <<std::setw(nWidthOutputField)<<"-"//29
+    <<std::setw(nWidthOutputField)<<"-"//30
+    <<std::setw(nWidthIntOutputField)<<"-"//31
+    <<std::setw(nWidthIntOutputField)<<"-"//32
+    <<std::setw(nWidthOutputField)<<"-"//33
+    <<std::setw(nWidthIntOutputField)<<"-"//34
+    <<std::setw(nWidthIntOutputField)<<"-"//35
+    <<std::setw(nWidthOutputField)<<"-"//36
+    <<std::setw(nWidthOutputField)<<"-"//37
+    <<std::setw(nWidthIntOutputField)<<"-"//38
+    <<std::setw(nWidthIntOutputField)<<"-"//39
+    <<std::setw(nWidthOutputField)<<"-"//40
+    <<std::setw(nWidthIntOutputField)<<"-"//41
+    <<std::setw(nWidthIntOutputField)<<"-"//42
+    <<std::setw(nWidthOutputField)<<"-"//43
+    <<std::setw(nWidthOutputField)<<"-"//44
+    <<std::setw(nWidthIntOutputField)<<"-"//45
+    <<std::setw(nWidthIntOutputField)<<"-"//46
+    <<std::setw(nWidthOutputField)<<"-"//47
+    <<std::setw(nWidthIntOutputField)<<"-"//48
+    <<std::setw(nWidthIntOutputField)<<"-"//49
+    <<std::setw(nWidthOutputField)<<"-"//50
+    <<std::setw(nWidthOutputField)<<"-"//51
+    <<std::setw(nWidthIntOutputField)<<"-"//52
+    <<std::setw(nWidthIntOutputField)<<"-"//53
+    <<std::setw(nWidthOutputField)<<"-"//54
+    <<std::setw(nWidthIntOutputField)<<"-"//55
+    <<std::setw(nWidthIntOutputField)<<"-"//56
+    <<std::setw(nWidthOutputField)<<"-"//57
+    <<std::setw(nWidthOutputField)<<"-"//58
+    <<std::setw(nWidthOutputField)<<"-"//59
+    <<std::setw(nWidthOutputField)<<dAve[nL_rad][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//60
+    <<std::setw(nWidthOutputField)<<dAve[nL_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//61
+    <<std::setw(nWidthOutputField)<<dAve[nF_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//62
+    <<std::setw(nWidthOutputField)<<dMax[nF_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//63
+    <<std::setw(nWidthOutputField)<<dMin[nF_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//64
+    <<std::setw(nWidthOutputField)<<"-"//65
+    <<std::setw(nWidthOutputField)<<"-"//66
+    <<std::setw(nWidthOutputField)<<"-"//67
+    <<std::setw(nWidthOutputField)<<"-"//68
+    <<std::setw(nWidthOutputField)<<"-"//69
+    <<std::setw(nWidthOutputField)<<"-"//70
+    <<std::setw(nWidthOutputField)<<"-"//71
+    <<std::setw(nWidthOutputField)<<"-"//72
+    <<std::setw(nWidthOutputField)<<"-"//73
+    <<std::setw(nWidthOutputField)<<"-"//74
+    <<std::setw(nWidthIntOutputField)<<"-"//75
+    <<std::setw(nWidthIntOutputField)<<"-"//76
+    <<std::setw(nWidthOutputField)<<"-"//77
+    <<std::setw(nWidthIntOutputField)<<"-"//78
+    <<std::setw(nWidthIntOutputField)<<"-"//79
+    <<std::setw(nWidthOutputField)<<dUpFlowFillingFactor[nSizeGlobe[0]+2*nNumGhostCells];//80
+  if(bExtraInfoInProfile){
+    ofFile<<std::setw(nWidthOutputField)<<"-"//81
+      <<std::setw(nWidthOutputField)<<"-"//82
+      <<std::setw(nWidthOutputField)<<"-";//83
   }
+  ofFile<<std::endl;
   
-  //calculate filling factor for upflow
-  nGhostCellsX=1;
-  if(nVarInfo[nU][0]==-1){
-    nGhostCellsX=0;
-  }
-  nGhostCellsY=1;
-  if(nVarInfo[nU][1]==-1){
-    nGhostCellsY=0;
-  }
-  nGhostCellsZ=1;
-  if(nVarInfo[nU][2]==-1){
-    nGhostCellsZ=0;
-  }
-  nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);
-  if (nVarInfo[nU][0]==1&&nPeriodic[0]==0){
-    nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
-  }
-  nSizeX2=nSize[nU][0]+nGhostCellsX*2*nNumGhostCells;
-  nSizeY=nSize[nU][1]+nGhostCellsY*2*nNumGhostCells;
-  nSizeZ=nSize[nU][2]+nGhostCellsZ*2*nNumGhostCells;
-  nStartY=nGhostCellsY*nNumGhostCells;
-  nEndY=nSize[nU][1]+nStartY;
-  nStartZ=nGhostCellsZ*nNumGhostCells;
-  nEndZ=nSize[nU][2]+nStartZ;
-  double *dUpFlowFillingFactor=new double[nSize[nU][0]+nGhostCellsX*2
-    *nNumGhostCells];
-  for(int i=0;i<nSizeX1;i++){
-    dUpFlowFillingFactor[i]=0.0;//no-upflow in 1D part
-  }
-  int nCountUp=0;
-  int nCountTotal=0;
-  for(int i=nSizeX1;i<nSizeX2;i++){
-    for(int j=nStartY;j<nEndY;j++){
-      for(int k=nStartZ;k<nEndZ;k++){
-        
-        //if there is an up-flow (removing flow due to pulsation)
-        if(dGrid[nU][i][j][k]-dGrid[nU0][i][0][0]>0.0){
-          nCountUp++;
-        }
-        nCountTotal++;
-      }
-    }
-    
-    //record filling factor, and reset counts
-    dUpFlowFillingFactor[i]=double(nCountUp)/double(nCountTotal);
-    nCountUp=0;
-    nCountTotal=0;
-  }
+  ofFile.close();
   
-  if(nGammaLaw!=0){//set P,E,kappa,gamma, Q, L_rad and L_con, KE, C, <rho>
-    
-    //allocate space
-    nGhostCellsX=1;
-    if(nVarInfo[nD][0]==-1){/*all internal variables are centred quantities, will be the same as 
-      the density*/
-      nGhostCellsX=0;
-    }
-    nGhostCellsY=1;
-    if(nVarInfo[nD][1]==-1){
-      nGhostCellsY=0;
-    }
-    nGhostCellsZ=1;
-    if(nVarInfo[nD][2]==-1){
-      nGhostCellsZ=0;
+  //delete profile statistics, the grid is freed with the dump file
+  freeRadialProfile(profile);
+}
+void makeRadialProfile(dumpFile &dump,int nShellThreads,radialProfile &profile){
+  
+  int nGammaLaw=int(dump.sEOSFileName.size());
+  double dGamma=dump.dGamma;
+  std::string sEOSTable;
+  eos &eosTable=profile.eosTable;
+  if(!dump.bGammaLaw){
+    sEOSTable=dump.sEOSFileName;
+    if(sEOSFile!=""){//overwrite sEOSTable if sEOSFile is set
+      sEOSTable=sEOSFile;
     }
     
-    double dF_con;
-    double dP_i;
-    double dE_i;
-    double dKappa_i;
-    double dGamma_i;
-    double dCp_i;
-    double dCp_ip1;
-    double dCp_ip1half;
-    double dRho_ip1half;
-    double dTAve_i;
-    double dTAve_ip1;
-    double dTAve_ip1half;
-    double dT_ip1halfjk;
-    double dP_ip1;
-    double dE_ip1;
-    double dKappa_ip1;
-    double dKappa_ip1half;
-    double dGamma_ip1;
-    double dQ;
-    double dQ0=0.0;
-    double dQ1=0.0;
-    double dQ2=0.0;
-    double dMaxE;
-    double dMinE;
-    double dSumE;
-    double dMaxP;
-    double dMinP;
-    double dSumP;
-    double dMaxF_con;
-    double dMinF_con;
-    double dSumF_con;
-    double dMaxKappa;
-    double dMinKappa;
-    double dSumKappa;
-    double dMaxGamma;
-    double dMinGamma;
-    double dSumGamma;
-    double dMaxQ;
-    double dMinQ;
-    double dSumQ;
-    double dC;
-    double dMaxC;
-    double dMinC;
-    double dSumC;
-    double dRSq_i;
-    double dA_ip1half;
-    double dA_im1half;
-    double dTheta_j;
-    double dTheta_jp1half;
-    double dTheta_jm1half;
-    double dA_jp1half;
-    double dA_jm1half;
-    double dA_j;
-    double dASq=dA*dA;
-    double dDVDtThreshold;
-    double dDVDt_mthreshold;
-    double dDVDt;
-    double dLSum_rad=0.0;
-    double dLSum_con=0.0;
-    double dAreaSum=0.0;
-    double dR_i;
-    double dRSq_ip1half;
-    double dT4_ip1;
-    double dT4_i;
-    double dArea;
-    double dArea1;
-    double dArea2;
-    double dPhi_kp1half;
-    double dPhi_km1half;
-    double dU_i;
-    double dU_ijk;
-    double dV_ijk;
-    double dW_ijk;
-    double dVSq_ijk;
-    double dKETotSum;
-    double dDMSum;
-    double dDMTemp;
-    
-    //set 1D part of the grid
-    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);/*maybe need to +1 if only one proc and 
-      variable is interface centered*/
-    if (nVarInfo[nD][0]==1&&nPeriodic[0]==0){
-      nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
-    }
-    nSizeY=1;
-    nSizeZ=1;
-    for(i=0;i<nSizeX1;i++){//find average max, and min in 1D region
-      
-      //get P,E,Kappa,Gamma
-      eosTable.getPEKappaGamma(dGrid[nT][i][0][0],dGrid[nD][i][0][0],dP_i,dE_i,dKappa_i,dGamma_i);
-      eosTable.getPEKappaGamma(dGrid[nT][i+1][0][0],dGrid[nD][i+1][0][0],dP_ip1,dE_ip1,dKappa_ip1
-        ,dGamma_ip1);
-      
-      //calculate Q
-      dR_i=(dGrid[nR][i+1][0][0]+dGrid[nR][i][0][0])*0.5;
-      dRSq_i=dR_i*dR_i;
-      dA_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
-      dA_im1half=dGrid[nR][i][0][0]*dGrid[nR][i][0][0];
-      dC=sqrt(dGamma_i*dP_i/dGrid[nD][i][0][0]);
-      dDVDtThreshold=dAVThreshold*dC;
-      dDVDt=(dA_ip1half*dGrid[nU][i+1][0][0]
-        -dA_im1half*dGrid[nU][i][0][0])/dRSq_i;
-      if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-        dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-        dQ=dASq*dGrid[nD][i][0][0]*dDVDt_mthreshold*dDVDt_mthreshold;
-      }
-      else{
-        dQ=0.0;
-      }
-      
-      //calculate luminosity from cell and add to sum
-      dLSum_rad=0.0;
-      dArea=dA_ip1half*4.0*dPi;
-      dT4_i=pow(dGrid[nT][i][0][0],4);
-      dT4_ip1=pow(dGrid[nT][i+1][0][0],4);
-      dKappa_ip1half=(dT4_i/dKappa_i+dT4_ip1/dKappa_ip1)
-        /(dT4_i+dT4_ip1);
-      dAve[nL_rad][i]=-16.0*dPi*dSigma*dA_ip1half*dKappa_ip1half
-        /3.0*(dT4_ip1-dT4_i)/(dGrid[nDM][i][0][0]+dGrid[nDM][i+1][0][0])
-        *2.0*dArea;
-      dAve[nL_con][i]=0.0;
-      dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
-      dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
-      dAve[nKETot][i]=dAve[nKEP][i];//nothing but pulsation energy in 1D
-      dMax[nE][i]=dE_i;
-      dMin[nE][i]=dE_i;
-      dAve[nE][i]=dE_i;
-      dMax[nP][i]=dP_i;
-      dMin[nP][i]=dP_i;
-      dAve[nP][i]=dP_i;
-      dMax[nF_con][i]=0.0;
-      dMin[nF_con][i]=0.0;
-      dAve[nF_con][i]=0.0;
-      dMax[nKappa][i]=dKappa_i;
-      dMin[nKappa][i]=dKappa_i;
-      dAve[nKappa][i]=dKappa_i;
-      dMax[nGamma][i]=dGamma_i;
-      dMin[nGamma][i]=dGamma_i;
-      dAve[nGamma][i]=dGamma_i;
-      dMax[nQ][i]=dQ;
-      dMin[nQ][i]=dQ;
-      dAve[nQ][i]=dQ;
-      dMax[nC][i]=dC;
-      dMin[nC][i]=dC;
-      dAve[nC][i]=dC;
-      nMaxJIndex[nP][i]=0;
-      nMaxKIndex[nP][i]=0;
-      nMinJIndex[nP][i]=0;
-      nMinKIndex[nP][i]=0;
-      nMaxJIndex[nE][i]=0;
-      nMaxKIndex[nE][i]=0;
-      nMinJIndex[nE][i]=0;
-      nMinKIndex[nE][i]=0;
-      nMaxJIndex[nKappa][i]=0;
-      nMaxKIndex[nKappa][i]=0;
-      nMinJIndex[nKappa][i]=0;
-      nMinKIndex[nKappa][i]=0;
-      nMaxJIndex[nGamma][i]=0;
-      nMaxKIndex[nGamma][i]=0;
-      nMinJIndex[nGamma][i]=0;
-      nMinKIndex[nGamma][i]=0;
-      nMaxJIndex[nQ][i]=0;
-      nMaxKIndex[nQ][i]=0;
-      nMinJIndex[nQ][i]=0;
-      nMinKIndex[nQ][i]=0;
-      nMaxJIndex[nC][i]=0;
-      nMaxKIndex[nC][i]=0;
-      nMinJIndex[nC][i]=0;
-      nMinKIndex[nC][i]=0;
-      nMaxJIndex[nL_rad][i]=0;
-      nMaxKIndex[nL_rad][i]=0;
-      nMinJIndex[nL_rad][i]=0;
-      nMinKIndex[nL_rad][i]=0;
-      nMaxJIndex[nKEP][i]=0;
-      nMaxKIndex[nKEP][i]=0;
-      nMinJIndex[nKEP][i]=0;
-      nMinKIndex[nKEP][i]=0;
-      nMaxJIndex[nKETot][i]=0;
-      nMaxKIndex[nKETot][i]=0;
-      nMinJIndex[nKETot][i]=0;
-      nMinKIndex[nKETot][i]=0;
-    }
-    
-    //set the rest of the grid
-    nSizeX2=nSize[nD][0]+nGhostCellsX*2*nNumGhostCells;
-    nSizeY=nSize[nD][1]+nGhostCellsY*2*nNumGhostCells;
-    nSizeZ=nSize[nD][2]+nGhostCellsZ*2*nNumGhostCells;
-    nStartY=nGhostCellsY*nNumGhostCells;
-    nEndY=nSize[nD][1]+nStartY;
-    nStartZ=nGhostCellsZ*nNumGhostCells;
-    nEndZ=nSize[nD][2]+nStartZ;
-    for(i=nSizeX1;i<nSizeX2;i++){
-      dMaxE=-1.0*std::numeric_limits<double>::max();
-      dMinE=std::numeric_limits<double>::max();
-      dSumE=0.0;
-      dMaxP=-1.0*std::numeric_limits<double>::max();
-      dMinP=std::numeric_limits<double>::max();
-      dSumP=0.0;
-      dMaxF_con=-1.0*std::numeric_limits<double>::max();
-      dMinF_con=std::numeric_limits<double>::max();
-      dSumF_con=0.0;
-      dMaxKappa=-1.0*std::numeric_limits<double>::max();
-      dMinKappa=std::numeric_limits<double>::max();
-      dSumKappa=0.0;
-      dMaxGamma=-1.0*std::numeric_limits<double>::max();
-      dMinGamma=std::numeric_limits<double>::max();
-      dSumGamma=0.0;
-      dMaxQ=-1.0*std::numeric_limits<double>::max();
-      dMinQ=std::numeric_limits<double>::max();
-      dSumQ=0.0;
-      dMaxC=-1.0*std::numeric_limits<double>::max();
-      dMinC=std::numeric_limits<double>::max();
-      dSumC=0.0;
-      nCount=0;
-      dR_i=(dGrid[nR][i+1][0][0]+dGrid[nR][i][0][0])*0.5;
-      dRSq_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
-      dRSq_i=dR_i*dR_i;
-      dA_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
-      dA_im1half=dGrid[nR][i][0][0]*dGrid[nR][i][0][0];
-      dLSum_rad=0.0;
-      dLSum_con=0.0;
-      dAreaSum=0.0;
-      dArea1=dRSq_ip1half*4.0*dPi;
-      dKETotSum=0.0;
-      dDMSum=0.0;
-      dDMTemp=dGrid[nDM][i][0][0];//in 1D these are the same
-      
-      //start debug LCon
-      /*
-      double bDebugLCon=false;
-      std::ofstream ofDebugLCon;
-      int nWidthOutputField=25;
-      int nWidthIntOutputField=12;
-      if(i==125 || i==128){
-        bDebugLCon=true;
-        std::stringstream ssDebugFile;
-        ssDebugFile<<"debugLCon_i"<<i<<".txt";
-        std::cout<<ssDebugFile.str().c_str()<<std::endl;
-        ofDebugLCon.open(ssDebugFile.str().c_str());
-        
-        //set double output precision
-        ofDebugLCon.precision(16);
-        ofDebugLCon.unsetf(std::ios::fixed);
-        ofDebugLCon.setf(std::ios::scientific);
-        
-        ofDebugLCon
-          <<std::setw(nWidthIntOutputField)<<"j(0)"
-          <<std::setw(nWidthIntOutputField)<<"k(1)"
-          <<std::setw(nWidthOutputField)<<"dCp_ip1half(2)"
-          <<std::setw(nWidthOutputField)<<"dRho_ip1half(3)"
-          <<std::setw(nWidthOutputField)<<"dT_ip1halfjk(4)"
-          <<std::setw(nWidthOutputField)<<"dTAve_ip1half(5)"
-          <<std::setw(nWidthOutputField)<<"dU_ip1halfjk(6)"
-          <<std::setw(nWidthOutputField)<<"dU0_ip1half(7)"
-          <<std::setw(nWidthOutputField)<<"dA_ip1halfjk(8)"
-          <<std::setw(nWidthOutputField)<<"dLCon_ip1halfjk(9)"<<std::endl;
-      }*/
-      //end debug LCon
-      
-      for(j=nStartY;j<nEndY;j++){
-        
-        if(nNumDims>1){
-          dTheta_jp1half=dGrid[nTheta][0][j][0];
-          if(j==0){
-            dTheta_jm1half=dGrid[nTheta][0][j][0]-(dGrid[nTheta][0][j+1][0]-dGrid[nTheta][0][j][0]);
-          }
-          else{
-            dTheta_jm1half=dGrid[nTheta][0][j-1][0];
-          }
-          dTheta_j=(dTheta_jp1half+dTheta_jm1half)*0.5;
-          dA_jp1half=sin(dTheta_jp1half);
-          dA_jm1half=sin(dTheta_jm1half);
-          dA_j=sin(dTheta_j);
-          dArea2=dArea1/2.0*(cos(dTheta_jm1half)-cos(dTheta_jp1half));
-          dArea=dArea2;
-          dDMTemp=(cos(dTheta_jm1half)-cos(dTheta_jp1half))*dGrid[nD][i][j][0];
-        }
-        
-        for(k=nStartZ;k<nEndZ;k++){
-          if(nNumDims>2){
-            dPhi_kp1half=dGrid[nPhi][0][0][k];
-            if(k==0){
-              dPhi_km1half=dGrid[nPhi][0][0][k]-(dGrid[nPhi][0][0][k+1]-dGrid[nPhi][0][0][k]);
-            }
-            else{
-              dPhi_km1half=dGrid[nPhi][0][0][k-1];
-            }
-            dArea=dArea2/(2.0*dPi)*(dPhi_kp1half-dPhi_km1half);
-            dDMTemp=(cos(dTheta_jm1half)-cos(dTheta_jp1half))
-              *(dPhi_kp1half-dPhi_km1half)*dGrid[nD][i][j][k];
-          }
-          
-          //get P,E,Kappa,Gamma, calculate luminosity from cell and add to sum
-          eosTable.getPEKappaGammaCp(dGrid[nT][i][j][k],dGrid[nD][i][j][k],dP_i,dE_i,dKappa_i
-            ,dGamma_i,dCp_i);
-          if(i<nSizeX2-1){
-            eosTable.getPEKappaGammaCp(dGrid[nT][i+1][j][k],dGrid[nD][i+1][j][k],dP_ip1,dE_ip1
-              ,dKappa_ip1,dGamma_ip1,dCp_ip1);
-            dT4_i=pow(dGrid[nT][i][j][k],4);
-            dT4_ip1=pow(dGrid[nT][i+1][j][k],4);
-            dKappa_ip1half=(dT4_i/dKappa_i+dT4_ip1/dKappa_ip1)
-              /(dT4_i+dT4_ip1);
-            dLSum_rad=dLSum_rad-16.0*dPi*dSigma*dRSq_ip1half*dKappa_ip1half/3.0
-              *(dT4_ip1-dT4_i)/(dGrid[nDM][i][0][0]+dGrid[nDM][i+1][0][0])*2.0*dArea;
-            dRho_ip1half=(dGrid[nD][i][j][k]+dGrid[nD][i+1][j][k])*0.5;
-            dTAve_ip1half=(dAve[nT][i]+dAve[nT][i+1])*0.5;
-            dT_ip1halfjk=(dGrid[nT][i][j][k]+dGrid[nT][i+1][j][k])*0.5;
-            dCp_ip1half=(dCp_i+dCp_ip1)*0.5;
-            
-            //start debug LCon
-            /*
-            if (bDebugLCon){
-              double dLCon=dCp_ip1half*dRho_ip1half*(dT_ip1halfjk-dTAve_ip1half)
-                *(dGrid[nU][i+1][j][k]-dGrid[nU0][i+1][0][0])*dArea;
-              ofDebugLCon
-                <<std::setw(nWidthIntOutputField)<<j
-                <<std::setw(nWidthIntOutputField)<<k
-                <<std::setw(nWidthOutputField)<<dCp_ip1half
-                <<std::setw(nWidthOutputField)<<dRho_ip1half
-                <<std::setw(nWidthOutputField)<<dT_ip1halfjk
-                <<std::setw(nWidthOutputField)<<dTAve_ip1half
-                <<std::setw(nWidthOutputField)<<dGrid[nU][i+1][j][k]
-                <<std::setw(nWidthOutputField)<<dGrid[nU0][i+1][0][0]
-                <<std::setw(nWidthOutputField)<<dArea
-                <<std::setw(nWidthOutputField)<<dLCon<<std::endl;
-            }*/
-            //end debug LCon
-            
-            dLSum_con=dLSum_con+dCp_ip1half*dRho_ip1half*(dT_ip1halfjk-dTAve_ip1half)
-              *(dGrid[nU][i+1][j][k]-dGrid[nU0][i+1][0][0])*dArea;
-            dF_con=dCp_ip1half*dRho_ip1half*(dT_ip1halfjk-dTAve_ip1half)
-              *(dGrid[nU][i+1][j][k]-dGrid[nU0][i+1][0][0]);
-          }
-          else{
-            //use surface boundary condition
-            dLSum_rad=dLSum_rad+dSigma*dArea*pow(pow(2.0,0.25)*dGrid[nT][i][j][k],4);
-            dLSum_con=0.0;
-          }
-          dAreaSum+=dArea;
-          
-          //calculate total kinetic energy
-          if(i==nSizeX1){
-            dU_ijk=(dGrid[nU][i+1][j][k]+dGrid[nU][i][0][0])*0.5;
-          }
-          else{
-            dU_ijk=(dGrid[nU][i+1][j][k]+dGrid[nU][i][j][k])*0.5;
-          }
-          dVSq_ijk=dU_ijk*dU_ijk;
-          if(nNumDims>1){
-            dV_ijk=(dGrid[nV][i][j+1][k]+dGrid[nV][i][j][k])*0.5;
-            dVSq_ijk+=dV_ijk*dV_ijk;
-          }
-          if(nNumDims>2){
-            dW_ijk=(dGrid[nW][i][j][k+1]+dGrid[nW][i][j][k])*0.5;
-            dVSq_ijk+=dW_ijk*dW_ijk;
-          }
-          dKETotSum+=dDMTemp*dVSq_ijk;
-          dDMSum+=dDMTemp;
-          
-          if(dF_con>dMaxF_con){
-            dMaxF_con=dF_con;
-            nMaxJIndex[nF_con][i]=j;
-            nMaxKIndex[nF_con][i]=k;
-          }
-          if(dF_con<dMinF_con){
-            dMinF_con=dF_con;
-            nMinJIndex[nF_con][i]=j;
-            nMinKIndex[nF_con][i]=k;
-          }
-          dSumF_con+=dF_con;
-          
-          //calculate Q
-          dC=sqrt(dGamma_i*dP_i/dGrid[nD][i][j][k]);
-          dDVDtThreshold=dAVThreshold*dC;
-          if(nNumDims>=1){
-            if(i==nSizeX1){
-              dDVDt=(dA_ip1half*dGrid[nU][i+1][j][k]
-                -dA_im1half*dGrid[nU][i][0][0])/dRSq_i;
-            }
-            else{
-              dDVDt=(dA_ip1half*dGrid[nU][i+1][j][k]
-                -dA_im1half*dGrid[nU][i][j][k])/dRSq_i;
-            }
-            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-              dQ0=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
-            }
-            else{
-              dQ0=0.0;
-            }
-          }
-          else if(nNumDims>=2){
-            if(j==0){
-              dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
-                -dA_jm1half*dGrid[nV][i][nSizeY-1][k])/dA_j;
-            }
-            else{
-              dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
-                -dA_jm1half*dGrid[nV][i][j-1][k])/dA_j;
-            }
-            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-              dQ1=dASq*dGrid[nD][i][j][k]
-                *dDVDt_mthreshold*dDVDt_mthreshold;
-            }
-            else{
-              dQ1=0.0;
-            }
-          }
-          else if(nNumDims==3){
-            if(k==0){
-              dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][nSizeZ-1]);
-            }
-            else{
-              dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][k-1]);
-            }
-            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-              dQ2=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
-            }
-            else{
-              dQ2=0.0;
-            }
-          }
-          dQ=dQ0+dQ1+dQ2;
-          
-          if(dP_i>dMaxP){
-            dMaxP=dP_i;
-            nMaxJIndex[nP][i]=j;
-            nMaxKIndex[nP][i]=k;
-          }
-          if(dP_i<dMinP){
-            dMinP=dP_i;
-            nMinJIndex[nP][i]=j;
-            nMinKIndex[nP][i]=k;
-          }
-          dSumP+=dP_i;
-          if(dE_i>dMaxE){
-            dMaxE=dE_i;
-            nMaxJIndex[nE][i]=j;
-            nMaxKIndex[nE][i]=k;
-          }
-          if(dE_i<dMinE){
-            dMinE=dE_i;
-            nMinJIndex[nE][i]=j;
-            nMinKIndex[nE][i]=k;
-          }
-          dSumE+=dE_i;
-          if(dKappa_i>dMaxKappa){
-            dMaxKappa=dKappa_i;
-            nMaxJIndex[nKappa][i]=j;
-            nMaxKIndex[nKappa][i]=k;
-          }
-          if(dKappa_i<dMinKappa){
-            dMinKappa=dKappa_i;
-            nMinJIndex[nKappa][i]=j;
-            nMinKIndex[nKappa][i]=k;
-          }
-          dSumKappa+=dKappa_i;
-          if(dGamma_i>dMaxGamma){
-            dMaxGamma=dGamma_i;
-            nMaxJIndex[nGamma][i]=j;
-            nMaxKIndex[nGamma][i]=k;
-          }
-          if(dGamma_i<dMinGamma){
-            dMinGamma=dGamma_i;
-            nMinJIndex[nGamma][i]=j;
-            nMinKIndex[nGamma][i]=k;
-          }
-          dSumGamma+=dGamma_i;
-          if(dQ>dMaxQ){
-            dMaxQ=dQ;
-            nMaxJIndex[nQ][i]=j;
-            nMaxKIndex[nQ][i]=k;
-          }
-          if(dQ<dMinQ){
-            dMinQ=dQ;
-            nMinJIndex[nQ][i]=j;
-            nMinKIndex[nQ][i]=k;
-          }
-          dSumQ+=dQ;
-          if(dC>dMaxC){
-            dMaxC=dC;
-            nMaxJIndex[nC][i]=j;
-            nMaxKIndex[nC][i]=k;
-          }
-          if(dC<dMinC){
-            dMinC=dC;
-            nMinJIndex[nC][i]=j;
-            nMinKIndex[nC][i]=k;
-          }
-          dSumC+=dC;
-          nMaxJIndex[nL_rad][i]=0;
-          nMaxKIndex[nL_rad][i]=0;
-          nMinJIndex[nL_rad][i]=0;
-          nMinKIndex[nL_rad][i]=0;
-          nMaxJIndex[nKEP][i]=0;
-          nMaxKIndex[nKEP][i]=0;
-          nMinJIndex[nKEP][i]=0;
-          nMinKIndex[nKETot][i]=0;
-          nMaxJIndex[nKETot][i]=0;
-          nMaxKIndex[nKETot][i]=0;
-          nMinJIndex[nKETot][i]=0;
-          nMinKIndex[nKETot][i]=0;
-          nCount++;
-        }
-      }
-      if(nNumDims==3){
-        dAve[nD][i]=dCalRhoAve3D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
+    //test to see if it is relative to the execuatable directory
+    std::string sTemp;
+    if (sEOSTable.substr(0,1)!="/" && sEOSTable.substr(0,2)!="./"){
+      
+      //if relative to executable directory 
+      sTemp=sExeDir+"/"+sEOSTable;
+    }
+    else{
+      sTemp=sEOSTable;
+    }
+    
+    eosTable=getEOSTable(sTemp);
+  }
+  double dA=dump.dA;
+  double dAVThreshold=dump.dAVThreshold;
+  int nSizeGlobe[3]={dump.nGlobalGridDims[0],dump.nGlobalGridDims[1],dump.nGlobalGridDims[2]};
+  int nPeriodic[3]={dump.nPeriodic[0],dump.nPeriodic[1],dump.nPeriodic[2]};
+  int nNum1DZones=dump.nNum1DZones;
+  int nNumGhostCells=dump.nNumGhostCells;
+  int nNumVars=dump.nNumVars;
+  
+  /*set grid sizes, only the radial direction counts the outer interface, rows in the file
+  may be longer*/
+  int **nSize=new int*[nNumVars];
+  int **nVarInfo=new int*[nNumVars];
+  int l;
+  for(int n=0;n<nNumVars;n++){
+    nSize[n]=new int[3];
+    nVarInfo[n]=new int[4];
+    for(l=0;l<4;l++){
+      nVarInfo[n][l]=dump.nVarInfo[n][l];
+    }
+    for(l=0;l<3;l++){
+      if(nVarInfo[n][l]==-1){//variable not defined in direction l
+        nSize[n][l]=1;
       }
-      else if(nNumDims==2){
-        dAve[nD][i]=dCalRhoAve2D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
+      else if(nVarInfo[n][l]==1&&l==0){//interface variable
+        nSize[n][l]=nSizeGlobe[l]+1;
       }
       else{
-        dAve[nD][i]=dGrid[nD][i][0][0];
+        nSize[n][l]=nSizeGlobe[l];
       }
-      
-      //start debug LCon
-      /*
-      if (bDebugLCon){
-        ofDebugLCon
-          <<std::setw(nWidthOutputField)<<dLSum_con
-          <<std::setw(nWidthOutputField)<<dAreaSum
-          <<std::setw(nWidthOutputField)<<dPi
-          <<std::setw(nWidthOutputField)<<dRSq_ip1half
-          <<std::endl;
-        ofDebugLCon.close();
-        bDebugLCon=false;
-      }*/
-      //end debug LCon
-      
-      dAve[nL_rad][i]=dLSum_rad/dAreaSum*4.0*dPi*dRSq_ip1half;
-      dAve[nL_con][i]=dLSum_con/dAreaSum*4.0*dPi*dRSq_ip1half;
-      dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
-      dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
-      dAve[nKETot][i]=0.5*dKETotSum/dDMSum*dGrid[nDM][i][0][0];
-      dMax[nP][i]=dMaxP;
-      dMin[nP][i]=dMinP;
-      dAve[nP][i]=dSumP/double(nCount);
-      dMax[nF_con][i]=dMaxF_con;
-      dMin[nF_con][i]=dMinF_con;
-      dAve[nF_con][i]=dSumF_con/double(nCount);
-      dMax[nE][i]=dMaxE;
-      dMin[nE][i]=dMinE;
-      dAve[nE][i]=dSumE/double(nCount);
-      dMax[nKappa][i]=dMaxKappa;
-      dMin[nKappa][i]=dMinKappa;
-      dAve[nKappa][i]=dSumKappa/double(nCount);
-      dMax[nGamma][i]=dMaxGamma;
-      dMin[nGamma][i]=dMinGamma;
-      dAve[nGamma][i]=dSumGamma/double(nCount);
-      dMax[nQ][i]=dMaxQ;
-      dMin[nQ][i]=dMinQ;
-      dAve[nQ][i]=dSumQ/double(nCount);
-      dMax[nC][i]=dMaxC;
-      dMin[nC][i]=dMinC;
-      dAve[nC][i]=dSumC/double(nCount);
     }
   }
-  else{//set P, Q, KE, and C
+  int nNumDims=dump.nNumDims;
+  
+  //set variable indices
+  int nNumIntVars=0;
+  if(nGammaLaw==0){//using gamma law gas
+    if(nNumDims==1){
+      nNumIntVars=5;
+      nM=0;
+      nDM=1;
+      nR=2;
+      nD=3;
+      nU=4;
+      nU0=5;
+      nE=6;
+      nP=nNumVars+0;
+      nQ=nNumVars+1;
+      nKEP=nNumVars+2;
+      nC=nNumVars+3;
+      nKETot=nNumVars+4;
+      nV=-1;
+      nW=-1;
+      nT=-1;
+      nTheta=-1;
+      nPhi=-1;
+      nKappa=-1;
+      nGamma=-1;
+    }
+    else if(nNumDims==2){
+      nNumIntVars=5;
+      nM=0;
+      nTheta=1;
+      nDM=2;
+      nR=3;
+      nD=4;
+      nU=5;
+      nU0=6;
+      nV=7;
+      nE=8;
+      nP=nNumVars+0;
+      nQ=nNumVars+1;
+      nKEP=nNumVars+2;
+      nC=nNumVars+3;
+      nKETot=nNumVars+4;
+      nW=-1;
+      nT=-1;
+      nPhi=-1;
+      nKappa=-1;
+      nGamma=-1;
+    }
+    else if(nNumDims==3){
+      nNumIntVars=5;
+      nM=0;
+      nTheta=1;
+      nPhi=2;
+      nDM=3;
+      nR=4;
+      nD=5;
+      nU=6;
+      nU0=7;
+      nV=8;
+      nW=9;
+      nE=10;
+      nP=nNumVars+0;
+      nQ=nNumVars+1;
+      nKEP=nNumVars+2;
+      nC=nNumVars+3;
+      nKETot=nNumVars+4;
+      nT=-1;
+      nKappa=-1;
+      nGamma=-1;
+    }
+  }
+  else{//using a tabulated equation of state
+    if(nNumDims==1){
+      nNumIntVars=11;
+      nM=0;
+      nDM=1;
+      nR=2;
+      nD=3;
+      nU=4;
+      nU0=5;
+      nT=6;
+      nE=nNumVars+0;
+      nQ=nNumVars+1;
+      nP=nNumVars+2;
+      nKappa=nNumVars+3;
+      nGamma=nNumVars+4;
+      nL_rad=nNumVars+5;
+      nL_con=nNumVars+6;
+      nF_con=nNumVars+7;
+      nKEP=nNumVars+8;
+      nC=nNumVars+9;
+      nKETot=nNumVars+10;
+      nV=-1;
+      nW=-1;
+      nTheta=-1;
+      nPhi=-1;
+    }
+    else if(nNumDims==2){
+      nNumIntVars=11;
+      nM=0;
+      nTheta=1;
+      nDM=2;
+      nR=3;
+      nD=4;
+      nU=5;
+      nU0=6;
+      nV=7;
+      nT=8;
+      nE=nNumVars+0;
+      nQ=nNumVars+1;
+      nP=nNumVars+2;
+      nKappa=nNumVars+3;
+      nGamma=nNumVars+4;
+      nL_rad=nNumVars+5;
+      nL_con=nNumVars+6;
+      nF_con=nNumVars+7;
+      nKEP=nNumVars+8;
+      nC=nNumVars+9;
+      nKETot=nNumVars+10;
+      nPhi=-1;
+      nW=-1;
+    }
+    else if(nNumDims==3){
+      nNumIntVars=11;
+      nM=0;
+      nTheta=1;
+      nPhi=2;
+      nDM=3;
+      nR=4;
+      nD=5;
+      nU=6;
+      nU0=7;
+      nV=8;
+      nW=9;
+      nT=10;
+      nE=nNumVars+0;
+      nQ=nNumVars+1;
+      nP=nNumVars+2;
+      nKappa=nNumVars+3;
+      nGamma=nNumVars+4;
+      nL_rad=nNumVars+5;
+      nL_con=nNumVars+6;
+      nF_con=nNumVars+7;
+      nKEP=nNumVars+8;
+      nC=nNumVars+9;
+      nKETot=nNumVars+10;
+    }
+  }
+  
+  //get the grid from the dump file
+  double ****dGrid=dump.getGrid();
+  int nGhostCellsX;
+  int nGhostCellsY;
+  int nGhostCellsZ;
+  int nSizeX1;
+  int nSizeX2;
+  int nStartY;
+  int nEndY;
+  int nSizeY;
+  int nStartZ;
+  int nEndZ;
+  int nSizeZ;
+  int i;
+  int j;
+  int k;
+  double dSum;
+  int nCount;
+  
+  //radialize the grid
+  double **dMax=new double*[nNumVars+nNumIntVars];
+  double **dMin=new double*[nNumVars+nNumIntVars];
+  double **dAve=new double*[nNumVars+nNumIntVars];
+  int **nMaxJIndex=new int*[nNumVars+nNumIntVars];
+  int **nMaxKIndex=new int*[nNumVars+nNumIntVars];
+  int **nMinJIndex=new int*[nNumVars+nNumIntVars];
+  int **nMinKIndex=new int*[nNumVars+nNumIntVars];
+  double dMaxTemp;
+  double dMinTemp;
+  for(int n=0;n<nNumVars;n++){
     
-    //allocate space
     nGhostCellsX=1;
-    if(nVarInfo[nD][0]==-1){/*all internal variables are cetnered quantities, will be the same as 
-      the density*/
+    if(nVarInfo[n][0]==-1){
       nGhostCellsX=0;
     }
     nGhostCellsY=1;
-    if(nVarInfo[nD][1]==-1){
+    if(nVarInfo[n][1]==-1){
       nGhostCellsY=0;
     }
     nGhostCellsZ=1;
-    if(nVarInfo[nD][2]==-1){
+    if(nVarInfo[n][2]==-1){
       nGhostCellsZ=0;
     }
-    double dP;
-    double dQ;
-    double dMaxP;
-    double dMinP;
-    double dSumP;
-    double dMaxQ;
-    double dMinQ;
-    double dSumQ;
-    double dMaxC;
-    double dMinC;
-    double dSumC;
-    double dQ0=0.0;
-    double dQ1=0.0;
-    double dQ2=0.0;
-    double dRSq_i;
-    double dA_ip1half;
-    double dA_im1half;
-    double dTheta_j;
-    double dTheta_jp1half;
-    double dTheta_jm1half;
-    double dA_jp1half;
-    double dA_jm1half;
-    double dA_j;
-    double dASq=dA*dA;
-    double dC;
-    double dDVDtThreshold;
-    double dDVDt_mthreshold;
-    double dDVDt;
-    double dU_i;
     
-    //set 1D part of the grid
-    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);//may be need to +1 if only one proc and variable in interface centered
-    if (nVarInfo[nD][0]==1&&nPeriodic[0]==0){
+    //make some space to hold max,min and average
+    dMax[n]=new double[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
+    dMin[n]=new double[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
+    dAve[n]=new double[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
+    
+    nMaxJIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
+    nMaxKIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
+    nMinJIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
+    nMinKIndex[n]=new int[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
+    
+    //read in 1D part of the grid
+    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);//may be need to +1 if only one proc and variable in interface centred
+    if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
       nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
     }
     nSizeY=1;
     nSizeZ=1;
-    for(i=0;i<nSizeX1;i++){//find average max, and min in 1D region
-      
-      //calculate P
-      dP=dGrid[nD][i][0][0]*(dGamma-1.0)*dGrid[nE][i][0][0];
-      
-      //calculate Q
-      dRSq_i=(dGrid[nR][i+1][0][0]+dGrid[nR][i][0][0])*0.5;
-      dA_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
-      dA_im1half=dGrid[nR][i][0][0]*dGrid[nR][i][0][0];
-      dC=sqrt(dGamma*dP/dGrid[nD][i][j][k]);
-      dDVDtThreshold=dAVThreshold*dC;
-      dDVDt=(dA_ip1half*dGrid[nU][i+1][j][k]
-        -dA_im1half*dGrid[nU][i][j][k])/dRSq_i;
-      if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-        dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-        dQ=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
-      }
-      else{
-        dQ=0.0;
-      }
-      dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
-      dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
-      dMax[nP][i]=dP;
-      dMin[nP][i]=dP;
-      dAve[nP][i]=dP;
-      dMax[nQ][i]=dQ;
-      dMin[nQ][i]=dQ;
-      dAve[nQ][i]=dQ;
-      dMax[nC][i]=dC;
-      dMin[nC][i]=dC;
-      dAve[nC][i]=dC;
-      nMaxJIndex[nP][i]=0;
-      nMaxKIndex[nP][i]=0;
-      nMinJIndex[nP][i]=0;
-      nMinKIndex[nP][i]=0;
-      nMaxJIndex[nQ][i]=0;
-      nMaxKIndex[nQ][i]=0;
-      nMinJIndex[nQ][i]=0;
-      nMinKIndex[nQ][i]=0;
-      nMaxJIndex[nC][i]=0;
-      nMaxKIndex[nC][i]=0;
-      nMinJIndex[nC][i]=0;
-      nMinKIndex[nC][i]=0;
-      nMaxJIndex[nKEP][i]=0;
-      nMaxKIndex[nKEP][i]=0;
-      nMinJIndex[nKEP][i]=0;
-      nMinKIndex[nKEP][i]=0;
-      
+    for(i=0;i<nSizeX1;i++){
+      //find average max, and min
+      dMax[n][i]=dGrid[n][i][0][0];
+      dMin[n][i]=dGrid[n][i][0][0];
+      dAve[n][i]=dGrid[n][i][0][0];
+      nMaxJIndex[n][i]=0;
+      nMaxKIndex[n][i]=0;
+      nMinJIndex[n][i]=0;
+      nMinKIndex[n][i]=0;
     }
     
-    //set the rest of the grid
-    nSizeX2=nSize[nD][0]+nGhostCellsX*2*nNumGhostCells;
-    nSizeY=nSize[nD][1]+nGhostCellsY*2*nNumGhostCells;
-    nSizeZ=nSize[nD][2]+nGhostCellsZ*2*nNumGhostCells;
+    //read in the rest of the grid
+    nSizeX2=nSize[n][0]+nGhostCellsX*2*nNumGhostCells;
+    nSizeY=nSize[n][1]+nGhostCellsY*2*nNumGhostCells;
+    nSizeZ=nSize[n][2]+nGhostCellsZ*2*nNumGhostCells;
     nStartY=nGhostCellsY*nNumGhostCells;
-    nEndY=nSize[nD][1]+nStartY;
+    nEndY=nSize[n][1]+nStartY;
     nStartZ=nGhostCellsZ*nNumGhostCells;
-    nEndZ=nSize[nD][2]+nStartZ;
+    nEndZ=nSize[n][2]+nStartZ;
     for(i=nSizeX1;i<nSizeX2;i++){
-      dMaxP=-1.0*std::numeric_limits<double>::max();
-      dMinP=std::numeric_limits<double>::max();
-      dSumP=0.0;
-      dMaxQ=-1.0*std::numeric_limits<double>::max();
-      dMinQ=std::numeric_limits<double>::max();
-      dSumQ=0.0;
-      dMaxC=-1.0*std::numeric_limits<double>::max();
-      dMinC=std::numeric_limits<double>::max();
-      dSumC=0.0;
+      dMaxTemp=-1.0*std::numeric_limits<double>::max();
+      dMinTemp=std::numeric_limits<double>::max();
+      dSum=0.0;
       nCount=0;
       for(j=nStartY;j<nEndY;j++){
-        dTheta_jp1half=dGrid[nTheta][0][j][0];
-        if(j==0){
-          dTheta_jm1half=dGrid[nTheta][0][j][0]-(dGrid[nTheta][0][j+1][0]-dGrid[nTheta][0][j][0]);
-        }
-        dTheta_j=(dTheta_jp1half+dTheta_jm1half)*0.5;
-        dA_jp1half=sin(dTheta_jp1half);
-        dA_jm1half=sin(dTheta_jm1half);;
-        dA_j=sin(dTheta_j);
         for(k=nStartZ;k<nEndZ;k++){
-          
-          //calculate P
-          dP=dGrid[nD][i][j][k]*(dGamma-1.0)*dGrid[nE][i][j][k];
-        
-          //calculate Q
-          dC=sqrt(dGamma*dP/dGrid[nD][i][j][k]);
-          dDVDtThreshold=dAVThreshold*dC;
-          if(nNumDims>=1){
-            dDVDt=(dA_ip1half*dGrid[nU][i+1][j][k]
-              -dA_im1half*dGrid[nU][i][j][k])/dRSq_i;
-            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-              dQ0=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
-            }
-            else{
-              dQ0=0.0;
-            }
-          }
-          else if(nNumDims>=2){
-            if(j==0){
-              dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
-                -dA_jm1half*dGrid[nV][i][nSizeY-1][k])/dA_j;
-            }
-            else{
-              dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
-                -dA_jm1half*dGrid[nV][i][j-1][k])/dA_j;
-            }
-            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-              dQ1=dASq*dGrid[nD][i][j][k]
-                *dDVDt_mthreshold*dDVDt_mthreshold;
-            }
-            else{
-              dQ1=0.0;
-            }
-          }
-          else if(nNumDims==3){
-            if(k==0){
-              dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][nSizeZ-1]);
-            }
-            else{
-              dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][k-1]);
-            }
-            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
-              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
-              dQ2=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
-            }
-            else{
-              dQ2=0.0;
-            }
-          }
-          dQ=dQ0+dQ1+dQ2;
-          
-          if(dP>dMaxP){
-            dMaxP=dP;
-            nMaxJIndex[nP][i]=j;
-            nMaxKIndex[nP][i]=k;
-          }
-          if(dP<dMinP){
-            dMinP=dP;
-            nMinJIndex[nP][i]=j;
-            nMinKIndex[nP][i]=k;
-          }
-          dSumP+=dP;
-          if(dQ>dMaxQ){
-            dMaxQ=dQ;
-            nMaxJIndex[nQ][i]=j;
-            nMaxKIndex[nQ][i]=k;
-          }
-          if(dQ<dMinQ){
-            dMinQ=dQ;
-            nMinJIndex[nQ][i]=j;
-            nMinKIndex[nQ][i]=k;
-          }
-          dSumQ+=dQ;
-          if(dC>dMaxC){
-            dMaxC=dC;
-            nMaxJIndex[nC][i]=j;
-            nMaxKIndex[nC][i]=k;
+          //find average max, and min
+          if(dGrid[n][i][j][k]>dMaxTemp){
+            dMaxTemp=dGrid[n][i][j][k];
+            nMaxJIndex[n][i]=j;
+            nMaxKIndex[n][i]=k;
           }
-          if(dC<dMinC){
-            dMinC=dC;
-            nMinJIndex[nC][i]=j;
-            nMinKIndex[nC][i]=k;
+          if(dGrid[n][i][j][k]<dMinTemp){
+            dMinTemp=dGrid[n][i][j][k];
+            nMinJIndex[n][i]=j;
+            nMinKIndex[n][i]=k;
           }
-          dSumC+=dC;
-          
+          dSum+=dGrid[n][i][j][k];
           nCount++;
         }
       }
-      dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
-      if(nNumDims==3){
-        dAve[nD][i]=dCalRhoAve3D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
-      }
-      else if(nNumDims==2){
-        dAve[nD][i]=dCalRhoAve2D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
-      }
-      else{
-        dAve[nD][i]=dGrid[nD][i][0][0];
-      }
-      dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
-      dMax[nP][i]=dMaxP;
-      dMin[nP][i]=dMinP;
-      dAve[nP][i]=dSumP/double(nCount);
-      dMax[nQ][i]=dMaxQ;
-      dMin[nQ][i]=dMinQ;
-      dAve[nQ][i]=dSumQ/double(nCount);
-      dMax[nC][i]=dMaxC;
-      dMin[nC][i]=dMinC;
-      dAve[nC][i]=dSumC/double(nCount);
-      nMaxJIndex[nKEP][i]=0;
-      nMaxKIndex[nKEP][i]=0;
-      nMinJIndex[nKEP][i]=0;
-      nMinKIndex[nKEP][i]=0;
+      dMax[n][i]=dMaxTemp;
+      dMin[n][i]=dMinTemp;
+      dAve[n][i]=dSum/double(nCount);
     }
   }
   
-  //open output file
-  std::string sFileNameOut=sFileName+"_pro.txt";
-  std::ofstream ofFile;
-  ofFile.open(sFileNameOut.c_str());
-  if(!ofFile.good()){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
-      <<sFileNameOut<<" didn't open properly\n";
-    throw exception2(ssTemp.str(),INPUT);
+  //allocate space for internal variables
+  for(int n=nNumVars;n<nNumVars+nNumIntVars;n++){
+    dMax[n]=new double[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
+    dMin[n]=new double[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
+    dAve[n]=new double[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
+    nMaxJIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
+    nMaxKIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
+    nMinJIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
+    nMinKIndex[n]=new int[nSize[nD][0]+nGhostCellsX*2*nNumGhostCells];
   }
   
-  //set double output precision
-  ofFile.precision(nPrecisionAscii);
-  if(bScientific){
-    ofFile.unsetf(std::ios::fixed);
-    ofFile.setf(std::ios::scientific);
+  //calculate filling factor for upflow
+  nGhostCellsX=1;
+  if(nVarInfo[nU][0]==-1){
+    nGhostCellsX=0;
+  }
+  nGhostCellsY=1;
+  if(nVarInfo[nU][1]==-1){
+    nGhostCellsY=0;
+  }
+  nGhostCellsZ=1;
+  if(nVarInfo[nU][2]==-1){
+    nGhostCellsZ=0;
   }
-  else{
-    ofFile.unsetf(std::ios::scientific);
-    ofFile.setf(std::ios::fixed);
+  nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);
+  if (nVarInfo[nU][0]==1&&nPeriodic[0]==0){
+    nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
   }
-  
-  //write out header to profile file
-  int nWidthOutputField=25;
-  int nWidthIntOutputField=12;
-  ofFile<<"time= "<<dTime<<" [s]"<<std::endl;
-  ofFile<<std::setw(nWidthIntOutputField)<<"Zone_#(1)"
-    <<std::setw(nWidthOutputField)<<"M_r_im1half[g](2)"
-    <<std::setw(nWidthOutputField)<<"DM_r[g](3)"
-    <<std::setw(nWidthOutputField)<<"ErrorDM_r(4)"
-    <<std::setw(nWidthOutputField)<<"R_im1half[cm](5)"
-    <<std::setw(nWidthOutputField)<<"R_ip1half[cm](6)"
-    <<std::setw(nWidthOutputField)<<"<D>[g/cm^3](7)"
-    <<std::setw(nWidthOutputField)<<"D_max[g/cm^3](8)"
-    <<std::setw(nWidthIntOutputField)<<"D_max_j(9)"
-    <<std::setw(nWidthIntOutputField)<<"D_max_k(10)"
-    <<std::setw(nWidthOutputField)<<"D_min[g/cm^3](11)"
-    <<std::setw(nWidthIntOutputField)<<"D_min_j(12)"
-    <<std::setw(nWidthIntOutputField)<<"D_min_k(13)"
-    <<std::setw(nWidthOutputField)<<"U_ave_im1half[cm/s](14)"
-    <<std::setw(nWidthOutputField)<<"U_max_im1half[cm/s](15)"
-    <<std::setw(nWidthIntOutputField)<<"U_max_j(16)"
-    <<std::setw(nWidthIntOutputField)<<"U_max_k(17)"
-    <<std::setw(nWidthOutputField)<<"U_min_im1half[cm/s](18)"
-    <<std::setw(nWidthIntOutputField)<<"U_min_j(19)"
-    <<std::setw(nWidthIntOutputField)<<"U_min_k(20)"
-    <<std::setw(nWidthOutputField)<<"U0[cm/s](21)"
-    <<std::setw(nWidthOutputField)<<"V_ave[cm/s](22)"
-    <<std::setw(nWidthOutputField)<<"V_max[cm/s](23)"
-    <<std::setw(nWidthIntOutputField)<<"V_max_j(24)"
-    <<std::setw(nWidthIntOutputField)<<"V_max_k(25)"
-    <<std::setw(nWidthOutputField)<<"V_min[cm/s](26)"
-    <<std::setw(nWidthIntOutputField)<<"V_min_j(27)"
-    <<std::setw(nWidthIntOutputField)<<"V_min_k(28)"
-    <<std::setw(nWidthOutputField)<<"W_ave[cm/s](29)"
-    <<std::setw(nWidthOutputField)<<"W_max[cm/s](30)"
-    <<std::setw(nWidthIntOutputField)<<"W_max_j(31)"
-    <<std::setw(nWidthIntOutputField)<<"W_max_k(32)"
-    <<std::setw(nWidthOutputField)<<"W_min[cm/s](33)"
-    <<std::setw(nWidthIntOutputField)<<"W_min_j(34)"
-    <<std::setw(nWidthIntOutputField)<<"W_min_k(35)"
-    <<std::setw(nWidthOutputField)<<"Q[dynes/cm^2](36)"
-    <<std::setw(nWidthOutputField)<<"Q_max[dynes/cm^2](37)"
-    <<std::setw(nWidthIntOutputField)<<"Q_max_j(38)"
-    <<std::setw(nWidthIntOutputField)<<"Q_max_k(39)"
-    <<std::setw(nWidthOutputField)<<"Q_min[dynes/cm^2](40)"
-    <<std::setw(nWidthIntOutputField)<<"Q_min_j(41)"
-    <<std::setw(nWidthIntOutputField)<<"Q_min_k(42)"
-    <<std::setw(nWidthOutputField)<<"E_ave[erg/g](43)"
-    <<std::setw(nWidthOutputField)<<"E_max[erg/g](44)"
-    <<std::setw(nWidthIntOutputField)<<"E_max_j(45)"
-    <<std::setw(nWidthIntOutputField)<<"E_max_k(46)"
-    <<std::setw(nWidthOutputField)<<"E_min[erg/g](47)"
-    <<std::setw(nWidthIntOutputField)<<"E_min_j(48)"
-    <<std::setw(nWidthIntOutputField)<<"E_min_k(49)"
-    <<std::setw(nWidthOutputField)<<"T_ave[K](50)"
-    <<std::setw(nWidthOutputField)<<"T_max[K](51)"
-    <<std::setw(nWidthIntOutputField)<<"T_max_j(52)"
-    <<std::setw(nWidthIntOutputField)<<"T_max_k(53)"
-    <<std::setw(nWidthOutputField)<<"T_min[K](54)"
-    <<std::setw(nWidthIntOutputField)<<"T_min_j(55)"
-    <<std::setw(nWidthIntOutputField)<<"T_min_k(56)"
-    <<std::setw(nWidthOutputField)<<"Kap_ave[cm^2/g](57)"
-    <<std::setw(nWidthOutputField)<<"Kap_min[cm^2/g](58)"
-    <<std::setw(nWidthOutputField)<<"Kap_max[cm^2/g](59)"
-    <<std::setw(nWidthOutputField)<<"L_rd_im1half[L_sun](60)"
-    <<std::setw(nWidthOutputField)<<"L_cv_im1half[L_sun](61)"
-    <<std::setw(nWidthOutputField)<<"F_cv_ave[L_sun/cm^2](62)"
-    <<std::setw(nWidthOutputField)<<"F_cv_max[L_sun/cm^2](63)"
-    <<std::setw(nWidthOutputField)<<"F_cv_min[L_sun/cm^2](64)"
-    <<std::setw(nWidthOutputField)<<"KEP[ergs](65)"
-    <<std::setw(nWidthOutputField)<<"KETot[ergs](66)"
-    <<std::setw(nWidthOutputField)<<"P_ave[dynes/cm^2](67)"
-    <<std::setw(nWidthOutputField)<<"P_min[dynes/cm^2](68)"
-    <<std::setw(nWidthOutputField)<<"P_max[dynes/cm^2](69)"
-    <<std::setw(nWidthOutputField)<<"Gam_ave[na](70)"
-    <<std::setw(nWidthOutputField)<<"Gam_min[na](71)"
-    <<std::setw(nWidthOutputField)<<"Gam_max[na](72)"
-    <<std::setw(nWidthOutputField)<<"C_ave[cm/s](73)"
-    <<std::setw(nWidthOutputField)<<"C_max[cm/s](74)"
-    <<std::setw(nWidthIntOutputField)<<"C_max_j(75)"
-    <<std::setw(nWidthIntOutputField)<<"C_max_k(76)"
-    <<std::setw(nWidthOutputField)<<"C_min[cm/s](77)"
-    <<std::setw(nWidthIntOutputField)<<"C_min_j(78)"
-    <<std::setw(nWidthIntOutputField)<<"C_min_k(79)"
-    <<std::setw(nWidthOutputField)<<"UpFillFac(80)";
-  if(bExtraInfoInProfile){
-    ofFile<<std::setw(nWidthOutputField)<<"DlnPDlnT(81)"
-      <<std::setw(nWidthOutputField)<<"DlnPDlnRho(82)"
-      <<std::setw(nWidthOutputField)<<"DEDT(83)";
+  nSizeX2=nSize[nU][0]+nGhostCellsX*2*nNumGhostCells;
+  nSizeY=nSize[nU][1]+nGhostCellsY*2*nNumGhostCells;
+  nSizeZ=nSize[nU][2]+nGhostCellsZ*2*nNumGhostCells;
+  nStartY=nGhostCellsY*nNumGhostCells;
+  nEndY=nSize[nU][1]+nStartY;
+  nStartZ=nGhostCellsZ*nNumGhostCells;
+  nEndZ=nSize[nU][2]+nStartZ;
+  double *dUpFlowFillingFactor=new double[nSize[nU][0]+nGhostCellsX*2
+    *nNumGhostCells];
+  for(int i=0;i<nSizeX1;i++){
+    dUpFlowFillingFactor[i]=0.0;//no-upflow in 1D part
   }
-  ofFile<<std::endl;
-  
-  //write out profile
-  double dErrorDM_r;
-  for(int i=0;i<nSizeGlobe[0]+2*nNumGhostCells;i++){
-    
-    //calculate mass error
-    dErrorDM_r=(4.0/3.0*dPi*dAve[nD][i]*(pow(dGrid[nR][i+1][0][0],3.0)
-      -pow(dGrid[nR][i][0][0],3.0))-dGrid[nDM][i][0][0])/dGrid[nDM][i][0][0];
-    double dDlnPDlnT;
-    double dDlnPDlnRho;
-    double dDEDT;
-    eosTable.getDlnPDlnTDlnPDlnPDEDT(dAve[nT][i],dAve[nD][i],dDlnPDlnT,dDlnPDlnRho,dDEDT);
+  int nCountUp=0;
+  int nCountTotal=0;
+  for(int i=nSizeX1;i<nSizeX2;i++){
+    for(int j=nStartY;j<nEndY;j++){
+      for(int k=nStartZ;k<nEndZ;k++){
+        
+        //if there is an up-flow (removing flow due to pulsation)
+        if(dGrid[nU][i][j][k]-dGrid[nU0][i][0][0]>0.0){
+          nCountUp++;
+        }
+        nCountTotal++;
+      }
+    }
     
-    nMaxJIndex[nP][i]=0;
-    nMaxKIndex[nP][i]=0;
-    nMinJIndex[nP][i]=0;
-    nMinKIndex[nP][i]=0;
+    //record filling factor, and reset counts
+    dUpFlowFillingFactor[i]=double(nCountUp)/double(nCountTotal);
+    nCountUp=0;
+    nCountTotal=0;
+  }
+  
+  if(nGammaLaw!=0){//set P,E,kappa,gamma, Q, L_rad and L_con, KE, C, <rho>
     
-    ofFile<<std::setw(nWidthIntOutputField)<<i//1
-      <<std::setw(nWidthOutputField)<<dGrid[nM][i][0][0]//2
-      <<std::setw(nWidthOutputField)<<dGrid[nDM][i][0][0]//3
-      <<std::setw(nWidthOutputField)<<dErrorDM_r//4
-      <<std::setw(nWidthOutputField)<<dGrid[nR][i][0][0]//5
-      <<std::setw(nWidthOutputField)<<dGrid[nR][i+1][0][0]//6
-      <<std::setw(nWidthOutputField)<<dAve[nD][i]//7
-      <<std::setw(nWidthOutputField)<<dMax[nD][i]//8
-      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nD][i]//9
-      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nD][i]//10
-      <<std::setw(nWidthOutputField)<<dMin[nD][i]//11
-      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nD][i]//12
-      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nD][i]//13
-      <<std::setw(nWidthOutputField)<<dAve[nU][i]//14
-      <<std::setw(nWidthOutputField)<<dMax[nU][i]//15
-      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nU][i]//16
-      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nU][i]//17
-      <<std::setw(nWidthOutputField)<<dMin[nU][i]//18
-      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nU][i]//19
-      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nU][i]//20
-      <<std::setw(nWidthOutputField)<<dGrid[nU0][i][0][0];//21
-    if(nNumDims>1){
-      ofFile
-        <<std::setw(nWidthOutputField)<<dAve[nV][i]//22
-        <<std::setw(nWidthOutputField)<<dMax[nV][i]//23
-        <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nV][i]//24
-        <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nV][i]//25
-        <<std::setw(nWidthOutputField)<<dMin[nV][i]//26
-        <<std::setw(nWidthIntOutputField)<<nMinJIndex[nV][i]//27
-        <<std::setw(nWidthIntOutputField)<<nMinKIndex[nV][i];//28
-    }
-    else{
-      ofFile
-        <<std::setw(nWidthOutputField)<<"-"//22
-        <<std::setw(nWidthOutputField)<<"-"//23
-        <<std::setw(nWidthIntOutputField)<<"-"//24
-        <<std::setw(nWidthIntOutputField)<<"-"//25
-        <<std::setw(nWidthOutputField)<<"-"//26
-        <<std::setw(nWidthIntOutputField)<<"-"//27
-        <<std::setw(nWidthIntOutputField)<<"-";//28
+    //allocate space
+    nGhostCellsX=1;
+    if(nVarInfo[nD][0]==-1){/*all internal variables are centred quantities, will be the same as 
+      the density*/
+      nGhostCellsX=0;
     }
-    if(nNumDims>2){
-      ofFile
-        <<std::setw(nWidthOutputField)<<dAve[nW][i]//29
-        <<std::setw(nWidthOutputField)<<dMax[nW][i]//30
-        <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nW][i]//31
-        <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nW][i]//32
-        <<std::setw(nWidthOutputField)<<dMin[nW][i]//33
-        <<std::setw(nWidthIntOutputField)<<nMinJIndex[nW][i]//34
-        <<std::setw(nWidthIntOutputField)<<nMinKIndex[nW][i];//35
+    nGhostCellsY=1;
+    if(nVarInfo[nD][1]==-1){
+      nGhostCellsY=0;
     }
-    else{
-      ofFile
-        <<std::setw(nWidthOutputField)<<"-"//29
-        <<std::setw(nWidthOutputField)<<"-"//30
-        <<std::setw(nWidthIntOutputField)<<"-"//31
-        <<std::setw(nWidthIntOutputField)<<"-"//32
-        <<std::setw(nWidthOutputField)<<"-"//33
-        <<std::setw(nWidthIntOutputField)<<"-"//34
-        <<std::setw(nWidthIntOutputField)<<"-";//35
+    nGhostCellsZ=1;
+    if(nVarInfo[nD][2]==-1){
+      nGhostCellsZ=0;
     }
-    ofFile
-      <<std::setw(nWidthOutputField)<<dAve[nQ][i]//36
-      <<std::setw(nWidthOutputField)<<dMax[nQ][i]//37
-      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nQ][i]//38
-      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nQ][i]//39
-      <<std::setw(nWidthOutputField)<<dMin[nQ][i]//40
-      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nQ][i]//41
-      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nQ][i];//42
-    ofFile
-      <<std::setw(nWidthOutputField)<<dAve[nE][i]//43
-      <<std::setw(nWidthOutputField)<<dMax[nE][i]//44
-      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nE][i]//45
-      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nE][i]//46
-      <<std::setw(nWidthOutputField)<<dMin[nE][i]//47
-      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nE][i]//48
-      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nE][i];//49
-    if(nGammaLaw==0){
-      ofFile
-        <<std::setw(nWidthOutputField)<<"-"//50
-        <<std::setw(nWidthOutputField)<<"-"//51
-        <<std::setw(nWidthIntOutputField)<<"-"//52
-        <<std::setw(nWidthIntOutputField)<<"-"//53
-        <<std::setw(nWidthOutputField)<<"-"//54
-        <<std::setw(nWidthIntOutputField)<<"-"//55
-        <<std::setw(nWidthIntOutputField)<<"-"//56
-        <<std::setw(nWidthOutputField)<<"-"//57
-        <<std::setw(nWidthOutputField)<<"-"//58
-        <<std::setw(nWidthOutputField)<<"-"//59
-        <<std::setw(nWidthOutputField)<<"-"//60
-        <<std::setw(nWidthOutputField)<<"-";//61
+    
+    double dP_i;
+    double dE_i;
+    double dKappa_i;
+    double dGamma_i;
+    double dP_ip1;
+    double dE_ip1;
+    double dKappa_ip1;
+    double dKappa_ip1half;
+    double dGamma_ip1;
+    double dQ;
+    double dC;
+    double dRSq_i;
+    double dA_ip1half;
+    double dA_im1half;
+    double dASq=dA*dA;
+    double dDVDtThreshold;
+    double dDVDt_mthreshold;
+    double dDVDt;
+    double dR_i;
+    double dT4_ip1;
+    double dT4_i;
+    double dArea;
+    double dU_i;
+    
+    //set 1D part of the grid
+    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);/*maybe need to +1 if only one proc and 
+      variable is interface centered*/
+    if (nVarInfo[nD][0]==1&&nPeriodic[0]==0){
+      nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
     }
-    else{
-      ofFile
-        <<std::setw(nWidthOutputField)<<dAve[nT][i]//50
-        <<std::setw(nWidthOutputField)<<dMax[nT][i]//51
-        <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nT][i]//52
-        <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nT][i]//53
-        <<std::setw(nWidthOutputField)<<dMin[nT][i]//54
-        <<std::setw(nWidthIntOutputField)<<nMinJIndex[nT][i]//55
-        <<std::setw(nWidthIntOutputField)<<nMinKIndex[nT][i]//56
-        <<std::setw(nWidthOutputField)<<dAve[nKappa][i]//57
-        <<std::setw(nWidthOutputField)<<dMax[nKappa][i]//58
-        <<std::setw(nWidthOutputField)<<dMin[nKappa][i];//59
-      if(i!=0){
-        ofFile
-          <<std::setw(nWidthOutputField)<<dAve[nL_rad][i-1]/dLSun//60
-          <<std::setw(nWidthOutputField)<<dAve[nL_con][i-1]/dLSun//61
-          <<std::setw(nWidthOutputField)<<dAve[nF_con][i-1]/dLSun//62
-          <<std::setw(nWidthOutputField)<<dMax[nF_con][i-1]/dLSun//63
-          <<std::setw(nWidthOutputField)<<dMin[nF_con][i-1]/dLSun;//64
+    nSizeY=1;
+    nSizeZ=1;
+    for(i=0;i<nSizeX1;i++){//find average max, and min in 1D region
+      
+      //get P,E,Kappa,Gamma
+      eosTable.getPEKappaGamma(dGrid[nT][i][0][0],dGrid[nD][i][0][0],dP_i,dE_i,dKappa_i,dGamma_i);
+      eosTable.getPEKappaGamma(dGrid[nT][i+1][0][0],dGrid[nD][i+1][0][0],dP_ip1,dE_ip1,dKappa_ip1
+        ,dGamma_ip1);
+      
+      //calculate Q
+      dR_i=(dGrid[nR][i+1][0][0]+dGrid[nR][i][0][0])*0.5;
+      dRSq_i=dR_i*dR_i;
+      dA_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
+      dA_im1half=dGrid[nR][i][0][0]*dGrid[nR][i][0][0];
+      dC=sqrt(dGamma_i*dP_i/dGrid[nD][i][0][0]);
+      dDVDtThreshold=dAVThreshold*dC;
+      dDVDt=(dA_ip1half*dGrid[nU][i+1][0][0]
+        -dA_im1half*dGrid[nU][i][0][0])/dRSq_i;
+      if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+        dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+        dQ=dASq*dGrid[nD][i][0][0]*dDVDt_mthreshold*dDVDt_mthreshold;
       }
-      else{//luminosity not defined at inner interface
-        ofFile
-          <<std::setw(nWidthOutputField)<<"-"//60
-          <<std::setw(nWidthOutputField)<<"-"//61
-          <<std::setw(nWidthOutputField)<<"-"//62
-          <<std::setw(nWidthOutputField)<<"-"//63
-          <<std::setw(nWidthOutputField)<<"-";//64
+      else{
+        dQ=0.0;
       }
+      
+      //calculate luminosity from cell and add to sum
+      dArea=dA_ip1half*4.0*dPi;
+      dT4_i=pow(dGrid[nT][i][0][0],4);
+      dT4_ip1=pow(dGrid[nT][i+1][0][0],4);
+      dKappa_ip1half=(dT4_i/dKappa_i+dT4_ip1/dKappa_ip1)
+        /(dT4_i+dT4_ip1);
+      dAve[nL_rad][i]=-16.0*dPi*dSigma*dA_ip1half*dKappa_ip1half
+        /3.0*(dT4_ip1-dT4_i)/(dGrid[nDM][i][0][0]+dGrid[nDM][i+1][0][0])
+        *2.0*dArea;
+      dAve[nL_con][i]=0.0;
+      dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
+      dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
+      dAve[nKETot][i]=dAve[nKEP][i];//nothing but pulsation energy in 1D
+      dMax[nE][i]=dE_i;
+      dMin[nE][i]=dE_i;
+      dAve[nE][i]=dE_i;
+      dMax[nP][i]=dP_i;
+      dMin[nP][i]=dP_i;
+      dAve[nP][i]=dP_i;
+      dMax[nF_con][i]=0.0;
+      dMin[nF_con][i]=0.0;
+      dAve[nF_con][i]=0.0;
+      dMax[nKappa][i]=dKappa_i;
+      dMin[nKappa][i]=dKappa_i;
+      dAve[nKappa][i]=dKappa_i;
+      dMax[nGamma][i]=dGamma_i;
+      dMin[nGamma][i]=dGamma_i;
+      dAve[nGamma][i]=dGamma_i;
+      dMax[nQ][i]=dQ;
+      dMin[nQ][i]=dQ;
+      dAve[nQ][i]=dQ;
+      dMax[nC][i]=dC;
+      dMin[nC][i]=dC;
+      dAve[nC][i]=dC;
+      nMaxJIndex[nP][i]=0;
+      nMaxKIndex[nP][i]=0;
+      nMinJIndex[nP][i]=0;
+      nMinKIndex[nP][i]=0;
+      nMaxJIndex[nE][i]=0;
+      nMaxKIndex[nE][i]=0;
+      nMinJIndex[nE][i]=0;
+      nMinKIndex[nE][i]=0;
+      nMaxJIndex[nKappa][i]=0;
+      nMaxKIndex[nKappa][i]=0;
+      nMinJIndex[nKappa][i]=0;
+      nMinKIndex[nKappa][i]=0;
+      nMaxJIndex[nGamma][i]=0;
+      nMaxKIndex[nGamma][i]=0;
+      nMinJIndex[nGamma][i]=0;
+      nMinKIndex[nGamma][i]=0;
+      nMaxJIndex[nQ][i]=0;
+      nMaxKIndex[nQ][i]=0;
+      nMinJIndex[nQ][i]=0;
+      nMinKIndex[nQ][i]=0;
+      nMaxJIndex[nC][i]=0;
+      nMaxKIndex[nC][i]=0;
+      nMinJIndex[nC][i]=0;
+      nMinKIndex[nC][i]=0;
+      nMaxJIndex[nL_rad][i]=0;
+      nMaxKIndex[nL_rad][i]=0;
+      nMinJIndex[nL_rad][i]=0;
+      nMinKIndex[nL_rad][i]=0;
+      nMaxJIndex[nKEP][i]=0;
+      nMaxKIndex[nKEP][i]=0;
+      nMinJIndex[nKEP][i]=0;
+      nMinKIndex[nKEP][i]=0;
+      nMaxJIndex[nKETot][i]=0;
+      nMaxKIndex[nKETot][i]=0;
+      nMinJIndex[nKETot][i]=0;
+      nMinKIndex[nKETot][i]=0;
     }
-    ofFile
-      <<std::setw(nWidthOutputField)<<dAve[nKEP][i]//65
-      <<std::setw(nWidthOutputField)<<dAve[nKETot][i]//66
-      <<std::setw(nWidthOutputField)<<dAve[nP][i]//67
-      <<std::setw(nWidthOutputField)<<dMax[nP][i]//68
-      <<std::setw(nWidthOutputField)<<dMin[nP][i]//69
-      <<std::setw(nWidthOutputField)<<dAve[nGamma][i]//70
-      <<std::setw(nWidthOutputField)<<dMax[nGamma][i]//71
-      <<std::setw(nWidthOutputField)<<dMin[nGamma][i]//72
-      <<std::setw(nWidthOutputField)<<dAve[nC][i]//73
-      <<std::setw(nWidthOutputField)<<dMax[nC][i]//74
-      <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nC][i]//75
-      <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nC][i]//76
-      <<std::setw(nWidthOutputField)<<dMin[nC][i]//77
-      <<std::setw(nWidthIntOutputField)<<nMinJIndex[nC][i]//78
-      <<std::setw(nWidthIntOutputField)<<nMinKIndex[nC][i]//79
-      <<std::setw(nWidthOutputField)<<dUpFlowFillingFactor[i];//80
-    if(bExtraInfoInProfile){
-      ofFile<<std::setw(nWidthOutputField)<<dDlnPDlnT//81
-        <<std::setw(nWidthOutputField)<<dDlnPDlnRho//82
-        <<std::setw(nWidthOutputField)<<dDEDT;//83
+    
+    //set the rest of the grid
+    nSizeX2=nSize[nD][0]+nGhostCellsX*2*nNumGhostCells;
+    nSizeY=nSize[nD][1]+nGhostCellsY*2*nNumGhostCells;
+    nSizeZ=nSize[nD][2]+nGhostCellsZ*2*nNumGhostCells;
+    nStartY=nGhostCellsY*nNumGhostCells;
+    nEndY=nSize[nD][1]+nStartY;
+    nStartZ=nGhostCellsZ*nNumGhostCells;
+    nEndZ=nSize[nD][2]+nStartZ;
+    profileShells shells;
+    shells.dGrid=dGrid;
+    shells.dMax=dMax;
+    shells.dMin=dMin;
+    shells.dAve=dAve;
+    shells.nMaxJIndex=nMaxJIndex;
+    shells.nMaxKIndex=nMaxKIndex;
+    shells.nMinJIndex=nMinJIndex;
+    shells.nMinKIndex=nMinKIndex;
+    shells.eosTable=&eosTable;
+    shells.indices=getGridIndices();
+    shells.nNumDims=nNumDims;
+    shells.nSizeX1=nSizeX1;
+    shells.nSizeX2=nSizeX2;
+    shells.nSizeY=nSizeY;
+    shells.nStartY=nStartY;
+    shells.nEndY=nEndY;
+    shells.nSizeZ=nSizeZ;
+    shells.nStartZ=nStartZ;
+    shells.nEndZ=nEndZ;
+    shells.dA=dA;
+    shells.dAVThreshold=dAVThreshold;
+    shells.nNext=nSizeX1;
+    shells.bError=false;
+    
+    //share the shells among the threads, in chunks of consecutive shells
+    int nThreads=std::min(nShellThreads
+      ,(nSizeX2-nSizeX1+nProfileShellChunk-1)/nProfileShellChunk);
+    if(nThreads<=1){
+      makeShellProfiles_TEOS(shells,nSizeX1,nSizeX2);
+    }
+    else{
+      pthread_mutex_init(&shells.mutex,NULL);
+      
+      //this thread also works on the shells, if a thread can't be created fewer are used
+      std::vector<pthread_t> vecThreads;
+      for(int t=1;t<nThreads;t++){
+        pthread_t threadTemp;
+        if(pthread_create(&threadTemp,NULL,profileShellWorker,(void*)(&shells))!=0){
+          break;
+        }
+        vecThreads.push_back(threadTemp);
+      }
+      profileShellWorker((void*)(&shells));
+      for(unsigned int t=0;t<vecThreads.size();t++){
+        pthread_join(vecThreads[t],NULL);
+      }
+      pthread_mutex_destroy(&shells.mutex);
+      if(shells.bError){
+        throw shells.eError;
+      }
     }
-    ofFile<<std::endl;
-  }
-  ofFile
-    <<std::setw(nWidthIntOutputField)<<(nSizeGlobe[0]+2*nNumGhostCells)//1
-    <<std::setw(nWidthOutputField)<<dGrid[nM][nSizeGlobe[0]+2*nNumGhostCells][0][0]//2
-    <<std::setw(nWidthOutputField)<<"-"//3
-    <<std::setw(nWidthOutputField)<<"-"//4
-    <<std::setw(nWidthOutputField)<<dGrid[nR][nSizeGlobe[0]+2*nNumGhostCells][0][0]//5
-    <<std::setw(nWidthOutputField)<<"-"//6
-    <<std::setw(nWidthOutputField)<<"-"//7
-    <<std::setw(nWidthOutputField)<<"-"//8
-    <<std::setw(nWidthIntOutputField)<<"-"//9
-    <<std::setw(nWidthIntOutputField)<<"-"//10
-    <<std::setw(nWidthOutputField)<<"-"//11
-    <<std::setw(nWidthIntOutputField)<<"-"//12
-    <<std::setw(nWidthIntOutputField)<<"-"//13
-    <<std::setw(nWidthOutputField)<<dAve[nU][nSizeGlobe[0]+2*nNumGhostCells]//14
-    <<std::setw(nWidthOutputField)<<dMax[nU][nSizeGlobe[0]+2*nNumGhostCells]//15
-    <<std::setw(nWidthIntOutputField)<<nMaxJIndex[nU][i]//16
-    <<std::setw(nWidthIntOutputField)<<nMaxKIndex[nU][i]//17
-    <<std::setw(nWidthOutputField)<<dMin[nU][nSizeGlobe[0]+2*nNumGhostCells]//18
-    <<std::setw(nWidthIntOutputField)<<nMinJIndex[nU][i]//19
-    <<std::setw(nWidthIntOutputField)<<nMinKIndex[nU][i]//20
-    <<std::setw(nWidthOutputField)<<dAve[nU0][nSizeGlobe[0]+2*nNumGhostCells]//21
-    <<std::setw(nWidthOutputField)<<"-"//22
-    <<std::setw(nWidthOutputField)<<"-"//23
-    <<std::setw(nWidthIntOutputField)<<"-"//24
-    <<std::setw(nWidthIntOutputField)<<"-"//25
-    <<std::setw(nWidthOutputField)<<"-"//26
-    <<std::setw(nWidthIntOutputField)<<"-"//27
-    <<std::setw(nWidthIntOutputField)<<"-"//28
-    <<std::setw(nWidthOutputField)<<"-"//29
-    <<std::setw(nWidthOutputField)<<"-"//30
-    <<std::setw(nWidthIntOutputField)<<"-"//31
-    <<std::setw(nWidthIntOutputField)<<"-"//32
-    <<std::setw(nWidthOutputField)<<"-"//33
-    <<std::setw(nWidthIntOutputField)<<"-"//34
-    <<std::setw(nWidthIntOutputField)<<"-"//35
-    <<std::setw(nWidthOutputField)<<"-"//36
-    <<std::setw(nWidthOutputField)<<"-"//37
-    <<std::setw(nWidthIntOutputField)<<"-"//38
-    <<std::setw(nWidthIntOutputField)<<"-"//39
-    <<std::setw(nWidthOutputField)<<"-"//40
-    <<std::setw(nWidthIntOutputField)<<"-"//41
-    <<std::setw(nWidthIntOutputField)<<"-"//42
-    <<std::setw(nWidthOutputField)<<"-"//43
-    <<std::setw(nWidthOutputField)<<"-"//44
-    <<std::setw(nWidthIntOutputField)<<"-"//45
-    <<std::setw(nWidthIntOutputField)<<"-"//46
-    <<std::setw(nWidthOutputField)<<"-"//47
-    <<std::setw(nWidthIntOutputField)<<"-"//48
-    <<std::setw(nWidthIntOutputField)<<"-"//49
-    <<std::setw(nWidthOutputField)<<"-"//50
-    <<std::setw(nWidthOutputField)<<"-"//51
-    <<std::setw(nWidthIntOutputField)<<"-"//52
-    <<std::setw(nWidthIntOutputField)<<"-"//53
-    <<std::setw(nWidthOutputField)<<"-"//54
-    <<std::setw(nWidthIntOutputField)<<"-"//55
-    <<std::setw(nWidthIntOutputField)<<"-"//56
-    <<std::setw(nWidthOutputField)<<"-"//57
-    <<std::setw(nWidthOutputField)<<"-"//58
-    <<std::setw(nWidthOutputField)<<"-"//59
-    <<std::setw(nWidthOutputField)<<dAve[nL_rad][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//60
-    <<std::setw(nWidthOutputField)<<dAve[nL_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//61
-    <<std::setw(nWidthOutputField)<<dAve[nF_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//62
-    <<std::setw(nWidthOutputField)<<dMax[nF_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//63
-    <<std::setw(nWidthOutputField)<<dMin[nF_con][nSizeGlobe[0]+2*nNumGhostCells-1]/dLSun//64
-    <<std::setw(nWidthOutputField)<<"-"//65
-    <<std::setw(nWidthOutputField)<<"-"//66
-    <<std::setw(nWidthOutputField)<<"-"//67
-    <<std::setw(nWidthOutputField)<<"-"//68
-    <<std::setw(nWidthOutputField)<<"-"//69
-    <<std::setw(nWidthOutputField)<<"-"//70
-    <<std::setw(nWidthOutputField)<<"-"//71
-    <<std::setw(nWidthOutputField)<<"-"//72
-    <<std::setw(nWidthOutputField)<<"-"//73
-    <<std::setw(nWidthOutputField)<<"-"//74
-    <<std::setw(nWidthIntOutputField)<<"-"//75
-    <<std::setw(nWidthIntOutputField)<<"-"//76
-    <<std::setw(nWidthOutputField)<<"-"//77
-    <<std::setw(nWidthIntOutputField)<<"-"//78
-    <<std::setw(nWidthIntOutputField)<<"-"//79
-    <<std::setw(nWidthOutputField)<<dUpFlowFillingFactor[nSizeGlobe[0]+2*nNumGhostCells];//80
-  if(bExtraInfoInProfile){
-    ofFile<<std::setw(nWidthOutputField)<<"-"//81
-      <<std::setw(nWidthOutputField)<<"-"//82
-      <<std::setw(nWidthOutputField)<<"-";//83
   }
-  ofFile<<std::endl;
-  
-  ofFile.close();
-  
-  //delete grid
-  for(int n=0;n<nNumVars;n++){
+  else{//set P, Q, KE, and C
+    
+    //allocate space
     nGhostCellsX=1;
-    if(nVarInfo[n][0]==-1){
+    if(nVarInfo[nD][0]==-1){/*all internal variables are cetnered quantities, will be the same as 
+      the density*/
       nGhostCellsX=0;
     }
     nGhostCellsY=1;
-    if(nVarInfo[n][1]==-1){
+    if(nVarInfo[nD][1]==-1){
       nGhostCellsY=0;
     }
     nGhostCellsZ=1;
-    if(nVarInfo[n][2]==-1){
+    if(nVarInfo[nD][2]==-1){
       nGhostCellsZ=0;
     }
-      
-    //delete 1D part of the grid
-    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);
-    if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
+    double dP;
+    double dQ;
+    double dMaxP;
+    double dMinP;
+    double dSumP;
+    double dMaxQ;
+    double dMinQ;
+    double dSumQ;
+    double dMaxC;
+    double dMinC;
+    double dSumC;
+    double dQ0=0.0;
+    double dQ1=0.0;
+    double dQ2=0.0;
+    double dRSq_i;
+    double dA_ip1half;
+    double dA_im1half;
+    double dTheta_j;
+    double dTheta_jp1half;
+    double dTheta_jm1half;
+    double dA_jp1half;
+    double dA_jm1half;
+    double dA_j;
+    double dASq=dA*dA;
+    double dC;
+    double dDVDtThreshold;
+    double dDVDt_mthreshold;
+    double dDVDt;
+    double dU_i;
+    
+    //set 1D part of the grid
+    nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);//may be need to +1 if only one proc and variable in interface centered
+    if (nVarInfo[nD][0]==1&&nPeriodic[0]==0){
       nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
     }
     nSizeY=1;
     nSizeZ=1;
-    for(i=0;i<nSizeX1;i++){
-      for(j=0;j<nSizeY;j++){
-        delete [] dGrid[n][i][j];
+    for(i=0;i<nSizeX1;i++){//find average max, and min in 1D region
+      
+      //calculate P
+      dP=dGrid[nD][i][0][0]*(dGamma-1.0)*dGrid[nE][i][0][0];
+      
+      //calculate Q
+      dRSq_i=(dGrid[nR][i+1][0][0]+dGrid[nR][i][0][0])*0.5;
+      dA_ip1half=dGrid[nR][i+1][0][0]*dGrid[nR][i+1][0][0];
+      dA_im1half=dGrid[nR][i][0][0]*dGrid[nR][i][0][0];
+      dC=sqrt(dGamma*dP/dGrid[nD][i][0][0]);
+      dDVDtThreshold=dAVThreshold*dC;
+      dDVDt=(dA_ip1half*dGrid[nU][i+1][0][0]
+        -dA_im1half*dGrid[nU][i][0][0])/dRSq_i;
+      if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+        dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+        dQ=dASq*dGrid[nD][i][0][0]*dDVDt_mthreshold*dDVDt_mthreshold;
       }
-      delete [] dGrid[n][i];
+      else{
+        dQ=0.0;
+      }
+      dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
+      dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
+      dMax[nP][i]=dP;
+      dMin[nP][i]=dP;
+      dAve[nP][i]=dP;
+      dMax[nQ][i]=dQ;
+      dMin[nQ][i]=dQ;
+      dAve[nQ][i]=dQ;
+      dMax[nC][i]=dC;
+      dMin[nC][i]=dC;
+      dAve[nC][i]=dC;
+      nMaxJIndex[nP][i]=0;
+      nMaxKIndex[nP][i]=0;
+      nMinJIndex[nP][i]=0;
+      nMinKIndex[nP][i]=0;
+      nMaxJIndex[nQ][i]=0;
+      nMaxKIndex[nQ][i]=0;
+      nMinJIndex[nQ][i]=0;
+      nMinKIndex[nQ][i]=0;
+      nMaxJIndex[nC][i]=0;
+      nMaxKIndex[nC][i]=0;
+      nMinJIndex[nC][i]=0;
+      nMinKIndex[nC][i]=0;
+      nMaxJIndex[nKEP][i]=0;
+      nMaxKIndex[nKEP][i]=0;
+      nMinJIndex[nKEP][i]=0;
+      nMinKIndex[nKEP][i]=0;
+      
     }
     
-    //read in the rest of the grid
-    nSizeX2=nSize[n][0]+nGhostCellsX*2*nNumGhostCells;
-    nSizeY=nSize[n][1]+nGhostCellsY*2*nNumGhostCells;//assume y and z are always periodic
-    nSizeZ=nSize[n][2]+nGhostCellsZ*2*nNumGhostCells;
+    //set the rest of the grid
+    nSizeX2=nSize[nD][0]+nGhostCellsX*2*nNumGhostCells;
+    nSizeY=nSize[nD][1]+nGhostCellsY*2*nNumGhostCells;
+    nSizeZ=nSize[nD][2]+nGhostCellsZ*2*nNumGhostCells;
+    nStartY=nGhostCellsY*nNumGhostCells;
+    nEndY=nSize[nD][1]+nStartY;
+    nStartZ=nGhostCellsZ*nNumGhostCells;
+    nEndZ=nSize[nD][2]+nStartZ;
     for(i=nSizeX1;i<nSizeX2;i++){
-      for(j=0;j<nSizeY;j++){
-        delete [] dGrid[n][i][j];
+      dMaxP=-1.0*std::numeric_limits<double>::max();
+      dMinP=std::numeric_limits<double>::max();
+      dSumP=0.0;
+      dMaxQ=-1.0*std::numeric_limits<double>::max();
+      dMinQ=std::numeric_limits<double>::max();
+      dSumQ=0.0;
+      dMaxC=-1.0*std::numeric_limits<double>::max();
+      dMinC=std::numeric_limits<double>::max();
+      dSumC=0.0;
+      nCount=0;
+      for(j=nStartY;j<nEndY;j++){
+        dTheta_jp1half=dGrid[nTheta][0][j][0];
+        if(j==0){
+          dTheta_jm1half=dGrid[nTheta][0][j][0]-(dGrid[nTheta][0][j+1][0]-dGrid[nTheta][0][j][0]);
+        }
+        dTheta_j=(dTheta_jp1half+dTheta_jm1half)*0.5;
+        dA_jp1half=sin(dTheta_jp1half);
+        dA_jm1half=sin(dTheta_jm1half);;
+        dA_j=sin(dTheta_j);
+        for(k=nStartZ;k<nEndZ;k++){
+          
+          //calculate P
+          dP=dGrid[nD][i][j][k]*(dGamma-1.0)*dGrid[nE][i][j][k];
+        
+          //calculate Q
+          dC=sqrt(dGamma*dP/dGrid[nD][i][j][k]);
+          dDVDtThreshold=dAVThreshold*dC;
+          if(nNumDims>=1){
+            dDVDt=(dA_ip1half*dGrid[nU][i+1][j][k]
+              -dA_im1half*dGrid[nU][i][j][k])/dRSq_i;
+            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+              dQ0=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
+            }
+            else{
+              dQ0=0.0;
+            }
+          }
+          else if(nNumDims>=2){
+            if(j==0){
+              dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
+                -dA_jm1half*dGrid[nV][i][nSizeY-1][k])/dA_j;
+            }
+            else{
+              dDVDt=(dA_jp1half*dGrid[nV][i][j][k]
+                -dA_jm1half*dGrid[nV][i][j-1][k])/dA_j;
+            }
+            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+              dQ1=dASq*dGrid[nD][i][j][k]
+                *dDVDt_mthreshold*dDVDt_mthreshold;
+            }
+            else{
+              dQ1=0.0;
+            }
+          }
+          else if(nNumDims==3){
+            if(k==0){
+              dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][nSizeZ-1]);
+            }
+            else{
+              dDVDt=(dGrid[nW][i][j][k]-dGrid[nW][i][j][k-1]);
+            }
+            if(dDVDt<-1.0*dDVDtThreshold){//being compressed
+              dDVDt_mthreshold=dDVDt+dDVDtThreshold;
+              dQ2=dASq*dGrid[nD][i][j][k]*dDVDt_mthreshold*dDVDt_mthreshold;
+            }
+            else{
+              dQ2=0.0;
+            }
+          }
+          dQ=dQ0+dQ1+dQ2;
+          
+          if(dP>dMaxP){
+            dMaxP=dP;
+            nMaxJIndex[nP][i]=j;
+            nMaxKIndex[nP][i]=k;
+          }
+          if(dP<dMinP){
+            dMinP=dP;
+            nMinJIndex[nP][i]=j;
+            nMinKIndex[nP][i]=k;
+          }
+          dSumP+=dP;
+          if(dQ>dMaxQ){
+            dMaxQ=dQ;
+            nMaxJIndex[nQ][i]=j;
+            nMaxKIndex[nQ][i]=k;
+          }
+          if(dQ<dMinQ){
+            dMinQ=dQ;
+            nMinJIndex[nQ][i]=j;
+            nMinKIndex[nQ][i]=k;
+          }
+          dSumQ+=dQ;
+          if(dC>dMaxC){
+            dMaxC=dC;
+            nMaxJIndex[nC][i]=j;
+            nMaxKIndex[nC][i]=k;
+          }
+          if(dC<dMinC){
+            dMinC=dC;
+            nMinJIndex[nC][i]=j;
+            nMinKIndex[nC][i]=k;
+          }
+          dSumC+=dC;
+          
+          nCount++;
+        }
       }
-      delete [] dGrid[n][i];
+      dU_i=(dGrid[nU0][i+1][0][0]+dGrid[nU0][i][0][0])*0.5;
+      if(nNumDims==3){
+        dAve[nD][i]=dCalRhoAve3D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
+      }
+      else if(nNumDims==2){
+        dAve[nD][i]=dCalRhoAve2D(dGrid,i,nStartY,nEndY,nStartZ,nEndZ);
+      }
+      else{
+        dAve[nD][i]=dGrid[nD][i][0][0];
+      }
+      dAve[nKEP][i]=0.5*dGrid[nDM][i][0][0]*dU_i*dU_i;
+      dMax[nP][i]=dMaxP;
+      dMin[nP][i]=dMinP;
+      dAve[nP][i]=dSumP/double(nCount);
+      dMax[nQ][i]=dMaxQ;
+      dMin[nQ][i]=dMinQ;
+      dAve[nQ][i]=dSumQ/double(nCount);
+      dMax[nC][i]=dMaxC;
+      dMin[nC][i]=dMinC;
+      dAve[nC][i]=dSumC/double(nCount);
+      nMaxJIndex[nKEP][i]=0;
+      nMaxKIndex[nKEP][i]=0;
+      nMinJIndex[nKEP][i]=0;
+      nMinKIndex[nKEP][i]=0;
     }
-    delete [] dGrid[n];
-    
-    delete [] dMax[n];
-    delete [] dMin[n];
-    delete [] dAve[n];
-    delete [] nMaxJIndex[n];
-    delete [] nMaxKIndex[n];
-    delete [] nMinJIndex[n];
-    delete [] nMinKIndex[n];
-  }
-  delete [] dMax;
-  delete [] dMin;
-  delete [] dAve;
-  delete [] nMaxJIndex;
-  delete [] nMaxKIndex;
-  delete [] nMinJIndex;
-  delete [] nMinKIndex;
-  delete [] dGrid;
+  }
   
-  delete [] dUpFlowFillingFactor;
+  //hand the profile statistics to the caller, the grid belongs to the dump file
+  profile.dGrid=dGrid;
+  profile.nNumVars=nNumVars;
+  profile.nNumIntVars=nNumIntVars;
+  profile.dMax=dMax;
+  profile.dMin=dMin;
+  profile.dAve=dAve;
+  profile.nMaxJIndex=nMaxJIndex;
+  profile.nMaxKIndex=nMaxKIndex;
+  profile.nMinJIndex=nMinJIndex;
+  profile.nMinKIndex=nMinKIndex;
+  profile.dUpFlowFillingFactor=dUpFlowFillingFactor;
   for(int n=0;n<nNumVars;n++){
     delete [] nSize[n];
     delete [] nVarInfo[n];
@@ -4181,11 +4828,57 @@ void makeRadialProFromColBin(std::string sFileName){//updated
   delete [] nSize;
   delete [] nVarInfo;
 }
+void freeRadialProfile(radialProfile &profile){
+  for(int n=0;n<profile.nNumVars+profile.nNumIntVars;n++){
+    delete [] profile.dMax[n];
+    delete [] profile.dMin[n];
+    delete [] profile.dAve[n];
+    delete [] profile.nMaxJIndex[n];
+    delete [] profile.nMaxKIndex[n];
+    delete [] profile.nMinJIndex[n];
+    delete [] profile.nMinKIndex[n];
+  }
+  delete [] profile.dMax;
+  delete [] profile.dMin;
+  delete [] profile.dAve;
+  delete [] profile.nMaxJIndex;
+  delete [] profile.nMaxKIndex;
+  delete [] profile.nMinJIndex;
+  delete [] profile.nMinKIndex;
+  delete [] profile.dUpFlowFillingFactor;
+}
 void fpSignalHandler(int nSig){
   std::stringstream ssTemp;
   ssTemp<<"Floating point signal "<<nSig<<" detected. Aborting program\n";
   throw exception2(ssTemp.str(),CALCULATION);
 }
+void readSliceVariable(dumpFile &dump,int nVar,const std::vector<bool> &vecbRowsX
+  ,const std::vector<bool> &vecbRowsY,int nStartZ,int nEndZ,double ***dVariable){
+  
+  //copy 1D part of the variable, it is small so always copy all of it
+  int nSizeX1=dump.nSizeX1[nVar];
+  int nSizeX2=dump.nSizeX2[nVar];
+  int nSizeY=dump.nSizeY[nVar];
+  int nSizeZ=dump.nSizeZ[nVar];
+  for(int i=0;i<nSizeX1;i++){
+    dVariable[i]=new double*[1];
+    dVariable[i][0]=new double[1];
+    dump.copyValues(nVar,dump.nRowStart(nVar,i,0),1,dVariable[i][0]);
+  }
+  
+  //copy the needed rows of the rest of the variable, rows not needed are left NULL
+  for(int i=nSizeX1;i<nSizeX2;i++){
+    dVariable[i]=new double*[nSizeY];
+    for(int j=0;j<nSizeY;j++){
+      dVariable[i][j]=NULL;
+      if(vecbRowsX[i]&&vecbRowsY[j]){
+        dVariable[i][j]=new double[nSizeZ]();
+        dump.copyValues(nVar,dump.nRowStart(nVar,i,j)+nStartZ,size_t(nEndZ-nStartZ+1)
+          ,dVariable[i][j]+nStartZ);
+      }
+    }
+  }
+}
 void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex){//updated
   
   int nWidthOutputField=25;
@@ -4197,120 +4890,39 @@ void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex){//updated
       <<": no input file specified\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  std::ifstream ifFile;
-  ifFile.open(sFileName.c_str(),std::ios::binary);
-  if(!ifFile.good()){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" didn't open properly\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //check that it is a binary file
-  char cTemp;
-  ifFile.read((char*)(&cTemp),sizeof(char));
-  if(cTemp!='b'){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" isn't a binary file.\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //check that it is the correct version
-  int nTemp;
-  ifFile.read((char*)(&nTemp),sizeof(int));
-  if(nTemp!=nDumpFileVersion){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": inpput file \""
-      <<sFileName<<"\" version \""<<nTemp
-      <<"\" isn't the supported version \""<<nDumpFileVersion<<"\".\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //read in binary input file and write out in averaged profiles
-  
-  //read in time
-  double dTime;
-  ifFile.read((char*)(&dTime),sizeof(double));
-  
-  //read in the time step index
-  int nTimeStepIndex;
-  ifFile.read((char*)(&nTimeStepIndex),sizeof(int));
-  
-  //read in timestep
-  double dTimeStep1;
-  ifFile.read((char*)(&dTimeStep1),sizeof(double));
-  
-  //read in timestep
-  double dTimeStep2;
-  ifFile.read((char*)(&dTimeStep2),sizeof(double));
-  
-  //read in alpha
-  double dAlpha;
-  ifFile.read((char*)(&dAlpha),sizeof(double));
-  
-  //read in gamma law
-  int nGammaLaw;
-  ifFile.read((char*)(&nGammaLaw),sizeof(int));
-  
-  double dGamma;
+  dumpFile dump;
+  dump.open(sFileName,nDumpFileVersion);
+  double dTime=dump.dTime;
+  int nGammaLaw=int(dump.sEOSFileName.size());
+  double dGamma=dump.dGamma;
   std::string sEOSTable;
   eos eosTable;
-  if(nGammaLaw==0){
-    ifFile.read((char*)(&dGamma),sizeof(double));
-  }
-  else{
-    char *cBuffer=new char[nGammaLaw+1];
-    ifFile.read(cBuffer,nGammaLaw*sizeof(char));
-    cBuffer[nGammaLaw]='\0';
-    sEOSTable=cBuffer;
-    delete [] cBuffer;
+  if(!dump.bGammaLaw){
+    sEOSTable=dump.sEOSFileName;
     if(sEOSFile!=""){//overwrite sEOSTable if sEOSFile is set
       sEOSTable=sEOSFile;
     }
-    eosTable.readBin(sEOSTable);
+    eosTable=getEOSTable(sEOSTable);
   }
-  
-  //read in artificial viscosity
-  double dA;
-  ifFile.read((char*)(&dA),sizeof(double));
+  double dA=dump.dA;
   double dASq=dA*dA;
-  
-  //read in artificial viscosity threshold
-  double dAVThreshold;
-  ifFile.read((char*)(&dAVThreshold),sizeof(double));
-  
-  //read in global grid size
-  int nSizeGlobe[3];
-  ifFile.read((char*)(nSizeGlobe),3*sizeof(int));
-  
-  //read in periodicity
-  int nPeriodic[3];
-  ifFile.read((char*)(nPeriodic),3*sizeof(int));
-  
-  //read in number of 1D Zones
-  int nNum1DZones;
-  ifFile.read((char*)(&nNum1DZones),sizeof(int));
-  
-  //read in number of ghostcells
-  int nNumGhostCells;
-  ifFile.read((char*)(&nNumGhostCells),sizeof(int));
-  
-  //read in number of grid variables
-  int nNumVars;
-  ifFile.read((char*)(&nNumVars),sizeof(int));
-  
-  //get variable info, and set grid sizes
+  double dAVThreshold=dump.dAVThreshold;
+  int nSizeGlobe[3]={dump.nGlobalGridDims[0],dump.nGlobalGridDims[1],dump.nGlobalGridDims[2]};
+  int nPeriodic[3]={dump.nPeriodic[0],dump.nPeriodic[1],dump.nPeriodic[2]};
+  int nNum1DZones=dump.nNum1DZones;
+  int nNumGhostCells=dump.nNumGhostCells;
+  int nNumVars=dump.nNumVars;
+  
+  //set grid sizes
   int **nSize=new int*[nNumVars];
   int **nVarInfo=new int*[nNumVars];
   for(int n=0;n<nNumVars;n++){
     nSize[n]=new int[3];
-    nVarInfo[n]=new int[3];
-    ifFile.read((char*)(nVarInfo[n]),(4)*sizeof(int));
+    nVarInfo[n]=new int[4];
+    for(int l=0;l<4;l++){
+      nVarInfo[n][l]=dump.nVarInfo[n][l];
+    }
     for(int l=0;l<3;l++){
-      if(nSizeGlobe[l]==1){
-        nVarInfo[n][l]=-1;
-      }
       if(nVarInfo[n][l]==-1){//variable not defined in direction l
         nSize[n][l]=1;
       }
@@ -4336,72 +4948,7 @@ void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex){//updated
   if(nSizeGlobe[2]==1){
     nSize2=nSizeGlobe[2]+1;//don't need ghost cells if grid not defined in direction l
   }
-  
-  //figure out number of dimensions
-  int nNumDims=0;
-  if(nSizeGlobe[0]>1){
-    nNumDims++;
-  }
-  if(nSizeGlobe[1]>1){
-    nNumDims++;
-  }
-  if(nSizeGlobe[2]>1){
-    nNumDims++;
-  }
-  
-  //read in grid
-  double ****dGrid=new double***[nNumVars];
-  for(int n=0;n<nNumVars;n++){
-    
-    int nGhostCellsX=1;
-    if(nVarInfo[n][0]==-1){
-      nGhostCellsX=0;
-    }
-    int nGhostCellsY=1;
-    if(nVarInfo[n][1]==-1){
-      nGhostCellsY=0;
-    }
-    int nGhostCellsZ=1;
-    if(nVarInfo[n][2]==-1){
-      nGhostCellsZ=0;
-    }
-    
-    dGrid[n]=new double**[nSize[n][0]+nGhostCellsX*2*nNumGhostCells];
-    
-    //read in 1D part of the grid
-    int nSizeX1=nGhostCellsX*(nNum1DZones+nNumGhostCells);//may be need to +1 if only one proc and variable in interface centered
-    if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
-      nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
-    }
-    int nSizeY=1;
-    int nSizeZ=1;
-    for(int i=0;i<nSizeX1;i++){
-      dGrid[n][i]=new double*[nSizeY];
-      for(int j=0;j<nSizeY;j++){
-        dGrid[n][i][j]=new double[nSizeZ];
-        ifFile.read((char*)(dGrid[n][i][j]),nSizeZ*sizeof(double));
-      }
-    }
-    
-    //read in the rest of the grid
-    int nSizeX2=nSize[n][0]+nGhostCellsX*2*nNumGhostCells;
-    nSizeY=nSize[n][1]+nGhostCellsY*2*nNumGhostCells;
-    nSizeZ=nSize[n][2]+nGhostCellsZ*2*nNumGhostCells;
-    for(int i=nSizeX1;i<nSizeX2;i++){
-      dGrid[n][i]=new double*[nSizeY];
-      for(int j=0;j<nSizeY;j++){
-        if(ifFile.eof()){
-          std::stringstream ssTemp;
-          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": reached end of file sooner than expected\n";
-          throw exception2(ssTemp.str(),INPUT);
-        }
-        dGrid[n][i][j]=new double[nSizeZ];
-        ifFile.read((char*)(dGrid[n][i][j]),(nSizeZ)*sizeof(double));
-      }
-    }
-  }
-  ifFile.close();
+  int nNumDims=dump.nNumDims;
   
   //set variable indices
   if(nGammaLaw==0){//using gamma law gas
@@ -4536,6 +5083,50 @@ void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex){//updated
     }
   }
   
+  //copy only the parts of the grid the plane needs out of the dump file
+  double ****dGrid=new double***[nNumVars];
+  for(int n=0;n<nNumVars;n++){
+    int nSizeX2=dump.nSizeX2[n];
+    int nSizeY=dump.nSizeY[n];
+    int nSizeZ=dump.nSizeZ[n];
+    
+    /*pick the rows and the range in the z-direction needed, neighbours of the plane are used for
+    the artificial viscosity, including the periodic neighbour across the grid edge. Coordinate
+    and radial only variables are small and always copied in full.*/
+    std::vector<bool> vecbRowsX(nSizeX2,true);
+    std::vector<bool> vecbRowsY(nSizeY,true);
+    int nStartZ=0;
+    int nEndZ=nSizeZ-1;
+    if(nVarInfo[n][0]!=-1&&(nSizeY>1||nSizeZ>1)){
+      if(nPlane==0&&nPlaneIndex>0){//r-theta
+        nStartZ=std::max(0,nPlaneIndex-1);
+        nEndZ=std::min(nSizeZ-1,nPlaneIndex+1);
+      }
+      else if(nPlane==1){//theta-phi
+        vecbRowsX.assign(nSizeX2,false);
+        for(int i=nPlaneIndex-1;i<=nPlaneIndex+1;i++){
+          if(i>=0&&i<nSizeX2){
+            vecbRowsX[i]=true;
+          }
+        }
+      }
+      else if(nPlane==2){//r-phi
+        vecbRowsY.assign(nSizeY,false);
+        for(int j=nPlaneIndex-1;j<=nPlaneIndex+1;j++){
+          if(j>=0&&j<nSizeY){
+            vecbRowsY[j]=true;
+          }
+        }
+        if(nPlaneIndex==0){
+          vecbRowsY[nSizeY-1]=true;
+        }
+      }
+    }
+    
+    dGrid[n]=new double**[nSizeX2];
+    readSliceVariable(dump,n,vecbRowsX,vecbRowsY,nStartZ,nEndZ,dGrid[n]);
+  }
+  
   //open output file
   std::stringstream sFileNameOut;
   if(nPlane==0){//r-theta plane
@@ -4621,9 +5212,9 @@ void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex){//updated
   double dE;
   double dKappa;
   double dQ;
-  double dQ0;
-  double dQ1;
-  double dQ2;
+  double dQ0=0.0;
+  double dQ1=0.0;
+  double dQ2=0.0;
   double dR_i;
   double dRSq_i;
   double dA_ip1half;
@@ -6434,7 +7025,7 @@ void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex){//updated
           if(nNumDims>=2){
             if(nPlaneIndex==0){
               dDVDt=(dA_jp1half*dGrid[nV][i][nPlaneIndex][k]
-                -dA_jm1half*dGrid[nV][i][nSizeY2-1][nPlaneIndex])/dA_j;
+                -dA_jm1half*dGrid[nV][i][nSizeY2-1][k])/dA_j;
             }
             else{
               dDVDt=(dA_jp1half*dGrid[nV][i][nPlaneIndex][k]
@@ -6542,9 +7133,21 @@ void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex){//updated
   
   ofFile.close();
   for(int n=0;n<nNumVars;n++){
+    for(int i=0;i<dump.nSizeX2[n];i++){
+      int nSizeY=dump.nSizeY[n];
+      if(i<dump.nSizeX1[n]){
+        nSizeY=1;
+      }
+      for(int j=0;j<nSizeY;j++){
+        delete [] dGrid[n][i][j];
+      }
+      delete [] dGrid[n][i];
+    }
+    delete [] dGrid[n];
     delete [] nSize[n];
     delete [] nVarInfo[n];
   }
+  delete [] dGrid;
   delete [] nSize;
   delete [] nVarInfo;
 }
@@ -6562,6 +7165,12 @@ watchzone readInWatchZone(std::string sFileName){
       throw exception2(ssTemp.str());
   }
   
+  //check if it is a binary watch zone file
+  if(ifIn.peek()=='w'){
+    ifIn.close();
+    return readInWatchZoneBin(sFileName);
+  }
+  
   //through out first and second lines
   std::string sLine;
   std::getline(ifIn,sLine);//first
@@ -6804,159 +7413,208 @@ watchzone readInWatchZone(std::string sFileName){
   }
   return watchzoneTemp;
 }
-void convertBinToLNA(std::string sFileName){
+void openWatchZoneBin(std::string sFileName,std::ifstream &ifIn,int nZone[3],bool &bIsGammaLaw
+  ,double &dGamma){
   
-  //open input file
-  if(sFileName.size()==0){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-      <<":no input file specified\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  if(sFileName.substr(sFileName.length()-4,4)==".txt"){
-    //try it without extension
-    sFileName=sFileName.substr(0,sFileName.length()-4);
-  }
-  std::ifstream ifFile;
-  ifFile.open(sFileName.c_str(),std::ios::binary);
-  if(!ifFile.good()){
+  //open file
+  ifIn.open(sFileName.c_str(),std::ios::binary);
+  if(!ifIn.good()){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
       <<sFileName<<"\" didn't open properly\n";
     throw exception2(ssTemp.str(),INPUT);
   }
   
-  //check that it is a binary file
+  //check that it is a binary watch zone file
   char cTemp;
-  ifFile.read((char*)(&cTemp),sizeof(char));
-  if(cTemp!='b'){
+  ifIn.read((char*)(&cTemp),sizeof(char));
+  if(cTemp!='w'){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" isn't a binary file.\n";
+      <<sFileName<<"\" isn't a binary watch zone file.\n";
     throw exception2(ssTemp.str(),INPUT);
   }
   
   //check that it is the correct version
   int nTemp;
-  ifFile.read((char*)(&nTemp),sizeof(int));
-  if(nTemp!=nDumpFileVersion){
+  ifIn.read((char*)(&nTemp),sizeof(int));
+  if(nTemp!=1){
     std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": inpput file \""
-      <<sFileName<<"\" version \""<<nTemp
-      <<"\" isn't the supported version \""<<nDumpFileVersion<<"\".\n";
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" is version "<<nTemp<<", and this code works with version 1.\n";
     throw exception2(ssTemp.str(),INPUT);
   }
   
-  //open output file
-  std::string sFileNameOut=sFileName+"_LNA.txt";
-  std::ofstream ofFile;
-  ofFile.open(sFileNameOut.c_str());
-  if(!ofFile.good()){
+  //read zone, equation of state, and number of columns
+  ifIn.read((char*)(nZone),3*sizeof(int));
+  ifIn.read((char*)(&nTemp),sizeof(int));
+  bIsGammaLaw=(nTemp==1);
+  ifIn.read((char*)(&dGamma),sizeof(double));
+  ifIn.read((char*)(&nTemp),sizeof(int));
+  if(nTemp!=nNumWatchZoneColumns){
     std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
-      <<sFileNameOut<<" didn't open properly\n";
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" has "<<nTemp<<" columns, expected "<<nNumWatchZoneColumns<<".\n";
     throw exception2(ssTemp.str(),INPUT);
   }
+}
+watchzone readInWatchZoneBin(std::string sFileName){
   
-  //read in binary input file and write out in LNA format
-  
-  //read in time
-  double dTime;
-  ifFile.read((char*)(&dTime),sizeof(double));
-  
-  //read in time step index
+  watchzone watchzoneTemp;
+  std::ifstream ifIn;
+  int nZone[3];
+  bool bIsGammaLaw;
+  double dGamma;
+  openWatchZoneBin(sFileName,ifIn,nZone,bIsGammaLaw,dGamma);
+  
+  //vectors to store each column in, eddy viscosity (column 18) is not kept
+  std::vector<double>* vecdColumns[nNumWatchZoneColumns]={&watchzoneTemp.vecdT
+    ,&watchzoneTemp.vecdU_ip1half,&watchzoneTemp.vecdU_im1half,&watchzoneTemp.vecdU0_ip1half
+    ,&watchzoneTemp.vecdU0_im1half,&watchzoneTemp.vecdQ0,&watchzoneTemp.vecdV_jp1half
+    ,&watchzoneTemp.vecdV_jm1half,&watchzoneTemp.vecdQ1,&watchzoneTemp.vecdW_kp1half
+    ,&watchzoneTemp.vecdW_km1half,&watchzoneTemp.vecdQ2,&watchzoneTemp.vecdR_ip1half
+    ,&watchzoneTemp.vecdR_im1half,&watchzoneTemp.vecdDensity,&watchzoneTemp.vecdDensityAve,NULL
+    ,&watchzoneTemp.vecdE,&watchzoneTemp.vecdP,&watchzoneTemp.vecdTemp
+    ,&watchzoneTemp.vecdDelM_r_t0,&watchzoneTemp.vecdDelM_r,&watchzoneTemp.vecdErrorDelM_r};
+  
+  //read in records, undefined values are skipped as in the text format
   int nTimeStepIndex;
-  ifFile.read((char*)(&nTimeStepIndex),sizeof(int));
-  
-  //read in last timestep
-  double dTimeStep1;
-  ifFile.read((char*)(&dTimeStep1),sizeof(double));
-  
-  //read in last timestep
-  double dTimeStep2;
-  ifFile.read((char*)(&dTimeStep2),sizeof(double));
-  
-  //read in alpha
-  double dAlpha;
-  ifFile.read((char*)(&dAlpha),sizeof(double));
+  double dValues[nNumWatchZoneColumns];
+  while(ifIn.read((char*)(&nTimeStepIndex),sizeof(int))
+    &&ifIn.read((char*)(dValues),nNumWatchZoneColumns*sizeof(double))){
+    for(int n=0;n<nNumWatchZoneColumns;n++){
+      if(vecdColumns[n]!=NULL&&dValues[n]==dValues[n]){
+        vecdColumns[n]->push_back(dValues[n]);
+      }
+    }
+  }
+  ifIn.close();
+  return watchzoneTemp;
+}
+void convertWatchZoneBinToAscii(std::string sFileName){
   
-  //read in equation of state info
-  int nGammaLaw;
+  std::ifstream ifIn;
+  int nZone[3];
+  bool bIsGammaLaw;
   double dGamma;
-  std::string sEOSTable;
-  ifFile.read((char*)(&nGammaLaw),sizeof(int));
-  if(nGammaLaw==0){
-    ifFile.read((char*)(&dGamma),sizeof(double));
+  openWatchZoneBin(sFileName,ifIn,nZone,bIsGammaLaw,dGamma);
+  
+  //open output file
+  std::string sOutFileName=sFileName;
+  size_t nExtension=sOutFileName.find_last_of(".");
+  if(nExtension!=std::string::npos){
+    sOutFileName=sOutFileName.substr(0,nExtension);
   }
-  else{
-    char *cBuffer=new char[nGammaLaw+1];
-    ifFile.read(cBuffer,nGammaLaw*sizeof(char));
-    cBuffer[nGammaLaw]='\0';
-    sEOSTable=cBuffer;
-    delete [] cBuffer;
+  sOutFileName=sOutFileName+".txt";
+  std::ofstream ofOut;
+  ofOut.open(sOutFileName.c_str());
+  if(!ofOut.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
+      <<sOutFileName<<"\" didn't open properly\n";
+    throw exception2(ssTemp.str(),OUTPUT);
   }
   
-  //read in/write out artificial viscosity
-  double dAV;
-  ifFile.read((char*)(&dAV),sizeof(double));
+  //write header, the same as SPHERLS writes for text watch zone files
+  ofOut.precision(14);
+  ofOut.setf(std::ios::scientific);
+  int nWidthOutputField=23;
+  std::stringstream ssHeader;
+  ssHeader<<"zone= ("<<nZone[0]<<","<<nZone[1]<<","<<nZone[2]<<")";
+  if(bIsGammaLaw){
+    ssHeader.precision(14);
+    ssHeader.setf(std::ios::scientific);
+    ssHeader<<" gamma= "<<dGamma;
+  }
+  ofOut<<std::setw(8+23*23)<<std::left<<ssHeader.str()<<"\n";
+  ofOut<<std::right
+    <<std::setw(8)<<"j(1)"
+    <<std::setw(nWidthOutputField)<<"t[s](2)"
+    <<std::setw(nWidthOutputField)<<"u_ip1half[cm/s](3)"
+    <<std::setw(nWidthOutputField)<<"u_im1half[cm/s](4)"
+    <<std::setw(nWidthOutputField)<<"u_0_ip1half[cm/s](5)"
+    <<std::setw(nWidthOutputField)<<"u_0_im1half[cm/s](6)"
+    <<std::setw(nWidthOutputField)<<"q0[dyne/cm^2](7)"
+    <<std::setw(nWidthOutputField)<<"v_jp1half[cm/s](8)"
+    <<std::setw(nWidthOutputField)<<"v_jm1half[cm/s](9)"
+    <<std::setw(nWidthOutputField)<<"q1[dyne/cm^2](10)"
+    <<std::setw(nWidthOutputField)<<"w_kp1half[cm/s](11)"
+    <<std::setw(nWidthOutputField)<<"w_km1half[cm/s](12)"
+    <<std::setw(nWidthOutputField)<<"q2[dyne/cm^2](13)"
+    <<std::setw(nWidthOutputField)<<"R_ip1half[cm](14)"
+    <<std::setw(nWidthOutputField)<<"R_im1half[cm](15)"
+    <<std::setw(nWidthOutputField)<<"Density[g/cm^3](16)"
+    <<std::setw(nWidthOutputField)<<"Den_ave[g/cm^3](17)"
+    <<std::setw(nWidthOutputField)<<"Eddy_Visc(18)"
+    <<std::setw(nWidthOutputField)<<"E[erg/g](19)"
+    <<std::setw(nWidthOutputField)<<"P[dyne/cm^2](20)"
+    <<std::setw(nWidthOutputField)<<"T[K](21)"
+    <<std::setw(nWidthOutputField)<<"DMr(t=0)[g](22)"
+    <<std::setw(nWidthOutputField)<<"Del_MCalc[g](23)"
+    <<std::setw(nWidthOutputField)<<"Rel_Error_Del_M(24)"
+    <<"\n";
+  
+  //write out records
+  int nTimeStepIndex;
+  double dValues[nNumWatchZoneColumns];
+  while(ifIn.read((char*)(&nTimeStepIndex),sizeof(int))
+    &&ifIn.read((char*)(dValues),nNumWatchZoneColumns*sizeof(double))){
+    ofOut<<std::setw(8)<<nTimeStepIndex;
+    for(int n=0;n<nNumWatchZoneColumns;n++){
+      ofOut<<std::setw(nWidthOutputField);
+      if(dValues[n]!=dValues[n]){//not defined for this zone
+        ofOut<<"-";
+      }
+      else{
+        ofOut<<dValues[n];
+      }
+    }
+    ofOut<<"\n";
+  }
+  ofOut.close();
+  ifIn.close();
+}
+void convertBinToLNA(std::string sFileName){
   
-  //read in/write out artificial viscosity threshold
-  double dAVThreshold;
-  ifFile.read((char*)(&dAVThreshold),sizeof(double));
+  //open input file
+  if(sFileName.size()==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<":no input file specified\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  if(sFileName.substr(sFileName.length()-4,4)==".txt"){
+    //try it without extension
+    sFileName=sFileName.substr(0,sFileName.length()-4);
+  }
+  dumpFile dump;
+  dump.open(sFileName,nDumpFileVersion);
   
-  //read in global grid size
-  int nSizeGlobe[3];
-  ifFile.read((char*)(nSizeGlobe),3*sizeof(int));
+  //open output file
+  std::string sFileNameOut=sFileName+"_LNA.txt";
+  std::ofstream ofFile;
+  ofFile.open(sFileNameOut.c_str());
+  if(!ofFile.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
+      <<sFileNameOut<<" didn't open properly\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
   
-  //figure out number of dimensions
+  //write out in LNA format
   int nNumDims=1;
-  if(nSizeGlobe[1]>1){
+  if(dump.nGlobalGridDims[1]>1){
     nNumDims++;
   }
-  if(nSizeGlobe[2]>1){
+  if(dump.nGlobalGridDims[2]>1){
     nNumDims++;
   }
+  int nNumGhostCells=dump.nNumGhostCells;
   
-  //read in periodicity
-  int nPeriodic[3];
-  ifFile.read((char*)(nPeriodic),3*sizeof(int));
-  
-  //read in number of 1D Zones
-  int nNum1DZones;
-  ifFile.read((char*)(&nNum1DZones),sizeof(int));
-  
-  //read in number of ghostcells
-  int nNumGhostCells;
-  ifFile.read((char*)(&nNumGhostCells),sizeof(int));
-  
-  //read in number of grid variables
-  int nNumVars;
-  ifFile.read((char*)(&nNumVars),sizeof(int));
-  
-  //get variable info, and set grid sizes
-  int **nSize=new int*[nNumVars];
-  int **nVarInfo=new int*[nNumVars];
-  for(int n=0;n<nNumVars;n++){
-    nSize[n]=new int[3];
-    nVarInfo[n]=new int[4];
-    ifFile.read((char*)(nVarInfo[n]),(4)*sizeof(int));
-    for(int l=0;l<3;l++){
-      if(nVarInfo[n][l]==-1){//variable not defined in direction l
-        nSize[n][l]=1;
-      }
-      else if(nVarInfo[n][l]==1&&nPeriodic[l]==0){//interface variable
-        nSize[n][l]=nSizeGlobe[l]+1;
-      }
-      else{
-        nSize[n][l]=nSizeGlobe[l];
-      }
-    }
-  }
-  
-  ofFile<<" "<<nSize[5][0]+nNumGhostCells;
+  ofFile<<" "<<dump.nSize[5][0]+nNumGhostCells;
   ofFile.precision(5);
-  if(nGammaLaw==0){
-    ofFile<<"  "<<dGamma<<std::endl;
+  if(dump.bGammaLaw){
+    ofFile<<"  "<<dump.dGamma<<std::endl;
   }
   else{
     ofFile<<"  "<<-1.0<<std::endl;
@@ -6966,208 +7624,93 @@ void convertBinToLNA(std::string sFileName){
   std::vector<double> vecdRadius;
   std::vector<double> vecdMass;
   
-  //read in the grid
-  for(int n=0;n<nNumVars;n++){
-    int nGhostCellsX=1;
-    if(nVarInfo[n][0]==-1){
-      nGhostCellsX=0;
-    }
-    int nGhostCellsY=1;
-    if(nVarInfo[n][1]==-1){
-      nGhostCellsY=0;
-    }
-    int nGhostCellsZ=1;
-    if(nVarInfo[n][2]==-1){
-      nGhostCellsZ=0;
-    }
-    
-    //read in 1D part of the grid
-    int nSizeX=nGhostCellsX*(nNum1DZones+nNumGhostCells);/*may be need to +1 if only one proc 
-      and variable in interface centered*/
-    if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
-      nSizeX=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
-    }
-    int nSizeY=1;
-    int nSizeZ=1;
-    for(int i=0;i<nSizeX;i++){
+  //average the grid over each radial row
+  double ****dGrid=dump.getGrid();
+  for(int n=0;n<dump.nNumVars;n++){
+    for(int i=nNumGhostCells;i<dump.nSizeX2[n];i++){//remove inner ghost cells
+      int nSizeY=dump.nSizeY[n];
+      int nSizeZ=dump.nSizeZ[n];
+      if(i<dump.nSizeX1[n]){//1D part of the grid
+        nSizeY=1;
+        nSizeZ=1;
+      }
       int nCount=0;
       double dSum=0;
       for(int j=0;j<nSizeY;j++){
-        double *dRow=new double[nSizeZ];
-        ifFile.read((char*)(dRow),nSizeZ*sizeof(double));
         for(int k=0;k<nSizeZ;k++){
-          dSum+=dRow[k];
+          dSum+=dGrid[n][i][j][k];
           nCount++;
         }
-        delete [] dRow;
       }
       double dAverage=dSum/double(nCount);
-      if(i>=nNumGhostCells){//remove inner ghost cells
+      
+      if(nNumDims==1){
         
-        if(nNumDims==1){
-          
-          //get density
-          if(n==3){
-            vecdDensity.push_back(dAverage);
-          }
-          
-          //get energy or temperature
-          if(n==6){
-            vecdEnergy_or_Temp.push_back(dAverage);
-          }
-          
-          //get radius
-          if(n==2){
-            vecdRadius.push_back(dAverage);
-          }
-          
-          //get interior mass
-          if(n==0){
-            vecdMass.push_back(dAverage);
-          }
+        //get density
+        if(n==3){
+          vecdDensity.push_back(dAverage);
         }
-        if(nNumDims==2){
-          
-          //get density
-          if(n==4){
-            vecdDensity.push_back(dAverage);
-          }
-          
-          //get energy or temperature
-          if(n==8){
-            vecdEnergy_or_Temp.push_back(dAverage);
-          }
-          
-          //get radius
-          if(n==3){
-            vecdRadius.push_back(dAverage);
-          }
-          
-          //get interior mass
-          if(n==0){
-            vecdMass.push_back(dAverage);
-          }
+        
+        //get energy or temperature
+        if(n==6){
+          vecdEnergy_or_Temp.push_back(dAverage);
         }
-        if(nNumDims==3){
-          
-          //get density
-          if(n==5){
-            vecdDensity.push_back(dAverage);
-          }
-          
-          //get energy or temperature
-          if(n==10){
-            vecdEnergy_or_Temp.push_back(dAverage);
-          }
-          
-          //get radius
-          if(n==4){
-            vecdRadius.push_back(dAverage);
-          }
-          
-          //get interior mass
-          if(n==0){
-            vecdMass.push_back(dAverage);
-          }
+        
+        //get radius
+        if(n==2){
+          vecdRadius.push_back(dAverage);
+        }
+        
+        //get interior mass
+        if(n==0){
+          vecdMass.push_back(dAverage);
         }
       }
-    }
-    
-    //raed in the rest of the grid
-    nSizeX=nSize[n][0]+nGhostCellsX*(nNumGhostCells-nNum1DZones);
-    if(nVarInfo[n][0]==1&&nPeriodic[0]==0){
-      nSizeX=nSize[n][0]+nGhostCellsX*(nNumGhostCells-(nNum1DZones+1));
-    }
-    nSizeY=nSize[n][1]+nGhostCellsY*2*nNumGhostCells;
-    nSizeZ=nSize[n][2]+nGhostCellsZ*2*nNumGhostCells;
-    double *dTempArray=new double[nSizeZ];
-    for(int i=0;i<nSizeX;i++){
-      int nCount=0;
-      double dSum=0;
-      for(int j=0;j<nSizeY;j++){
-        if(ifFile.eof()){
-          std::stringstream ssTemp;
-          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": reached end of file sooner than expected\n";
-          throw exception2(ssTemp.str(),INPUT);
+      if(nNumDims==2){
+        
+        //get density
+        if(n==4){
+          vecdDensity.push_back(dAverage);
         }
-        ifFile.read((char*)(dTempArray),(nSizeZ)*sizeof(double));
-        for(int k=0;k<nSizeZ;k++){
-          dSum+=dTempArray[k];
-          nCount++;
+        
+        //get energy or temperature
+        if(n==8){
+          vecdEnergy_or_Temp.push_back(dAverage);
+        }
+        
+        //get radius
+        if(n==3){
+          vecdRadius.push_back(dAverage);
+        }
+        
+        //get interior mass
+        if(n==0){
+          vecdMass.push_back(dAverage);
         }
       }
-      double dAverage=dSum/double(nCount);
+      if(nNumDims==3){
         
-        if(nNumDims==1){
-          
-          //get density
-          if(n==3){
-            vecdDensity.push_back(dAverage);
-          }
-          
-          //get energy or temperature
-          if(n==6){
-            vecdEnergy_or_Temp.push_back(dAverage);
-          }
-          
-          //get radius
-          if(n==2){
-            vecdRadius.push_back(dAverage);
-          }
-          
-          //get interior mass
-          if(n==0){
-            vecdMass.push_back(dAverage);
-          }
+        //get density
+        if(n==5){
+          vecdDensity.push_back(dAverage);
         }
-        if(nNumDims==2){
-          
-          //get density
-          if(n==4){
-            vecdDensity.push_back(dAverage);
-          }
-          
-          //get energy or temperature
-          if(n==8){
-            vecdEnergy_or_Temp.push_back(dAverage);
-          }
-          
-          //get radius
-          if(n==3){
-            vecdRadius.push_back(dAverage);
-          }
-          
-          //get interior mass
-          if(n==0){
-            vecdMass.push_back(dAverage);
-          }
+        
+        //get energy or temperature
+        if(n==10){
+          vecdEnergy_or_Temp.push_back(dAverage);
         }
-        if(nNumDims==3){
-          
-          //get density
-          if(n==5){
-            vecdDensity.push_back(dAverage);
-          }
-          
-          //get energy or temperature
-          if(n==10){
-            vecdEnergy_or_Temp.push_back(dAverage);
-          }
-          
-          //get radius
-          if(n==4){
-            vecdRadius.push_back(dAverage);
-          }
-          
-          //get interior mass
-          if(n==0){
-            vecdMass.push_back(dAverage);
-          }
+        
+        //get radius
+        if(n==4){
+          vecdRadius.push_back(dAverage);
+        }
+        
+        //get interior mass
+        if(n==0){
+          vecdMass.push_back(dAverage);
         }
+      }
     }
-    delete [] dTempArray;
-    
   }
   
   //write rest of LNA file
@@ -7243,14 +7786,7 @@ void convertBinToLNA(std::string sFileName){
     }
   }
   
-  ifFile.close();
   ofFile.close();
-  for(int n=0;n<nNumVars;n++){
-    delete [] nSize[n];
-    delete [] nVarInfo[n];
-  }
-  delete [] nSize;
-  delete [] nVarInfo;
 }
 double dCalRhoAve3D(double ****dGrid,int nI,int nStartY,int nEndY,int nStartZ,int nEndZ){
   int j;
@@ -7293,70 +7829,186 @@ double dCalRhoAve2D(double ****dGrid,int nI,int nStartY,int nEndY,int nStartZ,in
   return dSum/dVolume;
 }
 #ifdef FFTW_ENABLE
-void computeFourierTransFromList(std::string sInFileName,std::string sOutFileName){
-
-  //read in file list
-  std::vector<double>vecdTimes;
-  std::vector<double>vecdQuantity;
-  std::ifstream ifInputFile;
-  ifInputFile.open(sInFileName.c_str());
-  if(!ifInputFile.good()){
+void openTimeSeries(std::string sFileName,bool bWatchZone,timeSeries &series){
+  
+  series.sFileName=sFileName;
+  series.bWatchZone=bWatchZone;
+  series.bBinary=false;
+  series.ifIn.open(sFileName.c_str());
+  if(!series.ifIn.good()){
     std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<" unable to open the file \""
-      <<sInFileName<<"\"\n";
-    throw exception2(ssTemp.str());
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": unable to open the file \""
+      <<sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
   }
-  double dTemp1;
-  double dTemp2;
-  while(!ifInputFile.eof()){
-    ifInputFile>>dTemp1>>dTemp2;
-    vecdTimes.push_back(dTemp1);
-    vecdQuantity.push_back(dTemp2);
+  if(!bWatchZone){//two column text file, no header
+    return;
   }
   
-  //interpolate dependent variable to evenly spaced times
-  fftw_complex *in;
-  in=(fftw_complex*) fftw_malloc(sizeof(fftw_complex)*vecdTimes.size());
-  double dTInterp=(vecdTimes[vecdTimes.size()-1]-vecdTimes[0])
-    /double(vecdTimes.size());
-  unsigned int nIndexKeep=1;
-  unsigned int nIndexCur=1;
-  for(unsigned int i=0;i<vecdTimes.size();i++){
-    
-    //calculate time to interpolate to
-    double dt=double(i)*dTInterp+vecdTimes[0];
-    
-    //find bracketing times, will be nIndexKeep, and nIndexKeep-1
-    bool bFound=false;
-    nIndexCur--;
-    while(!bFound&&nIndexCur<vecdTimes.size()){
-      if(vecdTimes[nIndexCur]>dt){
-        nIndexKeep=nIndexCur;
-        bFound=true;
-      }
-      nIndexCur++;
-    }
-    
-    //if not found, say so
-    if(!bFound){
-      fftw_free(in);
+  //check if it is a binary watch zone file
+  if(series.ifIn.peek()=='w'){
+    series.ifIn.close();
+    series.ifIn.clear();
+    int nZone[3];
+    bool bIsGammaLaw;
+    double dGamma;
+    openWatchZoneBin(sFileName,series.ifIn,nZone,bIsGammaLaw,dGamma);
+    series.bBinary=true;
+    return;
+  }
+  
+  //through out the two header lines of a text watch zone file
+  std::string sLine;
+  std::getline(series.ifIn,sLine);
+  std::getline(series.ifIn,sLine);
+}
+bool bReadTimeSeriesSample(timeSeries &series,double &dTime,double &dValue){
+  
+  if(series.bBinary){//time and u_ip1half are the first two columns of each record
+    int nTimeStepIndex;
+    double dValues[nNumWatchZoneColumns];
+    while(series.ifIn.read((char*)(&nTimeStepIndex),sizeof(int))
+      &&series.ifIn.read((char*)(dValues),nNumWatchZoneColumns*sizeof(double))){
+      if(dValues[0]==dValues[0]&&dValues[1]==dValues[1]){//skip undefined values
+        dTime=dValues[0];
+        dValue=dValues[1];
+        return true;
+      }
+    }
+    return false;
+  }
+  if(series.bWatchZone){//time step index, time and u_ip1half start each line, "-" if undefined
+    std::string sLine;
+    while(std::getline(series.ifIn,sLine)){
+      std::stringstream ssLine(sLine);
+      int nTimeStepIndex;
+      std::string sTime;
+      std::string sValue;
+      if(!(ssLine>>nTimeStepIndex>>sTime>>sValue)||sTime.compare("-")==0
+        ||sValue.compare("-")==0){
+        continue;
+      }
+      dTime=atof(sTime.c_str());
+      dValue=atof(sValue.c_str());
+      return true;
+    }
+    return false;
+  }
+  if(series.ifIn>>dTime>>dValue){
+    return true;
+  }
+  return false;
+}
+void openUniformResampler(std::string sFileName,bool bWatchZone,double dTimeStart
+  ,double dDeltaTime,uniformResampler &resampler){
+  
+  openTimeSeries(sFileName,bWatchZone,resampler.series);
+  resampler.dTimeStart=dTimeStart;
+  resampler.dDeltaTime=dDeltaTime;
+  resampler.nIndex=0;
+  if(!bReadTimeSeriesSample(resampler.series,resampler.dTimePrev,resampler.dValuePrev)
+    ||!bReadTimeSeriesSample(resampler.series,resampler.dTimeNext,resampler.dValueNext)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": the file \""<<sFileName
+      <<"\" has fewer than two samples.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+}
+double dNextUniformSample(uniformResampler &resampler){
+  
+  //calculate time to interpolate to
+  double dt=double(resampler.nIndex)*resampler.dDeltaTime+resampler.dTimeStart;
+  
+  //read samples until they bracket dt, times are increasing so earlier samples aren't needed
+  while(resampler.dTimeNext<=dt){
+    resampler.dTimePrev=resampler.dTimeNext;
+    resampler.dValuePrev=resampler.dValueNext;
+    if(!bReadTimeSeriesSample(resampler.series,resampler.dTimeNext,resampler.dValueNext)){
       std::stringstream ssTemp;
-      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<" time interpolating to, "<<dt
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": time interpolating to, "<<dt
         <<" out side data set.\n";
-      throw exception2(ssTemp.str());
+      throw exception2(ssTemp.str(),INPUT);
     }
+  }
+  resampler.nIndex++;
+  
+  //do linear interpolation to dt
+  return (resampler.dValueNext-resampler.dValuePrev)/(resampler.dTimeNext-resampler.dTimePrev)
+    *(dt-resampler.dTimePrev)+resampler.dValuePrev;
+}
+void computeFourierTrans(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,int nThreads){
+  
+  //first pass, find number of samples, first and last times, and the mean and variance
+  timeSeries series;
+  openTimeSeries(sInFileName,bWatchZone,series);
+  size_t nNumSamples=0;
+  double dTimeFirst=0.0;
+  double dTimeLast=0.0;
+  double dMean=0.0;
+  double dSumSquares=0.0;
+  double dTime;
+  double dValue;
+  while(bReadTimeSeriesSample(series,dTime,dValue)){
+    if(nNumSamples==0){
+      dTimeFirst=dTime;
+    }
+    dTimeLast=dTime;
+    nNumSamples++;
     
-    //do linear interpolation to dt
-    in[i][0]=(vecdQuantity[nIndexKeep]-vecdQuantity[nIndexKeep-1])
-      /(vecdTimes[nIndexKeep]-vecdTimes[nIndexKeep-1])*
-      (dt-vecdTimes[nIndexKeep-1])+vecdQuantity[nIndexKeep-1];
+    //running mean and sum of squared deviations
+    double dDelta=dValue-dMean;
+    dMean+=dDelta/double(nNumSamples);
+    dSumSquares+=dDelta*(dValue-dMean);
+  }
+  series.ifIn.close();
+  if(nNumSamples<2||dTimeLast<=dTimeFirst){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": the file \""<<sInFileName
+      <<"\" has fewer than two samples at different times.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  double dVariance=dSumSquares/double(nNumSamples-1);
+  
+  //second pass, compute the spectrum
+  if(bLombScargle){
+    computeLombScargle(sInFileName,sOutFileName,bWatchZone,nNumSamples,dTimeFirst,dTimeLast
+      ,dMean,dVariance,nThreads);
+  }
+  else if(nSpectrumSegment>0){
+    computeWelchSpectrum(sInFileName,sOutFileName,bWatchZone,nNumSamples,dTimeFirst,dTimeLast);
+  }
+  else{
+    computeFourierTransWhole(sInFileName,sOutFileName,bWatchZone,nNumSamples,dTimeFirst
+      ,dTimeLast);
+  }
+}
+void computeFourierTransWhole(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,size_t nNumSamples,double dTimeFirst,double dTimeLast){
+  
+  //setup FFT plan before filling the input, use any plans cached in the wisdom file
+  std::string sWisdomFile=sGetFFTWWisdomFile();
+  if(sWisdomFile.size()>0){
+    fftw_import_wisdom_from_filename(sWisdomFile.c_str());
   }
+  double *in=(double*) fftw_malloc(sizeof(double)*nNumSamples);
+  fftw_complex *out=(fftw_complex*) fftw_malloc(sizeof(fftw_complex)*(nNumSamples/2+1));
+  fftw_plan p=fftw_plan_dft_r2c_1d(int(nNumSamples),in,out,FFTW_ESTIMATE);
   
-  //setup FFT plan
-  fftw_complex *out;
-  fftw_plan p;
-  out=(fftw_complex*) fftw_malloc(sizeof(fftw_complex)*vecdTimes.size());
-  p=fftw_plan_dft_1d(vecdTimes.size(),in,out,FFTW_FORWARD,FFTW_ESTIMATE);
+  //interpolate dependent variable to evenly spaced times
+  double dTInterp=(dTimeLast-dTimeFirst)/double(nNumSamples);
+  try{
+    uniformResampler resampler;
+    openUniformResampler(sInFileName,bWatchZone,dTimeFirst,dTInterp,resampler);
+    for(size_t i=0;i<nNumSamples;i++){
+      in[i]=dNextUniformSample(resampler);
+    }
+  }
+  catch(exception2&){
+    fftw_destroy_plan(p);
+    fftw_free(in); fftw_free(out);
+    throw;
+  }
   
   //do the FFT
   fftw_execute(p);
@@ -7365,16 +8017,18 @@ void computeFourierTransFromList(std::string sInFileName,std::string sOutFileNam
   std::ofstream ofOut;
   ofOut.open(sOutFileName.c_str());
   if(!ofOut.good()){
+    fftw_destroy_plan(p);
+    fftw_free(in); fftw_free(out);
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<" unable to open the file \""
       <<sOutFileName<<"\"\n";
-    throw exception2(ssTemp.str());
+    throw exception2(ssTemp.str(),OUTPUT);
   }
   
   //write out the properly scaled transform
-  for(unsigned int i=0;i<vecdTimes.size()/2;i++){
-    ofOut<<double(i)/dTInterp/vecdTimes.size()
-      <<" "<<sqrt(out[i][0]*out[i][0]+out[i][1]*out[i][1])/double(vecdTimes.size())*2.0<<" "
+  for(size_t i=0;i<nNumSamples/2;i++){
+    ofOut<<double(i)/dTInterp/nNumSamples
+      <<" "<<sqrt(out[i][0]*out[i][0]+out[i][1]*out[i][1])/double(nNumSamples)*2.0<<" "
       <<atan2(out[i][1],out[i][0])<<std::endl;
   }
   
@@ -7382,57 +8036,86 @@ void computeFourierTransFromList(std::string sInFileName,std::string sOutFileNam
   fftw_destroy_plan(p);
   fftw_free(in); fftw_free(out);
 }
-void computeFourierTrans(std::string sInFileName,std::string sOutFileName){
+void computeWelchSpectrum(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,size_t nNumSamples,double dTimeFirst,double dTimeLast){
   
-  //read in watchzone
-  watchzone watchzoneIn=readInWatchZone(sInFileName);
+  int nSegment=nSpectrumSegment;
+  int nHop=nSegment/2;
+  if(nNumSamples<size_t(nSegment)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": the file \""<<sInFileName
+      <<"\" has "<<nNumSamples<<" samples, fewer than the segment length "<<nSegment<<".\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  double dDeltaTime=(dTimeLast-dTimeFirst)/double(nNumSamples);
   
-  //interpolate dependent variable to evenly spaced times
-  fftw_complex *in;
-  in=(fftw_complex*) fftw_malloc(sizeof(fftw_complex)*watchzoneIn.vecdT.size());
-  double dTInterp=(watchzoneIn.vecdT[watchzoneIn.vecdT.size()-1]-watchzoneIn.vecdT[0])
-    /double(watchzoneIn.vecdT.size());
-  unsigned int nIndexKeep=1;
-  unsigned int nIndexCur=1;
-  for(unsigned int i=0;i<watchzoneIn.vecdT.size();i++){
-    
-    //calculate time to interpolate to
-    double dt=double(i)*dTInterp+watchzoneIn.vecdT[0];
-    
-    //find bracketing times, will be nIndexKeep, and nIndexKeep-1
-    bool bFound=false;
-    nIndexCur--;
-    while(!bFound&&nIndexCur<watchzoneIn.vecdT.size()){
-      if(watchzoneIn.vecdT[nIndexCur]>dt){
-        nIndexKeep=nIndexCur;
-        bFound=true;
-      }
-      nIndexCur++;
-    }
-    
-    //if not found, say so
-    if(!bFound){
-      fftw_free(in);
-      std::stringstream ssTemp;
-      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<" time interpolating to, "<<dt
-        <<" out side data set.\n";
-      throw exception2(ssTemp.str());
-    }
-    
-    //do linear interpolation to dt
-    in[i][0]=(watchzoneIn.vecdU_ip1half[nIndexKeep]-watchzoneIn.vecdU_ip1half[nIndexKeep-1])
-      /(watchzoneIn.vecdT[nIndexKeep]-watchzoneIn.vecdT[nIndexKeep-1])*
-      (dt-watchzoneIn.vecdT[nIndexKeep-1])+watchzoneIn.vecdU_ip1half[nIndexKeep-1];
+  //measure the best plan for the segment length, reusing and updating the wisdom file
+  std::string sWisdomFile=sGetFFTWWisdomFile();
+  if(sWisdomFile.size()>0){
+    fftw_import_wisdom_from_filename(sWisdomFile.c_str());
+  }
+  double *in=(double*) fftw_malloc(sizeof(double)*nSegment);
+  fftw_complex *out=(fftw_complex*) fftw_malloc(sizeof(fftw_complex)*(nSegment/2+1));
+  fftw_plan p=fftw_plan_dft_r2c_1d(nSegment,in,out,FFTW_MEASURE);
+  if(sWisdomFile.size()>0){
+    fftw_export_wisdom_to_filename(sWisdomFile.c_str());
   }
   
-  //setup FFT plan
-  fftw_complex *out;
-  fftw_plan p;
-  out=(fftw_complex*) fftw_malloc(sizeof(fftw_complex)*watchzoneIn.vecdT.size());
-  p=fftw_plan_dft_1d(watchzoneIn.vecdT.size(),in,out,FFTW_FORWARD,FFTW_ESTIMATE);
+  //Hann window, and the sum of its squares to normalize the power
+  std::vector<double> vecdWindow(nSegment);
+  double dWindowPower=0.0;
+  for(int n=0;n<nSegment;n++){
+    vecdWindow[n]=0.5*(1.0-cos(2.0*dPi*double(n)/double(nSegment)));
+    dWindowPower+=vecdWindow[n]*vecdWindow[n];
+  }
   
-  //do the FFT
-  fftw_execute(p);
+  //stream evenly spaced samples through a segment, transforming it every nHop samples
+  std::vector<double> vecdSegment(nSegment);
+  std::vector<double> vecdPower(nSegment/2+1,0.0);
+  int nNumSegments=0;
+  try{
+    uniformResampler resampler;
+    openUniformResampler(sInFileName,bWatchZone,dTimeFirst,dDeltaTime,resampler);
+    size_t nRead=0;
+    for(int n=0;n<nSegment;n++){
+      vecdSegment[n]=dNextUniformSample(resampler);
+      nRead++;
+    }
+    while(true){
+      
+      //remove the mean of the segment, window and transform it
+      double dSegmentMean=0.0;
+      for(int n=0;n<nSegment;n++){
+        dSegmentMean+=vecdSegment[n];
+      }
+      dSegmentMean/=double(nSegment);
+      for(int n=0;n<nSegment;n++){
+        in[n]=(vecdSegment[n]-dSegmentMean)*vecdWindow[n];
+      }
+      fftw_execute(p);
+      for(int k=0;k<=nSegment/2;k++){
+        vecdPower[k]+=out[k][0]*out[k][0]+out[k][1]*out[k][1];
+      }
+      nNumSegments++;
+      
+      //move on by half a segment, the samples left over at the end are not used
+      if(nRead+nHop>nNumSamples){
+        break;
+      }
+      std::copy(vecdSegment.begin()+nHop,vecdSegment.end(),vecdSegment.begin());
+      for(int n=nSegment-nHop;n<nSegment;n++){
+        vecdSegment[n]=dNextUniformSample(resampler);
+        nRead++;
+      }
+    }
+  }
+  catch(exception2&){
+    fftw_destroy_plan(p);
+    fftw_free(in); fftw_free(out);
+    throw;
+  }
+  fftw_destroy_plan(p);
+  fftw_free(in); fftw_free(out);
   
   //output to file
   std::ofstream ofOut;
@@ -7441,19 +8124,142 @@ void computeFourierTrans(std::string sInFileName,std::string sOutFileName){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<" unable to open the file \""
       <<sOutFileName<<"\"\n";
-    throw exception2(ssTemp.str());
+    throw exception2(ssTemp.str(),OUTPUT);
   }
   
-  //write out the properly scaled transform
-  for(unsigned int i=0;i<watchzoneIn.vecdT.size()/2;i++){
-    ofOut<<double(i)/dTInterp/watchzoneIn.vecdT.size()
-      <<" "<<sqrt(out[i][0]*out[i][0]+out[i][1]*out[i][1])/double(watchzoneIn.vecdT.size())*2.0<<" "
-      <<atan2(out[i][1],out[i][0])<<std::endl;
+  //write out the one sided power spectral density, zero and Nyquist frequencies aren't doubled
+  for(int k=0;k<=nSegment/2;k++){
+    double dScale=2.0;
+    if(k==0||2*k==nSegment){
+      dScale=1.0;
+    }
+    ofOut<<double(k)/(double(nSegment)*dDeltaTime)<<" "
+      <<dScale*vecdPower[k]*dDeltaTime/(double(nNumSegments)*dWindowPower)<<std::endl;
+  }
+}
+void* lombScargleWorker(void* vBlock){
+  
+  lombScargleBlock* block=(lombScargleBlock*)vBlock;
+  for(int n=0;n<block->nNumSamples;n++){
+    
+    //rotation by the frequency spacing, and the first frequency of the block
+    double dTheta=block->dDeltaOmega*block->dTimes[n];
+    double dCosDelta=cos(dTheta);
+    double dSinDelta=sin(dTheta);
+    double dCos=cos(double(block->nStart)*dTheta);
+    double dSin=sin(double(block->nStart)*dTheta);
+    double dY=block->dValues[n];
+    for(int k=block->nStart;k<block->nEnd;k++){
+      block->dSums[0][k]+=dY*dCos;
+      block->dSums[1][k]+=dY*dSin;
+      block->dSums[2][k]+=dCos*dCos;
+      block->dSums[3][k]+=dSin*dSin;
+      block->dSums[4][k]+=dSin*dCos;
+      double dCosNext=dCos*dCosDelta-dSin*dSinDelta;
+      dSin=dSin*dCosDelta+dCos*dSinDelta;
+      dCos=dCosNext;
+    }
+  }
+  return NULL;
+}
+void computeLombScargle(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,size_t nNumSamples,double dTimeFirst,double dTimeLast,double dMean,double dVariance
+  ,int nThreads){
+  
+  //frequencies are multiples of one over the length of the series
+  double dDuration=dTimeLast-dTimeFirst;
+  int nNumFrequencies=int(std::min(nNumSamples/2,size_t(nLombScargleMaxFrequencies)));
+  double dDeltaOmega=2.0*dPi/dDuration;
+  std::vector<double> vecdSums[5];
+  for(int m=0;m<5;m++){
+    vecdSums[m].resize(nNumFrequencies+1,0.0);
+  }
+  
+  //split frequencies among threads
+  nThreads=std::max(1,std::min(nThreads,nNumFrequencies));
+  std::vector<double> vecdTimes(nLombScargleChunk);
+  std::vector<double> vecdValues(nLombScargleChunk);
+  std::vector<lombScargleBlock> vecBlocks(nThreads);
+  for(int t=0;t<nThreads;t++){
+    vecBlocks[t].dTimes=&vecdTimes[0];
+    vecBlocks[t].dValues=&vecdValues[0];
+    vecBlocks[t].nStart=1+(t*nNumFrequencies)/nThreads;
+    vecBlocks[t].nEnd=1+((t+1)*nNumFrequencies)/nThreads;
+    vecBlocks[t].dDeltaOmega=dDeltaOmega;
+    for(int m=0;m<5;m++){
+      vecBlocks[t].dSums[m]=&vecdSums[m][0];
+    }
+  }
+  
+  //add samples to the sums a chunk at a time
+  timeSeries series;
+  openTimeSeries(sInFileName,bWatchZone,series);
+  int nChunk=nLombScargleChunk;
+  while(nChunk==nLombScargleChunk){
+    nChunk=0;
+    double dTime;
+    double dValue;
+    while(nChunk<nLombScargleChunk&&bReadTimeSeriesSample(series,dTime,dValue)){
+      vecdTimes[nChunk]=dTime-dTimeFirst;
+      vecdValues[nChunk]=dValue-dMean;
+      nChunk++;
+    }
+    for(int t=0;t<nThreads;t++){
+      vecBlocks[t].nNumSamples=nChunk;
+    }
+    if(nThreads==1){
+      lombScargleWorker((void*)(&vecBlocks[0]));
+    }
+    else{
+      std::vector<pthread_t> vecThreads(nThreads);
+      for(int t=0;t<nThreads;t++){
+        if(pthread_create(&vecThreads[t],NULL,lombScargleWorker,(void*)(&vecBlocks[t]))!=0){
+          for(int t2=0;t2<t;t2++){
+            pthread_join(vecThreads[t2],NULL);
+          }
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": unable to create thread "<<t<<std::endl;
+          throw exception2(ssTemp.str(),CALCULATION);
+        }
+      }
+      for(int t=0;t<nThreads;t++){
+        pthread_join(vecThreads[t],NULL);
+      }
+    }
   }
+  series.ifIn.close();
   
-  //free memory
-  fftw_destroy_plan(p);
-  fftw_free(in); fftw_free(out);
+  //output to file
+  std::ofstream ofOut;
+  ofOut.open(sOutFileName.c_str());
+  if(!ofOut.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<":"<<" unable to open the file \""
+      <<sOutFileName<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+  
+  //write out the normalized power and the amplitude of the least squares fit of a sinusoid
+  for(int k=1;k<=nNumFrequencies;k++){
+    double dYC=vecdSums[0][k];
+    double dYS=vecdSums[1][k];
+    double dCC=vecdSums[2][k];
+    double dSS=vecdSums[3][k];
+    double dCS=vecdSums[4][k];
+    double dDet=dCC*dSS-dCS*dCS;
+    double dA=(dYC*dSS-dYS*dCS)/dDet;
+    double dB=(dYS*dCC-dYC*dCS)/dDet;
+    ofOut<<double(k)/dDuration<<" "<<(dA*dYC+dB*dYS)/(2.0*dVariance)<<" "
+      <<sqrt(dA*dA+dB*dB)<<std::endl;
+  }
+}
+std::string sGetFFTWWisdomFile(){
+  const char* cHome=getenv("HOME");
+  if(cHome==NULL||cHome[0]=='\0'){
+    return "";
+  }
+  return std::string(cHome)+"/"+sFFTWWisdomFileName;
 }
 #endif
 #ifdef HDF_ENABLE
@@ -7474,115 +8280,26 @@ void convertBinToHDF4(std::string sFileName){
       <<": no input file specified\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  std::ifstream ifFile;
-  ifFile.open(sFileName.c_str(),std::ios::binary);
-  if(!ifFile.good()){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" didn't open properly\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //check that it is a binary file
-  char cTemp;
-  ifFile.read((char*)(&cTemp),sizeof(char));
-  if(cTemp!='b'){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
-      <<sFileName<<"\" isn't a binary file.\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //check that it is the correct version
-  int nTemp;
-  ifFile.read((char*)(&nTemp),sizeof(int));
-  if(nTemp!=nDumpFileVersion){
-    std::stringstream ssTemp;
-    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": inpput file \""
-      <<sFileName<<"\" version \""<<nTemp
-      <<"\" isn't the supported version \""<<nDumpFileVersion<<"\".\n";
-    throw exception2(ssTemp.str(),INPUT);
-  }
-  
-  //read in time
-  double dTime;
-  ifFile.read((char*)(&dTime),sizeof(double));
-  
-  //read in the time step index
-  int nTimeStepIndex;
-  ifFile.read((char*)(&nTimeStepIndex),sizeof(int));
-  
-  //read in the time step
-  double dTimeStep1;
-  ifFile.read((char*)(&dTimeStep1),sizeof(double));
-  
-  //read in the time step
-  double dTimeStep2;
-  ifFile.read((char*)(&dTimeStep2),sizeof(double));
-  
-  //read in alpha
-  double dAlpha;
-  ifFile.read((char*)(&dAlpha),sizeof(double));
-  
-  //read in gamma law
-  int nGammaLaw;
-  ifFile.read((char*)(&nGammaLaw),sizeof(int));
-  
-  double dGamma;
-  std::string sEOSTable;
-  eos eosTable;
-  if(nGammaLaw==0){
-    ifFile.read((char*)(&dGamma),sizeof(double));
-  }
-  else{
-    char *cBuffer=new char[nGammaLaw+1];
-    ifFile.read(cBuffer,nGammaLaw*sizeof(char));
-    cBuffer[nGammaLaw]='\0';
-    sEOSTable=cBuffer;
-    delete [] cBuffer;
-    eosTable.readBin(sEOSTable);
-  }
-  
-  //read in artificial viscosity
-  double dA;
-  ifFile.read((char*)(&dA),sizeof(double));
-  
-  //read in artificial viscosity threshold
-  double dAVThreshold;
-  ifFile.read((char*)(&dAVThreshold),sizeof(double));
-  
-  //read in global grid size
-  int nSizeGlobe[3];
-  ifFile.read((char*)(nSizeGlobe),3*sizeof(int));
-  
-  //read in periodicity
-  int nPeriodic[3];
-  ifFile.read((char*)(nPeriodic),3*sizeof(int));
-  
-  //read in number of 1D Zones
-  int nNum1DZones;
-  ifFile.read((char*)(&nNum1DZones),sizeof(int));
-  
-  //read in number of ghostcells
-  int nNumGhostCells;
-  ifFile.read((char*)(&nNumGhostCells),sizeof(int));
-  
-  //read in number of grid variables
-  int nNumVars;
-  ifFile.read((char*)(&nNumVars),sizeof(int));
+  dumpFile dump;
+  dump.open(sFileName,nDumpFileVersion);
+  int nGammaLaw=int(dump.sEOSFileName.size());
+  int nSizeGlobe[3]={dump.nGlobalGridDims[0],dump.nGlobalGridDims[1],dump.nGlobalGridDims[2]};
+  int nPeriodic[3]={dump.nPeriodic[0],dump.nPeriodic[1],dump.nPeriodic[2]};
+  int nNum1DZones=dump.nNum1DZones;
+  int nNumGhostCells=dump.nNumGhostCells;
+  int nNumVars=dump.nNumVars;
   
-  //get variable info, and set grid sizes
+  //set grid sizes
   int **nSize=new int*[nNumVars];
   int **nVarInfo=new int*[nNumVars];
   int l;
   for(int n=0;n<nNumVars;n++){
     nSize[n]=new int[3];
-    nVarInfo[n]=new int[3];
-    ifFile.read((char*)(nVarInfo[n]),(4)*sizeof(int));
+    nVarInfo[n]=new int[4];
+    for(l=0;l<4;l++){
+      nVarInfo[n][l]=dump.nVarInfo[n][l];
+    }
     for(l=0;l<3;l++){
-      if(nSizeGlobe[l]==1){
-        nVarInfo[n][l]=-1;
-      }
       if(nVarInfo[n][l]==-1){//variable not defined in direction l
         nSize[n][l]=1;
       }
@@ -7594,18 +8311,7 @@ void convertBinToHDF4(std::string sFileName){
       }
     }
   }
-  
-  //figure out number of dimensions
-  int nNumDims=0;
-  if(nSizeGlobe[0]>1){
-    nNumDims++;
-  }
-  if(nSizeGlobe[1]>1){
-    nNumDims++;
-  }
-  if(nSizeGlobe[2]>1){
-    nNumDims++;
-  }
+  int nNumDims=dump.nNumDims;
   
   //set variable indices
   int nNumIntVars=0;
@@ -7769,6 +8475,7 @@ void convertBinToHDF4(std::string sFileName){
   int32 nStart[3]={0,0,0};
   int32 nDataID;
   int32 nStat;
+  double ****dGrid=dump.getGrid();
   double ****dVarData=new double***[nNumVars];
   for(int n=0;n<nNumVars;n++){
     
@@ -7794,14 +8501,12 @@ void convertBinToHDF4(std::string sFileName){
     if (nVarInfo[n][0]==1&&nPeriodic[0]==0){
       nSizeX1=nGhostCellsX*(nNum1DZones+1+nNumGhostCells);
     }
-    double dTemp;
     for(i=0;i<nSizeX1;i++){
       dVarData[n][i]=new double*[nSizeY];
-      ifFile.read((char*)(&dTemp),sizeof(double));//only read one for every j,k set
       for(j=0;j<nSizeY;j++){
         dVarData[n][i][j]=new double[nSizeZ];
         for(k=0;k<nSizeZ;k++){
-          dVarData[n][i][j][k]=dTemp;
+          dVarData[n][i][j][k]=dGrid[n][i][0][0];//only one for every j,k set
         }
       }
     }
@@ -7812,7 +8517,7 @@ void convertBinToHDF4(std::string sFileName){
       dVarData[n][i]=new double*[nSizeY];
       for(j=0;j<nSizeY;j++){
         dVarData[n][i][j]=new double[nSizeZ];
-        ifFile.read((char*)(dVarData[n][i][j]),nSizeZ*sizeof(double));//read all k values at once
+        memcpy(dVarData[n][i][j],dGrid[n][i][j],nSizeZ*sizeof(double));//copy all k values at once
       }
     }
   }
@@ -8122,9 +8827,688 @@ void convertBinToHDF4(std::string sFileName){
       <<": closing the HDF file \""<<ssHDFFileName.str()<<"\" failed\n";
     throw exception2(ssTemp.str(),INPUT);
   }
-  ifFile.close();
 }
 #endif
+double dGetGridValue(dumpFile &dump,double ****dGrid,int n,int i,int j,int k){
+  if(dump.nVarInfo[n][0]==-1){
+    i=0;
+  }
+  if(dump.nVarInfo[n][1]==-1){
+    j=0;
+  }
+  if(dump.nVarInfo[n][2]==-1){
+    k=0;
+  }
+  if(i<dump.nSizeX1[n]){//1D region, only one value per row
+    return dGrid[n][i][0][0];
+  }
+  return dGrid[n][i][j][k];
+}
+void encodeVTKArray(vtkArray &array){
+  const char *cData=(const char*)(&array.vecdValues[0]);
+  uint64_t nSize=uint64_t(array.vecdValues.size())*sizeof(double);
+  if(!bVTKCompress){
+    array.veccEncoded.resize(sizeof(uint64_t)+nSize);
+    memcpy(&array.veccEncoded[0],&nSize,sizeof(uint64_t));
+    memcpy(&array.veccEncoded[sizeof(uint64_t)],cData,nSize);
+  }
+  else{
+    #ifdef ZLIB_ENABLE
+    
+    /*header is the number of blocks, the block size, the size of the last block if it is only
+    partly full, and the compressed size of each block*/
+    uint64_t nLastBlockSize=nSize%nVTKCompressBlockSize;
+    uint64_t nNumBlocks=nSize/nVTKCompressBlockSize+(nLastBlockSize>0?1:0);
+    std::vector<uint64_t> vecnHeader(3+nNumBlocks);
+    vecnHeader[0]=nNumBlocks;
+    vecnHeader[1]=nVTKCompressBlockSize;
+    vecnHeader[2]=nLastBlockSize;
+    size_t nHeaderSize=vecnHeader.size()*sizeof(uint64_t);
+    array.veccEncoded.resize(nHeaderSize);
+    std::vector<Bytef> vecBlock(compressBound(nVTKCompressBlockSize));
+    for(uint64_t b=0;b<nNumBlocks;b++){
+      uLong nBlockSize=nVTKCompressBlockSize;
+      if(b==nNumBlocks-1&&nLastBlockSize>0){
+        nBlockSize=nLastBlockSize;
+      }
+      uLongf nCompressedSize=vecBlock.size();
+      if(compress2(&vecBlock[0],&nCompressedSize,(const Bytef*)(cData+b*nVTKCompressBlockSize)
+        ,nBlockSize,Z_DEFAULT_COMPRESSION)!=Z_OK){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": compressing block "<<b<<" of array \""<<array.sName<<"\" failed\n";
+        throw exception2(ssTemp.str(),OUTPUT);
+      }
+      vecnHeader[3+b]=nCompressedSize;
+      array.veccEncoded.insert(array.veccEncoded.end(),(char*)(&vecBlock[0])
+        ,(char*)(&vecBlock[0])+nCompressedSize);
+    }
+    memcpy(&array.veccEncoded[0],&vecnHeader[0],nHeaderSize);
+    #else
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": zlib was disabled during configuration, VTK files can not be compressed\n";
+    throw exception2(ssTemp.str(),SYNTAX);
+    #endif
+  }
+  
+  //raw values are no longer needed
+  std::vector<double>().swap(array.vecdValues);
+}
+void convertBinToVTK(std::string sFileName){
+  
+  //open input file
+  std::string sExtension=sFileName.substr(sFileName.size()-4,1);
+  if(sExtension.compare(".")==0){//if there is an extension remove it
+    sFileName=sFileName.substr(0,sFileName.size()-4);
+  }
+  if(sFileName.size()==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": no input file specified\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  dumpFile dump;
+  dump.open(sFileName,nDumpFileVersion);
+  eos *eosTable=NULL;
+  if(!dump.bGammaLaw){
+    std::string sEOSTable=dump.sEOSFileName;
+    if(sEOSFile!=""){//overwrite sEOSTable if sEOSFile is set
+      sEOSTable=sEOSFile;
+    }
+    
+    //test to see if it is relative to the execuatable directory
+    if (sEOSTable.substr(0,1)!="/" && sEOSTable.substr(0,2)!="./"){
+      sEOSTable=sExeDir+"/"+sEOSTable;
+    }
+    eosTable=&getEOSTable(sEOSTable);
+  }
+  int nNumDims=dump.nNumDims;
+  int nNumGhostCells=dump.nNumGhostCells;
+  
+  /*set variable indices, theta and v are only in 2D and 3D grids, phi and w only in 3D grids and
+  the last variable is T for a tabulated equation of state and E for a gamma law gas*/
+  int nNext=0;
+  nM=nNext++;
+  nTheta=-1;
+  nPhi=-1;
+  nV=-1;
+  nW=-1;
+  if(nNumDims>1){
+    nTheta=nNext++;
+  }
+  if(nNumDims>2){
+    nPhi=nNext++;
+  }
+  nDM=nNext++;
+  nR=nNext++;
+  nD=nNext++;
+  nU=nNext++;
+  nU0=nNext++;
+  if(nNumDims>1){
+    nV=nNext++;
+  }
+  if(nNumDims>2){
+    nW=nNext++;
+  }
+  nT=-1;
+  nE=-1;
+  if(dump.bGammaLaw){
+    nE=nNext++;
+  }
+  else{
+    nT=nNext++;
+  }
+  if(nNext!=dump.nNumVars){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expected "<<nNext<<" variables in a "<<nNumDims<<"D model, but \""<<sFileName
+      <<"\" has "<<dump.nNumVars<<"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  /*number of cells and points in each direction, directions with one zone have no extent. An
+  interface centered variable has an extra inner interface if the direction isn't periodic, the
+  zone at grid index i is then between interfaces i and i+1, otherwise i-1 and i*/
+  int nNumCells[3];
+  int nNumPoints[3];
+  int nIntOffset[3];
+  for(int l=0;l<3;l++){
+    nNumCells[l]=dump.nGlobalGridDims[l];
+    nNumPoints[l]=1;
+    if(l==0||dump.nGlobalGridDims[l]>1){
+      nNumPoints[l]=dump.nGlobalGridDims[l]+1;
+    }
+    nIntOffset[l]=0;
+    if(dump.nPeriodic[l]==0){
+      nIntOffset[l]=1;
+    }
+  }
+  size_t nNumCellsTotal=size_t(nNumCells[0])*size_t(nNumCells[1])*size_t(nNumCells[2]);
+  size_t nNumPointsTotal=size_t(nNumPoints[0])*size_t(nNumPoints[1])*size_t(nNumPoints[2]);
+  double ****dGrid=dump.getGrid();
+  
+  //coordinates of the interfaces, and sines and cosines of the angles at zone centers
+  std::vector<double> vecdR(nNumPoints[0]);
+  std::vector<double> vecdTheta(nNumPoints[1],0.5*M_PI);
+  std::vector<double> vecdPhi(nNumPoints[2],0.0);
+  for(int i=0;i<nNumPoints[0];i++){
+    vecdR[i]=dGetGridValue(dump,dGrid,nR,nNumGhostCells+i+nIntOffset[0]-1,0,0);
+  }
+  if(nTheta!=-1){
+    for(int j=0;j<nNumPoints[1];j++){
+      vecdTheta[j]=dGetGridValue(dump,dGrid,nTheta,0,nNumGhostCells+j+nIntOffset[1]-1,0);
+    }
+  }
+  if(nPhi!=-1){
+    for(int k=0;k<nNumPoints[2];k++){
+      vecdPhi[k]=dGetGridValue(dump,dGrid,nPhi,0,0,nNumGhostCells+k+nIntOffset[2]-1);
+    }
+  }
+  std::vector<double> vecdSinTheta(nNumCells[1],1.0);
+  std::vector<double> vecdCosTheta(nNumCells[1],0.0);
+  std::vector<double> vecdSinPhi(nNumCells[2],0.0);
+  std::vector<double> vecdCosPhi(nNumCells[2],1.0);
+  if(nTheta!=-1){
+    for(int j=0;j<nNumCells[1];j++){
+      double dThetaCen=(vecdTheta[j]+vecdTheta[j+1])*0.5;
+      vecdSinTheta[j]=sin(dThetaCen);
+      vecdCosTheta[j]=cos(dThetaCen);
+    }
+  }
+  if(nPhi!=-1){
+    for(int k=0;k<nNumCells[2];k++){
+      double dPhiCen=(vecdPhi[k]+vecdPhi[k+1])*0.5;
+      vecdSinPhi[k]=sin(dPhiCen);
+      vecdCosPhi[k]=cos(dPhiCen);
+    }
+  }
+  
+  //points of the mesh, x index fastest
+  vtkArray arrayPoints;
+  arrayPoints.sName="Points";
+  arrayPoints.nNumComponents=3;
+  arrayPoints.vecdValues.resize(3*nNumPointsTotal);
+  double *dPoint=&arrayPoints.vecdValues[0];
+  for(int k=0;k<nNumPoints[2];k++){
+    for(int j=0;j<nNumPoints[1];j++){
+      for(int i=0;i<nNumPoints[0];i++){
+        if(bVTKSpherical){
+          dPoint[0]=vecdR[i];
+          dPoint[1]=nTheta!=-1?vecdTheta[j]:0.0;
+          dPoint[2]=vecdPhi[k];
+        }
+        else if(nNumDims==1){//along x
+          dPoint[0]=vecdR[i];
+          dPoint[1]=0.0;
+          dPoint[2]=0.0;
+        }
+        else if(nNumDims==2){//in the plane of theta, with the axis along y
+          dPoint[0]=vecdR[i]*sin(vecdTheta[j]);
+          dPoint[1]=vecdR[i]*cos(vecdTheta[j]);
+          dPoint[2]=0.0;
+        }
+        else{
+          dPoint[0]=vecdR[i]*sin(vecdTheta[j])*cos(vecdPhi[k]);
+          dPoint[1]=vecdR[i]*sin(vecdTheta[j])*sin(vecdPhi[k]);
+          dPoint[2]=vecdR[i]*cos(vecdTheta[j]);
+        }
+        dPoint+=3;
+      }
+    }
+  }
+  
+  //zone centered quantities read from the grid
+  std::vector<double> vecdDensity(nNumCellsTotal);
+  std::vector<double> vecdTE(nNumCellsTotal);
+  vtkArray arrayVelocity;
+  arrayVelocity.sName="vel";
+  arrayVelocity.nNumComponents=3;
+  arrayVelocity.vecdValues.resize(3*nNumCellsTotal);
+  vtkArray arrayConVel;
+  arrayConVel.sName="vr_con";
+  arrayConVel.nNumComponents=1;
+  arrayConVel.vecdValues.resize(nNumCellsTotal);
+  size_t nCell=0;
+  for(int k=0;k<nNumCells[2];k++){
+    int nK=nNumGhostCells+k;
+    for(int j=0;j<nNumCells[1];j++){
+      int nJ=nNumGhostCells+j;
+      for(int i=0;i<nNumCells[0];i++){
+        int nI=nNumGhostCells+i;
+        vecdDensity[nCell]=dGetGridValue(dump,dGrid,nD,nI,nJ,nK);
+        vecdTE[nCell]=dGetGridValue(dump,dGrid,(nT!=-1?nT:nE),nI,nJ,nK);
+        
+        //velocities averaged to zone centers
+        double dU_im1half=dGetGridValue(dump,dGrid,nU,nI+nIntOffset[0]-1,nJ,nK);
+        double dU_ip1half=dGetGridValue(dump,dGrid,nU,nI+nIntOffset[0],nJ,nK);
+        double dU0_im1half=dGetGridValue(dump,dGrid,nU0,nI+nIntOffset[0]-1,nJ,nK);
+        double dU0_ip1half=dGetGridValue(dump,dGrid,nU0,nI+nIntOffset[0],nJ,nK);
+        double dVr=(dU_im1half+dU_ip1half)*0.5;
+        double dVt=0.0;
+        double dVp=0.0;
+        if(nV!=-1){
+          dVt=(dGetGridValue(dump,dGrid,nV,nI,nJ+nIntOffset[1]-1,nK)
+            +dGetGridValue(dump,dGrid,nV,nI,nJ+nIntOffset[1],nK))*0.5;
+        }
+        if(nW!=-1){
+          dVp=(dGetGridValue(dump,dGrid,nW,nI,nJ,nK+nIntOffset[2]-1)
+            +dGetGridValue(dump,dGrid,nW,nI,nJ,nK+nIntOffset[2]))*0.5;
+        }
+        arrayConVel.vecdValues[nCell]=dVr-(dU0_im1half+dU0_ip1half)*0.5;
+        double *dVel=&arrayVelocity.vecdValues[3*nCell];
+        if(bVTKSpherical){
+          dVel[0]=dVr;
+          dVel[1]=dVt;
+          dVel[2]=dVp;
+        }
+        else if(nNumDims==1){
+          dVel[0]=dVr;
+          dVel[1]=0.0;
+          dVel[2]=0.0;
+        }
+        else if(nNumDims==2){
+          dVel[0]=dVr*vecdSinTheta[j]+dVt*vecdCosTheta[j];
+          dVel[1]=dVr*vecdCosTheta[j]-dVt*vecdSinTheta[j];
+          dVel[2]=0.0;
+        }
+        else{
+          dVel[0]=(dVr*vecdSinTheta[j]+dVt*vecdCosTheta[j])*vecdCosPhi[k]-dVp*vecdSinPhi[k];
+          dVel[1]=(dVr*vecdSinTheta[j]+dVt*vecdCosTheta[j])*vecdSinPhi[k]+dVp*vecdCosPhi[k];
+          dVel[2]=dVr*vecdCosTheta[j]-dVt*vecdSinTheta[j];
+        }
+        nCell++;
+      }
+    }
+  }
+  
+  /*scalars from the equation of state, space for all arrays is reserved as references to them
+  are kept while others are added*/
+  std::vector<vtkArray> vecArrays;
+  vecArrays.reserve(10);
+  vtkArray arrayTemplate;
+  arrayTemplate.nNumComponents=1;
+  vecArrays.push_back(arrayTemplate);
+  vecArrays.back().sName="rho";
+  vecArrays.back().vecdValues.swap(vecdDensity);
+  const std::vector<double> &vecdD=vecArrays.back().vecdValues;
+  vecArrays.push_back(arrayTemplate);
+  vecArrays.back().sName=dump.bGammaLaw?"e":"T";
+  vecArrays.back().vecdValues.swap(vecdTE);
+  const std::vector<double> &vecdTE_cen=vecArrays.back().vecdValues;
+  if(!dump.bGammaLaw){
+    const char* sNames[5]={"p","e","kappa","gamma","c"};
+    for(int n=0;n<5;n++){
+      vecArrays.push_back(arrayTemplate);
+      vecArrays.back().sName=sNames[n];
+      vecArrays.back().vecdValues.resize(nNumCellsTotal);
+    }
+    std::vector<double> vecdCp(nNumCellsTotal);
+    size_t nFirst=vecArrays.size()-5;
+    eosTable->getPEKappaGammaCp(int(nNumCellsTotal),&vecdTE_cen[0],&vecdD[0]
+      ,&vecArrays[nFirst].vecdValues[0],&vecArrays[nFirst+1].vecdValues[0]
+      ,&vecArrays[nFirst+2].vecdValues[0],&vecArrays[nFirst+3].vecdValues[0],&vecdCp[0]);
+    eosTable->getSoundSpeed(int(nNumCellsTotal),&vecdTE_cen[0],&vecdD[0]
+      ,&vecArrays[nFirst+4].vecdValues[0]);
+  }
+  else{
+    vecArrays.push_back(arrayTemplate);
+    vecArrays.back().sName="p";
+    std::vector<double> &vecdP=vecArrays.back().vecdValues;
+    vecdP.resize(nNumCellsTotal);
+    vecArrays.push_back(arrayTemplate);
+    vecArrays.back().sName="c";
+    std::vector<double> &vecdC=vecArrays.back().vecdValues;
+    vecdC.resize(nNumCellsTotal);
+    for(size_t n=0;n<nNumCellsTotal;n++){
+      vecdP[n]=(dump.dGamma-1.0)*vecdD[n]*vecdTE_cen[n];
+      vecdC[n]=sqrt(dump.dGamma*vecdP[n]/vecdD[n]);
+    }
+  }
+  vecArrays.push_back(arrayTemplate);
+  vecArrays.back().sName=arrayConVel.sName;
+  vecArrays.back().vecdValues.swap(arrayConVel.vecdValues);
+  vecArrays.push_back(arrayTemplate);
+  vecArrays.back().sName=arrayVelocity.sName;
+  vecArrays.back().nNumComponents=3;
+  vecArrays.back().vecdValues.swap(arrayVelocity.vecdValues);
+  vecArrays.push_back(arrayTemplate);
+  vecArrays.back().sName=arrayPoints.sName;
+  vecArrays.back().nNumComponents=3;
+  vecArrays.back().vecdValues.swap(arrayPoints.vecdValues);
+  
+  //encode the arrays, and find their offsets in the appended data
+  std::vector<uint64_t> vecnOffsets(vecArrays.size());
+  uint64_t nOffset=0;
+  for(unsigned int n=0;n<vecArrays.size();n++){
+    encodeVTKArray(vecArrays[n]);
+    vecnOffsets[n]=nOffset;
+    nOffset+=vecArrays[n].veccEncoded.size();
+  }
+  
+  //write the xml header
+  std::string sVTKFileName=sFileName+".vts";
+  std::ofstream ofFile;
+  ofFile.open(sVTKFileName.c_str(),std::ios::out|std::ios::binary);
+  if(!ofFile.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error opening the VTK file \""<<sVTKFileName<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+  int nEndianTest=1;
+  std::stringstream ssExtent;
+  ssExtent<<"0 "<<nNumPoints[0]-1<<" 0 "<<nNumPoints[1]-1<<" 0 "<<nNumPoints[2]-1;
+  ofFile<<"<?xml version=\"1.0\"?>\n"
+    <<"<VTKFile type=\"StructuredGrid\" version=\"1.0\" byte_order=\""
+    <<(*((char*)(&nEndianTest))==1?"LittleEndian":"BigEndian")<<"\" header_type=\"UInt64\"";
+  if(bVTKCompress){
+    ofFile<<" compressor=\"vtkZLibDataCompressor\"";
+  }
+  ofFile<<">\n"
+    <<"  <StructuredGrid WholeExtent=\""<<ssExtent.str()<<"\">\n"
+    <<"    <FieldData>\n"
+    <<"      <DataArray type=\"Float64\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">"
+    <<std::setprecision(17)<<dump.dTime<<"</DataArray>\n"
+    <<"      <DataArray type=\"Int32\" Name=\"CYCLE\" NumberOfTuples=\"1\" format=\"ascii\">"
+    <<dump.nTimeStepIndex<<"</DataArray>\n"
+    <<"    </FieldData>\n"
+    <<"    <Piece Extent=\""<<ssExtent.str()<<"\">\n"
+    <<"      <CellData Scalars=\"rho\" Vectors=\"vel\">\n";
+  for(unsigned int n=0;n<vecArrays.size();n++){
+    if(vecArrays[n].sName=="Points"){
+      ofFile<<"      </CellData>\n"
+        <<"      <Points>\n";
+    }
+    ofFile<<"        <DataArray type=\"Float64\"";
+    if(vecArrays[n].sName!="Points"){
+      ofFile<<" Name=\""<<vecArrays[n].sName<<"\"";
+    }
+    ofFile<<" NumberOfComponents=\""<<vecArrays[n].nNumComponents
+      <<"\" format=\"appended\" offset=\""<<vecnOffsets[n]<<"\"/>\n";
+  }
+  ofFile<<"      </Points>\n"
+    <<"    </Piece>\n"
+    <<"  </StructuredGrid>\n"
+    <<"  <AppendedData encoding=\"raw\">\n"
+    <<"   _";
+  
+  //write the appended data
+  for(unsigned int n=0;n<vecArrays.size();n++){
+    ofFile.write(&vecArrays[n].veccEncoded[0],vecArrays[n].veccEncoded.size());
+    std::vector<char>().swap(vecArrays[n].veccEncoded);
+  }
+  ofFile<<"\n  </AppendedData>\n"
+    <<"</VTKFile>\n";
+  ofFile.close();
+  if(ofFile.fail()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error writing the VTK file \""<<sVTKFileName<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+}
+void writeVTKCollection(std::vector<std::string> vecsFileNames){
+  
+  //simulation time of each file, from its header, each file is listed once
+  std::vector<std::pair<double,std::string> > vecFiles;
+  std::vector<std::string> vecsListed;
+  for(unsigned int n=0;n<vecsFileNames.size();n++){
+    std::string sFileName=vecsFileNames[n];
+    std::string sExtension=sFileName.substr(sFileName.size()-4,1);
+    if(sExtension.compare(".")==0){//if there is an extension remove it
+      sFileName=sFileName.substr(0,sFileName.size()-4);
+    }
+    if(std::find(vecsListed.begin(),vecsListed.end(),sFileName)!=vecsListed.end()){
+      continue;
+    }
+    vecsListed.push_back(sFileName);
+    dumpFile dump;
+    dump.open(sFileName,nDumpFileVersion);
+    vecFiles.push_back(std::pair<double,std::string>(dump.dTime,sFileName+".vts"));
+  }
+  std::stable_sort(vecFiles.begin(),vecFiles.end());
+  
+  //name the collection after the first file without its time step index, e.g. run1_t00001000
+  std::string sFirst=vecFiles[0].second.substr(0,vecFiles[0].second.size()-4);
+  size_t nDir=sFirst.find_last_of("/");
+  std::string sDir;
+  if(nDir!=std::string::npos){
+    sDir=sFirst.substr(0,nDir+1);
+  }
+  std::string sCollectionFileName=sGetRunName(sFirst)+".pvd";
+  
+  //file names are relative to the collection
+  std::ofstream ofFile;
+  ofFile.open(sCollectionFileName.c_str());
+  if(!ofFile.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error opening the VTK collection file \""<<sCollectionFileName<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+  ofFile<<"<?xml version=\"1.0\"?>\n"
+    <<"<VTKFile type=\"Collection\" version=\"0.1\">\n"
+    <<"  <Collection>\n";
+  for(unsigned int n=0;n<vecFiles.size();n++){
+    std::string sFile=vecFiles[n].second;
+    if(sDir.size()>0&&sFile.compare(0,sDir.size(),sDir)==0){
+      sFile=sFile.substr(sDir.size());
+    }
+    else if(sDir.size()>0&&sFile.substr(0,1)!="/"){
+      char *cPath=realpath(vecFiles[n].second.c_str(),NULL);
+      if(cPath!=NULL){
+        sFile=cPath;
+        free(cPath);
+      }
+    }
+    ofFile<<"    <DataSet timestep=\""<<std::setprecision(17)<<vecFiles[n].first
+      <<"\" group=\"\" part=\"0\" file=\""<<sFile<<"\"/>\n";
+  }
+  ofFile<<"  </Collection>\n"
+    <<"</VTKFile>\n";
+  ofFile.close();
+  if(ofFile.fail()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error writing the VTK collection file \""<<sCollectionFileName<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+}
+void makeGlobalScalars(std::string sFileName,int nShellThreads){
+  
+  //open input file
+  std::string sExtension=sFileName.substr(sFileName.size()-4,1);
+  if(sExtension.compare(".")==0){//if there is an extension remove it
+    sFileName=sFileName.substr(0,sFileName.size()-4);
+  }
+  if(sFileName.size()==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": no input file specified\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  dumpFile dump;
+  dump.open(sFileName,nDumpFileVersion);
+  
+  //radialize the grid, the same way as for a radial profile
+  radialProfile profile;
+  makeRadialProfile(dump,nShellThreads,profile);
+  double ****dGrid=profile.dGrid;
+  double **dMax=profile.dMax;
+  double **dAve=profile.dAve;
+  
+  //surface values, at the outer interface and the outer most zone
+  int nSurface=dump.nGlobalGridDims[0]+2*dump.nNumGhostCells;
+  globalScalars scalars;
+  scalars.nTimeStepIndex=dump.nTimeStepIndex;
+  scalars.dTime=dump.dTime;
+  scalars.bGammaLaw=dump.bGammaLaw;
+  scalars.dM=dGrid[nM][nSurface][0][0];
+  scalars.dR=dGrid[nR][nSurface][0][0];
+  scalars.dU0=dGrid[nU0][nSurface][0][0];
+  
+  //sum kinetic energies of the shells, and find the largest deviations from the grid velocity
+  scalars.dKEP=0.0;
+  for(int i=0;i<nSurface;i++){
+    scalars.dKEP+=dAve[nKEP][i];
+  }
+  scalars.dUmU0Max=-1.0*std::numeric_limits<double>::max();
+  for(int i=0;i<=nSurface;i++){
+    scalars.dUmU0Max=std::max(scalars.dUmU0Max,dMax[nU][i]-dGrid[nU0][i][0][0]);
+  }
+  
+  //luminosities, temperatures and convection are only calculated with a tabulated equation of state
+  scalars.dL_rad=0.0;
+  scalars.dL_con=0.0;
+  scalars.dT_eff=0.0;
+  scalars.dKETot=0.0;
+  scalars.dF_conMax=0.0;
+  scalars.dTmTAveMax=0.0;
+  if(!dump.bGammaLaw){
+    scalars.dL_rad=dAve[nL_rad][nSurface-1];
+    scalars.dL_con=dAve[nL_con][nSurface-1];
+    scalars.dT_eff=dAve[nT][nSurface-1]*pow(2.0,0.25);
+    scalars.dF_conMax=-1.0*std::numeric_limits<double>::max();
+    scalars.dTmTAveMax=-1.0*std::numeric_limits<double>::max();
+    for(int i=0;i<nSurface;i++){
+      scalars.dKETot+=dAve[nKETot][i];
+      scalars.dF_conMax=std::max(scalars.dF_conMax,dMax[nF_con][i]);
+      scalars.dTmTAveMax=std::max(scalars.dTmTAveMax,dMax[nT][i]-dAve[nT][i]);
+    }
+  }
+  freeRadialProfile(profile);
+  
+  pthread_mutex_lock(&mutexGlobalScalars);
+  vecGlobalScalars.push_back(scalars);
+  pthread_mutex_unlock(&mutexGlobalScalars);
+}
+bool bGlobalScalarsEarlier(const globalScalars &scalars1,const globalScalars &scalars2){
+  return scalars1.dTime<scalars2.dTime;
+}
+void writeGlobalScalars(std::vector<std::string> vecsFileNames){
+  
+  //order by time, a dump given more than once is listed once
+  std::vector<globalScalars> vecScalars;
+  std::stable_sort(vecGlobalScalars.begin(),vecGlobalScalars.end(),bGlobalScalarsEarlier);
+  for(unsigned int n=0;n<vecGlobalScalars.size();n++){
+    if(vecScalars.size()>0&&vecScalars.back().dTime==vecGlobalScalars[n].dTime
+      &&vecScalars.back().nTimeStepIndex==vecGlobalScalars[n].nTimeStepIndex){
+      continue;
+    }
+    vecScalars.push_back(vecGlobalScalars[n]);
+  }
+  
+  //open output file
+  std::string sFileNameOut=sGetRunName(vecsFileNames[0])+"_lc.txt";
+  std::ofstream ofFile;
+  ofFile.open(sFileNameOut.c_str());
+  if(!ofFile.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": output file \""
+      <<sFileNameOut<<" didn't open properly\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+  
+  //set double output precision
+  ofFile.precision(nPrecisionAscii);
+  if(bScientific){
+    ofFile.unsetf(std::ios::fixed);
+    ofFile.setf(std::ios::scientific);
+  }
+  else{
+    ofFile.unsetf(std::ios::scientific);
+    ofFile.setf(std::ios::fixed);
+  }
+  
+  //write out header
+  int nWidthOutputField=25;
+  int nWidthIntOutputField=12;
+  ofFile<<std::setw(nWidthIntOutputField)<<"index(1)"
+    <<std::setw(nWidthOutputField)<<"t[s](2)"
+    <<std::setw(nWidthOutputField)<<"L_rd[L_sun](3)"
+    <<std::setw(nWidthOutputField)<<"L_cv[L_sun](4)"
+    <<std::setw(nWidthOutputField)<<"T_eff[K](5)"
+    <<std::setw(nWidthOutputField)<<"M_r[g](6)"
+    <<std::setw(nWidthOutputField)<<"R[cm](7)"
+    <<std::setw(nWidthOutputField)<<"U0[cm/s](8)"
+    <<std::setw(nWidthOutputField)<<"g[cm/s^2](9)"
+    <<std::setw(nWidthOutputField)<<"DU0Dt[cm/s^2](10)"
+    <<std::setw(nWidthOutputField)<<"KEP[ergs](11)"
+    <<std::setw(nWidthOutputField)<<"KETot[ergs](12)"
+    <<std::setw(nWidthOutputField)<<"F_cv_max[L_sun/cm^2](13)"
+    <<std::setw(nWidthOutputField)<<"(U-U0)_max[cm/s](14)"
+    <<std::setw(nWidthOutputField)<<"(T-<T>)_max[K](15)"
+    <<std::endl;
+  
+  //write out one line per dump, the acceleration of the surface is taken from the next dump
+  for(unsigned int n=0;n<vecScalars.size();n++){
+    ofFile<<std::setw(nWidthIntOutputField)<<vecScalars[n].nTimeStepIndex//1
+      <<std::setw(nWidthOutputField)<<vecScalars[n].dTime;//2
+    if(vecScalars[n].bGammaLaw){
+      ofFile<<std::setw(nWidthOutputField)<<"-"//3
+        <<std::setw(nWidthOutputField)<<"-"//4
+        <<std::setw(nWidthOutputField)<<"-";//5
+    }
+    else{
+      ofFile<<std::setw(nWidthOutputField)<<vecScalars[n].dL_rad/dLSun//3
+        <<std::setw(nWidthOutputField)<<vecScalars[n].dL_con/dLSun//4
+        <<std::setw(nWidthOutputField)<<vecScalars[n].dT_eff;//5
+    }
+    ofFile<<std::setw(nWidthOutputField)<<vecScalars[n].dM//6
+      <<std::setw(nWidthOutputField)<<vecScalars[n].dR//7
+      <<std::setw(nWidthOutputField)<<vecScalars[n].dU0//8
+      <<std::setw(nWidthOutputField)<<dG*vecScalars[n].dM/(vecScalars[n].dR*vecScalars[n].dR);//9
+    if(n+1<vecScalars.size()){
+      ofFile<<std::setw(nWidthOutputField)<<(vecScalars[n+1].dU0-vecScalars[n].dU0)
+        /(vecScalars[n+1].dTime-vecScalars[n].dTime);//10
+    }
+    else{
+      ofFile<<std::setw(nWidthOutputField)<<"-";//10
+    }
+    ofFile<<std::setw(nWidthOutputField)<<vecScalars[n].dKEP;//11
+    if(vecScalars[n].bGammaLaw){
+      ofFile<<std::setw(nWidthOutputField)<<"-"//12
+        <<std::setw(nWidthOutputField)<<"-"//13
+        <<std::setw(nWidthOutputField)<<vecScalars[n].dUmU0Max//14
+        <<std::setw(nWidthOutputField)<<"-";//15
+    }
+    else{
+      ofFile<<std::setw(nWidthOutputField)<<vecScalars[n].dKETot//12
+        <<std::setw(nWidthOutputField)<<vecScalars[n].dF_conMax/dLSun//13
+        <<std::setw(nWidthOutputField)<<vecScalars[n].dUmU0Max//14
+        <<std::setw(nWidthOutputField)<<vecScalars[n].dTmTAveMax;//15
+    }
+    ofFile<<std::endl;
+  }
+  ofFile.close();
+  if(ofFile.fail()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error writing the light curve file \""<<sFileNameOut<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+}
+std::string sGetRunName(std::string sFileName){
+  std::string sExtension=sFileName.substr(sFileName.size()-4,1);
+  if(sExtension.compare(".")==0){//if there is an extension remove it
+    sFileName=sFileName.substr(0,sFileName.size()-4);
+  }
+  size_t nDir=sFileName.find_last_of("/");
+  std::string sDir;
+  if(nDir!=std::string::npos){
+    sDir=sFileName.substr(0,nDir+1);
+  }
+  std::string sBase=sFileName.substr(sDir.size());
+  size_t nLast=sBase.find_last_not_of("0123456789");
+  if(nLast!=std::string::npos&&nLast+1<sBase.size()){
+    sBase=sBase.substr(0,nLast+1);
+    if(sBase.size()>2&&sBase.substr(sBase.size()-2)=="_t"){
+      sBase=sBase.substr(0,sBase.size()-2);
+    }
+  }
+  return sDir+sBase;
+}
 void setExeDir(){
   char buff[1024];
   ssize_t len = readlink("/proc/self/exe", buff, sizeof(buff)-1);
@@ -15,6 +15,9 @@
 #ifdef HDF_ENABLE
   #include "mfhdf.h"
 #endif
+#ifdef ZLIB_ENABLE
+  #include <zlib.h>
+#endif
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -28,84 +31,95 @@
 #include <fenv.h>
 #include <limits>
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <glob.h>
+#include <map>
+#include <stdint.h>
+#include "eos.h"
+#include "dumpFile.h"
 
-int nM;/**<
+//grid indices, thread local as each thread may be processing a different kind of model
+__thread int nM;/**<
   Index of \f$M_r\f$ in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nTheta;/**<
+__thread int nTheta;/**<
   Index of \f$\theta\f$ in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nPhi;/**<
+__thread int nPhi;/**<
   Index of \f$\phi\f$ in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nDM;/**<
+__thread int nDM;/**<
   Index of \f$\delta M\f$ in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nR;/**<
+__thread int nR;/**<
   Index of \f$R\f$, radius, in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nD;/**<
+__thread int nD;/**<
   Index of \f$\rho\f$, density, in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nU;/**<
+__thread int nU;/**<
   Index of \f$u\f$,radial velocity, in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nU0;/**<
+__thread int nU0;/**<
   Index of \f$u_0\f$, radial grid velocity, in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nV;/**<
+__thread int nV;/**<
   Index of \f$v\f$, theta velocity in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nW;/**<
+__thread int nW;/**<
   Index of \f$w\f$, phi velocity, in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nE;/**<
+__thread int nE;/**<
   Index of \f$E\f$, internal energy, in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nT;/**<
+__thread int nT;/**<
   Index of \f$T\f$, temperature, in grids,
   This should be the same as that used in SPHERLS defined in global.h
   */
-int nP;/**<
+__thread int nP;/**<
   Index of \f$P\f$, pressure
   */
-int nQ;/**<
+__thread int nQ;/**<
   Index of the artificial viscosity in grids. 
   */
-int nKappa;/**<
+__thread int nKappa;/**<
   Index of the opacity in grids. 
   */
-int nGamma;/**<
+__thread int nGamma;/**<
   Index of the adiabatic gamma. 
   */
-int nL_rad;/**<
+__thread int nL_rad;/**<
   Index of the Radiative Luminosity.
   */
-int nL_con;/**<
+__thread int nL_con;/**<
   Index of the Convective Luminosity.
   */
-int nKEP;/**<
+__thread int nKEP;/**<
   Index of the Kinetic energy stored in pulsation.
   */
-int nKETot;/**<
+__thread int nKETot;/**<
   Index of the total kinetic energy
   */
-int nC;/**<
+__thread int nC;/**<
   Index of the sound speed.
   */
   
-int nF_con;/**<
+__thread int nF_con;/**<
   Index of the convective luminosity.
   */
 
@@ -125,6 +139,9 @@ const double dSigma=5.67040040E-5;/**<
 const double dLSun=3.839e33;/**<
   Luminosity of the sun in erg/s
   */
+const double dG=6.67259e-8;/**<
+  Gravitational constant in cm^3/(g s^2)
+  */
 const int nDumpFileVersion=1;/**<
   Version of the dump file supported
   */
@@ -138,16 +155,657 @@ std::string sEOSFile="";/**<
 std::string sExeDir;/**<
   The directory where this executable lives
   */
+int nNumThreads=0;/**<
+  Number of threads used to combine distributed binary files, set with the "-j" flag. If 0 the
+  number of online processors is used.
+  */
+int nMemoryBudgetMB=0;/**<
+  Memory in megabytes which the files being processed at the same time may use, set with the "-m"
+  flag. If 0 half of the physical memory is used.
+  */
+const size_t nBatchMemoryFactor=3;/**<
+  Memory needed to process a file is estimated as this multiple of its size, to account for the
+  derived quantities calculated from it.
+  */
+std::map<std::string,eos*> mapEOSTables;/**<
+  Equation of state tables which have been read in, by file name, so that each is read only once.
+  */
+pthread_mutex_t mutexEOSTables=PTHREAD_MUTEX_INITIALIZER;/**<
+  Protects \ref mapEOSTables.
+  */
+const int nProfileShellChunk=8;/**<
+  Number of consecutive radial shells a thread takes at a time when making a radial profile. The
+  equation of state of the outer neighbour of each shell is reused for the next shell of the chunk.
+  */
+const int nMaxCombineDumps=256;/**<
+  Maximum number of dumps combined at the same time by \ref combineBinFiles, this limits the number
+  of open output files.
+  */
+const size_t nCombineAlignment=4096;/**<
+  Alignment in bytes of the buffers distributed binary files are read into.
+  */
+const size_t nCombineWriteBufferSize=1048576;/**<
+  Number of doubles each thread buffers before writing them to a collected binary file.
+  */
+#ifndef HAVE_PWRITE
+pthread_mutex_t mutexCollectedFiles=PTHREAD_MUTEX_INITIALIZER;/**<
+  Makes each seek and write to a collected binary file atomic when pwrite is not available.
+  */
+#endif
+int nSpectrumSegment=0;/**<
+  Number of evenly spaced points in each segment of a Welch averaged power spectrum, set with the
+  "w" modifier of the "-t" flag. If 0 the whole time series is transformed at once and amplitudes
+  and phases are written.
+  */
+bool bLombScargle=false;/**<
+  If true the "-t" flag computes a Lomb-Scargle periodogram directly on the uneven time steps
+  instead of a Fourier transform, set with the "s" modifier of the "-t" flag.
+  */
+const int nLombScargleMaxFrequencies=16384;/**<
+  Maximum number of frequencies of a Lomb-Scargle periodogram. Frequencies are multiples of one
+  over the length of the series up to the average Nyquist frequency, or this many.
+  */
+const int nLombScargleChunk=4096;/**<
+  Number of samples read from a time series at a time when computing a Lomb-Scargle periodogram.
+  */
+const char sFFTWWisdomFileName[]=".SPHERLSanal_fftw_wisdom";/**<
+  Name of the file in the home directory FFTW plans are cached in between runs.
+  */
+bool bVTKCompress=false;/**<
+  If true the arrays of VTK files are compressed with zlib, set with the "z" modifier of the "-k"
+  flag.
+  */
+bool bVTKSpherical=false;/**<
+  If true VTK files use r, theta and phi as the coordinates of the grid and the components of the
+  velocity instead of cartesian ones, set with the "s" modifier of the "-k" flag.
+  */
+const size_t nVTKCompressBlockSize=1048576;/**<
+  Number of bytes of an array of a VTK file compressed at a time, VTK readers decompress one block
+  at a time.
+  */
 //functions
 void convertDistBinToAscii(std::string sFileNameBase);
-void combineBinFiles(std::string sFileNameBase);
+struct distributedDump{
+  std::string sFileNameBase;/**<
+    Base name of the distributed binary files, also the name of the collected binary file
+    */
+  int nNumFiles;/**<
+    Number of distributed binary files, one per processor
+    */
+  int nGlobalGridDims[3];/**<
+    Size of the global grid
+    */
+  int nGlobalProcDims[3];/**<
+    Number of processors in each direction
+    */
+  int nPeriodic[3];/**<
+    Periodicity of the grid in each direction
+    */
+  int nNumGhostCells;/**<
+    Number of ghost cells
+    */
+  int nNumVars;/**<
+    Number of variables in the files
+    */
+  int nNum1DZones;/**<
+    Number of zones in the 1D region
+    */
+  double dTime;/**<
+    Time of the dump
+    */
+  int nTimeStepIndex;/**<
+    Time step index of the dump
+    */
+  double dTimeStep1;/**<
+    Time step at n-1/2
+    */
+  double dTimeStep2;/**<
+    Time step at n+1/2
+    */
+  double dAlpha;/**<
+    Alpha used in the artificial viscosity
+    */
+  int nGammaLaw;/**<
+    0 for a gamma-law gas, otherwise the length of \ref sEOSFileName
+    */
+  double dGamma;/**<
+    Adiabatic gamma for a gamma-law gas
+    */
+  std::string sEOSFileName;/**<
+    Equation of state file
+    */
+  double dA;/**<
+    Artificial viscosity parameter
+    */
+  double dAVThreshold;/**<
+    Artificial viscosity threshold
+    */
+  int **nVariableInfo;/**<
+    Variable information, 4 values for each variable
+    */
+  int ***nFileGridSizes;/**<
+    Local grid sizes of each variable in each file
+    */
+  int **nFileProcCoords;/**<
+    Processor coordinates of each file
+    */
+  off_t *nFileDataStart;/**<
+    Position in bytes of the start of the grid in each file
+    */
+  off_t nHeaderSize;/**<
+    Size of the header of the collected file in bytes
+    */
+  int *nInnerSize;/**<
+    Number of values of each variable in the inner 1D region of processor 0
+    */
+  int *nOuterSize;/**<
+    Number of values of each variable in the outer 1D ghost cells of processor 0, these are not
+    written to the collected file
+    */
+  int **nCollectedSize;/**<
+    Size of the multi-dimensional region of each variable in the collected file
+    */
+  off_t *nVarStart;/**<
+    Position in bytes of the start of each variable in the collected file, the last element is the
+    size of the collected file
+    */
+  int nOutFile;/**<
+    File descriptor of the collected file
+    */
+};/**<
+  Holds the header information of a set of distributed binary files, and the layout of the
+  collected binary file made from them.
+  */
+struct combineTask{
+  distributedDump *dump;/**<
+    Dump the file belongs to
+    */
+  int nFile;/**<
+    Processor number of the file to combine
+    */
+};/**<
+  A single distributed binary file to be written into its collected binary file.
+  */
+struct combineQueue{
+  std::vector<combineTask> vecTasks;/**<
+    Files to combine
+    */
+  size_t nNext;/**<
+    Index of the next task to be started
+    */
+  pthread_mutex_t mutex;/**<
+    Protects \ref nNext, \ref bError and \ref eError
+    */
+  bool bError;/**<
+    Set if a thread failed, no new tasks are started once set
+    */
+  exception2 eError;/**<
+    The first error encountered by a thread
+    */
+};/**<
+  Tasks shared by the threads combining distributed binary files.
+  */
+struct combineBuffers{
+  double *dRead;/**<
+    Aligned buffer holding the grid of one distributed binary file
+    */
+  size_t nReadCapacity;/**<
+    Size of \ref dRead in doubles
+    */
+  double *dWrite;/**<
+    Buffer used by \ref collectedWriter
+    */
+  size_t nWriteCapacity;/**<
+    Size of \ref dWrite in doubles
+    */
+};/**<
+  Buffers owned by a single thread combining distributed binary files.
+  */
+struct collectedWriter{
+  int nFile;/**<
+    File descriptor of the collected file
+    */
+  std::string sFileName;/**<
+    Name of the collected file
+    */
+  double *dBuffer;/**<
+    Values waiting to be written
+    */
+  size_t nCapacity;/**<
+    Size of \ref dBuffer in doubles
+    */
+  size_t nNumBuffered;/**<
+    Number of values in \ref dBuffer
+    */
+  off_t nStart;/**<
+    Position in bytes in the collected file of the first value in \ref dBuffer
+    */
+};/**<
+  Gathers values which are contiguous in a collected binary file so they can be written with a
+  single positional write.
+  */
+void readDistributedHeaders(std::string sFileNameBase,distributedDump &dump);/**<
+  Reads the headers of the distributed binary files starting with \c sFileNameBase, checks that
+  they are compatiable with each other, and records where the grid starts in each file.
+  */
+void setCollectedLayout(distributedDump &dump);/**<
+  Works out the size of each variable in the collected binary file and where it starts. Must be
+  called after \ref writeCollectedHeader.
+  */
+void writeCollectedHeader(distributedDump &dump);/**<
+  Creates the collected binary file and writes out its header.
+  */
+void freeDistributedDump(distributedDump &dump);/**<
+  Frees the memory allocated by \ref readDistributedHeaders and \ref setCollectedLayout.
+  */
+void readBlock(int nFile,std::string sFileName,off_t nOffset,size_t nSize,char *cBuffer);/**<
+  Reads \c nSize bytes starting at \c nOffset from the open file \c nFile with positional reads.
+  */
+void flushCollectedWriter(collectedWriter &writer);/**<
+  Writes the buffered values of \c writer to the collected file with positional writes.
+  */
+void addToCollectedWriter(collectedWriter &writer,off_t nOffset,double *dValues,size_t nNum);/**<
+  Adds \c nNum values to be written at \c nOffset in the collected file. Values are buffered until
+  one that is not contiguous with them in the collected file is added, or the buffer is full.
+  */
+void combineFile(combineTask &task,combineBuffers &buffers);/**<
+  Reads the grid of one distributed binary file in one read, and writes the zones it owns into the
+  collected binary file at their computed positions. Processor 0 owns the inner 1D region, other
+  processors own their local zones and any ghost cells on the edge of the global grid.
+  */
+void* combineWorker(void *vQueue);/**<
+  Thread function, combines files from the \ref combineQueue \c vQueue until there are none left
+  or a thread has failed.
+  */
+struct batchJob{
+  int nOperation;/**<
+    Operation to perform on each file
+    */
+  int nFromFileType;/**<
+    Type of the input files
+    */
+  int nToFileType;/**<
+    Type of the output files for conversions
+    */
+  int nPlane;/**<
+    Plane of 2D slices
+    */
+  int nPlaneIndex;/**<
+    Index of the plane of 2D slices
+    */
+  int nShellThreads;/**<
+    Number of threads the radial shells of each file are shared among when making radial profiles
+    */
+};/**<
+  The operation requested on the command line, performed on every file given.
+  */
+struct batchQueue{
+  batchJob job;/**<
+    Operation to perform on each file
+    */
+  std::vector<std::string> vecsFileNames;/**<
+    Files to process
+    */
+  std::vector<size_t> vecnMemory;/**<
+    Estimated memory in bytes needed to process each file
+    */
+  size_t nNext;/**<
+    Index of the next file to be started
+    */
+  size_t nMemoryBudget;/**<
+    Memory in bytes the files being processed may use at the same time
+    */
+  size_t nMemoryInUse;/**<
+    Memory in bytes used by the files currently being processed
+    */
+  int nNumFailed;/**<
+    Number of files which failed
+    */
+  pthread_mutex_t mutex;/**<
+    Protects the members of the queue, and output to std::cout of errors
+    */
+  pthread_cond_t condMemory;/**<
+    Signaled when a file is finished and its memory released
+    */
+};/**<
+  Files shared by the threads of \ref processFiles.
+  */
+struct gridIndices{
+  int nM;/**<
+    Index of \ref ::nM
+    */
+  int nTheta;/**<
+    Index of \ref ::nTheta
+    */
+  int nPhi;/**<
+    Index of \ref ::nPhi
+    */
+  int nDM;/**<
+    Index of \ref ::nDM
+    */
+  int nR;/**<
+    Index of \ref ::nR
+    */
+  int nD;/**<
+    Index of \ref ::nD
+    */
+  int nU;/**<
+    Index of \ref ::nU
+    */
+  int nU0;/**<
+    Index of \ref ::nU0
+    */
+  int nV;/**<
+    Index of \ref ::nV
+    */
+  int nW;/**<
+    Index of \ref ::nW
+    */
+  int nE;/**<
+    Index of \ref ::nE
+    */
+  int nT;/**<
+    Index of \ref ::nT
+    */
+  int nP;/**<
+    Index of \ref ::nP
+    */
+  int nQ;/**<
+    Index of \ref ::nQ
+    */
+  int nKappa;/**<
+    Index of \ref ::nKappa
+    */
+  int nGamma;/**<
+    Index of \ref ::nGamma
+    */
+  int nL_rad;/**<
+    Index of \ref ::nL_rad
+    */
+  int nL_con;/**<
+    Index of \ref ::nL_con
+    */
+  int nKEP;/**<
+    Index of \ref ::nKEP
+    */
+  int nKETot;/**<
+    Index of \ref ::nKETot
+    */
+  int nC;/**<
+    Index of \ref ::nC
+    */
+  int nF_con;/**<
+    Index of \ref ::nF_con
+    */
+};/**<
+  A copy of the thread local grid indices, used to hand the indices of a model to the threads
+  helping to process it.
+  */
+struct profileShells{
+  double ****dGrid;/**<
+    Grid variables of the model
+    */
+  double **dMax;/**<
+    Horizontal maximum of each variable in each shell
+    */
+  double **dMin;/**<
+    Horizontal minimum of each variable in each shell
+    */
+  double **dAve;/**<
+    Horizontal average of each variable in each shell
+    */
+  int **nMaxJIndex;/**<
+    Theta index of the horizontal maximum of each variable in each shell
+    */
+  int **nMaxKIndex;/**<
+    Phi index of the horizontal maximum of each variable in each shell
+    */
+  int **nMinJIndex;/**<
+    Theta index of the horizontal minimum of each variable in each shell
+    */
+  int **nMinKIndex;/**<
+    Phi index of the horizontal minimum of each variable in each shell
+    */
+  eos *eosTable;/**<
+    Equation of state of the model
+    */
+  gridIndices indices;/**<
+    Grid indices of the model
+    */
+  int nNumDims;/**<
+    Number of dimensions of the model
+    */
+  int nSizeX1;/**<
+    First radial shell of the multi-dimensional region
+    */
+  int nSizeX2;/**<
+    One past the last radial shell
+    */
+  int nSizeY;/**<
+    Size of the grid in the theta-direction, including ghost cells
+    */
+  int nStartY;/**<
+    First theta index of the shells
+    */
+  int nEndY;/**<
+    One past the last theta index of the shells
+    */
+  int nSizeZ;/**<
+    Size of the grid in the phi-direction, including ghost cells
+    */
+  int nStartZ;/**<
+    First phi index of the shells
+    */
+  int nEndZ;/**<
+    One past the last phi index of the shells
+    */
+  double dA;/**<
+    Artificial viscosity parameter
+    */
+  double dAVThreshold;/**<
+    Artificial viscosity threshold
+    */
+  int nNext;/**<
+    First shell of the next chunk to be started
+    */
+  pthread_mutex_t mutex;/**<
+    Protects \ref nNext, \ref bError and \ref eError
+    */
+  bool bError;/**<
+    Set if a thread failed, no new chunks are started once set
+    */
+  exception2 eError;/**<
+    The first error encountered by a thread
+    */
+};/**<
+  Radial shells of a model with a tabulated equation of state shared by the threads of
+  \ref makeRadialProfile.
+  */
+struct radialProfile{
+  double ****dGrid;/**<
+    Grid variables of the model, they belong to the dump file the profile was made from
+    */
+  int nNumVars;/**<
+    Number of grid variables
+    */
+  int nNumIntVars;/**<
+    Number of variables calculated from the grid variables, e.g. pressure and luminosity
+    */
+  double **dMax;/**<
+    Horizontal maximum of each variable in each shell
+    */
+  double **dMin;/**<
+    Horizontal minimum of each variable in each shell
+    */
+  double **dAve;/**<
+    Horizontal average of each variable in each shell
+    */
+  int **nMaxJIndex;/**<
+    Theta index of the horizontal maximum of each variable in each shell
+    */
+  int **nMaxKIndex;/**<
+    Phi index of the horizontal maximum of each variable in each shell
+    */
+  int **nMinJIndex;/**<
+    Theta index of the horizontal minimum of each variable in each shell
+    */
+  int **nMinKIndex;/**<
+    Phi index of the horizontal minimum of each variable in each shell
+    */
+  double *dUpFlowFillingFactor;/**<
+    Fraction of each shell moving outward faster than the grid
+    */
+  eos eosTable;/**<
+    Equation of state of the model, not set for a gamma law gas
+    */
+};/**<
+  Horizontal averages, maximums and minimums of the grid variables and the quantities calculated
+  from them in each radial shell of a model.
+  */
+struct globalScalars{
+  int nTimeStepIndex;/**<
+    Index of the time step of the dump
+    */
+  double dTime;/**<
+    Simulation time of the dump
+    */
+  bool bGammaLaw;/**<
+    True if the dump uses a gamma law gas, the luminosities, temperatures and convective flux are
+    then not defined
+    */
+  double dL_rad;/**<
+    Radiative luminosity at the surface in erg/s
+    */
+  double dL_con;/**<
+    Convective luminosity at the surface in erg/s
+    */
+  double dT_eff;/**<
+    Effective temperature, the average temperature of the outer most zone times 2^(1/4)
+    */
+  double dM;/**<
+    Mass inside the surface
+    */
+  double dR;/**<
+    Radius of the surface
+    */
+  double dU0;/**<
+    Velocity of the surface
+    */
+  double dKEP;/**<
+    Kinetic energy of the pulsation, summed over all shells
+    */
+  double dKETot;/**<
+    Total kinetic energy, summed over all shells
+    */
+  double dF_conMax;/**<
+    Largest convective flux in any shell
+    */
+  double dUmU0Max;/**<
+    Largest radial velocity relative to the grid velocity
+    */
+  double dTmTAveMax;/**<
+    Largest temperature above the horizontal average
+    */
+};/**<
+  Global scalars of one dump, one row of a light curve.
+  */
+std::vector<globalScalars> vecGlobalScalars;/**<
+  Global scalars of the files processed with the "-g" flag, in the order they were finished.
+  */
+pthread_mutex_t mutexGlobalScalars=PTHREAD_MUTEX_INITIALIZER;/**<
+  Protects \ref vecGlobalScalars, as the files are processed by several threads.
+  */
+gridIndices getGridIndices();/**<
+  Returns a copy of the grid indices of the calling thread.
+  */
+void setGridIndices(const gridIndices &indices);/**<
+  Sets the grid indices of the calling thread to \c indices.
+  */
+void makeShellProfiles_TEOS(profileShells &shells,int nFirst,int nLast);/**<
+  Calculates the horizontal averages, maximums and minimums of the equation of state quantities,
+  luminosities, kinetic energies, artificial viscosity and sound speed of the shells \c nFirst up
+  to but not including \c nLast. The equation of state is evaluated for a whole shell at a time,
+  and the values of the outer neighbour of a shell are kept for the next shell.
+  */
+void* profileShellWorker(void *vShells);/**<
+  Thread function, calculates chunks of \ref nProfileShellChunk shells of the \ref profileShells
+  \c vShells until there are none left.
+  */
+eos& getEOSTable(std::string sFileName);/**<
+  Returns the equation of state table in \c sFileName, reading it in only the first time it is
+  requested.
+  */
+std::vector<std::string> expandFileNames(std::vector<std::string> vecsFileNames
+  ,std::string sBatchListFile,bool bDistributed);/**<
+  Adds the file names listed one per line in \c sBatchListFile, if given, and expands any wildcards
+  not already expanded by the shell. If \c bDistributed is true, matches ending in "-<integer>"
+  are replaced by their base name.
+  */
+void processFile(batchJob &job,std::string sFileName);/**<
+  Performs the operation \c job on a single file. Distributed binary files must already have been
+  combined.
+  */
+void* batchWorker(void *vQueue);/**<
+  Thread function, processes files from the \ref batchQueue \c vQueue until there are none left.
+  Before starting a file it waits until its estimated memory fits in the memory budget, or no other
+  file is being processed. Errors are reported and counted, and do not stop the other files.
+  */
+void processFiles(batchJob &job,std::vector<std::string> vecsFileNames);/**<
+  Performs the operation \c job on each of \c vecsFileNames using \ref nNumThreads threads,
+  keeping the estimated memory of the files being processed at once within
+  \ref nMemoryBudgetMB.
+  */
+void combineBinFiles(std::string sFileNameBase);/**<
+  Combines the distributed binary files starting with \c sFileNameBase into a collected binary
+  file named \c sFileNameBase.
+  */
+void combineBinFiles(std::vector<std::string> vecsFileNameBases);/**<
+  Combines the distributed binary files of each dump in \c vecsFileNameBases into collected binary
+  files. The files of all dumps are shared between \ref nNumThreads threads, each file is read in
+  one aligned read and its zones are written directly to their place in the collected file, so no
+  file is read or written sequentially by a single thread.
+  */
 void convertCollBinToAscii(std::string sFileName);
 void convertCollAsciiToBin(std::string sFileName);
-void makeRadialProFromColBin(std::string sFileName);
+void makeRadialProFromColBin(std::string sFileName,int nShellThreads=1);
+void makeRadialProfile(dumpFile &dump,int nShellThreads,radialProfile &profile);/**<
+  Calculates the horizontal averages, maximums and minimums of every shell of the dump file
+  \c dump, including the equation of state quantities, luminosities and kinetic energies. Up to
+  \c nShellThreads threads share the shells. Also sets the grid indices of the calling thread.
+  The profile is freed with \ref freeRadialProfile.
+  */
+void freeRadialProfile(radialProfile &profile);/**<
+  Frees the profile statistics made by \ref makeRadialProfile.
+  */
+void makeGlobalScalars(std::string sFileName,int nShellThreads);/**<
+  Calculates the global scalars of the collected binary file \c sFileName from its radial profile
+  and adds them to \ref vecGlobalScalars.
+  */
+bool bGlobalScalarsEarlier(const globalScalars &scalars1,const globalScalars &scalars2);/**<
+  Returns true if \c scalars1 is from a dump earlier in time than \c scalars2.
+  */
+void writeGlobalScalars(std::vector<std::string> vecsFileNames);/**<
+  Writes the global scalars in \ref vecGlobalScalars in order of time as a light curve, one line
+  per dump. It is named after the first of \c vecsFileNames without its time step index with
+  "_lc.txt" appended, and put next to it.
+  */
+std::string sGetRunName(std::string sFileName);/**<
+  Returns the collected binary file name \c sFileName without its extension and time step index,
+  e.g. run1 for run1_t00001000.
+  */
 void printHelp();
 bool bFileExists(std::string strFilename);
 void fpSignalHandler(int nSig);
-void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex);
+void readSliceVariable(dumpFile &dump,int nVar,const std::vector<bool> &vecbRowsX
+  ,const std::vector<bool> &vecbRowsY,int nStartZ,int nEndZ,double ***dVariable);/**<
+  Copies variable \c nVar of the collected binary file \c dump into \c dVariable. The 1D region
+  is always copied, of the rest only the rows with both \c vecbRowsX[i] and \c vecbRowsY[j] set
+  are allocated and copied, and only between \c nStartZ and \c nEndZ, other rows are left NULL.
+  */
+void make2DSlice(std::string sFileName,int nPlane,int nPlaneIndex);/**<
+  Makes a 2D slice of the collected binary file \c sFileName. Only the rows of the grid the plane
+  \c nPlane at \c nPlaneIndex and its neighbours need are copied out of the mapped file.
+  */
 void convertBinToLNA(std::string sFileName);
 double dCalRhoAve3D(double ****dGrid,int nI,int nStartY,int nEndY,int nStartZ,int nEndZ);/**
   Calculates a volume weighted average density given the grid varibles, dGrid and the radial
@@ -158,8 +816,129 @@ double dCalRhoAve2D(double ****dGrid,int nI,int nStartY,int nEndY,int nStartZ,in
   index, nI, the start and stop indices in the Y and Z direction. For the 2D case.
 */
 #ifdef FFTW_ENABLE
-void computeFourierTransFromList(std::string sInFileName,std::string sOutFileName);
-void computeFourierTrans(std::string sInFileName,std::string sOutFileName);
+struct timeSeries{
+  std::ifstream ifIn;/**<
+    File the samples are read from.
+    */
+  bool bWatchZone;/**<
+    True if the file is a watch zone file, false if it is a two column text file.
+    */
+  bool bBinary;/**<
+    True if the file is a binary watch zone file.
+    */
+  std::string sFileName;/**<
+    Name of the file.
+    */
+};/**<
+  A time series read one sample at a time, either the radial velocity at i+1/2 from a text or binary
+  watch zone file, or the second column of a two column text file.
+  */
+void openTimeSeries(std::string sFileName,bool bWatchZone,timeSeries &series);/**<
+  Opens the time series in \c sFileName and positions it at the first sample.
+  */
+bool bReadTimeSeriesSample(timeSeries &series,double &dTime,double &dValue);/**<
+  Reads the next sample of \c series with a defined value, returns false at the end of the series.
+  */
+struct uniformResampler{
+  timeSeries series;/**<
+    Series being resampled.
+    */
+  double dTimeStart;/**<
+    Time of the first evenly spaced sample.
+    */
+  double dDeltaTime;/**<
+    Spacing of the evenly spaced samples.
+    */
+  size_t nIndex;/**<
+    Index of the next evenly spaced sample.
+    */
+  double dTimePrev;/**<
+    Time of the sample of the series before the next evenly spaced sample.
+    */
+  double dValuePrev;/**<
+    Value of the sample of the series before the next evenly spaced sample.
+    */
+  double dTimeNext;/**<
+    Time of the sample of the series after the next evenly spaced sample.
+    */
+  double dValueNext;/**<
+    Value of the sample of the series after the next evenly spaced sample.
+    */
+};/**<
+  Linearly interpolates a time series to evenly spaced times as it is read.
+  */
+void openUniformResampler(std::string sFileName,bool bWatchZone,double dTimeStart
+  ,double dDeltaTime,uniformResampler &resampler);/**<
+  Opens the time series in \c sFileName to be interpolated to the times \c dTimeStart plus
+  multiples of \c dDeltaTime.
+  */
+double dNextUniformSample(uniformResampler &resampler);/**<
+  Returns the value of the series interpolated to the next evenly spaced time.
+  */
+void computeFourierTrans(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,int nThreads);/**<
+  Computes the spectrum of the time series in \c sInFileName and writes it to \c sOutFileName.
+  The series is read in a first pass to find its length and mean, then streamed again to compute
+  either the Fourier transform of the whole series, a Welch averaged power spectrum if
+  \ref nSpectrumSegment is set, or a Lomb-Scargle periodogram using \c nThreads threads if
+  \ref bLombScargle is set. Only the whole series transform holds the series in memory.
+  
+  @param[in] sInFileName name of the watch zone file, or two column text file
+  @param[in] sOutFileName name of the file to write the spectrum to
+  @param[in] bWatchZone true if \c sInFileName is a watch zone file
+  @param[in] nThreads number of threads used for a Lomb-Scargle periodogram
+  */
+void computeFourierTransWhole(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,size_t nNumSamples,double dTimeFirst,double dTimeLast);/**<
+  Interpolates the whole time series to \c nNumSamples evenly spaced times and writes the
+  frequency, amplitude and phase of its real to complex Fourier transform.
+  */
+void computeWelchSpectrum(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,size_t nNumSamples,double dTimeFirst,double dTimeLast);/**<
+  Interpolates the time series to \c nNumSamples evenly spaced times and averages the power
+  spectra of Hann windowed segments of \ref nSpectrumSegment points overlapping by half. Writes
+  the frequency and one sided power spectral density. Only one segment is held in memory.
+  */
+struct lombScargleBlock{
+  const double* dTimes;/**<
+    Times of the samples of the current chunk, relative to the first time of the series.
+    */
+  const double* dValues;/**<
+    Values of the samples of the current chunk, with the mean of the series subtracted.
+    */
+  int nNumSamples;/**<
+    Number of samples in the current chunk.
+    */
+  int nStart;/**<
+    Index of the first frequency of the block, frequency n is n times \c dDeltaOmega.
+    */
+  int nEnd;/**<
+    One past the index of the last frequency of the block.
+    */
+  double dDeltaOmega;/**<
+    Spacing of the angular frequencies.
+    */
+  double* dSums[5];/**<
+    Sums over the samples for each frequency of y cos, y sin, cos^2, sin^2 and sin cos of the
+    angular frequency times the time.
+    */
+};/**<
+  A range of frequencies of a Lomb-Scargle periodogram handled by one thread.
+  */
+void* lombScargleWorker(void* vBlock);/**<
+  Adds the samples of the current chunk to the sums of the frequencies of a \ref lombScargleBlock.
+  The sines and cosines of successive frequencies are found by rotation.
+  */
+void computeLombScargle(std::string sInFileName,std::string sOutFileName,bool bWatchZone
+  ,size_t nNumSamples,double dTimeFirst,double dTimeLast,double dMean,double dVariance
+  ,int nThreads);/**<
+  Computes a Lomb-Scargle periodogram on the uneven time steps of the series, streaming the samples
+  in chunks of \ref nLombScargleChunk. Writes the frequency, the normalized power and the
+  amplitude of the least squares sinusoid at each frequency.
+  */
+std::string sGetFFTWWisdomFile();/**<
+  Returns the path of the file FFTW plans are cached in, empty if there is no home directory.
+  */
 #endif
 struct watchzone{
   std::vector<double> vecdT;//2
@@ -185,10 +964,66 @@ struct watchzone{
   std::vector<double> vecdDelM_r;//22
   std::vector<double> vecdErrorDelM_r;//23
 };
+const int nNumWatchZoneColumns=23;/**<
+  Number of double precision values per time step in a binary watch zone file, must match the value
+  in SPHERLS watchzone.h.
+  */
+watchzone readInWatchZone(std::string sFileName);/**<
+  Reads in a watch zone file written by SPHERLS, in either the text or the binary format.
+  */
+void openWatchZoneBin(std::string sFileName,std::ifstream &ifIn,int nZone[3],bool &bIsGammaLaw
+  ,double &dGamma);/**<
+  Opens the binary watch zone file \c sFileName, checks its type and version, and reads its header.
+  On return \c ifIn is positioned at the first record.
+  */
+watchzone readInWatchZoneBin(std::string sFileName);/**<
+  Reads in a binary watch zone file written by SPHERLS.
+  */
+void convertWatchZoneBinToAscii(std::string sFileName);/**<
+  Converts a binary watch zone file to the text format written by SPHERLS.
+  */
 #endif
 #ifdef HDF_ENABLE
 void convertBinToHDF4(std::string sFileName);/**<
   converts a collected binary file to an hdf file
 */
 #endif
+struct vtkArray{
+  std::string sName;/**<
+    Name of the array in the VTK file.
+    */
+  int nNumComponents;/**<
+    Number of components of each value, 1 for scalars and 3 for vectors and points.
+    */
+  std::vector<double> vecdValues;/**<
+    Values of the array, components of a value are consecutive. Freed once the array is encoded.
+    */
+  std::vector<char> veccEncoded;/**<
+    The array as it is written to the appended data of the VTK file, with its header.
+    */
+};/**<
+  A data array of a VTK file.
+  */
+double dGetGridValue(dumpFile &dump,double ****dGrid,int n,int i,int j,int k);/**<
+  Returns the value of variable \c n at the grid position \c i, \c j, \c k, including ghost
+  cells. Directions the variable is not defined in are ignored, and rows in the 1D region have the
+  same value for every \c j and \c k.
+  */
+void encodeVTKArray(vtkArray &array);/**<
+  Encodes the values of \c array as they are written to the appended data of a VTK file, the
+  number of bytes followed by the raw values, or zlib compressed blocks of
+  \ref nVTKCompressBlockSize bytes if \ref bVTKCompress is set.
+  */
+void convertBinToVTK(std::string sFileName);/**<
+  Writes the collected binary file \c sFileName as a VTK structured grid, \c sFileName.vts, with
+  binary appended data. The mesh is made from the radius, theta and phi interfaces, and the cell
+  data are the density, energy, pressure, sound speed, convective radial velocity and velocity
+  vector at zone centers, plus the temperature, opacity and adiabatic index with a tabulated
+  equation of state. Ghost cells are not included.
+  */
+void writeVTKCollection(std::vector<std::string> vecsFileNames);/**<
+  Writes a VTK collection, .pvd, listing the VTK files made from the collected binary files
+  \c vecsFileNames in order of their simulation times, so they can be viewed as a time series. It
+  is named after the first file without its time step index and put next to it.
+  */
 void setExeDir();
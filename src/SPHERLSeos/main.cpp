@@ -0,0 +1,1514 @@
+/** @file
+
+  This code makes the combined equation of state and opacity tables used by SPHERLS from the OPAL
+  equation of state tables and the OPAL and Alexander & Ferguson opacity tables. It reads the same
+  configuration files as scripts/eos_interp.py and makes the same tables, with the loops over the
+  files and over the points of the tables shared among threads.
+
+  Usage: SPHERLSeos CONFIGFILE
+
+  \todo The "plot" option of the configuration file is ignored, tables can be inspected with
+  scripts/eos_interp.py.
+*/
+
+#include "exception2.h"
+#include "xmlParser.h"
+#include "xmlFunctions.h"
+#include "eos.h"
+#include "main.h"
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cmath>
+#include <cstdlib>
+#include <cctype>
+#include <vector>
+#include <map>
+#include <limits>
+#include <string>
+#include <algorithm>
+#include <unistd.h>
+
+int main(int argc,char* argv[]){
+  try{
+
+    if(argc!=2){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": usage: SPHERLSeos CONFIGFILE\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+
+    //read in settings and file names
+    readConfig(argv[1]);
+
+    //read in equation of state and opacity tables
+    readEOSFiles();
+    readOpacityFiles();
+
+    //make new tables
+    for(unsigned int n=0;n<vecTableConfigs.size();n++){
+      makeTable(vecTableConfigs[n]);
+    }
+  }
+  catch(exception2& eTemp){
+    std::cout<<eTemp.getMsg();
+    return 1;
+  }
+  return 0;
+}
+void readConfig(std::string sConfigFileName){
+
+  //set directory of executable
+  setExeDir();
+
+  //open file
+  XMLNode xRoot=openXMLFile(sConfigFileName,"root");
+
+  //get number of threads
+  if(!getXMLValueNoThrow(xRoot,"num-threads",0,nNumThreads)||nNumThreads<1){
+    nNumThreads=(unsigned int)(std::max(long(1),sysconf(_SC_NPROCESSORS_ONLN)));
+  }
+
+  //get equation of state files
+  XMLNode xEOSFiles=getXMLNode(getXMLNode(xRoot,"eos",0),"files",0);
+  int nNumEOSFiles=xEOSFiles.nChildNode("file");
+  for(int n=0;n<nNumEOSFiles;n++){
+    eosComposition eosFile;
+    getXMLValue(xEOSFiles,"file",n,eosFile.sFileName);
+    eosFile.sFileName=sDataFilePath(eosFile.sFileName);
+    vecEOSCompositions.push_back(eosFile);
+  }
+  if(vecEOSCompositions.size()==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": no \"file\" nodes found under \"files\" node under \"eos\" node\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //get opacity files
+  XMLNode xOpacity=getXMLNode(xRoot,"opacity",0);
+  XMLNode xOpacityFiles=getXMLNode(xOpacity,"files",0);
+  int nNumOpacityFiles=xOpacityFiles.nChildNode("file");
+  std::map<std::string,int> mapFileIndices;
+  std::vector<std::string> vecsOpacityFileNames;
+  for(int n=0;n<nNumOpacityFiles;n++){
+    std::string sID;
+    std::string sFileName;
+    getXMLAttribute(xOpacityFiles.getChildNode("file",n),"id",sID);
+    getXMLValue(xOpacityFiles,"file",n,sFileName);
+    mapFileIndices[sID]=int(vecsOpacityFileNames.size());
+    vecsOpacityFileNames.push_back(sDataFilePath(sFileName));
+  }
+
+  //get compositions in each opacity file
+  std::vector<std::vector<std::pair<double,double> > > vecFileCompositions(
+    vecsOpacityFileNames.size());
+  std::pair<std::vector<std::string>*,std::vector<std::vector<std::pair<double,double> > >*>
+    pairFiles(&vecsOpacityFileNames,&vecFileCompositions);
+  parallelFor(int(vecsOpacityFileNames.size()),getOpacityCompositionsBody,(void*)(&pairFiles));
+
+  //get opacity tables
+  XMLNode xOpacityTables=getXMLNode(xOpacity,"tables",0);
+  int nNumOpacityTables=xOpacityTables.nChildNode("table");
+  for(int n=0;n<nNumOpacityTables;n++){
+    XMLNode xTable=xOpacityTables.getChildNode("table",n);
+    std::string sFileID;
+    opacityComposition opacityTable;
+    getXMLAttribute(xTable,"fileID",sFileID);
+    getXMLAttribute(xTable,"X",opacityTable.dX);
+    getXMLAttribute(xTable,"Z",opacityTable.dZ);
+    std::map<std::string,int>::iterator it=mapFileIndices.find(sFileID);
+    if(it==mapFileIndices.end()){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": no opacity file with id=\""<<sFileID<<"\" for table "<<n<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+
+    //check that the file has the composition of the table in it
+    std::pair<double,double> pairComposition(opacityTable.dX,opacityTable.dZ);
+    std::vector<std::pair<double,double> > &vecCompositions=vecFileCompositions[it->second];
+    if(std::find(vecCompositions.begin(),vecCompositions.end(),pairComposition)
+      ==vecCompositions.end()){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": unable to find the composition X="<<opacityTable.dX<<" Z="<<opacityTable.dZ
+        <<" in the file specified by fileID=\""<<sFileID<<"\" ("
+        <<vecsOpacityFileNames[it->second]<<")\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    opacityTable.sFileName=vecsOpacityFileNames[it->second];
+    opacityTable.bMultiTable=(vecCompositions.size()>1);
+    vecOpacityCompositions.push_back(opacityTable);
+  }
+  if(vecOpacityCompositions.size()==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": no \"table\" nodes found under \"tables\" node under \"opacity\" node\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //get settings of new tables
+  XMLNode xInterpolatedTables=getXMLNode(xRoot,"interpolatedTables",0);
+  int nNumTables=xInterpolatedTables.nChildNode("table");
+  for(int n=0;n<nNumTables;n++){
+    XMLNode xTable=xInterpolatedTables.getChildNode("table",n);
+    tableConfig config;
+    getXMLValue(xTable,"X",0,config.dX);
+    getXMLValue(xTable,"Z",0,config.dZ);
+    getXMLValue(xTable,"minLogD",0,config.dLogRhoMin);
+    getXMLValue(xTable,"delLogD",0,config.dLogRhoDelta);
+    getXMLValue(xTable,"numLogD",0,config.nNumRho);
+    getXMLValue(xTable,"minLogT",0,config.dLogTMin);
+    getXMLValue(xTable,"delLogT",0,config.dLogTDelta);
+    getXMLValue(xTable,"numLogT",0,config.nNumT);
+    getXMLValue(xTable,"outputFile",0,config.sOutputFile);
+    if(config.nNumRho<1||config.nNumT<1){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": \"numLogD\" and \"numLogT\" of table "<<n
+        <<" under \"interpolatedTables\" node must be at least 1\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+
+    //get whether to set nans, accepts the same values as eos_interp.py
+    std::string sSetNans;
+    config.bSetNans=false;
+    if(getXMLValueNoThrow(xTable,"setNans",0,sSetNans)){
+      for(unsigned int i=0;i<sSetNans.size();i++){
+        sSetNans[i]=tolower(sSetNans[i]);
+      }
+      config.bSetNans=(sSetNans=="true"||sSetNans=="1"||sSetNans=="t"||sSetNans=="y"
+        ||sSetNans=="yes");
+    }
+    vecTableConfigs.push_back(config);
+  }
+  if(vecTableConfigs.size()==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": no \"table\" nodes found under \"interpolatedTables\" node\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+}
+void setExeDir(){
+  char buff[1024];
+  ssize_t len = readlink("/proc/self/exe", buff, sizeof(buff)-1);
+  if (len != -1) {
+    buff[len] = '\0';
+    sExeDir=std::string(buff);
+
+    //find the first "/" from the end
+    unsigned pos=sExeDir.find_last_of("/");
+
+    //keep from the begging to the location of the last "/" to remove the name
+    //of the executable
+    sExeDir=sExeDir.substr(0,pos);
+
+    //check to see if the last directory is "bin" if so remove that also
+    //as installed versions put the exe's into the bin directory and sExeDir
+    //should point the top level directory.
+    pos=sExeDir.find_last_of("/");
+    std::string sBin=sExeDir.substr(pos+1,3);
+
+    //if installed remove bin directory
+    if(sBin.compare("bin")==0){
+      sExeDir=sExeDir.substr(0,pos);
+    }
+
+  } else {
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error determining executable path"<<std::endl;
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+}
+std::string sDataFilePath(std::string sFileName){
+
+  //if not absolute or relative assume it is in the SPHERLS data directory
+  if(sFileName.substr(0,1)!="/" && sFileName.substr(0,2)!="./"){
+    return sExeDir+"/data/"+sFileName;
+  }
+  return sFileName;
+}
+void parallelFor(int nNumIndices,void (*fBody)(void*,int),void *vData){
+  parallelLoop loop;
+  loop.fBody=fBody;
+  loop.vData=vData;
+  loop.nNumIndices=nNumIndices;
+  loop.nNext=0;
+  loop.bError=false;
+  int nThreads=std::min(int(nNumThreads),nNumIndices);
+  if(nThreads<=1){
+    for(int n=0;n<nNumIndices;n++){
+      fBody(vData,n);
+    }
+    return;
+  }
+  pthread_mutex_init(&loop.mutex,NULL);
+
+  //this thread also works on the loop, if a thread can't be created fewer are used
+  std::vector<pthread_t> vecThreads;
+  for(int t=1;t<nThreads;t++){
+    pthread_t threadTemp;
+    if(pthread_create(&threadTemp,NULL,parallelLoopWorker,(void*)(&loop))!=0){
+      break;
+    }
+    vecThreads.push_back(threadTemp);
+  }
+  parallelLoopWorker((void*)(&loop));
+  for(unsigned int t=0;t<vecThreads.size();t++){
+    pthread_join(vecThreads[t],NULL);
+  }
+  pthread_mutex_destroy(&loop.mutex);
+  if(loop.bError){
+    throw loop.eError;
+  }
+}
+void* parallelLoopWorker(void *vLoop){
+  parallelLoop *loop=(parallelLoop*)(vLoop);
+  while(true){
+
+    //get the next index
+    pthread_mutex_lock(&loop->mutex);
+    if(loop->nNext>=loop->nNumIndices||loop->bError){
+      pthread_mutex_unlock(&loop->mutex);
+      break;
+    }
+    int nIndex=loop->nNext;
+    loop->nNext++;
+    pthread_mutex_unlock(&loop->mutex);
+
+    try{
+      loop->fBody(loop->vData,nIndex);
+    }
+    catch(exception2 &eTemp){
+      pthread_mutex_lock(&loop->mutex);
+      if(!loop->bError){
+        loop->eError=eTemp;
+        loop->bError=true;
+      }
+      pthread_mutex_unlock(&loop->mutex);
+    }
+  }
+  return NULL;
+}
+double dReadDouble(std::string sValue,std::string sFileName){
+  char *cEnd;
+  double dValue=strtod(sValue.c_str(),&cEnd);
+  if(sValue.size()==0||*cEnd!='\0'){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expected a number in \""<<sFileName<<"\" got \""<<sValue<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  return dValue;
+}
+int nReadInt(std::string sValue,std::string sFileName){
+  char *cEnd;
+  long nValue=strtol(sValue.c_str(),&cEnd,10);
+  if(sValue.size()==0||*cEnd!='\0'){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expected an integer in \""<<sFileName<<"\" got \""<<sValue<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  return int(nValue);
+}
+std::vector<std::string> vecsSplitLine(std::string sLine){
+  std::vector<std::string> vecsParts;
+  std::stringstream ssLine(sLine);
+  std::string sPart;
+  while(ssLine>>sPart){
+    vecsParts.push_back(sPart);
+  }
+  return vecsParts;
+}
+bool bReadValues(std::string sLine,std::vector<double> &vecdValues){
+  vecdValues.clear();
+  const char *cPos=sLine.c_str();
+  while(true){
+    while(*cPos!='\0'&&isspace(*cPos)){
+      cPos++;
+    }
+    if(*cPos=='\0'){
+      break;
+    }
+
+    /*strtod stops at the "-" of a following negative number, so values run together are read
+    correctly*/
+    char *cEnd;
+    double dValue=strtod(cPos,&cEnd);
+    if(cEnd==cPos){
+      return false;
+    }
+    vecdValues.push_back(dValue);
+    cPos=cEnd;
+  }
+  return true;
+}
+double dGroundStateEnergy(double dX,double dZ){
+  double dXC=0.247137766;
+  double dXN=0.0620782;
+  double dXO=0.52837118;
+  double dXNe=0.1624188;
+  double dAMass[7]={0.00054858,20.179,15.9994,14.0067,12.011,4.0026,1.0079};
+  double dEIon[6]={-3394.873554,-1974.86545,-1433.92718,-993.326315,-76.1959403,-15.28698437};
+  double dFracZ=dZ/(dXC*dAMass[4]+dXN*dAMass[3]+dXO*dAMass[2]+dXNe*dAMass[1]);
+  double dXC2=dFracZ*dXC;
+  double dXN2=dFracZ*dXN;
+  double dXO2=dFracZ*dXO;
+  double dXNe2=dFracZ*dXNe;
+  double dXH=dX/dAMass[6];
+  double dXHe=(1.0-dX-dZ)/dAMass[5];
+  double dXTot=dXH+dXHe+dXC2+dXN2+dXO2+dXNe2;
+  double dFrac[6]={dXNe2/dXTot,dXO2/dXTot,dXN2/dXTot,dXC2/dXTot,dXHe/dXTot,dXH/dXTot};
+  double dEGround=0.0;
+  for(int i=0;i<6;i++){
+    dEGround+=dEIon[i]*dFrac[i];
+  }
+  return dEGround;
+}
+void readEOSFile(eosComposition &eosFile){
+
+  //open file
+  std::ifstream ifIn(eosFile.sFileName.c_str());
+  if(!ifIn.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error opening the file \""<<eosFile.sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  //get composition
+  std::string sLine;
+  std::getline(ifIn,sLine);
+  std::vector<std::string> vecsParts=vecsSplitLine(sLine);
+  if(vecsParts.size()<8){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expected the composition on the first line of \""<<eosFile.sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  eosFile.dX=dReadDouble(vecsParts[1],eosFile.sFileName);
+  eosFile.dZ=dReadDouble(vecsParts[3],eosFile.sFileName);
+  double dMassPerMole=dReadDouble(vecsParts[7],eosFile.sFileName);
+  double dEGround=dGroundStateEnergy(eosFile.dX,eosFile.dZ);
+
+  //skip 2 lines
+  std::getline(ifIn,sLine);
+  std::getline(ifIn,sLine);
+
+  //loop over densities, the temperatures of each start at the highest
+  std::vector<std::vector<double> > vecvecdLogT;
+  std::vector<std::vector<double> > vecvecdLogE;
+  std::vector<std::vector<double> > vecvecdLogP;
+  eosFile.vecdLogRho.clear();
+  while(true){
+    if(!std::getline(ifIn,sLine)){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": unexpected end of file in \""<<eosFile.sFileName<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    vecsParts=vecsSplitLine(sLine);
+    if(vecsParts.size()<2){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": expected the number of temperatures in \""<<eosFile.sFileName<<"\" got \""<<sLine
+        <<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+
+    //number of temperatures is zero at the end of the file
+    int nNumTemps=nReadInt(vecsParts[1],eosFile.sFileName);
+    if(nNumTemps==0){
+      break;
+    }
+    if(vecsParts.size()<6){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": expected the density in \""<<eosFile.sFileName<<"\" got \""<<sLine<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    double dDensity=dReadDouble(vecsParts[5],eosFile.sFileName);
+    eosFile.vecdLogRho.push_back(log10(dDensity));
+
+    //skip 2 lines
+    std::getline(ifIn,sLine);
+    std::getline(ifIn,sLine);
+
+    //read temperatures
+    std::vector<double> vecdLogTRow;
+    std::vector<double> vecdLogERow;
+    std::vector<double> vecdLogPRow;
+    for(int i=0;i<nNumTemps;i++){
+      std::getline(ifIn,sLine);
+      vecsParts=vecsSplitLine(sLine);
+      if(vecsParts.size()<5){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": expected a temperature line in \""<<eosFile.sFileName<<"\" got \""<<sLine<<"\"\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      double dT6=dReadDouble(vecsParts[0],eosFile.sFileName);
+      double dPressure=dReadDouble(vecsParts[3],eosFile.sFileName)*1.0e12;//MB to dynes/cm^2
+      double dEnergy=dReadDouble(vecsParts[4],eosFile.sFileName);
+      dEnergy=(dEnergy*dMassPerMole-dEGround)/(dMassPerMole)*1.0e12;//set e=0 at T=0
+      vecdLogTRow.push_back(log10(dT6*1.0e6));
+      vecdLogERow.push_back(log10(dEnergy));
+      vecdLogPRow.push_back(log10(dPressure));
+    }
+    vecvecdLogT.push_back(vecdLogTRow);
+    vecvecdLogE.push_back(vecdLogERow);
+    vecvecdLogP.push_back(vecdLogPRow);
+
+    //skip three lines before the next density
+    std::getline(ifIn,sLine);
+    std::getline(ifIn,sLine);
+    std::getline(ifIn,sLine);
+  }
+  ifIn.close();
+
+  /*densities with fewer temperatures are missing the lowest temperatures, the temperatures they do
+  have must be the same as those of the first density*/
+  int nNumRho=int(vecvecdLogT.size());
+  if(nNumRho<4||vecvecdLogT[0].size()<4){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": \""<<eosFile.sFileName<<"\" must have at least 4 densities and temperatures\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  int nNumT=int(vecvecdLogT[0].size());
+  for(int i=1;i<nNumRho;i++){
+    bool bSameT=(int(vecvecdLogT[i].size())<=nNumT);
+    for(unsigned int j=0;bSameT&&j<vecvecdLogT[i].size();j++){
+      bSameT=(vecvecdLogT[i][j]==vecvecdLogT[0][j]);
+    }
+    if(!bSameT){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": temperatures at density "<<i<<" of \""<<eosFile.sFileName
+        <<"\" are not a subset of those at the first density\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+  }
+
+  //store with temperatures increasing, missing points are nans
+  bool bFlip=(vecvecdLogT[0][0]>vecvecdLogT[0][1]);
+  eosFile.vecdLogT.resize(nNumT);
+  for(int j=0;j<nNumT;j++){
+    eosFile.vecdLogT[bFlip?nNumT-1-j:j]=vecvecdLogT[0][j];
+  }
+  eosFile.vecdLogE.assign(nNumRho*nNumT,std::numeric_limits<double>::quiet_NaN());
+  eosFile.vecdLogP.assign(nNumRho*nNumT,std::numeric_limits<double>::quiet_NaN());
+  for(int i=0;i<nNumRho;i++){
+    for(unsigned int j=0;j<vecvecdLogT[i].size();j++){
+      int nIndex=i*nNumT+(bFlip?nNumT-1-int(j):int(j));
+      eosFile.vecdLogE[nIndex]=vecvecdLogE[i][j];
+      eosFile.vecdLogP[nIndex]=vecvecdLogP[i][j];
+    }
+  }
+}
+void readEOSFileBody(void *vData,int nIndex){
+  readEOSFile((*(std::vector<eosComposition>*)(vData))[nIndex]);
+}
+void readEOSFiles(){
+
+  //read files
+  std::cout<<"loading "<<vecEOSCompositions.size()<<" equation of state files ...\n";
+  parallelFor(int(vecEOSCompositions.size()),readEOSFileBody,(void*)(&vecEOSCompositions));
+
+  //sort in X, then Z keeping the order in X
+  std::stable_sort(vecEOSCompositions.begin(),vecEOSCompositions.end()
+    ,(bool (*)(const eosComposition&,const eosComposition&))bEarlierInX);
+  std::stable_sort(vecEOSCompositions.begin(),vecEOSCompositions.end()
+    ,(bool (*)(const eosComposition&,const eosComposition&))bEarlierInZ);
+
+  //require a rectangular grid
+  vecdEOSX.clear();
+  vecdEOSZ.clear();
+  vecdEOSZ.push_back(vecEOSCompositions[0].dZ);
+  unsigned int nXIndex=0;
+  for(unsigned int n=0;n<vecEOSCompositions.size();n++){
+
+    //at next Z
+    if(vecEOSCompositions[n].dZ>vecdEOSZ.back()){
+      if(vecdEOSZ.size()>1&&nXIndex!=vecdEOSX.size()){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": expected "<<vecdEOSX.size()<<" equation of state files at Z="<<vecdEOSZ.back()
+          <<" for a rectangular grid, got "<<nXIndex<<"\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      vecdEOSZ.push_back(vecEOSCompositions[n].dZ);
+      nXIndex=0;
+    }
+
+    //X's at the first Z set the X's expected at the other Z's
+    if(vecdEOSZ.size()==1){
+      vecdEOSX.push_back(vecEOSCompositions[n].dX);
+    }
+    else{
+      if(nXIndex>=vecdEOSX.size()||vecEOSCompositions[n].dX!=vecdEOSX[nXIndex]){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": current equation of state file \""<<vecEOSCompositions[n].sFileName
+          <<"\" has X of "<<vecEOSCompositions[n].dX<<" which doesn't fit in a rectangular grid\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      nXIndex++;
+    }
+  }
+  if(vecdEOSZ.size()>1&&nXIndex!=vecdEOSX.size()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expected "<<vecdEOSX.size()<<" equation of state files at Z="<<vecdEOSZ.back()
+      <<" for a rectangular grid, got "<<nXIndex<<"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+}
+bool bGetComposition(const std::vector<std::string> &vecsParts,double &dX,double &dZ){
+  int nIndexX=-1;
+  int nIndexZ=-1;
+  for(unsigned int i=0;i<vecsParts.size();i++){
+    if(vecsParts[i][0]=='X'){
+      nIndexX=int(i);
+    }
+    if(vecsParts[i][0]=='Z'){
+      nIndexZ=int(i);
+    }
+  }
+  if(nIndexX==-1||nIndexZ==-1){
+    return false;
+  }
+
+  //handle both X=0.0 and X= 0.0
+  std::string sX;
+  std::string sZ;
+  if(vecsParts[nIndexX].size()>2){
+    sX=vecsParts[nIndexX].substr(2);
+  }
+  else if(nIndexX+1<int(vecsParts.size())){
+    sX=vecsParts[nIndexX+1];
+  }
+  if(vecsParts[nIndexZ].size()>2){
+    sZ=vecsParts[nIndexZ].substr(2);
+  }
+  else if(nIndexZ+1<int(vecsParts.size())){
+    sZ=vecsParts[nIndexZ+1];
+  }
+  dX=dReadDouble(sX,"opacity file composition");
+  dZ=dReadDouble(sZ,"opacity file composition");
+  return true;
+}
+std::vector<std::pair<double,double> > vecGetOpacityCompositions(std::string sFileName){
+  std::ifstream ifIn(sFileName.c_str());
+  if(!ifIn.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error opening the file \""<<sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  std::vector<std::pair<double,double> > vecCompositions;
+  int nCurrentTable=0;
+  std::string sLine;
+  while(std::getline(ifIn,sLine)){
+    std::vector<std::string> vecsParts=vecsSplitLine(sLine);
+    double dX;
+    double dZ;
+    if(!bGetComposition(vecsParts,dX,dZ)){
+      continue;
+    }
+
+    //a table number smaller than the last one starts the actual tables, after the summary
+    if(vecsParts[0].substr(0,5)=="TABLE"&&vecsParts.size()>2){
+      int nTable;
+      if(vecsParts[1]=="#"){
+        nTable=nReadInt(vecsParts[2],sFileName);
+      }
+      else{
+        nTable=nReadInt(vecsParts[1].substr(1),sFileName);
+      }
+      if(nTable<nCurrentTable){
+        break;
+      }
+      nCurrentTable=nTable;
+    }
+    vecCompositions.push_back(std::pair<double,double>(dX,dZ));
+  }
+  ifIn.close();
+  return vecCompositions;
+}
+void getOpacityCompositionsBody(void *vData,int nIndex){
+  std::pair<std::vector<std::string>*,std::vector<std::vector<std::pair<double,double> > >*>
+    *pairFiles=(std::pair<std::vector<std::string>*
+    ,std::vector<std::vector<std::pair<double,double> > >*>*)(vData);
+  (*pairFiles->second)[nIndex]=vecGetOpacityCompositions((*pairFiles->first)[nIndex]);
+}
+void readOpacityFile(opacityComposition &opacityTable){
+  std::ifstream ifIn(opacityTable.sFileName.c_str());
+  if(!ifIn.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": error opening the file \""<<opacityTable.sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  /*find the composition, files with more than one table list the compositions at the top, the
+  table is at the second match*/
+  std::string sLine;
+  int nCount=1;
+  bool bFound=false;
+  while(!bFound&&std::getline(ifIn,sLine)){
+    double dX;
+    double dZ;
+    if(bGetComposition(vecsSplitLine(sLine),dX,dZ)&&dX==opacityTable.dX&&dZ==opacityTable.dZ){
+      if(nCount==2||!opacityTable.bMultiTable){
+        bFound=true;
+      }
+      else{
+        nCount=2;
+      }
+    }
+  }
+
+  //skip to the log R values, on the line starting with logT
+  while(bFound&&sLine.substr(0,5)!="log T"&&sLine.substr(0,4)!="logT"){
+    if(!std::getline(ifIn,sLine)){
+      bFound=false;
+    }
+  }
+  if(!bFound){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": unable to find the table with X="<<opacityTable.dX<<" Z="<<opacityTable.dZ<<" in \""
+      <<opacityTable.sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  if(!bReadValues(sLine.substr(sLine.substr(0,5)=="log T"?5:4),opacityTable.vecdLogR)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expected log R values in \""<<opacityTable.sFileName<<"\" got \""<<sLine<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //skip empty lines
+  sLine="";
+  while(sLine.size()<=1){
+    if(!std::getline(ifIn,sLine)){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": unexpected end of file in \""<<opacityTable.sFileName<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+  }
+
+  //read rows until an empty line, values of 9.999 are missing, as are values past the row's end
+  int nNumR=int(opacityTable.vecdLogR.size());
+  std::vector<double> vecdValues;
+  opacityTable.vecdLogT.clear();
+  opacityTable.vecdLogKappa.clear();
+  while(true){
+    if(!bReadValues(sLine,vecdValues)){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": expected a row of opacities in \""<<opacityTable.sFileName<<"\" got \""<<sLine
+        <<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    if(vecdValues.size()==0){
+      break;
+    }
+    opacityTable.vecdLogT.push_back(vecdValues[0]);
+    for(int j=0;j<nNumR;j++){
+      if(j+1<int(vecdValues.size())&&vecdValues[j+1]!=9.999){
+        opacityTable.vecdLogKappa.push_back(vecdValues[j+1]);
+      }
+      else{
+        opacityTable.vecdLogKappa.push_back(std::numeric_limits<double>::quiet_NaN());
+      }
+    }
+    if(!std::getline(ifIn,sLine)){
+      break;
+    }
+  }
+  ifIn.close();
+  int nNumT=int(opacityTable.vecdLogT.size());
+  if(nNumT<4||nNumR<4){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": table with X="<<opacityTable.dX<<" Z="<<opacityTable.dZ<<" in \""
+      <<opacityTable.sFileName<<"\" must have at least 4 temperatures and log R values\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //Alexander & Ferguson tables have temperatures decreasing
+  if(opacityTable.vecdLogT[0]>opacityTable.vecdLogT[1]){
+    std::reverse(opacityTable.vecdLogT.begin(),opacityTable.vecdLogT.end());
+    for(int i=0;i<nNumT/2;i++){
+      std::swap_ranges(opacityTable.vecdLogKappa.begin()+i*nNumR
+        ,opacityTable.vecdLogKappa.begin()+(i+1)*nNumR
+        ,opacityTable.vecdLogKappa.begin()+(nNumT-1-i)*nNumR);
+    }
+  }
+}
+void readOpacityFileBody(void *vData,int nIndex){
+  readOpacityFile((*(std::vector<opacityComposition>*)(vData))[nIndex]);
+}
+opacityComposition mergeOpacityTables(const opacityComposition &opacityTable1
+  ,const opacityComposition &opacityTable2){
+
+  const std::vector<double> &vecdLogR1=opacityTable1.vecdLogR;
+  const std::vector<double> &vecdLogR2=opacityTable2.vecdLogR;
+  const std::vector<double> &vecdLogT1=opacityTable1.vecdLogT;
+  const std::vector<double> &vecdLogT2=opacityTable2.vecdLogT;
+  int nNumR1=int(vecdLogR1.size());
+  int nNumR2=int(vecdLogR2.size());
+  int nNumT1=int(vecdLogT1.size());
+  int nNumT2=int(vecdLogT2.size());
+
+  /*find where each table starts in the merged table, the table starting later must start at a
+  point of the other*/
+  int nNumR=0;
+  int nStartR1=0;
+  int nStartR2=0;
+  if(vecdLogR1[0]<vecdLogR2[0]){
+    for(int i=0;i<nNumR1;i++){
+      if(vecdLogR1[i]==vecdLogR2[0]){
+        nNumR=i+nNumR2;
+        nStartR2=i;
+        break;
+      }
+    }
+  }
+  else{
+    for(int i=0;i<nNumR2;i++){
+      if(vecdLogR2[i]==vecdLogR1[0]){
+        nNumR=i+nNumR1;
+        nStartR1=i;
+        break;
+      }
+    }
+  }
+  int nNumT=0;
+  int nStartT1=0;
+  int nStartT2=0;
+  if(vecdLogT1[0]<vecdLogT2[0]){
+    for(int i=0;i<nNumT1;i++){
+      if(vecdLogT1[i]==vecdLogT2[0]){
+        nNumT=i+nNumT2;
+        nStartT2=i;
+        break;
+      }
+    }
+  }
+  else{
+    for(int i=0;i<nNumT2;i++){
+      if(vecdLogT2[i]==vecdLogT1[0]){
+        nNumT=i+nNumT1;
+        nStartT1=i;
+        break;
+      }
+    }
+  }
+  if(nNumR==0||nNumT==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": opacity tables with X="<<opacityTable1.dX<<" Z="<<opacityTable1.dZ<<" in \""
+      <<opacityTable1.sFileName<<"\" and \""<<opacityTable2.sFileName
+      <<"\" don't have overlapping grids\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  opacityComposition mergedTable;
+  mergedTable.sFileName=opacityTable1.sFileName;
+  mergedTable.bMultiTable=opacityTable1.bMultiTable;
+  mergedTable.dX=opacityTable1.dX;
+  mergedTable.dZ=opacityTable1.dZ;
+  mergedTable.vecdLogKappa.assign(nNumT*nNumR,std::numeric_limits<double>::quiet_NaN());
+  std::vector<int> vecnColumnCount(nNumR,0);
+  std::vector<int> vecnRowCount(nNumT,0);
+  for(int j=0;j<nNumR;j++){
+    for(int i=0;i<nNumT;i++){
+      bool bInTable1=(i>=nStartT1&&i<nNumT1+nStartT1&&j>=nStartR1&&j<nNumR1+nStartR1);
+      bool bInTable2=(i>=nStartT2&&i<nNumT2+nStartT2&&j>=nStartR2&&j<nNumR2+nStartR2);
+      if(bInTable1||bInTable2){
+        vecnColumnCount[j]++;
+        vecnRowCount[i]++;
+      }
+      if(bInTable1&&bInTable2){
+
+        /*find the range in temperature of the values of each table at this R, the overlap goes
+        from the bottom of one table to the top of the other*/
+        int nCol1=j-nStartR1;
+        int nCol2=j-nStartR2;
+        int nBottom1=0;
+        while(nBottom1<nNumT1&&std::isnan(opacityTable1.vecdLogKappa[nBottom1*nNumR1+nCol1])){
+          nBottom1++;
+        }
+        int nTop1=nNumT1-1;
+        while(nTop1>=0&&std::isnan(opacityTable1.vecdLogKappa[nTop1*nNumR1+nCol1])){
+          nTop1--;
+        }
+        int nBottom2=0;
+        while(nBottom2<nNumT2&&std::isnan(opacityTable2.vecdLogKappa[nBottom2*nNumR2+nCol2])){
+          nBottom2++;
+        }
+        int nTop2=nNumT2-1;
+        while(nTop2>=0&&std::isnan(opacityTable2.vecdLogKappa[nTop2*nNumR2+nCol2])){
+          nTop2--;
+        }
+        if(nTop1<0||nTop2<0){
+          std::stringstream ssTemp;
+          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+            <<": opacity tables with X="<<opacityTable1.dX<<" Z="<<opacityTable1.dZ
+            <<" have no values at a log R where they overlap\n";
+          throw exception2(ssTemp.str(),INPUT);
+        }
+        double dLogT10=vecdLogT1[nBottom1];
+        double dLogT11=vecdLogT1[nTop1];
+        double dLogT20=vecdLogT2[nBottom2];
+        double dLogT21=vecdLogT2[nTop2];
+        double dLogT0;
+        double dLogT1;
+        bool bLowerEdgeTable1=false;
+        if((dLogT10-dLogT11)<(dLogT20-dLogT21)){
+          dLogT0=dLogT10;
+          dLogT1=dLogT21;
+        }
+        else{
+          dLogT0=dLogT20;
+          dLogT1=dLogT11;
+          bLowerEdgeTable1=true;
+        }
+
+        //weight each table by the square of the distance from the other table's edge
+        double dLogT=vecdLogT2[i-nStartT2];
+        double dW1=(dLogT0-dLogT);
+        dW1=dW1*dW1;
+        double dW2=(dLogT1-dLogT);
+        dW2=dW2*dW2;
+        if(bLowerEdgeTable1){
+          std::swap(dW1,dW2);
+        }
+
+        //if one is a nan use the other
+        double dLogK1=opacityTable1.vecdLogKappa[(i-nStartT1)*nNumR1+nCol1];
+        double dLogK2=opacityTable2.vecdLogKappa[(i-nStartT2)*nNumR2+nCol2];
+        if(!(std::isnan(dLogK1)&&std::isnan(dLogK2))){
+          if(std::isnan(dLogK1)){
+            dLogK1=0.0;
+            dW1=0.0;
+          }
+          if(std::isnan(dLogK2)){
+            dLogK2=0.0;
+            dW2=0.0;
+          }
+        }
+        mergedTable.vecdLogKappa[i*nNumR+j]=(dW1*dLogK1+dW2*dLogK2)/(dW1+dW2);
+      }
+      else if(bInTable1){
+        mergedTable.vecdLogKappa[i*nNumR+j]=
+          opacityTable1.vecdLogKappa[(i-nStartT1)*nNumR1+j-nStartR1];
+      }
+      else if(bInTable2){
+        mergedTable.vecdLogKappa[i*nNumR+j]=
+          opacityTable2.vecdLogKappa[(i-nStartT2)*nNumR2+j-nStartR2];
+      }
+    }
+  }
+
+  /*temperatures are taken from the longest column and log R's from the longest row, where tables
+  overlap table 2 is used*/
+  int nLongestColumn=int(std::max_element(vecnColumnCount.begin(),vecnColumnCount.end())
+    -vecnColumnCount.begin());
+  int nLongestRow=int(std::max_element(vecnRowCount.begin(),vecnRowCount.end())
+    -vecnRowCount.begin());
+  bool bComplete=true;
+  mergedTable.vecdLogT.resize(nNumT);
+  for(int i=0;i<nNumT;i++){
+    int j=nLongestColumn;
+    if(i>=nStartT2&&i<nNumT2+nStartT2&&j>=nStartR2&&j<nNumR2+nStartR2){
+      mergedTable.vecdLogT[i]=vecdLogT2[i-nStartT2];
+    }
+    else if(i>=nStartT1&&i<nNumT1+nStartT1&&j>=nStartR1&&j<nNumR1+nStartR1){
+      mergedTable.vecdLogT[i]=vecdLogT1[i-nStartT1];
+    }
+    else{
+      bComplete=false;
+    }
+  }
+  mergedTable.vecdLogR.resize(nNumR);
+  for(int j=0;j<nNumR;j++){
+    int i=nLongestRow;
+    if(i>=nStartT2&&i<nNumT2+nStartT2&&j>=nStartR2&&j<nNumR2+nStartR2){
+      mergedTable.vecdLogR[j]=vecdLogR2[j-nStartR2];
+    }
+    else if(i>=nStartT1&&i<nNumT1+nStartT1&&j>=nStartR1&&j<nNumR1+nStartR1){
+      mergedTable.vecdLogR[j]=vecdLogR1[j-nStartR1];
+    }
+    else{
+      bComplete=false;
+    }
+  }
+  if(!bComplete){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": merging opacity tables with X="<<opacityTable1.dX<<" Z="<<opacityTable1.dZ
+      <<" doesn't give a rectangular grid\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  return mergedTable;
+}
+void readOpacityFiles(){
+
+  //read files
+  std::cout<<"loading "<<vecOpacityCompositions.size()<<" opacity tables ...\n";
+  parallelFor(int(vecOpacityCompositions.size()),readOpacityFileBody
+    ,(void*)(&vecOpacityCompositions));
+
+  //sort in X, then Z keeping the order in X
+  std::stable_sort(vecOpacityCompositions.begin(),vecOpacityCompositions.end()
+    ,(bool (*)(const opacityComposition&,const opacityComposition&))bEarlierInX);
+  std::stable_sort(vecOpacityCompositions.begin(),vecOpacityCompositions.end()
+    ,(bool (*)(const opacityComposition&,const opacityComposition&))bEarlierInZ);
+
+  //merge tables of the same composition, the first one listed is table 1
+  for(unsigned int n=0;n<vecOpacityCompositions.size();n++){
+    for(unsigned int m=n+1;m<vecOpacityCompositions.size();m++){
+      if(vecOpacityCompositions[m].dX==vecOpacityCompositions[n].dX
+        &&vecOpacityCompositions[m].dZ==vecOpacityCompositions[n].dZ){
+        vecOpacityCompositions[n]=mergeOpacityTables(vecOpacityCompositions[n]
+          ,vecOpacityCompositions[m]);
+        vecOpacityCompositions.erase(vecOpacityCompositions.begin()+m);
+        break;
+      }
+    }
+  }
+
+  //require a rectangular grid
+  vecdOpacityX.clear();
+  vecdOpacityZ.clear();
+  vecdOpacityZ.push_back(vecOpacityCompositions[0].dZ);
+  unsigned int nXIndex=0;
+  for(unsigned int n=0;n<vecOpacityCompositions.size();n++){
+
+    //at next Z
+    if(vecOpacityCompositions[n].dZ>vecdOpacityZ.back()){
+      if(vecdOpacityZ.size()>1&&nXIndex!=vecdOpacityX.size()){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": expected "<<vecdOpacityX.size()<<" opacity tables at Z="<<vecdOpacityZ.back()
+          <<" for a rectangular grid, got "<<nXIndex<<"\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      vecdOpacityZ.push_back(vecOpacityCompositions[n].dZ);
+      nXIndex=0;
+    }
+
+    //X's at the first Z set the X's expected at the other Z's
+    if(vecdOpacityZ.size()==1){
+      vecdOpacityX.push_back(vecOpacityCompositions[n].dX);
+    }
+    else{
+      if(nXIndex>=vecdOpacityX.size()||vecOpacityCompositions[n].dX!=vecdOpacityX[nXIndex]){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": current opacity table \""<<vecOpacityCompositions[n].sFileName<<"\" has X of "
+          <<vecOpacityCompositions[n].dX<<" which doesn't fit in a rectangular grid\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      nXIndex++;
+    }
+  }
+  if(vecdOpacityZ.size()>1&&nXIndex!=vecdOpacityX.size()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expected "<<vecdOpacityX.size()<<" opacity tables at Z="<<vecdOpacityZ.back()
+      <<" for a rectangular grid, got "<<nXIndex<<"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+}
+bool bEarlierInX(const eosComposition &eos1,const eosComposition &eos2){
+  return eos1.dX<eos2.dX;
+}
+bool bEarlierInZ(const eosComposition &eos1,const eosComposition &eos2){
+  return eos1.dZ<eos2.dZ;
+}
+bool bEarlierInX(const opacityComposition &opacity1,const opacityComposition &opacity2){
+  return opacity1.dX<opacity2.dX;
+}
+bool bEarlierInZ(const opacityComposition &opacity1,const opacityComposition &opacity2){
+  return opacity1.dZ<opacity2.dZ;
+}
+void getSplineSecondDerivs(const std::vector<double> &vecdX,const double *dY,int nStride
+  ,double *dSecondDeriv){
+  int nNum=int(vecdX.size());
+  if(nNum<4){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": a cubic spline needs at least 4 points, got "<<nNum<<"\n";
+    throw exception2(ssTemp.str(),CALCULATION);
+  }
+  std::vector<double> vecdH(nNum-1);
+  for(int i=0;i<nNum-1;i++){
+    vecdH[i]=vecdX[i+1]-vecdX[i];
+  }
+
+  //equations for the interior second derivatives
+  std::vector<double> vecdLower(nNum);
+  std::vector<double> vecdDiag(nNum);
+  std::vector<double> vecdUpper(nNum);
+  std::vector<double> vecdRHS(nNum);
+  for(int i=1;i<nNum-1;i++){
+    vecdLower[i]=vecdH[i-1];
+    vecdDiag[i]=2.0*(vecdH[i-1]+vecdH[i]);
+    vecdUpper[i]=vecdH[i];
+    vecdRHS[i]=6.0*((dY[(i+1)*nStride]-dY[i*nStride])/vecdH[i]
+      -(dY[i*nStride]-dY[(i-1)*nStride])/vecdH[i-1]);
+  }
+
+  /*not-a-knot, the third derivative is continuous at the second and second last points, which
+  gives the end second derivatives in terms of the interior ones*/
+  double dRatio0=vecdH[0]/vecdH[1];
+  double dRatioN=vecdH[nNum-2]/vecdH[nNum-3];
+  vecdDiag[1]+=vecdH[0]*(1.0+dRatio0);
+  vecdUpper[1]-=vecdH[0]*dRatio0;
+  vecdDiag[nNum-2]+=vecdH[nNum-2]*(1.0+dRatioN);
+  vecdLower[nNum-2]-=vecdH[nNum-2]*dRatioN;
+
+  //solve the tridiagonal system
+  for(int i=2;i<nNum-1;i++){
+    double dFactor=vecdLower[i]/vecdDiag[i-1];
+    vecdDiag[i]-=dFactor*vecdUpper[i-1];
+    vecdRHS[i]-=dFactor*vecdRHS[i-1];
+  }
+  dSecondDeriv[nNum-2]=vecdRHS[nNum-2]/vecdDiag[nNum-2];
+  for(int i=nNum-3;i>=1;i--){
+    dSecondDeriv[i]=(vecdRHS[i]-vecdUpper[i]*dSecondDeriv[i+1])/vecdDiag[i];
+  }
+  dSecondDeriv[0]=dSecondDeriv[1]*(1.0+dRatio0)-dSecondDeriv[2]*dRatio0;
+  dSecondDeriv[nNum-1]=dSecondDeriv[nNum-2]*(1.0+dRatioN)-dSecondDeriv[nNum-3]*dRatioN;
+}
+double dSplineValue(const std::vector<double> &vecdX,const double *dY,int nStride
+  ,const double *dSecondDeriv,double dXValue){
+
+  //find interval, the end intervals are used outside the points
+  int nNum=int(vecdX.size());
+  int k;
+  if(dXValue<=vecdX[0]){
+    k=0;
+  }
+  else if(dXValue>=vecdX[nNum-1]){
+    k=nNum-2;
+  }
+  else{
+    k=int(std::upper_bound(vecdX.begin(),vecdX.end(),dXValue)-vecdX.begin())-1;
+  }
+  double dH=vecdX[k+1]-vecdX[k];
+  double dA=vecdX[k+1]-dXValue;
+  double dB=dXValue-vecdX[k];
+  return (dSecondDeriv[k]*dA*dA*dA+dSecondDeriv[k+1]*dB*dB*dB)/(6.0*dH)
+    +(dY[k*nStride]/dH-dSecondDeriv[k]*dH/6.0)*dA
+    +(dY[(k+1)*nStride]/dH-dSecondDeriv[k+1]*dH/6.0)*dB;
+}
+std::vector<double> vecdSplineWeights(const std::vector<double> &vecdX,double dXValue){
+
+  //the spline is linear in the values, so the weights are the splines of unit vectors
+  int nNum=int(vecdX.size());
+  std::vector<double> vecdWeights(nNum);
+  std::vector<double> vecdUnit(nNum,0.0);
+  std::vector<double> vecdSecondDeriv(nNum);
+  for(int m=0;m<nNum;m++){
+    vecdUnit[m]=1.0;
+    getSplineSecondDerivs(vecdX,&vecdUnit[0],1,&vecdSecondDeriv[0]);
+    vecdWeights[m]=dSplineValue(vecdX,&vecdUnit[0],1,&vecdSecondDeriv[0],dXValue);
+    vecdUnit[m]=0.0;
+  }
+  return vecdWeights;
+}
+double dQuadratic(double dX,double dX1,double dX2,double dX3,double dY1,double dY2,double dY3){
+  double dX1Sq=dX1*dX1;
+  double dX2Sq=dX2*dX2;
+  double dX3Sq=dX3*dX3;
+  double dX1Sqmx2Sq=(dX1Sq-dX2Sq);
+  double dA=((dY1-dY2)*(dX2-dX3)-(dY2-dY3)*(dX1-dX2))
+    /(dX1Sqmx2Sq*(dX2-dX3)-(dX2Sq-dX3Sq)*(dX1-dX2));
+  double dB=(dY1-dY2-dA*dX1Sqmx2Sq)/(dX1-dX2);
+  double dC=dY1-dA*dX1Sq-dB*dX1;
+  return dA*dX*dX+dB*dX+dC;
+}
+eosComposition interpEOSComposition(double dX,double dZ){
+  std::cout<<"  interpolating eos in composition to (X,Z)=("<<dX<<","<<dZ<<") ...\n";
+  int nNumX=int(vecdEOSX.size());
+  if(vecdEOSZ.size()!=3){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": interpolation between more than or less than 3 different Z values is not supported, got "
+      <<vecdEOSZ.size()<<"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  if(nNumX<4){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": interpolation in X needs at least 4 different X values, got "<<nNumX<<"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //all tables must be on the same grid
+  const eosComposition &eosFirst=vecEOSCompositions[0];
+  for(unsigned int n=1;n<vecEOSCompositions.size();n++){
+    if(vecEOSCompositions[n].vecdLogRho!=eosFirst.vecdLogRho
+      ||vecEOSCompositions[n].vecdLogT!=eosFirst.vecdLogT){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": \""<<vecEOSCompositions[n].sFileName<<"\" has different density or temperature points"
+        <<" than \""<<eosFirst.sFileName<<"\"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+  }
+
+  /*quadratic in Z at each X, then a cubic spline in X. A nan in any of the tables gives a nan, as
+  it would throughout the spline*/
+  std::vector<double> vecdWeightsX=vecdSplineWeights(vecdEOSX,dX);
+  eosComposition eosInterp;
+  eosInterp.sFileName=eosFirst.sFileName;
+  eosInterp.dX=dX;
+  eosInterp.dZ=dZ;
+  eosInterp.vecdLogRho=eosFirst.vecdLogRho;
+  eosInterp.vecdLogT=eosFirst.vecdLogT;
+  int nNumPoints=int(eosFirst.vecdLogE.size());
+  eosInterp.vecdLogE.resize(nNumPoints);
+  eosInterp.vecdLogP.resize(nNumPoints);
+  for(int p=0;p<nNumPoints;p++){
+    double dSumE=0.0;
+    double dSumP=0.0;
+    for(int i=0;i<nNumX;i++){
+      const eosComposition &eos1=vecEOSCompositions[i];
+      const eosComposition &eos2=vecEOSCompositions[i+nNumX];
+      const eosComposition &eos3=vecEOSCompositions[i+2*nNumX];
+      double dLogE=dQuadratic(dZ,eos1.dZ,eos2.dZ,eos3.dZ,eos1.vecdLogE[p],eos2.vecdLogE[p]
+        ,eos3.vecdLogE[p]);
+      double dLogP=dQuadratic(dZ,eos1.dZ,eos2.dZ,eos3.dZ,eos1.vecdLogP[p],eos2.vecdLogP[p]
+        ,eos3.vecdLogP[p]);
+      dSumE+=vecdWeightsX[i]*dLogE;
+      dSumP+=vecdWeightsX[i]*dLogP;
+    }
+    eosInterp.vecdLogE[p]=dSumE;
+    eosInterp.vecdLogP[p]=dSumP;
+  }
+  return eosInterp;
+}
+opacityComposition interpOpacityComposition(double dX,double dZ){
+  std::cout<<"  interpolating opacity in composition to (X,Z)=("<<dX<<","<<dZ<<") ...\n";
+  int nNumX=int(vecdOpacityX.size());
+  int nNumZ=int(vecdOpacityZ.size());
+  if(nNumX<4||nNumZ<4){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": interpolating opacities with fewer than 4 X or Z values is not supported, got "<<nNumX
+      <<" X and "<<nNumZ<<" Z values\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //all tables must be on the same grid
+  const opacityComposition &opacityFirst=vecOpacityCompositions[0];
+  for(unsigned int n=1;n<vecOpacityCompositions.size();n++){
+    if(vecOpacityCompositions[n].vecdLogT!=opacityFirst.vecdLogT
+      ||vecOpacityCompositions[n].vecdLogR!=opacityFirst.vecdLogR){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": opacity table with X="<<vecOpacityCompositions[n].dX<<" Z="
+        <<vecOpacityCompositions[n].dZ<<" has different temperature or log R points than the one"
+        <<" with X="<<opacityFirst.dX<<" Z="<<opacityFirst.dZ<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+  }
+
+  /*bicubic spline in Z and X, kept within the range of the tables. A nan in any of the tables
+  gives a nan*/
+  std::vector<double> vecdWeightsX=vecdSplineWeights(vecdOpacityX
+    ,std::max(vecdOpacityX.front(),std::min(vecdOpacityX.back(),dX)));
+  std::vector<double> vecdWeightsZ=vecdSplineWeights(vecdOpacityZ
+    ,std::max(vecdOpacityZ.front(),std::min(vecdOpacityZ.back(),dZ)));
+  opacityComposition opacityInterp;
+  opacityInterp.sFileName=opacityFirst.sFileName;
+  opacityInterp.bMultiTable=false;
+  opacityInterp.dX=dX;
+  opacityInterp.dZ=dZ;
+  opacityInterp.vecdLogT=opacityFirst.vecdLogT;
+  opacityInterp.vecdLogR=opacityFirst.vecdLogR;
+  int nNumPoints=int(opacityFirst.vecdLogKappa.size());
+  opacityInterp.vecdLogKappa.resize(nNumPoints);
+  for(int p=0;p<nNumPoints;p++){
+    double dSum=0.0;
+    for(int l=0;l<nNumZ;l++){
+      double dSumX=0.0;
+      for(int m=0;m<nNumX;m++){
+        dSumX+=vecdWeightsX[m]*vecOpacityCompositions[l*nNumX+m].vecdLogKappa[p];
+      }
+      dSum+=vecdWeightsZ[l]*dSumX;
+    }
+    opacityInterp.vecdLogKappa[p]=dSum;
+  }
+  return opacityInterp;
+}
+void fillNansBody(void *vData,int nIndex){
+  fillNansLoop *loop=(fillNansLoop*)(vData);
+  const std::vector<double> &vecdRowAxis=*loop->vecdRowAxis;
+  const std::vector<double> &vecdColAxis=*loop->vecdColAxis;
+  int nNumCols=int(vecdColAxis.size());
+  int nNumTables=int(loop->vecvecdValues.size());
+  std::vector<double> vecdSums(nNumTables);
+  for(int k=0;k<nNumCols;k++){
+    int nPoint=nIndex*nNumCols+k;
+    if(!std::isnan((*loop->vecdMask)[nPoint])){
+      continue;
+    }
+
+    //weighted by the inverse of the distance to the 16th power
+    std::fill(vecdSums.begin(),vecdSums.end(),0.0);
+    double dSumWeights=0.0;
+    for(unsigned int n=0;n<loop->vecnBoundary.size();n++){
+      int nBoundary=loop->vecnBoundary[n];
+      double dDistanceRow=(vecdRowAxis[nIndex]-vecdRowAxis[nBoundary/nNumCols])*loop->dRowScale;
+      double dDistanceCol=(vecdColAxis[k]-vecdColAxis[nBoundary%nNumCols])*loop->dColScale;
+      double dDistance=dDistanceRow*dDistanceRow+dDistanceCol*dDistanceCol;
+      dDistance=dDistance*dDistance;
+      dDistance=dDistance*dDistance;
+      dDistance=dDistance*dDistance;
+      double dWeight=1.0/dDistance;
+      for(int v=0;v<nNumTables;v++){
+        vecdSums[v]+=dWeight*(*loop->vecvecdOriginal[v])[nBoundary];
+      }
+      dSumWeights+=dWeight;
+    }
+    for(int v=0;v<nNumTables;v++){
+      (*loop->vecvecdValues[v])[nPoint]=vecdSums[v]/dSumWeights;
+    }
+  }
+}
+void fillNans(const std::vector<double> &vecdRowAxis,const std::vector<double> &vecdColAxis
+  ,double dRowScale,double dColScale,const std::vector<double> &vecdMask
+  ,std::vector<const std::vector<double>*> vecvecdOriginal
+  ,std::vector<std::vector<double>*> vecvecdValues){
+
+  fillNansLoop loop;
+  loop.vecdRowAxis=&vecdRowAxis;
+  loop.vecdColAxis=&vecdColAxis;
+  loop.dRowScale=dRowScale;
+  loop.dColScale=dColScale;
+  loop.vecdMask=&vecdMask;
+  loop.vecvecdOriginal=vecvecdOriginal;
+  loop.vecvecdValues=vecvecdValues;
+  for(unsigned int v=0;v<vecvecdValues.size();v++){
+    *vecvecdValues[v]=*vecvecdOriginal[v];
+  }
+
+  //find points with a nan next to them
+  int nNumRows=int(vecdRowAxis.size());
+  int nNumCols=int(vecdColAxis.size());
+  for(int j=0;j<nNumRows;j++){
+    for(int k=0;k<nNumCols;k++){
+      if(std::isnan(vecdMask[j*nNumCols+k])){
+        continue;
+      }
+      if((j>0&&std::isnan(vecdMask[(j-1)*nNumCols+k]))
+        ||(j<nNumRows-1&&std::isnan(vecdMask[(j+1)*nNumCols+k]))
+        ||(k>0&&std::isnan(vecdMask[j*nNumCols+k-1]))
+        ||(k<nNumCols-1&&std::isnan(vecdMask[j*nNumCols+k+1]))){
+        loop.vecnBoundary.push_back(j*nNumCols+k);
+      }
+    }
+  }
+  parallelFor(nNumRows,fillNansBody,(void*)(&loop));
+}
+void evaluateSurfaceBody(void *vData,int nIndex){
+  surfaceLoop *loop=(surfaceLoop*)(vData);
+  const std::vector<double> &vecdA=*loop->vecdA;
+  const std::vector<double> &vecdB=*loop->vecdB;
+  int nNumA=int(vecdA.size());
+  int nNumB=int(vecdB.size());
+  int nNumBNew=int(loop->vecdBNew->size());
+
+  //values of the table along the first index at this column of the new grid
+  double dB=std::max(vecdB.front(),std::min(vecdB.back(),(*loop->vecdBNew)[nIndex]));
+  std::vector<double> vecdColumn(nNumA);
+  for(int i=0;i<nNumA;i++){
+    vecdColumn[i]=dSplineValue(vecdB,&(*loop->vecdValues)[i*nNumB],1
+      ,&loop->vecdSecondDerivB[i*nNumB],dB);
+  }
+  std::vector<double> vecdSecondDerivA(nNumA);
+  getSplineSecondDerivs(vecdA,&vecdColumn[0],1,&vecdSecondDerivA[0]);
+  for(int i=0;i<loop->nNumANew;i++){
+    int nPoint=i*nNumBNew+nIndex;
+    double dA=std::max(vecdA.front(),std::min(vecdA.back(),(*loop->vecdANew)[nPoint]));
+    (*loop->vecdResult)[nPoint]=dSplineValue(vecdA,&vecdColumn[0],1,&vecdSecondDerivA[0],dA);
+  }
+}
+void evaluateSurface(const std::vector<double> &vecdA,const std::vector<double> &vecdB
+  ,const std::vector<double> &vecdValues,int nNumANew,const std::vector<double> &vecdBNew
+  ,const std::vector<double> &vecdANew,std::vector<double> &vecdResult){
+
+  surfaceLoop loop;
+  loop.vecdA=&vecdA;
+  loop.vecdB=&vecdB;
+  loop.vecdValues=&vecdValues;
+  loop.nNumANew=nNumANew;
+  loop.vecdBNew=&vecdBNew;
+  loop.vecdANew=&vecdANew;
+  loop.vecdResult=&vecdResult;
+  vecdResult.resize(nNumANew*vecdBNew.size());
+
+  //splines along the second index of each row
+  int nNumA=int(vecdA.size());
+  int nNumB=int(vecdB.size());
+  loop.vecdSecondDerivB.resize(nNumA*nNumB);
+  for(int i=0;i<nNumA;i++){
+    getSplineSecondDerivs(vecdB,&vecdValues[i*nNumB],1,&loop.vecdSecondDerivB[i*nNumB]);
+  }
+  parallelFor(int(vecdBNew.size()),evaluateSurfaceBody,(void*)(&loop));
+}
+int nIntervalIndex(const std::vector<double> &vecdX,double dXValue){
+  for(unsigned int k=0;k+1<vecdX.size();k++){
+    if(vecdX[k]<=dXValue&&dXValue<vecdX[k+1]){
+      return int(k);
+    }
+  }
+  return 0;
+}
+bool bNearNan(const std::vector<double> &vecdValues,int nNumCols,int nRow,int nCol,int nRowLimit
+  ,int nColLimit){
+  if(std::isnan(vecdValues[nRow*nNumCols+nCol])){
+    return true;
+  }
+  if(nRow<nRowLimit&&std::isnan(vecdValues[(nRow+1)*nNumCols+nCol])){
+    return true;
+  }
+  if(nCol<nColLimit&&std::isnan(vecdValues[nRow*nNumCols+nCol+1])){
+    return true;
+  }
+  if(nRow<nRowLimit&&nCol<nColLimit&&std::isnan(vecdValues[(nRow+1)*nNumCols+nCol+1])){
+    return true;
+  }
+  return false;
+}
+void makeTable(const tableConfig &config){
+  std::cout<<"creating table \""<<config.sOutputFile<<"\" ...\n";
+
+  //interpolate in composition
+  eosComposition eosComp=interpEOSComposition(config.dX,config.dZ);
+  opacityComposition opacityComp=interpOpacityComposition(config.dX,config.dZ);
+
+  //grid of the new table
+  int nNumRho=config.nNumRho;
+  int nNumT=config.nNumT;
+  std::vector<double> vecdLogRhoNew(nNumRho);
+  std::vector<double> vecdLogTNew(nNumT);
+  for(int i=0;i<nNumRho;i++){
+    vecdLogRhoNew[i]=config.dLogRhoMin+double(i)*config.dLogRhoDelta;
+  }
+  for(int j=0;j<nNumT;j++){
+    vecdLogTNew[j]=config.dLogTMin+double(j)*config.dLogTDelta;
+  }
+
+  //fill in nans of the equation of state, and interpolate it to the new grid
+  std::cout<<"  interpolating eos to new grid ...\n";
+  std::vector<double> vecdLogEFilled;
+  std::vector<double> vecdLogPFilled;
+  std::vector<const std::vector<double>*> vecvecdOriginal;
+  std::vector<std::vector<double>*> vecvecdFilled;
+  vecvecdOriginal.push_back(&eosComp.vecdLogE);
+  vecvecdOriginal.push_back(&eosComp.vecdLogP);
+  vecvecdFilled.push_back(&vecdLogEFilled);
+  vecvecdFilled.push_back(&vecdLogPFilled);
+  fillNans(eosComp.vecdLogRho,eosComp.vecdLogT,0.5,1.0,eosComp.vecdLogE,vecvecdOriginal
+    ,vecvecdFilled);
+  std::vector<double> vecdLogRhoPoints(nNumRho*nNumT);
+  for(int i=0;i<nNumRho;i++){
+    for(int j=0;j<nNumT;j++){
+      vecdLogRhoPoints[i*nNumT+j]=vecdLogRhoNew[i];
+    }
+  }
+  std::vector<double> vecdLogEGas;
+  std::vector<double> vecdLogPGas;
+  evaluateSurface(eosComp.vecdLogRho,eosComp.vecdLogT,vecdLogEFilled,nNumRho,vecdLogTNew
+    ,vecdLogRhoPoints,vecdLogEGas);
+  evaluateSurface(eosComp.vecdLogRho,eosComp.vecdLogT,vecdLogPFilled,nNumRho,vecdLogTNew
+    ,vecdLogRhoPoints,vecdLogPGas);
+
+  //fill in nans of the opacity, and interpolate it to the new grid at R=rho/T6^3
+  std::cout<<"  interpolating opacity to new grid ...\n";
+  std::vector<double> vecdLogKappaFilled;
+  vecvecdOriginal.clear();
+  vecvecdFilled.clear();
+  vecvecdOriginal.push_back(&opacityComp.vecdLogKappa);
+  vecvecdFilled.push_back(&vecdLogKappaFilled);
+  fillNans(opacityComp.vecdLogT,opacityComp.vecdLogR,1.0,0.5,opacityComp.vecdLogKappa
+    ,vecvecdOriginal,vecvecdFilled);
+  int nNumTOpacity=int(opacityComp.vecdLogT.size());
+  int nNumR=int(opacityComp.vecdLogR.size());
+  std::vector<double> vecdLogKappaByR(nNumR*nNumTOpacity);
+  for(int i=0;i<nNumTOpacity;i++){
+    for(int j=0;j<nNumR;j++){
+      vecdLogKappaByR[j*nNumTOpacity+i]=vecdLogKappaFilled[i*nNumR+j];
+    }
+  }
+  std::vector<double> vecdLogRPoints(nNumRho*nNumT);
+  for(int i=0;i<nNumRho;i++){
+    for(int j=0;j<nNumT;j++){
+      double dT6=pow(10.0,vecdLogTNew[j])/1.0e6;
+      vecdLogRPoints[i*nNumT+j]=log10(pow(10.0,vecdLogRhoNew[i])/pow(dT6,3.0));
+    }
+  }
+  std::vector<double> vecdLogKappa;
+  evaluateSurface(opacityComp.vecdLogR,opacityComp.vecdLogT,vecdLogKappaByR,nNumRho,vecdLogTNew
+    ,vecdLogRPoints,vecdLogKappa);
+
+  //make new table, adding radiation to the equation of state
+  eos eosNew(nNumT,nNumRho);
+  eosNew.dXMassFrac=config.dX;
+  eosNew.dYMassFrac=1.0-config.dX-config.dZ;
+  eosNew.dLogRhoMin=config.dLogRhoMin;
+  eosNew.dLogRhoDelta=config.dLogRhoDelta;
+  eosNew.dLogTMin=config.dLogTMin;
+  eosNew.dLogTDelta=config.dLogTDelta;
+  double dNan=std::numeric_limits<double>::quiet_NaN();
+  int nNumRhoEOS=int(eosComp.vecdLogRho.size());
+  int nNumTEOS=int(eosComp.vecdLogT.size());
+  for(int i=0;i<nNumRho;i++){
+    for(int j=0;j<nNumT;j++){
+      int nPoint=i*nNumT+j;
+      double dT=pow(10.0,vecdLogTNew[j]);
+      double dRho=pow(10.0,vecdLogRhoNew[i]);
+      double dPRad=dRadiationConstant*pow(dT,4.0)/3.0;
+      double dERad=3.0*dPRad/dRho;
+      eosNew.dLogP[i][j]=log10(pow(10.0,vecdLogPGas[nPoint])+dPRad);
+      eosNew.dLogE[i][j]=log10(pow(10.0,vecdLogEGas[nPoint])+dERad);
+      eosNew.dLogKappa[i][j]=vecdLogKappa[nPoint];
+      if(!config.bSetNans){
+        continue;
+      }
+
+      /*points outside the original tables, or next to a nan in them, are nans. The limits on the
+      neighbours checked are those of eos_interp.py, so tables made by both are the same*/
+      if(vecdLogTNew[j]<eosComp.vecdLogT.front()||eosComp.vecdLogT.back()<vecdLogTNew[j]
+        ||vecdLogRhoNew[i]<eosComp.vecdLogRho.front()||eosComp.vecdLogRho.back()<vecdLogRhoNew[i]
+        ||bNearNan(eosComp.vecdLogE,nNumTEOS,nIntervalIndex(eosComp.vecdLogRho,vecdLogRhoNew[i])
+        ,nIntervalIndex(eosComp.vecdLogT,vecdLogTNew[j]),nNumTEOS-2,nNumRhoEOS-2)){
+        eosNew.dLogP[i][j]=dNan;
+        eosNew.dLogE[i][j]=dNan;
+      }
+      double dLogR=vecdLogRPoints[nPoint];
+      if(vecdLogTNew[j]<opacityComp.vecdLogT.front()||opacityComp.vecdLogT.back()<vecdLogTNew[j]
+        ||dLogR<opacityComp.vecdLogR.front()||opacityComp.vecdLogR.back()<dLogR
+        ||bNearNan(opacityComp.vecdLogKappa,nNumR,nIntervalIndex(opacityComp.vecdLogT
+        ,vecdLogTNew[j]),nIntervalIndex(opacityComp.vecdLogR,dLogR),nNumTOpacity-2,nNumR-2)){
+        eosNew.dLogKappa[i][j]=dNan;
+      }
+    }
+  }
+
+  //write out table
+  std::cout<<"  saving table to file \""<<config.sOutputFile<<"\" ...\n";
+  eosNew.writeBin(config.sOutputFile);
+}
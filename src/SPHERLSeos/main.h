@@ -0,0 +1,387 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+/** @file
+
+  Header file for \ref main.cpp.
+
+*/
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <pthread.h>
+#include "exception2.h"
+
+//structures
+struct eosComposition{
+  std::string sFileName;/**<
+    Name of the OPAL equation of state file the table was read from
+    */
+  double dX;/**<
+    Hydrogen mass fraction of the table
+    */
+  double dZ;/**<
+    Metal mass fraction of the table
+    */
+  std::vector<double> vecdLogRho;/**<
+    Log10 of the densities of the table [g/cm^3], increasing
+    */
+  std::vector<double> vecdLogT;/**<
+    Log10 of the temperatures of the table [K], increasing
+    */
+  std::vector<double> vecdLogE;/**<
+    Log10 of the energy [ergs/g], the value at \ref eosComposition::vecdLogRho [i] and
+    \ref eosComposition::vecdLogT [j] is at i*vecdLogT.size()+j. Points missing from the table are
+    NaNs.
+    */
+  std::vector<double> vecdLogP;/**<
+    Log10 of the pressure [dynes/cm^2], stored the same way as \ref eosComposition::vecdLogE.
+    */
+};/**<
+  Holds an equation of state table of a single composition on its own density and temperature grid.
+  */
+struct opacityComposition{
+  std::string sFileName;/**<
+    Name of the opacity file the table was read from
+    */
+  bool bMultiTable;/**<
+    True if the file holds tables for more than one composition.
+    */
+  double dX;/**<
+    Hydrogen mass fraction of the table
+    */
+  double dZ;/**<
+    Metal mass fraction of the table
+    */
+  std::vector<double> vecdLogT;/**<
+    Log10 of the temperatures of the table [K], increasing
+    */
+  std::vector<double> vecdLogR;/**<
+    Log10 of R=rho/T6^3 of the table, with rho in g/cm^3 and T6 the temperature in millions of K,
+    increasing
+    */
+  std::vector<double> vecdLogKappa;/**<
+    Log10 of the opacity [cm^2/g], the value at \ref opacityComposition::vecdLogT [i] and
+    \ref opacityComposition::vecdLogR [j] is at i*vecdLogR.size()+j. Points missing from the table
+    are NaNs.
+    */
+};/**<
+  Holds an opacity table of a single composition on its own temperature and R grid.
+  */
+struct tableConfig{
+  double dX;/**<
+    Hydrogen mass fraction of the new table
+    */
+  double dZ;/**<
+    Metal mass fraction of the new table
+    */
+  double dLogRhoMin;/**<
+    Log10 of the smallest density of the new table
+    */
+  double dLogRhoDelta;/**<
+    Spacing in log10 of the density of the new table
+    */
+  int nNumRho;/**<
+    Number of densities in the new table
+    */
+  double dLogTMin;/**<
+    Log10 of the smallest temperature of the new table
+    */
+  double dLogTDelta;/**<
+    Spacing in log10 of the temperature of the new table
+    */
+  int nNumT;/**<
+    Number of temperatures in the new table
+    */
+  std::string sOutputFile;/**<
+    Name of the file the new table is written to
+    */
+  bool bSetNans;/**<
+    If true, points outside the original tables, or next to points missing from them, are set
+    to NaNs in the new table. If false they are filled in by extrapolation.
+    */
+};/**<
+  Settings of a new equation of state table, read from a "table" node under the
+  "interpolatedTables" node of the configuration file.
+  */
+struct parallelLoop{
+  void (*fBody)(void*,int);/**<
+    Function called for each index of the loop, with \ref parallelLoop::vData and the index
+    */
+  void *vData;/**<
+    Data shared by all indices of the loop
+    */
+  int nNumIndices;/**<
+    Number of indices in the loop
+    */
+  int nNext;/**<
+    Next index to be done
+    */
+  bool bError;/**<
+    Set if an index of the loop failed, no more indices are started after that
+    */
+  exception2 eError;/**<
+    Error of the first index that failed
+    */
+  pthread_mutex_t mutex;/**<
+    Protects \ref parallelLoop::nNext, \ref parallelLoop::bError, and \ref parallelLoop::eError
+    */
+};/**<
+  A loop whose indices are shared among threads by \ref parallelFor.
+  */
+struct fillNansLoop{
+  const std::vector<double> *vecdRowAxis;/**<
+    Values of the first index of the table
+    */
+  const std::vector<double> *vecdColAxis;/**<
+    Values of the second index of the table
+    */
+  double dRowScale;/**<
+    Factor the distances along the first index are multiplied by
+    */
+  double dColScale;/**<
+    Factor the distances along the second index are multiplied by
+    */
+  const std::vector<double> *vecdMask;/**<
+    Table whose NaNs mark the points to be filled in
+    */
+  std::vector<std::vector<double>*> vecvecdValues;/**<
+    Tables to fill in, the original values are read from \ref fillNansLoop::vecvecdOriginal
+    */
+  std::vector<const std::vector<double>*> vecvecdOriginal;/**<
+    Original values of the tables to fill in
+    */
+  std::vector<int> vecnBoundary;/**<
+    Positions of the points with a NaN next to them
+    */
+};/**<
+  Data of the loop over rows filling in the NaNs of tables, see \ref fillNans.
+  */
+struct surfaceLoop{
+  const std::vector<double> *vecdA;/**<
+    Values of the first index of the table
+    */
+  const std::vector<double> *vecdB;/**<
+    Values of the second index of the table
+    */
+  const std::vector<double> *vecdValues;/**<
+    Values of the table, the value at vecdA[i] and vecdB[j] is at i*vecdB.size()+j
+    */
+  std::vector<double> vecdSecondDerivB;/**<
+    Second derivatives of the splines along the second index of each row of the table
+    */
+  int nNumANew;/**<
+    Number of points in each column of the new grid
+    */
+  const std::vector<double> *vecdBNew;/**<
+    Second index of the columns of the new grid
+    */
+  const std::vector<double> *vecdANew;/**<
+    First index of each point of the new grid, the point i of column j is at i*vecdBNew.size()+j
+    */
+  std::vector<double> *vecdResult;/**<
+    Interpolated values at the points of the new grid, stored as \ref surfaceLoop::vecdANew
+    */
+};/**<
+  Data of the loop over columns of a new grid evaluating the bicubic spline of a table, see
+  \ref evaluateSurface.
+  */
+
+//global variables
+std::string sExeDir;/**<
+  Directory of the executable, or the one above it if the executable is in a bin directory. Data
+  files are in the data directory under it.
+  */
+unsigned int nNumThreads;/**<
+  Number of threads used for the parallel loops.
+  */
+std::vector<eosComposition> vecEOSCompositions;/**<
+  Equation of state tables, sorted by Z then X once read.
+  */
+std::vector<double> vecdEOSX;/**<
+  Hydrogen mass fractions of the equation of state tables.
+  */
+std::vector<double> vecdEOSZ;/**<
+  Metal mass fractions of the equation of state tables.
+  */
+std::vector<opacityComposition> vecOpacityCompositions;/**<
+  Opacity tables, sorted by Z then X and with the tables of the same composition merged once read.
+  */
+std::vector<double> vecdOpacityX;/**<
+  Hydrogen mass fractions of the opacity tables.
+  */
+std::vector<double> vecdOpacityZ;/**<
+  Metal mass fractions of the opacity tables.
+  */
+std::vector<tableConfig> vecTableConfigs;/**<
+  Settings of the new tables to make.
+  */
+const double dRadiationConstant=7.56591e-15;/**<
+  Radiation constant a [ergs/(cm^3 K^4)]
+  */
+
+//functions
+int main(int argc,char* argv[]);/**<
+  Reads the configuration file given on the command line, reads in the equation of state and
+  opacity tables listed in it, and makes each of the new tables.
+  */
+void readConfig(std::string sConfigFileName);/**<
+  Reads the configuration file \c sConfigFileName. It has the same format as the configuration
+  files of scripts/eos_interp.py, and may also have a "num-threads" node under the root node.
+  */
+void setExeDir();/**<
+  Sets \ref sExeDir.
+  */
+std::string sDataFilePath(std::string sFileName);/**<
+  Returns the path of \c sFileName. Names starting with "/" or "./" are used as they are, others
+  are taken to be relative to the data directory.
+  */
+void parallelFor(int nNumIndices,void (*fBody)(void*,int),void *vData);/**<
+  Calls \c fBody with \c vData for each index from 0 to \c nNumIndices-1, sharing the indices
+  among \ref nNumThreads threads. If an index throws an \ref exception2, no more indices are
+  started and the first error is thrown once all threads are done.
+  */
+void* parallelLoopWorker(void *vLoop);/**<
+  Thread function, does indices of the \ref parallelLoop \c vLoop until there are none left.
+  */
+double dReadDouble(std::string sValue,std::string sFileName);/**<
+  Returns the value of \c sValue, read from \c sFileName. Throws an error if \c sValue is not a
+  number.
+  */
+int nReadInt(std::string sValue,std::string sFileName);/**<
+  Returns the value of \c sValue, read from \c sFileName. Throws an error if \c sValue is not an
+  integer.
+  */
+std::vector<std::string> vecsSplitLine(std::string sLine);/**<
+  Returns the white space separated parts of \c sLine.
+  */
+bool bReadValues(std::string sLine,std::vector<double> &vecdValues);/**<
+  Reads the numbers on \c sLine into \c vecdValues. Numbers need not be separated by white space
+  when the second one is negative, as happens in some of the opacity tables. Returns false if
+  \c sLine has something other than numbers on it.
+  */
+double dGroundStateEnergy(double dX,double dZ);/**<
+  Returns the energy per mole of the composition \c dX, \c dZ at zero temperature, in the units of
+  the OPAL equation of state tables. It follows the gmass function in ZFS_interp_EOS5.f of the OPAL
+  equation of state.
+  */
+void readEOSFile(eosComposition &eosFile);/**<
+  Reads in the OPAL equation of state file \ref eosComposition::sFileName of \c eosFile. The
+  energies are shifted to be zero at zero temperature.
+  */
+void readEOSFileBody(void *vData,int nIndex);/**<
+  Body of the loop reading the equation of state files, reads in entry \c nIndex of the vector of
+  \ref eosComposition \c vData.
+  */
+void readEOSFiles();/**<
+  Reads in the equation of state tables in \ref vecEOSCompositions, sorts them in Z then X, and
+  sets \ref vecdEOSX and \ref vecdEOSZ. The tables must form a rectangular grid in X and Z.
+  */
+bool bGetComposition(const std::vector<std::string> &vecsParts,double &dX,double &dZ);/**<
+  Reads the composition from the parts \c vecsParts of a line of an opacity file. Returns false
+  if the line doesn't have a composition.
+  */
+std::vector<std::pair<double,double> > vecGetOpacityCompositions(std::string sFileName);/**<
+  Returns the (X,Z) compositions of the tables in the opacity file \c sFileName. Only the summary
+  at the top of files with more than one table is used.
+  */
+void getOpacityCompositionsBody(void *vData,int nIndex);/**<
+  Body of the loop getting the compositions of the opacity files.
+  */
+void readOpacityFile(opacityComposition &opacityTable);/**<
+  Reads in the table of composition \ref opacityComposition::dX, \ref opacityComposition::dZ from
+  the opacity file \ref opacityComposition::sFileName of \c opacityTable.
+  */
+void readOpacityFileBody(void *vData,int nIndex);/**<
+  Body of the loop reading the opacity tables, reads in entry \c nIndex of the vector of
+  \ref opacityComposition \c vData.
+  */
+opacityComposition mergeOpacityTables(const opacityComposition &opacityTable1
+  ,const opacityComposition &opacityTable2);/**<
+  Merges two opacity tables of the same composition, typically a high temperature OPAL table and
+  a low temperature Alexander & Ferguson table. Where both tables have values they are averaged,
+  weighted towards the table the point is further inside of in temperature.
+  */
+void readOpacityFiles();/**<
+  Reads in the opacity tables in \ref vecOpacityCompositions, sorts them in Z then X, merges
+  tables of the same composition, and sets \ref vecdOpacityX and \ref vecdOpacityZ. The tables
+  must form a rectangular grid in X and Z.
+  */
+bool bEarlierInX(const eosComposition &eos1,const eosComposition &eos2);/**<
+  Returns true if \c eos1 has a smaller X than \c eos2.
+  */
+bool bEarlierInZ(const eosComposition &eos1,const eosComposition &eos2);/**<
+  Returns true if \c eos1 has a smaller Z than \c eos2.
+  */
+bool bEarlierInX(const opacityComposition &opacity1,const opacityComposition &opacity2);/**<
+  Returns true if \c opacity1 has a smaller X than \c opacity2.
+  */
+bool bEarlierInZ(const opacityComposition &opacity1,const opacityComposition &opacity2);/**<
+  Returns true if \c opacity1 has a smaller Z than \c opacity2.
+  */
+void getSplineSecondDerivs(const std::vector<double> &vecdX,const double *dY,int nStride
+  ,double *dSecondDeriv);/**<
+  Calculates the second derivatives \c dSecondDeriv of the cubic spline through the points
+  \c vecdX, \c dY[n*nStride] with not-a-knot end conditions. At least 4 points are needed.
+  */
+double dSplineValue(const std::vector<double> &vecdX,const double *dY,int nStride
+  ,const double *dSecondDeriv,double dXValue);/**<
+  Returns the value of the cubic spline with second derivatives \c dSecondDeriv through the points
+  \c vecdX, \c dY[n*nStride] at \c dXValue. Values outside the points are extrapolated with the
+  cubic of the nearest interval.
+  */
+std::vector<double> vecdSplineWeights(const std::vector<double> &vecdX,double dXValue);/**<
+  Returns the weights of the values at \c vecdX in the value of their cubic spline at \c dXValue.
+  */
+double dQuadratic(double dX,double dX1,double dX2,double dX3,double dY1,double dY2,double dY3);/**<
+  Returns the value at \c dX of the quadratic through the points (\c dX1, \c dY1),
+  (\c dX2, \c dY2), and (\c dX3, \c dY3).
+  */
+eosComposition interpEOSComposition(double dX,double dZ);/**<
+  Returns the equation of state table at composition \c dX, \c dZ, interpolated quadratically in Z
+  between the three Z of \ref vecEOSCompositions, and with a cubic spline in X.
+  */
+opacityComposition interpOpacityComposition(double dX,double dZ);/**<
+  Returns the opacity table at composition \c dX, \c dZ, interpolated with a bicubic spline in X
+  and Z from \ref vecOpacityCompositions.
+  */
+void fillNansBody(void *vData,int nIndex);/**<
+  Body of the loop filling in the NaNs of tables, fills in row \c nIndex of the
+  \ref fillNansLoop \c vData.
+  */
+void fillNans(const std::vector<double> &vecdRowAxis,const std::vector<double> &vecdColAxis
+  ,double dRowScale,double dColScale,const std::vector<double> &vecdMask
+  ,std::vector<const std::vector<double>*> vecvecdOriginal
+  ,std::vector<std::vector<double>*> vecvecdValues);/**<
+  Fills in the points of the tables \c vecvecdValues where \c vecdMask is NaN with an average of
+  the points next to a NaN, weighted by the inverse of their distance to the 16th power. Distances
+  along the first and second index are multiplied by \c dRowScale and \c dColScale. The tables
+  start as copies of \c vecvecdOriginal.
+  */
+void evaluateSurfaceBody(void *vData,int nIndex);/**<
+  Body of the loop evaluating the bicubic spline of a table, does column \c nIndex of the new grid
+  of the \ref surfaceLoop \c vData.
+  */
+void evaluateSurface(const std::vector<double> &vecdA,const std::vector<double> &vecdB
+  ,const std::vector<double> &vecdValues,int nNumANew,const std::vector<double> &vecdBNew
+  ,const std::vector<double> &vecdANew,std::vector<double> &vecdResult);/**<
+  Evaluates the bicubic spline with not-a-knot end conditions of the table \c vecdValues on the
+  grid \c vecdA, \c vecdB at the points of a new grid. The new grid has columns at \c vecdBNew,
+  each with \c nNumANew points whose first indices are given in \c vecdANew. Points outside the
+  table are given the value at the nearest edge of the table.
+  */
+int nIntervalIndex(const std::vector<double> &vecdX,double dXValue);/**<
+  Returns the index of the interval of \c vecdX holding \c dXValue, or 0 if none do.
+  */
+bool bNearNan(const std::vector<double> &vecdValues,int nNumCols,int nRow,int nCol,int nRowLimit
+  ,int nColLimit);/**<
+  Returns true if the point \c nRow, \c nCol of the table \c vecdValues with \c nNumCols columns
+  is a NaN, or if one of the points above it in either index is. The point above in the first
+  index is only checked if \c nRow is less than \c nRowLimit, and the one above in the second index
+  if \c nCol is less than \c nColLimit.
+  */
+void makeTable(const tableConfig &config);/**<
+  Makes the new equation of state table described by \c config and writes it out.
+  */
+#endif
@@ -25,6 +25,12 @@
 #include <algorithm>
 #include <iomanip>
 #include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
 
 int main(){
   try{
@@ -73,716 +79,1104 @@ void readConfig(std::string sConfigFileName,std::string sStartNode){
     dSigma=5.6704e-5;
   }
   
-  //get first model
+  //get first model, and survey
   XMLNode xModel=getXMLNodeNoThrow(xData, "model",0);
+  XMLNode xSurvey=getXMLNodeNoThrow(xData, "survey",0);
   
-  if(xModel.isEmpty()){
+  if(xModel.isEmpty()&&xSurvey.isEmpty()){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-      <<": no \"model\" node found under \"data\" node. Need at least one model node.\n";
+      <<": no \"model\" or \"survey\" node found under \"data\" node. Need at least one model "
+      <<"node or a survey node.\n";
     throw exception2(ssTemp.str(),INPUT);
   }
   int nCount=0;
+  while(!xModel.isEmpty()){
+    
+    makeModel(xModel,nCount);
+    
+    //get next model
+    nCount++;
+    xModel=getXMLNodeNoThrow(xData,"model",nCount);
+  }
+  
+  //generate the models of the survey
+  if(!xSurvey.isEmpty()){
+    runSurvey(xSurvey);
+  }
+}
+void makeModel(XMLNode xModel,int nCount){
+  
   int nCount2=0;
   XMLNode xMDeltaDelta;
   XMLNode xMDeltaPicking;
   MDeltaDelta mDeltaDeltaTemp;
   std::string sModelType;
   std::string sEOSType;
-  while(!xModel.isEmpty()){
+  statsConvergence.nNumShells=0;
+  statsConvergence.nNumIterations=0;
+  statsConvergence.nMaxIterations=0;
+  statsConvergence.nNumUnconverged=0;
+  
+  //get model type
+  getXMLAttribute(xModel,"type",sModelType);
+  if(sModelType.compare("sedov")==0){
     
-    //get model type
-    getXMLAttribute(xModel,"type",sModelType);
-    if(sModelType.compare("sedov")==0){
-      
-      //no alpha for sedov model
-      dAlpha=0.0;
-      
-      /////////////////////////////////////////////
-      //OUTPUT OPTIONS
-      
-      XMLNode xOutput=getXMLNode(xModel,"output",0);
-      
-      //get name of file to write model to
-      getXMLValue(xOutput,"fileName",0,sOutPutfile);
-      std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": generating sedov model \""<<sOutPutfile<<"\" ...\n";
-      
-      //get output file type, binary or ascii
-      if(!getXMLValueNoThrow(xOutput,"binary",0,bBinaryOutput)){
-        bBinaryOutput=true;//default
-      }
-      
-      //get wheather to write to screen
-      if(!getXMLValueNoThrow(xOutput,"writeToScreen",0,bWriteToScreen)){
-        bWriteToScreen=false;//default value
-      }
-      
-      //get precision
-      if(!getXMLValueNoThrow(xOutput,"precision",0,nPrecision)){
-        nPrecision=16;
-      }
-      
-      //get dTimeStepFactor
-      getXMLValue(xOutput,"timeStepFactor",0,dTimeStepFactor);
-      
-      
-      ////////////////////////////////////////
-      //GET DIMENSIONS OF MODEL
-      
-      //switch to dimensions node
-      XMLNode xDims=getXMLNode(xModel,"dimensions",0);
-      
-      //get theta dimension
-      getXMLValue(xDims,"num-theta",0,nNumTheta);
-      if(nNumTheta<1){
-        std::stringstream ssTemp;
-        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": number of theta zones \"num-theta\" must be 1 or greater\n";
-        throw exception2(ssTemp.str(),INPUT);
-      }
-      
-      //get phi dimension
-      getXMLValue(xDims,"num-phi",0,nNumPhi);
-      if(nNumPhi<1){
-        std::stringstream ssTemp;
-        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": number of phi zones \"num-phi\" must be 1 or greater\n";
-        throw exception2(ssTemp.str(),INPUT);
+    //no alpha for sedov model
+    dAlpha=0.0;
+    
+    /////////////////////////////////////////////
+    //OUTPUT OPTIONS
+    
+    XMLNode xOutput=getXMLNode(xModel,"output",0);
+    
+    //get name of file to write model to
+    getXMLValue(xOutput,"fileName",0,sOutPutfile);
+    std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": generating sedov model \""<<sOutPutfile<<"\" ...\n";
+    
+    //get output file type, binary or ascii
+    if(!getXMLValueNoThrow(xOutput,"binary",0,bBinaryOutput)){
+      bBinaryOutput=true;//default
+    }
+    
+    //get wheather to write to screen
+    if(!getXMLValueNoThrow(xOutput,"writeToScreen",0,bWriteToScreen)){
+      bWriteToScreen=false;//default value
+    }
+    
+    //get precision
+    if(!getXMLValueNoThrow(xOutput,"precision",0,nPrecision)){
+      nPrecision=16;
+    }
+    
+    //get number of threads used to write out 3D models
+    if(!getXMLValueNoThrow(xOutput,"num-threads",0,nNumThreads)||nNumThreads<1){
+      nNumThreads=(unsigned int)(std::max(long(1),sysconf(_SC_NPROCESSORS_ONLN)));
+      if(bSurveyWorker){//survey models are already generated in parallel
+        nNumThreads=1;
       }
-      
-      //get delta theta
-      getXMLValue(xDims,"delta-theta",0,dDeltaTheta);
-      
-      //get delta phi
-      getXMLValue(xDims,"delta-phi",0,dDeltaPhi);
-      
-      //get number of ghost cells
-      getXMLValue(xDims,"num-ghost-cells",0,nNumGhostCells);
-      
-      //set number of dimensions
-      if(nNumTheta==1&&nNumPhi==1){
-        nNumDims=1;
+    }
+    
+    //get dTimeStepFactor
+    getXMLValue(xOutput,"timeStepFactor",0,dTimeStepFactor);
+    
+    
+    ////////////////////////////////////////
+    //GET DIMENSIONS OF MODEL
+    
+    //switch to dimensions node
+    XMLNode xDims=getXMLNode(xModel,"dimensions",0);
+    
+    //get theta dimension
+    getXMLValue(xDims,"num-theta",0,nNumTheta);
+    if(nNumTheta<1){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": number of theta zones \"num-theta\" must be 1 or greater\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //get phi dimension
+    getXMLValue(xDims,"num-phi",0,nNumPhi);
+    if(nNumPhi<1){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": number of phi zones \"num-phi\" must be 1 or greater\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //get delta theta
+    getXMLValue(xDims,"delta-theta",0,dDeltaTheta);
+    
+    //get delta phi
+    getXMLValue(xDims,"delta-phi",0,dDeltaPhi);
+    
+    //get number of ghost cells
+    getXMLValue(xDims,"num-ghost-cells",0,nNumGhostCells);
+    
+    //set number of dimensions
+    if(nNumTheta==1&&nNumPhi==1){
+      nNumDims=1;
+    }
+    else if(nNumTheta>1&&nNumPhi==1){
+      nNumDims=2;
+    }
+    else if(nNumTheta>1&&nNumPhi>1){
+      nNumDims=3;
+    }
+    else if(nNumTheta==1&&nNumPhi>1){//only support 2D in theta direction
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": 2D simulations use only radial and theta directions, try switching number of "
+        <<"theta and phi zones.\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    
+    //RADIAL INDEPENDENT VARIABLE
+    
+    //get deleta r
+    XMLNode xIndepVar=getXMLNode(xDims,"radIndepVar",0);
+    getXMLValue(xIndepVar,"r-delta",0,dRDelta);
+    
+    //get minimum radius
+    getXMLValue(xIndepVar,"r-min",0,dRMin);
+    
+    //get number of raidial zones
+    getXMLValue(xIndepVar,"num-r",0,nNumR);
+    
+    //get number of 1D zones at center
+    getXMLValue(xIndepVar,"num-1D",0,nNumZones1D);
+    
+    
+    ////////////////////////////////////////
+    //GET PERIODICITY
+    
+    //switch to periodic node
+    XMLNode xPeriodic=getXMLNode(xModel,"periodic",0);
+    
+    //get x-periodicity
+    getXMLValue(xPeriodic,"x0",0,nPeriodic[0]);
+    if(nPeriodic[0]!=0){//x0 periodicity not yet supported
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": periodicity in x-direction not yet implemented\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //get y-periodicity
+    getXMLValue(xPeriodic,"x1",0,nPeriodic[1]);
+    if(nPeriodic[1]!=0&&nNumTheta<nNumGhostCells){//must have enough zones for periodic BC
+      std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": WARNING number of theta zones is "<<nNumTheta
+        <<" which is too small to support periodicity with "<<nNumGhostCells
+        <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
+      nPeriodic[1]=0;
+    }
+    
+    //get z-periodicity
+    getXMLValue(xPeriodic,"x2",0,nPeriodic[2]);
+    if(nPeriodic[2]!=0&&nNumPhi<nNumGhostCells){//must have enough zones for periodic BC
+      std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": WARNING number of phi zones is "<<nNumPhi
+        <<" which is too small to support periodicity with "<<nNumGhostCells
+        <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
+      nPeriodic[2]=0;
+    }
+    
+    
+    //GET STATE
+    XMLNode xState=getXMLNode(xModel,"state",0);
+    
+    //get gamma
+    getXMLValue(xState,"gamma",0,dGamma);
+    bGammaLawEOS=true;
+    
+    //get number of central cells
+    getXMLValue(xState,"num-shells-center",0,nNumCellsCent);
+    
+    //get central energy
+    getXMLValue(xState,"eng-cent",0,dEngCent);
+    
+    //get energy in for rest of grid
+    getXMLValue(xState,"eng",0,dEng);
+    
+    //get density of grid
+    getXMLValue(xState,"rho",0,dRho);
+    
+    //generate sedov model
+    generateModel_SEDOV();
+    
+    //write to screen
+    if(bWriteToScreen){
+      writeModelToScreen_GL();
+    }
+    
+    //write to file
+    if(bBinaryOutput){
+      if(nNumDims==1){
+        writeModel_Bin_R_GL();
       }
-      else if(nNumTheta>1&&nNumPhi==1){
-        nNumDims=2;
+      else if(nNumDims==2){
+        writeModel_Bin_RT_GL();
       }
-      else if(nNumTheta>1&&nNumPhi>1){
-        nNumDims=3;
+      else if(nNumDims==3){
+        writeModel_Bin_RTP_GL();
       }
-      else if(nNumTheta==1&&nNumPhi>1){//only support 2D in theta direction
-        std::stringstream ssTemp;
-        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": 2D simulations use only radial and theta directions, try switching number of "
-          <<"theta and phi zones.\n";
-        throw exception2(ssTemp.str(),INPUT);
+    }
+    else{
+      if(nNumDims==1){
+        writeModel_R_GL();
       }
-      
-      
-      //RADIAL INDEPENDENT VARIABLE
-      
-      //get deleta r
-      XMLNode xIndepVar=getXMLNode(xDims,"radIndepVar",0);
-      getXMLValue(xIndepVar,"r-delta",0,dRDelta);
-      
-      //get minimum radius
-      getXMLValue(xIndepVar,"r-min",0,dRMin);
-      
-      //get number of raidial zones
-      getXMLValue(xIndepVar,"num-r",0,nNumR);
-      
-      //get number of 1D zones at center
-      getXMLValue(xIndepVar,"num-1D",0,nNumZones1D);
-      
-      
-      ////////////////////////////////////////
-      //GET PERIODICITY
-      
-      //switch to periodic node
-      XMLNode xPeriodic=getXMLNode(xModel,"periodic",0);
-      
-      //get x-periodicity
-      getXMLValue(xPeriodic,"x0",0,nPeriodic[0]);
-      if(nPeriodic[0]!=0){//x0 periodicity not yet supported
-        std::stringstream ssTemp;
-        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": periodicity in x-direction not yet implemented\n";
-        throw exception2(ssTemp.str(),INPUT);
+      else if(nNumDims==2){
+        writeModel_RT_GL();
       }
-      
-      //get y-periodicity
-      getXMLValue(xPeriodic,"x1",0,nPeriodic[1]);
-      if(nPeriodic[1]!=0&&nNumTheta<nNumGhostCells){//must have enough zones for periodic BC
-        std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": WARNING number of theta zones is "<<nNumTheta
-          <<" which is too small to support periodicity with "<<nNumGhostCells
-          <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
-        nPeriodic[1]=0;
+      else if(nNumDims==3){
+        writeModel_RTP_GL();
       }
-      
-      //get z-periodicity
-      getXMLValue(xPeriodic,"x2",0,nPeriodic[2]);
-      if(nPeriodic[2]!=0&&nNumPhi<nNumGhostCells){//must have enough zones for periodic BC
-        std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": WARNING number of phi zones is "<<nNumPhi
-          <<" which is too small to support periodicity with "<<nNumGhostCells
-          <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
-        nPeriodic[2]=0;
+    }
+
+  }
+  else if(sModelType.compare("stellar")==0){
+    
+    
+    /////////////////////////////////////////////
+    //OUTPUT OPTIONS
+    
+    XMLNode xOutput=getXMLNode(xModel,"output",0);
+    
+    //get name of file to write model to
+    getXMLValue(xOutput,"fileName",0,sOutPutfile);
+    std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": generating stellar model \""
+      <<sOutPutfile<<"\" ...\n";
+    
+    //get output file type, binary or ascii
+    if(!getXMLValueNoThrow(xOutput,"binary",0,bBinaryOutput)){
+      bBinaryOutput=true;//default
+    }
+    
+    //get wheather to write to screen
+    if(!getXMLValueNoThrow(xOutput,"writeToScreen",0,bWriteToScreen)){
+      bWriteToScreen=false;//default value
+    }
+    
+    //get precision
+    if(!getXMLValueNoThrow(xOutput,"precision",0,nPrecision)){
+      nPrecision=16;
+    }
+    
+    //get number of threads used to write out 3D models
+    if(!getXMLValueNoThrow(xOutput,"num-threads",0,nNumThreads)||nNumThreads<1){
+      nNumThreads=(unsigned int)(std::max(long(1),sysconf(_SC_NPROCESSORS_ONLN)));
+      if(bSurveyWorker){//survey models are already generated in parallel
+        nNumThreads=1;
       }
-      
-      
-      //GET STATE
-      XMLNode xState=getXMLNode(xModel,"state",0);
+    }
+    
+    //get dTimeStepFactor
+    getXMLValue(xOutput,"timeStepFactor",0,dTimeStepFactor);
+    
+    
+    ////////////////////////////////////////
+    //GET EQUATION OF STATE
+    XMLNode xEOS=getXMLNode(xModel,"EOS",0);
+    getXMLAttribute(xEOS,"type",sEOSType);
+    if(sEOSType.compare("gammaLaw")==0){//use gamma law equation of state
       
       //get gamma
-      getXMLValue(xState,"gamma",0,dGamma);
-      bGammaLawEOS=true;
+      getXMLValue(xEOS,"gamma",0,dGamma);
       
-      //get number of central cells
-      getXMLValue(xState,"num-shells-center",0,nNumCellsCent);
+      //get name of file containing internal energy profile
+      std::string sEProFileName;
+      getXMLValue(xEOS,"E-pro",0,sEProFileName);
       
-      //get central energy
-      getXMLValue(xState,"eng-cent",0,dEngCent);
-      
-      //get energy in for rest of grid
-      getXMLValue(xState,"eng",0,dEng);
-      
-      //get density of grid
-      getXMLValue(xState,"rho",0,dRho);
-      
-      //generate sedov model
-      generateModel_SEDOV();
-      
-      //write to screen
-      if(bWriteToScreen){
-        writeModelToScreen_GL();
-      }
-      
-      //write to file
-      if(bBinaryOutput){
-        if(nNumDims==1){
-          writeModel_Bin_R_GL();
-        }
-        else if(nNumDims==2){
-          writeModel_Bin_RT_GL();
-        }
-        else if(nNumDims==3){
-          writeModel_Bin_RTP_GL();
-        }
+      //test to see if it is relative to the executable directory
+      std::string sTemp;
+      if (sEProFileName.substr(0,1)!="/" 
+        && sEProFileName.substr(0,2)!="./"){
+        
+        //if relative to executable directory 
+        sTemp=sExeDir+"/"+sEProFileName;
       }
       else{
-        if(nNumDims==1){
-          writeModel_R_GL();
-        }
-        else if(nNumDims==2){
-          writeModel_RT_GL();
-        }
-        else if(nNumDims==3){
-          writeModel_RTP_GL();
-        }
+        sTemp=sEProFileName;
       }
-
-    }
-    else if(sModelType.compare("stellar")==0){
-      
       
-      /////////////////////////////////////////////
-      //OUTPUT OPTIONS
+      //read in energy profile
+      readEnergyProfile_GL(sTemp);
       
-      XMLNode xOutput=getXMLNode(xModel,"output",0);
-      
-      //get name of file to write model to
-      getXMLValue(xOutput,"fileName",0,sOutPutfile);
-      std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": generating stellar model \""
-        <<sOutPutfile<<"\" ...\n";
+      //get dRSurf
+      getXMLValue(xEOS,"R-surf",0,dRSurf);
+    }
+    else if(sEOSType.compare("table")==0){//use tabulated equation of state
       
-      //get output file type, binary or ascii
-      if(!getXMLValueNoThrow(xOutput,"binary",0,bBinaryOutput)){
-        bBinaryOutput=true;//default
-      }
+      //get file name for eos table
+      getXMLValue(xEOS,"eosTable",0,sEOSFile);
       
-      //get wheather to write to screen
-      if(!getXMLValueNoThrow(xOutput,"writeToScreen",0,bWriteToScreen)){
-        bWriteToScreen=false;//default value
-      }
+      //get equation of state, tables are only read in the first time they are used
+      eosTable=getEOSTable(sEOSTablePath(sEOSFile));
       
-      //get precision
-      if(!getXMLValueNoThrow(xOutput,"precision",0,nPrecision)){
-        nPrecision=16;
-      }
+      //get dTeff
+      getXMLValue(xEOS,"T-eff",0,dTeff);
       
-      //get dTimeStepFactor
-      getXMLValue(xOutput,"timeStepFactor",0,dTimeStepFactor);
+      //get dL
+      getXMLValue(xEOS,"L",0,dL);
       
+      //get allowed tolerance
+      getXMLValue(xEOS,"tolerance",0,dTolerance);
       
-      ////////////////////////////////////////
-      //GET EQUATION OF STATE
-      XMLNode xEOS=getXMLNode(xModel,"EOS",0);
-      getXMLAttribute(xEOS,"type",sEOSType);
-      if(sEOSType.compare("gammaLaw")==0){//use gamma law equation of state
-        
-        //get gamma
-        getXMLValue(xEOS,"gamma",0,dGamma);
-        
-        //get name of file containing internal energy profile
-        std::string sEProFileName;
-        getXMLValue(xEOS,"E-pro",0,sEProFileName);
-        
-        //test to see if it is relative to the executable directory
-        std::string sTemp;
-        if (sEProFileName.substr(0,1)!="/" 
-          && sEProFileName.substr(0,2)!="./"){
-          
-          //if relative to executable directory 
-          sTemp=sExeDir+"/"+sEProFileName;
-        }
-        else{
-          sTemp=sEProFileName;
-        }
-        
-        //read in energy profile
-        readEnergyProfile_GL(sTemp);
-        
-        //get dRSurf
-        getXMLValue(xEOS,"R-surf",0,dRSurf);
+      //get allowed tolerance
+      if(!getXMLValueNoThrow(xEOS,"maxIterations",0,nNumIters)){
+        nNumIters=1000000;//if not set it big, but not soo big that it sits there for ever
       }
-      else if(sEOSType.compare("table")==0){//use tabulated equation of state
-        
-        //get file name for eos table
-        getXMLValue(xEOS,"eosTable",0,sEOSFile);
-        
-        //test to see if it is relative to the executable directory
-        std::string sTemp;
-        if (sEOSFile.substr(0,1)!="/" && sEOSFile.substr(0,2)!="./"){
-          
-          //if relative to executable directory 
-          sTemp=sExeDir+"/"+sEOSFile;
-        }
-        else{
-          sTemp=sEOSFile;
-        }
-        
-        //read in equation of state
-        eosTable.readBin(sTemp);
-        
-        //get dTeff
-        getXMLValue(xEOS,"T-eff",0,dTeff);
-        
-        //get dL
-        getXMLValue(xEOS,"L",0,dL);
-        
-        //get allowed tolerance
-        getXMLValue(xEOS,"tolerance",0,dTolerance);
-        
-        //get allowed tolerance
-        if(!getXMLValueNoThrow(xEOS,"maxIterations",0,nNumIters)){
-          nNumIters=1000000;//if not set it big, but not soo big that it sits there for ever
-        }
-        
-        //don't use gamma-law EOS
-        bGammaLawEOS=false;
-      }
-      else{
-          std::stringstream ssTemp;
-          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": EOS node has an unknown type in model "<<nCount<<".\n";
-          throw exception2(ssTemp.str(),INPUT);
-      }
-      
-      
-      ////////////////////////////////////////
-      //GET DIMENSIONS OF MODEL
-      
-      //switch to dimensions node
-      XMLNode xDims=getXMLNode(xModel,"dimensions",0);
       
-      //get theta dimension
-      getXMLValue(xDims,"num-theta",0,nNumTheta);
-      if(nNumTheta<1){
+      //don't use gamma-law EOS
+      bGammaLawEOS=false;
+    }
+    else{
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": number of theta zones \"num-theta\" must be 1 or greater in model"<<nCount<<"\n";
+          <<": EOS node has an unknown type in model "<<nCount<<".\n";
         throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    
+    ////////////////////////////////////////
+    //GET DIMENSIONS OF MODEL
+    
+    //switch to dimensions node
+    XMLNode xDims=getXMLNode(xModel,"dimensions",0);
+    
+    //get theta dimension
+    getXMLValue(xDims,"num-theta",0,nNumTheta);
+    if(nNumTheta<1){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": number of theta zones \"num-theta\" must be 1 or greater in model"<<nCount<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //get phi dimension
+    getXMLValue(xDims,"num-phi",0,nNumPhi);
+    if(nNumPhi<1){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": number of phi zones \"num-phi\" must be 1 or greater in model "<<nCount<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //get delta theta
+    getXMLValue(xDims,"delta-theta",0,dDeltaTheta);
+    
+    //get delta phi
+    getXMLValue(xDims,"delta-phi",0,dDeltaPhi);
+    
+    //get number of ghost cells
+    if(getXMLValueNoThrow(xDims,"num-ghost-cells",0,nNumGhostCells)==0){
+      nNumGhostCells=2;//if no xml node is found
+    }
+    
+    //set number of dimensions
+    if(nNumTheta==1&&nNumPhi==1){
+      nNumDims=1;
+    }
+    else if(nNumTheta>1&&nNumPhi==1){
+      nNumDims=2;
+    }
+    else if(nNumTheta>1&&nNumPhi>1){
+      nNumDims=3;
+    }
+    else if(nNumTheta==1&&nNumPhi>1){//only support 2D in theta direction
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": 2D simulations use only radial and theta directions, try switching number of "
+        <<"theta and phi zones in model "<<nCount<<".\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    
+    //RADIAL INDEPENDENT VARIABLE
+    
+    //get total mass
+    XMLNode xIndepVar=getXMLNode(xDims,"radIndepVar",0);
+    getXMLValue(xIndepVar,"M-total",0,dMTotal);
+    
+    //get delta mass init
+    getXMLValue(xIndepVar,"M-delta-init",0,dMDelta);
+    
+    //get method for determining % change in delta mass
+    xMDeltaPicking=getXMLNode(xIndepVar,"M-delta-picking",0);
+    if(!xMDeltaPicking.isEmpty()){
+      std::string sDeltaMPicking;
+      getXMLAttribute(xMDeltaPicking,"type",sDeltaMPicking);
+      if(sDeltaMPicking.compare("auto")==0){
+        bAutoDeltaM=true;
       }
-      
-      //get phi dimension
-      getXMLValue(xDims,"num-phi",0,nNumPhi);
-      if(nNumPhi<1){
+      else if (sDeltaMPicking.compare("manual")==0){
+        bAutoDeltaM=false;
+      }
+      else{
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": number of phi zones \"num-phi\" must be 1 or greater in model "<<nCount<<"\n";
+          <<": \"M-delta-picking\" node attribute \"type\" must be either  \"auto\" or \"manual\""
+          <<" node under the "<<nCount<<"th model.\n";
         throw exception2(ssTemp.str(),INPUT);
       }
+    }
+    if(!bAutoDeltaM){
       
-      //get delta theta
-      getXMLValue(xDims,"delta-theta",0,dDeltaTheta);
-      
-      //get delta phi
-      getXMLValue(xDims,"delta-phi",0,dDeltaPhi);
-      
-      //get number of ghost cells
-      if(getXMLValueNoThrow(xDims,"num-ghost-cells",0,nNumGhostCells)==0){
-        nNumGhostCells=2;//if no xml node is found
-      }
-      
-      //set number of dimensions
-      if(nNumTheta==1&&nNumPhi==1){
-        nNumDims=1;
-      }
-      else if(nNumTheta>1&&nNumPhi==1){
-        nNumDims=2;
-      }
-      else if(nNumTheta>1&&nNumPhi>1){
-        nNumDims=3;
-      }
-      else if(nNumTheta==1&&nNumPhi>1){//only support 2D in theta direction
+      //get % change in delta mass
+      xMDeltaDelta=getXMLNodeNoThrow(xMDeltaPicking, "M-delta-delta",0);
+      if(xMDeltaDelta.isEmpty()){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": 2D simulations use only radial and theta directions, try switching number of "
-          <<"theta and phi zones in model "<<nCount<<".\n";
+          <<": no \"M-delta-delta\" node found under \"radIndepVar\" node, under \"dimensions\""
+          <<" node under the "<<nCount<<"th model.\n";
         throw exception2(ssTemp.str(),INPUT);
       }
-      
-      
-      //RADIAL INDEPENDENT VARIABLE
-      
-      //get total mass
-      XMLNode xIndepVar=getXMLNode(xDims,"radIndepVar",0);
-      getXMLValue(xIndepVar,"M-total",0,dMTotal);
-      
-      //get delta mass init
-      getXMLValue(xIndepVar,"M-delta-init",0,dMDelta);
-      
-      //get method for determining % change in delta mass
-      xMDeltaPicking=getXMLNode(xIndepVar,"M-delta-picking",0);
-      if(!xMDeltaPicking.isEmpty()){
-        std::string sDeltaMPicking;
-        getXMLAttribute(xMDeltaPicking,"type",sDeltaMPicking);
-        if(sDeltaMPicking.compare("auto")==0){
-          bAutoDeltaM=true;
-        }
-        else if (sDeltaMPicking.compare("manual")==0){
-          bAutoDeltaM=false;
-        }
-        else{
+      nCount2=0;
+      while(!xMDeltaDelta.isEmpty()){
+        
+        //get type of stop
+        getXMLAttribute(xMDeltaDelta,"stopType",mDeltaDeltaTemp.sStopType);
+        
+        //if type is T and model is adiabatic, halt
+        if(mDeltaDeltaTemp.sStopType.compare("T")==0&&sEOSType.compare("gammaLaw")==0){
           std::stringstream ssTemp;
           ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": \"M-delta-picking\" node attribute \"type\" must be either  \"auto\" or \"manual\""
-            <<" node under the "<<nCount<<"th model.\n";
+            <<":"<<nCount2<<"th \"M-delta-delta\" node of "<<nCount<<"th model has a \"stopType\""
+            <<" of \"T\" but model uses a gamma-law gas, must have a tabulated equation of state to"
+            <<" use a \"stopType\" of \"T\". Perhpas use a \"stoptype\" of \"R\" or use a different"
+            <<" equation of state.\n";
           throw exception2(ssTemp.str(),INPUT);
         }
+        
+        //get value of stop
+        getXMLAttribute(xMDeltaDelta,"stopValue",mDeltaDeltaTemp.dStopValue);
+        
+        /**\todo need to check that T is increasing, and R is decreasing. This will get tricky if
+        R and T types are mixed.*/
+        
+        //get value of MDeltaDelta
+        getXMLValue(xMDeltaPicking,"M-delta-delta",nCount2,mDeltaDeltaTemp.dMDeltaDelta);
+        
+        //add to vector
+        vecMDeltaDeltaList.push_back(mDeltaDeltaTemp);
+        
+        //get next node
+        nCount2++;
+        xMDeltaDelta=getXMLNodeNoThrow(xMDeltaPicking, "M-delta-delta",nCount2);
       }
-      if(!bAutoDeltaM){
+    }
+    else{
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": M-delta-picking node type is \"auto\" unfortunately this mode is not yet support,"
+        <<" only manual picking of M-delta-delta is supported.\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    //get dAlpha
+    getXMLValue(xIndepVar,"alpha",0,dAlpha);
+    
+    //get number of 1D zones at center
+    getXMLValue(xIndepVar,"num-1D",0,nNumZones1D);
+    
+    ////////////////////////////////////////
+    //GET PERIODICITY
+    
+    //set defaults
+    nPeriodic[0]=0;
+    nPeriodic[1]=1;
+    nPeriodic[2]=1;
+    
+    //switch to periodic node if there is one
+    XMLNode xPeriodic=getXMLNodeNoThrow(xModel,"periodic",0);
+    
+    //if there is a periodic node get values
+    if(!xPeriodic.isEmpty()){
+      getXMLValue(xPeriodic,"x0",0,nPeriodic[0]);
+      getXMLValue(xPeriodic,"x1",0,nPeriodic[1]);
+      getXMLValue(xPeriodic,"x2",0,nPeriodic[2]);
+    }
+    
+    //check periodicity against grid sizes
+    if(nPeriodic[0]!=0){//x0 periodicity not yet supported
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": periodicity in x-direction not yet implemented\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    if(nPeriodic[1]!=0&&nNumTheta<nNumGhostCells){//must have enough zones for periodic BC
+      if(!xPeriodic.isEmpty()){//don't need to tell user about this unless they tried to set it
+        std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": WARNING number of theta zones is "<<nNumTheta
+          <<" which is too small to support periodicity with "<<nNumGhostCells
+          <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
+      }
+      nPeriodic[1]=0;
+    }
+    if(nPeriodic[2]!=0&&nNumPhi<nNumGhostCells){//must have enough zones for periodic BC
+      if(!xPeriodic.isEmpty()){//don't need to tell user about this unless they tried to set it
+        std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": WARNING number of phi zones is "<<nNumPhi
+          <<" which is too small to support periodicity with "<<nNumGhostCells
+          <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
+      }
+      nPeriodic[2]=0;
+    }
+    
+    //GET VELOCITY DISTRIBUTION
+    XMLNode xVelDist=getXMLNode(xModel,"velocityDist",0);
+    std::string sType;
+    getXMLAttribute(xVelDist,"type",sUDistType);
+    if(sUDistType=="POLY"){
+      int nIndex=0;
+      XMLNode xTemp=getXMLNodeNoThrow(xVelDist,"term",nIndex);
+      while(!xTemp.isEmpty()){
         
-        //get % change in delta mass
-        xMDeltaDelta=getXMLNodeNoThrow(xMDeltaPicking, "M-delta-delta",0);
-        if(xMDeltaDelta.isEmpty()){
-          std::stringstream ssTemp;
-          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": no \"M-delta-delta\" node found under \"radIndepVar\" node, under \"dimensions\""
-            <<" node under the "<<nCount<<"th model.\n";
-          throw exception2(ssTemp.str(),INPUT);
-        }
-        nCount2=0;
-        while(!xMDeltaDelta.isEmpty()){
-          
-          //get type of stop
-          getXMLAttribute(xMDeltaDelta,"stopType",mDeltaDeltaTemp.sStopType);
-          
-          //if type is T and model is adiabatic, halt
-          if(mDeltaDeltaTemp.sStopType.compare("T")==0&&sEOSType.compare("gammaLaw")==0){
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<":"<<nCount2<<"th \"M-delta-delta\" node of "<<nCount<<"th model has a \"stopType\""
-              <<" of \"T\" but model uses a gamma-law gas, must have a tabulated equation of state to"
-              <<" use a \"stopType\" of \"T\". Perhpas use a \"stoptype\" of \"R\" or use a different"
-              <<" equation of state.\n";
-            throw exception2(ssTemp.str(),INPUT);
-          }
-          
-          //get value of stop
-          getXMLAttribute(xMDeltaDelta,"stopValue",mDeltaDeltaTemp.dStopValue);
-          
-          /**\todo need to check that T is increasing, and R is decreasing. This will get tricky if
-          R and T types are mixed.*/
-          
-          //get value of MDeltaDelta
-          getXMLValue(xMDeltaPicking,"M-delta-delta",nCount2,mDeltaDeltaTemp.dMDeltaDelta);
-          
-          //add to vector
-          vecMDeltaDeltaList.push_back(mDeltaDeltaTemp);
-          
-          //get next node
-          nCount2++;
-          xMDeltaDelta=getXMLNodeNoThrow(xMDeltaPicking, "M-delta-delta",nCount2);
-        }
+        //READ IN TERM
+        term tTemp;
+        
+        //get coeffecient
+        getXMLValue(xTemp,"c",0,tTemp.dCoeff);
+        
+        //get power
+        getXMLValueNoThrow(xTemp,"p",0,tTemp.dPower);
+        
+        //add term
+        vectVelDist.push_back(tTemp);
+        
+        //get next term
+        nIndex++;
+        xTemp=getXMLNodeNoThrow(xVelDist,"term",nIndex);
       }
-      else{
+      if(vectVelDist.size()==0){//no terms found
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": M-delta-picking node type is \"auto\" unfortunately this mode is not yet support,"
-          <<" only manual picking of M-delta-delta is supported.\n";
+          <<": need at least one \"term\" node in the \"velocityDist\" node!\n";
         throw exception2(ssTemp.str(),INPUT);
       }
-      //get dAlpha
-      getXMLValue(xIndepVar,"alpha",0,dAlpha);
-      
-      //get number of 1D zones at center
-      getXMLValue(xIndepVar,"num-1D",0,nNumZones1D);
+    }
+    else if(sUDistType=="PRO"){
       
-      ////////////////////////////////////////
-      //GET PERIODICITY
+      //get file name 
+      std::string sProfileFileName;
+      getXMLValue(xVelDist,"fileName",0,sProfileFileName);
       
-      //set defaults
-      nPeriodic[0]=0;
-      nPeriodic[1]=1;
-      nPeriodic[2]=1;
+      //test to see if it is relative to the execuatable directory
+      std::string sTemp;
+      if (sProfileFileName.substr(0,1)!="/" 
+        && sProfileFileName.substr(0,2)!="./"){
+        
+        //if relative to executable directory 
+        sTemp=sExeDir+"/"+sProfileFileName;
+      }
+      else{
+        sTemp=sProfileFileName;
+      }
       
-      //switch to periodic node if there is one
-      XMLNode xPeriodic=getXMLNodeNoThrow(xModel,"periodic",0);
+      //read u profile
+      readUProfile(sTemp);
       
-      //if there is a periodic node get values
-      if(!xPeriodic.isEmpty()){
-        getXMLValue(xPeriodic,"x0",0,nPeriodic[0]);
-        getXMLValue(xPeriodic,"x1",0,nPeriodic[1]);
-        getXMLValue(xPeriodic,"x2",0,nPeriodic[2]);
-      }
+      //get surface velocity value
+      getXMLValue(xVelDist,"uSurf",0,dUSurf);
       
-      //check periodicity against grid sizes
-      if(nPeriodic[0]!=0){//x0 periodicity not yet supported
+    }
+    else{
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-          <<": periodicity in x-direction not yet implemented\n";
+          <<": velocityDist node has an unknown type.\n";
         throw exception2(ssTemp.str(),INPUT);
+    }
+    
+    //check for velocity perturbations, they are added when the velocities are set
+    XMLNode xPerturb=getXMLNodeNoThrow(xVelDist,"perturb",0);
+    int nPerturbation=0;
+    while(!xPerturb.isEmpty()){
+      
+      //figure out type of preturbaiton
+      std::string sPerturbType;
+      getXMLAttribute(xPerturb,"type",sPerturbType);
+      if(sPerturbType=="torus"){
+        
+        //read perturbation info
+        readTorusPerturbation(xPerturb);
       }
-      if(nPeriodic[1]!=0&&nNumTheta<nNumGhostCells){//must have enough zones for periodic BC
-        if(!xPeriodic.isEmpty()){//don't need to tell user about this unless they tried to set it
-          std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": WARNING number of theta zones is "<<nNumTheta
-            <<" which is too small to support periodicity with "<<nNumGhostCells
-            <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
-        }
-        nPeriodic[1]=0;
+      else{
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": unknown perturbation type, \""<<sPerturbType<<"\", in "<<nPerturbation
+          <<"th preturbation in velocityDist node with type \""<<sUDistType<<"\"\n";
+        throw exception2(ssTemp.str(),INPUT);
       }
-      if(nPeriodic[2]!=0&&nNumPhi<nNumGhostCells){//must have enough zones for periodic BC
-        if(!xPeriodic.isEmpty()){//don't need to tell user about this unless they tried to set it
-          std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": WARNING number of phi zones is "<<nNumPhi
-            <<" which is too small to support periodicity with "<<nNumGhostCells
-            <<" ghost cells at boundary. Unsetting periodic boundary condition.\n";
-        }
-        nPeriodic[2]=0;
+      
+      //get next perturbation
+      nPerturbation++;
+      xPerturb=getXMLNodeNoThrow(xVelDist,"perturb",nPerturbation);
+    }
+    
+    //generate stellar model
+    if(bGammaLawEOS){
+      
+      //generate model
+      generateModel_GL();
+      
+      //write to screen
+      if(bWriteToScreen){
+        writeModelToScreen_GL();
       }
       
-      //GET VELOCITY DISTRIBUTION
-      XMLNode xVelDist=getXMLNode(xModel,"velocityDist",0);
-      std::string sType;
-      getXMLAttribute(xVelDist,"type",sUDistType);
-      if(sUDistType=="POLY"){
-        int nIndex=0;
-        XMLNode xTemp=getXMLNodeNoThrow(xVelDist,"term",nIndex);
-        while(!xTemp.isEmpty()){
-          
-          //READ IN TERM
-          term tTemp;
-          
-          //get coeffecient
-          getXMLValue(xTemp,"c",0,tTemp.dCoeff);
-          
-          //get power
-          getXMLValueNoThrow(xTemp,"p",0,tTemp.dPower);
-          
-          //add term
-          vectVelDist.push_back(tTemp);
-          
-          //get next term
-          nIndex++;
-          xTemp=getXMLNodeNoThrow(xVelDist,"term",nIndex);
+      //write to file
+      if(bBinaryOutput){
+        if(nNumDims==1){
+          writeModel_Bin_R_GL();
         }
-        if(vectVelDist.size()==0){//no terms found
-          std::stringstream ssTemp;
-          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": need at least one \"term\" node in the \"velocityDist\" node!\n";
-          throw exception2(ssTemp.str(),INPUT);
+        else if(nNumDims==2){
+          writeModel_Bin_RT_GL();
+        }
+        else if(nNumDims==3){
+          writeModel_Bin_RTP_GL();
         }
       }
-      else if(sUDistType=="PRO"){
-        
-        //get file name 
-        std::string sProfileFileName;
-        getXMLValue(xVelDist,"fileName",0,sProfileFileName);
-        
-        //test to see if it is relative to the execuatable directory
-        std::string sTemp;
-        if (sProfileFileName.substr(0,1)!="/" 
-          && sProfileFileName.substr(0,2)!="./"){
-          
-          //if relative to executable directory 
-          sTemp=sExeDir+"/"+sProfileFileName;
+      else{
+        if(nNumDims==1){
+          writeModel_R_GL();
+        }
+        else if(nNumDims==2){
+          writeModel_RT_GL();
         }
-        else{
-          sTemp=sProfileFileName;
+        else if(nNumDims==3){
+          writeModel_RTP_GL();
         }
-        
-        //read u profile
-        readUProfile(sTemp);
-        
-        //get surface velocity value
-        getXMLValue(xVelDist,"uSurf",0,dUSurf);
-        
       }
-      else{
-          std::stringstream ssTemp;
-          ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-            <<": velocityDist node has an unknown type.\n";
-          throw exception2(ssTemp.str(),INPUT);
+    }
+    else{
+      
+      //generate model
+      generateModel_TEOS();
+      
+      //write to screen
+      if(bWriteToScreen){
+        writeModelToScreen_TEOS();
       }
       
-      //generate stellar model
-      if(bGammaLawEOS){
-        
-        //generate model
-        generateModel_GL();
-        
-        //check for velocity perturbations and apply them
-        XMLNode xPerturb=getXMLNodeNoThrow(xVelDist,"perturb",0);
-        int nPerturbation=0;
-        while(!xPerturb.isEmpty()){
-          
-          
-          //figure out type of preturbaiton
-          std::string sPerturbType;
-          getXMLAttribute(xPerturb,"type",sPerturbType);
-          if(sPerturbType=="torus"){
-            
-            //ready perturbation info, and apply a torus velocity perturbation
-            pretubeVelocityTorus(xPerturb);
-          }
-          else{
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": unknown perturbation type, \""<<sPerturbType<<"\", in "<<nPerturbation
-              <<"th preturbation in velocityDist node with type \""<<sUDistType<<"\"\n";
-            throw exception2(ssTemp.str(),INPUT);
-          }
-          
-          //get next perturbation
-          nPerturbation++;
-          xPerturb=getXMLNodeNoThrow(xVelDist,"pretrub",nPerturbation);
-        }
-        
-        //write to screen
-        if(bWriteToScreen){
-          writeModelToScreen_GL();
+      //write to file
+      if(bBinaryOutput){
+        if(nNumDims==1){
+          writeModel_Bin_R_TEOS();
         }
-        
-        //write to file
-        if(bBinaryOutput){
-          if(nNumDims==1){
-            writeModel_Bin_R_GL();
-          }
-          else if(nNumDims==2){
-            writeModel_Bin_RT_GL();
-          }
-          else if(nNumDims==3){
-            writeModel_Bin_RTP_GL();
-          }
+        else if(nNumDims==2){
+          writeModel_Bin_RT_TEOS();
         }
-        else{
-          if(nNumDims==1){
-            writeModel_R_GL();
-          }
-          else if(nNumDims==2){
-            writeModel_RT_GL();
-          }
-          else if(nNumDims==3){
-            writeModel_RTP_GL();
-          }
+        else if(nNumDims==3){
+          writeModel_Bin_RTP_TEOS();
         }
       }
       else{
-        
-        //generate model
-        generateModel_TEOS();
-        
-        //check for velocity perturbations and apply them
-        XMLNode xPerturb=getXMLNodeNoThrow(xVelDist,"perturb",0);
-        int nPerturbation=0;
-        while(!xPerturb.isEmpty()){
-          
-          
-          //figure out type of preturbaiton
-          std::string sPerturbType;
-          getXMLAttribute(xPerturb,"type",sPerturbType);
-          if(sPerturbType=="torus"){
-            
-            //ready perturbation info, and apply a torus velocity perturbation
-            pretubeVelocityTorus(xPerturb);
-          }
-          else{
-            std::stringstream ssTemp;
-            ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-              <<": unknown perturbation type, \""<<sPerturbType<<"\", in "<<nPerturbation
-              <<"th preturbation in velocityDist node with type \""<<sUDistType<<"\"\n";
-            throw exception2(ssTemp.str(),INPUT);
-          }
-          
-          //get next perturbation
-          nPerturbation++;
-          xPerturb=getXMLNodeNoThrow(xVelDist,"pretrub",nPerturbation);
+        if(nNumDims==1){
+          writeModel_R_TEOS();
         }
-        
-        //write to screen
-        if(bWriteToScreen){
-          writeModelToScreen_TEOS();
+        else if(nNumDims==2){
+          writeModel_RT_TEOS();
         }
-        
-        //write to file
-        if(bBinaryOutput){
-          if(nNumDims==1){
-            writeModel_Bin_R_TEOS();
-          }
-          else if(nNumDims==2){
-            writeModel_Bin_RT_TEOS();
-          }
-          else if(nNumDims==3){
-            writeModel_Bin_RTP_TEOS();
-          }
+        else if(nNumDims==3){
+          writeModel_RTP_TEOS();
+        }
+      }
+    }
+    
+  }
+  else{
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": unknown model type \""<<sModelType<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //erase vectors
+  statsConvergence.nNumShells=vecdRho.size();
+  vecdM.erase(vecdM.begin(),vecdM.end());
+  vecdMDel.erase(vecdMDel.begin(),vecdMDel.end());
+  vecdP.erase(vecdP.begin(),vecdP.end());
+  vecdE.erase(vecdE.begin(),vecdE.end());
+  vecdRho.erase(vecdRho.begin(),vecdRho.end());
+  vecdR.erase(vecdR.begin(),vecdR.end());
+  vecdT.erase(vecdT.begin(),vecdT.end());
+  vecdKappa.erase(vecdKappa.begin(),vecdKappa.end());
+  vectVelDist.erase(vectVelDist.begin(),vectVelDist.end());
+  vecTorusPerturbations.erase(vecTorusPerturbations.begin(),vecTorusPerturbations.end());
+  vecMDeltaDeltaList.erase(vecMDeltaDeltaList.begin(),vecMDeltaDeltaList.end());
+}
+eos& getEOSTable(std::string sFileName){
+  std::map<std::string,eos*>::iterator it=mapEOSTables.find(sFileName);
+  if(it==mapEOSTables.end()){
+    
+    //first time this table is needed, read it in
+    eos *eosNew=new eos;
+    try{
+      eosNew->readBin(sFileName);
+    }
+    catch(exception2 &eTemp){
+      delete eosNew;
+      throw;
+    }
+    it=mapEOSTables.insert(std::pair<std::string,eos*>(sFileName,eosNew)).first;
+  }
+  return *(it->second);
+}
+std::string sEOSTablePath(std::string sEOSFileName){
+  
+  //test to see if it is relative to the executable directory
+  if (sEOSFileName.substr(0,1)!="/" && sEOSFileName.substr(0,2)!="./"){
+    return sExeDir+"/"+sEOSFileName;
+  }
+  return sEOSFileName;
+}
+void runSurvey(XMLNode xSurvey){
+  
+  //get template model
+  XMLNode xModel=getXMLNode(xSurvey,"model",0);
+  std::string sModelType;
+  getXMLAttribute(xModel,"type",sModelType);
+  
+  //get number of models to generate at once
+  unsigned int nNumProcesses;
+  if(!getXMLValueNoThrow(xSurvey,"num-processes",0,nNumProcesses)||nNumProcesses<1){
+    nNumProcesses=(unsigned int)(std::max(long(1),sysconf(_SC_NPROCESSORS_ONLN)));
+  }
+  
+  //get name of summary file
+  std::string sSummaryFile;
+  if(!getXMLValueNoThrow(xSurvey,"summary",0,sSummaryFile)){
+    sSummaryFile="survey_summary.txt";//default
+  }
+  
+  //read in parameters of the models, in the order the grids and sets are given
+  std::vector<surveyModel> vecModels;
+  for(int i=0;i<xSurvey.nChildNode();i++){
+    XMLNode xChild=xSurvey.getChildNode(i);
+    std::string sName=xChild.getName();
+    if(sName.compare("grid")==0){
+      readSurveyGrid(xChild,vecModels);
+    }
+    else if(sName.compare("set")==0){
+      readSurveySet(xChild,vecModels);
+    }
+  }
+  if(vecModels.size()==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": survey has no models, need at least one \"grid\" or \"set\" node under the \"survey\" "
+      <<"node.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //check that all parameters are in the template model
+  for(unsigned int n=0;n<vecModels.size();n++){
+    for(unsigned int i=0;i<vecModels[n].vecsNames.size();i++){
+      if(nCountXMLNodes(xModel,vecModels[n].vecsNames[i])==0){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": survey parameter \""
+          <<vecModels[n].vecsNames[i]<<"\" is not a node of the template model.\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+    }
+  }
+  
+  //set output file names, "{n}" is replaced with the model number and "{name}" with the value of
+  //parameter "name", if neither is used the model number is appended
+  std::string sFileNameTemplate;
+  getXMLValue(getXMLNode(xModel,"output",0),"fileName",0,sFileNameTemplate);
+  int nWidth=1;
+  for(unsigned int n=vecModels.size()-1;n>=10;n/=10){
+    nWidth++;
+  }
+  for(unsigned int n=0;n<vecModels.size();n++){
+    std::stringstream ssNumber;
+    ssNumber<<std::setw(nWidth)<<std::setfill('0')<<n;
+    std::string sFileName=sFileNameTemplate;
+    if(sFileName.find("{")==std::string::npos){
+      sFileName+="_"+ssNumber.str();
+    }
+    std::vector<std::string> vecsKeys(1,"{n}");
+    std::vector<std::string> vecsReplace(1,ssNumber.str());
+    for(unsigned int i=0;i<vecModels[n].vecsNames.size();i++){
+      vecsKeys.push_back("{"+vecModels[n].vecsNames[i]+"}");
+      vecsReplace.push_back(vecModels[n].vecsValues[i]);
+    }
+    for(unsigned int i=0;i<vecsKeys.size();i++){
+      size_t nPos=sFileName.find(vecsKeys[i]);
+      while(nPos!=std::string::npos){
+        sFileName.replace(nPos,vecsKeys[i].size(),vecsReplace[i]);
+        nPos=sFileName.find(vecsKeys[i],nPos+vecsReplace[i].size());
+      }
+    }
+    vecModels[n].sFileName=sFileName;
+  }
+  
+  //read in equation of state tables once, forked workers share them
+  if(sModelType.compare("stellar")==0){
+    XMLNode xEOS=getXMLNode(xModel,"EOS",0);
+    std::string sEOSType;
+    getXMLAttribute(xEOS,"type",sEOSType);
+    std::string sEOSFileTemplate;
+    getXMLValueNoThrow(xEOS,"eosTable",0,sEOSFileTemplate);
+    for(unsigned int n=0;n<vecModels.size();n++){
+      std::string sEOSFileName=sEOSFileTemplate;
+      for(unsigned int i=0;i<vecModels[n].vecsNames.size();i++){
+        if(vecModels[n].vecsNames[i].compare("eosTable")==0){
+          sEOSFileName=vecModels[n].vecsValues[i];
         }
-        else{
-          if(nNumDims==1){
-            writeModel_R_TEOS();
-          }
-          else if(nNumDims==2){
-            writeModel_RT_TEOS();
-          }
-          else if(nNumDims==3){
-            writeModel_RTP_TEOS();
-          }
+      }
+      if(sEOSType.compare("table")==0){
+        getEOSTable(sEOSTablePath(sEOSFileName));
+      }
+    }
+  }
+  
+  std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": generating "<<vecModels.size()
+    <<" survey models with "<<nNumProcesses<<" processes ...\n";
+  
+  //generate models, keeping at most nNumProcesses workers running
+  std::vector<convergenceStats> vecStats(vecModels.size());
+  std::vector<std::string> vecsStatus(vecModels.size());
+  std::vector<double> vecdTime(vecModels.size());
+  std::vector<timeval> vecStart(vecModels.size());
+  std::map<pid_t,unsigned int> mapRunning;
+  std::map<pid_t,int> mapPipes;
+  unsigned int nNext=0;
+  unsigned int nNumFailed=0;
+  timeval tvStart;
+  gettimeofday(&tvStart,NULL);
+  while(nNext<vecModels.size()||mapRunning.size()>0){
+    
+    //start workers
+    while(nNext<vecModels.size()&&mapRunning.size()<nNumProcesses){
+      int nPipe[2];
+      if(pipe(nPipe)!=0){
+        if(mapRunning.size()>0){//wait for a worker to finish and try again
+          break;
         }
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": unable to create a pipe for survey model "<<nNext<<", "<<strerror(errno)<<"\n";
+        throw exception2(ssTemp.str(),CALCULATION);
       }
       
+      //make sure buffered output is not written again by the worker
+      std::cout.flush();
+      std::cerr.flush();
+      gettimeofday(&vecStart[nNext],NULL);
+      pid_t pid=fork();
+      if(pid==0){
+        close(nPipe[0]);
+        surveyWorker(xModel,vecModels[nNext],nNext,nPipe[1]);
+      }
+      close(nPipe[1]);
+      if(pid<0){
+        close(nPipe[0]);
+        if(mapRunning.size()>0){//wait for a worker to finish and try again
+          break;
+        }
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": unable to start a worker for survey model "<<nNext<<", "<<strerror(errno)<<"\n";
+        throw exception2(ssTemp.str(),CALCULATION);
+      }
+      mapRunning[pid]=nNext;
+      mapPipes[pid]=nPipe[0];
+      nNext++;
     }
-    else{
+    
+    //wait for a worker to finish
+    int nStatus;
+    pid_t pid=waitpid(-1,&nStatus,0);
+    if(pid<0){
+      if(errno==EINTR){
+        continue;
+      }
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-        <<": unknown model type \""<<sModelType<<"\"\n";
+        <<": error waiting for survey workers, "<<strerror(errno)<<"\n";
+      throw exception2(ssTemp.str(),CALCULATION);
+    }
+    std::map<pid_t,unsigned int>::iterator it=mapRunning.find(pid);
+    if(it==mapRunning.end()){//not one of our workers
+      continue;
+    }
+    unsigned int n=it->second;
+    mapRunning.erase(it);
+    timeval tvEnd;
+    gettimeofday(&tvEnd,NULL);
+    vecdTime[n]=double(tvEnd.tv_sec-vecStart[n].tv_sec)
+      +double(tvEnd.tv_usec-vecStart[n].tv_usec)*1.0e-6;
+    
+    //get convergence statistics sent by the worker
+    convergenceStats statsTemp;
+    if(read(mapPipes[pid],&statsTemp,sizeof(convergenceStats))==sizeof(convergenceStats)){
+      vecStats[n]=statsTemp;
+    }
+    close(mapPipes[pid]);
+    mapPipes.erase(pid);
+    
+    //get status of worker
+    std::stringstream ssStatus;
+    if(WIFEXITED(nStatus)&&WEXITSTATUS(nStatus)==0){
+      ssStatus<<"ok";
+    }
+    else{
+      nNumFailed++;
+      if(WIFSIGNALED(nStatus)){
+        ssStatus<<"signal_"<<WTERMSIG(nStatus);
+      }
+      else{
+        ssStatus<<"failed_"<<WEXITSTATUS(nStatus);
+      }
+    }
+    vecsStatus[n]=ssStatus.str();
+    std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": model "<<n<<" \""
+      <<vecModels[n].sFileName<<"\" "<<vecsStatus[n]<<" in "<<vecdTime[n]<<" s, "
+      <<vecStats[n].nNumUnconverged<<" unconverged shells\n";
+  }
+  timeval tvEnd;
+  gettimeofday(&tvEnd,NULL);
+  double dTotalTime=double(tvEnd.tv_sec-tvStart.tv_sec)
+    +double(tvEnd.tv_usec-tvStart.tv_usec)*1.0e-6;
+  
+  //write summary
+  std::ofstream ofSummary;
+  ofSummary.open(sSummaryFile.c_str());
+  if(!ofSummary.good()){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": unable to open survey summary file \""<<sSummaryFile<<"\"\n";
+    throw exception2(ssTemp.str(),OUTPUT);
+  }
+  ofSummary<<"#model status time[s] shells iterations max_iterations unconverged file "
+    <<"parameters\n";
+  for(unsigned int n=0;n<vecModels.size();n++){
+    ofSummary<<n<<" "<<vecsStatus[n]<<" "<<vecdTime[n]<<" "<<vecStats[n].nNumShells<<" "
+      <<vecStats[n].nNumIterations<<" "<<vecStats[n].nMaxIterations<<" "
+      <<vecStats[n].nNumUnconverged<<" "<<vecModels[n].sFileName;
+    for(unsigned int i=0;i<vecModels[n].vecsNames.size();i++){
+      ofSummary<<" "<<vecModels[n].vecsNames[i]<<"="<<vecModels[n].vecsValues[i];
+    }
+    ofSummary<<"\n";
+  }
+  ofSummary.close();
+  
+  std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": generated "
+    <<vecModels.size()-nNumFailed<<" of "<<vecModels.size()<<" survey models in "<<dTotalTime
+    <<" s, summary written to \""<<sSummaryFile<<"\"\n";
+}
+void readSurveyGrid(XMLNode xGrid,std::vector<surveyModel> &vecModels){
+  
+  //get values of each parameter
+  std::vector<std::string> vecsNames;
+  std::vector<std::vector<std::string> > vecvecsValues;
+  for(int i=0;i<xGrid.nChildNode();i++){
+    XMLNode xParameter=xGrid.getChildNode(i);
+    vecsNames.push_back(xParameter.getName());
+    std::vector<std::string> vecsValues;
+    std::stringstream ssValues;
+    if(xParameter.getText()!=NULL){
+      ssValues.str(xParameter.getText());
+    }
+    std::string sValue;
+    while(ssValues>>sValue){
+      vecsValues.push_back(sValue);
+    }
+    if(vecsValues.size()==0){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": survey grid parameter \""
+        <<vecsNames.back()<<"\" has no values.\n";
       throw exception2(ssTemp.str(),INPUT);
     }
-    //get next model
-    nCount++;
-    xModel=getXMLNodeNoThrow(xData,"model",nCount);
+    vecvecsValues.push_back(vecsValues);
+  }
+  if(vecsNames.size()==0){
+    return;
+  }
+  
+  //add every combination of values, the last parameter varies fastest
+  std::vector<unsigned int> vecnIndex(vecsNames.size(),0);
+  while(true){
+    surveyModel modelTemp;
+    modelTemp.vecsNames=vecsNames;
+    for(unsigned int i=0;i<vecsNames.size();i++){
+      modelTemp.vecsValues.push_back(vecvecsValues[i][vecnIndex[i]]);
+    }
+    vecModels.push_back(modelTemp);
+    
+    //next combination
+    int i=vecsNames.size()-1;
+    while(i>=0){
+      vecnIndex[i]++;
+      if(vecnIndex[i]<vecvecsValues[i].size()){
+        break;
+      }
+      vecnIndex[i]=0;
+      i--;
+    }
+    if(i<0){
+      break;
+    }
+  }
+}
+void readSurveySet(XMLNode xSet,std::vector<surveyModel> &vecModels){
+  surveyModel modelTemp;
+  for(int i=0;i<xSet.nChildNode();i++){
+    XMLNode xParameter=xSet.getChildNode(i);
+    std::string sValue;
+    if(xParameter.getText()!=NULL){
+      std::stringstream ssValue(xParameter.getText());
+      ssValue>>sValue;
+    }
+    modelTemp.vecsNames.push_back(xParameter.getName());
+    modelTemp.vecsValues.push_back(sValue);
+  }
+  vecModels.push_back(modelTemp);
+}
+int nCountXMLNodes(XMLNode xParent,std::string sName){
+  int nNumNodes=0;
+  for(int i=0;i<xParent.nChildNode();i++){
+    XMLNode xChild=xParent.getChildNode(i);
+    if(sName.compare(xChild.getName())==0){
+      nNumNodes++;
+    }
+    nNumNodes+=nCountXMLNodes(xChild,sName);
+  }
+  return nNumNodes;
+}
+int nSetXMLValues(XMLNode xParent,std::string sName,std::string sValue){
+  int nNumSet=0;
+  for(int i=0;i<xParent.nChildNode();i++){
+    XMLNode xChild=xParent.getChildNode(i);
+    if(sName.compare(xChild.getName())==0){
+      xChild.updateText(sValue.c_str());
+      nNumSet++;
+    }
+    nNumSet+=nSetXMLValues(xChild,sName,sValue);
+  }
+  return nNumSet;
+}
+void surveyWorker(XMLNode xModel,const surveyModel &modelSurvey,int nModel,int nPipe){
+  
+  //write output of the model to its log file
+  std::string sLogFile=modelSurvey.sFileName+".log";
+  int nLog=open(sLogFile.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+  if(nLog>=0){
+    dup2(nLog,STDOUT_FILENO);
+    dup2(nLog,STDERR_FILENO);
+    close(nLog);
+  }
+  bSurveyWorker=true;
+  int nExit=0;
+  try{
     
-    //erase vectors
-    vecdM.erase(vecdM.begin(),vecdM.end());
-    vecdMDel.erase(vecdMDel.begin(),vecdMDel.end());
-    vecdP.erase(vecdP.begin(),vecdP.end());
-    vecdE.erase(vecdE.begin(),vecdE.end());
-    vecdRho.erase(vecdRho.begin(),vecdRho.end());
-    vecdR.erase(vecdR.begin(),vecdR.end());
-    vecdT.erase(vecdT.begin(),vecdT.end());
-    vecdKappa.erase(vecdKappa.begin(),vecdKappa.end());
-    vectVelDist.erase(vectVelDist.begin(),vectVelDist.end());
+    //set parameters of the model
+    for(unsigned int i=0;i<modelSurvey.vecsNames.size();i++){
+      nSetXMLValues(xModel,modelSurvey.vecsNames[i],modelSurvey.vecsValues[i]);
+    }
+    XMLNode xFileName=getXMLNode(getXMLNode(xModel,"output",0),"fileName",0);
+    xFileName.updateText(modelSurvey.sFileName.c_str());
+    
+    makeModel(xModel,nModel);
+    
+    //send convergence statistics to the parent
+    if(write(nPipe,&statsConvergence,sizeof(convergenceStats))!=sizeof(convergenceStats)){
+      std::cout<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": unable to send convergence statistics, "<<strerror(errno)<<"\n";
+    }
   }
+  catch(exception2& eTemp){
+    std::cout<<eTemp.getMsg();
+    nExit=1;
+  }
+  std::cout.flush();
+  std::cerr.flush();
+  close(nPipe);
+  _exit(nExit);
 }
 void readUProfile(std::string sProfileFileName){
   
@@ -1066,53 +1460,92 @@ void calculateShell_TEOS(unsigned int nShell){
   //initial guesses at T and rho
   double dT=vecdT[nShell-1];
   double dRho=vecdRho[nShell-1];
-  double dRhoCorrection=dRho;
-  double dTCorrection=dT;
-  double dRhoError=dRhoCorrection/dRho;
-  double dTError  =dTCorrection  /dT;
-  double dCorrectionFrac=0.1;
+  double dRhoError=1.0;
+  double dTError  =1.0;
+  
+  //conservation equations and their derivatives at the initial guess, residuals are scaled by
+  //the gravity term and luminosity for the line search
+  double dCons[2];
+  double dJacobian[2][2];
+  getConsAndJacobian_TEOS(dT,dRho,nShell,dCons[0],dCons[1],dJacobian);
+  double dScale[2];
+  dScale[0]=1.0/(dG*vecdM[nShell]/(4.0*dPi*pow(vecdR[nShell],4)));
+  dScale[1]=1.0/dL;
+  double dMerit=pow(dCons[0]*dScale[0],2)+pow(dCons[1]*dScale[1],2);
   
   //keep going if error temperature or error in density is too big
   int nIteration=0;
   while( (fabs(dRhoError)>dTolerance||fabs(dTError)>dTolerance) && nIteration<=nNumIters){
     
-    //calculate coeffecients of the equations to solve for T and rho corrections
-    double dError=10.0;
-    double dB1=-1.0*dMomentumCons(dT,dRho,nShell);
-    double dB2=-1.0*dEnergyCons(dT,dRho,nShell);
-    double dH=1.0e-10*dT;
-    double dA11=dPartialDerivativeVar1(dT,dRho,nShell,dMomentumCons,dH,dError);
-    dH=1.0e-10*dRho;
-    double dA12=dPartialDerivativeVar2(dT,dRho,nShell,dMomentumCons,dH,dError);
-    dH=1.0e-10*dT;
-    double dA21=dPartialDerivativeVar1(dT,dRho,nShell,dEnergyCons,dH,dError);
-    dH=1.0e-10*dRho;
-    double dA22=dPartialDerivativeVar2(dT,dRho,nShell,dEnergyCons,dH,dError);
+    //solve for the Newton corrections
+    double dDet=dJacobian[0][0]*dJacobian[1][1]-dJacobian[0][1]*dJacobian[1][0];
+    double dTCorrection  =(dCons[1]*dJacobian[0][1]-dCons[0]*dJacobian[1][1])/dDet;
+    double dRhoCorrection=(dCons[0]*dJacobian[1][0]-dCons[1]*dJacobian[0][0])/dDet;
+    nIteration++;
     
-    //solve for the corrections
-    double dFracA21A11=dA21/dA11;
-    dRhoCorrection=(dB2-dFracA21A11*dB1)/(dA22-dFracA21A11*dA12);
-    dTCorrection  =dB1/dA11-dA12/dA11*dRhoCorrection;
+    //calculate relative error, if converged take the full correction
+    dTError  =dTCorrection  /dT;
+    dRhoError=dRhoCorrection/dRho;
+    if(fabs(dRhoError)<=dTolerance&&fabs(dTError)<=dTolerance){
+      dT  =dT  +dTCorrection;
+      dRho=dRho+dRhoCorrection;
+      break;
+    }
     
-    while(dRho+dCorrectionFrac*dRhoCorrection<0.0){//keep it from decreasing too fast and becoming negative
-      dCorrectionFrac=dCorrectionFrac*0.5;
+    //keep it from decreasing too fast and becoming negative
+    double dStep=1.0;
+    while(dRho+dStep*dRhoCorrection<=0.0||dT+dStep*dTCorrection<=0.0){
+      dStep=dStep*0.5;
     }
-    while(dT  +dCorrectionFrac*dTCorrection<0.0){//keep it from decreasing too fast and becoming negative
-      dCorrectionFrac=dCorrectionFrac*0.5;
+    
+    /*backtrack until the scaled residuals decrease enough, or until the step is too small to
+    matter in which case the last step is taken anyway. Steps that leave the equation of state
+    table are also backtracked.*/
+    double dTNew=dT;
+    double dRhoNew=dRho;
+    double dConsNew[2];
+    double dJacobianNew[2][2];
+    while(true){
+      dTNew  =dT  +dStep*dTCorrection;
+      dRhoNew=dRho+dStep*dRhoCorrection;
+      bool bAccept=false;
+      try{
+        getConsAndJacobian_TEOS(dTNew,dRhoNew,nShell,dConsNew[0],dConsNew[1],dJacobianNew);
+        double dMeritNew=pow(dConsNew[0]*dScale[0],2)+pow(dConsNew[1]*dScale[1],2);
+        bAccept=(dMeritNew<=(1.0-2.0*dLineSearchAlpha*dStep)*dMerit)||dStep<dMinLineSearchStep;
+        if(bAccept){
+          dMerit=dMeritNew;
+        }
+      }
+      catch(exception2 &eTemp){
+        if(dStep<dMinLineSearchStep){
+          throw;
+        }
+      }
+      if(bAccept){
+        break;
+      }
+      dStep=dStep*0.5;
     }
     
     //apply corrections
-    dT  =dT  +dCorrectionFrac*dTCorrection;
-    dRho=dRho+dCorrectionFrac*dRhoCorrection;
-    
-    //calculate relative error
-    dTError  =dTCorrection  /dT;
-    dRhoError=dRhoCorrection/dRho;
-    nIteration++;
+    dT  =dTNew;
+    dRho=dRhoNew;
+    dCons[0]=dConsNew[0];
+    dCons[1]=dConsNew[1];
+    dJacobian[0][0]=dJacobianNew[0][0];
+    dJacobian[0][1]=dJacobianNew[0][1];
+    dJacobian[1][0]=dJacobianNew[1][0];
+    dJacobian[1][1]=dJacobianNew[1][1];
   }
   if (nIteration>nNumIters){
     std::cout<<"maximum number of iterations("<<nNumIters<<") exceeded with density error ="
       <<dRhoError<<" and temperature error ="<<dTError<<" in shell "<<nShell<<std::endl;
+    statsConvergence.nNumUnconverged++;
+  }
+  statsConvergence.nNumIterations+=nIteration;
+  if((unsigned int)nIteration>statsConvergence.nMaxIterations){
+    statsConvergence.nMaxIterations=nIteration;
   }
   
   //temperature at (nShell)
@@ -3813,13 +4246,13 @@ void writeModel_Bin_RTP_TEOS(){
     ofOut.write((char*)(&vecdRho[i]),sizeof(double));
   }
   
-  //write out 3D region
+  //write out 3D region, a shell at a time
+  unsigned int nSizeY=nNumTheta+2*nNumGhostCells;
+  unsigned int nSizeZ=nNumPhi+2*nNumGhostCells;
+  std::vector<double> vecdShell(nSizeY*nSizeZ);
   for(int i=vecdRho.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&vecdRho[i]),sizeof(double));//spherically symetric
-      }
-    }
+    std::fill(vecdShell.begin(),vecdShell.end(),vecdRho[i]);//spherically symetric
+    ofOut.write((char*)(&vecdShell[0]),vecdShell.size()*sizeof(double));
   }
   
   //write out u
@@ -3830,17 +4263,12 @@ void writeModel_Bin_RTP_TEOS(){
     nStart-=1;
   }
   for(unsigned int i=nStart;i>=nEnd;i--){//start at the center and work outward
-    ofOut.write((char*)(&dU[i][0][0]),sizeof(double));
+    dTemp=dGetVelocity(0,i,0,0);
+    ofOut.write((char*)(&dTemp),sizeof(double));
   }
   
   //write out 3D region
-  for(int i=nEnd-1;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&dU[i][j][k]),sizeof(double));//spherically symetric
-      }
-    }
-  }
+  writeVelocityShells(ofOut,0,nEnd-1,nSizeY,nSizeZ);
   
   //write out u_0 - 1D
   nStart=vecdR.size()-1;
@@ -3854,7 +4282,8 @@ void writeModel_Bin_RTP_TEOS(){
  //write out v - 3D
   //write out 1D region
   for(unsigned int i=vecdRho.size()-1;i>=vecdRho.size()-nNumZones1D-nNumGhostCells;i--){//start at the center and work outward
-    ofOut.write((char*)(&dV[i][0][0]),sizeof(double));
+    dTemp=dGetVelocity(1,i,0,0);
+    ofOut.write((char*)(&dTemp),sizeof(double));
   }
   
   int nInt=1;//if not periodic add inner interface
@@ -3863,18 +4292,13 @@ void writeModel_Bin_RTP_TEOS(){
   }
   
   //write out 3D region
-  for(int i=vecdRho.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells+nInt;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&dV[i][j][k]),sizeof(double));//spherically symetric
-      }
-    }
-  }
+  writeVelocityShells(ofOut,1,vecdRho.size()-nNumZones1D-1-nNumGhostCells,nSizeY+nInt,nSizeZ);
   
  //write out w - 3D
   //write out 1D region
   for(unsigned int i=vecdRho.size()-1;i>=vecdRho.size()-nNumZones1D-nNumGhostCells;i--){//start at the center and work outward
-    ofOut.write((char*)(&dW[i][0][0]),sizeof(double));
+    dTemp=dGetVelocity(2,i,0,0);
+    ofOut.write((char*)(&dTemp),sizeof(double));
   }
   
   nInt=1;//if not periodic add inner interface
@@ -3883,13 +4307,7 @@ void writeModel_Bin_RTP_TEOS(){
   }
   
   //write out 3D region
-  for(int i=vecdRho.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells+nInt;k++){
-        ofOut.write((char*)(&dW[i][j][k]),sizeof(double));//spherically symetric
-      }
-    }
-  }
+  writeVelocityShells(ofOut,2,vecdRho.size()-nNumZones1D-1-nNumGhostCells,nSizeY,nSizeZ+nInt);
   
   //write out T
   
@@ -3898,13 +4316,10 @@ void writeModel_Bin_RTP_TEOS(){
     ofOut.write((char*)(&vecdT[i]),sizeof(double));
   }
   
-  //write out 3D region
+  //write out 3D region, a shell at a time
   for(int i=vecdT.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&vecdT[i]),sizeof(double));//spherically symetric
-      }
-    }
+    std::fill(vecdShell.begin(),vecdShell.end(),vecdT[i]);//spherically symetric
+    ofOut.write((char*)(&vecdShell[0]),vecdShell.size()*sizeof(double));
   }
   ofOut.close();
 }
@@ -4152,13 +4567,13 @@ void writeModel_Bin_RTP_GL(){
     ofOut.write((char*)(&vecdRho[i]),sizeof(double));
   }
   
-  //write out 3D region
+  //write out 3D region, a shell at a time
+  unsigned int nSizeY=nNumTheta+2*nNumGhostCells;
+  unsigned int nSizeZ=nNumPhi+2*nNumGhostCells;
+  std::vector<double> vecdShell(nSizeY*nSizeZ);
   for(int i=vecdRho.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&vecdRho[i]),sizeof(double));//spherically symetric
-      }
-    }
+    std::fill(vecdShell.begin(),vecdShell.end(),vecdRho[i]);//spherically symetric
+    ofOut.write((char*)(&vecdShell[0]),vecdShell.size()*sizeof(double));
   }
   
   //write out u
@@ -4169,17 +4584,12 @@ void writeModel_Bin_RTP_GL(){
     nStart-=1;
   }
   for(unsigned int i=nStart;i>=nEnd;i--){//start at the center and work outward
-    ofOut.write((char*)(&dU[i][0][0]),sizeof(double));
+    dTemp=dGetVelocity(0,i,0,0);
+    ofOut.write((char*)(&dTemp),sizeof(double));
   }
   
   //write out 3D region
-  for(int i=nEnd-1;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&dU[i][j][k]),sizeof(double));//spherically symetric
-      }
-    }
-  }
+  writeVelocityShells(ofOut,0,nEnd-1,nSizeY,nSizeZ);
   
   //write out u_0 - 1D
   nStart=vecdR.size()-1;
@@ -4193,7 +4603,8 @@ void writeModel_Bin_RTP_GL(){
  //write out v - 3D
   //write out 1D region
   for(unsigned int i=vecdRho.size()-1;i>=vecdRho.size()-nNumZones1D-nNumGhostCells;i--){//start at the center and work outward
-    ofOut.write((char*)(&dV[i][0][0]),sizeof(double));
+    dTemp=dGetVelocity(1,i,0,0);
+    ofOut.write((char*)(&dTemp),sizeof(double));
   }
   
   int nInt=1;//if not periodic add inner interface
@@ -4202,18 +4613,13 @@ void writeModel_Bin_RTP_GL(){
   }
   
   //write out 3D region
-  for(int i=vecdRho.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells+nInt;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&dV[i][j][k]),sizeof(double));//spherically symetric
-      }
-    }
-  }
+  writeVelocityShells(ofOut,1,vecdRho.size()-nNumZones1D-1-nNumGhostCells,nSizeY+nInt,nSizeZ);
   
  //write out w - 3D
   //write out 1D region
   for(unsigned int i=vecdRho.size()-1;i>=vecdRho.size()-nNumZones1D-nNumGhostCells;i--){//start at the center and work outward
-    ofOut.write((char*)(&dW[i][0][0]),sizeof(double));
+    dTemp=dGetVelocity(2,i,0,0);
+    ofOut.write((char*)(&dTemp),sizeof(double));
   }
   
   nInt=1;//if not periodic add inner interface
@@ -4222,13 +4628,7 @@ void writeModel_Bin_RTP_GL(){
   }
   
   //write out 3D region
-  for(int i=vecdRho.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells+nInt;k++){
-        ofOut.write((char*)(&dW[i][j][k]),sizeof(double));//spherically symetric
-      }
-    }
-  }
+  writeVelocityShells(ofOut,2,vecdRho.size()-nNumZones1D-1-nNumGhostCells,nSizeY,nSizeZ+nInt);
   
   //write out E
   
@@ -4237,13 +4637,10 @@ void writeModel_Bin_RTP_GL(){
     ofOut.write((char*)(&vecdE[i]),sizeof(double));
   }
   
-  //write out 3D region
+  //write out 3D region, a shell at a time
   for(int i=vecdE.size()-nNumZones1D-1-nNumGhostCells;i>=0;i--){//start at the center and work outward
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        ofOut.write((char*)(&vecdE[i]),sizeof(double));//spherically symetric
-      }
-    }
+    std::fill(vecdShell.begin(),vecdShell.end(),vecdE[i]);//spherically symetric
+    ofOut.write((char*)(&vecdShell[0]),vecdShell.size()*sizeof(double));
   }
   ofOut.close();
 }
@@ -4269,7 +4666,7 @@ void writeModelToScreen_TEOS(){
       <<std::setw(nWidth)<<vecdE[i]
       <<std::setw(nWidth)<<vecdT[i]
       <<std::setw(nWidth)<<vecdP[i]
-      <<std::setw(nWidth)<<dU[i][0][0]<<std::endl;
+      <<std::setw(nWidth)<<dGetVelocity(0,i,0,0)<<std::endl;
   }
   std::cout<<std::setw(3)<<vecdP.size()
     <<std::setw(nWidth)<<vecdM[vecdP.size()]
@@ -4279,7 +4676,7 @@ void writeModelToScreen_TEOS(){
     <<std::setw(nWidth)<<"-"
     <<std::setw(nWidth)<<"-"
     <<std::setw(nWidth)<<"-"
-    <<std::setw(nWidth)<<dU[vecdP.size()][0][0]<<std::endl;
+    <<std::setw(nWidth)<<dGetVelocity(0,vecdP.size(),0,0)<<std::endl;
 }
 void writeModelToScreen_GL(){
   int nWidth=nPrecision+9;
@@ -4301,7 +4698,7 @@ void writeModelToScreen_GL(){
       <<std::setw(nWidth)<<vecdRho[i]
       <<std::setw(nWidth)<<vecdE[i]
       <<std::setw(nWidth)<<vecdP[i]
-      <<std::setw(nWidth)<<dU[i][0][0]<<std::endl;
+      <<std::setw(nWidth)<<dGetVelocity(0,i,0,0)<<std::endl;
   }
   std::cout<<std::setw(3)<<vecdP.size()
     <<std::setw(nWidth)<<vecdM[vecdP.size()]
@@ -4310,7 +4707,7 @@ void writeModelToScreen_GL(){
     <<std::setw(nWidth)<<"-"
     <<std::setw(nWidth)<<"-"
     <<std::setw(nWidth)<<"-"
-    <<std::setw(nWidth)<<dU[vecdP.size()][0][0]<<std::endl;
+    <<std::setw(nWidth)<<dGetVelocity(0,vecdP.size(),0,0)<<std::endl;
 }
 double interpolateU(double dIntVar){
   
@@ -4338,15 +4735,14 @@ double interpolateU(double dIntVar){
 }
 void makeVelocityDist(){
   
-  //RADIAL VELOCITY, U
+  //RADIAL GRID VELOCITY, U0
   
   //allocate space
-  dU=new double**[vecdR.size()];
   dU0=new double[vecdR.size()];
   
   if(sUDistType=="POLY"){
     
-    //set radial velocity
+    //set radial grid velocity
     for(int i=vecdR.size()-1;i>=0;i--){//should go same way as R
       
       //calculate new velocity at new radius
@@ -4359,114 +4755,223 @@ void makeVelocityDist(){
         }
         dVelocity+=vectVelDist[n].dCoeff*pow(dRFrac,vectVelDist[n].dPower);
       }
-      
-      //allocate more memory and assign values
-      dU[i]=new double* [nNumTheta+2*nNumGhostCells];
-      for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-        dU[i][j]=new double[nNumPhi+2*nNumGhostCells];
-        for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-          dU[i][j][k]=dVelocity;
-        }
-      }
       dU0[i]=dVelocity;
     }
-    
-    //set theta velocity
-    dV=new double**[vecdRho.size()];
-    int nInt=1;
-    if(nPeriodic[1]==1){
-      nInt=0;
-    }
-    for(unsigned int i=0;i<vecdRho.size();i++){
-      dV[i]=new double*[nNumTheta+2*nNumGhostCells+nInt];
-      for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells+nInt;j++){
-        dV[i][j]=new double[nNumTheta+2*nNumGhostCells];
-        for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-          dV[i][j][k]=0.0;
-        }
-      }
-    }
-    
-    //set phi velocity
-    dW=new double**[vecdRho.size()];
-    nInt=1;
-    if(nPeriodic[2]==1){
-      nInt=0;
-    }
-    for(unsigned int i=0;i<vecdRho.size();i++){
-      dW[i]=new double*[nNumTheta+2*nNumGhostCells];
-      for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-        dW[i][j]=new double[nNumTheta+2*nNumGhostCells+nInt];
-        for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells+nInt;k++){
-          dW[i][j][k]=0.0;
-        }
-      }
-    }
   }
   else if (sUDistType=="PRO"){
     
-    //set radial velocity
+    //set radial grid velocity
     for(unsigned int i=0;i<vecdR.size()-3;i++){//should go same way as R
-      
       double dIntVar=vecdR[i]/vecdR[0];
-      double dVelocity=dUSurf*interpolateU(dIntVar);
-      
-      //allocate more memory and assign values
-      dU[i]=new double* [nNumTheta+2*nNumGhostCells];
-      for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-        dU[i][j]=new double[nNumPhi+2*nNumGhostCells];
-        for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-          dU[i][j][k]=dVelocity;
-        }
-      }
-      dU0[i]=dVelocity;
+      dU0[i]=dUSurf*interpolateU(dIntVar);
     }
     for(unsigned int i=vecdR.size()-3;i<vecdR.size();i++){//should go same way as R
-      //allocate more memory and assign values
-      dU[i]=new double* [nNumTheta+2*nNumGhostCells];
-      for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-        dU[i][j]=new double[nNumPhi+2*nNumGhostCells];
-        for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-          dU[i][j][k]=0.0;
-        }
-      }
       dU0[i]=0.0;
     }
-    
-    //set theta velocity
-    dV=new double**[vecdRho.size()];
+  }
+  
+  //3D binary models calculate the velocities as they are written out
+  bVelocityArrays=false;
+  if(nNumDims==3&&bBinaryOutput){
+    return;
+  }
+  
+  //RADIAL VELOCITY, U
+  unsigned int nSizeY=nNumTheta+2*nNumGhostCells;
+  unsigned int nSizeZ=nNumPhi+2*nNumGhostCells;
+  dU=new double**[vecdR.size()];
+  for(unsigned int i=0;i<vecdR.size();i++){
+    dU[i]=new double*[nSizeY];
+    dU[i][0]=new double[nSizeY*nSizeZ];
+    for(unsigned int j=1;j<nSizeY;j++){
+      dU[i][j]=dU[i][0]+j*nSizeZ;
+    }
+    setVelocityShell(0,i,nSizeY,nSizeZ,dU[i][0]);
+  }
+  
+  //THETA VELOCITY, V
+  int nInt=1;
+  if(nPeriodic[1]==1){
+    nInt=0;
+  }
+  dV=new double**[vecdRho.size()];
+  for(unsigned int i=0;i<vecdRho.size();i++){
+    dV[i]=new double*[nSizeY+nInt];
+    dV[i][0]=new double[(nSizeY+nInt)*nSizeZ];
+    for(unsigned int j=1;j<nSizeY+nInt;j++){
+      dV[i][j]=dV[i][0]+j*nSizeZ;
+    }
+    setVelocityShell(1,i,nSizeY+nInt,nSizeZ,dV[i][0]);
+  }
+  
+  //PHI VELOCITY, W
+  nInt=1;
+  if(nPeriodic[2]==1){
+    nInt=0;
+  }
+  dW=new double**[vecdRho.size()];
+  for(unsigned int i=0;i<vecdRho.size();i++){
+    dW[i]=new double*[nSizeY];
+    dW[i][0]=new double[nSizeY*(nSizeZ+nInt)];
+    for(unsigned int j=1;j<nSizeY;j++){
+      dW[i][j]=dW[i][0]+j*(nSizeZ+nInt);
+    }
+    setVelocityShell(2,i,nSizeY,nSizeZ+nInt,dW[i][0]);
+  }
+  bVelocityArrays=true;
+}
+double dCalculateVelocity(int nComponent,unsigned int i,unsigned int j,unsigned int k){
+  
+  //unperturbed velocity, only radial
+  double dVelocity=0.0;
+  if(nComponent==0){
+    dVelocity=dU0[i];
+  }
+  if(vecTorusPerturbations.size()==0){
+    return dVelocity;
+  }
+  
+  //set starting theta of model
+  double dRadPerDegree=dPi/180.0;
+  double dStartTheta=(90.0-dDeltaTheta*double((nNumTheta+2*nNumGhostCells)/2))*dPi/180.0;
+  unsigned int nTest=2*int(nNumTheta/2.0);
+  if(nTest!=nNumTheta){//if an uneven number of theta
+    dStartTheta-=dDeltaTheta*dPi/360.0;
+  }
+  
+  //set start of phi's
+  double dStartPhi=(0.0-dDeltaPhi*double((nNumPhi+2*nNumGhostCells)/2))*dPi/180.0;
+  if(2*(nNumPhi/2)!=nNumPhi){
+    dStartPhi-=dDeltaPhi*dPi/360.0;
+  }
+  
+  //get location of the velocity component, u is at zone centers in theta and phi, v at theta
+  //interfaces and w at phi interfaces
+  double dR;
+  double dTheta=(2.0*dStartTheta+(double(2*j+1)*dDeltaTheta*dRadPerDegree))*0.5;
+  double dPhi=(2.0*dStartPhi+double(2*k+1)*dDeltaPhi*dRadPerDegree)*0.5;
+  if(nComponent==0){
+    dR=vecdR[i];
+  }
+  else{
+    dR=(vecdR[i]+vecdR[i+1])*0.5;
     int nInt=1;
-    if(nPeriodic[1]==1){
+    if(nPeriodic[nComponent]==1){
       nInt=0;
     }
-    for(unsigned int i=0;i<vecdRho.size();i++){
-      dV[i]=new double*[nNumTheta+2*nNumGhostCells+nInt];
-      for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells+nInt;j++){
-        dV[i][j]=new double[nNumTheta+2*nNumGhostCells];
-        for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-          dV[i][j][k]=0.0;
-        }
+    if(nComponent==1){
+      dTheta=(dStartTheta+double(j+(1-nInt))*dDeltaTheta*dRadPerDegree);
+    }
+    else{
+      dPhi=dStartPhi+double(k+(1-nInt))*dDeltaPhi*dRadPerDegree;
+    }
+  }
+  
+  //add perturbations
+  for(unsigned int n=0;n<vecTorusPerturbations.size();n++){
+    dVelocity+=dTorusVelocity(vecTorusPerturbations[n],nComponent,dR,dTheta,dPhi);
+  }
+  return dVelocity;
+}
+double dGetVelocity(int nComponent,unsigned int i,unsigned int j,unsigned int k){
+  if(!bVelocityArrays){
+    return dCalculateVelocity(nComponent,i,j,k);
+  }
+  if(nComponent==0){
+    return dU[i][j][k];
+  }
+  else if(nComponent==1){
+    return dV[i][j][k];
+  }
+  return dW[i][j][k];
+}
+void setVelocityShell(int nComponent,unsigned int i,unsigned int nSizeY,unsigned int nSizeZ
+  ,double *dShell){
+  if(bVelocityArrays){//copy rows, they may not be contiguous
+    double ***dVelocity=dU;
+    if(nComponent==1){
+      dVelocity=dV;
+    }
+    else if(nComponent==2){
+      dVelocity=dW;
+    }
+    for(unsigned int j=0;j<nSizeY;j++){
+      std::copy(dVelocity[i][j],dVelocity[i][j]+nSizeZ,dShell+j*nSizeZ);
+    }
+  }
+  else{
+    for(unsigned int j=0;j<nSizeY;j++){
+      for(unsigned int k=0;k<nSizeZ;k++){
+        dShell[j*nSizeZ+k]=dCalculateVelocity(nComponent,i,j,k);
       }
     }
+  }
+}
+void* velocityShellWorker(void *vShells){
+  velocityShells *shells=(velocityShells*)(vShells);
+  size_t nShellSize=size_t(shells->nSizeY)*size_t(shells->nSizeZ);
+  while(true){
     
-    //set phi velocity
-    dW=new double**[vecdRho.size()];
-    nInt=1;
-    if(nPeriodic[2]==1){
-      nInt=0;
+    //get the next shell
+    pthread_mutex_lock(&shells->mutex);
+    if(shells->nNext>=shells->nNumShells){
+      pthread_mutex_unlock(&shells->mutex);
+      break;
     }
-    for(unsigned int i=0;i<vecdRho.size();i++){
-      dW[i]=new double*[nNumTheta+2*nNumGhostCells];
-      for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-        dW[i][j]=new double[nNumTheta+2*nNumGhostCells+nInt];
-        for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells+nInt;k++){
-          dW[i][j][k]=0.0;
-        }
+    unsigned int nShell=shells->nNext;
+    shells->nNext++;
+    pthread_mutex_unlock(&shells->mutex);
+    
+    setVelocityShell(shells->nComponent,shells->nFirst-nShell,shells->nSizeY,shells->nSizeZ
+      ,shells->dBlock+nShell*nShellSize);
+  }
+  return NULL;
+}
+void writeVelocityShells(std::ofstream &ofOut,int nComponent,int nFirst,unsigned int nSizeY
+  ,unsigned int nSizeZ){
+  
+  if(nFirst<0){//no shells to write
+    return;
+  }
+  
+  //keep a few shells per thread in memory
+  size_t nShellSize=size_t(nSizeY)*size_t(nSizeZ);
+  unsigned int nBlockSize=nNumThreads*nVelocityShellsPerThread;
+  if(nBlockSize>(unsigned int)(nFirst+1)){
+    nBlockSize=nFirst+1;
+  }
+  std::vector<double> vecdBlock(nBlockSize*nShellSize);
+  velocityShells shells;
+  shells.nComponent=nComponent;
+  shells.nSizeY=nSizeY;
+  shells.nSizeZ=nSizeZ;
+  shells.dBlock=&vecdBlock[0];
+  pthread_mutex_init(&shells.mutex,NULL);
+  
+  //calculate and write out blocks of shells, starting at the center and working outward
+  for(int nStart=nFirst;nStart>=0;nStart-=nBlockSize){
+    shells.nFirst=nStart;
+    shells.nNumShells=std::min(nBlockSize,(unsigned int)(nStart+1));
+    shells.nNext=0;
+    
+    //this thread also works on the shells, if a thread can't be created fewer are used
+    std::vector<pthread_t> vecThreads;
+    for(unsigned int t=1;t<std::min(nNumThreads,shells.nNumShells);t++){
+      pthread_t threadTemp;
+      if(pthread_create(&threadTemp,NULL,velocityShellWorker,(void*)(&shells))!=0){
+        break;
       }
+      vecThreads.push_back(threadTemp);
     }
+    velocityShellWorker((void*)(&shells));
+    for(unsigned int t=0;t<vecThreads.size();t++){
+      pthread_join(vecThreads[t],NULL);
+    }
+    ofOut.write((char*)(shells.dBlock),shells.nNumShells*nShellSize*sizeof(double));
   }
+  pthread_mutex_destroy(&shells.mutex);
 }
-void pretubeVelocityTorus(XMLNode xPerturb){
+void readTorusPerturbation(XMLNode xPerturb){
   
   if(nNumDims!=3){
     std::stringstream ssTemp;
@@ -4487,331 +4992,124 @@ void pretubeVelocityTorus(XMLNode xPerturb){
   getXMLValue(xPerturb,"phi_cen_off",0,dPhi_torus);
   
   //get inner and outer radii of torus
-  double dCen_torus_radius;
-  getXMLValue(xPerturb,"radius_cen",0,dCen_torus_radius);
-  double dOutter_torus_radius;
-  getXMLValue(xPerturb,"radius_outter",0,dOutter_torus_radius);
+  torusPerturbation torus;
+  getXMLValue(xPerturb,"radius_cen",0,torus.dCenRadius);
+  getXMLValue(xPerturb,"radius_outter",0,torus.dOutterRadius);
   
   //get width of guassian and amplitude of preturbation
   double dWidthGuassian;
   getXMLValue(xPerturb,"width_guassian",0,dWidthGuassian);
-  double dAmplitude;
-  getXMLValue(xPerturb,"amplitude",0,dAmplitude);
-  
-  
-  //PERTURB VELOCITY
-  
-  //set starting theta of model
-  double dStartTheta=(90.0-dDeltaTheta*double((nNumTheta+2*nNumGhostCells)/2))*dPi/180.0;  
-  unsigned int nTest=2*int(nNumTheta/2.0);
-  if(nTest!=nNumTheta){//if an uneven number of theta
-    dStartTheta-=dDeltaTheta*dPi/360.0;
-  }
-  
-  //set start of phi's
-  double dStartPhi=(0.0-dDeltaPhi*double((nNumPhi+2*nNumGhostCells)/2))*dPi/180.0;
-  if(2*(nNumPhi/2)!=nNumPhi){
-    dStartPhi-=dDeltaPhi*dPi/360.0;
-  }
+  getXMLValue(xPerturb,"amplitude",0,torus.dAmplitude);
   
   //set a couple conversion factors
   double dRadPerDegree=dPi/180.0;
   double dHWHMconversion=1.0/sqrt(2.0*log(2.0));
+  torus.dC_sq=pow(dWidthGuassian*dHWHMconversion,2);
   
   //set torus absolute position
   double dR_t=dR_torus;
   double dTheta_t=(90.0)+dTheta_torus;
   double dPhi_t=(0.0)+dPhi_torus;
-  double dX_t=dR_t*sin(dTheta_t*dRadPerDegree)*cos(dPhi_t*dRadPerDegree);
-  double dY_t=dR_t*sin(dTheta_t*dRadPerDegree)*sin(dPhi_t*dRadPerDegree);
-  double dZ_t=dR_t*cos(dTheta_t*dRadPerDegree);
+  torus.dX=dR_t*sin(dTheta_t*dRadPerDegree)*cos(dPhi_t*dRadPerDegree);
+  torus.dY=dR_t*sin(dTheta_t*dRadPerDegree)*sin(dPhi_t*dRadPerDegree);
+  torus.dZ=dR_t*cos(dTheta_t*dRadPerDegree);
   
-  //RADIAL VELOCITY, U
-  for(unsigned int i=0;i<vecdR.size();i++){//should go same way as R
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      double dThetaCenter=(2.0*dStartTheta+(double(2*j+1)*dDeltaTheta*dRadPerDegree))*0.5;
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        double dPhiCenter=(2.0*dStartPhi+double(2*k+1)*dDeltaPhi*dRadPerDegree)*0.5;
-        
-        //get location x,y,z of current velocity component
-        double dX=vecdR[i]*sin(dThetaCenter)*cos(dPhiCenter);
-        double dY=vecdR[i]*sin(dThetaCenter)*sin(dPhiCenter);
-        double dZ=vecdR[i]*cos(dThetaCenter);
-        
-        //get torus angle1
-        double dAngle1=-10.0;
-        if(dY>dY_t&&dZ>dZ_t){//(1)
-          dAngle1=atan( (dZ-dZ_t)/(dY-dY_t) );
-        }
-        else if(dY<dY_t&&dZ>dZ_t){//(2)
-          dAngle1=atan( (dY_t-dY)/(dZ-dZ_t) )+dPi*0.5;
-        }
-        else if(dY<dY_t&&dZ<dZ_t){//(3)
-          dAngle1=atan( (dZ_t-dZ)/(dY_t-dY) )+dPi;
-        }
-        else if(dY>dY_t&&dZ<dZ_t){//(4)
-          dAngle1=atan( (dY-dY_t)/(dZ_t-dZ) )+1.5*dPi;
-        }
-        else if(dY>dY_t&&dZ==dZ_t){//(5)
-          dAngle1=0.0;
-        }
-        else if(dY==dY_t&&dZ>dZ_t){//(6)
-          dAngle1=dPi*0.5;
-        }
-        else if(dY<dY_t&&dZ==dZ_t){//(7)
-          dAngle1=dPi;
-        }
-        else if(dY==dY_t&&dZ<dZ_t){//(8)
-          dAngle1=1.5*dPi;
-        }
-        
-        //get torus angle2
-        double dX_tt=dX_t;
-        double dY_tt=dY_t+dCen_torus_radius*cos(dAngle1);
-        double dZ_tt=dZ_t+dCen_torus_radius*sin(dAngle1);
-        double dB=sqrt( pow( (dY_tt-dY),2) + pow( (dZ_tt-dZ),2));
-        double dR=sqrt( pow( (dY_t-dY),2) + pow( (dZ_t-dZ),2));
-        double dAngle2=-10.0;
-        if(dR>dCen_torus_radius&&dX>dX_tt){//1
-          dAngle2=atan( (dX-dX_tt)/dB );
-        }
-        else if(dR<dCen_torus_radius&&dX>dX_tt){//2
-          dAngle2=atan( dB/(dX-dX_tt) )+dPi*0.5;
-        }
-        else if(dR<dCen_torus_radius&&dX<dX_tt){//3
-          dAngle2=atan( (dX_tt-dX)/dB )+dPi;
-        }
-        else if(dR>dCen_torus_radius&&dX<dX_tt){//4
-          dAngle2=atan( dB/(dX_tt-dX) )+dPi*1.5;
-        }
-        else if(dR>dCen_torus_radius&&dX==dX_tt){//5
-          dAngle2=0.0;
-        }
-        else if(dR==dCen_torus_radius&&dX>dX_tt){//6
-          dAngle2=dPi*0.5;
-        }
-        else if(dR<dCen_torus_radius&&dX==dX_tt){//7
-          dAngle2=dPi;
-        }
-        else if(dR==dCen_torus_radius&&dX<dX_tt){//7
-          dAngle2=dPi*1.5;
-        }
-        
-        //get closest point on surface of torus
-        double dY_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*cos(dAngle1)+dY_t;
-        double dZ_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*sin(dAngle1)+dZ_t;
-        double dX_st=dOutter_torus_radius*sin(dAngle2)+dX_t;
-        
-        //get distance from torus using parametric equation for the torus
-        double dD_sq=pow((dX-dX_st),2)+pow((dY-dY_st),2)+pow((dZ-dZ_st),2);
-        
-        //calculate velocity perturbation from gaussian
-        double dC_sq=pow(dWidthGuassian*dHWHMconversion,2);
-        double dVAmplitude=dAmplitude*exp(-1.0*dD_sq/(2.0*dC_sq));
-        double dTheta_prime=atan(dR/dX);
-        double dBeta=dPi*0.5-dTheta_prime-dAngle2;
-        double dV_r=-1.0*dVAmplitude*sin(dBeta);
-        //double dV_r=-1.0*1e5*sin(dBeta);
-        
-        //preturb the velocity
-        dU[i][j][k]=dU[i][j][k]+dV_r;
-      }
-    }
+  vecTorusPerturbations.push_back(torus);
+}
+double dTorusVelocity(const torusPerturbation &torus,int nComponent,double dRPos,double dTheta
+  ,double dPhi){
+  
+  double dX_t=torus.dX;
+  double dY_t=torus.dY;
+  double dZ_t=torus.dZ;
+  double dCen_torus_radius=torus.dCenRadius;
+  double dOutter_torus_radius=torus.dOutterRadius;
+  
+  //get location x,y,z of velocity component
+  double dX=dRPos*sin(dTheta)*cos(dPhi);
+  double dY=dRPos*sin(dTheta)*sin(dPhi);
+  double dZ=dRPos*cos(dTheta);
+  
+  //get torus angle1
+  double dAngle1=-10.0;
+  if(dY>dY_t&&dZ>dZ_t){//(1)
+    dAngle1=atan( (dZ-dZ_t)/(dY-dY_t) );
   }
-    
-  //THETA VELOCITY, V
-  int nInt=1;
-  if(nPeriodic[1]==1){
-    nInt=0;
+  else if(dY<dY_t&&dZ>dZ_t){//(2)
+    dAngle1=atan( (dY_t-dY)/(dZ-dZ_t) )+dPi*0.5;
   }
-  for(unsigned int i=0;i<vecdRho.size();i++){
-    double dRCen=(vecdR[i]+vecdR[i+1])*0.5;
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells+nInt;j++){
-      double dTheta=(dStartTheta+double(j+(1-nInt))*dDeltaTheta*dRadPerDegree);
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells;k++){
-        double dPhiCenter=(2.0*dStartPhi+double(2*k+1)*dDeltaPhi*dRadPerDegree)*0.5;
-        //get location x,y,z
-        double dX=dRCen*sin(dTheta)*cos(dPhiCenter);
-        double dY=dRCen*sin(dTheta)*sin(dPhiCenter);
-        double dZ=dRCen*cos(dTheta);
-        
-        //get torus angle1
-        double dAngle1=-10.0;
-        if(dY>dY_t&&dZ>dZ_t){//(1)
-          dAngle1=atan( (dZ-dZ_t)/(dY-dY_t) );
-        }
-        else if(dY<dY_t&&dZ>dZ_t){//(2)
-          dAngle1=atan( (dY_t-dY)/(dZ-dZ_t) )+dPi*0.5;
-        }
-        else if(dY<dY_t&&dZ<dZ_t){//(3)
-          dAngle1=atan( (dZ_t-dZ)/(dY_t-dY) )+dPi;
-        }
-        else if(dY>dY_t&&dZ<dZ_t){//(4)
-          dAngle1=atan( (dY-dY_t)/(dZ_t-dZ) )+1.5*dPi;
-        }
-        else if(dY>dY_t&&dZ==dZ_t){//(5)
-          dAngle1=0.0;
-        }
-        else if(dY==dY_t&&dZ>dZ_t){//(6)
-          dAngle1=dPi*0.5;
-        }
-        else if(dY<dY_t&&dZ==dZ_t){//(7)
-          dAngle1=dPi;
-        }
-        else if(dY==dY_t&&dZ<dZ_t){//(8)
-          dAngle1=1.5*dPi;
-        }
-        
-        //get torus angle2
-        double dX_tt=dX_t;
-        double dY_tt=dY_t+dCen_torus_radius*cos(dAngle1);
-        double dZ_tt=dZ_t+dCen_torus_radius*sin(dAngle1);
-        double dB=sqrt( pow( (dY_tt-dY),2) + pow( (dZ_tt-dZ),2));
-        double dR=sqrt( pow( (dY_t-dY),2) + pow( (dZ_t-dZ),2));
-        double dAngle2=-10.0;
-        if(dR>dCen_torus_radius&&dX>dX_tt){//1
-          dAngle2=atan( (dX-dX_tt)/dB );
-        }
-        else if(dR<dCen_torus_radius&&dX>dX_tt){//2
-          dAngle2=atan( dB/(dX-dX_tt) )+dPi*0.5;
-        }
-        else if(dR<dCen_torus_radius&&dX<dX_tt){//3
-          dAngle2=atan( (dX_tt-dX)/dB )+dPi;
-        }
-        else if(dR>dCen_torus_radius&&dX<dX_tt){//4
-          dAngle2=atan( dB/(dX_tt-dX) )+dPi*1.5;
-        }
-        else if(dR>dCen_torus_radius&&dX==dX_tt){//5
-          dAngle2=0.0;
-        }
-        else if(dR==dCen_torus_radius&&dX>dX_tt){//6
-          dAngle2=dPi*0.5;
-        }
-        else if(dR<dCen_torus_radius&&dX==dX_tt){//7
-          dAngle2=dPi;
-        }
-        else if(dR==dCen_torus_radius&&dX<dX_tt){//7
-          dAngle2=dPi*1.5;
-        }
-        
-        //get closest point on surface of torus
-        double dY_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*cos(dAngle1)+dY_t;
-        double dZ_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*sin(dAngle1)+dZ_t;
-        double dX_st=dOutter_torus_radius*sin(dAngle2)+dX_t;
-        
-        //get distance from torus using parametric equation for the torus
-        double dD_sq=pow((dX-dX_st),2)+pow((dY-dY_st),2)+pow((dZ-dZ_st),2);
-        
-        //calculate velocity perturbation from gaussian
-        double dC_sq=pow(dWidthGuassian*dHWHMconversion,2);
-        double dVAmplitude=dAmplitude*exp(-1.0*dD_sq/(2.0*dC_sq));
-        double dTheta_prime=atan(dR/dX);
-        double dBeta=dPi*0.5-dTheta_prime-dAngle2;
-        double dV_theta=-1.0*dVAmplitude*cos(dBeta)*sin(dAngle1);
-        
-        //preturb the velocity
-        dV[i][j][k]+=dV_theta;
-      }
-    }
+  else if(dY<dY_t&&dZ<dZ_t){//(3)
+    dAngle1=atan( (dZ_t-dZ)/(dY_t-dY) )+dPi;
   }
-    
-  //PHI VELOCITY, W
-  nInt=1;
-  if(nPeriodic[2]==1){
-    nInt=0;
+  else if(dY>dY_t&&dZ<dZ_t){//(4)
+    dAngle1=atan( (dY-dY_t)/(dZ_t-dZ) )+1.5*dPi;
   }
-  for(unsigned int i=0;i<vecdRho.size();i++){
-    double dRCen=(vecdR[i]+vecdR[i+1])*0.5;
-    for(unsigned int j=0;j<nNumTheta+2*nNumGhostCells;j++){
-      double dThetaCenter=(2.0*dStartTheta+(double(2*j+1)*dDeltaTheta*dRadPerDegree))*0.5;
-      for(unsigned int k=0;k<nNumPhi+2*nNumGhostCells+nInt;k++){
-       double dPhi=dStartPhi+double(k+(1-nInt))*dDeltaPhi*dRadPerDegree;
-        
-        //get location x,y,z
-        double dX=dRCen*sin(dThetaCenter)*cos(dPhi);
-        double dY=dRCen*sin(dThetaCenter)*sin(dPhi);
-        double dZ=dRCen*cos(dThetaCenter);
-        
-        //get torus angle1
-        double dAngle1=-10.0;
-        if(dY>dY_t&&dZ>dZ_t){//(1)
-          dAngle1=atan( (dZ-dZ_t)/(dY-dY_t) );
-        }
-        else if(dY<dY_t&&dZ>dZ_t){//(2)
-          dAngle1=atan( (dY_t-dY)/(dZ-dZ_t) )+dPi*0.5;
-        }
-        else if(dY<dY_t&&dZ<dZ_t){//(3)
-          dAngle1=atan( (dZ_t-dZ)/(dY_t-dY) )+dPi;
-        }
-        else if(dY>dY_t&&dZ<dZ_t){//(4)
-          dAngle1=atan( (dY-dY_t)/(dZ_t-dZ) )+1.5*dPi;
-        }
-        else if(dY>dY_t&&dZ==dZ_t){//(5)
-          dAngle1=0.0;
-        }
-        else if(dY==dY_t&&dZ>dZ_t){//(6)
-          dAngle1=dPi*0.5;
-        }
-        else if(dY<dY_t&&dZ==dZ_t){//(7)
-          dAngle1=dPi;
-        }
-        else if(dY==dY_t&&dZ<dZ_t){//(8)
-          dAngle1=1.5*dPi;
-        }
-        
-        //get torus angle2
-        double dX_tt=dX_t;
-        double dY_tt=dY_t+dCen_torus_radius*cos(dAngle1);
-        double dZ_tt=dZ_t+dCen_torus_radius*sin(dAngle1);
-        double dB=sqrt( pow( (dY_tt-dY),2) + pow( (dZ_tt-dZ),2));
-        double dR=sqrt( pow( (dY_t-dY),2) + pow( (dZ_t-dZ),2));
-        double dAngle2=-10.0;
-        if(dR>dCen_torus_radius&&dX>dX_tt){//1
-          dAngle2=atan( (dX-dX_tt)/dB );
-        }
-        else if(dR<dCen_torus_radius&&dX>dX_tt){//2
-          dAngle2=atan( dB/(dX-dX_tt) )+dPi*0.5;
-        }
-        else if(dR<dCen_torus_radius&&dX<dX_tt){//3
-          dAngle2=atan( (dX_tt-dX)/dB )+dPi;
-        }
-        else if(dR>dCen_torus_radius&&dX<dX_tt){//4
-          dAngle2=atan( dB/(dX_tt-dX) )+dPi*1.5;
-        }
-        else if(dR>dCen_torus_radius&&dX==dX_tt){//5
-          dAngle2=0.0;
-        }
-        else if(dR==dCen_torus_radius&&dX>dX_tt){//6
-          dAngle2=dPi*0.5;
-        }
-        else if(dR<dCen_torus_radius&&dX==dX_tt){//7
-          dAngle2=dPi;
-        }
-        else if(dR==dCen_torus_radius&&dX<dX_tt){//7
-          dAngle2=dPi*1.5;
-        }
-        
-        //get closest point on surface of torus
-        double dY_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*cos(dAngle1)+dY_t;
-        double dZ_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*sin(dAngle1)+dZ_t;
-        double dX_st=dOutter_torus_radius*sin(dAngle2)+dX_t;
-        
-        //get distance from torus using parametric equation for the torus
-        double dD_sq=pow((dX-dX_st),2)+pow((dY-dY_st),2)+pow((dZ-dZ_st),2);
-        
-        //calculate velocity perturbation from gaussian
-        double dC_sq=pow(dWidthGuassian*dHWHMconversion,2);
-        double dVAmplitude=dAmplitude*exp(-1.0*dD_sq/(2.0*dC_sq));
-        double dTheta_prime=atan(dR/dX);
-        double dBeta=dPi*0.5-dTheta_prime-dAngle2;
-        double dV_phi=dVAmplitude*cos(dBeta)*cos(dAngle1);
-        
-        //preturb the velocity
-        dW[i][j][k]+=dV_phi;
-        
-      }
-    }
+  else if(dY>dY_t&&dZ==dZ_t){//(5)
+    dAngle1=0.0;
+  }
+  else if(dY==dY_t&&dZ>dZ_t){//(6)
+    dAngle1=dPi*0.5;
+  }
+  else if(dY<dY_t&&dZ==dZ_t){//(7)
+    dAngle1=dPi;
+  }
+  else if(dY==dY_t&&dZ<dZ_t){//(8)
+    dAngle1=1.5*dPi;
+  }
+  
+  //get torus angle2
+  double dX_tt=dX_t;
+  double dY_tt=dY_t+dCen_torus_radius*cos(dAngle1);
+  double dZ_tt=dZ_t+dCen_torus_radius*sin(dAngle1);
+  double dB=sqrt( pow( (dY_tt-dY),2) + pow( (dZ_tt-dZ),2));
+  double dR=sqrt( pow( (dY_t-dY),2) + pow( (dZ_t-dZ),2));
+  double dAngle2=-10.0;
+  if(dR>dCen_torus_radius&&dX>dX_tt){//1
+    dAngle2=atan( (dX-dX_tt)/dB );
+  }
+  else if(dR<dCen_torus_radius&&dX>dX_tt){//2
+    dAngle2=atan( dB/(dX-dX_tt) )+dPi*0.5;
   }
+  else if(dR<dCen_torus_radius&&dX<dX_tt){//3
+    dAngle2=atan( (dX_tt-dX)/dB )+dPi;
+  }
+  else if(dR>dCen_torus_radius&&dX<dX_tt){//4
+    dAngle2=atan( dB/(dX_tt-dX) )+dPi*1.5;
+  }
+  else if(dR>dCen_torus_radius&&dX==dX_tt){//5
+    dAngle2=0.0;
+  }
+  else if(dR==dCen_torus_radius&&dX>dX_tt){//6
+    dAngle2=dPi*0.5;
+  }
+  else if(dR<dCen_torus_radius&&dX==dX_tt){//7
+    dAngle2=dPi;
+  }
+  else if(dR==dCen_torus_radius&&dX<dX_tt){//7
+    dAngle2=dPi*1.5;
+  }
+  
+  //get closest point on surface of torus
+  double dY_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*cos(dAngle1)+dY_t;
+  double dZ_st=(dCen_torus_radius+dOutter_torus_radius*cos(dAngle2))*sin(dAngle1)+dZ_t;
+  double dX_st=dOutter_torus_radius*sin(dAngle2)+dX_t;
+  
+  //get distance from torus using parametric equation for the torus
+  double dD_sq=pow((dX-dX_st),2)+pow((dY-dY_st),2)+pow((dZ-dZ_st),2);
+  
+  //calculate velocity perturbation from gaussian
+  double dC_sq=torus.dC_sq;
+  double dVAmplitude=torus.dAmplitude*exp(-1.0*dD_sq/(2.0*dC_sq));
+  double dTheta_prime=atan(dR/dX);
+  double dBeta=dPi*0.5-dTheta_prime-dAngle2;
+  
+  if(nComponent==0){
+    return -1.0*dVAmplitude*sin(dBeta);
+  }
+  else if(nComponent==1){
+    return -1.0*dVAmplitude*cos(dBeta)*sin(dAngle1);
+  }
+  return dVAmplitude*cos(dBeta)*cos(dAngle1);
 }
 void makeVelocityDist_SEDOV(){
   
@@ -4898,32 +5196,48 @@ void makeVelocityDist_SEDOV(){
       }
     }
   }
+  bVelocityArrays=true;
 }
-double dMomentumCons(double dT, double dRho,int nShell){
+void getConsAndJacobian_TEOS(double dT,double dRho,unsigned int nShell,double &dMomentum
+  ,double &dEnergy,double dJacobian[2][2]){
+  
+  //pressure, opacity and their derivatives from a single equation of state lookup
+  double dP_nShell;
+  double dKappa_nShell;
+  double dDlnPDlnT;
+  double dDlnPDlnRho;
+  double dDlnKappaDlnT;
+  double dDlnKappaDlnRho;
+  eosTable.getPKappaAndDerivs(dT,dRho,dP_nShell,dKappa_nShell,dDlnPDlnT,dDlnPDlnRho
+    ,dDlnKappaDlnT,dDlnKappaDlnRho);
+  double dMDelSum=(vecdMDel[nShell]+vecdMDel[nShell-1])*0.5;
+  
+  //momentum conservation
   double dP_nShellm1=vecdP[nShell-1];
-  double dP_nShell  =eosTable.dGetPressure(dT,dRho);
   double dGravTerm=dG*vecdM[nShell]/(4.0*dPi*pow(vecdR[nShell],4));
   double dPressureTerm=(dP_nShell-dP_nShellm1)/(vecdMDel[nShell]+vecdMDel[nShell-1])*2.0;
-  return dGravTerm+dPressureTerm;
-}
-double dEnergyCons(double dT, double dRho,int nShell){
+  dMomentum=dGravTerm+dPressureTerm;
+  dJacobian[0][0]=dP_nShell*dDlnPDlnT/dT/dMDelSum;
+  dJacobian[0][1]=dP_nShell*dDlnPDlnRho/dRho/dMDelSum;
+  
+  //energy conservation
   double dKappa_nShellm1=vecdKappa[nShell-1];
-  double dKappa_nShell=eosTable.dGetOpacity(dT,dRho);
   double dT_nShellP4=pow(dT,4);
   double dT_nShellm1P4=pow(vecdT[nShell-1],4);
   double dKappa_nShellm1half=(dT_nShellP4/dKappa_nShell+dT_nShellm1P4/dKappa_nShellm1)
     /(dT_nShellP4+dT_nShellm1P4);
-  double dFluxTerm=-64.0*dPi*dPi*dSigma*pow(vecdR[nShell],4)/3.0*dKappa_nShellm1half
-    *(dT_nShellP4-dT_nShellm1P4)/(vecdMDel[nShell]+vecdMDel[nShell-1])*2.0;
-  return dFluxTerm/dLSun-dL;
-}
-double dPartialDerivativeVar1(double dVar1, double dVar2,int nShell,
-  double (*dFunction)(double dVar1, double dVar2, int nShell),double dH, double &dError){
-  return (dFunction(dVar1+dH,dVar2,nShell)-dFunction(dVar1-dH,dVar2,nShell))/(2.0*dH);
-}
-double dPartialDerivativeVar2(double dVar1, double dVar2,int nShell,
-  double (*dFunction)(double dVar1, double dVar2, int nShell),double dH, double &dError){
-  return (dFunction(dVar1,dVar2+dH,nShell)-dFunction(dVar1,dVar2-dH,nShell))/(2.0*dH);
+  double dFluxCoeff=-64.0*dPi*dPi*dSigma*pow(vecdR[nShell],4)/3.0/dMDelSum/dLSun;
+  dEnergy=dFluxCoeff*dKappa_nShellm1half*(dT_nShellP4-dT_nShellm1P4)-dL;
+  
+  //derivatives of T^4/kappa and of the averaged inverse opacity
+  double dDTP4DT=4.0*dT_nShellP4/dT;
+  double dDTP4KappaDT=dT_nShellP4/dKappa_nShell*(4.0-dDlnKappaDlnT)/dT;
+  double dDTP4KappaDRho=-1.0*dT_nShellP4/dKappa_nShell*dDlnKappaDlnRho/dRho;
+  double dDKappaDT=(dDTP4KappaDT-dKappa_nShellm1half*dDTP4DT)/(dT_nShellP4+dT_nShellm1P4);
+  double dDKappaDRho=dDTP4KappaDRho/(dT_nShellP4+dT_nShellm1P4);
+  dJacobian[1][0]=dFluxCoeff*(dDKappaDT*(dT_nShellP4-dT_nShellm1P4)
+    +dKappa_nShellm1half*dDTP4DT);
+  dJacobian[1][1]=dFluxCoeff*dDKappaDRho*(dT_nShellP4-dT_nShellm1P4);
 }
 void readEnergyProfile_GL(std::string sProfileFileName){
   
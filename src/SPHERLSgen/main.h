@@ -8,6 +8,9 @@
 */
 
 #include <vector>
+#include <map>
+#include <fstream>
+#include <pthread.h>
 #include "eos.h"
 
 //variables
@@ -163,6 +166,11 @@ unsigned int nPeriodic[3]={0,0,0};/**<
   "<x0>", "<x1>" and "<x2>" for the three directions, where x0 is the radial direciton, x1 is the
   theta direction, and x2 is the phi direction.
   */
+unsigned int nNumThreads=1;/**<
+  Number of threads used to calculate the velocities of 3D models while they are written to a 
+  binary file. It is set in the configuration file under the "<output>" node with the 
+  "<num-threads>" tag, and defaults to the number of online processors.
+  */
 double dTimeStepFactor=1.0;/**<
   Fraction to multiply the courant timestep by when calculating the
   time step. This value should be the same at that used when following the hydrodynamics of the 
@@ -216,6 +224,67 @@ double*** dW;/**<
   Holds the phi velocity, assumed to be zero and are centered on
   phi interfaces.
   */
+bool bVelocityArrays=false;/**<
+  If true the velocities are stored in \ref dU, \ref dV and \ref dW. If false they are not
+  allocated and are calculated shell by shell from \ref dU0 and \ref vecTorusPerturbations as they
+  are written out, which is done for 3D models written to binary files.
+  */
+struct torusPerturbation{
+  double dX;/**< x position of the center of the torus [cm]
+    */
+  double dY;/**< y position of the center of the torus [cm]
+    */
+  double dZ;/**< z position of the center of the torus [cm]
+    */
+  double dCenRadius;/**< Radius of the center of the ring of the torus [cm]
+    */
+  double dOutterRadius;/**< Radius of the ring of the torus [cm]
+    */
+  double dC_sq;/**< Square of the width of the guassian the velocity falls off with [cm^2]
+    */
+  double dAmplitude;/**< Amplitude of the velocity perturbation [cm/s]
+    */
+};/**@struct torusPerturbation
+  Structured variable holding the position, size and amplitude of a torus shaped velocity
+  perturbation, read from a "<perturb>" node of type "torus".
+  \see vecTorusPerturbations
+  */
+std::vector<torusPerturbation> vecTorusPerturbations;/**<
+  Holds the torus velocity perturbations which are added to the velocities of the model.
+  \see torusPerturbation
+  */
+struct velocityShells{
+  int nComponent;/**<
+    Velocity component of the shells, 0 for u, 1 for v and 2 for w
+    */
+  int nFirst;/**<
+    Radial index of the first shell in the block, the shells are in order of decreasing radial 
+    index, the order they are written out in
+    */
+  unsigned int nNumShells;/**<
+    Number of shells in the block
+    */
+  unsigned int nSizeY;/**<
+    Size of a shell in the theta-direction, including ghost cells
+    */
+  unsigned int nSizeZ;/**<
+    Size of a shell in the phi-direction, including ghost cells
+    */
+  double *dBlock;/**<
+    Values of the shells, one after the other, each shell stored row by row
+    */
+  unsigned int nNext;/**<
+    Next shell in the block to be calculated
+    */
+  pthread_mutex_t mutex;/**<
+    Protects \ref nNext
+    */
+};/**@struct velocityShells
+  A block of consecutive velocity shells shared by the threads of \ref writeVelocityShells.
+  */
+const unsigned int nVelocityShellsPerThread=2;/**<
+  Number of velocity shells kept in memory for each thread while writing out a 3D model.
+  */
 struct term{
   double dCoeff;/**< Coeffeicent of the term in the polynomial.
     */
@@ -237,11 +306,60 @@ struct MDeltaDelta{
   double dStopValue;
 };
 std::vector<MDeltaDelta> vecMDeltaDeltaList;
+const double dLineSearchAlpha=1.0e-4;/**<
+  Fraction of the decrease in the scaled residuals predicted by a Newton step which must be
+  achieved for the step to be accepted by \ref calculateShell_TEOS.
+  */
+const double dMinLineSearchStep=1.0e-10;/**<
+  Smallest fraction of a Newton step tried by \ref calculateShell_TEOS, the step is taken even if
+  the residuals do not decrease enough.
+  */
 eos eosTable;/**<
   It is of type eos and holds the equation of state and opacity information and 
   functions used to provide a tabulated equation of state.
   \see SPHERLS reference manual for a more in depth description of the eos class.
   */
+std::map<std::string,eos*> mapEOSTables;/**<
+  Equation of state tables which have been read in, by file name, so that each is read only once
+  when generating many models.
+  */
+struct convergenceStats{
+  unsigned int nNumShells;/**<
+    Number of radial shells in the model.
+    */
+  unsigned int nNumIterations;/**<
+    Total number of iterations used to calculate the shells of the model.
+    */
+  unsigned int nMaxIterations;/**<
+    Largest number of iterations used to calculate a single shell.
+    */
+  unsigned int nNumUnconverged;/**<
+    Number of shells which did not converge within \ref nNumIters iterations.
+    */
+};/**@struct convergenceStats
+  Convergence statistics of a generated model, reported in the summary of a survey.
+  \see runSurvey
+  */
+convergenceStats statsConvergence;/**<
+  Convergence statistics of the model being generated.
+  */
+struct surveyModel{
+  std::vector<std::string> vecsNames;/**<
+    Tag names of the parameters set for this model.
+    */
+  std::vector<std::string> vecsValues;/**<
+    Values of the parameters set for this model.
+    */
+  std::string sFileName;/**<
+    Name of the file the model is written to.
+    */
+};/**@struct surveyModel
+  Parameters of one model of a survey, which replace the values of the matching nodes of the
+  template model.
+  */
+bool bSurveyWorker=false;/**<
+  True in the worker processes generating the models of a survey.
+  */
 bool bGammaLawEOS=true;/**<
   if true will cause model to be generated using a gamma law gas
   */
@@ -287,6 +405,48 @@ void readConfig(std::string sConfigFileName,std::string sStartNode);/**<
   @param [in] sConfigFileName filename and path to configuration file. Often "SPHERLSgen.xml"
   @param [in] sStartNode name of the starting node in the configuration file. Often "data"
   */
+void makeModel(XMLNode xModel,int nCount);/**<
+  Generates the model described by the model node \c xModel and writes it out.
+  
+  @param [in] xModel model node of the configuration file
+  @param [in] nCount index of the model, used in error messages
+  */
+eos& getEOSTable(std::string sFileName);/**<
+  Returns the equation of state table \c sFileName, reading it in only the first time it is asked
+  for.
+  */
+std::string sEOSTablePath(std::string sEOSFileName);/**<
+  Returns the path of the equation of state table \c sEOSFileName. Names which do not start with
+  "/" or "./" are relative to \ref sExeDir.
+  */
+void runSurvey(XMLNode xSurvey);/**<
+  Generates the models of the survey node \c xSurvey. Each model is a copy of the template model
+  node of the survey with the values of the nodes named by the parameters of the model replaced.
+  Models are generated in parallel by forked worker processes, which write the output of the model
+  to "<fileName>.log". Equation of state tables are read in once before the workers are started and
+  are shared by them. A summary of the convergence of each model is written to the summary file.
+  
+  @param [in] xSurvey survey node of the configuration file
+  */
+void readSurveyGrid(XMLNode xGrid,std::vector<surveyModel> &vecModels);/**<
+  Adds a model to \c vecModels for every combination of the whitespace separated values of the
+  children of the grid node \c xGrid. The values of the last child vary fastest.
+  */
+void readSurveySet(XMLNode xSet,std::vector<surveyModel> &vecModels);/**<
+  Adds a single model to \c vecModels with the values of the children of the set node \c xSet.
+  */
+int nCountXMLNodes(XMLNode xParent,std::string sName);/**<
+  Returns the number of nodes named \c sName under \c xParent, at any depth.
+  */
+int nSetXMLValues(XMLNode xParent,std::string sName,std::string sValue);/**<
+  Sets the text of all nodes named \c sName under \c xParent, at any depth, to \c sValue and
+  returns the number of nodes changed.
+  */
+void surveyWorker(XMLNode xModel,const surveyModel &modelSurvey,int nModel,int nPipe);/**<
+  Generates model \c nModel of a survey in a forked worker process from the template \c xModel,
+  writes its \ref convergenceStats to \c nPipe and exits. The exit status is 0 if the model was
+  generated and 1 otherwise.
+  */
 void readUProfile(std::string sProfileFileName);/**<
   This function reads in the radial velocity profile. The radial velocities are stored in \ref dUPro
   , the radii of those points are stored in \ref dUProR, and the size of these arrays is given by
@@ -324,7 +484,11 @@ void calculateShell_SEDOV(int nShell);/**<
   
   */
 void calculateShell_TEOS(unsigned int nShell);/**<
-  
+  Calculates the temperature and density of shell \c nShell by solving the static momentum and
+  energy conservation equations with Newton's method, using the analytic derivatives from
+  \ref getConsAndJacobian_TEOS. Each Newton step is backtracked until the scaled residuals
+  decrease, which keeps the step within the equation of state table and the temperature and
+  density positive. The remaining quantities of the shell are then calculated from them.
   */
 void calculateFirstShell_SEDOV();/**<
   Calcualtes the first shell of a spherical blast wave model, or in otherwords a sedov test model.
@@ -367,29 +531,19 @@ void calculateFirstShell_TEOS();/**<
       of the zone at the mass of the shell.</li>
   </ol>
   */
-double dPartialDerivativeVar1(double dVar1, double dVar2,int nShell
-  ,double (*dFunction)(double dVar1, double dVar2, int nShell),double dH, double &dError);/**<
-  Computes the partial deriavative of a function of two variables with respect to the first
-  variable.
-  
-  @param[in] dVar1 location at which derivative should be evaluted, and also the variable that the
-  partial derivative is take with respect to.
-  @param[in] dVar2 locaiton at which derivative should be evaluated.
-  @param[in] dFunction pointer to the double precision function of two variables, dVar1 and dVar2.
-  
-  @return returns the partial derivative with respect to dVar1 of the given function
-  */
-double dPartialDerivativeVar2(double dVar1, double dVar2,int nShell
-  ,double (*dFunction)(double dVar1, double dVar2, int nShell),double dH, double &dError);/**<
-  Computes the partial deriavative of a function of two variables with respect to the second
-  variable.
-  
-  @param[in] dVar1 location at which derivative should be evaluted, and also the variable that the
-  partial derivative is take with respect to.
-  @param[in] dVar2 locaiton at which derivative should be evaluated.
-  @param[in] dFunction pointer to the double precision function of two variables, dVar1 and dVar2.
+void getConsAndJacobian_TEOS(double dT,double dRho,unsigned int nShell,double &dMomentum
+  ,double &dEnergy,double dJacobian[2][2]);/**<
+  Calculates the residuals of the static momentum and energy conservation equations for shell
+  \c nShell at temperature \c dT and density \c dRho, and their analytic derivatives. The pressure,
+  opacity and their derivatives come from a single equation of state lookup.
   
-  @return returns the partial derivative with respect to dVar1 of the given function
+  @param[in] dT temperature of the shell.
+  @param[in] dRho density of the shell.
+  @param[in] nShell shell whose temperature and density are being solved for.
+  @param[out] dMomentum residual of the momentum equation.
+  @param[out] dEnergy residual of the energy equation, in solar luminosities.
+  @param[out] dJacobian derivatives of the residuals, row 0 is the momentum equation and row 1 the
+  energy equation, column 0 is the derivative w.r.t. temperature and column 1 w.r.t. density.
   */
 void writeModel_R_TEOS();/**<
   Writes out the model generated using a tabulated equation of state in 1D to an ascii file.
@@ -432,13 +586,37 @@ void writeModel_Bin_RTP_TEOS();/**<
   \ref sOutPutfile
   */
 void makeVelocityDist();/**<
+  Sets the radial grid velocity \ref dU0 from the velocity distribution, and the velocities
+  \ref dU, \ref dV, and \ref dW, including the perturbations in \ref vecTorusPerturbations. The
+  velocity arrays are not allocated for 3D models written to binary files, in that case the
+  velocities are calculated as they are written out.
+  */
+double dCalculateVelocity(int nComponent,unsigned int i,unsigned int j,unsigned int k);/**<
+  Calculates the velocity component \c nComponent (0 for u, 1 for v and 2 for w) at grid
+  position \c i, \c j, \c k from \ref dU0 and the perturbations in \ref vecTorusPerturbations.
+  */
+double dGetVelocity(int nComponent,unsigned int i,unsigned int j,unsigned int k);/**<
+  Returns the velocity component \c nComponent at grid position \c i, \c j, \c k, from the
+  velocity arrays if they are allocated, otherwise it is calculated with 
+  \ref dCalculateVelocity.
+  */
+void setVelocityShell(int nComponent,unsigned int i,unsigned int nSizeY,unsigned int nSizeZ
+  ,double *dShell);/**<
+  Sets \c dShell to the values of velocity component \c nComponent in the radial shell \c i,
+  with \c nSizeY rows of \c nSizeZ values.
+  */
+void* velocityShellWorker(void *vShells);/**<
+  Thread function, calculates shells of the \ref velocityShells block \c vShells until there are
+  none left.
+  */
+void writeVelocityShells(std::ofstream &ofOut,int nComponent,int nFirst,unsigned int nSizeY
+  ,unsigned int nSizeZ);/**<
+  Writes out the shells of velocity component \c nComponent from radial index \c nFirst down to 0
+  to \c ofOut. The shells are calculated in blocks by \ref nNumThreads threads, and each block
+  is written out with a single write.
   */
 double dTimeStep_TEOS();/**<
   */
-double dMomentumCons(double dT,double dRho,int nShell);/**<
-  */
-double dEnergyCons(double dT,double dRho,int nShell);/**<
-  */
 void writeModel_R_GL();/**<
   Writes out the model generated using a gamma law gas in 1D in radius to an ascii file.
     
@@ -513,6 +691,13 @@ int main();/**<
   Main driving funciton for SPHERLSgen
   */
 void makeVelocityDist_SEDOV();
-void pretubeVelocityTorus(XMLNode xPerturb);
+void readTorusPerturbation(XMLNode xPerturb);/**<
+  Reads the torus perturbation in \c xPerturb and adds it to \ref vecTorusPerturbations.
+  */
+double dTorusVelocity(const torusPerturbation &torus,int nComponent,double dRPos,double dTheta
+  ,double dPhi);/**<
+  Returns the velocity component \c nComponent (0 for radial, 1 for theta and 2 for phi) of the
+  torus perturbation \c torus at radius \c dRPos, and angles \c dTheta and \c dPhi [rad].
+  */
 void setExeDir();
 #endif
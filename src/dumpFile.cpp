@@ -0,0 +1,328 @@
+/** @file
+
+  Implements the dumpFile class defined in \ref dumpFile.h
+*/
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "dumpFile.h"
+#include "exception2.h"
+
+static void readHeader(dumpFile &dump,const char *cMap,size_t nMapSize,size_t &nPos,void *vValue
+  ,size_t nSize){//copies the next nSize bytes of the header into vValue
+  if(nPos+nSize>nMapSize){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": reached end of file \""
+      <<dump.sFileName<<"\" while reading the header\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  memcpy(vValue,cMap+nPos,nSize);
+  nPos+=nSize;
+}
+dumpFile::dumpFile(){
+  nFile=-1;
+  cMap=NULL;
+  nMapSize=0;
+  nNumVars=0;
+  nVariableInfo=NULL;
+  nVarInfo=NULL;
+  nSize=NULL;
+  nSizeX1=NULL;
+  nSizeX2=NULL;
+  nSizeY=NULL;
+  nSizeZ=NULL;
+  nVarOffset=NULL;
+  dVariables=NULL;
+  bCopied=NULL;
+  dGrid=NULL;
+}
+dumpFile::~dumpFile(){
+  close();
+}
+void dumpFile::open(std::string sFileNameIn,int nVersionSupported)throw(exception2){
+
+  close();
+  sFileName=sFileNameIn;
+
+  //map the file
+  nFile=::open(sFileName.c_str(),O_RDONLY);
+  if(nFile<0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" didn't open properly\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  struct stat statFile;
+  if(fstat(nFile,&statFile)!=0||statFile.st_size==0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" is empty or its size could not be found\n";
+    ::close(nFile);
+    nFile=-1;
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  nMapSize=size_t(statFile.st_size);
+
+  /*map it privately with write access so changes made by callers to the grid stay in memory and
+  are never written to the file*/
+  void *vMap=mmap(NULL,nMapSize,PROT_READ|PROT_WRITE,MAP_PRIVATE,nFile,0);
+  if(vMap==MAP_FAILED){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" could not be mapped into memory\n";
+    ::close(nFile);
+    nFile=-1;
+    nMapSize=0;
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  cMap=(char*)vMap;
+
+  //check that it is a binary file
+  size_t nPos=0;
+  char cTemp;
+  readHeader(*this,cMap,nMapSize,nPos,&cTemp,sizeof(char));
+  if(cTemp!='b'){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" isn't a binary file.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //check that it is the correct version
+  readHeader(*this,cMap,nMapSize,nPos,&nVersion,sizeof(int));
+  if(nVersion!=nVersionSupported){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" version \""<<nVersion
+      <<"\" isn't the supported version \""<<nVersionSupported<<"\".\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+
+  //read in time and time steps
+  readHeader(*this,cMap,nMapSize,nPos,&dTime,sizeof(double));
+  readHeader(*this,cMap,nMapSize,nPos,&nTimeStepIndex,sizeof(int));
+  readHeader(*this,cMap,nMapSize,nPos,&dDeltat_nm1half,sizeof(double));
+  readHeader(*this,cMap,nMapSize,nPos,&dDeltat_np1half,sizeof(double));
+  readHeader(*this,cMap,nMapSize,nPos,&dAlpha,sizeof(double));
+
+  //read in equation of state, a length of zero means a gamma law gas
+  int nGammaLaw;
+  readHeader(*this,cMap,nMapSize,nPos,&nGammaLaw,sizeof(int));
+  dGamma=0.0;
+  sEOSFileName="";
+  bGammaLaw=(nGammaLaw==0);
+  if(bGammaLaw){
+    readHeader(*this,cMap,nMapSize,nPos,&dGamma,sizeof(double));
+  }
+  else{
+    if(nGammaLaw<0||nPos+size_t(nGammaLaw)>nMapSize){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+        <<sFileName<<"\" has an invalid equation of state file name length "<<nGammaLaw<<"\n";
+      throw exception2(ssTemp.str(),INPUT);
+    }
+    sEOSFileName=std::string(cMap+nPos,size_t(nGammaLaw));
+    nPos+=size_t(nGammaLaw);
+  }
+
+  //read in artificial viscosity
+  readHeader(*this,cMap,nMapSize,nPos,&dA,sizeof(double));
+  readHeader(*this,cMap,nMapSize,nPos,&dAVThreshold,sizeof(double));
+
+  //read in grid description
+  readHeader(*this,cMap,nMapSize,nPos,nGlobalGridDims,3*sizeof(int));
+  readHeader(*this,cMap,nMapSize,nPos,nPeriodic,3*sizeof(int));
+  readHeader(*this,cMap,nMapSize,nPos,&nNum1DZones,sizeof(int));
+  readHeader(*this,cMap,nMapSize,nPos,&nNumGhostCells,sizeof(int));
+  int nNumVarsFile;
+  readHeader(*this,cMap,nMapSize,nPos,&nNumVarsFile,sizeof(int));
+  if(nNumVarsFile<0||nPos+size_t(nNumVarsFile)*4*sizeof(int)>nMapSize){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" has an invalid number of variables "<<nNumVarsFile<<"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  nNumVars=nNumVarsFile;
+  nVariableInfo=new int[4*nNumVars];
+  readHeader(*this,cMap,nMapSize,nPos,nVariableInfo,4*nNumVars*sizeof(int));
+
+  //figure out number of dimensions
+  nNumDims=0;
+  for(int l=0;l<3;l++){
+    if(nGlobalGridDims[l]>1){
+      nNumDims++;
+    }
+  }
+
+  //set the layout of each variable
+  nVarInfo=new int*[nNumVars];
+  nSize=new int*[nNumVars];
+  nSizeX1=new int[nNumVars];
+  nSizeX2=new int[nNumVars];
+  nSizeY=new int[nNumVars];
+  nSizeZ=new int[nNumVars];
+  nVarOffset=new size_t[nNumVars+1];
+  dVariables=new double*[nNumVars];
+  bCopied=new bool[nNumVars];
+  nVarOffset[0]=nPos;
+  for(int n=0;n<nNumVars;n++){
+    nVarInfo[n]=new int[4];
+    nSize[n]=new int[3];
+    for(int l=0;l<4;l++){
+      nVarInfo[n][l]=nVariableInfo[4*n+l];
+    }
+    int nGhostCells[3];
+    for(int l=0;l<3;l++){
+      if(nGlobalGridDims[l]==1){
+        nVarInfo[n][l]=-1;
+      }
+      nGhostCells[l]=1;
+      if(nVarInfo[n][l]==-1){//variable not defined in direction l
+        nSize[n][l]=1;
+        nGhostCells[l]=0;
+      }
+      else if(nVarInfo[n][l]==1&&nPeriodic[l]==0){//interface variable
+        nSize[n][l]=nGlobalGridDims[l]+1;
+      }
+      else{
+        nSize[n][l]=nGlobalGridDims[l];
+      }
+    }
+    nSizeX1[n]=nGhostCells[0]*(nNum1DZones+nNumGhostCells);
+    if(nVarInfo[n][0]==1&&nPeriodic[0]==0){
+      nSizeX1[n]=nGhostCells[0]*(nNum1DZones+1+nNumGhostCells);
+    }
+    nSizeX2[n]=nSize[n][0]+nGhostCells[0]*2*nNumGhostCells;
+    nSizeY[n]=nSize[n][1]+nGhostCells[1]*2*nNumGhostCells;
+    nSizeZ[n]=nSize[n][2]+nGhostCells[2]*2*nNumGhostCells;
+    nVarOffset[n+1]=nVarOffset[n]+nNumValues(n)*sizeof(double);
+    dVariables[n]=NULL;
+    bCopied[n]=false;
+  }
+  if(nVarOffset[nNumVars]>nMapSize){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": input file \""
+      <<sFileName<<"\" is "<<nMapSize<<" bytes, but the grid described in its header needs "
+      <<nVarOffset[nNumVars]<<" bytes\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+}
+void dumpFile::close(){
+  if(dGrid!=NULL){
+    for(int n=0;n<nNumVars;n++){
+      for(int i=0;i<nSizeX2[n];i++){
+        delete [] dGrid[n][i];
+      }
+      delete [] dGrid[n];
+    }
+    delete [] dGrid;
+    dGrid=NULL;
+  }
+  if(dVariables!=NULL){
+    for(int n=0;n<nNumVars;n++){
+      if(bCopied[n]){
+        delete [] dVariables[n];
+      }
+    }
+    delete [] dVariables;
+    delete [] bCopied;
+    dVariables=NULL;
+    bCopied=NULL;
+  }
+  if(nVarInfo!=NULL){
+    for(int n=0;n<nNumVars;n++){
+      delete [] nVarInfo[n];
+      delete [] nSize[n];
+    }
+  }
+  delete [] nVarInfo;
+  delete [] nSize;
+  delete [] nSizeX1;
+  delete [] nSizeX2;
+  delete [] nSizeY;
+  delete [] nSizeZ;
+  delete [] nVarOffset;
+  delete [] nVariableInfo;
+  nVarInfo=NULL;
+  nSize=NULL;
+  nSizeX1=NULL;
+  nSizeX2=NULL;
+  nSizeY=NULL;
+  nSizeZ=NULL;
+  nVarOffset=NULL;
+  nVariableInfo=NULL;
+  nNumVars=0;
+  if(cMap!=NULL){
+    munmap(cMap,nMapSize);
+    cMap=NULL;
+    nMapSize=0;
+  }
+  if(nFile>=0){
+    ::close(nFile);
+    nFile=-1;
+  }
+}
+size_t dumpFile::nNumValues(int nVar){
+  return size_t(nSizeX1[nVar])+size_t(nSizeX2[nVar]-nSizeX1[nVar])*size_t(nSizeY[nVar])
+    *size_t(nSizeZ[nVar]);
+}
+size_t dumpFile::nRowStart(int nVar,int i,int j){
+  if(i<nSizeX1[nVar]){
+    return size_t(i);
+  }
+  return size_t(nSizeX1[nVar])+(size_t(i-nSizeX1[nVar])*size_t(nSizeY[nVar])+size_t(j))
+    *size_t(nSizeZ[nVar]);
+}
+const double* dumpFile::getVariable(int nVar){
+  if(dVariables[nVar]==NULL){
+    char *cStart=cMap+nVarOffset[nVar];
+    if(size_t(cStart)%sizeof(double)==0){//aligned, use the values where they are
+      dVariables[nVar]=(double*)cStart;
+    }
+    else{
+      dVariables[nVar]=new double[nNumValues(nVar)];
+      memcpy(dVariables[nVar],cStart,nNumValues(nVar)*sizeof(double));
+      bCopied[nVar]=true;
+    }
+  }
+  return dVariables[nVar];
+}
+void dumpFile::copyValues(int nVar,size_t nStart,size_t nNum,double *dValues){
+  if(nStart+nNum>nNumValues(nVar)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": values "<<nStart<<" to "
+      <<nStart+nNum<<" are outside of variable "<<nVar<<" of file \""<<sFileName<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  if(dVariables[nVar]!=NULL){
+    memcpy(dValues,dVariables[nVar]+nStart,nNum*sizeof(double));
+  }
+  else{
+    memcpy(dValues,cMap+nVarOffset[nVar]+nStart*sizeof(double),nNum*sizeof(double));
+  }
+}
+double**** dumpFile::getGrid(){
+  if(dGrid==NULL){
+    dGrid=new double***[nNumVars];
+    for(int n=0;n<nNumVars;n++){
+      double *dValues=(double*)getVariable(n);
+      dGrid[n]=new double**[nSizeX2[n]];
+      for(int i=0;i<nSizeX2[n];i++){
+        int nRows=nSizeY[n];
+        if(i<nSizeX1[n]){
+          nRows=1;
+        }
+        dGrid[n][i]=new double*[nRows];
+        for(int j=0;j<nRows;j++){
+          dGrid[n][i][j]=dValues+nRowStart(n,i,j);
+        }
+      }
+    }
+  }
+  return dGrid;
+}
@@ -0,0 +1,168 @@
+#ifndef DUMPFILE_H
+#define DUMPFILE_H
+
+/** @file
+
+  Header file for \ref dumpFile.cpp
+*/
+
+#include <string>
+#include <cstddef>
+#include "exception2.h"
+class dumpFile{
+  public:
+
+    //member variables
+    std::string sFileName;/**<
+      Name of the open collected binary dump file.
+      */
+    int nVersion;/**<
+      Version of the dump file.
+      */
+    double dTime;/**<
+      Simulation time of the dump.
+      */
+    int nTimeStepIndex;/**<
+      Index of the time step of the dump.
+      */
+    double dDeltat_nm1half;/**<
+      Time step between t^{n-1/2} and t^{n+1/2}.
+      */
+    double dDeltat_np1half;/**<
+      Time step between t^n and t^{n+1}.
+      */
+    double dAlpha;/**<
+      Fraction of the time step used for the next time step.
+      */
+    bool bGammaLaw;/**<
+      True if the dump uses a gamma law gas, false if it uses a tabulated equation of state.
+      */
+    double dGamma;/**<
+      Value of gamma for a gamma law gas, 0.0 if the dump uses a tabulated equation of state.
+      */
+    std::string sEOSFileName;/**<
+      Name of the equation of state table, empty if the dump uses a gamma law gas.
+      */
+    double dA;/**<
+      Artificial viscosity parameter.
+      */
+    double dAVThreshold;/**<
+      Artificial viscosity threshold.
+      */
+    int nGlobalGridDims[3];/**<
+      Number of zones in each direction, not including ghost cells.
+      */
+    int nPeriodic[3];/**<
+      1 if the grid is periodic in a direction, 0 if not.
+      */
+    int nNum1DZones;/**<
+      Number of radial zones in the inner 1D region.
+      */
+    int nNumGhostCells;/**<
+      Number of ghost cells at the boundaries.
+      */
+    int nNumVars;/**<
+      Number of grid variables.
+      */
+    int nNumDims;/**<
+      Number of dimensions with more than one zone.
+      */
+    int *nVariableInfo;/**<
+      Variable infos as stored in the file, 4 integers per variable. The first three are -1 if the
+      variable is not defined in that direction, 0 if it is zone centered and 1 if it is interface
+      centered, the fourth is 1 if the variable is time dependent.
+      */
+    int **nVarInfo;/**<
+      Variable infos of each variable, with directions that have only one zone set to -1 as the
+      variable is not really defined in those directions.
+      */
+    int **nSize;/**<
+      Global size of each variable in each direction, not including ghost cells.
+      */
+    int *nSizeX1;/**<
+      Number of radial values of each variable in the inner 1D region, each has only one value.
+      */
+    int *nSizeX2;/**<
+      Total number of radial values of each variable, including ghost cells.
+      */
+    int *nSizeY;/**<
+      Number of theta values in a row of each variable outside the 1D region, including ghost
+      cells.
+      */
+    int *nSizeZ;/**<
+      Number of phi values in a row of each variable outside the 1D region, including ghost
+      cells.
+      */
+
+    //member functions
+    dumpFile();/**<
+      Constructor, no file is open until \ref dumpFile::open is called.
+      */
+    ~dumpFile();/**<
+      Destructor, closes the file if it is open.
+      */
+    void open(std::string sFileName,int nVersion)throw(exception2);/**<
+      Maps the collected binary dump file \c sFileName into memory, and reads its header. Nothing
+      from the grid is read until it is asked for.
+
+      @param[in] sFileName name of the collected binary dump file
+      @param[in] nVersion version of the dump file supported by the caller
+      */
+    void close();/**<
+      Frees the variables and grid, and unmaps the file.
+      */
+    size_t nNumValues(int nVar);/**<
+      Returns the number of values stored for variable \c nVar.
+      */
+    size_t nRowStart(int nVar,int i,int j);/**<
+      Returns the position of the first value of row \c i, \c j of variable \c nVar among the values
+      of the variable. In the 1D region rows have only one value and \c j must be 0.
+      */
+    const double* getVariable(int nVar);/**<
+      Returns the values of variable \c nVar. The values are read from the mapped file where they
+      are, unless they are not aligned in the file in which case they are copied once on first
+      use.
+      */
+    void copyValues(int nVar,size_t nStart,size_t nNum,double *dValues);/**<
+      Copies \c nNum values of variable \c nVar starting at \c nStart into \c dValues. Only the
+      pages of the file holding those values are read.
+      */
+    double**** getGrid();/**<
+      Returns the grid as an array of rows, dGrid[n][i][j] points to the values in the row \c i,
+      \c j of variable \c n. Rows in the 1D region have one value. The grid belongs to the
+      \ref dumpFile object and is valid until the file is closed. Changes made to it are not
+      written to the file.
+      */
+  private:
+    int nFile;/**<
+      File descriptor of the open file, -1 if no file is open.
+      */
+    char *cMap;/**<
+      Start of the mapped file.
+      */
+    size_t nMapSize;/**<
+      Size of the mapped file in bytes.
+      */
+    size_t *nVarOffset;/**<
+      Offset in bytes of the first value of each variable from the start of the file.
+      */
+    double **dVariables;/**<
+      Values of each variable once asked for, NULL until then.
+      */
+    bool *bCopied;/**<
+      True if the values of a variable were copied out of the mapped file.
+      */
+    double ****dGrid;/**<
+      Rows of the grid once asked for, NULL until then.
+      */
+    dumpFile(const dumpFile &ref);/**<
+      Copying is not allowed since the object owns the mapping.
+      */
+    dumpFile& operator=(const dumpFile &ref);/**<
+      Assignment is not allowed since the object owns the mapping.
+      */
+};/**@class dumpFile
+  Gives access to a collected binary dump file through a memory mapping. The header is read when
+  the file is opened and the grid variables are read only when they are used.
+*/
+#endif
@@ -7,6 +7,8 @@
 #include <sstream>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -19,11 +21,62 @@ eos::eos(){//empty constructor
   dLogP=NULL;
   dLogE=NULL;
   dLogKappa=NULL;
+  bHermite=false;
+  dDLogPDLogT=NULL;
+  dDLogPDLogRho=NULL;
+  dD2LogPDLogTDLogRho=NULL;
+  dDLogEDLogT=NULL;
+  dDLogEDLogRho=NULL;
+  dD2LogEDLogTDLogRho=NULL;
+  dDLogKappaDLogT=NULL;
+  dDLogKappaDLogRho=NULL;
+  dD2LogKappaDLogTDLogRho=NULL;
+  bInverse=false;
+  nNumE=0;
+  dLogEMin=0.0;
+  dLogEDelta=0.0;
+  dLogTOfLogE=NULL;
+  setExePath();
+}
+eos::eos(int nNumT,int nNumRho){//allocating constructor
+  this->nNumT=nNumT;
+  this->nNumRho=nNumRho;
+  dXMassFrac=0.0;
+  dYMassFrac=0.0;
+  dLogRhoMin=0.0;
+  dLogRhoDelta=0.0;
+  dLogTMin=0.0;
+  dLogTDelta=0.0;
+  dLogP=new double*[nNumRho];
+  dLogE=new double*[nNumRho];
+  dLogKappa=new double*[nNumRho];
+  for(int i=0;i<nNumRho;i++){
+    dLogP[i]=new double[nNumT];
+    dLogE[i]=new double[nNumT];
+    dLogKappa[i]=new double[nNumT];
+  }
+  bHermite=false;
+  dDLogPDLogT=NULL;
+  dDLogPDLogRho=NULL;
+  dD2LogPDLogTDLogRho=NULL;
+  dDLogEDLogT=NULL;
+  dDLogEDLogRho=NULL;
+  dD2LogEDLogTDLogRho=NULL;
+  dDLogKappaDLogT=NULL;
+  dDLogKappaDLogRho=NULL;
+  dD2LogKappaDLogTDLogRho=NULL;
+  bInverse=false;
+  nNumE=0;
+  dLogEMin=0.0;
+  dLogEDelta=0.0;
+  dLogTOfLogE=NULL;
   setExePath();
 }
 eos& eos::operator=(const eos & rhs){//assignment operator
   if (this !=&rhs){
     //deallocate old memory
+    deleteHermiteTables();
+    deleteInverseTable();
     for(int i=0;i<nNumRho;i++){
       delete [] dLogP[i];
       delete [] dLogE[i];
@@ -35,6 +88,8 @@ eos& eos::operator=(const eos & rhs){//assignment operator
     
     nNumT=rhs.nNumT;
     nNumRho=rhs.nNumRho;
+    dXMassFrac=rhs.dXMassFrac;
+    dYMassFrac=rhs.dYMassFrac;
     dLogRhoMin=rhs.dLogRhoMin;
     dLogTMin=rhs.dLogTMin;
     dLogRhoDelta=rhs.dLogRhoDelta;
@@ -54,6 +109,18 @@ eos& eos::operator=(const eos & rhs){//assignment operator
         dLogKappa[i][j]=rhs.dLogKappa[i][j];
       }
     }
+    
+    //remake derivative tables if needed
+    bHermite=rhs.bHermite;
+    if(bHermite){
+      makeHermiteTables();
+    }
+    
+    //remake inverse table if needed
+    bInverse=rhs.bInverse;
+    if(bInverse){
+      makeInverseTable();
+    }
   }
   return *this;
 }
@@ -79,8 +146,34 @@ eos::eos(const eos &ref){//copy constructor
       dLogKappa[i][j]=ref.dLogKappa[i][j];
     }
   }
+  sExePath=ref.sExePath;
+  
+  //remake derivative tables if needed
+  bHermite=ref.bHermite;
+  dDLogPDLogT=NULL;
+  dDLogPDLogRho=NULL;
+  dD2LogPDLogTDLogRho=NULL;
+  dDLogEDLogT=NULL;
+  dDLogEDLogRho=NULL;
+  dD2LogEDLogTDLogRho=NULL;
+  dDLogKappaDLogT=NULL;
+  dDLogKappaDLogRho=NULL;
+  dD2LogKappaDLogTDLogRho=NULL;
+  if(bHermite){
+    makeHermiteTables();
+  }
+  
+  //remake inverse table if needed
+  bInverse=ref.bInverse;
+  nNumE=0;
+  dLogTOfLogE=NULL;
+  if(bInverse){
+    makeInverseTable();
+  }
 }
 eos::~eos(){//destructor
+  deleteHermiteTables();
+  deleteInverseTable();
   for(int i=0;i<nNumRho;i++){
     delete [] dLogP[i];
     delete [] dLogE[i];
@@ -90,6 +183,344 @@ eos::~eos(){//destructor
   delete [] dLogE;
   delete [] dLogKappa;
 }
+void eos::setHermite(bool bHermite){
+  this->bHermite=bHermite;
+  if(bHermite){
+    makeHermiteTables();
+  }
+  else{
+    deleteHermiteTables();
+  }
+}
+void eos::makeHermiteTables(){
+  
+  //free any old tables
+  deleteHermiteTables();
+  
+  //allocate memory
+  dDLogPDLogT=new double*[nNumRho];
+  dDLogPDLogRho=new double*[nNumRho];
+  dD2LogPDLogTDLogRho=new double*[nNumRho];
+  dDLogEDLogT=new double*[nNumRho];
+  dDLogEDLogRho=new double*[nNumRho];
+  dD2LogEDLogTDLogRho=new double*[nNumRho];
+  dDLogKappaDLogT=new double*[nNumRho];
+  dDLogKappaDLogRho=new double*[nNumRho];
+  dD2LogKappaDLogTDLogRho=new double*[nNumRho];
+  for(int i=0;i<nNumRho;i++){
+    dDLogPDLogT[i]=new double[nNumT];
+    dDLogPDLogRho[i]=new double[nNumT];
+    dD2LogPDLogTDLogRho[i]=new double[nNumT];
+    dDLogEDLogT[i]=new double[nNumT];
+    dDLogEDLogRho[i]=new double[nNumT];
+    dD2LogEDLogTDLogRho[i]=new double[nNumT];
+    dDLogKappaDLogT[i]=new double[nNumT];
+    dDLogKappaDLogRho[i]=new double[nNumT];
+    dD2LogKappaDLogTDLogRho[i]=new double[nNumT];
+  }
+  
+  //first derivatives, then the mixed derivative as the density derivative of the temperature one
+  differentiateTable(dLogP,dDLogPDLogT,true);
+  differentiateTable(dLogP,dDLogPDLogRho,false);
+  differentiateTable(dDLogPDLogT,dD2LogPDLogTDLogRho,false);
+  differentiateTable(dLogE,dDLogEDLogT,true);
+  differentiateTable(dLogE,dDLogEDLogRho,false);
+  differentiateTable(dDLogEDLogT,dD2LogEDLogTDLogRho,false);
+  differentiateTable(dLogKappa,dDLogKappaDLogT,true);
+  differentiateTable(dLogKappa,dDLogKappaDLogRho,false);
+  differentiateTable(dDLogKappaDLogT,dD2LogKappaDLogTDLogRho,false);
+}
+void eos::deleteHermiteTables(){
+  if(dDLogPDLogT!=NULL){
+    for(int i=0;i<nNumRho;i++){
+      delete [] dDLogPDLogT[i];
+      delete [] dDLogPDLogRho[i];
+      delete [] dD2LogPDLogTDLogRho[i];
+      delete [] dDLogEDLogT[i];
+      delete [] dDLogEDLogRho[i];
+      delete [] dD2LogEDLogTDLogRho[i];
+      delete [] dDLogKappaDLogT[i];
+      delete [] dDLogKappaDLogRho[i];
+      delete [] dD2LogKappaDLogTDLogRho[i];
+    }
+    delete [] dDLogPDLogT;
+    delete [] dDLogPDLogRho;
+    delete [] dD2LogPDLogTDLogRho;
+    delete [] dDLogEDLogT;
+    delete [] dDLogEDLogRho;
+    delete [] dD2LogEDLogTDLogRho;
+    delete [] dDLogKappaDLogT;
+    delete [] dDLogKappaDLogRho;
+    delete [] dD2LogKappaDLogTDLogRho;
+  }
+  dDLogPDLogT=NULL;
+  dDLogPDLogRho=NULL;
+  dD2LogPDLogTDLogRho=NULL;
+  dDLogEDLogT=NULL;
+  dDLogEDLogRho=NULL;
+  dD2LogEDLogTDLogRho=NULL;
+  dDLogKappaDLogT=NULL;
+  dDLogKappaDLogRho=NULL;
+  dD2LogKappaDLogTDLogRho=NULL;
+}
+void eos::differentiateTable(double **dF,double **dDF,bool bAlongT){
+  int nNum=nNumRho;
+  double dDelta=dLogRhoDelta;
+  if(bAlongT){
+    nNum=nNumT;
+    dDelta=dLogTDelta;
+  }
+  for(int i=0;i<nNumRho;i++){
+    for(int j=0;j<nNumT;j++){
+      
+      //position along the direction of the derivative, and values of the neighbours
+      int n=j;
+      if(!bAlongT){
+        n=i;
+      }
+      double dF_n=dF[i][j];
+      double dF_nm1=std::numeric_limits<double>::quiet_NaN();
+      double dF_np1=std::numeric_limits<double>::quiet_NaN();
+      if(n>0){
+        if(bAlongT){
+          dF_nm1=dF[i][j-1];
+        }
+        else{
+          dF_nm1=dF[i-1][j];
+        }
+      }
+      if(n<nNum-1){
+        if(bAlongT){
+          dF_np1=dF[i][j+1];
+        }
+        else{
+          dF_np1=dF[i+1][j];
+        }
+      }
+      
+      //centered if possible, otherwise one sided, zero for an isolated node
+      if(!std::isnan(dF_nm1)&&!std::isnan(dF_np1)){
+        dDF[i][j]=(dF_np1-dF_nm1)/(2.0*dDelta);
+      }
+      else if(!std::isnan(dF_np1)){
+        dDF[i][j]=(dF_np1-dF_n)/dDelta;
+      }
+      else if(!std::isnan(dF_nm1)){
+        dDF[i][j]=(dF_n-dF_nm1)/dDelta;
+      }
+      else{
+        dDF[i][j]=0.0;
+      }
+    }
+  }
+}
+void eos::interpHermite(double **dF,double **dDFDLogT,double **dDFDLogRho
+  ,double **dD2FDLogTDLogRho,int nI,int nJ,double dRhoFrac,double dTFrac,double &dFInterp
+  ,double &dDFInterpDLogT,double &dDFInterpDLogRho){
+  
+  //cubic Hermite basis functions and their derivatives in temperature, index 0 is the lower node
+  double dT_1m=1.0-dTFrac;
+  double dHT[2];
+  double dGT[2];
+  double dDHT[2];
+  double dDGT[2];
+  dHT[0]=(1.0+2.0*dTFrac)*dT_1m*dT_1m;
+  dHT[1]=dTFrac*dTFrac*(3.0-2.0*dTFrac);
+  dGT[0]=dTFrac*dT_1m*dT_1m*dLogTDelta;
+  dGT[1]=-dTFrac*dTFrac*dT_1m*dLogTDelta;
+  dDHT[0]=-6.0*dTFrac*dT_1m/dLogTDelta;
+  dDHT[1]=-dDHT[0];
+  dDGT[0]=dT_1m*(1.0-3.0*dTFrac);
+  dDGT[1]=dTFrac*(3.0*dTFrac-2.0);
+  
+  //cubic Hermite basis functions and their derivatives in density
+  double dRho_1m=1.0-dRhoFrac;
+  double dHRho[2];
+  double dGRho[2];
+  double dDHRho[2];
+  double dDGRho[2];
+  dHRho[0]=(1.0+2.0*dRhoFrac)*dRho_1m*dRho_1m;
+  dHRho[1]=dRhoFrac*dRhoFrac*(3.0-2.0*dRhoFrac);
+  dGRho[0]=dRhoFrac*dRho_1m*dRho_1m*dLogRhoDelta;
+  dGRho[1]=-dRhoFrac*dRhoFrac*dRho_1m*dLogRhoDelta;
+  dDHRho[0]=-6.0*dRhoFrac*dRho_1m/dLogRhoDelta;
+  dDHRho[1]=-dDHRho[0];
+  dDGRho[0]=dRho_1m*(1.0-3.0*dRhoFrac);
+  dDGRho[1]=dRhoFrac*(3.0*dRhoFrac-2.0);
+  
+  //sum contributions of the 4 corners of the cell
+  dFInterp=0.0;
+  dDFInterpDLogT=0.0;
+  dDFInterpDLogRho=0.0;
+  for(int a=0;a<2;a++){//density
+    for(int b=0;b<2;b++){//temperature
+      double dF_ab=dF[nI+a][nJ+b];
+      double dFT_ab=dDFDLogT[nI+a][nJ+b];
+      double dFRho_ab=dDFDLogRho[nI+a][nJ+b];
+      double dFTRho_ab=dD2FDLogTDLogRho[nI+a][nJ+b];
+      dFInterp+=(dF_ab*dHT[b]+dFT_ab*dGT[b])*dHRho[a]+(dFRho_ab*dHT[b]+dFTRho_ab*dGT[b])*dGRho[a];
+      dDFInterpDLogT+=(dF_ab*dDHT[b]+dFT_ab*dDGT[b])*dHRho[a]
+        +(dFRho_ab*dDHT[b]+dFTRho_ab*dDGT[b])*dGRho[a];
+      dDFInterpDLogRho+=(dF_ab*dHT[b]+dFT_ab*dGT[b])*dDHRho[a]
+        +(dFRho_ab*dHT[b]+dFTRho_ab*dGT[b])*dDGRho[a];
+    }
+  }
+}
+void eos::setInverse(bool bInverse){
+  this->bInverse=bInverse;
+  if(bInverse){
+    makeInverseTable();
+  }
+  else{
+    deleteInverseTable();
+  }
+}
+void eos::makeInverseTable(){
+  
+  //free any old table
+  deleteInverseTable();
+  
+  //energy range of the table, ignoring nan's
+  double dLogEMax=-std::numeric_limits<double>::max();
+  dLogEMin=std::numeric_limits<double>::max();
+  for(int i=0;i<nNumRho;i++){
+    for(int j=0;j<nNumT;j++){
+      if(dLogE[i][j]<dLogEMin){
+        dLogEMin=dLogE[i][j];
+      }
+      if(dLogE[i][j]>dLogEMax){
+        dLogEMax=dLogE[i][j];
+      }
+    }
+  }
+  
+  //same resolution in energy as in temperature
+  nNumE=nNumT;
+  dLogEDelta=(dLogEMax-dLogEMin)/double(nNumE-1);
+  if(nNumT<2||!(dLogEDelta>0.0)){//no usable energy range, lookups will fall back to searching
+    nNumE=0;
+  }
+  
+  //allocate memory
+  dLogTOfLogE=new double*[nNumRho];
+  for(int i=0;i<nNumRho;i++){
+    dLogTOfLogE[i]=new double[nNumE];
+    
+    //energies increase along the row, so the bracketing temperature interval only moves up
+    int j=0;
+    for(int k=0;k<nNumE;k++){
+      double dLogETarget=dLogEMin+double(k)*dLogEDelta;
+      while(j<nNumT-2&&!(dLogE[i][j+1]>=dLogETarget)){
+        j++;
+      }
+      if(dLogE[i][j]<=dLogETarget&&dLogETarget<=dLogE[i][j+1]&&dLogE[i][j+1]>dLogE[i][j]){
+        double dTFrac=(dLogETarget-dLogE[i][j])/(dLogE[i][j+1]-dLogE[i][j]);
+        dLogTOfLogE[i][k]=dLogTMin+(double(j)+dTFrac)*dLogTDelta;
+      }
+      else{
+        dLogTOfLogE[i][k]=std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+  }
+}
+void eos::deleteInverseTable(){
+  if(dLogTOfLogE!=NULL){
+    for(int i=0;i<nNumRho;i++){
+      delete [] dLogTOfLogE[i];
+    }
+    delete [] dLogTOfLogE;
+  }
+  dLogTOfLogE=NULL;
+}
+int eos::nGetCell(double dT,double dRho){
+  if(!(dT>0.0&&dRho>0.0)){
+    return -1;
+  }
+  
+  //clamp to the cells of the table before converting to int
+  double dI=floor((log10(dRho)-dLogRhoMin)/dLogRhoDelta);
+  double dJ=floor((log10(dT)-dLogTMin)/dLogTDelta);
+  int nI=int(std::max(0.0,std::min(double(nNumRho-2),dI)));
+  int nJ=int(std::max(0.0,std::min(double(nNumT-2),dJ)));
+  return nI*nNumT+nJ;
+}
+void eos::findCell(double dLogT,double dLogRho,int &nCell,int &nI,int &nJ,double &dRhoFrac
+  ,double &dTFrac)throw(exception2){
+  
+  //reuse the cell of the last lookup if it still brackets the point
+  if(nCell>=0){
+    nI=nCell/nNumT;
+    nJ=nCell-nI*nNumT;
+    if(nI<nNumRho-1&&nJ<nNumT-1){
+      double dLogRhoLower=dLogRhoMin+double(nI)*dLogRhoDelta;
+      double dLogRhoUpper=dLogRhoMin+double(nI+1)*dLogRhoDelta;
+      double dLogTLower=dLogTMin+double(nJ)*dLogTDelta;
+      double dLogTUpper=dLogTMin+double(nJ+1)*dLogTDelta;
+      if(dLogRho>=dLogRhoLower&&dLogRho<dLogRhoUpper&&dLogT>=dLogTLower&&dLogT<dLogTUpper){
+        dRhoFrac=(dLogRho-dLogRhoLower)/(dLogRhoUpper-dLogRhoLower);
+        dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
+        return;
+      }
+    }
+  }
+  
+  //if density too low
+  if(dLogRho<dLogRhoMin){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log density to interpolate to, \""<<dLogRho
+      <<"\" is lower than the minimum density in the table, \""<<dLogRhoMin<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //if temperature too low
+  if(dLogT<dLogTMin){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log temperature to interpolate to, \""<<dLogT
+      <<"\" is lower than the minimum log temperature in the table, \""<<dLogTMin<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate maximum values of grid
+  double dLogRhoMax=dLogRhoMin+double(nNumRho)*dLogRhoDelta;
+  double dLogTMax=dLogTMin+double(nNumT)*dLogTDelta;
+  
+  //calculate independent quantities at bracketing i's
+  nI=int((dLogRho-dLogRhoMin)/dLogRhoDelta);
+  double dLogRhoLower=dLogRhoMin+double(nI)*dLogRhoDelta;
+  double dLogRhoUpper=dLogRhoMin+double(nI+1)*dLogRhoDelta;
+  
+  //if density too high
+  if(dLogRho>dLogRhoMax||nI+1>(nNumRho-1)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log density to interpolate to, \""<<dLogRho
+      <<"\"("<<nI+1<<") is higher than the maximum density in the table, \""<<dLogRhoMax
+      <<"\"("<<nNumRho-1<<")\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate independent quantities at bracketing j's
+  nJ=int((dLogT-dLogTMin)/dLogTDelta);
+  double dLogTLower=dLogTMin+double(nJ)*dLogTDelta;
+  double dLogTUpper=dLogTMin+double(nJ+1)*dLogTDelta;
+  
+  //if temperature too high
+  if(dLogT>dLogTMax||nJ+1>(nNumT-1)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log temperature to interpolate to, \""<<dLogT
+      <<"\"("<<nJ+1<<") is higher than the maximum temperature in the table, \""<<dLogTMax
+      <<"\"("<<nNumT-1<<")\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate fractional distances across the cell
+  dRhoFrac=(dLogRho-dLogRhoLower)/(dLogRhoUpper-dLogRhoLower);
+  dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
+  nCell=nI*nNumT+nJ;
+}
 void eos::readAscii(std::string sFileName)throw(exception2){
   
   //open file
@@ -103,6 +534,8 @@ void eos::readAscii(std::string sFileName)throw(exception2){
   }
   
   //delete memory
+  deleteHermiteTables();
+  deleteInverseTable();
   for(int i=0;i<nNumRho;i++){
     delete [] dLogP[i];
     delete [] dLogE[i];
@@ -149,6 +582,16 @@ void eos::readAscii(std::string sFileName)throw(exception2){
   }
   
   ifIn.close();
+  
+  //remake derivative tables for the new table
+  if(bHermite){
+    makeHermiteTables();
+  }
+  
+  //remake inverse table for the new table
+  if(bInverse){
+    makeInverseTable();
+  }
 }
 void eos::readBobsAscii(std::string sFileName)throw(exception2){
   
@@ -163,6 +606,8 @@ void eos::readBobsAscii(std::string sFileName)throw(exception2){
   }
   
   //delete memory
+  deleteHermiteTables();
+  deleteInverseTable();
   for(int i=0;i<nNumRho;i++){
     delete [] dLogP[i];
     delete [] dLogE[i];
@@ -202,6 +647,16 @@ void eos::readBobsAscii(std::string sFileName)throw(exception2){
     throw exception2(ssTemp.str(),INPUT);
   }
   ifIn.close();
+  
+  //remake derivative tables for the new table
+  if(bHermite){
+    makeHermiteTables();
+  }
+  
+  //remake inverse table for the new table
+  if(bInverse){
+    makeInverseTable();
+  }
 }
 void eos::writeAscii(std::string sFileName)throw(exception2){
   
@@ -255,6 +710,8 @@ void eos::readBin(std::string sFileName)throw(exception2){
   }
   
   //delete memory
+  deleteHermiteTables();
+  deleteInverseTable();
   for(int i=0;i<nNumRho;i++){
     delete [] dLogP[i];
     delete [] dLogE[i];
@@ -295,6 +752,16 @@ void eos::readBin(std::string sFileName)throw(exception2){
     throw exception2(ssTemp.str(),INPUT);
   }
   ifIn.close();
+  
+  //remake derivative tables for the new table
+  if(bHermite){
+    makeHermiteTables();
+  }
+  
+  //remake inverse table for the new table
+  if(bInverse){
+    makeInverseTable();
+  }
 }
 void eos::writeBin(std::string sFileName)throw(exception2){
   
@@ -405,9 +872,19 @@ double eos::dGetPressure(double dT, double dRho)throw(exception2){
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
   //calculate interpolated pressure
-  double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
-  double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
-  double dP=pow(10.0,((dP_jp1-dP_j)*dTFrac+dP_j));
+  double dLogPInterp;
+  if(bHermite){
+    double dDlnPDlnT;
+    double dDlnPDlnRho;
+    interpHermite(dLogP,dDLogPDLogT,dDLogPDLogRho,dD2LogPDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogPInterp,dDlnPDlnT,dDlnPDlnRho);
+  }
+  else{
+    double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
+    double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
+    dLogPInterp=(dP_jp1-dP_j)*dTFrac+dP_j;
+  }
+  double dP=pow(10.0,dLogPInterp);
   if (std::isnan(dP)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -500,9 +977,19 @@ double eos::dGetEnergy(double dT, double dRho)throw(exception2){
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
   //calculate interpolated energy
-  double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
-  double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
-  double dE=pow(10.0,((dE_jp1-dE_j)*dTFrac+dE_j));
+  double dLogEInterp;
+  if(bHermite){
+    double dDlnEDlnT;
+    double dDlnEDlnRho;
+    interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+  }
+  else{
+    double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
+    double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
+    dLogEInterp=(dE_jp1-dE_j)*dTFrac+dE_j;
+  }
+  double dE=pow(10.0,dLogEInterp);
   if (std::isnan(dE)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -595,11 +1082,21 @@ double eos::dGetOpacity(double dT, double dRho)throw(exception2){
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
   //calculate interpolated opacity
-  double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
-    +dLogKappa[nILower][nJLower];
-  double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
-    +dLogKappa[nILower][nJUpper];
-  double dKappa=pow(10.0,((dKappa_jp1-dKappa_j)*dTFrac+dKappa_j));
+  double dLogKappaInterp;
+  if(bHermite){
+    double dDlnKappaDlnT;
+    double dDlnKappaDlnRho;
+    interpHermite(dLogKappa,dDLogKappaDLogT,dDLogKappaDLogRho,dD2LogKappaDLogTDLogRho,nILower
+      ,nJLower,dRhoFrac,dTFrac,dLogKappaInterp,dDlnKappaDlnT,dDlnKappaDlnRho);
+  }
+  else{
+    double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
+      +dLogKappa[nILower][nJLower];
+    double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
+      +dLogKappa[nILower][nJUpper];
+    dLogKappaInterp=(dKappa_jp1-dKappa_j)*dTFrac+dKappa_j;
+  }
+  double dKappa=pow(10.0,dLogKappaInterp);
   if (std::isnan(dKappa)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -702,6 +1199,12 @@ double eos::dDRhoDP(double dT,double dRho)throw(exception2){
   }
   return dDRhoDP;
 }
+void eos::getDRhoDP(int nNum,const double dT[],const double dRho[],double dDRhoDP[])
+  throw(exception2){
+  for(int n=0;n<nNum;n++){
+    dDRhoDP[n]=this->dDRhoDP(dT[n],dRho[n]);
+  }
+}
 double eos::dSoundSpeed(double dT,double dRho)throw(exception2){
   
   //check for negative density
@@ -825,6 +1328,12 @@ double eos::dSoundSpeed(double dT,double dRho)throw(exception2){
   }
   return dC;
 }
+void eos::getSoundSpeed(int nNum,const double dT[],const double dRho[],double dC[])
+  throw(exception2){
+  for(int n=0;n<nNum;n++){
+    dC[n]=dSoundSpeed(dT[n],dRho[n]);
+  }
+}
 void eos::getEKappa(double dT, double dRho, double &dE, double &dKappa)throw(exception2){
   
   //check for negative density
@@ -908,9 +1417,19 @@ void eos::getEKappa(double dT, double dRho, double &dE, double &dKappa)throw(exc
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
   //calculate interpolated energy
-  double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
-  double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
-  dE=pow(10.0,((dE_jp1-dE_j)*dTFrac+dE_j));
+  double dLogEInterp;
+  if(bHermite){
+    double dDlnEDlnT;
+    double dDlnEDlnRho;
+    interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+  }
+  else{
+    double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
+    double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
+    dLogEInterp=(dE_jp1-dE_j)*dTFrac+dE_j;
+  }
+  dE=pow(10.0,dLogEInterp);
   if (std::isnan(dE)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -920,11 +1439,21 @@ void eos::getEKappa(double dT, double dRho, double &dE, double &dKappa)throw(exc
   }
   
   //calculate interpolated opacity
-  double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
-    +dLogKappa[nILower][nJLower];
-  double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
-    +dLogKappa[nILower][nJUpper];
-  dKappa=pow(10.0,((dKappa_jp1-dKappa_j)*dTFrac+dKappa_j));
+  double dLogKappaInterp;
+  if(bHermite){
+    double dDlnKappaDlnT;
+    double dDlnKappaDlnRho;
+    interpHermite(dLogKappa,dDLogKappaDLogT,dDLogKappaDLogRho,dD2LogKappaDLogTDLogRho,nILower
+      ,nJLower,dRhoFrac,dTFrac,dLogKappaInterp,dDlnKappaDlnT,dDlnKappaDlnRho);
+  }
+  else{
+    double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
+      +dLogKappa[nILower][nJLower];
+    double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
+      +dLogKappa[nILower][nJUpper];
+    dLogKappaInterp=(dKappa_jp1-dKappa_j)*dTFrac+dKappa_j;
+  }
+  dKappa=pow(10.0,dLogKappaInterp);
   if (std::isnan(dKappa)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1016,9 +1545,19 @@ void eos::getPEKappa(double dT, double dRho, double &dP, double &dE, double &dKa
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
   //calculate interpolated pressure
-  double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
-  double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
-  dP=pow(10.0,((dP_jp1-dP_j)*dTFrac+dP_j));
+  double dLogPInterp;
+  if(bHermite){
+    double dDlnPDlnT;
+    double dDlnPDlnRho;
+    interpHermite(dLogP,dDLogPDLogT,dDLogPDLogRho,dD2LogPDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogPInterp,dDlnPDlnT,dDlnPDlnRho);
+  }
+  else{
+    double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
+    double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
+    dLogPInterp=(dP_jp1-dP_j)*dTFrac+dP_j;
+  }
+  dP=pow(10.0,dLogPInterp);
   if (std::isnan(dP)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1028,9 +1567,19 @@ void eos::getPEKappa(double dT, double dRho, double &dP, double &dE, double &dKa
   }
   
   //calculate interpolated energy
-  double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
-  double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
-  dE=pow(10.0,((dE_jp1-dE_j)*dTFrac+dE_j));
+  double dLogEInterp;
+  if(bHermite){
+    double dDlnEDlnT;
+    double dDlnEDlnRho;
+    interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+  }
+  else{
+    double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
+    double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
+    dLogEInterp=(dE_jp1-dE_j)*dTFrac+dE_j;
+  }
+  dE=pow(10.0,dLogEInterp);
   if (std::isnan(dE)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1040,11 +1589,21 @@ void eos::getPEKappa(double dT, double dRho, double &dP, double &dE, double &dKa
   }
   
   //calculate interpolated opacity
-  double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
-    +dLogKappa[nILower][nJLower];
-  double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
-    +dLogKappa[nILower][nJUpper];
-  dKappa=pow(10.0,((dKappa_jp1-dKappa_j)*dTFrac+dKappa_j));
+  double dLogKappaInterp;
+  if(bHermite){
+    double dDlnKappaDlnT;
+    double dDlnKappaDlnRho;
+    interpHermite(dLogKappa,dDLogKappaDLogT,dDLogKappaDLogRho,dD2LogKappaDLogTDLogRho,nILower
+      ,nJLower,dRhoFrac,dTFrac,dLogKappaInterp,dDlnKappaDlnT,dDlnKappaDlnRho);
+  }
+  else{
+    double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
+      +dLogKappa[nILower][nJLower];
+    double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
+      +dLogKappa[nILower][nJUpper];
+    dLogKappaInterp=(dKappa_jp1-dKappa_j)*dTFrac+dKappa_j;
+  }
+  dKappa=pow(10.0,dLogKappaInterp);
   if (std::isnan(dKappa)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1136,35 +1695,114 @@ void eos::getPEKappaGamma(double dT, double dRho, double &dP, double &dE, double
   //calculate fractional distance between nJLower and nJUpper
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
-  //calculate interpolated log10 pressure at upper and lower temperatures
-  double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
-  double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
+  //calculate pressure, energy, opacity and gamma in this cell
+  getPEKappaGammaCell(nILower,nJLower,dRhoFrac,dTFrac,dT,dLogT,dRho,dP,dE,dKappa,dGamma);
+}
+void eos::getPEKappaGamma(double dT,double dRho,int &nCell,double &dP,double &dE,double &dKappa
+  ,double &dGamma)throw(exception2){
   
-  //calculate interpolated log10 energy at upper and lower temperatures
-  double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
-  double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
+  //check for negative density
+  if(dRho<0.0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": dRho=\""<<dRho
+      <<"\" is less than zero.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
   
-  //calculate interpolated log10 opacity at upper and lower temperatures
-  double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
-    +dLogKappa[nILower][nJLower];
-  double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
-    +dLogKappa[nILower][nJUpper];
+  //check for negative temperature
+  if(dT<0.0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": dT=\""<<dT
+      <<"\" is less than zero.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
   
-  //calculate interpolated log pressures at upper and lower densities
-  double dP_i  =(dLogP[nILower][nJUpper]-dLogP[nILower][nJLower])*dTFrac+dLogP[nILower][nJLower];
-  double dP_ip1=(dLogP[nIUpper][nJUpper]-dLogP[nIUpper][nJLower])*dTFrac+dLogP[nIUpper][nJLower];
+  //calculate logs of dT and dRho
+  double dLogRho=log10(dRho);
+  double dLogT=log10(dT);
   
-  //calculate dlnP/dlnT at constant density
-  double dDlnPDlnT=(dP_jp1-dP_j)/(dLogTUpper-dLogTLower);
+  //find the table cell, starting from the hint
+  int nI;
+  int nJ;
+  double dRhoFrac;
+  double dTFrac;
+  findCell(dLogT,dLogRho,nCell,nI,nJ,dRhoFrac,dTFrac);
   
-  //calculate dlnP/dlnRho at constant temperature
-  double dDlnPDlnRho=(dP_ip1-dP_i)/(dLogRhoUpper-dLogRhoLower);
+  //calculate pressure, energy, opacity and gamma in this cell
+  getPEKappaGammaCell(nI,nJ,dRhoFrac,dTFrac,dT,dLogT,dRho,dP,dE,dKappa,dGamma);
+}
+void eos::getPEKappaGammaCell(int nI,int nJ,double dRhoFrac,double dTFrac,double dT,double dLogT
+  ,double dRho,double &dP,double &dE,double &dKappa,double &dGamma)throw(exception2){
+  
+  //indices and independent quantities at the cell corners
+  int nILower=nI;
+  int nIUpper=nI+1;
+  int nJLower=nJ;
+  int nJUpper=nJ+1;
+  double dLogRhoLower=dLogRhoMin+double(nILower)*dLogRhoDelta;
+  double dLogRhoUpper=dLogRhoMin+double(nIUpper)*dLogRhoDelta;
+  double dLogTLower=dLogTMin+double(nJLower)*dLogTDelta;
+  double dLogTUpper=dLogTMin+double(nJUpper)*dLogTDelta;
   
-  //calculate dE/dT at constant density, equal to C_v (specific heat at constant volume)
-  double dDEDT=(pow(10.0,dE_jp1)-pow(10.0,dE_j))/(pow(10.0,dLogTUpper)-pow(10.0,dLogTLower));
+  //calculate interpolated log10 pressure, energy and opacity, and the derivatives needed for
+  //gamma
+  double dLogPInterp;
+  double dLogEInterp;
+  double dLogKappaInterp;
+  double dDlnPDlnT;
+  double dDlnPDlnRho;
+  double dDEDT;
+  if(bHermite){
+    double dDlnEDlnT;
+    double dDlnEDlnRho;
+    double dDlnKappaDlnT;
+    double dDlnKappaDlnRho;
+    interpHermite(dLogP,dDLogPDLogT,dDLogPDLogRho,dD2LogPDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogPInterp,dDlnPDlnT,dDlnPDlnRho);
+    interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+    interpHermite(dLogKappa,dDLogKappaDLogT,dDLogKappaDLogRho,dD2LogKappaDLogTDLogRho,nILower
+      ,nJLower,dRhoFrac,dTFrac,dLogKappaInterp,dDlnKappaDlnT,dDlnKappaDlnRho);
+    
+    //calculate dE/dT at constant density from the derivative of the interpolation
+    dDEDT=pow(10.0,dLogEInterp-dLogT)*dDlnEDlnT;
+  }
+  else{
+    //calculate interpolated log10 pressure at upper and lower temperatures
+    double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
+    double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
+    
+    //calculate interpolated log10 energy at upper and lower temperatures
+    double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
+    double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
+    
+    //calculate interpolated log10 opacity at upper and lower temperatures
+    double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
+      +dLogKappa[nILower][nJLower];
+    double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
+      +dLogKappa[nILower][nJUpper];
+    
+    //calculate interpolated log pressures at upper and lower densities
+    double dP_i  =(dLogP[nILower][nJUpper]-dLogP[nILower][nJLower])*dTFrac+dLogP[nILower][nJLower];
+    double dP_ip1=(dLogP[nIUpper][nJUpper]-dLogP[nIUpper][nJLower])*dTFrac+dLogP[nIUpper][nJLower];
+    
+    //calculate dlnP/dlnT at constant density
+    dDlnPDlnT=(dP_jp1-dP_j)/(dLogTUpper-dLogTLower);
+    
+    //calculate dlnP/dlnRho at constant temperature
+    dDlnPDlnRho=(dP_ip1-dP_i)/(dLogRhoUpper-dLogRhoLower);
+    
+    //calculate dE/dT at constant density, equal to C_v (specific heat at constant volume)
+    dDEDT=(pow(10.0,dE_jp1)-pow(10.0,dE_j))/(pow(10.0,dLogTUpper)-pow(10.0,dLogTLower));
+    
+    //calculate interpolated log10 quantities
+    dLogPInterp=(dP_jp1-dP_j)*dTFrac+dP_j;
+    dLogEInterp=(dE_jp1-dE_j)*dTFrac+dE_j;
+    dLogKappaInterp=(dKappa_jp1-dKappa_j)*dTFrac+dKappa_j;
+  }
   
   //calculate interpolated energy
-  dE=pow(10.0,((dE_jp1-dE_j)*dTFrac+dE_j));
+  dE=pow(10.0,dLogEInterp);
   if (std::isnan(dE)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1174,7 +1812,7 @@ void eos::getPEKappaGamma(double dT, double dRho, double &dP, double &dE, double
   }
   
   //calculate interpolated pressure
-  dP=pow(10.0,((dP_jp1-dP_j)*dTFrac+dP_j));
+  dP=pow(10.0,dLogPInterp);
   if (std::isnan(dP)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1184,7 +1822,7 @@ void eos::getPEKappaGamma(double dT, double dRho, double &dP, double &dE, double
   }
   
   //calculate interpolated opacity
-  dKappa=pow(10.0,((dKappa_jp1-dKappa_j)*dTFrac+dKappa_j));
+  dKappa=pow(10.0,dLogKappaInterp);
   if (std::isnan(dKappa)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1373,6 +2011,12 @@ void eos::getPEKappaGammaCp(double dT, double dRho, double &dP, double &dE, doub
     throw exception2(ssTemp.str(),INPUT);
   }
 }
+void eos::getPEKappaGammaCp(int nNum,const double dT[],const double dRho[],double dP[]
+  ,double dE[],double dKappa[],double dGamma[],double dC_p[])throw(exception2){
+  for(int n=0;n<nNum;n++){
+    getPEKappaGammaCp(dT[n],dRho[n],dP[n],dE[n],dKappa[n],dGamma[n],dC_p[n]);
+  }
+}
 void eos::getPKappaGamma(double dT, double dRho, double &dP, double &dKappa,double &dGamma)throw(exception2){
   
   //check for negative density
@@ -1455,38 +2099,84 @@ void eos::getPKappaGamma(double dT, double dRho, double &dP, double &dKappa,doub
   //calculate fractional distance between nJLower and nJUpper
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
-  //calculate interpolated log10 pressure at upper and lower temperatures
-  double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
-  double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
-  
-  //calculate interpolated log10 energy at upper and lower temperatures
-  double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
-  double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
-  
-  //calculate interpolated log10 opacity at upper and lower temperatures
-  double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
-    +dLogKappa[nILower][nJLower];
-  double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
-    +dLogKappa[nILower][nJUpper];
-  
-  //calculate interpolated log pressures at upper and lower densities
-  double dP_i  =(dLogP[nILower][nJUpper]-dLogP[nILower][nJLower])*dTFrac+dLogP[nILower][nJLower];
-  double dP_ip1=(dLogP[nIUpper][nJUpper]-dLogP[nIUpper][nJLower])*dTFrac+dLogP[nIUpper][nJLower];
-  
-  //calculate dlnP/dlnT at constant density
-  double dDlnPDlnT=(dP_jp1-dP_j)/(dLogTUpper-dLogTLower);
-  
-  //calculate dlnP/dlnRho at constant temperature
-  double dDlnPDlnRho=(dP_ip1-dP_i)/(dLogRhoUpper-dLogRhoLower);
+  //calculate pressure, opacity and gamma in this cell
+  getPKappaGammaCell(nILower,nJLower,dRhoFrac,dTFrac,dT,dLogT,dRho,dP,dKappa,dGamma);
+}
+void eos::getPKappaGammaCell(int nI,int nJ,double dRhoFrac,double dTFrac,double dT,double dLogT
+  ,double dRho,double &dP,double &dKappa,double &dGamma)throw(exception2){
+  
+  //indices and independent quantities at the cell corners
+  int nILower=nI;
+  int nIUpper=nI+1;
+  int nJLower=nJ;
+  int nJUpper=nJ+1;
+  double dLogRhoLower=dLogRhoMin+double(nILower)*dLogRhoDelta;
+  double dLogRhoUpper=dLogRhoMin+double(nIUpper)*dLogRhoDelta;
+  double dLogTLower=dLogTMin+double(nJLower)*dLogTDelta;
+  double dLogTUpper=dLogTMin+double(nJUpper)*dLogTDelta;
   
-  //calculate dE/dT at constant density, equal to C_v (specific heat at constant volume)
-  double dDEDT=(pow(10.0,dE_jp1)-pow(10.0,dE_j))/(pow(10.0,dLogTUpper)-pow(10.0,dLogTLower));
+  //calculate interpolated log10 pressure, energy and opacity, and the derivatives needed for
+  //gamma
+  double dLogPInterp;
+  double dLogEInterp;
+  double dLogKappaInterp;
+  double dDlnPDlnT;
+  double dDlnPDlnRho;
+  double dDEDT;
+  if(bHermite){
+    double dDlnEDlnT;
+    double dDlnEDlnRho;
+    double dDlnKappaDlnT;
+    double dDlnKappaDlnRho;
+    interpHermite(dLogP,dDLogPDLogT,dDLogPDLogRho,dD2LogPDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogPInterp,dDlnPDlnT,dDlnPDlnRho);
+    interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+    interpHermite(dLogKappa,dDLogKappaDLogT,dDLogKappaDLogRho,dD2LogKappaDLogTDLogRho,nILower
+      ,nJLower,dRhoFrac,dTFrac,dLogKappaInterp,dDlnKappaDlnT,dDlnKappaDlnRho);
+    
+    //calculate dE/dT at constant density from the derivative of the interpolation
+    dDEDT=pow(10.0,dLogEInterp-dLogT)*dDlnEDlnT;
+  }
+  else{
+    //calculate interpolated log10 pressure at upper and lower temperatures
+    double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
+    double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
+    
+    //calculate interpolated log10 energy at upper and lower temperatures
+    double dE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
+    double dE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
+    
+    //calculate interpolated log10 opacity at upper and lower temperatures
+    double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
+      +dLogKappa[nILower][nJLower];
+    double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
+      +dLogKappa[nILower][nJUpper];
+    
+    //calculate interpolated log pressures at upper and lower densities
+    double dP_i  =(dLogP[nILower][nJUpper]-dLogP[nILower][nJLower])*dTFrac+dLogP[nILower][nJLower];
+    double dP_ip1=(dLogP[nIUpper][nJUpper]-dLogP[nIUpper][nJLower])*dTFrac+dLogP[nIUpper][nJLower];
+    
+    //calculate dlnP/dlnT at constant density
+    dDlnPDlnT=(dP_jp1-dP_j)/(dLogTUpper-dLogTLower);
+    
+    //calculate dlnP/dlnRho at constant temperature
+    dDlnPDlnRho=(dP_ip1-dP_i)/(dLogRhoUpper-dLogRhoLower);
+    
+    //calculate dE/dT at constant density, equal to C_v (specific heat at constant volume)
+    dDEDT=(pow(10.0,dE_jp1)-pow(10.0,dE_j))/(pow(10.0,dLogTUpper)-pow(10.0,dLogTLower));
+    
+    //calculate interpolated log10 quantities
+    dLogPInterp=(dP_jp1-dP_j)*dTFrac+dP_j;
+    dLogEInterp=(dE_jp1-dE_j)*dTFrac+dE_j;
+    dLogKappaInterp=(dKappa_jp1-dKappa_j)*dTFrac+dKappa_j;
+  }
   
   //calculate interpolated energy
   //dE=pow(10.0,((dE_jp1-dE_j)*dTFrac+dE_j));
   
   //calculate interpolated pressure
-  dP=pow(10.0,((dP_jp1-dP_j)*dTFrac+dP_j));
+  dP=pow(10.0,dLogPInterp);
   if (std::isnan(dP)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1496,7 +2186,7 @@ void eos::getPKappaGamma(double dT, double dRho, double &dP, double &dKappa,doub
   }
   
   //calculate interpolated opacity
-  dKappa=pow(10.0,((dKappa_jp1-dKappa_j)*dTFrac+dKappa_j));
+  dKappa=pow(10.0,dLogKappaInterp);
   if (std::isnan(dKappa)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1518,6 +2208,312 @@ void eos::getPKappaGamma(double dT, double dRho, double &dP, double &dKappa,doub
     throw exception2(ssTemp.str(),INPUT);
   }
 }
+bool eos::bGetTPKappaGamma(double dE,double dRho,double dTolerance,int nMaxIterations,double &dT
+  ,double &dP,double &dKappa,double &dGamma)throw(exception2){
+  int nCell=-1;
+  return bGetTPKappaGamma(dE,dRho,dTolerance,nMaxIterations,nCell,dT,dP,dKappa,dGamma);
+}
+bool eos::bGetTPKappaGamma(double dE,double dRho,double dTolerance,int nMaxIterations,int &nCell
+  ,double &dT,double &dP,double &dKappa,double &dGamma)throw(exception2){
+  
+  //check for negative density
+  if(dRho<0.0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": dRho=\""<<dRho
+      <<"\" is less than zero.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //check for negative energy
+  if(dE<0.0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": dE=\""<<dE
+      <<"\" is less than zero.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate logs of dE and dRho
+  double dLogRho=log10(dRho);
+  double dLogETarget=log10(dE);
+  
+  //if density too low
+  if(dLogRho<dLogRhoMin){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log density to interpolate to, \""<<dLogRho
+      <<"\" is lower than the minimum density in the table, \""<<dLogRhoMin<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate maximum values of grid
+  double dLogRhoMax=dLogRhoMin+double(nNumRho-1)*dLogRhoDelta;
+  double dLogTMax=dLogTMin+double(nNumT-1)*dLogTDelta;
+  
+  //calculate independent quantities at bracketing i's, keeping the density index of the hint if it
+  //still brackets dRho
+  int nILower=-1;
+  int nJHint=-1;
+  if(nCell>=0){
+    nILower=nCell/nNumT;
+    nJHint=nCell-nILower*nNumT;
+    if(!(nILower<nNumRho-1&&dLogRho>=dLogRhoMin+double(nILower)*dLogRhoDelta
+      &&dLogRho<dLogRhoMin+double(nILower+1)*dLogRhoDelta)){
+      nILower=int((dLogRho-dLogRhoMin)/dLogRhoDelta);
+    }
+  }
+  else{
+    nILower=int((dLogRho-dLogRhoMin)/dLogRhoDelta);
+  }
+  int nIUpper=nILower+1;
+  double dLogRhoLower=dLogRhoMin+double(nILower)*dLogRhoDelta;
+  double dLogRhoUpper=dLogRhoMin+double(nIUpper)*dLogRhoDelta;
+  
+  //if density too high
+  if(dLogRho>dLogRhoMax||nIUpper>(nNumRho-1)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log density to interpolate to, \""<<dLogRho
+      <<"\"("<<nIUpper<<") is higher than the maximum density in the table, \""<<dLogRhoMax
+      <<"\"("<<nNumRho-1<<")\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate fractional distance between nILower and nIUpper
+  double dRhoFrac=(dLogRho-dLogRhoLower)/(dLogRhoUpper-dLogRhoLower);
+  
+  //start from the temperature cell of the hint, or guess it from the inverse table
+  int nJLower=-1;
+  if(nJHint>=0&&nJHint<nNumT-1){
+    nJLower=nJHint;
+  }
+  else if(bInverse&&nNumE>1){
+    double dEPos=(dLogETarget-dLogEMin)/dLogEDelta;
+    if(dEPos>=0.0&&dEPos<double(nNumE-1)){
+      int nK=int(dEPos);
+      double dEFrac=dEPos-double(nK);
+      double dLogT_k  =(dLogTOfLogE[nIUpper][nK]-dLogTOfLogE[nILower][nK])*dRhoFrac
+        +dLogTOfLogE[nILower][nK];
+      double dLogT_kp1=(dLogTOfLogE[nIUpper][nK+1]-dLogTOfLogE[nILower][nK+1])*dRhoFrac
+        +dLogTOfLogE[nILower][nK+1];
+      double dLogTGuess=(dLogT_kp1-dLogT_k)*dEFrac+dLogT_k;
+      if(!std::isnan(dLogTGuess)){
+        nJLower=std::max(0,std::min(nNumT-2,int((dLogTGuess-dLogTMin)/dLogTDelta)));
+      }
+    }
+  }
+  
+  //find the temperature cell nearest the starting cell with energies bracketing the energy at
+  //this density, searching up from the bottom of the column if there is no starting cell. The
+  //energy isn't monotonic in temperature everywhere, and the nearest root is usually the one
+  //iterating from the starting temperature would reach.
+  int nJStart=std::max(0,nJLower);
+  double dLogE_j=std::numeric_limits<double>::quiet_NaN();
+  double dLogE_jp1=std::numeric_limits<double>::quiet_NaN();
+  nJLower=-1;
+  for(int nStep=0;nStep<nNumT-1&&nJLower<0;nStep++){
+    for(int nSide=-1;nSide<=1;nSide+=2){
+      int j=nJStart+nSide*nStep;
+      if(j<0||j>nNumT-2||(nStep==0&&nSide==1)){
+        continue;
+      }
+      dLogE_j=(dLogE[nIUpper][j]-dLogE[nILower][j])*dRhoFrac+dLogE[nILower][j];
+      dLogE_jp1=(dLogE[nIUpper][j+1]-dLogE[nILower][j+1])*dRhoFrac+dLogE[nILower][j+1];
+      if((dLogE_j-dLogETarget)*(dLogE_jp1-dLogETarget)<=0.0&&dLogE_jp1!=dLogE_j){
+        nJLower=j;
+        break;
+      }
+    }
+  }
+  if(nJLower<0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log energy to invert, \""<<dLogETarget<<"\" isn't within the table at log density \""
+      <<dLogRho<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //log10 energy is linear in log10 temperature within the cell at this density
+  double dLogTLower=dLogTMin+double(nJLower)*dLogTDelta;
+  double dLogTUpper=dLogTMin+double(nJLower+1)*dLogTDelta;
+  double dTFrac=(dLogETarget-dLogE_j)/(dLogE_jp1-dLogE_j);
+  double dLogT=dLogTLower+dTFrac*(dLogTUpper-dLogTLower);
+  
+  //with bicubic interpolation correct the temperature with Newton's method
+  bool bConverged=true;
+  if(bHermite){
+    int nCount=0;
+    double dDelLogELast=std::numeric_limits<double>::max();
+    while(true){
+      double dLogEInterp;
+      double dDlnEDlnT;
+      double dDlnEDlnRho;
+      interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+        ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+      
+      //stop if the energy matches, or if the error stopped decreasing at the level of round off
+      //in log10 energy
+      double dDelLogE=fabs(dLogETarget-dLogEInterp);
+      if(fabs(pow(10.0,dLogETarget-dLogEInterp)-1.0)<=dTolerance||(dDelLogE>=dDelLogELast
+        &&dDelLogE<=64.0*std::numeric_limits<double>::epsilon()*fabs(dLogETarget))){
+        break;
+      }
+      if(nCount>=nMaxIterations){
+        bConverged=false;
+        break;
+      }
+      dDelLogELast=dDelLogE;
+      dLogT=dLogT+(dLogETarget-dLogEInterp)/dDlnEDlnT;
+      nCount++;
+      
+      //if temperature is out of the table
+      if(!(dLogT>=dLogTMin&&dLogT<=dLogTMax)){
+        std::stringstream ssTemp;
+        ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+          <<": the log temperature found for log energy \""<<dLogETarget<<"\", \""<<dLogT
+          <<"\", is outside the table\n";
+        throw exception2(ssTemp.str(),INPUT);
+      }
+      
+      //find the cell of the corrected temperature
+      nJLower=std::min(nNumT-2,int((dLogT-dLogTMin)/dLogTDelta));
+      dLogTLower=dLogTMin+double(nJLower)*dLogTDelta;
+      dLogTUpper=dLogTMin+double(nJLower+1)*dLogTDelta;
+      dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
+    }
+  }
+  dT=pow(10.0,dLogT);
+  
+  //calculate pressure, opacity and gamma in the same cell
+  getPKappaGammaCell(nILower,nJLower,dRhoFrac,dTFrac,dT,dLogT,dRho,dP,dKappa,dGamma);
+  nCell=nILower*nNumT+nJLower;
+  return bConverged;
+}
+void eos::getPKappaAndDerivs(double dT,double dRho,double &dP,double &dKappa,double &dDlnPDlnT
+  ,double &dDlnPDlnRho,double &dDlnKappaDlnT,double &dDlnKappaDlnRho)throw(exception2){
+  
+  //check for negative density
+  if(dRho<0.0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": dRho=\""<<dRho
+      <<"\" is less than zero.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //check for negative temperature
+  if(dT<0.0){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": dT=\""<<dT
+      <<"\" is less than zero.\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate logs of dT and dRho
+  double dLogRho=log10(dRho);
+  double dLogT=log10(dT);
+  
+  //if density too low
+  if(dLogRho<dLogRhoMin){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log density to interpolate to, \""<<dLogRho
+      <<"\" is lower than the minimum density in the table, \""<<dLogRhoMin<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //if temperature too low
+  if(dLogT<dLogTMin){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log temperature to interpolate to, \""<<dLogT
+      <<"\" is lower than the minimum log temperature in the table, \""<<dLogTMin<<"\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate maximum values of grid
+  double dLogRhoMax=dLogRhoMin+double(nNumRho-1)*dLogRhoDelta;
+  double dLogTMax=dLogTMin+double(nNumT-1)*dLogTDelta;
+  
+  //calculate independent quantities at bracketing i's
+  int nILower=int((dLogRho-dLogRhoMin)/dLogRhoDelta);
+  int nIUpper=nILower+1;
+  double dLogRhoLower=dLogRhoMin+double(nILower)*dLogRhoDelta;
+  double dLogRhoUpper=dLogRhoMin+double(nIUpper)*dLogRhoDelta;
+  
+  //if density too high
+  if(dLogRho>dLogRhoMax||nIUpper>(nNumRho-1)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log density to interpolate to, \""<<dLogRho
+      <<"\"("<<nIUpper<<") is higher than the maximum density in the table, \""<<dLogRhoMax
+      <<"\"("<<nNumRho-1<<")\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate independent quantities at bracketing j's
+  int nJLower=int((dLogT-dLogTMin)/dLogTDelta);
+  int nJUpper=nJLower+1;
+  double dLogTLower=dLogTMin+double(nJLower)*dLogTDelta;
+  double dLogTUpper=dLogTMin+double(nJUpper)*dLogTDelta;
+  
+  //if temperature too high
+  if(dLogT>dLogTMax||nJUpper>(nNumT-1)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": the log temperature to interpolate to, \""<<dLogT
+      <<"\"("<<nJUpper<<") is higher than the maximum temperature in the table, \""<<dLogTMax
+      <<"\"("<<nNumT-1<<")\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  
+  //calculate fractional distance between nILower and nIUpper
+  double dRhoFrac=(dLogRho-dLogRhoLower)/(dLogRhoUpper-dLogRhoLower);
+  
+  //calculate fractional distance between nJLower and nJUpper
+  double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
+  
+  //calculate interpolated pressure and opacity, and the derivatives of the interpolation
+  double dLogPInterp;
+  double dLogKappaInterp;
+  if(bHermite){
+    interpHermite(dLogP,dDLogPDLogT,dDLogPDLogRho,dD2LogPDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogPInterp,dDlnPDlnT,dDlnPDlnRho);
+    interpHermite(dLogKappa,dDLogKappaDLogT,dDLogKappaDLogRho,dD2LogKappaDLogTDLogRho,nILower
+      ,nJLower,dRhoFrac,dTFrac,dLogKappaInterp,dDlnKappaDlnT,dDlnKappaDlnRho);
+  }
+  else{
+    double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
+    double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
+    dLogPInterp=(dP_jp1-dP_j)*dTFrac+dP_j;
+    dDlnPDlnT=(dP_jp1-dP_j)/(dLogTUpper-dLogTLower);
+    dDlnPDlnRho=((dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*(1.0-dTFrac)
+      +(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dTFrac)/(dLogRhoUpper-dLogRhoLower);
+    double dKappa_j  =(dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*dRhoFrac
+      +dLogKappa[nILower][nJLower];
+    double dKappa_jp1=(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dRhoFrac
+      +dLogKappa[nILower][nJUpper];
+    dLogKappaInterp=(dKappa_jp1-dKappa_j)*dTFrac+dKappa_j;
+    dDlnKappaDlnT=(dKappa_jp1-dKappa_j)/(dLogTUpper-dLogTLower);
+    dDlnKappaDlnRho=((dLogKappa[nIUpper][nJLower]-dLogKappa[nILower][nJLower])*(1.0-dTFrac)
+      +(dLogKappa[nIUpper][nJUpper]-dLogKappa[nILower][nJUpper])*dTFrac)
+      /(dLogRhoUpper-dLogRhoLower);
+  }
+  dP=pow(10.0,dLogPInterp);
+  if (std::isnan(dP)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": got nan for the pressure at (rho,T)=("<<dRho<<","<<dT<<"), indicating that one or more"
+      <<" values used in the interpolation are outside the calculated grid points.\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+  dKappa=pow(10.0,dLogKappaInterp);
+  if (std::isnan(dKappa)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": got nan for the opacity at (rho,T)=("<<dRho<<","<<dT<<"), indicating that one or more"
+      <<" values used in the interpolation are outside the calculated grid points.\"\n";
+    throw exception2(ssTemp.str(),INPUT);
+  }
+}
 void eos::gamma1DelAdC_v(double dT,double dRho,double &dGamma1, double &dDelAd,double &dC_v)throw(exception2){
   
   //check for negative density
@@ -1657,6 +2653,12 @@ void eos::gamma1DelAdC_v(double dT,double dRho,double &dGamma1, double &dDelAd,d
     throw exception2(ssTemp.str(),INPUT);
   }
 }
+void eos::gamma1DelAdC_v(int nNum,const double dT[],const double dRho[],double dGamma1[]
+  ,double dDelAd[],double dC_v[])throw(exception2){
+  for(int n=0;n<nNum;n++){
+    gamma1DelAdC_v(dT[n],dRho[n],dGamma1[n],dDelAd[n],dC_v[n]);
+  }
+}
 void eos::getPAndDRhoDP(double dT,double dRho,double &dP, double &dDRhoDP)throw(exception2){
   
   //check for negative density
@@ -1860,9 +2862,22 @@ void eos::getEAndDTDE(double dT,double dRho,double &dE, double &dDTDE)throw(exce
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
   //calculate interpolated energy
-  double dLogE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
-  double dLogE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
-  dDTDE=(pow(10.0,dLogTUpper)-pow(10.0,dLogTLower))/(pow(10.0,dLogE_jp1)-pow(10.0,dLogE_j));
+  double dLogEInterp;
+  if(bHermite){
+    double dDlnEDlnT;
+    double dDlnEDlnRho;
+    interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+    
+    //dT/dE at constant density from the derivative of the interpolation, continuous across cells
+    dDTDE=pow(10.0,dLogT-dLogEInterp)/dDlnEDlnT;
+  }
+  else{
+    double dLogE_j  =(dLogE[nIUpper][nJLower]-dLogE[nILower][nJLower])*dRhoFrac+dLogE[nILower][nJLower];
+    double dLogE_jp1=(dLogE[nIUpper][nJUpper]-dLogE[nILower][nJUpper])*dRhoFrac+dLogE[nILower][nJUpper];
+    dDTDE=(pow(10.0,dLogTUpper)-pow(10.0,dLogTLower))/(pow(10.0,dLogE_jp1)-pow(10.0,dLogE_j));
+    dLogEInterp=(dLogE_jp1-dLogE_j)*dTFrac+dLogE_j;
+  }
   if (std::isnan(dDTDE)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1872,7 +2887,7 @@ void eos::getEAndDTDE(double dT,double dRho,double &dE, double &dDTDE)throw(exce
   }
   
   //calculate interpolated energy
-  dE=pow(10.0,((dLogE_jp1-dLogE_j)*dTFrac+dLogE_j));
+  dE=pow(10.0,dLogEInterp);
   if (std::isnan(dE)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
@@ -1964,6 +2979,22 @@ void eos::getDlnPDlnTDlnPDlnPDEDT(double dT, double dRho, double &dDlnPDlnT,
   //calculate fractional distance between nJLower and nJUpper
   double dTFrac=(dLogT-dLogTLower)/(dLogTUpper-dLogTLower);
   
+  //use the derivatives of the bicubic Hermite interpolation if the derivative tables are made
+  if(bHermite){
+    double dLogPInterp;
+    double dLogEInterp;
+    double dDlnEDlnT;
+    double dDlnEDlnRho;
+    interpHermite(dLogP,dDLogPDLogT,dDLogPDLogRho,dD2LogPDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogPInterp,dDlnPDlnT,dDlnPDlnRho);
+    interpHermite(dLogE,dDLogEDLogT,dDLogEDLogRho,dD2LogEDLogTDLogRho,nILower,nJLower,dRhoFrac
+      ,dTFrac,dLogEInterp,dDlnEDlnT,dDlnEDlnRho);
+    
+    //calculate dE/dT at constant density from the derivative of the interpolation
+    dDEDT=pow(10.0,dLogEInterp-dLogT)*dDlnEDlnT;
+    return;
+  }
+  
   //calculate interpolated log10 pressure at upper and lower temperatures
   double dP_j  =(dLogP[nIUpper][nJLower]-dLogP[nILower][nJLower])*dRhoFrac+dLogP[nILower][nJLower];
   double dP_jp1=(dLogP[nIUpper][nJUpper]-dLogP[nILower][nJUpper])*dRhoFrac+dLogP[nILower][nJUpper];
@@ -1991,6 +3022,12 @@ void eos::getDlnPDlnTDlnPDlnPDEDT(double dT, double dRho, double &dDlnPDlnT,
   //calculate dE/dT at constant density, equal to C_v (specific heat at constant volume)
   dDEDT=(pow(10.0,dE_jp1)-pow(10.0,dE_j))/(pow(10.0,dLogTUpper)-pow(10.0,dLogTLower));
 }
+void eos::getDlnPDlnTDlnPDlnPDEDT(int nNum,const double dT[],const double dRho[]
+  ,double dDlnPDlnT[],double dDlnPDlnRho[],double dDEDT[])throw(exception2){
+  for(int n=0;n<nNum;n++){
+    getDlnPDlnTDlnPDlnPDEDT(dT[n],dRho[n],dDlnPDlnT[n],dDlnPDlnRho[n],dDEDT[n]);
+  }
+}
 void eos::setExePath(){
   /*This method might not be 100% portable, may need to look into other 
   solutions if problems arise with this not being reliable*/
@@ -52,6 +52,62 @@ class eos{
       \ref eos::dLogRhoMin, and at log10 temperature of \ref eos::dLogTDelta*j
       +\ref eos::dLogTMin.
       */
+    bool bHermite;/**<
+      If true the tables of derivatives \ref eos::dDLogPDLogT etc. have been made and the
+      interpolation functions use bicubic Hermite interpolation instead of bilinear interpolation.
+      Set with \ref eos::setHermite.
+      */
+    double **dDLogPDLogT;/**<
+      2D array of the derivative of log10 pressure w.r.t. log10 temperature at the table nodes,
+      indexed like \ref eos::dLogP. Only allocated if \ref eos::bHermite is true.
+      */
+    double **dDLogPDLogRho;/**<
+      2D array of the derivative of log10 pressure w.r.t. log10 density at the table nodes.
+      */
+    double **dD2LogPDLogTDLogRho;/**<
+      2D array of the mixed second derivative of log10 pressure w.r.t. log10 temperature and log10
+      density at the table nodes.
+      */
+    double **dDLogEDLogT;/**<
+      2D array of the derivative of log10 energy w.r.t. log10 temperature at the table nodes.
+      */
+    double **dDLogEDLogRho;/**<
+      2D array of the derivative of log10 energy w.r.t. log10 density at the table nodes.
+      */
+    double **dD2LogEDLogTDLogRho;/**<
+      2D array of the mixed second derivative of log10 energy w.r.t. log10 temperature and log10
+      density at the table nodes.
+      */
+    double **dDLogKappaDLogT;/**<
+      2D array of the derivative of log10 opacity w.r.t. log10 temperature at the table nodes.
+      */
+    double **dDLogKappaDLogRho;/**<
+      2D array of the derivative of log10 opacity w.r.t. log10 density at the table nodes.
+      */
+    double **dD2LogKappaDLogTDLogRho;/**<
+      2D array of the mixed second derivative of log10 opacity w.r.t. log10 temperature and log10
+      density at the table nodes.
+      */
+    bool bInverse;/**<
+      If true the inverse table \ref eos::dLogTOfLogE has been made and
+      \ref eos::bGetTPKappaGamma starts from it. Set with \ref eos::setInverse.
+      */
+    int nNumE;/**<
+      Number of energies in the inverse table \ref eos::dLogTOfLogE.
+      */
+    double dLogEMin;/**<
+      Minimum energy of the inverse table in log10.
+      */
+    double dLogEDelta;/**<
+      Increment of the energy between inverse table entries in log10.
+      */
+    double **dLogTOfLogE;/**<
+      2D array of log10 temperatures. dLogTOfLogE[i][k] gives the log10 temperature at log10
+      density of \ref eos::dLogRhoDelta*i+\ref eos::dLogRhoMin, and at log10 energy of
+      \ref eos::dLogEDelta*k+\ref eos::dLogEMin, or nan if that energy isn't in the table at that
+      density. Where the energy isn't monotonic in temperature only the lowest temperature
+      reaching the energy is kept. Only allocated if \ref eos::bInverse is true.
+      */
     std::string sExePath;/**<
       contains the path to the current executable, used for making equation of 
       state file paths relative to it.
@@ -67,8 +123,7 @@ class eos{
       @param[in] nNumT number of temperatures in the equaiton of state table
       @param[in] nNumRho number of densities in the equaiton of state table
       
-      Note: I don't think this version of the constructor is implemented,
-      I should probably get rid of this definition
+      The values of the table are not set.
       */
     eos(const eos &ref);/**<
       Copy constructor, simply constructs a new eos object from another eos object
@@ -82,6 +137,94 @@ class eos{
     void setExePath();/**<
       Sets the path of the current executable, used for relative eos file paths
       */
+    void setHermite(bool bHermite);/**<
+      Switches between bilinear and bicubic Hermite interpolation of the tables. When switched on
+      the derivatives of log10 pressure, energy and opacity w.r.t. log10 temperature and log10
+      density are computed once at every table node with centered differences, so that
+      interpolated values and their derivatives are continuous across table cells. The tables are
+      remade whenever a new equation of state is read in. \ref eos::dGetPressure,
+      \ref eos::dGetEnergy, \ref eos::dGetOpacity, \ref eos::getEKappa, \ref eos::getPEKappa,
+      \ref eos::getPEKappaGamma, \ref eos::getPKappaGamma, \ref eos::getPKappaAndDerivs,
+      \ref eos::getEAndDTDE and \ref eos::getDlnPDlnTDlnPDlnPDEDT use it, the other functions
+      always interpolate bilinearly.
+      
+      @param[in] bHermite if true use bicubic Hermite interpolation, if false use bilinear
+      interpolation and free the derivative tables.
+      */
+    void makeHermiteTables();/**<
+      Allocates and computes the derivative tables used by the bicubic Hermite interpolation from
+      the current tables. Called by \ref eos::setHermite and after reading a new table.
+      */
+    void deleteHermiteTables();/**<
+      Frees the derivative tables used by the bicubic Hermite interpolation.
+      */
+    void differentiateTable(double **dF,double **dDF,bool bAlongT);/**<
+      Calculates the derivative of a table at every node with centered differences, falling back to
+      one sided differences at the edges of the table and next to nan's.
+      
+      @param[in] dF table to differentiate, indexed like \ref eos::dLogP.
+      @param[out] dDF derivative of \c dF at every node, must already be allocated.
+      @param[in] bAlongT if true differentiate w.r.t. log10 temperature, otherwise w.r.t. log10
+      density.
+      */
+    void interpHermite(double **dF,double **dDFDLogT,double **dDFDLogRho,double **dD2FDLogTDLogRho
+      ,int nI,int nJ,double dRhoFrac,double dTFrac,double &dFInterp,double &dDFInterpDLogT
+      ,double &dDFInterpDLogRho);/**<
+      Bicubic Hermite interpolation of a table within the cell with lower corner (\c nI, \c nJ).
+      The value and both first derivatives come from the same 4 nodes.
+      
+      @param[in] dF table of values.
+      @param[in] dDFDLogT table of derivatives of \c dF w.r.t. log10 temperature.
+      @param[in] dDFDLogRho table of derivatives of \c dF w.r.t. log10 density.
+      @param[in] dD2FDLogTDLogRho table of mixed second derivatives of \c dF.
+      @param[in] nI density index of the lower corner of the cell.
+      @param[in] nJ temperature index of the lower corner of the cell.
+      @param[in] dRhoFrac fractional distance across the cell in log10 density.
+      @param[in] dTFrac fractional distance across the cell in log10 temperature.
+      @param[out] dFInterp interpolated value.
+      @param[out] dDFInterpDLogT derivative of the interpolated value w.r.t. log10 temperature.
+      @param[out] dDFInterpDLogRho derivative of the interpolated value w.r.t. log10 density.
+      */
+    void setInverse(bool bInverse);/**<
+      Switches the inverse table, log10 temperature as a function of log10 energy and log10
+      density, on or off. The table is remade whenever a new equation of state is read in.
+      
+      @param[in] bInverse if true make the inverse table, if false free it.
+      */
+    void makeInverseTable();/**<
+      Allocates and computes \ref eos::dLogTOfLogE from the current table, by linearly inverting
+      every density row of \ref eos::dLogE on an evenly spaced grid of log10 energies spanning the
+      table.
+      */
+    void deleteInverseTable();/**<
+      Frees the inverse table.
+      */
+    void findCell(double dLogT,double dLogRho,int &nCell,int &nI,int &nJ,double &dRhoFrac
+      ,double &dTFrac)throw(exception2);/**<
+      Finds the table cell containing a log10 temperature and log10 density. The cell \c nCell
+      found by the last lookup at the same place, e.g. the same zone in the last time step, is
+      checked first with a few comparisons, and only if it no longer brackets the point is the
+      cell computed and range checked from scratch.
+      
+      @param[in] dLogT log10 temperature.
+      @param[in] dLogRho log10 density.
+      @param[in,out] nCell cell hint, <tt>nI*</tt>\ref eos::nNumT<tt>+nJ</tt>, or -1 if there is no
+      hint. Set to the cell found.
+      @param[out] nI density index of the lower corner of the cell.
+      @param[out] nJ temperature index of the lower corner of the cell.
+      @param[out] dRhoFrac fractional distance across the cell in log10 density.
+      @param[out] dTFrac fractional distance across the cell in log10 temperature.
+      */
+    int nGetCell(double dT,double dRho);/**<
+      Gives the table cell containing a temperature and density, moved to the nearest cell on the
+      edge of the table if outside it. Meant as the cell hint of \ref eos::bGetTPKappaGamma when
+      there is a temperature to start from, but no hint yet.
+      
+      @param[in] dT temperature.
+      @param[in] dRho density.
+      @return the cell, <tt>nI*</tt>\ref eos::nNumT<tt>+nJ</tt>, or -1 if \c dT or \c dRho isn't
+      positive.
+      */
     void readAscii(std::string sFileName)throw(exception2);/**<
       This fuction reads in an ascii file and stores it in the current object.
       
@@ -135,12 +278,31 @@ class eos{
       @param [in] dRho density at which the derivative is to be computed
       @return the partial derivative of density w.r.t. pressure.
       */
+    void getDRhoDP(int nNum,const double dT[],const double dRho[],double dDRhoDP[])
+      throw(exception2);/**<
+      Calculates the partial derivative of density w.r.t. pressure for \c nNum temperature and
+      density pairs at once.
+      
+      @param[in] nNum number of temperature and density pairs.
+      @param[in] dT temperatures at which the derivatives are to be computed.
+      @param[in] dRho densities at which the derivatives are to be computed.
+      @param[out] dDRhoDP partial derivatives of density w.r.t. pressure.
+      */
     double dSoundSpeed(double dT,double dRho)throw(exception2);/**<
       This function calculates the adiabatic sound speed
       @param [in] dT temperature at which the derivative is to be computed
       @param [in] dRho density at which the derivative is to be computed
       @return the sound speed.
       */
+    void getSoundSpeed(int nNum,const double dT[],const double dRho[],double dC[])
+      throw(exception2);/**<
+      Calculates the adiabatic sound speed for \c nNum temperature and density pairs at once.
+      
+      @param[in] nNum number of temperature and density pairs.
+      @param[in] dT temperatures at which the sound speeds are to be computed.
+      @param[in] dRho densities at which the sound speeds are to be computed.
+      @param[out] dC sound speeds.
+      */
     void getEKappa(double dT, double dRho, double &dE, double &dKappa)throw(exception2);/**<
       This function linearly interpolates the three dependent quantities (Pressure, Energy
       , Opacity) to a given temperature and density. Note that both \c dT and \c dRho are 
@@ -174,6 +336,37 @@ class eos{
       @param[out] dKappa opacity at dT and dRho.
       @param[out] dGamma adiabatic index at dT and dRho.
       */
+    void getPEKappaGamma(double dT,double dRho,int &nCell,double &dP,double &dE,double &dKappa
+      ,double &dGamma)throw(exception2);/**<
+      Same as \ref eos::getPEKappaGamma above, but starts from the table cell hint \c nCell, see
+      \ref eos::findCell.
+      
+      @param[in] dT temperature to interpolate to.
+      @param[in] dRho density to interpolate to.
+      @param[in,out] nCell cell hint, or -1 if there is none. Set to the cell used.
+      @param[out] dP pressure at dT and dRho.
+      @param[out] dE energy at dT and dRho.
+      @param[out] dKappa opacity at dT and dRho.
+      @param[out] dGamma adiabatic index at dT and dRho.
+      */
+    void getPEKappaGammaCell(int nI,int nJ,double dRhoFrac,double dTFrac,double dT,double dLogT
+      ,double dRho,double &dP,double &dE,double &dKappa,double &dGamma)throw(exception2);/**<
+      Calculates the pressure, energy, opacity and adiabatic index from the table cell with lower
+      corner (\c nI, \c nJ), once the cell has been found. Used by both versions of
+      \ref eos::getPEKappaGamma.
+      
+      @param[in] nI density index of the lower corner of the cell.
+      @param[in] nJ temperature index of the lower corner of the cell.
+      @param[in] dRhoFrac fractional distance across the cell in log10 density.
+      @param[in] dTFrac fractional distance across the cell in log10 temperature.
+      @param[in] dT temperature.
+      @param[in] dLogT log10 of \c dT.
+      @param[in] dRho density.
+      @param[out] dP pressure at dT and dRho.
+      @param[out] dE energy at dT and dRho.
+      @param[out] dKappa opacity at dT and dRho.
+      @param[out] dGamma adiabatic index at dT and dRho.
+      */
     void getPEKappaGammaCp(double dT,double dRho,double &dP,double &dE,double &dKappa
       ,double &dGamma,double &dCp)throw(exception2);/**<
       This function linearly interpolates the energy and opacity to a given temperature and 
@@ -187,6 +380,21 @@ class eos{
       @param[out] dGamma adiabatic index at dT and dRho.
       @param[out] dCp specific heat at constant pressure at dT and dRho.
       */
+    void getPEKappaGammaCp(int nNum,const double dT[],const double dRho[],double dP[],double dE[]
+      ,double dKappa[],double dGamma[],double dCp[])throw(exception2);/**<
+      Interpolates the pressure, energy, opacity, adiabatic index and specific heat at constant
+      pressure for \c nNum temperature and density pairs at once, for example all the zones of a
+      radial shell.
+      
+      @param[in] nNum number of temperature and density pairs.
+      @param[in] dT temperatures to interpolate to.
+      @param[in] dRho densities to interpolate to.
+      @param[out] dP pressures at dT and dRho.
+      @param[out] dE energies at dT and dRho.
+      @param[out] dKappa opacities at dT and dRho.
+      @param[out] dGamma adiabatic indices at dT and dRho.
+      @param[out] dCp specific heats at constant pressure at dT and dRho.
+      */
     void getPKappaGamma(double dT, double dRho, double &dP, double &dKappa,double &dGamma)throw(exception2);/**<
       This function linearly interpolates the energy and opacity to a given temperature and 
       density. Note that both \c dT and \c dRho are not in log space.
@@ -197,6 +405,85 @@ class eos{
       @param[out] dKappa opacity at dT and dRho.
       @param[out] dGamma adiabatic index at dT and dRho.
       */
+    void getPKappaGammaCell(int nI,int nJ,double dRhoFrac,double dTFrac,double dT,double dLogT
+      ,double dRho,double &dP,double &dKappa,double &dGamma)throw(exception2);/**<
+      Calculates the pressure, opacity and adiabatic index from the table cell with lower corner
+      (\c nI, \c nJ), once the cell has been found. Used by \ref eos::getPKappaGamma and
+      \ref eos::bGetTPKappaGamma.
+      
+      @param[in] nI density index of the lower corner of the cell.
+      @param[in] nJ temperature index of the lower corner of the cell.
+      @param[in] dRhoFrac fractional distance across the cell in log10 density.
+      @param[in] dTFrac fractional distance across the cell in log10 temperature.
+      @param[in] dT temperature.
+      @param[in] dLogT log10 of \c dT.
+      @param[in] dRho density.
+      @param[out] dP pressure at dT and dRho.
+      @param[out] dKappa opacity at dT and dRho.
+      @param[out] dGamma adiabatic index at dT and dRho.
+      */
+    bool bGetTPKappaGamma(double dE,double dRho,double dTolerance,int nMaxIterations,double &dT
+      ,double &dP,double &dKappa,double &dGamma)throw(exception2);/**<
+      Finds the temperature at which the table gives the energy \c dE at density \c dRho, and
+      the pressure, opacity and adiabatic index there from the same table cell. The temperature
+      cell is guessed from \ref eos::dLogTOfLogE, if made, and moved to the cell bracketing
+      \c dE. With bilinear interpolation log10 energy is linear in log10 temperature within the
+      cell at fixed density, so the temperature is found exactly without iterating. With bicubic
+      Hermite interpolation (\ref eos::bHermite) Newton corrections in log10 temperature follow
+      until the relative error in the energy is below \c dTolerance, usually one.
+      
+      @param[in] dE energy to match.
+      @param[in] dRho density.
+      @param[in] dTolerance allowed relative error in the energy, only used with bicubic
+      interpolation.
+      @param[in] nMaxIterations maximum number of Newton corrections, only used with bicubic
+      interpolation.
+      @param[out] dT temperature at which the energy is \c dE.
+      @param[out] dP pressure at dT and dRho.
+      @param[out] dKappa opacity at dT and dRho.
+      @param[out] dGamma adiabatic index at dT and dRho.
+      @return false if \c nMaxIterations corrections didn't reach \c dTolerance, true otherwise.
+      */
+    bool bGetTPKappaGamma(double dE,double dRho,double dTolerance,int nMaxIterations,int &nCell
+      ,double &dT,double &dP,double &dKappa,double &dGamma)throw(exception2);/**<
+      Same as \ref eos::bGetTPKappaGamma above, but starts from the table cell hint \c nCell
+      instead of the inverse table. The density index of the hint is kept if it still brackets
+      \c dRho, and the search for the temperature cell starts at its temperature index, so a zone
+      whose state changed little since the last time step is found in its old cell right away.
+      Where the energy isn't monotonic in temperature the root nearest the hint is found, so
+      callers which know an old temperature should pass its cell (\ref eos::nGetCell) rather
+      than -1.
+      
+      @param[in] dE energy to match.
+      @param[in] dRho density.
+      @param[in] dTolerance allowed relative error in the energy, only used with bicubic
+      interpolation.
+      @param[in] nMaxIterations maximum number of Newton corrections, only used with bicubic
+      interpolation.
+      @param[in,out] nCell cell hint, <tt>nI*</tt>\ref eos::nNumT<tt>+nJ</tt>, or -1 if there is no
+      hint. Set to the cell used.
+      @param[out] dT temperature at which the energy is \c dE.
+      @param[out] dP pressure at dT and dRho.
+      @param[out] dKappa opacity at dT and dRho.
+      @param[out] dGamma adiabatic index at dT and dRho.
+      @return false if \c nMaxIterations corrections didn't reach \c dTolerance, true otherwise.
+      */
+    void getPKappaAndDerivs(double dT,double dRho,double &dP,double &dKappa,double &dDlnPDlnT
+      ,double &dDlnPDlnRho,double &dDlnKappaDlnT,double &dDlnKappaDlnRho)throw(exception2);/**<
+      This function interpolates the pressure and opacity to a given temperature and density, and
+      calculates their logarithmic derivatives from the same table cell. The derivatives are
+      those of the interpolation, so they are consistent with \ref eos::dGetPressure and
+      \ref eos::dGetOpacity. Note that both \c dT and \c dRho are not in log space.
+      
+      @param[in] dT temperature to interpolate to.
+      @param[in] dRho density to interpolate to.
+      @param[out] dP pressure at dT and dRho.
+      @param[out] dKappa opacity at dT and dRho.
+      @param[out] dDlnPDlnT derivative of ln(P) w.r.t. ln(T) at constant density.
+      @param[out] dDlnPDlnRho derivative of ln(P) w.r.t. ln(Rho) at constant temperature.
+      @param[out] dDlnKappaDlnT derivative of ln(Kappa) w.r.t. ln(T) at constant density.
+      @param[out] dDlnKappaDlnRho derivative of ln(Kappa) w.r.t. ln(Rho) at constant temperature.
+      */
     void gamma1DelAdC_v(double dT,double dRho,double &dGamma1, double &dDelAd, double &dC_v)throw(exception2);/**<
       This function calculates gamma1 and the adiabatic gradient
       
@@ -206,6 +493,18 @@ class eos{
       @param [out] dDelAd adiabatic gradient
       @param [out] dC_v specific heat at constant volume
       */
+    void gamma1DelAdC_v(int nNum,const double dT[],const double dRho[],double dGamma1[]
+      ,double dDelAd[],double dC_v[])throw(exception2);/**<
+      Calculates gamma1, the adiabatic gradient and the specific heat at constant volume for
+      \c nNum temperature and density pairs at once.
+      
+      @param[in] nNum number of temperature and density pairs.
+      @param[in] dT temperatures at which the quantities are to be computed.
+      @param[in] dRho densities at which the quantities are to be computed.
+      @param[out] dGamma1 gamma1 values.
+      @param[out] dDelAd adiabatic gradients.
+      @param[out] dC_v specific heats at constant volume.
+      */
     void getPAndDRhoDP(double dT,double dRho,double &dP, double &dDRhoDP)throw(exception2);/**<
       This function calculates the partial derivative of density w.r.t. pressure
       and the pressure
@@ -231,6 +530,18 @@ class eos{
         @param [out] dDlnPDlnRho derivative of ln(P) w.r.t. ln(Rho)
         @param [out] dDEDT derivative of temperature w.r.t. energy at constant density
       */
+    void getDlnPDlnTDlnPDlnPDEDT(int nNum,const double dT[],const double dRho[],double dDlnPDlnT[]
+      ,double dDlnPDlnRho[],double dDEDT[])throw(exception2);/**<
+      Calculates the same partial derivatives as the scalar version for \c nNum temperature and
+      density pairs at once.
+      
+      @param[in] nNum number of temperature and density pairs.
+      @param[in] dT temperatures at which the derivatives are to be computed.
+      @param[in] dRho densities at which the derivatives are to be computed.
+      @param[out] dDlnPDlnT derivatives of ln(P) w.r.t. ln(T).
+      @param[out] dDlnPDlnRho derivatives of ln(P) w.r.t. ln(Rho).
+      @param[out] dDEDT derivatives of energy w.r.t. temperature at constant density.
+      */
 };/**@class eos
   This class holds an equation of state as well as many functions useful for manipulating it
   */
@@ -27,3 +27,8 @@ exception2::exception2(const exception2 &exception2In):exception(){//copy constr
   setMsg(exception2In.sMsg);
   setCode(exception2In.nCode);
 }
+exception2& exception2::operator=(const exception2 &exception2In){//copy assignment
+  setMsg(exception2In.sMsg);
+  setCode(exception2In.nCode);
+  return *this;
+}
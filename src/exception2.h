@@ -26,6 +26,7 @@ class exception2: public std::exception{
     exception2(std::string sMsg,int nCode);
     exception2(std::string sMsg);
     exception2(const exception2 &exception2In);//copy constructor
+    exception2& operator=(const exception2 &exception2In);//copy assignment
     std::string getMsg();
     void setMsg(std::string sMsg);
     void setCode(int nCodeIn);
@@ -2,6 +2,7 @@
 #include <iostream>
 #include "mfhdf.h"
 #include <sstream>
+#include <string>
 #include <vector>
 
 int32 nDataID=FAIL;
@@ -10,10 +11,12 @@ int32* nDims=NULL;
 static PyObject* HDFError;
 int32 nFileID=FAIL;
 
-bool walkListAndWriteData(PyObject* list, int* nPosition,int nDepth){
+/** Copies the values of nested lists into dValues in C order, used when the data given to
+writeData does not provide a buffer*/
+bool walkListAndCopyData(PyObject* list,double* dValues,size_t* nPosition,int nDepth){
   
   //check that list is really a list
-  if(!PyList_Check(list)){
+  if(!PyList_Check(list)&&!PyTuple_Check(list)){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
       <<": expecting a list for argument, check that you have nested the lists appropriately "
@@ -23,26 +26,24 @@ bool walkListAndWriteData(PyObject* list, int* nPosition,int nDepth){
   }
   
   //check that the list is long enough
-  if(PyList_Size(list)!=nDims[nDepth]){
+  if(PySequence_Size(list)!=nDims[nDepth]){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-      <<": size of list given "<<PyList_Size(list)
+      <<": size of list given "<<PySequence_Size(list)
       <<" doesn't match dimensions of varible previously set as "<<nDims[nDepth];
     PyErr_SetString(HDFError,ssTemp.str().c_str());
     return false;
   }
   
-  if(nDepth==nRank-1){//we are at the bottom of the list, write out data
+  if(nDepth==nRank-1){//we are at the bottom of the list, copy data
     
-    //loop over list and write data
-    double *dTemp= new double[nDims[nDepth]];
-    nPosition[nDepth]=0;
+    //loop over list and copy data
     for(int i=0;i<nDims[nDepth];i++){
       
-      PyObject* temp=PyList_GetItem(list,i);
+      PyObject* temp=PySequence_Fast_GET_ITEM(list,i);
       
       //check to make sure we really are at the bottom
-      if(PyList_Check(temp)){
+      if(PyList_Check(temp)||PyTuple_Check(temp)){
         std::stringstream ssTemp;
         ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
           <<": too many nested lists for data of rank "<<nRank;
@@ -50,81 +51,58 @@ bool walkListAndWriteData(PyObject* list, int* nPosition,int nDepth){
         return false;
       }
       
-
-      dTemp[i]=PyFloat_AsDouble(temp);
+      dValues[*nPosition]=PyFloat_AsDouble(temp);
       
       //check to see if we might have an error some where
-      if(dTemp[i]==-1){
+      if(dValues[*nPosition]==-1){
         if(PyErr_Occurred()!=NULL){
           return false;
         }
       }
+      (*nPosition)++;
     }
+  }
+  else{//not at the bottom of the list, keep going
     
-    //write data to file
-    int* nDimsTemp=new int[nRank];
-    for(int j=0;j<nRank;j++){
-      nDimsTemp[j]=1;
-      if (j==nDepth){
-        nDimsTemp[j]=nDims[nDepth];
+    //for each list in the current list call walkListAndCopyData
+    for(int i=0;i<nDims[nDepth];i++){
+      if(!walkListAndCopyData(PySequence_Fast_GET_ITEM(list,i),dValues,nPosition,nDepth+1)){
+        return false;
       }
     }
+  }
+  return true;
+}
+/** Converts a list of integers into a newly allocated array*/
+bool sequenceToInt32(PyObject* sequence,int32** nValues,int32* nNum,const char* cArgument){
+  
+  //check that sequence is really a list or tuple
+  if(!PyList_Check(sequence)&&!PyTuple_Check(sequence)){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": expecting a list for argument \""<<cArgument<<"\"";
+    PyErr_SetString(HDFError,ssTemp.str().c_str());
+    return false;
+  }
+  
+  *nNum=PySequence_Size(sequence);
+  *nValues=new int32[*nNum];
+  for(int i=0;i<*nNum;i++){
     
-    //DEBUG write out position
-    /*std::cout<<"nPosition=(";
-    for(int j=0;j<nRank-1;j++){
-      std::cout<<nPosition[j]<<",";
-    }
-    std::cout<<nPosition[nRank-1]<<") ";
-    
-    //DEBUG write out position
-    std::cout<<"nDimsTemp=(";
-    for(int j=0;j<nRank-1;j++){
-      std::cout<<nDimsTemp[j]<<",";
-    }
-    std::cout<<nDimsTemp[nRank-1]<<") ";
-    
-    //DEBUG write out position
-    std::cout<<"dTemp=(";
-    for(int j=0;j<nDims[nDepth];j++){
-      std::cout<<dTemp[j]<<",";
-    }
-    std::cout<<dTemp[nDims[nDepth]-1]<<") \n\n";*/
-    
-    /**Warning this function call (SDWritedata) seems to leak memory, not sure why, I have tried a number of different methods to ensure that the buffer, dTemp is freed. I have also made sure that the data opened with SDcreate is closed with SDendaccess. Perhaps saving the data and doing one write would help, I am not sure. In any case doing only one write would very likely speed this up.
-    
-    I have moved this write out side the very bottom loop, and while it may not have removed the memory leak totaly, it seems to have drastically reduced it's severity.*/
-    int32 nStat=SDwritedata(nDataID,nPosition,NULL,nDimsTemp,(VOIDP)dTemp);
-    delete [] nDimsTemp;
-    delete [] dTemp;
-    if(nStat==FAIL){
+    PyObject* temp=PySequence_Fast_GET_ITEM(sequence,i);
+    if(!PyInt_Check(temp)&&!PyLong_Check(temp)){
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-        <<": failed writting data to file at data location (";
-      for(int j=0;j<nRank-1;j++){
-        ssTemp<<nPosition[j]<<",";
-      }
-      ssTemp<<nPosition[nRank-1]<<")";
+        <<": expecting a list of integers for argument \""<<cArgument<<"\"";
       PyErr_SetString(HDFError,ssTemp.str().c_str());
+      delete [] *nValues;
+      *nValues=NULL;
       return false;
     }
-  }
-  else{//not at the bottom of the list, keep going
-    //for each list in the current list call walkListAndWriteData
-    
-    for(int i=0;i<nDims[nDepth];i++){
-      
-      //get sub list
-      PyObject* temp=PyList_GetItem(list,i);
-      nPosition[nDepth]=i;
-      if(!walkListAndWriteData(temp,nPosition,nDepth+1)){
-        return false;
-      }
-    }
+    (*nValues)[i]=PyInt_AsLong(temp);
   }
   return true;
 }
-
 /** Opens an HDF file*/
 static PyObject* open(PyObject* self, PyObject* args){
   const char* fileName;
@@ -172,12 +150,16 @@ static PyObject* close(PyObject* self, PyObject* args){
   Py_INCREF(Py_None);
   return Py_None;
 }
-static PyObject* openData(PyObject* self, PyObject* args){
+static PyObject* openData(PyObject* self, PyObject* args, PyObject* kwargs){
   
   int32 nFileIDLoc=FAIL;
   int32 nDataIDLoc=FAIL;
   int32 nType;
+  int nCompression=0;
   PyObject* listDims;
+  PyObject* listChunks=NULL;
+  static char* cKeywords[]={(char*)"name",(char*)"type",(char*)"dims",(char*)"fileID"
+    ,(char*)"compression",(char*)"chunks",NULL};
   
   //check to see if we have a data stream open
   if(nDims!=NULL){
@@ -189,7 +171,8 @@ static PyObject* openData(PyObject* self, PyObject* args){
   }
   
   char* cVarName=NULL;
-  if(!PyArg_ParseTuple(args,"siO|i",&cVarName,&nType,&listDims,&nFileIDLoc)){
+  if(!PyArg_ParseTupleAndKeywords(args,kwargs,"siO|iiO",cKeywords,&cVarName,&nType,&listDims
+    ,&nFileIDLoc,&nCompression,&listChunks)){
     return NULL;
   }
   
@@ -207,63 +190,192 @@ static PyObject* openData(PyObject* self, PyObject* args){
     }
   }
   
-  //check that listDims is really a list
-  if(!PyList_Check(listDims)){
+  //check compression level, deflate accepts levels 1-9
+  if(nCompression<0||nCompression>9){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-      <<": expecting a list for argument 3";
+      <<": compression level "<<nCompression<<" must be between 0 (no compression) and 9";
     PyErr_SetString(HDFError,ssTemp.str().c_str());
     return NULL;
   }
   
   //get rank and dimensions
-  nRank=PyList_Size(listDims);
-  nDims=new int32[nRank];
-  for(int i=0;i<nRank;i++){
-    
-    PyObject* temp=PyList_GetItem(listDims,i);
-    if(!PyInt_Check(temp)){
+  int32* nDimsLoc=NULL;
+  int32 nRankLoc=0;
+  if(!sequenceToInt32(listDims,&nDimsLoc,&nRankLoc,"dims")){
+    return NULL;
+  }
+  
+  //get chunk dimensions
+  int32* nChunks=NULL;
+  if(listChunks!=NULL&&listChunks!=Py_None){
+    int32 nNumChunks=0;
+    if(!sequenceToInt32(listChunks,&nChunks,&nNumChunks,"chunks")){
+      delete [] nDimsLoc;
+      return NULL;
+    }
+    if(nNumChunks!=nRankLoc){
       std::stringstream ssTemp;
       ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
-        <<": expecting a list of integers for argument 3";
+        <<": number of chunk dimensions "<<nNumChunks<<" doesn't match rank of data "<<nRankLoc;
       PyErr_SetString(HDFError,ssTemp.str().c_str());
+      delete [] nDimsLoc;
+      delete [] nChunks;
       return NULL;
     }
-    int32 nDimTemp=PyInt_AsLong(temp);
-    nDims[i]=nDimTemp;
   }
   
   //create the HDF data
-  nDataIDLoc=SDcreate(nFileIDLoc,cVarName,nType,nRank,nDims);
+  nDataIDLoc=SDcreate(nFileIDLoc,cVarName,nType,nRankLoc,nDimsLoc);
   if(nDataIDLoc==FAIL){
     std::stringstream ssTemp;
     ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
       <<": creating a new HDF data set for variable \""<<cVarName<<"\" failed\n";
     PyErr_SetString(HDFError,ssTemp.str().c_str());
+    delete [] nDimsLoc;
+    if(nChunks!=NULL){
+      delete [] nChunks;
+    }
     return NULL;
   }
+  
+  //set chunking and compression, must be done before any data is written
+  int32 nStat=0;
+  if(nChunks!=NULL){
+    HDF_CHUNK_DEF chunkDef;
+    int32 nFlags=HDF_CHUNK;
+    if(nCompression>0){
+      nFlags=HDF_CHUNK|HDF_COMP;
+      for(int i=0;i<nRankLoc;i++){
+        chunkDef.comp.chunk_lengths[i]=nChunks[i];
+      }
+      chunkDef.comp.comp_type=COMP_CODE_DEFLATE;
+      chunkDef.comp.cinfo.deflate.level=nCompression;
+    }
+    else{
+      for(int i=0;i<nRankLoc;i++){
+        chunkDef.chunk_lengths[i]=nChunks[i];
+      }
+    }
+    nStat=SDsetchunk(nDataIDLoc,chunkDef,nFlags);
+    delete [] nChunks;
+  }
+  else if(nCompression>0){
+    comp_info compInfo;
+    compInfo.deflate.level=nCompression;
+    nStat=SDsetcompress(nDataIDLoc,COMP_CODE_DEFLATE,&compInfo);
+  }
+  if(nStat==FAIL){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": setting chunking or compression for variable \""<<cVarName<<"\" failed\n";
+    PyErr_SetString(HDFError,ssTemp.str().c_str());
+    SDendaccess(nDataIDLoc);
+    delete [] nDimsLoc;
+    return NULL;
+  }
+  
+  nDims=nDimsLoc;
+  nRank=nRankLoc;
   nDataID=nDataIDLoc;
   return Py_BuildValue("i",nDataIDLoc);
 }
 static PyObject* writeData(PyObject* self, PyObject* args){
-  PyObject* list;
-  if(!PyArg_ParseTuple(args,"O",&list)){
+  PyObject* data;
+  if(!PyArg_ParseTuple(args,"O",&data)){
+    return NULL;
+  }
+  
+  //check to see if we have a data stream open
+  if(nDims==NULL){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+      <<": no data opened, open data by calling \"hdf.openData\" before writing";
+    PyErr_SetString(HDFError,ssTemp.str().c_str());
     return NULL;
   }
   
   //create and initialize starting position
-  int* nPosition=new int[nRank];
+  int32* nStart=new int32[nRank];
+  size_t nNumValues=1;
   for(int i=0;i<nRank;i++){
-    nPosition[i]=0;
+    nStart[i]=0;
+    nNumValues*=nDims[i];
   }
   
-  if(!walkListAndWriteData(list,nPosition,0)){
-    delete [] nPosition;
+  int32 nStat;
+  if(PyObject_CheckBuffer(data)){//write the whole buffer at once, e.g. from a numpy array
+    
+    Py_buffer buffer;
+    if(PyObject_GetBuffer(data,&buffer,PyBUF_C_CONTIGUOUS|PyBUF_FORMAT)==-1){
+      PyErr_Clear();
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": data must be C contiguous, try passing numpy.ascontiguousarray(data)";
+      PyErr_SetString(HDFError,ssTemp.str().c_str());
+      delete [] nStart;
+      return NULL;
+    }
+    
+    //check that the buffer holds doubles
+    std::string sFormat=(buffer.format==NULL)?"B":buffer.format;
+    if(buffer.itemsize!=sizeof(double)||(sFormat!="d"&&sFormat!="@d"&&sFormat!="=d"
+      &&sFormat!="<d")){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__
+        <<": expecting data of doubles, got buffer with format \""<<sFormat
+        <<"\", try passing data.astype(\"d\")";
+      PyErr_SetString(HDFError,ssTemp.str().c_str());
+      PyBuffer_Release(&buffer);
+      delete [] nStart;
+      return NULL;
+    }
+    
+    //check that the shape matches dimensions of the data
+    bool bShapeMatches=(buffer.ndim==nRank);
+    for(int i=0;i<nRank&&bShapeMatches;i++){
+      bShapeMatches=(buffer.shape[i]==nDims[i]);
+    }
+    if(!bShapeMatches){
+      std::stringstream ssTemp;
+      ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": shape of data given (";
+      for(int i=0;i<buffer.ndim;i++){
+        ssTemp<<buffer.shape[i]<<((i<buffer.ndim-1)?",":"");
+      }
+      ssTemp<<") doesn't match dimensions of varible previously set as (";
+      for(int i=0;i<nRank;i++){
+        ssTemp<<nDims[i]<<((i<nRank-1)?",":"");
+      }
+      ssTemp<<")";
+      PyErr_SetString(HDFError,ssTemp.str().c_str());
+      PyBuffer_Release(&buffer);
+      delete [] nStart;
+      return NULL;
+    }
+    
+    nStat=SDwritedata(nDataID,nStart,NULL,nDims,(VOIDP)buffer.buf);
+    PyBuffer_Release(&buffer);
+  }
+  else{//copy nested lists into one buffer and write it at once
+    
+    double* dValues=new double[nNumValues];
+    size_t nPosition=0;
+    if(!walkListAndCopyData(data,dValues,&nPosition,0)){
+      delete [] dValues;
+      delete [] nStart;
+      return NULL;
+    }
+    nStat=SDwritedata(nDataID,nStart,NULL,nDims,(VOIDP)dValues);
+    delete [] dValues;
+  }
+  delete [] nStart;
+  if(nStat==FAIL){
+    std::stringstream ssTemp;
+    ssTemp<<__FILE__<<":"<<__FUNCTION__<<":"<<__LINE__<<": failed writting data to file";
+    PyErr_SetString(HDFError,ssTemp.str().c_str());
     return NULL;
   }
   
-  //nStat=SDwritedata(nDataID,nStart,NULL,nDims,(VOIDP)dTemp);
-  delete [] nPosition;
   Py_INCREF(Py_None);
   return Py_None;
 }
@@ -305,8 +417,10 @@ static PyObject* closeData(PyObject* self, PyObject* args){
 }
 static PyMethodDef HDFMethods[] ={
      {"open", open, METH_VARARGS, "Opens an HDF file"},
-     {"openData", openData, METH_VARARGS, "Opens access for writting data to hdf file"},
-     {"writeData", writeData, METH_VARARGS, "Writes data to an hdf file"},
+     {"openData", (PyCFunction)openData, METH_VARARGS|METH_KEYWORDS
+       , "Opens access for writting data to hdf file, optionally chunked and/or deflate compressed"},
+     {"writeData", writeData, METH_VARARGS
+       , "Writes data to an hdf file, from a C contiguous buffer of doubles or nested lists"},
      {"closeData", closeData, METH_VARARGS, "Closes access for writting data to hdf file"},
      {"close", close, METH_VARARGS, "Closes hdf file"},
      {NULL, NULL, 0, NULL}